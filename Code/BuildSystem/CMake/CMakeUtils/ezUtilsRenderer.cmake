@@ -22,6 +22,12 @@ endmacro()
 # ## Add all required libraries and dependencies to the given target so it has access to all available renderers.
 # #####################################
 function(ez_add_renderers TARGET_NAME)
+	# The null renderer works everywhere, it doesn't need a GPU
+	target_link_libraries(${TARGET_NAME}
+		PRIVATE
+		RendererNull
+	)
+
 	# PLATFORM-TODO
 	if(EZ_BUILD_EXPERIMENTAL_VULKAN)
 		target_link_libraries(${TARGET_NAME}
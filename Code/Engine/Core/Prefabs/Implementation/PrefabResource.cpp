@@ -48,6 +48,14 @@ void ezPrefabResource::InstantiatePrefab(ezWorld& ref_world, const ezTransform&
   }
 }
 
+void ezPrefabResource::InstantiatePrefabs(ezWorld& ref_world, ezArrayPtr<const ezTransform> rootTransforms, const ezPrefabInstantiationOptions& options)
+{
+  if (GetLoadingState() != ezResourceState::Loaded)
+    return;
+
+  m_WorldReader.InstantiatePrefabs(ref_world, rootTransforms, options);
+}
+
 ezPrefabResource::InstantiateResult ezPrefabResource::InstantiatePrefab(const ezPrefabResourceHandle& hPrefab, bool bBlockTillLoaded, ezWorld& ref_world, const ezTransform& rootTransform, ezPrefabInstantiationOptions options, const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues /*= nullptr*/)
 {
   ezResourceLock<ezPrefabResource> pPrefab(hPrefab, bBlockTillLoaded ? ezResourceAcquireMode::BlockTillLoaded_NeverFail : ezResourceAcquireMode::AllowLoadingFallback_NeverFail);
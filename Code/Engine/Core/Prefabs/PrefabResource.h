@@ -46,6 +46,11 @@ public:
   /// \brief Creates an instance of this prefab in the given world.
   void InstantiatePrefab(ezWorld& ref_world, const ezTransform& rootTransform, ezPrefabInstantiationOptions options, const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues = nullptr);
 
+  /// \brief Creates one instance of this prefab for each of the given root transforms.
+  ///
+  /// This is much faster than calling InstantiatePrefab() for every transform, see ezWorldReader::InstantiatePrefabs() for details.
+  void InstantiatePrefabs(ezWorld& ref_world, ezArrayPtr<const ezTransform> rootTransforms, const ezPrefabInstantiationOptions& options);
+
   void ApplyExposedParameterValues(const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, const ezDynamicArray<ezGameObject*>& createdChildObjects, const ezDynamicArray<ezGameObject*>& createdRootObjects) const;
 
 private:
@@ -247,6 +247,9 @@ void ezResource::SetPriority(ezResourcePriority priority)
 
   m_Priority = priority;
 
+  // if the resource is waiting to be loaded, its position in the queue changes right away
+  ezResourceManager::UpdateLoadingPriority(this);
+
   ezResourceEvent e;
   e.m_pResource = this;
   e.m_Type = ezResourceEvent::Type::ResourcePriorityChanged;
@@ -3,6 +3,7 @@
 #include <Core/ResourceManager/Implementation/ResourceManagerState.h>
 #include <Core/ResourceManager/ResourceManager.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Utilities/Stats.h>
 
 ezTypelessResourceHandle ezResourceManager::LoadResourceByType(const ezRTTI* pResourceType, ezStringView sResourceID)
 {
@@ -128,68 +129,111 @@ void ezResourceManager::RunWorkerTask()
   }
 }
 
-void ezResourceManager::ReverseBubbleSortStep(ezDeque<LoadingInfo>& data)
+void ezResourceManager::UpdateLoadingDeadlines()
 {
-  // Yep, it's really bubble sort!
-  // This will move the entry with the smallest value to the front and move all other values closer to their correct position,
-  // which is exactly what we need for the priority queue.
-  // We do this once a frame, which gives us nice iterative sorting, with relatively deterministic performance characteristics.
+  if (s_pState->m_LoadingQueue.IsEmpty())
+    return;
 
   EZ_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "Calling code must acquire s_ResourceMutex");
 
-  const ezUInt32 uiCount = data.GetCount();
+  EZ_PROFILE_SCOPE("UpdateLoadingDeadlines");
+
+  // The loading priority also depends on how recently a resource was acquired, which changes over time without any notification.
+  // Therefore a few entries are re-evaluated every time. Each update moves the entry to its correct position in the heap right away.
+
+  const ezUInt32 uiCount = s_pState->m_LoadingQueue.GetCount();
 
-  for (ezUInt32 i = uiCount; i > 1; --i)
+  if (s_pState->m_uiLastResourcePriorityUpdateIdx >= uiCount)
   {
-    const ezUInt32 idx2 = i - 1;
-    const ezUInt32 idx1 = i - 2;
+    s_pState->m_uiLastResourcePriorityUpdateIdx = 0;
+  }
 
-    if (data[idx1].m_fPriority > data[idx2].m_fPriority)
-    {
-      ezMath::Swap(data[idx1], data[idx2]);
-    }
+  const ezUInt32 uiUpdateCount = ezMath::Min(50u, uiCount - s_pState->m_uiLastResourcePriorityUpdateIdx);
+
+  // updating an entry moves it within the heap, so first gather which resources to update
+  ezHybridArray<ezResource*, 50> resourcesToUpdate;
+  for (ezUInt32 i = 0; i < uiUpdateCount; ++i)
+  {
+    resourcesToUpdate.PushBack(s_pState->m_LoadingQueue.GetResource(s_pState->m_uiLastResourcePriorityUpdateIdx + i));
+  }
+
+  s_pState->m_uiLastResourcePriorityUpdateIdx += uiUpdateCount;
+
+  const ezTime tNow = ezTime::Now();
+
+  for (ezResource* pResource : resourcesToUpdate)
+  {
+    s_pState->m_LoadingQueue.UpdatePriority(pResource, pResource->GetLoadingPriority(tNow));
   }
 }
 
-void ezResourceManager::UpdateLoadingDeadlines()
+void ezResourceManager::UpdateLoadingPriority(ezResource* pResource)
 {
-  if (s_pState->m_LoadingQueue.IsEmpty())
+  // accessing IsQueuedForLoading without a lock here is safe, the queue itself is only checked inside the lock
+  if (!IsQueuedForLoading(pResource))
     return;
 
+  EZ_LOCK(s_ResourceMutex);
+
+  s_pState->m_LoadingQueue.UpdatePriority(pResource, pResource->GetLoadingPriority(ezTime::Now()));
+}
+
+void ezResourceManager::ReportLoadingFinished(ezResourcePriority priority, ezTime loadingTime)
+{
   EZ_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "Calling code must acquire s_ResourceMutex");
 
-  EZ_PROFILE_SCOPE("UpdateLoadingDeadlines");
+  auto& stats = s_pState->m_LoadingStats[(int)priority];
 
-  const ezUInt32 uiCount = s_pState->m_LoadingQueue.GetCount();
-  s_pState->m_uiLastResourcePriorityUpdateIdx = ezMath::Min(s_pState->m_uiLastResourcePriorityUpdateIdx, uiCount);
+  if (stats.m_uiNumLoaded == 0)
+  {
+    stats.m_AverageLoadingTime = loadingTime;
+  }
+  else
+  {
+    // exponential moving average, so that the stat follows the current situation
+    stats.m_AverageLoadingTime += (loadingTime - stats.m_AverageLoadingTime) * 0.1;
+  }
+
+  ++stats.m_uiNumLoaded;
+  stats.m_bModified = true;
+  s_pState->m_bLoadingStatsModified = true;
+}
 
-  ezUInt32 uiUpdateCount = ezMath::Min(50u, uiCount - s_pState->m_uiLastResourcePriorityUpdateIdx);
+void ezResourceManager::UpdateLoadingStats()
+{
+  // reading these without the lock is fine, a change is picked up in the next frame at the latest
+  if (s_pState->m_LoadingQueue.IsEmpty() && s_pState->m_uiReportedLoadingQueueCount == 0 && !s_pState->m_bLoadingStatsModified)
+    return;
 
-  if (uiUpdateCount == 0)
+  EZ_LOCK(s_ResourceMutex);
+
+  if (s_pState->m_uiReportedLoadingQueueCount != s_pState->m_LoadingQueue.GetCount())
   {
-    s_pState->m_uiLastResourcePriorityUpdateIdx = 0;
-    uiUpdateCount = ezMath::Min(50u, uiCount - s_pState->m_uiLastResourcePriorityUpdateIdx);
+    s_pState->m_uiReportedLoadingQueueCount = s_pState->m_LoadingQueue.GetCount();
+    ezStats::SetStat("Resource Manager/Loading Queue Count", s_pState->m_uiReportedLoadingQueueCount);
   }
 
-  if (uiUpdateCount > 0)
+  if (!s_pState->m_bLoadingStatsModified)
+    return;
+
+  s_pState->m_bLoadingStatsModified = false;
+
+  const char* szPriorityNames[] = {"Critical", "VeryHigh", "High", "Medium", "Low", "VeryLow"};
+  static_assert(EZ_ARRAY_SIZE(szPriorityNames) == EZ_ARRAY_SIZE(s_pState->m_LoadingStats));
+
+  ezStringBuilder sStatName;
+
+  for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(s_pState->m_LoadingStats); ++i)
   {
-    {
-      EZ_PROFILE_SCOPE("EvalLoadingDeadlines");
+    auto& stats = s_pState->m_LoadingStats[i];
 
-      const ezTime tNow = ezTime::Now();
+    if (!stats.m_bModified)
+      continue;
 
-      for (ezUInt32 i = 0; i < uiUpdateCount; ++i)
-      {
-        auto& element = s_pState->m_LoadingQueue[s_pState->m_uiLastResourcePriorityUpdateIdx];
-        element.m_fPriority = element.m_pResource->GetLoadingPriority(tNow);
-        ++s_pState->m_uiLastResourcePriorityUpdateIdx;
-      }
-    }
+    stats.m_bModified = false;
 
-    {
-      EZ_PROFILE_SCOPE("SortLoadingDeadlines");
-      ReverseBubbleSortStep(s_pState->m_LoadingQueue);
-    }
+    sStatName.SetFormat("Resource Manager/Time To Load (ms)/{0}", szPriorityNames[i]);
+    ezStats::SetStat(sStatName, stats.m_AverageLoadingTime.GetMilliseconds());
   }
 }
 
@@ -221,10 +265,7 @@ ezResult ezResourceManager::RemoveFromLoadingQueue(ezResource* pResource)
   if (!IsQueuedForLoading(pResource))
     return EZ_SUCCESS;
 
-  LoadingInfo li;
-  li.m_pResource = pResource;
-
-  if (s_pState->m_LoadingQueue.RemoveAndSwap(li))
+  if (s_pState->m_LoadingQueue.Remove(pResource))
   {
     pResource->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
     return EZ_SUCCESS;
@@ -240,19 +281,14 @@ void ezResourceManager::AddToLoadingQueue(ezResource* pResource, bool bHighestPr
 
   pResource->m_Flags.Add(ezResourceFlags::IsQueuedForLoading);
 
-  LoadingInfo li;
-  li.m_pResource = pResource;
-
   if (bHighestPriority)
   {
     pResource->SetPriority(ezResourcePriority::Critical);
-    li.m_fPriority = 0.0f;
-    s_pState->m_LoadingQueue.PushFront(li);
+    s_pState->m_LoadingQueue.Insert(pResource, 0.0f, true, ezTime::Now());
   }
   else
   {
-    li.m_fPriority = pResource->GetLoadingPriority(s_pState->m_LastFrameUpdate);
-    s_pState->m_LoadingQueue.PushBack(li);
+    s_pState->m_LoadingQueue.Insert(pResource, pResource->GetLoadingPriority(s_pState->m_LastFrameUpdate), false, ezTime::Now());
   }
 }
 
@@ -285,10 +321,7 @@ bool ezResourceManager::ReloadResource(ezResource* pResource, bool bForce)
   {
     bAllowPreloading = false;
 
-    LoadingInfo li;
-    li.m_pResource = pResource;
-
-    if (s_pState->m_LoadingQueue.IndexOf(li) == ezInvalidIndex)
+    if (!s_pState->m_LoadingQueue.Contains(pResource))
     {
       // the resource is marked as 'loading' but it is not in the queue anymore
       // that means some task is already working on loading it
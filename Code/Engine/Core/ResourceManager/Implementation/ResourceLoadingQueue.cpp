@@ -0,0 +1,149 @@
+#include <Core/CorePCH.h>
+
+#include <Core/ResourceManager/Implementation/ResourceLoadingQueue.h>
+#include <Core/ResourceManager/Resource.h>
+
+bool ezResourceLoadingQueue::Contains(const ezResource* pResource) const
+{
+  const ezUInt32 uiIndex = pResource->m_uiLoadingQueueIndex;
+  return uiIndex < m_Heap.GetCount() && m_Heap[uiIndex].m_pResource == pResource;
+}
+
+void ezResourceLoadingQueue::Insert(ezResource* pResource, float fPriority, bool bFront, ezTime queuedTime)
+{
+  EZ_ASSERT_DEBUG(!Contains(pResource), "Resource is already in the loading queue");
+
+  Entry entry;
+  entry.m_fPriority = fPriority;
+  entry.m_iSequence = bFront ? m_iNextFrontSequence-- : m_iNextBackSequence++;
+  entry.m_pResource = pResource;
+  entry.m_QueuedTime = queuedTime;
+
+  const ezUInt32 uiIndex = m_Heap.GetCount();
+  m_Heap.PushBack(entry);
+  pResource->m_uiLoadingQueueIndex = uiIndex;
+
+  SiftUp(uiIndex);
+}
+
+bool ezResourceLoadingQueue::Remove(ezResource* pResource)
+{
+  if (!Contains(pResource))
+    return false;
+
+  RemoveAt(pResource->m_uiLoadingQueueIndex);
+  return true;
+}
+
+void ezResourceLoadingQueue::UpdatePriority(ezResource* pResource, float fPriority)
+{
+  if (!Contains(pResource))
+    return;
+
+  const ezUInt32 uiIndex = pResource->m_uiLoadingQueueIndex;
+  Entry& entry = m_Heap[uiIndex];
+
+  if (entry.m_fPriority == fPriority)
+    return;
+
+  const bool bMovesUp = fPriority < entry.m_fPriority;
+  entry.m_fPriority = fPriority;
+
+  if (bMovesUp)
+    SiftUp(uiIndex);
+  else
+    SiftDown(uiIndex);
+}
+
+ezResourceLoadingQueue::Entry ezResourceLoadingQueue::PopFront()
+{
+  EZ_ASSERT_DEBUG(!m_Heap.IsEmpty(), "The loading queue is empty");
+
+  Entry front = m_Heap[0];
+  RemoveAt(0);
+  return front;
+}
+
+void ezResourceLoadingQueue::Clear()
+{
+  for (const Entry& entry : m_Heap)
+  {
+    entry.m_pResource->m_uiLoadingQueueIndex = ezInvalidIndex;
+  }
+
+  m_Heap.Clear();
+  m_iNextBackSequence = 0;
+  m_iNextFrontSequence = -1;
+}
+
+EZ_ALWAYS_INLINE void ezResourceLoadingQueue::SetEntry(ezUInt32 uiIndex, const Entry& entry)
+{
+  m_Heap[uiIndex] = entry;
+  entry.m_pResource->m_uiLoadingQueueIndex = uiIndex;
+}
+
+void ezResourceLoadingQueue::SiftUp(ezUInt32 uiIndex)
+{
+  const Entry entry = m_Heap[uiIndex];
+
+  while (uiIndex > 0)
+  {
+    const ezUInt32 uiParent = (uiIndex - 1) / 2;
+
+    if (!(entry < m_Heap[uiParent]))
+      break;
+
+    SetEntry(uiIndex, m_Heap[uiParent]);
+    uiIndex = uiParent;
+  }
+
+  SetEntry(uiIndex, entry);
+}
+
+void ezResourceLoadingQueue::SiftDown(ezUInt32 uiIndex)
+{
+  const ezUInt32 uiCount = m_Heap.GetCount();
+  const Entry entry = m_Heap[uiIndex];
+
+  while (true)
+  {
+    ezUInt32 uiChild = uiIndex * 2 + 1;
+
+    if (uiChild >= uiCount)
+      break;
+
+    if (uiChild + 1 < uiCount && m_Heap[uiChild + 1] < m_Heap[uiChild])
+      ++uiChild;
+
+    if (!(m_Heap[uiChild] < entry))
+      break;
+
+    SetEntry(uiIndex, m_Heap[uiChild]);
+    uiIndex = uiChild;
+  }
+
+  SetEntry(uiIndex, entry);
+}
+
+void ezResourceLoadingQueue::RemoveAt(ezUInt32 uiIndex)
+{
+  m_Heap[uiIndex].m_pResource->m_uiLoadingQueueIndex = ezInvalidIndex;
+
+  const ezUInt32 uiLast = m_Heap.GetCount() - 1;
+
+  if (uiIndex != uiLast)
+  {
+    const bool bMovesUp = m_Heap[uiLast] < m_Heap[uiIndex];
+    SetEntry(uiIndex, m_Heap[uiLast]);
+    m_Heap.PopBack();
+
+    if (bMovesUp)
+      SiftUp(uiIndex);
+    else
+      SiftDown(uiIndex);
+  }
+  else
+  {
+    m_Heap.PopBack();
+  }
+}
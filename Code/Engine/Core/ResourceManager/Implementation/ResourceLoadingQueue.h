@@ -0,0 +1,64 @@
+#pragma once
+
+#include <Core/ResourceManager/Implementation/Declarations.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Time/Time.h>
+
+/// \brief [internal] Priority queue of all resources that are waiting for a data load task.
+///
+/// The queue is a binary min-heap, resources with lower priority values are loaded first. Resources with equal priority are loaded
+/// in the order in which they were added, except for those that were added to the front, which are loaded in reverse order.
+/// Every queued resource stores its position in the heap, therefore changing its priority or removing it from the queue takes O(log n)
+/// and never requires to search the queue.
+///
+/// All functions must be called while holding ezResourceManager::s_ResourceMutex.
+class EZ_CORE_DLL ezResourceLoadingQueue
+{
+public:
+  struct Entry
+  {
+    float m_fPriority = 0.0f;
+    ezInt64 m_iSequence = 0;
+    ezResource* m_pResource = nullptr;
+    ezTime m_QueuedTime;
+
+    EZ_ALWAYS_INLINE bool operator<(const Entry& rhs) const
+    {
+      return m_fPriority < rhs.m_fPriority || (m_fPriority == rhs.m_fPriority && m_iSequence < rhs.m_iSequence);
+    }
+  };
+
+  EZ_ALWAYS_INLINE bool IsEmpty() const { return m_Heap.IsEmpty(); }
+  EZ_ALWAYS_INLINE ezUInt32 GetCount() const { return m_Heap.GetCount(); }
+
+  /// \brief Returns the resource at the given position in the heap. The order is not sorted, this is only meant for iterating over all entries.
+  EZ_ALWAYS_INLINE ezResource* GetResource(ezUInt32 uiIndex) const { return m_Heap[uiIndex].m_pResource; }
+
+  /// \brief Returns whether the resource is currently in the queue.
+  bool Contains(const ezResource* pResource) const;
+
+  /// \brief Adds the resource to the queue. If bFront is true, it is loaded before all other resources with the same priority.
+  void Insert(ezResource* pResource, float fPriority, bool bFront, ezTime queuedTime);
+
+  /// \brief Removes the resource from the queue. Returns false, if it was not in the queue.
+  bool Remove(ezResource* pResource);
+
+  /// \brief Moves the resource to the position in the queue that corresponds to its new priority. Does nothing, if the resource is not in the queue.
+  void UpdatePriority(ezResource* pResource, float fPriority);
+
+  /// \brief Returns the entry with the lowest priority value and removes it from the queue.
+  Entry PopFront();
+
+  /// \brief Removes all entries.
+  void Clear();
+
+private:
+  void SetEntry(ezUInt32 uiIndex, const Entry& entry);
+  void SiftUp(ezUInt32 uiIndex);
+  void SiftDown(ezUInt32 uiIndex);
+  void RemoveAt(ezUInt32 uiIndex);
+
+  ezDynamicArray<Entry> m_Heap;
+  ezInt64 m_iNextBackSequence = 0;
+  ezInt64 m_iNextFrontSequence = -1;
+};
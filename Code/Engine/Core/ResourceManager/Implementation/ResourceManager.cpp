@@ -446,6 +446,8 @@ void ezResourceManager::PerFrameUpdate()
 
   s_pState->m_LastFrameUpdate = ezClock::GetGlobalClock()->GetLastUpdateTime();
 
+  UpdateLoadingStats();
+
   if (s_pState->m_bBroadcastExistsEvent)
   {
     EZ_LOCK(s_ResourceMutex);
@@ -573,9 +575,9 @@ void ezResourceManager::EngineAboutToShutdown()
   {
     EZ_LOCK(s_ResourceMutex);
 
-    for (auto entry : s_pState->m_LoadingQueue)
+    for (ezUInt32 i = 0; i < s_pState->m_LoadingQueue.GetCount(); ++i)
     {
-      entry.m_pResource->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
+      s_pState->m_LoadingQueue.GetResource(i)->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
     }
 
     s_pState->m_LoadingQueue.Clear();
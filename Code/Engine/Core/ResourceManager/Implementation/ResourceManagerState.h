@@ -3,6 +3,7 @@
 #include <Core/CoreInternal.h>
 EZ_CORE_INTERNAL_HEADER
 
+#include <Core/ResourceManager/Implementation/ResourceLoadingQueue.h>
 #include <Core/ResourceManager/ResourceManager.h>
 
 class ezResourceManagerState
@@ -51,7 +52,19 @@ private:
   ezUInt32 m_uiForceNoFallbackAcquisition = 0;
 
   // resources in this queue are waiting for a task to load them
-  ezDeque<ezResourceManager::LoadingInfo> m_LoadingQueue;
+  ezResourceLoadingQueue m_LoadingQueue;
+
+  struct LoadingStats
+  {
+    ezTime m_AverageLoadingTime;
+    ezUInt32 m_uiNumLoaded = 0;
+    bool m_bModified = false;
+  };
+
+  // time from entering the loading queue until the content is updated, per ezResourcePriority band
+  LoadingStats m_LoadingStats[(int)ezResourcePriority::VeryLow + 1];
+  bool m_bLoadingStatsModified = false;
+  ezUInt32 m_uiReportedLoadingQueueCount = ezInvalidIndex; // forces the stat to be published once, even if nothing is ever queued
 
   ezHashTable<const ezRTTI*, ezResourceManager::LoadedResources> m_LoadedResources;
 
@@ -15,6 +15,7 @@ void ezResourceManagerWorkerDataLoad::Execute()
   ezResource* pResourceToLoad = nullptr;
   ezResourceTypeLoader* pLoader = nullptr;
   ezUniquePtr<ezResourceTypeLoader> pCustomLoader;
+  ezTime queuedTime;
 
   {
     EZ_LOCK(ezResourceManager::s_ResourceMutex);
@@ -27,9 +28,9 @@ void ezResourceManagerWorkerDataLoad::Execute()
 
     ezResourceManager::UpdateLoadingDeadlines();
 
-    auto it = ezResourceManager::s_pState->m_LoadingQueue.PeekFront();
-    pResourceToLoad = it.m_pResource;
-    ezResourceManager::s_pState->m_LoadingQueue.PopFront();
+    const ezResourceLoadingQueue::Entry entry = ezResourceManager::s_pState->m_LoadingQueue.PopFront();
+    pResourceToLoad = entry.m_pResource;
+    queuedTime = entry.m_QueuedTime;
 
     if (pResourceToLoad->m_Flags.IsSet(ezResourceFlags::HasCustomDataLoader))
     {
@@ -94,6 +95,7 @@ void ezResourceManagerWorkerDataLoad::Execute()
     pUpdateContentTask->m_pLoader = pLoader;
     pUpdateContentTask->m_pCustomLoader = std::move(pCustomLoader);
     pUpdateContentTask->m_pResourceToLoad = pResourceToLoad;
+    pUpdateContentTask->m_QueuedTime = queuedTime;
 
     // schedule the task to run, either on the main thread or on some other thread
     *pUpdateContentGroup = ezTaskSystem::StartSingleTask(
@@ -154,6 +156,8 @@ void ezResourceManagerWorkerUpdateContent::Execute()
     EZ_ASSERT_DEV(ezResourceManager::IsQueuedForLoading(m_pResourceToLoad), "Multi-threaded access detected");
     m_pResourceToLoad->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
     m_pResourceToLoad->m_LastAcquire = ezResourceManager::GetLastFrameUpdate();
+
+    ezResourceManager::ReportLoadingFinished(m_pResourceToLoad->GetPriority(), ezTime::Now() - m_QueuedTime);
   }
 
   m_pLoader = nullptr;
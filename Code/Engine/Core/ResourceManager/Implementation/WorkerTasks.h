@@ -29,6 +29,7 @@ public:
 
   ezResourceLoadData m_LoaderData;
   ezResource* m_pResourceToLoad = nullptr;
+  ezTime m_QueuedTime; // when the resource was added to the loading queue, used for the loading time stats
   ezResourceTypeLoader* m_pLoader = nullptr;
   // this is only used to clean up a custom loader at the right time, if one is used
   // m_pLoader is always set, no need to go through m_pCustomLoader
@@ -144,6 +144,7 @@ private:
   friend class ezResourceManager;
   friend class ezResourceManagerWorkerDataLoad;
   friend class ezResourceManagerWorkerUpdateContent;
+  friend class ezResourceLoadingQueue;
 
   /// \brief Called by ezResourceManager shortly after resource creation.
   void SetUniqueID(ezStringView sUniqueID, bool bIsReloadable);
@@ -236,6 +237,7 @@ private:
 
   ezTime m_LastAcquire;
   ezResourcePriority m_Priority = ezResourcePriority::Medium;
+  ezUInt32 m_uiLoadingQueueIndex = ezInvalidIndex; // position in the loading queue heap, only valid while it is queued
   ezTimestamp m_LoadedFileModificationTime;
 
 private:
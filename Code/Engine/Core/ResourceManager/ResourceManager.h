@@ -454,14 +454,6 @@ private:
     ezHashTable<ezTempHashedString, ezResource*> m_Resources;
   };
 
-  struct LoadingInfo
-  {
-    float m_fPriority = 0;
-    ezResource* m_pResource = nullptr;
-
-    EZ_ALWAYS_INLINE bool operator==(const LoadingInfo& rhs) const { return m_pResource == rhs.m_pResource; }
-    EZ_ALWAYS_INLINE bool operator<(const LoadingInfo& rhs) const { return m_fPriority < rhs.m_fPriority; }
-  };
   static void EnsureResourceLoadingState(ezResource* pResource, const ezResourceState RequestedState);
   static void PreloadResource(ezResource* pResource);
   static void InternalPreloadResource(ezResource* pResource, bool bHighestPriority);
@@ -471,7 +463,9 @@ private:
   static ezResource* GetResource(const ezRTTI* pRtti, ezStringView sResourceID, bool bIsReloadable);
   static void RunWorkerTask();
   static void UpdateLoadingDeadlines();
-  static void ReverseBubbleSortStep(ezDeque<LoadingInfo>& data);
+  static void UpdateLoadingPriority(ezResource* pResource);
+  static void ReportLoadingFinished(ezResourcePriority priority, ezTime loadingTime);
+  static void UpdateLoadingStats();
   static bool ReloadResource(ezResource* pResource, bool bForce);
 
   static void SetupWorkerTasks();
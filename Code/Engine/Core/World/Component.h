@@ -104,6 +104,14 @@ public:
   /// will be initialized after creation, even if they were already in an initialized state when they were serialized.
   virtual void DeserializeComponent(ezWorldReader& inout_stream);
 
+  /// \brief Override this to copy the state that DeserializeComponent() reads from another component of the same type.
+  ///
+  /// ezWorldReader::InstantiatePrefabs() uses this to set up many instances of the same prefab without deserializing every one of them.
+  /// The other component may already be initialized, so only the deserialized state must be copied.
+  /// Components that store handles to other objects or components must not implement this, since the handles would point into the other instance.
+  /// Returns false if copying is not supported, in which case the component is deserialized as usual.
+  virtual bool CopyDeserializedState(const ezComponent& other);
+
 
   /// \brief Ensures that the component is initialized. Must only be called from another component's Initialize callback.
   void EnsureInitialized();
@@ -217,6 +217,7 @@ struct ezObjectFlags
     ParentChangesNotifications = EZ_BIT(12),          ///< The object should send a notification message when the parent is changes.
 
     CreatedByPrefab = EZ_BIT(13),                     ///< Such flagged objects and components are ignored during scene export (see ezWorldWriter) and will be removed when a prefab needs to be re-instantiated.
+    StaticTransformDirty = EZ_BIT(14),                ///< The static object's transform was changed with UpdateBehaviorIfStatic::UpdateDeferred and is updated during the next world update.
 
     UserFlag0 = EZ_BIT(24),
     UserFlag1 = EZ_BIT(25),
@@ -247,8 +248,9 @@ struct ezObjectFlags
     StorageType ParentChangesNotifications : 1;          //< 12
 
     StorageType CreatedByPrefab : 1;                     //< 13
+    StorageType StaticTransformDirty : 1;                //< 14
 
-    StorageType Padding : 10;                            // 14 - 23
+    StorageType Padding : 9;                             // 15 - 23
 
     StorageType UserFlag0 : 1;                           //< 24
     StorageType UserFlag1 : 1;                           //< 25
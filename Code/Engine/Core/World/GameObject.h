@@ -231,6 +231,7 @@ public:
   {
     None,              ///< Only sets the local transform, does not update
     UpdateImmediately, ///< Updates the hierarchy underneath the object immediately
+    UpdateDeferred,    ///< Updates the hierarchy underneath the object once during the next world update, no matter how often it is changed until then
   };
 
   /// \brief Changes the position of the object local to its parent.
@@ -383,7 +384,7 @@ public:
   ezArrayPtr<const ezComponent* const> GetComponents() const;
 
   /// \brief Returns the current version of components attached to this object.
-  /// This version is increased whenever components are added or removed and can be used for cache validation.
+  /// This version is increased whenever components are added or removed, or when a static object is moved, and can be used for cache validation.
   ezUInt16 GetComponentVersion() const;
 
 
@@ -546,6 +547,8 @@ private:
 
   void UpdateGlobalTransformAndBoundsRecursive();
   void UpdateLastGlobalTransform();
+  void UpdateStaticTransform(UpdateBehaviorIfStatic updateBehavior);
+  void MarkStaticTransformDirty();
 
   void OnMsgDeleteGameObject(ezMsgDeleteGameObject& msg);
 
@@ -61,6 +61,12 @@ void ezComponent::DeserializeComponent(ezWorldReader& inout_stream)
   EZ_IGNORE_UNUSED(inout_stream);
 }
 
+bool ezComponent::CopyDeserializedState(const ezComponent& other)
+{
+  EZ_IGNORE_UNUSED(other);
+  return false;
+}
+
 void ezComponent::EnsureInitialized()
 {
   EZ_ASSERT_DEV(m_pOwner != nullptr, "Owner must not be null");
@@ -273,6 +273,9 @@ void ezGameObject::UpdateGlobalTransformAndBoundsRecursive()
     ezLog::Error("Static object '{0}' was moved during runtime.", GetName());
   }
 
+  // this also covers all queued changes of this object and its children
+  m_Flags.Remove(ezObjectFlags::StaticTransformDirty);
+
   ezSimdTransform oldGlobalTransform = GetGlobalTransformSimd();
 
   m_pTransformationData->UpdateGlobalTransformNonRecursive(GetWorld()->GetUpdateCounter());
@@ -286,13 +289,19 @@ void ezGameObject::UpdateGlobalTransformAndBoundsRecursive()
     m_pTransformationData->UpdateGlobalBounds();
   }
 
-  if (IsStatic() && m_Flags.IsSet(ezObjectFlags::StaticTransformChangesNotifications) && oldGlobalTransform != GetGlobalTransformSimd())
+  if (IsStatic() && oldGlobalTransform != GetGlobalTransformSimd())
   {
-    ezMsgTransformChanged msg;
-    msg.m_OldGlobalTransform = ezSimdConversion::ToTransform(oldGlobalTransform);
-    msg.m_NewGlobalTransform = GetGlobalTransform();
+    // data that was cached for the static object, e.g. render data, contains the old transform and must not be used anymore
+    m_Components.GetUserData<ComponentUserData>().m_uiVersion++;
+
+    if (m_Flags.IsSet(ezObjectFlags::StaticTransformChangesNotifications))
+    {
+      ezMsgTransformChanged msg;
+      msg.m_OldGlobalTransform = ezSimdConversion::ToTransform(oldGlobalTransform);
+      msg.m_NewGlobalTransform = GetGlobalTransform();
 
-    SendMessage(msg);
+      SendMessage(msg);
+    }
   }
 
   for (auto it = GetChildren(); it.IsValid(); ++it)
@@ -301,6 +310,15 @@ void ezGameObject::UpdateGlobalTransformAndBoundsRecursive()
   }
 }
 
+void ezGameObject::MarkStaticTransformDirty()
+{
+  if (m_Flags.IsSet(ezObjectFlags::StaticTransformDirty))
+    return;
+
+  m_Flags.Add(ezObjectFlags::StaticTransformDirty);
+  GetWorld()->AddStaticObjectWithDirtyTransform(GetHandle());
+}
+
 void ezGameObject::UpdateLastGlobalTransform()
 {
   m_pTransformationData->UpdateLastGlobalTransform(GetWorld()->GetUpdateCounter());
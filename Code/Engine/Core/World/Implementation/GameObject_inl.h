@@ -273,13 +273,25 @@ EZ_ALWAYS_INLINE ezTransform ezGameObject::GetLastGlobalTransform() const
 }
 
 
+EZ_ALWAYS_INLINE void ezGameObject::UpdateStaticTransform(UpdateBehaviorIfStatic updateBehavior)
+{
+  if (updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
+  {
+    UpdateGlobalTransformAndBoundsRecursive();
+  }
+  else if (updateBehavior == UpdateBehaviorIfStatic::UpdateDeferred)
+  {
+    MarkStaticTransformDirty();
+  }
+}
+
 EZ_ALWAYS_INLINE void ezGameObject::SetLocalPosition(const ezSimdVec4f& vPosition, UpdateBehaviorIfStatic updateBehavior)
 {
   m_pTransformationData->m_localPosition = vPosition;
 
-  if (IsStatic() && updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
+  if (IsStatic())
   {
-    UpdateGlobalTransformAndBoundsRecursive();
+    UpdateStaticTransform(updateBehavior);
   }
 }
 
@@ -293,9 +305,9 @@ EZ_ALWAYS_INLINE void ezGameObject::SetLocalRotation(const ezSimdQuat& qRotation
 {
   m_pTransformationData->m_localRotation = qRotation;
 
-  if (IsStatic() && updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
+  if (IsStatic())
   {
-    UpdateGlobalTransformAndBoundsRecursive();
+    UpdateStaticTransform(updateBehavior);
   }
 }
 
@@ -311,9 +323,9 @@ EZ_ALWAYS_INLINE void ezGameObject::SetLocalScaling(const ezSimdVec4f& vScaling,
   m_pTransformationData->m_localScaling = vScaling;
   m_pTransformationData->m_localScaling.SetW(uniformScale);
 
-  if (IsStatic() && updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
+  if (IsStatic())
   {
-    UpdateGlobalTransformAndBoundsRecursive();
+    UpdateStaticTransform(updateBehavior);
   }
 }
 
@@ -327,9 +339,9 @@ EZ_ALWAYS_INLINE void ezGameObject::SetLocalUniformScaling(const ezSimdFloat& fS
 {
   m_pTransformationData->m_localScaling.SetW(fScaling);
 
-  if (IsStatic() && updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
+  if (IsStatic())
   {
-    UpdateGlobalTransformAndBoundsRecursive();
+    UpdateStaticTransform(updateBehavior);
   }
 }
 
@@ -47,6 +47,42 @@ void ezSpatialSystem::FindObjectsInBox(const ezBoundingBox& box, const QueryPara
     });
 }
 
+void ezSpatialSystem::FindObjectsInSpheres(ezArrayPtr<const ezBoundingSphere> spheres, const QueryParams& queryParams, BatchQueryCallback callback) const
+{
+  for (ezUInt32 i = 0; i < spheres.GetCount(); ++i)
+  {
+    FindObjectsInSphere(
+      spheres[i], queryParams,
+      [&](ezGameObject* pObject)
+      {
+        return callback(i, pObject);
+      });
+  }
+}
+
+void ezSpatialSystem::FindObjectsInBoxes(ezArrayPtr<const ezBoundingBox> boxes, const QueryParams& queryParams, BatchQueryCallback callback) const
+{
+  for (ezUInt32 i = 0; i < boxes.GetCount(); ++i)
+  {
+    FindObjectsInBox(
+      boxes[i], queryParams,
+      [&](ezGameObject* pObject)
+      {
+        return callback(i, pObject);
+      });
+  }
+}
+
+void ezSpatialSystem::FindVisibleObjects(ezArrayPtr<const ezFrustum> frustums, const QueryParams& queryParams, ezArrayPtr<ezDynamicArray<const ezGameObject*>> out_objects, ezVisibilityState visType) const
+{
+  EZ_ASSERT_DEV(frustums.GetCount() == out_objects.GetCount(), "Need exactly one output array per frustum");
+
+  for (ezUInt32 i = 0; i < frustums.GetCount(); ++i)
+  {
+    FindVisibleObjects(frustums[i], queryParams, out_objects[i], {}, visType);
+  }
+}
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
 void ezSpatialSystem::GetInternalStats(ezStringBuilder& ref_sSb) const
 {
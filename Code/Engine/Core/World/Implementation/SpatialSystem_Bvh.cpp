@@ -0,0 +1,1593 @@
+#include <Core/CorePCH.h>
+
+#include <Core/World/SpatialSystem_Bvh.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  // Number of query shapes or frustums that are tested together in one tree traversal, limited by the bits in a query mask
+  constexpr ezUInt32 s_uiQueryBatchSize = 32;
+
+  // Cost of testing an object relative to the cost of visiting a node. Objects in a leaf are tested with a linear scan over
+  // contiguous memory, which is a lot cheaper than following the child indices of a node.
+  constexpr float s_fObjectTestCost = 0.125f;
+
+  // A moving object stays in its leaf as long as the leaf doesn't get bigger than this factor times its surface area when it was last fitted
+  // to its objects
+  constexpr float s_fMaxLeafGrowth = 2.0f;
+
+  EZ_ALWAYS_INLINE float GetSurfaceArea(const ezSimdBBox& box)
+  {
+    const ezSimdVec4f vExtents = box.GetExtents();
+    return vExtents.Dot<3>(vExtents.Get<ezSwizzle::YZXW>());
+  }
+
+  EZ_ALWAYS_INLINE ezSimdBBox GetMergedBounds(const ezSimdBBox& a, const ezSimdBBox& b)
+  {
+    return ezSimdBBox(a.m_Min.CompMin(b.m_Min), a.m_Max.CompMax(b.m_Max));
+  }
+
+  EZ_ALWAYS_INLINE ezUInt32 GetQueryMask(ezUInt32 uiNumQueries)
+  {
+    return uiNumQueries >= s_uiQueryBatchSize ? 0xFFFFFFFFu : (1u << uiNumQueries) - 1;
+  }
+
+  EZ_ALWAYS_INLINE bool IsFilteredByTags(const ezTagSet& tags, const ezTagSet* pIncludeTags, const ezTagSet* pExcludeTags)
+  {
+    if (pExcludeTags != nullptr && !pExcludeTags->IsEmpty() && pExcludeTags->IsAnySet(tags))
+      return true;
+
+    if (pIncludeTags != nullptr && !pIncludeTags->IsEmpty() && !pIncludeTags->IsAnySet(tags))
+      return true;
+
+    return false;
+  }
+
+  EZ_ALWAYS_INLINE ezSimdBSphere ToSimdShape(const ezBoundingSphere& sphere)
+  {
+    return ezSimdBSphere(ezSimdConversion::ToVec3(sphere.m_vCenter), sphere.m_fRadius);
+  }
+
+  EZ_ALWAYS_INLINE ezSimdBBox ToSimdShape(const ezBoundingBox& box)
+  {
+    return ezSimdBBox(ezSimdConversion::ToVec3(box.m_vMin), ezSimdConversion::ToVec3(box.m_vMax));
+  }
+
+  struct TraversalEntry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiNodeIndex;
+    ezUInt32 m_uiActiveMask; ///< Queries that still need to visit this node
+    ezUInt32 m_uiInsideMask; ///< Frustums that fully contain this node, no need to test its children against them
+  };
+
+  /// \brief A depth first traversal never needs more stack entries than the tree height plus one, so this doesn't need any bounds checks.
+  struct TraversalStack
+  {
+    explicit TraversalStack(ezUInt32 uiTreeHeight)
+    {
+      m_Entries.SetCountUninitialized(uiTreeHeight + 1);
+      m_pEntries = m_Entries.GetData();
+    }
+
+    EZ_ALWAYS_INLINE bool IsEmpty() const { return m_uiCount == 0; }
+    EZ_ALWAYS_INLINE void Push(const TraversalEntry& entry) { m_pEntries[m_uiCount++] = entry; }
+    EZ_ALWAYS_INLINE TraversalEntry Pop() { return m_pEntries[--m_uiCount]; }
+
+    ezHybridArray<TraversalEntry, 64> m_Entries;
+    TraversalEntry* m_pEntries = nullptr;
+    ezUInt32 m_uiCount = 0;
+  };
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+
+struct ezSpatialSystem_Bvh::FrustumPlanes
+{
+  // Planes 4 and 5 are duplicated to fill up a full vector, so all six planes are tested with two operations
+  ezSimdVec4f m_x0x1x2x3;
+  ezSimdVec4f m_y0y1y2y3;
+  ezSimdVec4f m_z0z1z2z3;
+  ezSimdVec4f m_w0w1w2w3;
+
+  ezSimdVec4f m_x4x5x4x5;
+  ezSimdVec4f m_y4y5y4y5;
+  ezSimdVec4f m_z4z5z4z5;
+  ezSimdVec4f m_w4w5w4w5;
+
+  // Absolute normals to compute the projected radius of boxes
+  ezSimdVec4f m_absX0x1x2x3;
+  ezSimdVec4f m_absY0y1y2y3;
+  ezSimdVec4f m_absZ0z1z2z3;
+
+  ezSimdVec4f m_absX4x5x4x5;
+  ezSimdVec4f m_absY4y5y4y5;
+  ezSimdVec4f m_absZ4z5z4z5;
+
+  static FrustumPlanes MakeFromFrustum(const ezFrustum& frustum)
+  {
+    ezSimdVec4f planes[6];
+    for (ezUInt32 i = 0; i < 6; ++i)
+    {
+      planes[i] = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(i).m_vNormal.x)));
+    }
+
+    FrustumPlanes result;
+
+    ezSimdMat4f helperMat;
+    helperMat.SetRows(planes[0], planes[1], planes[2], planes[3]);
+
+    result.m_x0x1x2x3 = helperMat.m_col0;
+    result.m_y0y1y2y3 = helperMat.m_col1;
+    result.m_z0z1z2z3 = helperMat.m_col2;
+    result.m_w0w1w2w3 = helperMat.m_col3;
+
+    helperMat.SetRows(planes[4], planes[5], planes[4], planes[5]);
+
+    result.m_x4x5x4x5 = helperMat.m_col0;
+    result.m_y4y5y4y5 = helperMat.m_col1;
+    result.m_z4z5z4z5 = helperMat.m_col2;
+    result.m_w4w5w4w5 = helperMat.m_col3;
+
+    result.m_absX0x1x2x3 = result.m_x0x1x2x3.Abs();
+    result.m_absY0y1y2y3 = result.m_y0y1y2y3.Abs();
+    result.m_absZ0z1z2z3 = result.m_z0z1z2z3.Abs();
+
+    result.m_absX4x5x4x5 = result.m_x4x5x4x5.Abs();
+    result.m_absY4y5y4y5 = result.m_y4y5y4y5.Abs();
+    result.m_absZ4z5z4z5 = result.m_z4z5z4z5.Abs();
+
+    return result;
+  }
+
+  /// \brief Returns false if the box is completely outside. Sets out_bInside if the box is completely inside.
+  EZ_FORCE_INLINE bool TestBox(const ezSimdBBox& box, bool& out_bInside) const
+  {
+    const ezSimdVec4f vCenter = box.GetCenter();
+    const ezSimdVec4f vHalfExtents = box.GetHalfExtents();
+
+    const ezSimdVec4f pos_xxxx = vCenter.Get<ezSwizzle::XXXX>();
+    const ezSimdVec4f pos_yyyy = vCenter.Get<ezSwizzle::YYYY>();
+    const ezSimdVec4f pos_zzzz = vCenter.Get<ezSwizzle::ZZZZ>();
+
+    const ezSimdVec4f ext_xxxx = vHalfExtents.Get<ezSwizzle::XXXX>();
+    const ezSimdVec4f ext_yyyy = vHalfExtents.Get<ezSwizzle::YYYY>();
+    const ezSimdVec4f ext_zzzz = vHalfExtents.Get<ezSwizzle::ZZZZ>();
+
+    ezSimdVec4f dot_0123;
+    dot_0123 = ezSimdVec4f::MulAdd(pos_xxxx, m_x0x1x2x3, m_w0w1w2w3);
+    dot_0123 = ezSimdVec4f::MulAdd(pos_yyyy, m_y0y1y2y3, dot_0123);
+    dot_0123 = ezSimdVec4f::MulAdd(pos_zzzz, m_z0z1z2z3, dot_0123);
+
+    ezSimdVec4f dot_4545;
+    dot_4545 = ezSimdVec4f::MulAdd(pos_xxxx, m_x4x5x4x5, m_w4w5w4w5);
+    dot_4545 = ezSimdVec4f::MulAdd(pos_yyyy, m_y4y5y4y5, dot_4545);
+    dot_4545 = ezSimdVec4f::MulAdd(pos_zzzz, m_z4z5z4z5, dot_4545);
+
+    ezSimdVec4f radius_0123 = ext_xxxx.CompMul(m_absX0x1x2x3);
+    radius_0123 = ezSimdVec4f::MulAdd(ext_yyyy, m_absY0y1y2y3, radius_0123);
+    radius_0123 = ezSimdVec4f::MulAdd(ext_zzzz, m_absZ0z1z2z3, radius_0123);
+
+    ezSimdVec4f radius_4545 = ext_xxxx.CompMul(m_absX4x5x4x5);
+    radius_4545 = ezSimdVec4f::MulAdd(ext_yyyy, m_absY4y5y4y5, radius_4545);
+    radius_4545 = ezSimdVec4f::MulAdd(ext_zzzz, m_absZ4z5z4z5, radius_4545);
+
+    if ((dot_0123 > radius_0123 || dot_4545 > radius_4545).AnySet<4>())
+      return false;
+
+    out_bInside = (dot_0123 < -radius_0123 && dot_4545 < -radius_4545).AllSet<4>();
+    return true;
+  }
+
+  EZ_FORCE_INLINE bool TestSphere(const ezSimdBSphere& sphere) const
+  {
+    ezSimdVec4f pos_xxxx(sphere.m_CenterAndRadius.x());
+    ezSimdVec4f pos_yyyy(sphere.m_CenterAndRadius.y());
+    ezSimdVec4f pos_zzzz(sphere.m_CenterAndRadius.z());
+    ezSimdVec4f pos_rrrr(sphere.m_CenterAndRadius.w());
+
+    ezSimdVec4f dot_0123;
+    dot_0123 = ezSimdVec4f::MulAdd(pos_xxxx, m_x0x1x2x3, m_w0w1w2w3);
+    dot_0123 = ezSimdVec4f::MulAdd(pos_yyyy, m_y0y1y2y3, dot_0123);
+    dot_0123 = ezSimdVec4f::MulAdd(pos_zzzz, m_z0z1z2z3, dot_0123);
+
+    ezSimdVec4f dot_4545;
+    dot_4545 = ezSimdVec4f::MulAdd(pos_xxxx, m_x4x5x4x5, m_w4w5w4w5);
+    dot_4545 = ezSimdVec4f::MulAdd(pos_yyyy, m_y4y5y4y5, dot_4545);
+    dot_4545 = ezSimdVec4f::MulAdd(pos_zzzz, m_z4z5z4z5, dot_4545);
+
+    return (dot_0123 > pos_rrrr || dot_4545 > pos_rrrr).NoneSet<4>();
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezSpatialSystem_Bvh, 1, ezRTTINoAllocator)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+ezSpatialSystem_Bvh::ezSpatialSystem_Bvh(float fLeafMarginScale /*= 0.25f*/, float fMovePrediction /*= 4.0f*/)
+  : m_AlignedAllocator("Spatial System Aligned", ezFoundation::GetAlignedAllocator())
+  , m_fLeafMarginScale(fLeafMarginScale)
+  , m_fMovePrediction(fMovePrediction)
+  , m_Nodes(&m_AlignedAllocator)
+  , m_LeafSpheres(&m_AlignedAllocator)
+  , m_LeafCategoryBitmasks(&m_Allocator)
+  , m_LeafDataIndices(&m_Allocator)
+  , m_LeafEnlargedBounds(&m_AlignedAllocator)
+  , m_DataTable(&m_Allocator)
+  , m_DataBounds(&m_AlignedAllocator)
+  , m_DataEnlargedBounds(&m_AlignedAllocator)
+  , m_DataTags(&m_Allocator)
+  , m_DataObjects(&m_Allocator)
+  , m_DataCategoryBitmasks(&m_Allocator)
+  , m_DataLastVisibleFrameIdxAndVisType(&m_Allocator)
+  , m_AlwaysVisibleData(&m_Allocator)
+{
+  static_assert(sizeof(Node) == 64);
+}
+
+ezSpatialSystem_Bvh::~ezSpatialSystem_Bvh() = default;
+
+void ezSpatialSystem_Bvh::GetNodeBoxes(ezDynamicArray<ezBoundingBox>& out_boundingBoxes, ezUInt32 uiMaxDepth /*= ezInvalidIndex*/) const
+{
+  if (m_uiRootNode == ezInvalidIndex)
+    return;
+
+  ezHybridArray<ezUInt32, 64> stack;
+  ezHybridArray<ezUInt32, 64> depthStack;
+  stack.PushBack(m_uiRootNode);
+  depthStack.PushBack(0);
+
+  while (!stack.IsEmpty())
+  {
+    const Node& node = m_Nodes[stack.PeekBack()];
+    const ezUInt32 uiDepth = depthStack.PeekBack();
+    stack.PopBack();
+    depthStack.PopBack();
+
+    out_boundingBoxes.PushBack(ezSimdConversion::ToBBox(node.m_Bounds));
+
+    if (!node.IsLeaf() && uiDepth < uiMaxDepth)
+    {
+      stack.PushBack(node.m_uiChild0);
+      stack.PushBack(node.m_uiChild1);
+      depthStack.PushBack(uiDepth + 1);
+      depthStack.PushBack(uiDepth + 1);
+    }
+  }
+}
+
+ezUInt32 ezSpatialSystem_Bvh::GetTreeHeight() const
+{
+  return m_uiRootNode != ezInvalidIndex ? m_Nodes[m_uiRootNode].m_iHeight + 1 : 0;
+}
+
+void ezSpatialSystem_Bvh::StartNewFrame()
+{
+  SUPER::StartNewFrame();
+
+  // New objects are inserted one by one, which builds a much worse tree than building it from all objects at once. It can't create
+  // wide leaves either, so once a significant part of the objects is new, the tree is rebuilt. Moving objects are only re-inserted
+  // locally and the rotations keep the tree in shape, so they don't need a rebuild.
+  const ezUInt32 uiNumObjects = m_DataTable.GetCount() - m_AlwaysVisibleData.GetCount();
+  if (m_uiNumInsertsSinceRebuild > ezMath::Max(uiNumObjects / 4, 256u))
+  {
+    RebuildTree();
+  }
+}
+
+ezSpatialDataHandle ezSpatialSystem_Bvh::CreateSpatialData(const ezSimdBBoxSphere& bounds, ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags)
+{
+  if (uiCategoryBitmask == 0)
+    return ezSpatialDataHandle();
+
+  return AddSpatialData(bounds, pObject, uiCategoryBitmask, tags, false);
+}
+
+ezSpatialDataHandle ezSpatialSystem_Bvh::CreateSpatialDataAlwaysVisible(ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags)
+{
+  if (uiCategoryBitmask == 0)
+    return ezSpatialDataHandle();
+
+  return AddSpatialData(ezSimdBBoxSphere(), pObject, uiCategoryBitmask, tags, true);
+}
+
+void ezSpatialSystem_Bvh::DeleteSpatialData(const ezSpatialDataHandle& hData)
+{
+  Data oldData;
+  EZ_VERIFY(m_DataTable.Remove(hData.GetInternalID(), &oldData), "Invalid spatial data handle");
+
+  const ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+  if (oldData.m_uiNodeIndex == ezInvalidIndex)
+  {
+    m_AlwaysVisibleData.RemoveAndSwap(uiDataIndex);
+  }
+  else
+  {
+    RemoveObject(oldData.m_uiNodeIndex, oldData.m_uiObjectIndex);
+  }
+
+  m_DataTags[uiDataIndex].Clear();
+  m_DataObjects[uiDataIndex] = nullptr;
+}
+
+void ezSpatialSystem_Bvh::UpdateSpatialDataBounds(const ezSpatialDataHandle& hData, const ezSimdBBoxSphere& bounds)
+{
+  Data* pData = nullptr;
+  EZ_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  // No need to update bounds for always visible data
+  if (pData->m_uiNodeIndex == ezInvalidIndex)
+    return;
+
+  const ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+  const ezSimdVec4f vDisplacement = bounds.m_CenterAndRadius - m_DataBounds[uiDataIndex].m_CenterAndRadius;
+  m_DataBounds[uiDataIndex] = bounds;
+
+  m_LeafSpheres[pData->m_uiObjectIndex] = bounds.GetSphere();
+
+  ezSimdBBox& enlargedBounds = m_DataEnlargedBounds[uiDataIndex];
+  if (enlargedBounds.Contains(GetTightBounds(bounds)))
+    return;
+
+  enlargedBounds = GetEnlargedBounds(bounds, vDisplacement);
+  m_LeafEnlargedBounds[pData->m_uiObjectIndex] = enlargedBounds;
+
+  // The leaf encloses all of its objects, so a moving object can often stay where it is
+  const ezUInt32 uiLeafIndex = pData->m_uiNodeIndex;
+  Node& leaf = m_Nodes[uiLeafIndex];
+  if (leaf.m_Bounds.Contains(enlargedBounds))
+    return;
+
+  // Objects that move together, or an object that only moves a bit out of its leaf, are cheaper to handle by growing the leaf.
+  // Only if the leaf would get a lot bigger than it was when it was fitted to its objects, the object is moved to another leaf.
+  if (leaf.m_uiNumObjects > 1)
+  {
+    const ezSimdBBox grownBounds = GetMergedBounds(leaf.m_Bounds, enlargedBounds);
+    if (GetSurfaceArea(grownBounds) <= s_fMaxLeafGrowth * leaf.m_fFittedArea)
+    {
+      leaf.m_Bounds = grownBounds;
+
+      // The ancestors only need to grow until one of them already contains the leaf
+      for (ezUInt32 uiNodeIndex = leaf.m_uiParent; uiNodeIndex != ezInvalidIndex; uiNodeIndex = m_Nodes[uiNodeIndex].m_uiParent)
+      {
+        Node& node = m_Nodes[uiNodeIndex];
+        if (node.m_Bounds.Contains(grownBounds))
+          break;
+
+        node.m_Bounds = GetMergedBounds(node.m_Bounds, grownBounds);
+      }
+      return;
+    }
+  }
+
+  // Objects usually move only a bit, so the object is re-inserted into the sub-tree of the lowest ancestor that still contains it.
+  // The ancestors above don't change at all. A leaf that loses its last object is removed together with its parent.
+  ezUInt32 uiInsertionRoot = leaf.m_uiParent;
+  if (leaf.m_uiNumObjects == 1 && uiInsertionRoot != ezInvalidIndex)
+  {
+    uiInsertionRoot = m_Nodes[uiInsertionRoot].m_uiParent;
+  }
+
+  while (uiInsertionRoot != ezInvalidIndex && !m_Nodes[uiInsertionRoot].m_Bounds.Contains(enlargedBounds))
+  {
+    uiInsertionRoot = m_Nodes[uiInsertionRoot].m_uiParent;
+  }
+
+  RemoveObject(uiLeafIndex, pData->m_uiObjectIndex);
+  InsertObject(uiDataIndex, uiInsertionRoot);
+}
+
+void ezSpatialSystem_Bvh::UpdateSpatialDataObject(const ezSpatialDataHandle& hData, ezGameObject* pObject)
+{
+  Data* pData = nullptr;
+  EZ_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  m_DataObjects[hData.GetInternalID().m_InstanceIndex] = pObject;
+}
+
+void ezSpatialSystem_Bvh::FindObjectsInSphere(const ezBoundingSphere& sphere, const QueryParams& queryParams, QueryCallback callback) const
+{
+  EZ_PROFILE_SCOPE("FindObjectsInSphere");
+
+  FindObjectsInShapes(ezMakeArrayPtr(&sphere, 1), queryParams,
+    [&](ezUInt32 uiQueryIndex, ezGameObject* pObject)
+    {
+      EZ_IGNORE_UNUSED(uiQueryIndex);
+      return callback(pObject);
+    });
+}
+
+void ezSpatialSystem_Bvh::FindObjectsInBox(const ezBoundingBox& box, const QueryParams& queryParams, QueryCallback callback) const
+{
+  EZ_PROFILE_SCOPE("FindObjectsInBox");
+
+  FindObjectsInShapes(ezMakeArrayPtr(&box, 1), queryParams,
+    [&](ezUInt32 uiQueryIndex, ezGameObject* pObject)
+    {
+      EZ_IGNORE_UNUSED(uiQueryIndex);
+      return callback(pObject);
+    });
+}
+
+void ezSpatialSystem_Bvh::FindObjectsInSpheres(ezArrayPtr<const ezBoundingSphere> spheres, const QueryParams& queryParams, BatchQueryCallback callback) const
+{
+  EZ_PROFILE_SCOPE("FindObjectsInSpheres");
+
+  FindObjectsInShapes(spheres, queryParams, callback);
+}
+
+void ezSpatialSystem_Bvh::FindObjectsInBoxes(ezArrayPtr<const ezBoundingBox> boxes, const QueryParams& queryParams, BatchQueryCallback callback) const
+{
+  EZ_PROFILE_SCOPE("FindObjectsInBoxes");
+
+  FindObjectsInShapes(boxes, queryParams, callback);
+}
+
+void ezSpatialSystem_Bvh::FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_Objects, ezSpatialSystem::IsOccludedFunc IsOccluded, ezVisibilityState visType) const
+{
+  EZ_PROFILE_SCOPE("FindVisibleObjects");
+
+  const FrustumPlanes frustumPlanes = FrustumPlanes::MakeFromFrustum(frustum);
+  ezDynamicArray<const ezGameObject*>* pOutObjects = &out_Objects;
+
+  FindVisibleObjectsInFrustums(ezMakeArrayPtr(&frustumPlanes, 1), queryParams, &pOutObjects, IsOccluded, visType);
+}
+
+void ezSpatialSystem_Bvh::FindVisibleObjects(ezArrayPtr<const ezFrustum> frustums, const QueryParams& queryParams, ezArrayPtr<ezDynamicArray<const ezGameObject*>> out_Objects, ezVisibilityState visType) const
+{
+  EZ_PROFILE_SCOPE("FindVisibleObjectsBatch");
+
+  EZ_ASSERT_DEV(frustums.GetCount() == out_Objects.GetCount(), "Need exactly one output array per frustum");
+
+  FrustumPlanes frustumPlanes[s_uiQueryBatchSize];
+  ezDynamicArray<const ezGameObject*>* outObjects[s_uiQueryBatchSize];
+
+  for (ezUInt32 uiFirstFrustum = 0; uiFirstFrustum < frustums.GetCount(); uiFirstFrustum += s_uiQueryBatchSize)
+  {
+    const ezUInt32 uiNumFrustums = ezMath::Min(frustums.GetCount() - uiFirstFrustum, s_uiQueryBatchSize);
+
+    for (ezUInt32 i = 0; i < uiNumFrustums; ++i)
+    {
+      frustumPlanes[i] = FrustumPlanes::MakeFromFrustum(frustums[uiFirstFrustum + i]);
+      outObjects[i] = &out_Objects[uiFirstFrustum + i];
+    }
+
+    FindVisibleObjectsInFrustums(ezMakeArrayPtr(frustumPlanes, uiNumFrustums), queryParams, outObjects, {}, visType);
+  }
+}
+
+ezVisibilityState ezSpatialSystem_Bvh::GetVisibilityState(const ezSpatialDataHandle& hData, ezUInt32 uiNumFramesBeforeInvisible) const
+{
+  Data* pData = nullptr;
+  EZ_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  if (pData->m_uiNodeIndex == ezInvalidIndex)
+    return ezVisibilityState::Direct;
+
+  const ezUInt64 uiLastVisibleFrameIdxAndVisType = m_DataLastVisibleFrameIdxAndVisType[hData.GetInternalID().m_InstanceIndex];
+
+  const ezUInt64 uiLastVisibleFrameIdx = (uiLastVisibleFrameIdxAndVisType >> 4);
+  const ezUInt64 uiLastVisibilityType = (uiLastVisibleFrameIdxAndVisType & static_cast<ezUInt64>(15)); // mask out lower 4 bits
+
+  if (m_uiFrameCounter > uiLastVisibleFrameIdx + uiNumFramesBeforeInvisible)
+    return ezVisibilityState::Invisible;
+
+  return static_cast<ezVisibilityState>(uiLastVisibilityType);
+}
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+void ezSpatialSystem_Bvh::GetInternalStats(ezStringBuilder& sb) const
+{
+  const ezUInt32 uiNumAlwaysVisible = m_AlwaysVisibleData.GetCount();
+  const ezUInt32 uiNumObjects = m_DataTable.GetCount() - uiNumAlwaysVisible;
+
+  sb.SetFormat("Num Objects: {}\nNum Nodes: {}\nTree Height: {}\nAlways Visible: {}\n", uiNumObjects, m_uiNumUsedNodes, GetTreeHeight(), uiNumAlwaysVisible);
+}
+#endif
+
+ezUInt32 ezSpatialSystem_Bvh::AllocateNode()
+{
+  ezUInt32 uiNodeIndex = m_uiFirstFreeNode;
+  if (uiNodeIndex != ezInvalidIndex)
+  {
+    m_uiFirstFreeNode = m_Nodes[uiNodeIndex].m_uiParent;
+  }
+  else
+  {
+    uiNodeIndex = m_Nodes.GetCount();
+    m_Nodes.ExpandAndGetRef();
+  }
+
+  Node& node = m_Nodes[uiNodeIndex];
+  node.m_uiParent = ezInvalidIndex;
+  node.m_uiCategoryBitmask = 0;
+  node.m_iHeight = 0;
+  node.m_uiNumObjects = 0;
+  node.m_uiChild0 = ezInvalidIndex;
+  node.m_uiChild1 = ezInvalidIndex;
+  node.m_uiFirstObject = ezInvalidIndex;
+  node.m_uiObjectCapacity = 0;
+
+  ++m_uiNumUsedNodes;
+
+  return uiNodeIndex;
+}
+
+void ezSpatialSystem_Bvh::FreeNode(ezUInt32 uiNodeIndex)
+{
+  Node& node = m_Nodes[uiNodeIndex];
+  node.m_uiParent = m_uiFirstFreeNode;
+  node.m_iHeight = -1;
+  node.m_uiNumObjects = 0;
+
+  m_uiFirstFreeNode = uiNodeIndex;
+
+  --m_uiNumUsedNodes;
+}
+
+ezUInt32 ezSpatialSystem_Bvh::AllocateLeafObjects()
+{
+  ezUInt32 uiFirstObject = m_uiFirstFreeLeafObjects;
+  if (uiFirstObject != ezInvalidIndex)
+  {
+    m_uiFirstFreeLeafObjects = m_LeafDataIndices[uiFirstObject];
+  }
+  else
+  {
+    uiFirstObject = m_LeafSpheres.GetCount();
+
+    const ezUInt32 uiNewCount = uiFirstObject + LeafCapacity;
+    m_LeafSpheres.SetCountUninitialized(uiNewCount);
+    m_LeafCategoryBitmasks.SetCountUninitialized(uiNewCount);
+    m_LeafDataIndices.SetCountUninitialized(uiNewCount);
+    m_LeafEnlargedBounds.SetCountUninitialized(uiNewCount);
+  }
+
+  return uiFirstObject;
+}
+
+void ezSpatialSystem_Bvh::FreeLeafObjects(const Node& leaf)
+{
+  // Only the wide leaves of a rebuild have a bigger capacity, their objects are compacted by the next rebuild
+  if (leaf.m_uiObjectCapacity != LeafCapacity)
+    return;
+
+  m_LeafDataIndices[leaf.m_uiFirstObject] = m_uiFirstFreeLeafObjects;
+  m_uiFirstFreeLeafObjects = leaf.m_uiFirstObject;
+}
+
+void ezSpatialSystem_Bvh::InsertObject(ezUInt32 uiDataIndex, ezUInt32 uiInsertionRoot)
+{
+
+  const ezSimdBBox objectBounds = m_DataEnlargedBounds[uiDataIndex];
+  const float fObjectArea = GetSurfaceArea(objectBounds);
+
+  // Find the node that adds the least cost to the tree, measured as surface area. The object either becomes the sibling of a node
+  // in a new leaf, which needs a new parent node that encloses both, or it is added to a leaf with free space, which makes every query
+  // that reaches the leaf test one more object. Both grow all ancestors of the node.
+  // The descent stops as soon as the growth of the ancestors alone exceeds the best cost found so far.
+  // This keeps big objects close to the root instead of inflating a deep sub-tree.
+  ezUInt32 uiTarget = ezInvalidIndex;
+  bool bAddToLeaf = false;
+
+  if (m_uiRootNode != ezInvalidIndex)
+  {
+    if (uiInsertionRoot == ezInvalidIndex)
+    {
+      uiInsertionRoot = m_uiRootNode;
+    }
+
+    float fBestCost = ezMath::MaxValue<float>();
+    float fInheritedCost = 0.0f;
+
+    auto EvaluateTarget = [&](ezUInt32 uiNodeIndex, const Node& node, float fNodeArea, float fMergedArea)
+    {
+      const float fSiblingCost = fInheritedCost + fMergedArea + fObjectArea * (1.0f + s_fObjectTestCost);
+      if (fSiblingCost < fBestCost)
+      {
+        fBestCost = fSiblingCost;
+        uiTarget = uiNodeIndex;
+        bAddToLeaf = false;
+      }
+
+      if (node.IsLeaf() && node.m_uiNumObjects < node.m_uiObjectCapacity)
+      {
+        const float fNumObjects = node.m_uiNumObjects;
+        const float fLeafCost = fInheritedCost + fMergedArea * (1.0f + (fNumObjects + 1.0f) * s_fObjectTestCost) - fNodeArea * (1.0f + fNumObjects * s_fObjectTestCost);
+        if (fLeafCost < fBestCost)
+        {
+          fBestCost = fLeafCost;
+          uiTarget = uiNodeIndex;
+          bAddToLeaf = true;
+        }
+      }
+    };
+
+    ezUInt32 uiNodeIndex = uiInsertionRoot;
+    float fNodeArea = GetSurfaceArea(m_Nodes[uiNodeIndex].m_Bounds);
+    float fMergedArea = GetSurfaceArea(GetMergedBounds(m_Nodes[uiNodeIndex].m_Bounds, objectBounds));
+    EvaluateTarget(uiNodeIndex, m_Nodes[uiNodeIndex], fNodeArea, fMergedArea);
+
+    while (!m_Nodes[uiNodeIndex].IsLeaf())
+    {
+      const Node& node = m_Nodes[uiNodeIndex];
+
+      fInheritedCost += fMergedArea - fNodeArea;
+
+      float fChildArea[2];
+      float fChildMergedArea[2];
+      float fChildLowerCost[2];
+
+      for (ezUInt32 i = 0; i < 2; ++i)
+      {
+        const ezUInt32 uiChildIndex = i == 0 ? node.m_uiChild0 : node.m_uiChild1;
+        const Node& child = m_Nodes[uiChildIndex];
+
+        fChildArea[i] = GetSurfaceArea(child.m_Bounds);
+        fChildMergedArea[i] = GetSurfaceArea(GetMergedBounds(child.m_Bounds, objectBounds));
+
+        EvaluateTarget(uiChildIndex, child, fChildArea[i], fChildMergedArea[i]);
+
+        // Going down further costs at least the growth of the child plus testing the object
+        fChildLowerCost[i] = child.IsLeaf() ? ezMath::MaxValue<float>() : fInheritedCost + fChildMergedArea[i] - fChildArea[i] + fObjectArea * s_fObjectTestCost;
+      }
+
+      if (fBestCost <= fChildLowerCost[0] && fBestCost <= fChildLowerCost[1])
+        break;
+
+      const ezUInt32 uiNext = fChildLowerCost[0] <= fChildLowerCost[1] ? 0 : 1;
+
+      uiNodeIndex = uiNext == 0 ? node.m_uiChild0 : node.m_uiChild1;
+      fNodeArea = fChildArea[uiNext];
+      fMergedArea = fChildMergedArea[uiNext];
+    }
+  }
+
+  const ezUInt32 uiCategoryBitmask = m_DataCategoryBitmasks[uiDataIndex];
+
+  ezUInt32 uiLeafIndex = uiTarget;
+  if (!bAddToLeaf)
+  {
+    uiLeafIndex = AllocateNode();
+
+    const ezUInt32 uiFirstObject = AllocateLeafObjects();
+    m_Nodes[uiLeafIndex].m_uiFirstObject = uiFirstObject;
+    m_Nodes[uiLeafIndex].m_uiObjectCapacity = LeafCapacity;
+  }
+
+  Node& leaf = m_Nodes[uiLeafIndex];
+  const ezUInt32 uiObjectIndex = leaf.m_uiFirstObject + leaf.m_uiNumObjects;
+  ++leaf.m_uiNumObjects;
+  leaf.m_Bounds = bAddToLeaf ? GetMergedBounds(leaf.m_Bounds, objectBounds) : objectBounds;
+  leaf.m_fFittedArea = GetSurfaceArea(leaf.m_Bounds);
+  leaf.m_uiCategoryBitmask |= uiCategoryBitmask;
+
+  m_LeafSpheres[uiObjectIndex] = m_DataBounds[uiDataIndex].GetSphere();
+  m_LeafCategoryBitmasks[uiObjectIndex] = uiCategoryBitmask;
+  m_LeafDataIndices[uiObjectIndex] = uiDataIndex;
+  m_LeafEnlargedBounds[uiObjectIndex] = objectBounds;
+
+  Data& data = m_DataTable.GetValueUnchecked(uiDataIndex);
+  data.m_uiNodeIndex = uiLeafIndex;
+  data.m_uiObjectIndex = uiObjectIndex;
+
+  if (bAddToLeaf)
+  {
+    RefitAncestors(leaf.m_uiParent);
+  }
+  else
+  {
+    InsertLeaf(uiLeafIndex, uiTarget);
+  }
+}
+
+void ezSpatialSystem_Bvh::RemoveObject(ezUInt32 uiLeafIndex, ezUInt32 uiObjectIndex)
+{
+  Node& leaf = m_Nodes[uiLeafIndex];
+  if (leaf.m_uiNumObjects == 1)
+  {
+    FreeLeafObjects(leaf);
+    RemoveLeaf(uiLeafIndex);
+    FreeNode(uiLeafIndex);
+    return;
+  }
+
+  // Move the last object into the free slot
+  --leaf.m_uiNumObjects;
+
+  const ezUInt32 uiLastObjectIndex = leaf.m_uiFirstObject + leaf.m_uiNumObjects;
+  if (uiObjectIndex != uiLastObjectIndex)
+  {
+    m_LeafSpheres[uiObjectIndex] = m_LeafSpheres[uiLastObjectIndex];
+    m_LeafCategoryBitmasks[uiObjectIndex] = m_LeafCategoryBitmasks[uiLastObjectIndex];
+    m_LeafDataIndices[uiObjectIndex] = m_LeafDataIndices[uiLastObjectIndex];
+    m_LeafEnlargedBounds[uiObjectIndex] = m_LeafEnlargedBounds[uiLastObjectIndex];
+
+    m_DataTable.GetValueUnchecked(m_LeafDataIndices[uiObjectIndex]).m_uiObjectIndex = uiObjectIndex;
+  }
+
+  UpdateLeafFromObjects(leaf);
+  RefitAncestors(leaf.m_uiParent);
+}
+
+void ezSpatialSystem_Bvh::InsertLeaf(ezUInt32 uiLeafIndex, ezUInt32 uiSibling)
+{
+  if (uiSibling == ezInvalidIndex)
+  {
+    m_uiRootNode = uiLeafIndex;
+    m_Nodes[uiLeafIndex].m_uiParent = ezInvalidIndex;
+    return;
+  }
+
+  const ezUInt32 uiOldParent = m_Nodes[uiSibling].m_uiParent;
+  const ezUInt32 uiNewParent = AllocateNode();
+
+  {
+    Node& newParent = m_Nodes[uiNewParent];
+    newParent.m_uiParent = uiOldParent;
+    newParent.m_uiChild0 = uiSibling;
+    newParent.m_uiChild1 = uiLeafIndex;
+    UpdateNodeFromChildren(newParent);
+  }
+
+  m_Nodes[uiSibling].m_uiParent = uiNewParent;
+  m_Nodes[uiLeafIndex].m_uiParent = uiNewParent;
+
+  if (uiOldParent != ezInvalidIndex)
+  {
+    Node& oldParent = m_Nodes[uiOldParent];
+    if (oldParent.m_uiChild0 == uiSibling)
+      oldParent.m_uiChild0 = uiNewParent;
+    else
+      oldParent.m_uiChild1 = uiNewParent;
+  }
+  else
+  {
+    m_uiRootNode = uiNewParent;
+  }
+
+  RefitAncestors(uiOldParent);
+}
+
+void ezSpatialSystem_Bvh::RemoveLeaf(ezUInt32 uiLeafIndex)
+{
+  if (uiLeafIndex == m_uiRootNode)
+  {
+    m_uiRootNode = ezInvalidIndex;
+    return;
+  }
+
+  const ezUInt32 uiParent = m_Nodes[uiLeafIndex].m_uiParent;
+  const ezUInt32 uiGrandParent = m_Nodes[uiParent].m_uiParent;
+  const ezUInt32 uiSibling = m_Nodes[uiParent].m_uiChild0 == uiLeafIndex ? m_Nodes[uiParent].m_uiChild1 : m_Nodes[uiParent].m_uiChild0;
+
+  FreeNode(uiParent);
+  m_Nodes[uiSibling].m_uiParent = uiGrandParent;
+  m_Nodes[uiLeafIndex].m_uiParent = ezInvalidIndex;
+
+  if (uiGrandParent == ezInvalidIndex)
+  {
+    m_uiRootNode = uiSibling;
+    return;
+  }
+
+  Node& grandParent = m_Nodes[uiGrandParent];
+  if (grandParent.m_uiChild0 == uiParent)
+    grandParent.m_uiChild0 = uiSibling;
+  else
+    grandParent.m_uiChild1 = uiSibling;
+
+  RefitAncestors(uiGrandParent);
+}
+
+void ezSpatialSystem_Bvh::RefitAncestors(ezUInt32 uiNodeIndex)
+{
+  while (uiNodeIndex != ezInvalidIndex)
+  {
+    Node& node = m_Nodes[uiNodeIndex];
+    const Node oldNode = node;
+
+    UpdateNodeFromChildren(node);
+
+    // Nothing changes further up
+    if (node.m_Bounds == oldNode.m_Bounds && node.m_iHeight == oldNode.m_iHeight && node.m_uiCategoryBitmask == oldNode.m_uiCategoryBitmask)
+      return;
+
+    RotateNodes(uiNodeIndex);
+
+    uiNodeIndex = m_Nodes[uiNodeIndex].m_uiParent;
+  }
+}
+
+void ezSpatialSystem_Bvh::RotateNodes(ezUInt32 uiNodeIndex)
+{
+  // Swaps a child of this node with a grandchild from the other side if that reduces the surface area of the tree.
+  // Unlike height based balancing this keeps big objects close to the root, but it can build long chains of big objects.
+  // So if one side is much higher than the other, its higher grandchild is moved up instead.
+  const Node& a = m_Nodes[uiNodeIndex];
+  if (a.m_iHeight < 2)
+    return;
+
+  const ezUInt32 uiChildren[2] = {a.m_uiChild0, a.m_uiChild1};
+
+  float fBestReduction = 0.0f;
+  ezUInt32 uiBestChild = ezInvalidIndex;
+  ezUInt32 uiBestGrandChild = ezInvalidIndex;
+
+  const ezInt32 iHeightDifference = m_Nodes[uiChildren[0]].m_iHeight - m_Nodes[uiChildren[1]].m_iHeight;
+  if (iHeightDifference > 1 || iHeightDifference < -1)
+  {
+    const ezUInt32 uiHigherChild = iHeightDifference > 0 ? 0 : 1;
+    const Node& higherChild = m_Nodes[uiChildren[uiHigherChild]];
+
+    uiBestChild = uiChildren[1 - uiHigherChild];
+    uiBestGrandChild = m_Nodes[higherChild.m_uiChild0].m_iHeight >= m_Nodes[higherChild.m_uiChild1].m_iHeight ? higherChild.m_uiChild0 : higherChild.m_uiChild1;
+  }
+  else
+  {
+    for (ezUInt32 i = 0; i < 2; ++i)
+    {
+      const Node& child = m_Nodes[uiChildren[i]];
+      const Node& otherChild = m_Nodes[uiChildren[1 - i]];
+
+      if (otherChild.IsLeaf())
+        continue;
+
+      const float fOtherArea = GetSurfaceArea(otherChild.m_Bounds);
+
+      // Swapping the child with one grandchild leaves the other child with the child and the remaining grandchild
+      const float fReduction0 = fOtherArea - GetSurfaceArea(GetMergedBounds(child.m_Bounds, m_Nodes[otherChild.m_uiChild1].m_Bounds));
+      const float fReduction1 = fOtherArea - GetSurfaceArea(GetMergedBounds(child.m_Bounds, m_Nodes[otherChild.m_uiChild0].m_Bounds));
+
+      if (fReduction0 > fBestReduction)
+      {
+        fBestReduction = fReduction0;
+        uiBestChild = uiChildren[i];
+        uiBestGrandChild = otherChild.m_uiChild0;
+      }
+
+      if (fReduction1 > fBestReduction)
+      {
+        fBestReduction = fReduction1;
+        uiBestChild = uiChildren[i];
+        uiBestGrandChild = otherChild.m_uiChild1;
+      }
+    }
+  }
+
+  if (uiBestChild == ezInvalidIndex)
+    return;
+
+  Node& child = m_Nodes[uiBestChild];
+  Node& grandChild = m_Nodes[uiBestGrandChild];
+  Node& otherChild = m_Nodes[grandChild.m_uiParent];
+
+  Node& node = m_Nodes[uiNodeIndex];
+  if (node.m_uiChild0 == uiBestChild)
+    node.m_uiChild0 = uiBestGrandChild;
+  else
+    node.m_uiChild1 = uiBestGrandChild;
+
+  if (otherChild.m_uiChild0 == uiBestGrandChild)
+    otherChild.m_uiChild0 = uiBestChild;
+  else
+    otherChild.m_uiChild1 = uiBestChild;
+
+  child.m_uiParent = grandChild.m_uiParent;
+  grandChild.m_uiParent = uiNodeIndex;
+
+  UpdateNodeFromChildren(otherChild);
+  UpdateNodeFromChildren(node);
+}
+
+void ezSpatialSystem_Bvh::UpdateNodeFromChildren(Node& ref_node)
+{
+  const Node& child0 = m_Nodes[ref_node.m_uiChild0];
+  const Node& child1 = m_Nodes[ref_node.m_uiChild1];
+
+  ref_node.m_Bounds = GetMergedBounds(child0.m_Bounds, child1.m_Bounds);
+  ref_node.m_uiCategoryBitmask = child0.m_uiCategoryBitmask | child1.m_uiCategoryBitmask;
+  ref_node.m_iHeight = 1 + ezMath::Max(child0.m_iHeight, child1.m_iHeight);
+}
+
+void ezSpatialSystem_Bvh::UpdateLeafFromObjects(Node& ref_leaf)
+{
+  const ezUInt32 uiFirstObject = ref_leaf.m_uiFirstObject;
+
+  ezSimdBBox bounds = m_LeafEnlargedBounds[uiFirstObject];
+  ezUInt32 uiCategoryBitmask = m_LeafCategoryBitmasks[uiFirstObject];
+
+  for (ezUInt32 i = uiFirstObject + 1; i < uiFirstObject + ref_leaf.m_uiNumObjects; ++i)
+  {
+    bounds = GetMergedBounds(bounds, m_LeafEnlargedBounds[i]);
+    uiCategoryBitmask |= m_LeafCategoryBitmasks[i];
+  }
+
+  ref_leaf.m_Bounds = bounds;
+  ref_leaf.m_fFittedArea = GetSurfaceArea(bounds);
+  ref_leaf.m_uiCategoryBitmask = uiCategoryBitmask;
+}
+
+void ezSpatialSystem_Bvh::RebuildTree()
+{
+  EZ_PROFILE_SCOPE("BVH Rebuild Tree");
+
+  m_uiNumInsertsSinceRebuild = 0;
+  m_uiFirstFreeNode = ezInvalidIndex;
+  m_uiFirstFreeLeafObjects = ezInvalidIndex;
+
+  struct BuildObject
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezSimdBBox m_Bounds;
+    ezVec3 m_vCenter;
+    float m_fSize; ///< Logarithm of the surface area
+    ezUInt32 m_uiDataIndex;
+  };
+
+  ezDynamicArray<BuildObject, ezAlignedAllocatorWrapper> objects;
+  objects.Reserve(m_DataTable.GetCount());
+
+  for (const Node& node : m_Nodes)
+  {
+    if (node.m_iHeight != 0)
+      continue;
+
+    for (ezUInt32 i = node.m_uiFirstObject; i < node.m_uiFirstObject + node.m_uiNumObjects; ++i)
+    {
+      const ezUInt32 uiDataIndex = m_LeafDataIndices[i];
+      const ezSimdBBox& bounds = m_LeafEnlargedBounds[i];
+
+      BuildObject& object = objects.ExpandAndGetRef();
+      object.m_Bounds = bounds;
+      object.m_vCenter = ezSimdConversion::ToVec3(bounds.GetCenter());
+      object.m_fSize = ezMath::Log2(GetSurfaceArea(bounds) + 1.0f);
+      object.m_uiDataIndex = uiDataIndex;
+    }
+  }
+
+  const ezUInt32 uiNumObjects = objects.GetCount();
+
+  m_Nodes.Clear();
+  m_Nodes.Reserve(uiNumObjects / 2 + 1);
+  m_LeafSpheres.Clear();
+  m_LeafCategoryBitmasks.Clear();
+  m_LeafDataIndices.Clear();
+  m_LeafEnlargedBounds.Clear();
+
+  m_uiRootNode = uiNumObjects > 0 ? 0 : ezInvalidIndex;
+  m_uiNumUsedNodes = 0;
+
+  if (uiNumObjects == 0)
+    return;
+
+  // Top down build that splits the objects where the surface area of both halves weighted by their number of objects is smallest.
+  // Objects are either split by their position along the longest axis or by their size. The latter moves big objects close to the root,
+  // instead of inflating all nodes of a spatial split. A range of objects becomes a leaf as soon as testing all of them is cheaper than
+  // the best split, which puts objects that overlap a lot into one wide leaf.
+  // Sub-trees are stored depth first and the two children of a node are always stored next to each other,
+  // so a traversal mostly reads memory that was just prefetched. The objects of the leaves are stored in the same order.
+  struct Entry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiFirstObject;
+    ezUInt32 m_uiNumObjects;
+    ezUInt32 m_uiNodeIndex;
+    ezUInt32 m_uiParent;
+  };
+
+  constexpr ezUInt32 uiNumBins = 16;
+
+  struct Bins
+  {
+    ezSimdBBox m_Bounds[uiNumBins];
+    ezUInt32 m_uiCounts[uiNumBins];
+  };
+
+  struct Split
+  {
+    float m_fCost = ezMath::MaxValue<float>();
+    ezUInt32 m_uiBin = 0;
+    ezUInt32 m_uiNumLeftObjects = 0;
+  };
+
+  auto FindBestSplit = [&](const Bins& bins, ezUInt32 uiNumRangeObjects, Split& inout_split) -> bool
+  {
+    // Sweep from the right to get the cost of everything right of each split, then from the left to find the best split
+    float fRightCosts[uiNumBins];
+    ezSimdBBox rightBounds = ezSimdBBox::MakeInvalid();
+    ezUInt32 uiRightCount = 0;
+    for (ezUInt32 i = uiNumBins - 1; i > 0; --i)
+    {
+      rightBounds = GetMergedBounds(rightBounds, bins.m_Bounds[i]);
+      uiRightCount += bins.m_uiCounts[i];
+      fRightCosts[i] = uiRightCount > 0 ? GetSurfaceArea(rightBounds) * uiRightCount : 0.0f;
+    }
+
+    bool bFound = false;
+    ezSimdBBox leftBounds = ezSimdBBox::MakeInvalid();
+    ezUInt32 uiLeftCount = 0;
+    for (ezUInt32 i = 1; i < uiNumBins; ++i)
+    {
+      leftBounds = GetMergedBounds(leftBounds, bins.m_Bounds[i - 1]);
+      uiLeftCount += bins.m_uiCounts[i - 1];
+
+      if (uiLeftCount == 0 || uiLeftCount == uiNumRangeObjects)
+        continue;
+
+      const float fCost = GetSurfaceArea(leftBounds) * uiLeftCount + fRightCosts[i];
+      if (fCost < inout_split.m_fCost)
+      {
+        inout_split.m_fCost = fCost;
+        inout_split.m_uiBin = i;
+        inout_split.m_uiNumLeftObjects = uiLeftCount;
+        bFound = true;
+      }
+    }
+
+    return bFound;
+  };
+
+  BuildObject* pObjects = objects.GetData();
+
+  ezHybridArray<Entry, 64> stack;
+  stack.PushBack({0, uiNumObjects, 0, ezInvalidIndex});
+  m_Nodes.ExpandAndGetRef();
+
+  while (!stack.IsEmpty())
+  {
+    const Entry entry = stack.PeekBack();
+    stack.PopBack();
+
+    BuildObject* pRangeObjects = pObjects + entry.m_uiFirstObject;
+    const ezUInt32 uiNumRangeObjects = entry.m_uiNumObjects;
+
+    ezSimdBBox bounds = ezSimdBBox::MakeInvalid();
+    ezBoundingBox centerBounds = ezBoundingBox::MakeInvalid();
+    float fMinSize = ezMath::MaxValue<float>();
+    float fMaxSize = 0.0f;
+    for (ezUInt32 i = 0; i < uiNumRangeObjects; ++i)
+    {
+      const BuildObject& object = pRangeObjects[i];
+      bounds = GetMergedBounds(bounds, object.m_Bounds);
+      centerBounds.ExpandToInclude(object.m_vCenter);
+      fMinSize = ezMath::Min(fMinSize, object.m_fSize);
+      fMaxSize = ezMath::Max(fMaxSize, object.m_fSize);
+    }
+
+    const ezVec3 vCenterExtents = centerBounds.GetExtents();
+    const ezUInt32 uiAxis = vCenterExtents.x >= vCenterExtents.y ? (vCenterExtents.x >= vCenterExtents.z ? 0 : 2) : (vCenterExtents.y >= vCenterExtents.z ? 1 : 2);
+    const float fMinCenter = centerBounds.m_vMin.GetData()[uiAxis];
+    const float fCenterBinScale = vCenterExtents.GetData()[uiAxis] > 0.0f ? uiNumBins * 0.999f / vCenterExtents.GetData()[uiAxis] : 0.0f;
+    const float fSizeBinScale = fMaxSize > fMinSize ? uiNumBins * 0.999f / (fMaxSize - fMinSize) : 0.0f;
+
+    auto GetCenterBin = [&](const BuildObject& object)
+    { return static_cast<ezUInt32>((object.m_vCenter.GetData()[uiAxis] - fMinCenter) * fCenterBinScale); };
+
+    auto GetSizeBin = [&](const BuildObject& object)
+    { return static_cast<ezUInt32>((object.m_fSize - fMinSize) * fSizeBinScale); };
+
+    Split split;
+    bool bCenterSplit = false;
+    bool bSizeSplit = false;
+
+    if (uiNumRangeObjects > 1)
+    {
+      Bins centerBins;
+      Bins sizeBins;
+      for (ezUInt32 i = 0; i < uiNumBins; ++i)
+      {
+        centerBins.m_Bounds[i] = ezSimdBBox::MakeInvalid();
+        centerBins.m_uiCounts[i] = 0;
+        sizeBins.m_Bounds[i] = ezSimdBBox::MakeInvalid();
+        sizeBins.m_uiCounts[i] = 0;
+      }
+
+      for (ezUInt32 i = 0; i < uiNumRangeObjects; ++i)
+      {
+        const BuildObject& object = pRangeObjects[i];
+
+        const ezUInt32 uiCenterBin = GetCenterBin(object);
+        centerBins.m_Bounds[uiCenterBin] = GetMergedBounds(centerBins.m_Bounds[uiCenterBin], object.m_Bounds);
+        ++centerBins.m_uiCounts[uiCenterBin];
+
+        const ezUInt32 uiSizeBin = GetSizeBin(object);
+        sizeBins.m_Bounds[uiSizeBin] = GetMergedBounds(sizeBins.m_Bounds[uiSizeBin], object.m_Bounds);
+        ++sizeBins.m_uiCounts[uiSizeBin];
+      }
+
+      bCenterSplit = FindBestSplit(centerBins, uiNumRangeObjects, split);
+      bSizeSplit = FindBestSplit(sizeBins, uiNumRangeObjects, split);
+    }
+
+    // A split costs a node visit on top of testing the objects of both halves
+    const float fArea = GetSurfaceArea(bounds);
+    const bool bCanSplit = bCenterSplit || bSizeSplit;
+    const bool bMakeLeaf = uiNumRangeObjects <= MaxLeafObjects && (!bCanSplit || fArea * uiNumRangeObjects * s_fObjectTestCost <= fArea + split.m_fCost * s_fObjectTestCost);
+
+    if (bMakeLeaf)
+    {
+      const ezUInt32 uiFirstObject = m_LeafSpheres.GetCount();
+      const ezUInt32 uiCapacity = ezMath::Min(ezMath::Max(ezMath::PowerOfTwo_Ceil(uiNumRangeObjects + 1), LeafCapacity), 0xFFFFu);
+
+      const ezUInt32 uiNewCount = uiFirstObject + uiCapacity;
+      m_LeafSpheres.SetCountUninitialized(uiNewCount);
+      m_LeafCategoryBitmasks.SetCountUninitialized(uiNewCount);
+      m_LeafDataIndices.SetCountUninitialized(uiNewCount);
+      m_LeafEnlargedBounds.SetCountUninitialized(uiNewCount);
+
+      ezUInt32 uiCategoryBitmask = 0;
+      for (ezUInt32 i = 0; i < uiNumRangeObjects; ++i)
+      {
+        const ezUInt32 uiDataIndex = pRangeObjects[i].m_uiDataIndex;
+        const ezUInt32 uiObjectIndex = uiFirstObject + i;
+
+        m_LeafSpheres[uiObjectIndex] = m_DataBounds[uiDataIndex].GetSphere();
+        m_LeafCategoryBitmasks[uiObjectIndex] = m_DataCategoryBitmasks[uiDataIndex];
+        m_LeafDataIndices[uiObjectIndex] = uiDataIndex;
+        m_LeafEnlargedBounds[uiObjectIndex] = pRangeObjects[i].m_Bounds;
+        uiCategoryBitmask |= m_DataCategoryBitmasks[uiDataIndex];
+
+        Data& data = m_DataTable.GetValueUnchecked(uiDataIndex);
+        data.m_uiNodeIndex = entry.m_uiNodeIndex;
+        data.m_uiObjectIndex = uiObjectIndex;
+      }
+
+      Node& leaf = m_Nodes[entry.m_uiNodeIndex];
+      leaf.m_Bounds = bounds;
+      leaf.m_fFittedArea = GetSurfaceArea(bounds);
+      leaf.m_uiParent = entry.m_uiParent;
+      leaf.m_uiCategoryBitmask = uiCategoryBitmask;
+      leaf.m_iHeight = 0;
+      leaf.m_uiNumObjects = static_cast<ezUInt16>(uiNumRangeObjects);
+      leaf.m_uiChild0 = ezInvalidIndex;
+      leaf.m_uiChild1 = ezInvalidIndex;
+      leaf.m_uiFirstObject = uiFirstObject;
+      leaf.m_uiObjectCapacity = static_cast<ezUInt16>(uiCapacity);
+      continue;
+    }
+
+    auto Partition = [&](auto getBin)
+    {
+      ezUInt32 uiLeft = 0;
+      ezUInt32 uiRight = uiNumRangeObjects;
+      while (uiLeft < uiRight)
+      {
+        if (getBin(pRangeObjects[uiLeft]) < split.m_uiBin)
+        {
+          ++uiLeft;
+        }
+        else
+        {
+          --uiRight;
+          ezMath::Swap(pRangeObjects[uiLeft], pRangeObjects[uiRight]);
+        }
+      }
+    };
+
+    ezUInt32 uiNumLeftObjects = split.m_uiNumLeftObjects;
+    if (bSizeSplit)
+    {
+      Partition(GetSizeBin);
+    }
+    else if (bCenterSplit)
+    {
+      Partition(GetCenterBin);
+    }
+    else
+    {
+      // Too many objects for one leaf, but all of them are in the same spot and have the same size
+      uiNumLeftObjects = uiNumRangeObjects / 2;
+    }
+
+    const ezUInt32 uiChild0 = m_Nodes.GetCount();
+    m_Nodes.SetCountUninitialized(uiChild0 + 2);
+
+    Node& node = m_Nodes[entry.m_uiNodeIndex];
+    node.m_uiParent = entry.m_uiParent;
+    node.m_uiNumObjects = 0;
+    node.m_uiChild0 = uiChild0;
+    node.m_uiChild1 = uiChild0 + 1;
+    node.m_uiFirstObject = ezInvalidIndex;
+    node.m_uiObjectCapacity = 0;
+
+    stack.PushBack({entry.m_uiFirstObject + uiNumLeftObjects, uiNumRangeObjects - uiNumLeftObjects, uiChild0 + 1, entry.m_uiNodeIndex});
+    stack.PushBack({entry.m_uiFirstObject, uiNumLeftObjects, uiChild0, entry.m_uiNodeIndex});
+  }
+
+  m_uiNumUsedNodes = m_Nodes.GetCount();
+
+  // Children are always stored after their parent, so a backwards pass computes the inner nodes bottom up
+  for (ezUInt32 i = m_uiNumUsedNodes; i-- > 0;)
+  {
+    Node& node = m_Nodes[i];
+    if (!node.IsLeaf())
+    {
+      UpdateNodeFromChildren(node);
+    }
+  }
+}
+
+ezSimdBBox ezSpatialSystem_Bvh::GetTightBounds(const ezSimdBBoxSphere& bounds)
+{
+  // Queries test against the bounding sphere, so the leaf has to enclose the sphere as well as the box
+  return ezSimdBBox::MakeFromCenterAndHalfExtents(bounds.m_CenterAndRadius, bounds.m_BoxHalfExtents.CompMax(bounds.m_CenterAndRadius.Get<ezSwizzle::WWWW>()));
+}
+
+ezSimdBBox ezSpatialSystem_Bvh::GetEnlargedBounds(const ezSimdBBoxSphere& bounds, const ezSimdVec4f& vDisplacement) const
+{
+  ezSimdBBox enlargedBounds = GetTightBounds(bounds);
+
+  // The margin grows with the object, so small objects keep tight bounds while big objects don't need to be re-inserted for every small move
+  enlargedBounds.Grow(bounds.m_CenterAndRadius.Get<ezSwizzle::WWWW>() * m_fLeafMarginScale);
+
+  // Moving objects get their bounds extended along the direction of their last move
+  const ezSimdVec4f vPredicted = vDisplacement * m_fMovePrediction;
+  enlargedBounds.m_Min = enlargedBounds.m_Min.CompMin(enlargedBounds.m_Min + vPredicted);
+  enlargedBounds.m_Max = enlargedBounds.m_Max.CompMax(enlargedBounds.m_Max + vPredicted);
+
+  return enlargedBounds;
+}
+
+ezSpatialDataHandle ezSpatialSystem_Bvh::AddSpatialData(const ezSimdBBoxSphere& bounds, ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags, bool bAlwaysVisible)
+{
+  Data data;
+  data.m_uiNodeIndex = ezInvalidIndex;
+
+  const ezSpatialDataId id = m_DataTable.Insert(data);
+  const ezUInt32 uiDataIndex = id.m_InstanceIndex;
+
+  if (uiDataIndex >= m_DataBounds.GetCount())
+  {
+    const ezUInt32 uiNewCount = uiDataIndex + 1;
+
+    m_DataBounds.SetCount(uiNewCount);
+    m_DataEnlargedBounds.SetCount(uiNewCount);
+    m_DataTags.SetCount(uiNewCount);
+    m_DataObjects.SetCount(uiNewCount);
+    m_DataCategoryBitmasks.SetCount(uiNewCount);
+    m_DataLastVisibleFrameIdxAndVisType.SetCount(uiNewCount);
+  }
+
+  m_DataBounds[uiDataIndex] = bounds;
+  m_DataTags[uiDataIndex] = tags;
+  m_DataObjects[uiDataIndex] = pObject;
+  m_DataCategoryBitmasks[uiDataIndex] = uiCategoryBitmask;
+  m_DataLastVisibleFrameIdxAndVisType[uiDataIndex].Set(0);
+
+  if (bAlwaysVisible)
+  {
+    m_AlwaysVisibleData.PushBack(uiDataIndex);
+  }
+  else
+  {
+    m_DataEnlargedBounds[uiDataIndex] = GetEnlargedBounds(bounds, ezSimdVec4f::MakeZero());
+
+    InsertObject(uiDataIndex);
+    ++m_uiNumInsertsSinceRebuild;
+  }
+
+  return ezSpatialDataHandle(id);
+}
+
+template <typename Shape>
+void ezSpatialSystem_Bvh::FindObjectsInShapes(ezArrayPtr<const Shape> shapes, const QueryParams& queryParams, BatchQueryCallback callback) const
+{
+  using SimdShape = decltype(ToSimdShape(shapes[0]));
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  ezStopwatch timer;
+#endif
+
+  const bool bUseTagsFilter = (queryParams.m_pIncludeTags && queryParams.m_pIncludeTags->IsEmpty() == false) || (queryParams.m_pExcludeTags && queryParams.m_pExcludeTags->IsEmpty() == false);
+
+  ezUInt32 uiNumObjectsTested = 0;
+  ezUInt32 uiNumObjectsPassed = 0;
+
+  SimdShape simdShapes[s_uiQueryBatchSize];
+  TraversalStack stack(GetTreeHeight());
+
+  for (ezUInt32 uiFirstShape = 0; uiFirstShape < shapes.GetCount(); uiFirstShape += s_uiQueryBatchSize)
+  {
+    const ezUInt32 uiNumShapes = ezMath::Min(shapes.GetCount() - uiFirstShape, s_uiQueryBatchSize);
+
+    for (ezUInt32 i = 0; i < uiNumShapes; ++i)
+    {
+      simdShapes[i] = ToSimdShape(shapes[uiFirstShape + i]);
+    }
+
+    // Queries are removed from this mask when their callback returns Stop
+    ezUInt32 uiRunningQueriesMask = GetQueryMask(uiNumShapes);
+
+    auto ReportObject = [&](ezUInt32 uiObjectMask, ezUInt32 uiDataIndex)
+    {
+      ++uiNumObjectsPassed;
+
+      while (uiObjectMask > 0)
+      {
+        const ezUInt32 i = ezMath::FirstBitLow(uiObjectMask);
+        uiObjectMask &= uiObjectMask - 1;
+
+        if (callback(uiFirstShape + i, m_DataObjects[uiDataIndex]) == ezVisitorExecution::Stop)
+        {
+          uiRunningQueriesMask &= ~(1u << i);
+        }
+      }
+    };
+
+    for (ezUInt32 uiDataIndex : m_AlwaysVisibleData)
+    {
+      if ((m_DataCategoryBitmasks[uiDataIndex] & queryParams.m_uiCategoryBitmask) == 0)
+        continue;
+
+      ++uiNumObjectsTested;
+
+      if (bUseTagsFilter && IsFilteredByTags(m_DataTags[uiDataIndex], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
+        continue;
+
+      ReportObject(uiRunningQueriesMask, uiDataIndex);
+    }
+
+    // Nodes are tested before they are pushed, so the stack only contains nodes that overlap at least one query
+    const Node* pNodes = m_Nodes.GetData();
+    const ezSimdBSphere* pLeafSpheres = m_LeafSpheres.GetData();
+    const ezUInt32* pLeafCategoryBitmasks = m_LeafCategoryBitmasks.GetData();
+    const ezUInt32* pLeafDataIndices = m_LeafDataIndices.GetData();
+    auto GetOverlapMask = [&](const Node& node, ezUInt32 uiTestMask)
+    {
+      ezUInt32 uiOverlapMask = 0;
+      if ((node.m_uiCategoryBitmask & queryParams.m_uiCategoryBitmask) == 0)
+        return uiOverlapMask;
+
+      while (uiTestMask > 0)
+      {
+        const ezUInt32 i = ezMath::FirstBitLow(uiTestMask);
+        uiTestMask &= uiTestMask - 1;
+
+        if (node.m_Bounds.Overlaps(simdShapes[i]))
+        {
+          uiOverlapMask |= (1u << i);
+        }
+      }
+
+      return uiOverlapMask;
+    };
+
+    if (m_uiRootNode != ezInvalidIndex)
+    {
+      if (const ezUInt32 uiRootMask = GetOverlapMask(pNodes[m_uiRootNode], uiRunningQueriesMask))
+      {
+        stack.Push({m_uiRootNode, uiRootMask, 0});
+      }
+    }
+
+    while (!stack.IsEmpty())
+    {
+      const TraversalEntry entry = stack.Pop();
+      const Node& node = pNodes[entry.m_uiNodeIndex];
+
+      ezUInt32 uiOverlapMask = entry.m_uiActiveMask & uiRunningQueriesMask;
+      if (uiOverlapMask == 0)
+        continue;
+
+      if (!node.IsLeaf())
+      {
+        if (const ezUInt32 uiChildMask = GetOverlapMask(pNodes[node.m_uiChild1], uiOverlapMask))
+        {
+          stack.Push({node.m_uiChild1, uiChildMask, 0});
+        }
+
+        if (const ezUInt32 uiChildMask = GetOverlapMask(pNodes[node.m_uiChild0], uiOverlapMask))
+        {
+          stack.Push({node.m_uiChild0, uiChildMask, 0});
+        }
+
+        continue;
+      }
+
+      for (ezUInt32 uiObject = node.m_uiFirstObject; uiObject < node.m_uiFirstObject + node.m_uiNumObjects; ++uiObject)
+      {
+        if ((pLeafCategoryBitmasks[uiObject] & queryParams.m_uiCategoryBitmask) == 0)
+          continue;
+
+        ++uiNumObjectsTested;
+
+        const ezUInt32 uiDataIndex = pLeafDataIndices[uiObject];
+        if (bUseTagsFilter && IsFilteredByTags(m_DataTags[uiDataIndex], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
+          continue;
+
+        const ezSimdBSphere& objectSphere = pLeafSpheres[uiObject];
+
+        ezUInt32 uiObjectMask = 0;
+        ezUInt32 uiTestMask = uiOverlapMask & uiRunningQueriesMask;
+        while (uiTestMask > 0)
+        {
+          const ezUInt32 i = ezMath::FirstBitLow(uiTestMask);
+          uiTestMask &= uiTestMask - 1;
+
+          if (simdShapes[i].Overlaps(objectSphere))
+          {
+            uiObjectMask |= (1u << i);
+          }
+        }
+
+        if (uiObjectMask != 0)
+        {
+          ReportObject(uiObjectMask, uiDataIndex);
+        }
+      }
+    }
+  }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (queryParams.m_pStats != nullptr)
+  {
+    queryParams.m_pStats->m_uiTotalNumObjects = m_DataTable.GetCount();
+    queryParams.m_pStats->m_uiNumObjectsTested += uiNumObjectsTested;
+    queryParams.m_pStats->m_uiNumObjectsPassed += uiNumObjectsPassed;
+    queryParams.m_pStats->m_TimeTaken = timer.GetRunningTotal();
+  }
+#endif
+}
+
+void ezSpatialSystem_Bvh::FindVisibleObjectsInFrustums(ezArrayPtr<const FrustumPlanes> frustumPlanes, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>** pOutObjects, ezSpatialSystem::IsOccludedFunc IsOccluded, ezVisibilityState visType) const
+{
+  EZ_ASSERT_DEBUG(frustumPlanes.GetCount() <= s_uiQueryBatchSize, "Too many frustums in one batch");
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  ezStopwatch timer;
+#endif
+
+  const bool bUseTagsFilter = (queryParams.m_pIncludeTags && queryParams.m_pIncludeTags->IsEmpty() == false) || (queryParams.m_pExcludeTags && queryParams.m_pExcludeTags->IsEmpty() == false);
+  const ezUInt32 uiAllFrustumsMask = GetQueryMask(frustumPlanes.GetCount());
+  const ezUInt64 uiFrameIdxAndType = (m_uiFrameCounter << 4) | static_cast<ezUInt64>(visType);
+
+  ezUInt32 uiNumObjectsTested = 0;
+  ezUInt32 uiNumObjectsPassed = 0;
+  ezUInt32 uiNumObjectsCulled = 0;
+  ezUInt32 uiNumObjectsOccluded = 0;
+
+  auto AddObject = [&](ezUInt32 uiObjectMask, ezUInt32 uiDataIndex)
+  {
+    ++uiNumObjectsPassed;
+
+    const ezGameObject* pObject = m_DataObjects[uiDataIndex];
+    while (uiObjectMask > 0)
+    {
+      const ezUInt32 i = ezMath::FirstBitLow(uiObjectMask);
+      uiObjectMask &= uiObjectMask - 1;
+
+      pOutObjects[i]->PushBack(pObject);
+    }
+  };
+
+  for (ezUInt32 uiDataIndex : m_AlwaysVisibleData)
+  {
+    if ((m_DataCategoryBitmasks[uiDataIndex] & queryParams.m_uiCategoryBitmask) == 0)
+      continue;
+
+    ++uiNumObjectsTested;
+
+    if (bUseTagsFilter && IsFilteredByTags(m_DataTags[uiDataIndex], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
+      continue;
+
+    AddObject(uiAllFrustumsMask, uiDataIndex);
+  }
+
+  const Node* pNodes = m_Nodes.GetData();
+  const ezSimdBSphere* pLeafSpheres = m_LeafSpheres.GetData();
+  const ezUInt32* pLeafCategoryBitmasks = m_LeafCategoryBitmasks.GetData();
+  const ezUInt32* pLeafDataIndices = m_LeafDataIndices.GetData();
+
+  TraversalStack stack(GetTreeHeight());
+  if (m_uiRootNode != ezInvalidIndex)
+  {
+    stack.Push({m_uiRootNode, uiAllFrustumsMask, 0});
+  }
+
+  while (!stack.IsEmpty())
+  {
+    const TraversalEntry entry = stack.Pop();
+    const Node& node = pNodes[entry.m_uiNodeIndex];
+    if ((node.m_uiCategoryBitmask & queryParams.m_uiCategoryBitmask) == 0)
+      continue;
+
+    ezUInt32 uiActiveMask = entry.m_uiActiveMask;
+    ezUInt32 uiInsideMask = entry.m_uiInsideMask;
+
+    // Nodes that are fully inside of a frustum don't need to be tested against it again
+    ezUInt32 uiTestMask = uiActiveMask & ~uiInsideMask;
+    while (uiTestMask > 0)
+    {
+      const ezUInt32 i = ezMath::FirstBitLow(uiTestMask);
+      uiTestMask &= uiTestMask - 1;
+
+      bool bInside = false;
+      if (!frustumPlanes[i].TestBox(node.m_Bounds, bInside))
+      {
+        uiActiveMask &= ~(1u << i);
+      }
+      else if (bInside)
+      {
+        uiInsideMask |= (1u << i);
+      }
+    }
+
+    if (uiActiveMask == 0)
+      continue;
+
+    if (!node.IsLeaf())
+    {
+      stack.Push({node.m_uiChild1, uiActiveMask, uiInsideMask});
+      stack.Push({node.m_uiChild0, uiActiveMask, uiInsideMask});
+      continue;
+    }
+
+    for (ezUInt32 uiObject = node.m_uiFirstObject; uiObject < node.m_uiFirstObject + node.m_uiNumObjects; ++uiObject)
+    {
+      if ((pLeafCategoryBitmasks[uiObject] & queryParams.m_uiCategoryBitmask) == 0)
+        continue;
+
+      ++uiNumObjectsTested;
+
+      const ezUInt32 uiDataIndex = pLeafDataIndices[uiObject];
+      if (bUseTagsFilter && IsFilteredByTags(m_DataTags[uiDataIndex], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
+        continue;
+
+      const ezSimdBSphere& objectSphere = pLeafSpheres[uiObject];
+
+      // The leaf bounds enclose the object sphere, so the object is visible in all frustums that contain the leaf
+      ezUInt32 uiObjectMask = uiActiveMask & uiInsideMask;
+
+      uiTestMask = uiActiveMask & ~uiInsideMask;
+      while (uiTestMask > 0)
+      {
+        const ezUInt32 i = ezMath::FirstBitLow(uiTestMask);
+        uiTestMask &= uiTestMask - 1;
+
+        if (frustumPlanes[i].TestSphere(objectSphere))
+        {
+          uiObjectMask |= (1u << i);
+        }
+      }
+
+      if (uiObjectMask == 0)
+      {
+        ++uiNumObjectsCulled;
+        continue;
+      }
+
+      if (IsOccluded.IsValid() && IsOccluded(ezSimdBBox::MakeFromCenterAndHalfExtents(objectSphere.GetCenter(), m_DataBounds[uiDataIndex].m_BoxHalfExtents)))
+      {
+        ++uiNumObjectsOccluded;
+        continue;
+      }
+
+      m_DataLastVisibleFrameIdxAndVisType[uiDataIndex].Max(uiFrameIdxAndType);
+      AddObject(uiObjectMask, uiDataIndex);
+    }
+  }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (queryParams.m_pStats != nullptr)
+  {
+    queryParams.m_pStats->m_uiTotalNumObjects = m_DataTable.GetCount();
+    queryParams.m_pStats->m_uiNumObjectsTested += uiNumObjectsTested;
+    queryParams.m_pStats->m_uiNumObjectsPassed += uiNumObjectsPassed;
+    queryParams.m_pStats->m_uiNumObjectsCulled += uiNumObjectsCulled;
+    queryParams.m_pStats->m_uiNumObjectsOccluded += uiNumObjectsOccluded;
+    queryParams.m_pStats->m_TimeTaken = timer.GetRunningTotal();
+  }
+#endif
+}
+
+EZ_STATICLINK_FILE(Core, Core_World_Implementation_SpatialSystem_Bvh);
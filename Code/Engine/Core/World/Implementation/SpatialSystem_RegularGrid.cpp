@@ -4,9 +4,11 @@
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Stopwatch.h>
 
 ezCVarInt cvar_SpatialQueriesCachingThreshold("Spatial.Queries.CachingThreshold", 100, ezCVarFlags::Default, "Number of objects that are tested for a query before it is considered for caching");
+ezCVarBool cvar_SpatialQueriesParallelCulling("Spatial.Queries.ParallelCulling", true, ezCVarFlags::Default, "Whether visibility queries split the culling of large numbers of objects into multiple tasks");
 
 struct PlaneData
 {
@@ -21,6 +23,12 @@ struct PlaneData
   ezSimdVec4f m_w4w5w4w5;
 };
 
+struct SplatPlaneData
+{
+  // Every component of a plane is replicated into all four lanes, so one plane can be tested against four spheres at once
+  ezSimdVec4f m_Planes[6][4];
+};
+
 namespace
 {
   enum
@@ -29,6 +37,9 @@ namespace
     CELL_INDEX_MASK = (1 << 21) - 1
   };
 
+  // Splitting the culling of fewer objects into multiple tasks costs more than it saves
+  constexpr ezUInt32 s_uiMinObjectsPerCullingTask = 2048;
+
   EZ_ALWAYS_INLINE ezSimdVec4f ToVec3(const ezSimdVec4i& v)
   {
     return v.ToFloat();
@@ -173,6 +184,38 @@ namespace
 
     return result;
   }
+
+  EZ_FORCE_INLINE ezSimdVec4b IsOutsidePlane(const ezSimdMat4f& spheres, const ezSimdVec4f* pPlane)
+  {
+    ezSimdVec4f dist;
+    dist = ezSimdVec4f::MulAdd(spheres.m_col0, pPlane[0], pPlane[3]);
+    dist = ezSimdVec4f::MulAdd(spheres.m_col1, pPlane[1], dist);
+    dist = ezSimdVec4f::MulAdd(spheres.m_col2, pPlane[2], dist);
+
+    return dist > spheres.m_col3;
+  }
+
+  // Tests four consecutive spheres, returns one bit per sphere that is not outside of the frustum
+  EZ_FORCE_INLINE ezUInt32 SphereFrustumIntersect(const ezSimdBSphere* pSpheres, const SplatPlaneData& planeData)
+  {
+    // Transpose the spheres, so the columns hold the x, y, z and radius of all four spheres
+    ezSimdMat4f spheres;
+    spheres.SetRows(pSpheres[0].m_CenterAndRadius, pSpheres[1].m_CenterAndRadius, pSpheres[2].m_CenterAndRadius, pSpheres[3].m_CenterAndRadius);
+
+    ezSimdVec4b outside = IsOutsidePlane(spheres, planeData.m_Planes[0]);
+    outside = outside || IsOutsidePlane(spheres, planeData.m_Planes[1]);
+    outside = outside || IsOutsidePlane(spheres, planeData.m_Planes[2]);
+    outside = outside || IsOutsidePlane(spheres, planeData.m_Planes[3]);
+    outside = outside || IsOutsidePlane(spheres, planeData.m_Planes[4]);
+    outside = outside || IsOutsidePlane(spheres, planeData.m_Planes[5]);
+
+    ezUInt32 result = outside.x() ? 0 : 1;
+    result |= outside.y() ? 0 : 2;
+    result |= outside.z() ? 0 : 4;
+    result |= outside.w() ? 0 : 8;
+
+    return result;
+  }
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -470,9 +513,20 @@ struct ezSpatialSystem_RegularGrid::Grid
 
 struct ezSpatialSystem_RegularGrid::Stats
 {
+  void operator+=(const Stats& other)
+  {
+    m_uiNumObjectsTested += other.m_uiNumObjectsTested;
+    m_uiNumObjectsPassed += other.m_uiNumObjectsPassed;
+    m_uiNumObjectsFiltered += other.m_uiNumObjectsFiltered;
+    m_uiNumObjectsCulled += other.m_uiNumObjectsCulled;
+    m_uiNumObjectsOccluded += other.m_uiNumObjectsOccluded;
+  }
+
   ezUInt32 m_uiNumObjectsTested = 0;
   ezUInt32 m_uiNumObjectsPassed = 0;
   ezUInt32 m_uiNumObjectsFiltered = 0;
+  ezUInt32 m_uiNumObjectsCulled = 0;
+  ezUInt32 m_uiNumObjectsOccluded = 0;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -533,6 +587,7 @@ namespace ezInternal
     struct FrustumQueryData
     {
       PlaneData m_PlaneData;
+      SplatPlaneData m_SplatPlaneData;
       ezDynamicArray<const ezGameObject*>* m_pOutObjects;
       ezUInt64 m_uiFrameCounter;
       ezSpatialSystem::IsOccludedFunc m_IsOccludedCB;
@@ -574,14 +629,13 @@ namespace ezInternal
         {
           ezUInt32 mask = 0;
 
-          for (ezUInt32 i = 0; i < 32; i += 2)
+          for (ezUInt32 i = 0; i < 32; i += 4)
           {
-            auto& objectSphereA = boundingSpheres[currentIndex + i + 0];
-            auto& objectSphereB = boundingSpheres[currentIndex + i + 1];
-
-            mask |= SphereFrustumIntersect(objectSphereA, objectSphereB, planeData) << i;
+            mask |= SphereFrustumIntersect(boundingSpheres + currentIndex + i, pQueryData->m_SplatPlaneData) << i;
           }
 
+          ref_stats.m_uiNumObjectsCulled += 32 - ezMath::CountBits(mask);
+
           while (mask > 0)
           {
             ezUInt32 i = ezMath::FirstBitLow(mask) + currentIndex;
@@ -601,6 +655,7 @@ namespace ezInternal
               const ezSimdBBox bbox = ezSimdBBox::MakeFromCenterAndHalfExtents(boundingSpheres[i].GetCenter(), boundingBoxHalfExtents[i]);
               if (pQueryData->m_IsOccludedCB(bbox))
               {
+                ref_stats.m_uiNumObjectsOccluded++;
                 continue;
               }
             }
@@ -619,7 +674,10 @@ namespace ezInternal
           ++currentIndex;
 
           if (!SphereFrustumIntersect(boundingSpheres[i], planeData))
+          {
+            ref_stats.m_uiNumObjectsCulled++;
             continue;
+          }
 
           if constexpr (UseTagsFilter)
           {
@@ -636,6 +694,7 @@ namespace ezInternal
 
             if (pQueryData->m_IsOccludedCB(bbox))
             {
+              ref_stats.m_uiNumObjectsOccluded++;
               continue;
             }
           }
@@ -649,6 +708,85 @@ namespace ezInternal
 
       return ezVisitorExecution::Continue;
     }
+
+    static void FrustumQueryInCells(ezArrayPtr<const ezSpatialSystem_RegularGrid::Cell* const> cells, ezUInt32 uiNumObjects, ezSpatialSystem_RegularGrid::CellCallback cellCallback, const ezSpatialSystem::QueryParams& queryParams, ezSpatialSystem_RegularGrid::Stats& ref_stats, FrustumQueryData& ref_queryData, ezVisibilityState visType)
+    {
+      // the calling thread helps out as well
+      const ezUInt32 uiMaxNumChunks = cvar_SpatialQueriesParallelCulling ? ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks) + 1 : 1;
+      const ezUInt32 uiNumChunks = ezMath::Clamp(uiNumObjects / s_uiMinObjectsPerCullingTask, 1u, ezMath::Min(uiMaxNumChunks, cells.GetCount()));
+
+
+      if (uiNumChunks <= 1)
+      {
+        for (auto pCell : cells)
+        {
+          cellCallback(*pCell, queryParams, ref_stats, &ref_queryData, visType);
+        }
+
+        return;
+      }
+
+      EZ_PROFILE_SCOPE("FrustumQueryInParallel");
+
+      struct Chunk
+      {
+        ezUInt32 m_uiStartCell = 0;
+        ezUInt32 m_uiEndCell = 0;
+        ezSpatialSystem_RegularGrid::Stats m_Stats;
+        ezDynamicArray<const ezGameObject*> m_Objects;
+      };
+
+      ezHybridArray<Chunk, 16> chunks;
+      chunks.SetCount(uiNumChunks);
+
+      // split by objects instead of cells, since the number of objects per cell varies a lot
+      ezUInt32 uiCellIndex = 0;
+      ezUInt32 uiNumObjectsInChunks = 0;
+      for (ezUInt32 uiChunk = 0; uiChunk < uiNumChunks; ++uiChunk)
+      {
+        const bool bLastChunk = uiChunk == uiNumChunks - 1;
+        const ezUInt32 uiNumObjectsUntilChunkEnd = static_cast<ezUInt32>(ezUInt64(uiNumObjects) * (uiChunk + 1) / uiNumChunks);
+
+        chunks[uiChunk].m_uiStartCell = uiCellIndex;
+
+        while (uiCellIndex < cells.GetCount() && (bLastChunk || uiNumObjectsInChunks < uiNumObjectsUntilChunkEnd))
+        {
+          uiNumObjectsInChunks += cells[uiCellIndex]->m_BoundingSpheres.GetCount();
+          ++uiCellIndex;
+        }
+
+        chunks[uiChunk].m_uiEndCell = uiCellIndex;
+      }
+
+      ezParallelForParams params;
+      params.m_uiBinSize = 1;
+      params.m_uiMaxTasksPerThread = 1;
+
+      ezTaskSystem::ParallelForIndexed(
+        0, uiNumChunks, [&](ezUInt32 uiStartChunk, ezUInt32 uiEndChunk)
+        {
+          for (ezUInt32 uiChunk = uiStartChunk; uiChunk < uiEndChunk; ++uiChunk)
+          {
+            Chunk& chunk = chunks[uiChunk];
+
+            FrustumQueryData chunkQueryData = ref_queryData;
+            chunkQueryData.m_pOutObjects = &chunk.m_Objects;
+
+            for (ezUInt32 i = chunk.m_uiStartCell; i < chunk.m_uiEndCell; ++i)
+            {
+              cellCallback(*cells[i], queryParams, chunk.m_Stats, &chunkQueryData, visType);
+            }
+          }
+        },
+        "FrustumQueryInCells", ezTaskNesting::Never, params);
+
+      // merge in chunk order, so that the result is the same as with a single task
+      for (const Chunk& chunk : chunks)
+      {
+        ref_queryData.m_pOutObjects->PushBackRange(chunk.m_Objects);
+        ref_stats += chunk.m_Stats;
+      }
+    }
   };
 } // namespace ezInternal
 
@@ -935,27 +1073,50 @@ void ezSpatialSystem_RegularGrid::FindVisibleObjects(const ezFrustum& frustum, c
     queryData.m_PlaneData.m_z4z5z4z5 = helperMat.m_col2;
     queryData.m_PlaneData.m_w4w5w4w5 = helperMat.m_col3;
 
+    const ezSimdVec4f planes[] = {plane0, plane1, plane2, plane3, plane4, plane5};
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(planes); ++i)
+    {
+      queryData.m_SplatPlaneData.m_Planes[i][0] = planes[i].Get<ezSwizzle::XXXX>();
+      queryData.m_SplatPlaneData.m_Planes[i][1] = planes[i].Get<ezSwizzle::YYYY>();
+      queryData.m_SplatPlaneData.m_Planes[i][2] = planes[i].Get<ezSwizzle::ZZZZ>();
+      queryData.m_SplatPlaneData.m_Planes[i][3] = planes[i].Get<ezSwizzle::WWWW>();
+    }
+
     queryData.m_pOutObjects = &out_Objects;
     queryData.m_uiFrameCounter = m_uiFrameCounter;
 
     queryData.m_IsOccludedCB = IsOccluded;
   }
 
+  CellCallback noFilterCallback = &ezInternal::QueryHelper::FrustumQueryCallback<false, false>;
+  CellCallback filterByTagsCallback = &ezInternal::QueryHelper::FrustumQueryCallback<true, false>;
+
   if (IsOccluded.IsValid())
   {
-    ForEachCellInBoxInMatchingGrids(simdBox, queryParams,
-      &ezInternal::QueryHelper::FrustumQueryCallback<false, true>,
-      &ezInternal::QueryHelper::FrustumQueryCallback<true, true>,
-      &queryData, visType);
-  }
-  else
-  {
-    ForEachCellInBoxInMatchingGrids(simdBox, queryParams,
-      &ezInternal::QueryHelper::FrustumQueryCallback<false, false>,
-      &ezInternal::QueryHelper::FrustumQueryCallback<true, false>,
-      &queryData, visType);
+    noFilterCallback = &ezInternal::QueryHelper::FrustumQueryCallback<false, true>;
+    filterByTagsCallback = &ezInternal::QueryHelper::FrustumQueryCallback<true, true>;
   }
 
+  // Collect the cells of each grid first, so that large numbers of objects can be culled in multiple tasks
+  ezHybridArray<const Cell*, 256> cells;
+
+  ForEachMatchingGrid(queryParams,
+    [&](const Grid& grid, bool bUseTagsFilter, Stats& ref_stats)
+    {
+      cells.Clear();
+      ezUInt32 uiNumObjects = 0;
+
+      grid.ForEachCellInBox(simdBox,
+        [&](const Cell& cell)
+        {
+          cells.PushBack(&cell);
+          uiNumObjects += cell.m_BoundingSpheres.GetCount();
+          return ezVisitorExecution::Continue;
+        });
+
+      ezInternal::QueryHelper::FrustumQueryInCells(cells, uiNumObjects, bUseTagsFilter ? filterByTagsCallback : noFilterCallback, queryParams, ref_stats, queryData, visType);
+    });
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   if (queryParams.m_pStats != nullptr)
   {
@@ -1111,13 +1272,25 @@ EZ_FORCE_INLINE void ezSpatialSystem_RegularGrid::ForEachGrid(const Data& data,
   }
 }
 
-void ezSpatialSystem_RegularGrid::ForEachCellInBoxInMatchingGrids(const ezSimdBBox& box, const QueryParams& queryParams, CellCallback noFilterCallback, CellCallback filterByTagsCallback, void* pUserData, ezVisibilityState visType) const
+template <typename Functor>
+void ezSpatialSystem_RegularGrid::ForEachMatchingGrid(const QueryParams& queryParams, Functor func) const
 {
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   if (queryParams.m_pStats != nullptr)
   {
     queryParams.m_pStats->m_uiTotalNumObjects = m_DataTable.GetCount();
   }
+
+  auto AddStats = [&](const Stats& stats)
+  {
+    if (queryParams.m_pStats != nullptr)
+    {
+      queryParams.m_pStats->m_uiNumObjectsTested += stats.m_uiNumObjectsTested;
+      queryParams.m_pStats->m_uiNumObjectsPassed += stats.m_uiNumObjectsPassed;
+      queryParams.m_pStats->m_uiNumObjectsCulled += stats.m_uiNumObjectsCulled;
+      queryParams.m_pStats->m_uiNumObjectsOccluded += stats.m_uiNumObjectsOccluded;
+    }
+  };
 #endif
 
   ezUInt32 uiGridBitmask = queryParams.m_uiCategoryBitmask;
@@ -1137,26 +1310,17 @@ void ezSpatialSystem_RegularGrid::ForEachCellInBoxInMatchingGrids(const ezSimdBB
     uiGridBitmask &= ~pGrid->m_Category.GetBitmask();
 
     Stats stats;
-    pGrid->ForEachCellInBox(box,
-      [&](const Cell& cell)
-      {
-        return noFilterCallback(cell, queryParams, stats, pUserData, visType);
-      });
+    func(*pGrid, false, stats);
 
     UpdateCacheCandidate(queryParams.m_pIncludeTags, queryParams.m_pExcludeTags, pGrid->m_Category, 0.0f);
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-    if (queryParams.m_pStats != nullptr)
-    {
-      queryParams.m_pStats->m_uiNumObjectsTested += stats.m_uiNumObjectsTested;
-      queryParams.m_pStats->m_uiNumObjectsPassed += stats.m_uiNumObjectsPassed;
-    }
+    AddStats(stats);
 #endif
   }
 
   // then search for the rest
   const bool useTagsFilter = (queryParams.m_pIncludeTags && queryParams.m_pIncludeTags->IsEmpty() == false) || (queryParams.m_pExcludeTags && queryParams.m_pExcludeTags->IsEmpty() == false);
-  CellCallback cellCallback = useTagsFilter ? filterByTagsCallback : noFilterCallback;
 
   while (uiGridBitmask > 0)
   {
@@ -1168,11 +1332,7 @@ void ezSpatialSystem_RegularGrid::ForEachCellInBoxInMatchingGrids(const ezSimdBB
       continue;
 
     Stats stats;
-    pGrid->ForEachCellInBox(box,
-      [&](const Cell& cell)
-      {
-        return cellCallback(cell, queryParams, stats, pUserData, visType);
-      });
+    func(*pGrid, useTagsFilter, stats);
 
     if (pGrid->m_bCanBeCached && useTagsFilter)
     {
@@ -1190,15 +1350,26 @@ void ezSpatialSystem_RegularGrid::ForEachCellInBoxInMatchingGrids(const ezSimdBB
     }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-    if (queryParams.m_pStats != nullptr)
-    {
-      queryParams.m_pStats->m_uiNumObjectsTested += stats.m_uiNumObjectsTested;
-      queryParams.m_pStats->m_uiNumObjectsPassed += stats.m_uiNumObjectsPassed;
-    }
+    AddStats(stats);
 #endif
   }
 }
 
+void ezSpatialSystem_RegularGrid::ForEachCellInBoxInMatchingGrids(const ezSimdBBox& box, const QueryParams& queryParams, CellCallback noFilterCallback, CellCallback filterByTagsCallback, void* pUserData, ezVisibilityState visType) const
+{
+  ForEachMatchingGrid(queryParams,
+    [&](const Grid& grid, bool bUseTagsFilter, Stats& ref_stats)
+    {
+      CellCallback cellCallback = bUseTagsFilter ? filterByTagsCallback : noFilterCallback;
+
+      grid.ForEachCellInBox(box,
+        [&](const Cell& cell)
+        {
+          return cellCallback(cell, queryParams, ref_stats, pUserData, visType);
+        });
+    });
+}
+
 void ezSpatialSystem_RegularGrid::MigrateCachedGrid(ezUInt32 uiCandidateIndex)
 {
   ezUInt32 uiTargetGridIndex = ezInvalidIndex;
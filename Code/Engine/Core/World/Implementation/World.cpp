@@ -409,19 +409,7 @@ void ezWorld::PostMessage(const ezGameObjectHandle& receiverObject, const ezMess
     delay = ezMath::Max(delay, ezTime::MakeFromMilliseconds(1));
   }
 
-  ezRTTIAllocator* pMsgRTTIAllocator = msg.GetDynamicRTTI()->GetAllocator();
-  if (delay.IsPositive())
-  {
-    ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, &m_Data.m_Allocator);
-
-    metaData.m_Due = m_Data.m_Clock.GetAccumulatedTime() + delay;
-    m_Data.m_TimedMessageQueues[queueType].Enqueue(pMsgCopy, metaData);
-  }
-  else
-  {
-    ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, m_Data.m_StackAllocator.GetCurrentAllocator());
-    m_Data.m_MessageQueues[queueType].Enqueue(pMsgCopy, metaData);
-  }
+  m_Data.StageMessage(msg, metaData, queueType, delay);
 }
 
 void ezWorld::PostMessage(const ezComponentHandle& hReceiverComponent, const ezMessage& msg, ezTime delay, ezObjectMsgQueueType::Enum queueType) const
@@ -440,19 +428,7 @@ void ezWorld::PostMessage(const ezComponentHandle& hReceiverComponent, const ezM
     delay = ezMath::Max(delay, ezTime::MakeFromMilliseconds(1));
   }
 
-  ezRTTIAllocator* pMsgRTTIAllocator = msg.GetDynamicRTTI()->GetAllocator();
-  if (delay.IsPositive())
-  {
-    ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, &m_Data.m_Allocator);
-
-    metaData.m_Due = m_Data.m_Clock.GetAccumulatedTime() + delay;
-    m_Data.m_TimedMessageQueues[queueType].Enqueue(pMsgCopy, metaData);
-  }
-  else
-  {
-    ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, m_Data.m_StackAllocator.GetCurrentAllocator());
-    m_Data.m_MessageQueues[queueType].Enqueue(pMsgCopy, metaData);
-  }
+  m_Data.StageMessage(msg, metaData, queueType, delay);
 }
 
 void ezWorld::FindEventMsgHandlers(const ezMessage& msg, ezGameObject* pSearchObject, ezDynamicArray<ezComponent*>& out_components)
@@ -552,6 +528,7 @@ void ezWorld::Update()
   // update transforms
   {
     EZ_PROFILE_SCOPE("Update Transforms");
+    UpdateDirtyStaticTransforms();
     m_Data.UpdateGlobalTransforms();
   }
 
@@ -573,7 +550,7 @@ void ezWorld::Update()
   }
 
   // Swap our double buffered stack allocator
-  m_Data.m_StackAllocator.Swap();
+  m_Data.SwapStackAllocator();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -917,6 +894,9 @@ void ezWorld::ProcessQueuedMessages(ezObjectMsgQueueType::Enum queueType)
     }
   };
 
+  // messages that have been posted since the last call
+  m_Data.MergeStagedMessages();
+
   // regular messages
   {
     ezInternal::WorldData::MessageQueue& queue = m_Data.m_MessageQueues[queueType];
@@ -936,25 +916,25 @@ void ezWorld::ProcessQueuedMessages(ezObjectMsgQueueType::Enum queueType)
 
   // timed messages
   {
-    ezInternal::WorldData::MessageQueue& queue = m_Data.m_TimedMessageQueues[queueType];
-    queue.Sort(MessageComparer());
+    ezInternal::WorldData::TimedMessageWheel& wheel = m_Data.m_TimedMessageWheels[queueType];
 
     const ezTime now = m_Data.m_Clock.GetAccumulatedTime();
 
+    auto& dueMessages = m_Data.m_DueMessages;
+    wheel.TakeDueEntries(now, dueMessages);
+    dueMessages.Sort(MessageComparer());
+
+    // messages that are posted while processing are never due before the next update, since they have a delay
     m_Data.m_ProcessingMessageQueue = queueType;
-    while (!queue.IsEmpty())
+    for (auto& entry : dueMessages)
     {
-      auto& entry = queue.Peek();
-      if (entry.m_MetaData.m_Due > now)
-        break;
-
       ProcessQueuedMessage(entry);
 
       EZ_DELETE(&m_Data.m_Allocator, entry.m_pMessage);
-
-      queue.Dequeue();
     }
     m_Data.m_ProcessingMessageQueue = ezObjectMsgQueueType::COUNT;
+
+    dueMessages.Clear();
   }
 }
 
@@ -1491,6 +1471,54 @@ void ezWorld::RecreateHierarchyData(ezGameObject* pObject, bool bWasDynamic)
   }
 }
 
+void ezWorld::AddStaticObjectWithDirtyTransform(const ezGameObjectHandle& hObject)
+{
+  CheckForWriteAccess();
+
+  m_Data.m_StaticObjectsWithDirtyTransform.PushBack(hObject);
+}
+
+void ezWorld::UpdateDirtyStaticTransforms()
+{
+  if (m_Data.m_StaticObjectsWithDirtyTransform.IsEmpty())
+    return;
+
+  EZ_PROFILE_SCOPE("Update Static Transforms");
+
+  ezHybridArray<ezGameObject*, 64> dirtyObjects(ezFrameAllocator::GetCurrentAllocator());
+
+  for (const ezGameObjectHandle& hObject : m_Data.m_StaticObjectsWithDirtyTransform)
+  {
+    ezGameObject* pObject = nullptr;
+    if (TryGetObject(hObject, pObject) && pObject->m_Flags.IsSet(ezObjectFlags::StaticTransformDirty))
+    {
+      dirtyObjects.PushBack(pObject);
+    }
+  }
+
+  m_Data.m_StaticObjectsWithDirtyTransform.Clear();
+
+  // Update parents before their children. The recursive update of a parent clears the dirty flag of all its children,
+  // so every hierarchy is only updated once, no matter how many of its objects were changed.
+  dirtyObjects.Sort([](const ezGameObject* a, const ezGameObject* b)
+    { return a->m_uiHierarchyLevel < b->m_uiHierarchyLevel; });
+
+  for (ezGameObject* pObject : dirtyObjects)
+  {
+    if (!pObject->m_Flags.IsSet(ezObjectFlags::StaticTransformDirty))
+      continue;
+
+    if (pObject->IsDynamic())
+    {
+      // dynamic objects are updated with the rest of the dynamic hierarchy anyway
+      pObject->m_Flags.Remove(ezObjectFlags::StaticTransformDirty);
+      continue;
+    }
+
+    pObject->UpdateGlobalTransformAndBoundsRecursive();
+  }
+}
+
 void ezWorld::ProcessResourceReloadFunctions()
 {
   ResourceReloadContext context;
@@ -27,6 +27,9 @@ namespace ezInternal
     }
   };
 
+  static ezAtomicInteger64 s_iNextStagingBufferId;
+  static ezAtomicInteger32 s_iNextPostingThreadIndex;
+
   ////////////////////////////////////////////////////////////////////////////////////////////////////
 
   void WorldData::UpdateTask::Execute()
@@ -40,6 +43,448 @@ namespace ezInternal
 
   ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+  WorldData::StagedMessageAllocator::StagedMessageAllocator(const WorldData& worldData)
+    : m_WorldData(worldData)
+  {
+  }
+
+  void* WorldData::StagedMessageAllocator::Allocate(size_t uiSize, size_t uiAlign, ezMemoryUtils::DestructorFunction destructorFunc)
+  {
+    if (m_pChunk == nullptr || m_uiChunkStackAllocatorSwapCount != m_WorldData.m_uiStackAllocatorSwapCount)
+    {
+      m_pChunk = nullptr;
+    }
+
+    if (m_pChunk != nullptr)
+    {
+      if (void* pPtr = m_pChunk->Allocate(uiSize, uiAlign, destructorFunc))
+        return pPtr;
+    }
+
+    ezAllocator* pStackAllocator = m_WorldData.m_StackAllocator.GetCurrentAllocator();
+
+    // the chunk is freed by the stack allocator, which then also calls the destructors of the messages
+    m_pChunk = EZ_NEW(pStackAllocator, Chunk);
+    m_uiChunkStackAllocatorSwapCount = m_WorldData.m_uiStackAllocatorSwapCount;
+
+    if (void* pPtr = m_pChunk->Allocate(uiSize, uiAlign, destructorFunc))
+      return pPtr;
+
+    // too large for a chunk
+    return pStackAllocator->Allocate(uiSize, uiAlign, destructorFunc);
+  }
+
+  void WorldData::StagedMessageAllocator::Deallocate(void* pPtr)
+  {
+    EZ_IGNORE_UNUSED(pPtr);
+
+    // the memory is freed when the stack allocator is reset
+  }
+
+  size_t WorldData::StagedMessageAllocator::AllocatedSize(const void* pPtr)
+  {
+    EZ_IGNORE_UNUSED(pPtr);
+    return 0;
+  }
+
+  ezAllocatorId WorldData::StagedMessageAllocator::GetId() const
+  {
+    return ezAllocatorId();
+  }
+
+  ezAllocator::Stats WorldData::StagedMessageAllocator::GetStats() const
+  {
+    return Stats();
+  }
+
+  WorldData::StagedMessageAllocator::Chunk::~Chunk()
+  {
+    const Destructor* pDestructors = reinterpret_cast<const Destructor*>(m_Memory + Size) - m_uiNumDestructors;
+
+    for (ezUInt32 i = 0; i < m_uiNumDestructors; ++i)
+    {
+      pDestructors[i].m_Func(pDestructors[i].m_pPtr);
+    }
+  }
+
+  void* WorldData::StagedMessageAllocator::Chunk::Allocate(size_t uiSize, size_t uiAlign, ezMemoryUtils::DestructorFunction destructorFunc)
+  {
+    if (uiAlign > alignof(Chunk))
+      return nullptr;
+
+    const size_t uiOffset = ezMemoryUtils::AlignSize<size_t>(m_uiUsedSize, uiAlign);
+    const size_t uiNumDestructors = m_uiNumDestructors + (destructorFunc != nullptr ? 1 : 0);
+
+    if (uiOffset + uiSize + uiNumDestructors * sizeof(Destructor) > Size)
+      return nullptr;
+
+    void* pPtr = m_Memory + uiOffset;
+    m_uiUsedSize = static_cast<ezUInt32>(uiOffset + uiSize);
+
+    if (destructorFunc != nullptr)
+    {
+      m_uiNumDestructors = static_cast<ezUInt32>(uiNumDestructors);
+
+      Destructor& destructor = reinterpret_cast<Destructor*>(m_Memory + Size)[-static_cast<ezInt32>(m_uiNumDestructors)];
+      destructor.m_Func = destructorFunc;
+      destructor.m_pPtr = pPtr;
+    }
+
+    return pPtr;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+  WorldData::MessageStagingBuffer::MessageStagingBuffer(WorldData& worldData)
+    : m_Messages(&worldData.m_Allocator)
+    , m_MessageAllocator(worldData)
+  {
+  }
+
+  void WorldData::MessageStagingBuffer::Lock()
+  {
+    // only the posting thread and the merge ever lock the buffer
+    while (!m_iLocked.TestAndSet(0, 1))
+    {
+      ezThreadUtils::YieldTimeSlice();
+    }
+  }
+
+  void WorldData::MessageStagingBuffer::Unlock()
+  {
+    m_iLocked.Set(0);
+  }
+
+  WorldData::MessageStagingBuffer& WorldData::GetStagingBufferOfCurrentThread() const
+  {
+    struct CachedStagingBuffer
+    {
+      ezInt64 m_iStagingBufferId = 0;
+      MessageStagingBuffer* m_pBuffer = nullptr;
+    };
+
+    // a few buffers are cached, so that threads posting to different worlds don't need to look up their buffer every time
+    static thread_local CachedStagingBuffer s_CachedBuffers[4];
+    static thread_local ezUInt32 s_uiNextCachedBuffer = 0;
+    static thread_local ezUInt32 s_uiThreadIndex = 0;
+
+    for (const CachedStagingBuffer& cachedBuffer : s_CachedBuffers)
+    {
+      if (cachedBuffer.m_iStagingBufferId == m_iStagingBufferId)
+        return *cachedBuffer.m_pBuffer;
+    }
+
+    if (s_uiThreadIndex == 0)
+    {
+      s_uiThreadIndex = static_cast<ezUInt32>(s_iNextPostingThreadIndex.Increment());
+    }
+
+    MessageStagingBuffer* pBuffer = nullptr;
+    {
+      EZ_LOCK(m_StagingBuffersMutex);
+
+      if (!m_StagingBuffers.TryGetValue(s_uiThreadIndex, pBuffer))
+      {
+        pBuffer = EZ_NEW(&m_Allocator, MessageStagingBuffer, const_cast<WorldData&>(*this));
+        m_StagingBuffers.Insert(s_uiThreadIndex, pBuffer);
+      }
+    }
+
+    CachedStagingBuffer& cachedBuffer = s_CachedBuffers[s_uiNextCachedBuffer];
+    cachedBuffer.m_iStagingBufferId = m_iStagingBufferId;
+    cachedBuffer.m_pBuffer = pBuffer;
+    s_uiNextCachedBuffer = (s_uiNextCachedBuffer + 1) % EZ_ARRAY_SIZE(s_CachedBuffers);
+
+    return *pBuffer;
+  }
+
+  void WorldData::StageMessage(const ezMessage& msg, QueuedMsgMetaData metaData, ezObjectMsgQueueType::Enum queueType, ezTime delay) const
+  {
+    MessageStagingBuffer& buffer = GetStagingBufferOfCurrentThread();
+
+    ezRTTIAllocator* pMsgRTTIAllocator = msg.GetDynamicRTTI()->GetAllocator();
+    const bool bTimed = delay.IsPositive();
+
+    // the message is copied while the buffer is locked, so the stack allocator can't be swapped before the copy is staged
+    buffer.Lock();
+
+    ezMessage* pMsgCopy = nullptr;
+    if (bTimed)
+    {
+      pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, &m_Allocator);
+      metaData.m_Due = m_Clock.GetAccumulatedTime() + delay;
+    }
+    else
+    {
+      // the message allocator is only used by this thread
+      pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, &buffer.m_MessageAllocator);
+    }
+
+    auto& stagedMessage = buffer.m_Messages.ExpandAndGetRef();
+    stagedMessage.m_Entry.m_pMessage = pMsgCopy;
+    stagedMessage.m_Entry.m_MetaData = metaData;
+    stagedMessage.m_QueueType = queueType;
+    stagedMessage.m_bTimed = bTimed;
+
+    buffer.Unlock();
+  }
+
+  void WorldData::MergeStagedMessages()
+  {
+    EZ_LOCK(m_StagingBuffersMutex);
+
+    for (auto it : m_StagingBuffers)
+    {
+      MessageStagingBuffer& buffer = *it.Value();
+
+      buffer.Lock();
+      MergeStagingBuffer(buffer);
+      buffer.Unlock();
+    }
+  }
+
+  void WorldData::MergeStagingBuffer(MessageStagingBuffer& ref_buffer)
+  {
+    for (const auto& stagedMessage : ref_buffer.m_Messages)
+    {
+      if (stagedMessage.m_bTimed)
+      {
+        m_TimedMessageWheels[stagedMessage.m_QueueType].Insert(stagedMessage.m_Entry);
+      }
+      else
+      {
+        m_MessageQueues[stagedMessage.m_QueueType].Enqueue(stagedMessage.m_Entry.m_pMessage, stagedMessage.m_Entry.m_MetaData);
+      }
+    }
+
+    // keeps the capacity for the next messages of this thread
+    ref_buffer.m_Messages.Clear();
+  }
+
+  void WorldData::SwapStackAllocator()
+  {
+    EZ_LOCK(m_StagingBuffersMutex);
+
+    // All buffers stay locked until the swap is done. Otherwise a message that was copied into the current stack allocator could be merged
+    // after the swap and only be processed in the frame after that, when its memory has already been freed.
+    for (auto it : m_StagingBuffers)
+    {
+      it.Value()->Lock();
+      MergeStagingBuffer(*it.Value());
+    }
+
+    m_StackAllocator.Swap();
+    ++m_uiStackAllocatorSwapCount;
+
+    for (auto it : m_StagingBuffers)
+    {
+      it.Value()->Unlock();
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+  WorldData::TimedMessageWheel::TimedMessageWheel()
+  {
+    for (ezUInt32 uiLevel = 0; uiLevel < NumLevels; ++uiLevel)
+    {
+      for (ezUInt32 uiSlot = 0; uiSlot < NumSlots; ++uiSlot)
+      {
+        m_Slots[uiLevel][uiSlot] = ezInvalidIndex;
+      }
+    }
+  }
+
+  void WorldData::TimedMessageWheel::Insert(const MessageQueue::Entry& entry)
+  {
+    ezUInt32 uiNodeIndex = m_uiFirstFreeNode;
+    if (uiNodeIndex != ezInvalidIndex)
+    {
+      m_uiFirstFreeNode = m_Nodes[uiNodeIndex].m_uiNext;
+    }
+    else
+    {
+      uiNodeIndex = m_Nodes.GetCount();
+      m_Nodes.ExpandAndGetRef();
+    }
+
+    Node& node = m_Nodes[uiNodeIndex];
+    node.m_Entry = entry;
+    node.m_iTick = GetTick(entry.m_MetaData.m_Due);
+
+    InsertNode(uiNodeIndex);
+  }
+
+  void WorldData::TimedMessageWheel::TakeDueEntries(ezTime now, MessageEntryArray& out_entries)
+  {
+    const ezInt64 iTargetTick = GetTick(now);
+
+    if (iTargetTick < m_iCurrentTick)
+    {
+      // the clock has been set back, all messages need to be sorted in again relative to the new time
+      TakeAllEntries(m_TempEntries);
+
+      m_iCurrentTick = iTargetTick;
+
+      for (const auto& entry : m_TempEntries)
+      {
+        Insert(entry);
+      }
+
+      m_TempEntries.Clear();
+    }
+
+    while (m_iCurrentTick < iTargetTick)
+    {
+      // find the next tick at which a slot needs to be processed, all slots of one level lie before the slots of the next higher level
+      ezUInt32 uiLevel = 0;
+      ezInt64 iNextTick = ezMath::MaxValue<ezInt64>();
+
+      for (; uiLevel < NumLevels; ++uiLevel)
+      {
+        const ezUInt32 uiShift = uiLevel * SlotBits;
+        const ezUInt32 uiCurrentSlot = static_cast<ezUInt32>(m_iCurrentTick >> uiShift) & (NumSlots - 1);
+        const ezUInt64 uiLaterSlots = (uiCurrentSlot + 1 < NumSlots) ? (m_OccupiedSlots[uiLevel] & (ezUInt64(-1) << (uiCurrentSlot + 1))) : 0;
+
+        if (uiLaterSlots != 0)
+        {
+          const ezInt64 iBlockStart = (m_iCurrentTick >> (uiShift + SlotBits)) << (uiShift + SlotBits);
+          iNextTick = iBlockStart + (ezInt64(ezMath::FirstBitLow(uiLaterSlots)) << uiShift);
+          break;
+        }
+      }
+
+      if (uiLevel == NumLevels && m_uiOverflow != ezInvalidIndex)
+      {
+        const ezUInt32 uiShift = NumLevels * SlotBits;
+        iNextTick = ((m_iCurrentTick >> uiShift) + 1) << uiShift;
+      }
+
+      if (iNextTick > iTargetTick)
+      {
+        m_iCurrentTick = iTargetTick;
+        break;
+      }
+
+      m_iCurrentTick = iNextTick;
+
+      ezUInt32 uiFirstNodeIndex = ezInvalidIndex;
+      if (uiLevel < NumLevels)
+      {
+        const ezUInt32 uiSlot = static_cast<ezUInt32>(m_iCurrentTick >> (uiLevel * SlotBits)) & (NumSlots - 1);
+        uiFirstNodeIndex = m_Slots[uiLevel][uiSlot];
+        m_Slots[uiLevel][uiSlot] = ezInvalidIndex;
+        m_OccupiedSlots[uiLevel] &= ~(ezUInt64(1) << uiSlot);
+      }
+      else
+      {
+        uiFirstNodeIndex = m_uiOverflow;
+        m_uiOverflow = ezInvalidIndex;
+      }
+
+      // the messages end up in lower levels or in the current tick list
+      ReinsertList(uiFirstNodeIndex);
+    }
+
+    for (ezUInt32 i = 0; i < m_CurrentTickEntries.GetCount();)
+    {
+      if (m_CurrentTickEntries[i].m_MetaData.m_Due <= now)
+      {
+        out_entries.PushBack(m_CurrentTickEntries[i]);
+        m_CurrentTickEntries.RemoveAtAndSwap(i);
+      }
+      else
+      {
+        ++i;
+      }
+    }
+  }
+
+  void WorldData::TimedMessageWheel::TakeAllEntries(MessageEntryArray& out_entries)
+  {
+    for (ezUInt32 uiLevel = 0; uiLevel < NumLevels; ++uiLevel)
+    {
+      for (ezUInt32 uiSlot = 0; uiSlot < NumSlots; ++uiSlot)
+      {
+        m_Slots[uiLevel][uiSlot] = ezInvalidIndex;
+      }
+
+      m_OccupiedSlots[uiLevel] = 0;
+    }
+
+    out_entries.PushBackRange(m_CurrentTickEntries);
+    m_CurrentTickEntries.Clear();
+
+    // free nodes are marked with an invalid tick
+    for (const Node& node : m_Nodes)
+    {
+      if (node.m_iTick >= 0)
+      {
+        out_entries.PushBack(node.m_Entry);
+      }
+    }
+
+    m_Nodes.Clear();
+    m_uiOverflow = ezInvalidIndex;
+    m_uiFirstFreeNode = ezInvalidIndex;
+  }
+
+  // static
+  ezInt64 WorldData::TimedMessageWheel::GetTick(ezTime time)
+  {
+    return ezMath::Max(static_cast<ezInt64>(ezMath::Floor(time.GetMilliseconds())), ezInt64(0));
+  }
+
+  void WorldData::TimedMessageWheel::InsertNode(ezUInt32 uiNodeIndex)
+  {
+    Node& node = m_Nodes[uiNodeIndex];
+
+    if (node.m_iTick <= m_iCurrentTick)
+    {
+      m_CurrentTickEntries.PushBack(node.m_Entry);
+      FreeNode(uiNodeIndex);
+      return;
+    }
+
+    // use the lowest level whose slots cover the time range that contains both the current and the due tick
+    for (ezUInt32 uiLevel = 0; uiLevel < NumLevels; ++uiLevel)
+    {
+      const ezUInt32 uiShift = uiLevel * SlotBits;
+      if ((node.m_iTick >> (uiShift + SlotBits)) == (m_iCurrentTick >> (uiShift + SlotBits)))
+      {
+        const ezUInt32 uiSlot = static_cast<ezUInt32>(node.m_iTick >> uiShift) & (NumSlots - 1);
+        node.m_uiNext = m_Slots[uiLevel][uiSlot];
+        m_Slots[uiLevel][uiSlot] = uiNodeIndex;
+        m_OccupiedSlots[uiLevel] |= ezUInt64(1) << uiSlot;
+        return;
+      }
+    }
+
+    node.m_uiNext = m_uiOverflow;
+    m_uiOverflow = uiNodeIndex;
+  }
+
+  void WorldData::TimedMessageWheel::ReinsertList(ezUInt32 uiFirstNodeIndex)
+  {
+    ezUInt32 uiNodeIndex = uiFirstNodeIndex;
+    while (uiNodeIndex != ezInvalidIndex)
+    {
+      const ezUInt32 uiNextNodeIndex = m_Nodes[uiNodeIndex].m_uiNext;
+      InsertNode(uiNodeIndex);
+      uiNodeIndex = uiNextNodeIndex;
+    }
+  }
+
+  void WorldData::TimedMessageWheel::FreeNode(ezUInt32 uiNodeIndex)
+  {
+    Node& node = m_Nodes[uiNodeIndex];
+    node.m_iTick = -1;
+    node.m_uiNext = m_uiFirstFreeNode;
+    m_uiFirstFreeNode = uiNodeIndex;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+
   WorldData::WorldData(ezWorldDesc& desc)
     : m_sName(desc.m_sName)
     , m_Allocator(desc.m_sName, ezFoundation::GetDefaultAllocator())
@@ -57,6 +502,8 @@ namespace ezInternal
   {
     m_AllocatorWrapper.Reset();
 
+    m_iStagingBufferId = s_iNextStagingBufferId.Increment();
+
     if (desc.m_uiRandomNumberGeneratorSeed == 0)
     {
       m_Random.InitializeFromCurrentTime();
@@ -111,6 +558,11 @@ namespace ezInternal
   WorldData::~WorldData()
   {
     ezResourceManager::GetResourceEvents().RemoveEventHandler(ezMakeDelegate(&WorldData::ResourceEventHandler, this));
+
+    for (auto it : m_StagingBuffers)
+    {
+      EZ_DELETE(&m_Allocator, it.Value());
+    }
   }
 
   void WorldData::Clear()
@@ -165,10 +617,14 @@ namespace ezInternal
       hierarchy.m_Data.Clear();
     }
 
+    m_StaticObjectsWithDirtyTransform.Clear();
+
     // delete task storage
     m_UpdateTasks.Clear();
 
     // delete queued messages
+    MergeStagedMessages();
+
     for (ezUInt32 i = 0; i < ezObjectMsgQueueType::COUNT; ++i)
     {
       {
@@ -179,14 +635,12 @@ namespace ezInternal
       }
 
       {
-        MessageQueue& queue = m_TimedMessageQueues[i];
-        while (!queue.IsEmpty())
+        m_TimedMessageWheels[i].TakeAllEntries(m_DueMessages);
+        for (auto& entry : m_DueMessages)
         {
-          MessageQueue::Entry& entry = queue.Peek();
           EZ_DELETE(&m_Allocator, entry.m_pMessage);
-
-          queue.Dequeue();
         }
+        m_DueMessages.Clear();
       }
     }
   }
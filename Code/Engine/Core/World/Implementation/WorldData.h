@@ -34,7 +34,8 @@ namespace ezInternal
     enum
     {
       GAME_OBJECTS_PER_BLOCK = ezDataBlock<ezGameObject, ezInternal::DEFAULT_BLOCK_SIZE>::CAPACITY,
-      TRANSFORMATION_DATA_PER_BLOCK = ezDataBlock<ezGameObject::TransformationData, ezInternal::DEFAULT_BLOCK_SIZE>::CAPACITY
+      TRANSFORMATION_DATA_PER_BLOCK = ezDataBlock<ezGameObject::TransformationData, ezInternal::DEFAULT_BLOCK_SIZE>::CAPACITY,
+      MIN_TRANSFORMS_PER_TASK = 1024, ///< hierarchy levels with fewer objects are updated without spawning tasks
     };
 
     // object storage
@@ -43,6 +44,9 @@ namespace ezInternal
     ObjectStorage m_ObjectStorage;
 
     ezSet<ezGameObject*, ezCompareHelper<ezGameObject*>, ezLocalAllocatorWrapper> m_DeadObjects;
+
+    // static objects that were moved with UpdateBehaviorIfStatic::UpdateDeferred and still need to update their hierarchy
+    ezDynamicArray<ezGameObjectHandle, ezLocalAllocatorWrapper> m_StaticObjectsWithDirtyTransform;
     ezEvent<const ezGameObject*> m_ObjectDeletionEvent;
 
   public:
@@ -232,8 +236,146 @@ namespace ezInternal
     };
 
     using MessageQueue = ezMessageQueue<QueuedMsgMetaData, ezLocalAllocatorWrapper>;
+    using MessageEntryArray = ezDynamicArray<MessageQueue::Entry, ezLocalAllocatorWrapper>;
+
+    /// \brief Hierarchical timing wheel that holds timed messages until they are due.
+    ///
+    /// Each level splits the time range of one slot of the next higher level into 64 slots, the lowest level has a resolution of one millisecond.
+    /// Messages are moved down to the lower levels while their due time comes closer, so finding the due messages only depends on the number of
+    /// messages that become due and not on the number of messages that are scheduled further in the future.
+    class TimedMessageWheel
+    {
+    public:
+      TimedMessageWheel();
+
+      /// \brief Schedules the given message.
+      void Insert(const MessageQueue::Entry& entry);
+
+      /// \brief Removes all messages that are due at the given time and appends them to out_entries. The messages are not sorted.
+      void TakeDueEntries(ezTime now, MessageEntryArray& out_entries);
+
+      /// \brief Removes all messages and appends them to out_entries.
+      void TakeAllEntries(MessageEntryArray& out_entries);
+
+    private:
+      static constexpr ezUInt32 NumLevels = 4;
+      static constexpr ezUInt32 SlotBits = 6;
+      static constexpr ezUInt32 NumSlots = 1 << SlotBits;
+
+      struct Node
+      {
+        MessageQueue::Entry m_Entry;
+        ezInt64 m_iTick;
+        ezUInt32 m_uiNext;
+      };
+
+      static ezInt64 GetTick(ezTime time);
+      void InsertNode(ezUInt32 uiNodeIndex);
+      void ReinsertList(ezUInt32 uiFirstNodeIndex);
+      void FreeNode(ezUInt32 uiNodeIndex);
+
+      ezInt64 m_iCurrentTick = 0;
+      ezUInt32 m_Slots[NumLevels][NumSlots];
+      ezUInt64 m_OccupiedSlots[NumLevels] = {};
+      ezUInt32 m_uiOverflow = ezInvalidIndex;
+      ezUInt32 m_uiFirstFreeNode = ezInvalidIndex;
+      ezDynamicArray<Node, ezLocalAllocatorWrapper> m_Nodes;
+
+      // messages of the current tick, they might not be due yet since the due time has a higher resolution
+      MessageEntryArray m_CurrentTickEntries;
+      MessageEntryArray m_TempEntries;
+    };
+
+    /// \brief Copies the messages that one thread posts into memory chunks taken from the world's stack allocator.
+    ///
+    /// Only the owning thread allocates through it, so the stack allocator is only locked once per chunk and not for every message.
+    /// A chunk can only be used until the stack allocator is swapped, since its memory is freed together with the other allocations of that frame.
+    class StagedMessageAllocator final : public ezAllocator
+    {
+    public:
+      StagedMessageAllocator(const WorldData& worldData);
+
+      virtual void* Allocate(size_t uiSize, size_t uiAlign, ezMemoryUtils::DestructorFunction destructorFunc) override;
+      virtual void Deallocate(void* pPtr) override;
+      virtual size_t AllocatedSize(const void* pPtr) override;
+      virtual ezAllocatorId GetId() const override;
+      virtual Stats GetStats() const override;
+
+    private:
+      struct Chunk
+      {
+        static constexpr ezUInt32 Size = 16 * 1024;
+
+        struct Destructor
+        {
+          ezMemoryUtils::DestructorFunction m_Func;
+          void* m_pPtr;
+        };
+
+        ~Chunk();
+
+        void* Allocate(size_t uiSize, size_t uiAlign, ezMemoryUtils::DestructorFunction destructorFunc);
+
+        ezUInt32 m_uiUsedSize = 0;
+        ezUInt32 m_uiNumDestructors = 0;
+
+        // the destructors are stored at the end of the memory, growing towards the allocations
+        alignas(16) ezUInt8 m_Memory[Size];
+      };
+
+      const WorldData& m_WorldData;
+      Chunk* m_pChunk = nullptr;
+      ezUInt32 m_uiChunkStackAllocatorSwapCount = 0;
+    };
+
+    /// \brief Messages that one thread has posted to this world and that have not been moved into the message queues yet.
+    ///
+    /// Every posting thread has its own buffer, which is kept for the lifetime of the world and reused after every merge.
+    /// The buffer is locked while a message is appended or while the buffer is merged, which only ever contends with the merge.
+    struct MessageStagingBuffer
+    {
+      struct StagedMessage
+      {
+        MessageQueue::Entry m_Entry;
+        ezObjectMsgQueueType::Enum m_QueueType;
+        bool m_bTimed;
+      };
+
+      MessageStagingBuffer(WorldData& worldData);
+
+      void Lock();
+      void Unlock();
+
+      ezAtomicInteger32 m_iLocked;
+      ezDynamicArray<StagedMessage> m_Messages;
+      StagedMessageAllocator m_MessageAllocator;
+    };
+
+    /// \brief Copies the message into the staging buffer of the calling thread. Can be called from multiple threads.
+    void StageMessage(const ezMessage& msg, QueuedMsgMetaData metaData, ezObjectMsgQueueType::Enum queueType, ezTime delay) const;
+
+    /// \brief Moves all staged messages into the message queues and timing wheels.
+    ///
+    /// Messages that are posted concurrently either end up in this merge or stay in their staging buffer for the next one.
+    void MergeStagedMessages();
+
+    /// \brief Merges the staged messages and swaps the stack allocator, without letting other threads post in between.
+    void SwapStackAllocator();
+
+    /// \brief Moves the messages of one staging buffer into the message queues and timing wheels. The buffer must be locked.
+    void MergeStagingBuffer(MessageStagingBuffer& ref_buffer);
+
+    MessageStagingBuffer& GetStagingBufferOfCurrentThread() const;
+
+    // unique across all worlds, so that a thread can't confuse the cached staging buffer of a deleted world with the one of a new world
+    ezInt64 m_iStagingBufferId = 0;
+    ezUInt32 m_uiStackAllocatorSwapCount = 0;
+    mutable ezMutex m_StagingBuffersMutex;
+    mutable ezHashTable<ezUInt32, MessageStagingBuffer*> m_StagingBuffers; // key is the posting thread index
+
     mutable MessageQueue m_MessageQueues[ezObjectMsgQueueType::COUNT];
-    mutable MessageQueue m_TimedMessageQueues[ezObjectMsgQueueType::COUNT];
+    TimedMessageWheel m_TimedMessageWheels[ezObjectMsgQueueType::COUNT];
+    MessageEntryArray m_DueMessages;
     ezObjectMsgQueueType::Enum m_ProcessingMessageQueue = ezObjectMsgQueueType::COUNT;
 
     ezThreadID m_WriteThreadID;
@@ -34,28 +34,52 @@ namespace ezInternal
   EZ_FORCE_INLINE ezVisitorExecution::Enum WorldData::TraverseHierarchyLevelMultiThreaded(
     Hierarchy::DataBlockArray& blocks, void* pUserData /* = nullptr*/)
   {
+    if (blocks.IsEmpty())
+      return ezVisitorExecution::Continue;
+
+    // all blocks except for the last one are always full, so the objects of a level can be addressed by index
+    const ezUInt32 uiNumObjects = (blocks.GetCount() - 1) * Hierarchy::DataBlock::CAPACITY + blocks.PeekBack().m_uiCount;
+
     ezParallelForParams parallelForParams;
-    parallelForParams.m_uiBinSize = 100;
+    parallelForParams.m_uiBinSize = MIN_TRANSFORMS_PER_TASK;
     parallelForParams.m_uiMaxTasksPerThread = 2;
     parallelForParams.m_pTaskAllocator = m_StackAllocator.GetCurrentAllocator();
 
-    ezTaskSystem::ParallelFor(
-      blocks.GetArrayPtr(),
-      [pUserData](ezArrayPtr<WorldData::Hierarchy::DataBlock> blocksSlice)
+    // small levels are cheaper to update right away than to hand them to the task system
+    if (uiNumObjects <= parallelForParams.m_uiBinSize)
+    {
+      return TraverseHierarchyLevel<VISITOR>(blocks, pUserData);
+    }
+
+    // split by objects instead of blocks, so that large levels are distributed evenly across all workers
+    ezTaskSystem::ParallelForIndexed(
+      0u, uiNumObjects,
+      [&blocks, pUserData](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
       {
-        for (WorldData::Hierarchy::DataBlock& block : blocksSlice)
+        ezUInt32 uiBlockIndex = uiStartIndex / Hierarchy::DataBlock::CAPACITY;
+        ezUInt32 uiIndexInBlock = uiStartIndex % Hierarchy::DataBlock::CAPACITY;
+        ezUInt32 uiRemaining = uiEndIndex - uiStartIndex;
+
+        while (uiRemaining > 0)
         {
-          ezGameObject::TransformationData* pCurrentData = block.m_pData;
-          ezGameObject::TransformationData* pEndData = block.m_pData + block.m_uiCount;
+          WorldData::Hierarchy::DataBlock& block = blocks[uiBlockIndex];
+          const ezUInt32 uiCount = ezMath::Min(uiRemaining, block.m_uiCount - uiIndexInBlock);
+
+          ezGameObject::TransformationData* pCurrentData = block.m_pData + uiIndexInBlock;
+          ezGameObject::TransformationData* pEndData = pCurrentData + uiCount;
 
           while (pCurrentData < pEndData)
           {
             VISITOR::Visit(pCurrentData, pUserData);
             ++pCurrentData;
           }
+
+          uiRemaining -= uiCount;
+          uiIndexInBlock = 0;
+          ++uiBlockIndex;
         }
       },
-      "World DataBlock Traversal Task", parallelForParams);
+      "World DataBlock Traversal Task", ezTaskNesting::Never, parallelForParams);
 
     return ezVisitorExecution::Continue;
   }
@@ -83,6 +83,12 @@ EZ_FORCE_INLINE ezUInt32 ezWorld::GetObjectCount() const
   return static_cast<ezUInt32>(m_Data.m_Objects.GetCount() - 1);
 }
 
+EZ_FORCE_INLINE ezUInt32 ezWorld::GetDeferredStaticTransformCount() const
+{
+  CheckForReadAccess();
+  return m_Data.m_StaticObjectsWithDirtyTransform.GetCount();
+}
+
 EZ_FORCE_INLINE ezInternal::WorldData::ObjectIterator ezWorld::GetObjects()
 {
   CheckForWriteAccess();
@@ -36,10 +36,12 @@ public:
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   struct QueryStats
   {
-    ezUInt32 m_uiTotalNumObjects = 0;  ///< The total number of spatial objects in this system.
-    ezUInt32 m_uiNumObjectsTested = 0; ///< Number of objects tested for the query condition.
-    ezUInt32 m_uiNumObjectsPassed = 0; ///< Number of objects that passed the query condition.
-    ezTime m_TimeTaken;                ///< Time taken to execute the query
+    ezUInt32 m_uiTotalNumObjects = 0;    ///< The total number of spatial objects in this system.
+    ezUInt32 m_uiNumObjectsTested = 0;   ///< Number of objects tested for the query condition.
+    ezUInt32 m_uiNumObjectsPassed = 0;   ///< Number of objects that passed the query condition.
+    ezUInt32 m_uiNumObjectsCulled = 0;   ///< Visibility queries only: Number of tested objects that are outside of the frustum.
+    ezUInt32 m_uiNumObjectsOccluded = 0; ///< Visibility queries only: Number of tested objects inside the frustum that were rejected by the occlusion callback.
+    ezTime m_TimeTaken;                  ///< Time taken to execute the query
   };
 #endif
 
@@ -59,14 +61,37 @@ public:
   virtual void FindObjectsInBox(const ezBoundingBox& box, const QueryParams& queryParams, ezDynamicArray<ezGameObject*>& out_objects) const;
   virtual void FindObjectsInBox(const ezBoundingBox& box, const QueryParams& queryParams, QueryCallback callback) const = 0;
 
+  ///@}
+  /// \name Batched Queries
+  ///@{
+
+  /// \brief Called with the index of the query shape that the object was found with. Returning Stop ends only that one query.
+  using BatchQueryCallback = ezDelegate<ezVisitorExecution::Enum(ezUInt32, ezGameObject*)>;
+
+  /// \brief Finds all objects that overlap any of the given spheres.
+  ///
+  /// The default implementation executes one query per sphere. Spatial systems that can share work between the queries, e.g. the tree traversal, override this.
+  virtual void FindObjectsInSpheres(ezArrayPtr<const ezBoundingSphere> spheres, const QueryParams& queryParams, BatchQueryCallback callback) const;
+
+  /// \brief Finds all objects that overlap any of the given boxes. See FindObjectsInSpheres().
+  virtual void FindObjectsInBoxes(ezArrayPtr<const ezBoundingBox> boxes, const QueryParams& queryParams, BatchQueryCallback callback) const;
+
   ///@}
   /// \name Visibility Queries
   ///@{
 
   using IsOccludedFunc = ezDelegate<bool(const ezSimdBBox&)>;
 
+  /// \brief Appends all objects inside the frustum that are not rejected by the optional occlusion callback to out_objects.
+  ///
+  /// Spatial systems may split the culling into multiple tasks, so isOccluded must be safe to be called from multiple threads at once.
   virtual void FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_objects, IsOccludedFunc isOccluded, ezVisibilityState visType) const = 0;
 
+  /// \brief Finds the visible objects for several views at once, e.g. the main view and its shadow cascades.
+  ///
+  /// The objects visible in frustums[i] are appended to out_objects[i]. The default implementation executes one query per frustum.
+  virtual void FindVisibleObjects(ezArrayPtr<const ezFrustum> frustums, const QueryParams& queryParams, ezArrayPtr<ezDynamicArray<const ezGameObject*>> out_objects, ezVisibilityState visType) const;
+
   /// \brief Retrieves a state describing how visible the object is.
   ///
   /// An object may be invisible, fully visible, or indirectly visible (through shadows or reflections).
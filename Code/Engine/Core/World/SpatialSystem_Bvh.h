@@ -0,0 +1,147 @@
+#pragma once
+
+#include <Core/World/SpatialSystem.h>
+#include <Foundation/Containers/IdTable.h>
+
+/// \brief A spatial system that stores all spatial data in a dynamic bounding volume hierarchy.
+///
+/// Unlike the regular grid this doesn't depend on a cell size that fits the scene, so it handles a mix of huge and tiny objects
+/// or very sparse scenes well. Each leaf holds several objects whose bounding spheres are stored next to each other, which keeps
+/// the tree flat and lets queries scan them linearly. Objects that overlap a lot, like huge terrain chunks, end up in one wide leaf
+/// since a deep tree wouldn't reject any of them anyway.
+/// Every object has slightly enlarged bounds, as long as a moving object stays inside of its leaf only the object data is updated.
+/// Otherwise the object is moved to another leaf, which only touches a small part of the tree.
+///
+/// Use it by setting ezWorldDesc::m_pSpatialSystem before creating the world.
+class EZ_CORE_DLL ezSpatialSystem_Bvh : public ezSpatialSystem
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezSpatialSystem_Bvh, ezSpatialSystem);
+
+public:
+  /// \brief The leaf margin scale is the distance an object can move before the tree needs to be updated, relative to the object's radius.
+  /// Moving objects additionally get their leaf extended by their last movement multiplied with the move prediction.
+  ezSpatialSystem_Bvh(float fLeafMarginScale = 0.25f, float fMovePrediction = 4.0f);
+  ~ezSpatialSystem_Bvh();
+
+  /// \brief Returns the bounds of all tree nodes down to the given depth. Useful for debug visualizations.
+  void GetNodeBoxes(ezDynamicArray<ezBoundingBox>& out_boundingBoxes, ezUInt32 uiMaxDepth = ezInvalidIndex) const;
+
+  /// \brief Returns the height of the tree, i.e. the number of nodes on the longest path from the root to a leaf.
+  ezUInt32 GetTreeHeight() const;
+
+private:
+  // ezSpatialSystem implementation
+  void StartNewFrame() override;
+
+  ezSpatialDataHandle CreateSpatialData(const ezSimdBBoxSphere& bounds, ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags) override;
+  ezSpatialDataHandle CreateSpatialDataAlwaysVisible(ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags) override;
+
+  void DeleteSpatialData(const ezSpatialDataHandle& hData) override;
+
+  void UpdateSpatialDataBounds(const ezSpatialDataHandle& hData, const ezSimdBBoxSphere& bounds) override;
+  void UpdateSpatialDataObject(const ezSpatialDataHandle& hData, ezGameObject* pObject) override;
+
+  void FindObjectsInSphere(const ezBoundingSphere& sphere, const QueryParams& queryParams, QueryCallback callback) const override;
+  void FindObjectsInBox(const ezBoundingBox& box, const QueryParams& queryParams, QueryCallback callback) const override;
+
+  void FindObjectsInSpheres(ezArrayPtr<const ezBoundingSphere> spheres, const QueryParams& queryParams, BatchQueryCallback callback) const override;
+  void FindObjectsInBoxes(ezArrayPtr<const ezBoundingBox> boxes, const QueryParams& queryParams, BatchQueryCallback callback) const override;
+
+  void FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_Objects, ezSpatialSystem::IsOccludedFunc IsOccluded, ezVisibilityState visType) const override;
+  void FindVisibleObjects(ezArrayPtr<const ezFrustum> frustums, const QueryParams& queryParams, ezArrayPtr<ezDynamicArray<const ezGameObject*>> out_Objects, ezVisibilityState visType) const override;
+
+  ezVisibilityState GetVisibilityState(const ezSpatialDataHandle& hData, ezUInt32 uiNumFramesBeforeInvisible) const override;
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  virtual void GetInternalStats(ezStringBuilder& sb) const override;
+#endif
+
+  ezProxyAllocator m_AlignedAllocator;
+
+  float m_fLeafMarginScale;
+  float m_fMovePrediction;
+
+  /// \brief Leaves that are created for a single inserted object have room for this many objects.
+  static constexpr ezUInt32 LeafCapacity = 8;
+
+  /// \brief The rebuild creates leaves with up to this many objects where a linear scan is cheaper than splitting them.
+  static constexpr ezUInt32 MaxLeafObjects = 1024;
+
+  struct Node
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    EZ_ALWAYS_INLINE bool IsLeaf() const { return m_uiNumObjects > 0; }
+
+    ezSimdBBox m_Bounds;
+    ezUInt32 m_uiParent;          ///< For nodes in the free list this is the index of the next free node
+    ezUInt32 m_uiCategoryBitmask; ///< Union of the category bitmasks of all objects in this sub-tree
+    ezInt16 m_iHeight;            ///< 0 for leaves, -1 for free nodes
+    ezUInt16 m_uiNumObjects;      ///< 0 for inner nodes
+    ezUInt32 m_uiChild0;
+    ezUInt32 m_uiChild1;
+    ezUInt32 m_uiFirstObject;    ///< Index into the leaf object arrays for leaves
+    ezUInt16 m_uiObjectCapacity; ///< Number of objects the leaf has room for
+    float m_fFittedArea;         ///< Surface area of the leaf when its bounds were last fitted to its objects
+  };
+
+  ezDynamicArray<Node> m_Nodes;
+
+  // The objects of a leaf are stored next to each other in these arrays. Everything a query needs to reject an object is stored here,
+  // so it doesn't need to touch the per data arrays.
+  ezDynamicArray<ezSimdBSphere> m_LeafSpheres;
+  ezDynamicArray<ezUInt32> m_LeafCategoryBitmasks;
+  ezDynamicArray<ezUInt32> m_LeafDataIndices;      ///< For free ranges the first entry is the index of the next free range
+  ezDynamicArray<ezSimdBBox> m_LeafEnlargedBounds; ///< Copy of the enlarged bounds, so a leaf can be refitted without gathering them from the per data array
+  ezUInt32 m_uiRootNode = ezInvalidIndex;
+  ezUInt32 m_uiFirstFreeNode = ezInvalidIndex;
+  ezUInt32 m_uiFirstFreeLeafObjects = ezInvalidIndex;
+  ezUInt32 m_uiNumUsedNodes = 0;
+  ezUInt32 m_uiNumInsertsSinceRebuild = 0;
+
+  ezUInt32 AllocateNode();
+  void FreeNode(ezUInt32 uiNodeIndex);
+  ezUInt32 AllocateLeafObjects();
+  void FreeLeafObjects(const Node& leaf);
+
+  void InsertObject(ezUInt32 uiDataIndex, ezUInt32 uiInsertionRoot = ezInvalidIndex);
+  void RemoveObject(ezUInt32 uiLeafIndex, ezUInt32 uiObjectIndex);
+  void InsertLeaf(ezUInt32 uiLeafIndex, ezUInt32 uiSibling);
+  void RemoveLeaf(ezUInt32 uiLeafIndex);
+  void RefitAncestors(ezUInt32 uiNodeIndex);
+  void RotateNodes(ezUInt32 uiNodeIndex);
+  void UpdateNodeFromChildren(Node& ref_node);
+  void UpdateLeafFromObjects(Node& ref_leaf);
+  void RebuildTree();
+
+  static ezSimdBBox GetTightBounds(const ezSimdBBoxSphere& bounds);
+  ezSimdBBox GetEnlargedBounds(const ezSimdBBoxSphere& bounds, const ezSimdVec4f& vDisplacement) const;
+
+  struct Data
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiNodeIndex;   ///< ezInvalidIndex for always visible data
+    ezUInt32 m_uiObjectIndex; ///< Index of the object in the leaf object arrays
+  };
+
+  ezIdTable<ezSpatialDataId, Data, ezLocalAllocatorWrapper> m_DataTable;
+
+  // Per data arrays, indexed by the instance index of the spatial data id
+  ezDynamicArray<ezSimdBBoxSphere> m_DataBounds;
+  ezDynamicArray<ezSimdBBox> m_DataEnlargedBounds; ///< The leaf bounds are the union of the enlarged bounds of their objects
+  ezDynamicArray<ezTagSet> m_DataTags;
+  ezDynamicArray<ezGameObject*> m_DataObjects;
+  ezDynamicArray<ezUInt32> m_DataCategoryBitmasks;
+  mutable ezDynamicArray<ezAtomicInteger64> m_DataLastVisibleFrameIdxAndVisType;
+
+  ezDynamicArray<ezUInt32> m_AlwaysVisibleData;
+
+  ezSpatialDataHandle AddSpatialData(const ezSimdBBoxSphere& bounds, ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags, bool bAlwaysVisible);
+
+  template <typename Shape>
+  void FindObjectsInShapes(ezArrayPtr<const Shape> shapes, const QueryParams& queryParams, BatchQueryCallback callback) const;
+
+  struct FrustumPlanes;
+  void FindVisibleObjectsInFrustums(ezArrayPtr<const FrustumPlanes> frustumPlanes, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>** pOutObjects, ezSpatialSystem::IsOccludedFunc IsOccluded, ezVisibilityState visType) const;
+};
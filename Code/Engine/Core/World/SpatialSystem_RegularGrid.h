@@ -88,6 +88,10 @@ private:
   using CellCallback = ezDelegate<ezVisitorExecution::Enum(const Cell&, const QueryParams&, Stats&, void*, ezVisibilityState)>;
   void ForEachCellInBoxInMatchingGrids(const ezSimdBBox& box, const QueryParams& queryParams, CellCallback noFilterCallback, CellCallback filterByTagsCallback, void* pUserData, ezVisibilityState visType) const;
 
+  /// \brief Calls func(grid, bUseTagsFilter, stats) for every grid that matches the query params and updates the cache candidates with the resulting stats.
+  template <typename Functor>
+  void ForEachMatchingGrid(const QueryParams& queryParams, Functor func) const;
+
   struct CacheCandidate
   {
     ezTagSet m_IncludeTags;
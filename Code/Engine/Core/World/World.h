@@ -80,6 +80,9 @@ public:
   /// \brief Returns the total number of objects in this world.
   ezUInt32 GetObjectCount() const;
 
+  /// \brief Returns the number of static objects that were moved with ezGameObject::UpdateBehaviorIfStatic::UpdateDeferred and wait for the next world update.
+  ezUInt32 GetDeferredStaticTransformCount() const;
+
   /// \brief Returns an iterator over all objects in this world in no specific order.
   ezInternal::WorldData::ObjectIterator GetObjects();
 
@@ -416,6 +419,8 @@ private:
 
   void PatchHierarchyData(ezGameObject* pObject, ezGameObject::TransformPreservation preserve);
   void RecreateHierarchyData(ezGameObject* pObject, bool bWasDynamic);
+  void AddStaticObjectWithDirtyTransform(const ezGameObjectHandle& hObject);
+  void UpdateDirtyStaticTransforms();
 
   void ProcessResourceReloadFunctions();
 
@@ -93,6 +93,32 @@ ezUniquePtr<ezWorldReader::InstantiationContextBase> ezWorldReader::InstantiateP
   return Instantiate(ref_world, true, rootTransform, options);
 }
 
+void ezWorldReader::InstantiatePrefabs(ezWorld& ref_world, ezArrayPtr<const ezTransform> rootTransforms, const ezPrefabInstantiationOptions& options)
+{
+  if (rootTransforms.IsEmpty())
+    return;
+
+  EZ_PROFILE_SCOPE("ezWorldReader::InstantiatePrefabs");
+
+  ezPrefabInstantiationOptions bulkOptions = options;
+  bulkOptions.m_MaxStepTime = ezTime::MakeZero();
+  bulkOptions.m_pProgress = nullptr;
+
+  EZ_LOCK(ref_world.GetWriteMarker());
+
+  InstantiationContext context(*this, &ref_world, true, rootTransforms[0], bulkOptions);
+
+  for (ezUInt32 i = 0; i < rootTransforms.GetCount(); ++i)
+  {
+    if (i > 0)
+    {
+      context.BeginNextInstance(rootTransforms[i]);
+    }
+
+    EZ_VERIFY(context.Step() == InstantiationContextBase::StepResult::Finished, "Instantiation should be completed after this call");
+  }
+}
+
 ezStreamReader& ezWorldReader::GetStream() const
 {
   ezWorldReader::InstantiationContext* pContext = ((ezWorldReader::InstantiationContext*)tl_pReaderContext);
@@ -694,6 +720,13 @@ bool ezWorldReader::InstantiationContext::DeserializeComponents(ezTime endTime)
       compTypeState.m_uiDataReadOffset = m_CurrentReader.GetReadPosition();
     }
 
+    if (m_uiCurrentIndex == 0 && CopyComponentsFromTemplate(compTypeState))
+    {
+      m_CurrentReader.SkipBytes(compTypeInfo.m_uiComponentDataSize);
+      m_uiCurrentNumComponentsProcessed += compTypeState.m_ComponentIndexToHandle.GetCount() - 1;
+      continue;
+    }
+
     while (m_uiCurrentIndex < compTypeState.m_ComponentIndexToHandle.GetCount())
     {
       ezComponent* pComponent = nullptr;
@@ -729,6 +762,34 @@ bool ezWorldReader::InstantiationContext::DeserializeComponents(ezTime endTime)
   return true;
 }
 
+bool ezWorldReader::InstantiationContext::CopyComponentsFromTemplate(ComponentTypeState& ref_compTypeState)
+{
+  if (!ref_compTypeState.m_bCopyFromTemplate)
+    return false;
+
+  const ezUInt32 uiNumComponents = ref_compTypeState.m_ComponentIndexToHandle.GetCount();
+  EZ_ASSERT_DEBUG(uiNumComponents == ref_compTypeState.m_TemplateComponents.GetCount(), "Component count doesn't match");
+
+  // index zero is the invalid handle
+  for (ezUInt32 i = 1; i < uiNumComponents; ++i)
+  {
+    ezComponent* pComponent = nullptr;
+    ezComponent* pTemplate = nullptr;
+
+    // a template may have been deleted while the first instance was initialized
+    if (!m_pWorld->TryGetComponent(ref_compTypeState.m_ComponentIndexToHandle[i], pComponent) ||
+        !m_pWorld->TryGetComponent(ref_compTypeState.m_TemplateComponents[i], pTemplate) ||
+        !pComponent->CopyDeserializedState(*pTemplate))
+    {
+      // deserializing all components of this type overwrites the ones that have already been copied
+      ref_compTypeState.m_bCopyFromTemplate = false;
+      return false;
+    }
+  }
+
+  return true;
+}
+
 bool ezWorldReader::InstantiationContext::AddComponentsToBatch(ezTime endTime)
 {
   EZ_PROFILE_SCOPE("ezWorldReader::AddComponentsToBatch");
@@ -784,6 +845,27 @@ bool ezWorldReader::InstantiationContext::AddComponentsToBatch(ezTime endTime)
   return true;
 }
 
+void ezWorldReader::InstantiationContext::BeginNextInstance(const ezTransform& rootTransform)
+{
+  EZ_ASSERT_DEV(m_Phase == Phase::Invalid, "The previous instance has not been finished yet.");
+
+  m_Phase = Phase::CreateRootObjects;
+  m_RootTransform = rootTransform;
+
+  m_IndexToGameObjectHandle.SetCount(1);
+
+  for (auto& compTypeState : m_ComponentTypeStates)
+  {
+    if (compTypeState.m_TemplateComponents.IsEmpty())
+    {
+      compTypeState.m_TemplateComponents = compTypeState.m_ComponentIndexToHandle;
+      compTypeState.m_bCopyFromTemplate = true;
+    }
+
+    compTypeState.m_ComponentIndexToHandle.SetCount(1);
+  }
+}
+
 void ezWorldReader::InstantiationContext::SetMaxStepTime(ezTime stepTime)
 {
   m_Options.m_MaxStepTime = stepTime;
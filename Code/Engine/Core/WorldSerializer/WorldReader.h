@@ -117,6 +117,15 @@ public:
   /// has to be valid as long as the instantiation is in progress.
   ezUniquePtr<InstantiationContextBase> InstantiatePrefab(ezWorld& ref_world, const ezTransform& rootTransform, const ezPrefabInstantiationOptions& options);
 
+  /// \brief Creates one instance of the world that was previously read by ReadWorldDescription() for each of the given root transforms.
+  ///
+  /// This is much more efficient than calling InstantiatePrefab() for every transform. The instantiation state is only set up once,
+  /// and components that implement ezComponent::CopyDeserializedState() copy their state from the first instance instead of being deserialized again.
+  ///
+  /// The created objects of all instances are appended to the arrays in \a options, in the order of the root transforms.
+  /// The instantiation always happens immediately, options.m_MaxStepTime and options.m_pProgress are ignored.
+  void InstantiatePrefabs(ezWorld& ref_world, ezArrayPtr<const ezTransform> rootTransforms, const ezPrefabInstantiationOptions& options);
+
   /// \brief Gives access to the stream of data. Use this inside component deserialization functions to read data.
   ezStreamReader& GetStream() const;
 
@@ -212,6 +221,11 @@ private:
     void SetMaxStepTime(ezTime stepTime);
     ezTime GetMaxStepTime() const;
 
+    /// \brief Restarts a finished instantiation for another instance at the given transform.
+    ///
+    /// The components of the first instance are used as templates for all following instances.
+    void BeginNextInstance(const ezTransform& rootTransform);
+
   private:
     void BeginNextProgressStep(ezStringView sName);
     void SetSubProgressCompletion(double fCompletion);
@@ -230,8 +244,12 @@ private:
     {
       ezUInt64 m_uiDataReadOffset = 0;
       ezDynamicArray<ezComponentHandle> m_ComponentIndexToHandle;
+      ezDynamicArray<ezComponentHandle> m_TemplateComponents;
+      bool m_bCopyFromTemplate = false;
     };
 
+    bool CopyComponentsFromTemplate(ComponentTypeState& ref_compTypeState);
+
     ezDynamicArray<ezGameObjectHandle> m_IndexToGameObjectHandle;
     ezDynamicArray<ComponentTypeState> m_ComponentTypeStates;
 
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Math/Math.h>
+#include <Foundation/Memory/AllocatorWrapper.h>
+#include <Foundation/Threading/Mutex.h>
+
+#include <atomic>
+
+/// \brief A hashtable that may be accessed by multiple threads at the same time.
+///
+/// Lookups (TryGetValue(), Contains()) are lock-free. Modifications lock one of several mutexes, selected by the hash of the key,
+/// so writers only contend with writers that touch the same part of the table. Growing the table locks all of them.
+///
+/// Entries are never modified in place: replacing a value or removing an entry unlinks the old entry, and growing the table copies all entries
+/// into a new bucket array. Unlinked memory is freed through epoch-based reclamation, once no reader can access it anymore.
+/// Therefore values are always returned by copy and should be cheap to copy, e.g. pointers, handles or shared pointers.
+///
+/// The hash function can be customized by providing a Hasher helper class like ezHashHelper, just as for ezHashTable.
+///
+/// \see ezHashTable
+template <typename KeyType, typename ValueType, typename Hasher>
+class ezConcurrentHashTableBase
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezConcurrentHashTableBase);
+
+protected:
+  /// \brief Creates an empty hashtable. Does not allocate any data yet.
+  explicit ezConcurrentHashTableBase(ezAllocator* pAllocator); // [tested]
+
+  /// \brief Destructor. No other thread may access the table anymore at this point.
+  ~ezConcurrentHashTableBase(); // [tested]
+
+public:
+  /// \brief Returns the number of active entries in the table. The result is only a snapshot, if other threads modify the table.
+  ezUInt32 GetCount() const; // [tested]
+
+  /// \brief Returns true, if the hashtable does not contain any elements.
+  bool IsEmpty() const; // [tested]
+
+  /// \brief Removes all entries.
+  void Clear(); // [tested]
+
+  /// \brief Inserts the key value pair or replaces value if an entry with the given key already exists.
+  ///
+  /// Returns true if an existing value was replaced and optionally writes out the old value to out_pOldValue.
+  bool Insert(const KeyType& key, const ValueType& value, ValueType* out_pOldValue = nullptr); // [tested]
+
+  /// \brief Returns the value stored for the given key. If none exists, the given value is inserted and returned.
+  ///
+  /// When multiple threads try to add the same key at the same time, exactly one of them inserts its value and all of them return that value.
+  /// \a out_pExisted indicates whether the key already existed.
+  ValueType FindOrAdd(const KeyType& key, const ValueType& value, bool* out_pExisted = nullptr); // [tested]
+
+  /// \brief Removes the entry with the given key. Returns whether an entry was removed and optionally writes out the old value to out_pOldValue.
+  template <typename CompatibleKeyType>
+  bool Remove(const CompatibleKeyType& key, ValueType* out_pOldValue = nullptr); // [tested]
+
+  /// \brief Returns whether an entry with the given key was found and if found writes out the corresponding value to out_value. Lock-free.
+  template <typename CompatibleKeyType>
+  bool TryGetValue(const CompatibleKeyType& key, ValueType& out_value) const; // [tested]
+
+  /// \brief Returns if an entry with given key exists in the table. Lock-free.
+  template <typename CompatibleKeyType>
+  bool Contains(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns the allocator that is used by this instance.
+  ezAllocator* GetAllocator() const;
+
+private:
+  // ezAtomicInteger reads are implemented as read-modify-write operations, which would make all readers write to the same cache lines.
+  // Lock-free lookups need plain acquire loads, therefore std::atomic is used here.
+
+  struct Node
+  {
+    Node(ezUInt32 uiHash, const KeyType& key, const ValueType& value, Node* pNext)
+      : m_uiHash(uiHash)
+      , m_Key(key)
+      , m_Value(value)
+      , m_pNext(pNext)
+    {
+    }
+
+    ezUInt32 m_uiHash;
+    KeyType m_Key;
+    ValueType m_Value;
+    std::atomic<Node*> m_pNext;
+    Node* m_pNextRetired = nullptr;
+  };
+
+  struct Table
+  {
+    ezUInt32 m_uiBucketMask = 0;
+    std::atomic<Node*>* m_pBuckets = nullptr;
+    Table* m_pNextRetired = nullptr;
+  };
+
+  enum
+  {
+    NUM_WRITE_LOCKS = 16,   // number of mutexes that protect the buckets, the bucket count is never smaller than this
+    NUM_READER_SLOTS = 32,  // number of cache lines across which the reader counts are distributed
+    NUM_EPOCHS = 3,
+    INITIAL_BUCKETS = 64,
+    MAX_LOAD_PERCENT = 75,
+    RECLAIM_INTERVAL = 16, // number of retired nodes after which the epoch is advanced
+  };
+
+  /// Readers register in the current epoch for the duration of a lookup. To spread the contention, each thread uses its own slot.
+  struct alignas(64) ReaderSlot
+  {
+    std::atomic<ezInt32> m_iReaders[NUM_EPOCHS];
+  };
+
+  class ReadScope
+  {
+  public:
+    explicit ReadScope(const ezConcurrentHashTableBase* pTable);
+    ~ReadScope();
+
+  private:
+    std::atomic<ezInt32>* m_pCounter;
+  };
+
+  template <typename CompatibleKeyType>
+  const Node* FindNode(const Table* pTable, ezUInt32 uiHash, const CompatibleKeyType& key) const;
+
+  ezMutex& GetWriteLock(ezUInt32 uiHash) const { return m_WriteLocks[uiHash & (NUM_WRITE_LOCKS - 1)]; }
+  Table* GetOrCreateTable();
+  Table* CreateTable(ezUInt32 uiNumBuckets);
+  void DestroyTable(Table* pTable);
+  void GrowIfNeeded();
+
+  void RetireNodes(Node* pFirst, Node* pLast);
+  void RetireTable(Table* pTable);
+  void TryReclaim();
+  void FreeRetired(ezUInt32 uiEpochIndex);
+
+  static ezUInt32 GetReaderSlotIndex();
+
+  std::atomic<Table*> m_pTable;
+  std::atomic<ezUInt32> m_uiCount;
+  ezAllocator* m_pAllocator = nullptr;
+
+  mutable ezMutex m_WriteLocks[NUM_WRITE_LOCKS];
+
+  // the retired lists are protected by m_ReclaimMutex, the epoch is only advanced while holding it
+  ezMutex m_ReclaimMutex;
+  std::atomic<ezUInt32> m_uiEpoch;
+  Node* m_pRetiredNodes[NUM_EPOCHS] = {};
+  Table* m_pRetiredTables[NUM_EPOCHS] = {};
+  ezUInt32 m_uiNumRetiredSinceReclaim = 0;
+  mutable ReaderSlot m_ReaderSlots[NUM_READER_SLOTS];
+};
+
+/// \brief \see ezConcurrentHashTableBase
+template <typename KeyType, typename ValueType, typename Hasher = ezHashHelper<KeyType>, typename AllocatorWrapper = ezDefaultAllocatorWrapper>
+class ezConcurrentHashTable : public ezConcurrentHashTableBase<KeyType, ValueType, Hasher>
+{
+public:
+  ezConcurrentHashTable();
+  explicit ezConcurrentHashTable(ezAllocator* pAllocator);
+};
+
+#include <Foundation/Containers/Implementation/ConcurrentHashTable_inl.h>
@@ -0,0 +1,487 @@
+#pragma once
+
+#include <Foundation/Threading/Lock.h>
+
+template <typename K, typename V, typename H>
+ezConcurrentHashTableBase<K, V, H>::ReadScope::ReadScope(const ezConcurrentHashTableBase* pTable)
+{
+  ReaderSlot& slot = pTable->m_ReaderSlots[GetReaderSlotIndex()];
+
+  while (true)
+  {
+    const ezUInt32 uiEpoch = pTable->m_uiEpoch.load();
+    m_pCounter = &slot.m_iReaders[uiEpoch % NUM_EPOCHS];
+    m_pCounter->fetch_add(1);
+
+    // if the epoch was advanced in between, a writer may not have seen our registration, so register in the new epoch instead
+    if (pTable->m_uiEpoch.load() == uiEpoch)
+      return;
+
+    m_pCounter->fetch_sub(1);
+  }
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezConcurrentHashTableBase<K, V, H>::ReadScope::~ReadScope()
+{
+  m_pCounter->fetch_sub(1, std::memory_order_release);
+}
+
+template <typename K, typename V, typename H>
+ezConcurrentHashTableBase<K, V, H>::ezConcurrentHashTableBase(ezAllocator* pAllocator)
+  : m_pTable(nullptr)
+  , m_uiCount(0)
+  , m_pAllocator(pAllocator)
+  , m_uiEpoch(0)
+{
+  for (auto& slot : m_ReaderSlots)
+  {
+    for (auto& iReaders : slot.m_iReaders)
+    {
+      iReaders.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+template <typename K, typename V, typename H>
+ezConcurrentHashTableBase<K, V, H>::~ezConcurrentHashTableBase()
+{
+  if (Table* pTable = m_pTable.load())
+  {
+    DestroyTable(pTable);
+  }
+
+  for (ezUInt32 i = 0; i < NUM_EPOCHS; ++i)
+  {
+    FreeRetired(i);
+  }
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezUInt32 ezConcurrentHashTableBase<K, V, H>::GetCount() const
+{
+  return m_uiCount.load(std::memory_order_relaxed);
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE bool ezConcurrentHashTableBase<K, V, H>::IsEmpty() const
+{
+  return GetCount() == 0;
+}
+
+template <typename K, typename V, typename H>
+void ezConcurrentHashTableBase<K, V, H>::Clear()
+{
+  Node* pFirst = nullptr;
+  Node* pLast = nullptr;
+
+  for (auto& writeLock : m_WriteLocks)
+  {
+    writeLock.Lock();
+  }
+
+  if (Table* pTable = m_pTable.load(std::memory_order_relaxed))
+  {
+    for (ezUInt32 i = 0; i <= pTable->m_uiBucketMask; ++i)
+    {
+      // readers that are currently in this chain can still walk it, since the nodes are only retired
+      for (Node* pNode = pTable->m_pBuckets[i].exchange(nullptr, std::memory_order_acq_rel); pNode != nullptr; pNode = pNode->m_pNext.load(std::memory_order_relaxed))
+      {
+        pNode->m_pNextRetired = pFirst;
+        pFirst = pNode;
+
+        if (pLast == nullptr)
+          pLast = pNode;
+      }
+    }
+  }
+
+  m_uiCount.store(0, std::memory_order_relaxed);
+
+  for (ezUInt32 i = NUM_WRITE_LOCKS; i > 0; --i)
+  {
+    m_WriteLocks[i - 1].Unlock();
+  }
+
+  if (pFirst != nullptr)
+  {
+    RetireNodes(pFirst, pLast);
+  }
+}
+
+template <typename K, typename V, typename H>
+bool ezConcurrentHashTableBase<K, V, H>::Insert(const K& key, const V& value, V* out_pOldValue)
+{
+  const ezUInt32 uiHash = H::Hash(key);
+  Node* pReplacedNode = nullptr;
+
+  {
+    EZ_LOCK(GetWriteLock(uiHash));
+
+    Table* pTable = GetOrCreateTable();
+    std::atomic<Node*>* pLink = &pTable->m_pBuckets[uiHash & pTable->m_uiBucketMask];
+
+    for (Node* pNode = pLink->load(std::memory_order_relaxed); pNode != nullptr; pNode = pLink->load(std::memory_order_relaxed))
+    {
+      if (pNode->m_uiHash == uiHash && H::Equal(pNode->m_Key, key))
+      {
+        if (out_pOldValue != nullptr)
+          *out_pOldValue = pNode->m_Value;
+
+        // readers may access the old node at any time, so it is replaced instead of modified
+        Node* pNewNode = EZ_NEW(m_pAllocator, Node, uiHash, key, value, pNode->m_pNext.load(std::memory_order_relaxed));
+        pLink->store(pNewNode, std::memory_order_release);
+
+        pReplacedNode = pNode;
+        break;
+      }
+
+      pLink = &pNode->m_pNext;
+    }
+
+    if (pReplacedNode == nullptr)
+    {
+      std::atomic<Node*>& bucket = pTable->m_pBuckets[uiHash & pTable->m_uiBucketMask];
+      Node* pNewNode = EZ_NEW(m_pAllocator, Node, uiHash, key, value, bucket.load(std::memory_order_relaxed));
+      bucket.store(pNewNode, std::memory_order_release);
+
+      m_uiCount.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  if (pReplacedNode != nullptr)
+  {
+    RetireNodes(pReplacedNode, pReplacedNode);
+    return true;
+  }
+
+  GrowIfNeeded();
+  return false;
+}
+
+template <typename K, typename V, typename H>
+V ezConcurrentHashTableBase<K, V, H>::FindOrAdd(const K& key, const V& value, bool* out_pExisted)
+{
+  const ezUInt32 uiHash = H::Hash(key);
+
+  if (out_pExisted != nullptr)
+    *out_pExisted = true;
+
+  // the common case for caches is that the entry exists already, so try without a lock first
+  {
+    ReadScope scope(this);
+
+    if (const Table* pTable = m_pTable.load(std::memory_order_acquire))
+    {
+      if (const Node* pNode = FindNode(pTable, uiHash, key))
+        return pNode->m_Value;
+    }
+  }
+
+  {
+    EZ_LOCK(GetWriteLock(uiHash));
+
+    Table* pTable = GetOrCreateTable();
+
+    // another thread may have added the key in the meantime
+    if (const Node* pNode = FindNode(pTable, uiHash, key))
+      return pNode->m_Value;
+
+    std::atomic<Node*>& bucket = pTable->m_pBuckets[uiHash & pTable->m_uiBucketMask];
+    Node* pNewNode = EZ_NEW(m_pAllocator, Node, uiHash, key, value, bucket.load(std::memory_order_relaxed));
+    bucket.store(pNewNode, std::memory_order_release);
+
+    m_uiCount.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  if (out_pExisted != nullptr)
+    *out_pExisted = false;
+
+  GrowIfNeeded();
+  return value;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+bool ezConcurrentHashTableBase<K, V, H>::Remove(const CompatibleKeyType& key, V* out_pOldValue)
+{
+  const ezUInt32 uiHash = H::Hash(key);
+  Node* pRemovedNode = nullptr;
+
+  {
+    EZ_LOCK(GetWriteLock(uiHash));
+
+    Table* pTable = m_pTable.load(std::memory_order_relaxed);
+    if (pTable == nullptr)
+      return false;
+
+    std::atomic<Node*>* pLink = &pTable->m_pBuckets[uiHash & pTable->m_uiBucketMask];
+
+    for (Node* pNode = pLink->load(std::memory_order_relaxed); pNode != nullptr; pNode = pLink->load(std::memory_order_relaxed))
+    {
+      if (pNode->m_uiHash == uiHash && H::Equal(pNode->m_Key, key))
+      {
+        if (out_pOldValue != nullptr)
+          *out_pOldValue = pNode->m_Value;
+
+        pLink->store(pNode->m_pNext.load(std::memory_order_relaxed), std::memory_order_release);
+        m_uiCount.fetch_sub(1, std::memory_order_relaxed);
+
+        pRemovedNode = pNode;
+        break;
+      }
+
+      pLink = &pNode->m_pNext;
+    }
+  }
+
+  if (pRemovedNode == nullptr)
+    return false;
+
+  RetireNodes(pRemovedNode, pRemovedNode);
+  return true;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+bool ezConcurrentHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, V& out_value) const
+{
+  const ezUInt32 uiHash = H::Hash(key);
+
+  ReadScope scope(this);
+
+  const Table* pTable = m_pTable.load(std::memory_order_acquire);
+  if (pTable == nullptr)
+    return false;
+
+  if (const Node* pNode = FindNode(pTable, uiHash, key))
+  {
+    out_value = pNode->m_Value;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+bool ezConcurrentHashTableBase<K, V, H>::Contains(const CompatibleKeyType& key) const
+{
+  const ezUInt32 uiHash = H::Hash(key);
+
+  ReadScope scope(this);
+
+  const Table* pTable = m_pTable.load(std::memory_order_acquire);
+  return pTable != nullptr && FindNode(pTable, uiHash, key) != nullptr;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezAllocator* ezConcurrentHashTableBase<K, V, H>::GetAllocator() const
+{
+  return m_pAllocator;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE const typename ezConcurrentHashTableBase<K, V, H>::Node* ezConcurrentHashTableBase<K, V, H>::FindNode(const Table* pTable, ezUInt32 uiHash, const CompatibleKeyType& key) const
+{
+  for (const Node* pNode = pTable->m_pBuckets[uiHash & pTable->m_uiBucketMask].load(std::memory_order_acquire); pNode != nullptr; pNode = pNode->m_pNext.load(std::memory_order_acquire))
+  {
+    if (pNode->m_uiHash == uiHash && H::Equal(pNode->m_Key, key))
+      return pNode;
+  }
+
+  return nullptr;
+}
+
+template <typename K, typename V, typename H>
+typename ezConcurrentHashTableBase<K, V, H>::Table* ezConcurrentHashTableBase<K, V, H>::GetOrCreateTable()
+{
+  Table* pTable = m_pTable.load(std::memory_order_acquire);
+  if (pTable != nullptr)
+    return pTable;
+
+  // writers that hold different write locks may get here at the same time
+  Table* pNewTable = CreateTable(INITIAL_BUCKETS);
+  if (m_pTable.compare_exchange_strong(pTable, pNewTable, std::memory_order_acq_rel))
+    return pNewTable;
+
+  DestroyTable(pNewTable);
+  return pTable;
+}
+
+template <typename K, typename V, typename H>
+typename ezConcurrentHashTableBase<K, V, H>::Table* ezConcurrentHashTableBase<K, V, H>::CreateTable(ezUInt32 uiNumBuckets)
+{
+  EZ_ASSERT_DEBUG(ezMath::IsPowerOf2(uiNumBuckets) && uiNumBuckets >= NUM_WRITE_LOCKS, "Invalid bucket count {0}", uiNumBuckets);
+
+  Table* pTable = EZ_NEW(m_pAllocator, Table);
+  pTable->m_uiBucketMask = uiNumBuckets - 1;
+  pTable->m_pBuckets = EZ_NEW_RAW_BUFFER(m_pAllocator, std::atomic<Node*>, uiNumBuckets);
+
+  for (ezUInt32 i = 0; i < uiNumBuckets; ++i)
+  {
+    new (&pTable->m_pBuckets[i]) std::atomic<Node*>(nullptr);
+  }
+
+  return pTable;
+}
+
+template <typename K, typename V, typename H>
+void ezConcurrentHashTableBase<K, V, H>::DestroyTable(Table* pTable)
+{
+  for (ezUInt32 i = 0; i <= pTable->m_uiBucketMask; ++i)
+  {
+    Node* pNode = pTable->m_pBuckets[i].load(std::memory_order_relaxed);
+    while (pNode != nullptr)
+    {
+      Node* pNext = pNode->m_pNext.load(std::memory_order_relaxed);
+      EZ_DELETE(m_pAllocator, pNode);
+      pNode = pNext;
+    }
+  }
+
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, pTable->m_pBuckets);
+  EZ_DELETE(m_pAllocator, pTable);
+}
+
+template <typename K, typename V, typename H>
+void ezConcurrentHashTableBase<K, V, H>::GrowIfNeeded()
+{
+  auto NeedsToGrow = [this](const Table* pTable)
+  { return static_cast<ezUInt64>(GetCount()) * 100 > static_cast<ezUInt64>(pTable->m_uiBucketMask + 1) * MAX_LOAD_PERCENT; };
+
+  Table* pTable = m_pTable.load(std::memory_order_acquire);
+  if (pTable == nullptr || !NeedsToGrow(pTable))
+    return;
+
+  for (auto& writeLock : m_WriteLocks)
+  {
+    writeLock.Lock();
+  }
+
+  // another thread may have grown the table already
+  pTable = m_pTable.load(std::memory_order_relaxed);
+  const bool bGrow = NeedsToGrow(pTable);
+
+  if (bGrow)
+  {
+    // the nodes can't be moved, since readers may be walking the old chains, so the new table gets copies of them
+    Table* pNewTable = CreateTable((pTable->m_uiBucketMask + 1) * 2);
+
+    for (ezUInt32 i = 0; i <= pTable->m_uiBucketMask; ++i)
+    {
+      for (const Node* pNode = pTable->m_pBuckets[i].load(std::memory_order_relaxed); pNode != nullptr; pNode = pNode->m_pNext.load(std::memory_order_relaxed))
+      {
+        std::atomic<Node*>& bucket = pNewTable->m_pBuckets[pNode->m_uiHash & pNewTable->m_uiBucketMask];
+        bucket.store(EZ_NEW(m_pAllocator, Node, pNode->m_uiHash, pNode->m_Key, pNode->m_Value, bucket.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+      }
+    }
+
+    m_pTable.store(pNewTable, std::memory_order_release);
+  }
+
+  for (ezUInt32 i = NUM_WRITE_LOCKS; i > 0; --i)
+  {
+    m_WriteLocks[i - 1].Unlock();
+  }
+
+  if (bGrow)
+  {
+    RetireTable(pTable);
+  }
+}
+
+template <typename K, typename V, typename H>
+void ezConcurrentHashTableBase<K, V, H>::RetireNodes(Node* pFirst, Node* pLast)
+{
+  EZ_LOCK(m_ReclaimMutex);
+
+  const ezUInt32 uiEpochIndex = m_uiEpoch.load(std::memory_order_relaxed) % NUM_EPOCHS;
+  pLast->m_pNextRetired = m_pRetiredNodes[uiEpochIndex];
+  m_pRetiredNodes[uiEpochIndex] = pFirst;
+
+  // checking all reader slots is not free, so only do it once in a while
+  if (++m_uiNumRetiredSinceReclaim >= RECLAIM_INTERVAL)
+  {
+    TryReclaim();
+  }
+}
+
+template <typename K, typename V, typename H>
+void ezConcurrentHashTableBase<K, V, H>::RetireTable(Table* pTable)
+{
+  EZ_LOCK(m_ReclaimMutex);
+
+  const ezUInt32 uiEpochIndex = m_uiEpoch.load(std::memory_order_relaxed) % NUM_EPOCHS;
+  pTable->m_pNextRetired = m_pRetiredTables[uiEpochIndex];
+  m_pRetiredTables[uiEpochIndex] = pTable;
+
+  TryReclaim();
+}
+
+template <typename K, typename V, typename H>
+void ezConcurrentHashTableBase<K, V, H>::TryReclaim()
+{
+  // Memory that was retired in epoch E can only be accessed by readers that entered in epoch E or earlier.
+  // The epoch is only advanced from E to E+1 when no reader of epoch E-1 is active anymore,
+  // so once it has reached E+2, the memory retired in E is not accessible anymore.
+  const ezUInt32 uiEpoch = m_uiEpoch.load(std::memory_order_relaxed);
+  const ezUInt32 uiPreviousEpochIndex = (uiEpoch + NUM_EPOCHS - 1) % NUM_EPOCHS;
+
+  for (const auto& slot : m_ReaderSlots)
+  {
+    if (slot.m_iReaders[uiPreviousEpochIndex].load() != 0)
+      return;
+  }
+
+  m_uiEpoch.store(uiEpoch + 1);
+  m_uiNumRetiredSinceReclaim = 0;
+
+  FreeRetired(uiPreviousEpochIndex);
+}
+
+template <typename K, typename V, typename H>
+void ezConcurrentHashTableBase<K, V, H>::FreeRetired(ezUInt32 uiEpochIndex)
+{
+  Node* pNode = m_pRetiredNodes[uiEpochIndex];
+  m_pRetiredNodes[uiEpochIndex] = nullptr;
+
+  while (pNode != nullptr)
+  {
+    Node* pNext = pNode->m_pNextRetired;
+    EZ_DELETE(m_pAllocator, pNode);
+    pNode = pNext;
+  }
+
+  Table* pTable = m_pRetiredTables[uiEpochIndex];
+  m_pRetiredTables[uiEpochIndex] = nullptr;
+
+  while (pTable != nullptr)
+  {
+    Table* pNext = pTable->m_pNextRetired;
+    DestroyTable(pTable);
+    pTable = pNext;
+  }
+}
+
+template <typename K, typename V, typename H>
+ezUInt32 ezConcurrentHashTableBase<K, V, H>::GetReaderSlotIndex()
+{
+  static std::atomic<ezUInt32> s_uiNextSlot(0);
+  static thread_local const ezUInt32 s_uiSlot = s_uiNextSlot.fetch_add(1, std::memory_order_relaxed) % NUM_READER_SLOTS;
+
+  return s_uiSlot;
+}
+
+template <typename K, typename V, typename H, typename A>
+ezConcurrentHashTable<K, V, H, A>::ezConcurrentHashTable()
+  : ezConcurrentHashTableBase<K, V, H>(A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezConcurrentHashTable<K, V, H, A>::ezConcurrentHashTable(ezAllocator* pAllocator)
+  : ezConcurrentHashTableBase<K, V, H>(pAllocator)
+{
+}
@@ -6,6 +6,7 @@
 #include <Foundation/DataProcessing/Stream/ProcessingStreamProcessor.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Memory/MemoryUtils.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 ezProcessingStreamGroup::ezProcessingStreamGroup()
 {
@@ -142,6 +143,8 @@ void ezProcessingStreamGroup::SetSize(ezUInt64 uiNumElements)
 /// processors).
 void ezProcessingStreamGroup::RemoveElement(ezUInt64 uiElementIndex)
 {
+  EZ_LOCK(m_PendingMutex);
+
   if (m_PendingRemoveIndices.Contains(uiElementIndex))
     return;
 
@@ -154,6 +157,8 @@ void ezProcessingStreamGroup::RemoveElement(ezUInt64 uiElementIndex)
 /// spawning will be queued.
 void ezProcessingStreamGroup::InitializeElements(ezUInt64 uiNumElements)
 {
+  EZ_LOCK(m_PendingMutex);
+
   m_uiPendingNumberOfElementsToSpawn += uiNumElements;
 }
 
@@ -164,7 +169,14 @@ void ezProcessingStreamGroup::Process()
   // TODO: Identify which processors work on which streams and find independent groups and use separate tasks for them?
   for (ezProcessingStreamProcessor* pStreamProcessor : m_Processors)
   {
-    pStreamProcessor->Process(m_uiNumActiveElements);
+    if (m_uiParallelProcessingBinSize > 0 && m_uiNumActiveElements > m_uiParallelProcessingBinSize && pStreamProcessor->SupportsParallelProcessing())
+    {
+      ProcessInParallel(pStreamProcessor);
+    }
+    else
+    {
+      pStreamProcessor->Process(m_uiNumActiveElements);
+    }
   }
 
   // Run any pending deletions which happened due to stream processor execution
@@ -175,12 +187,28 @@ void ezProcessingStreamGroup::Process()
   RunPendingSpawns();
 }
 
+void ezProcessingStreamGroup::ProcessInParallel(ezProcessingStreamProcessor* pProcessor)
+{
+  if (!pProcessor->PrepareParallelProcessing(m_uiNumActiveElements))
+    return;
+
+  ezParallelForParams params;
+  params.m_uiBinSize = m_uiParallelProcessingBinSize;
+
+  ezTaskSystem::ParallelForIndexed(
+    static_cast<ezUInt64>(0), m_uiNumActiveElements, [pProcessor](ezUInt64 uiStartIndex, ezUInt64 uiEndIndex)
+    { pProcessor->ProcessRange(uiStartIndex, uiEndIndex - uiStartIndex); },
+    "ProcessingStreamGroup::ProcessRange", ezTaskNesting::Never, params);
+}
 
 void ezProcessingStreamGroup::RunPendingDeletions()
 {
   ezStreamGroupElementRemovedEvent e;
   e.m_pStreamGroup = this;
 
+  // elements may have been removed from multiple threads, sort them to always remove them in the same order
+  m_PendingRemoveIndices.Sort();
+
   // Remove elements
   while (!m_PendingRemoveIndices.IsEmpty())
   {
@@ -0,0 +1,145 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/DataProcessing/Stream/ProcessingStreamKernels.h>
+
+namespace
+{
+  EZ_ALWAYS_INLINE float* GetElements(const ezProcessingStream* pStream, ezUInt64 uiStartIndex, ezUInt32 uiNumComponents)
+  {
+    EZ_ASSERT_DEBUG(pStream->GetElementStride() == uiNumComponents * sizeof(float), "Stream '{0}' is not a tightly packed float stream with {1} components", pStream->GetName(), uiNumComponents);
+    EZ_ASSERT_DEBUG((uiStartIndex + 1) * pStream->GetElementStride() <= pStream->GetDataSize() || pStream->GetDataSize() == 0, "Out of bounds access");
+
+    return pStream->GetWritableData<float>() + uiStartIndex * uiNumComponents;
+  }
+} // namespace
+
+// static
+void ezProcessingStreamKernels::AddFloat3(ezProcessingStream* pStream, ezUInt64 uiStartIndex, ezUInt64 uiNumElements, const ezVec3& vValue)
+{
+  if (uiNumElements == 0)
+    return;
+
+  float* pData = GetElements(pStream, uiStartIndex, 3);
+
+  // four consecutive elements form three SIMD vectors, which need the value rotated accordingly
+  const ezSimdVec4f v0(vValue.x, vValue.y, vValue.z, vValue.x);
+  const ezSimdVec4f v1(vValue.y, vValue.z, vValue.x, vValue.y);
+  const ezSimdVec4f v2(vValue.z, vValue.x, vValue.y, vValue.z);
+
+  const ezUInt64 uiNumBlocks = uiNumElements / 4;
+  for (ezUInt64 i = 0; i < uiNumBlocks; ++i, pData += 12)
+  {
+    ezSimdVec4f a, b, c;
+    a.Load<4>(pData + 0);
+    b.Load<4>(pData + 4);
+    c.Load<4>(pData + 8);
+
+    (a + v0).Store<4>(pData + 0);
+    (b + v1).Store<4>(pData + 4);
+    (c + v2).Store<4>(pData + 8);
+  }
+
+  for (ezUInt64 i = uiNumBlocks * 4; i < uiNumElements; ++i, pData += 3)
+  {
+    ezSimdVec4f a;
+    a.Load<3>(pData);
+    (a + v0).Store<3>(pData);
+  }
+}
+
+// static
+void ezProcessingStreamKernels::MulFloat3(ezProcessingStream* pStream, ezUInt64 uiStartIndex, ezUInt64 uiNumElements, float fFactor)
+{
+  if (uiNumElements == 0)
+    return;
+
+  float* pData = GetElements(pStream, uiStartIndex, 3);
+
+  const ezSimdFloat factor = fFactor;
+
+  const ezUInt64 uiNumBlocks = uiNumElements / 4;
+  for (ezUInt64 i = 0; i < uiNumBlocks; ++i, pData += 12)
+  {
+    ezSimdVec4f a, b, c;
+    a.Load<4>(pData + 0);
+    b.Load<4>(pData + 4);
+    c.Load<4>(pData + 8);
+
+    (a * factor).Store<4>(pData + 0);
+    (b * factor).Store<4>(pData + 4);
+    (c * factor).Store<4>(pData + 8);
+  }
+
+  for (ezUInt64 i = uiNumBlocks * 4; i < uiNumElements; ++i, pData += 3)
+  {
+    ezSimdVec4f a;
+    a.Load<3>(pData);
+    (a * factor).Store<3>(pData);
+  }
+}
+
+// static
+void ezProcessingStreamKernels::AddFloat4(ezProcessingStream* pStream, ezUInt64 uiStartIndex, ezUInt64 uiNumElements, const ezSimdVec4f& vValue)
+{
+  if (uiNumElements == 0)
+    return;
+
+  float* pData = GetElements(pStream, uiStartIndex, 4);
+
+  for (ezUInt64 i = 0; i < uiNumElements; ++i, pData += 4)
+  {
+    ezSimdVec4f a;
+    a.Load<4>(pData);
+    (a + vValue).Store<4>(pData);
+  }
+}
+
+// static
+void ezProcessingStreamKernels::MulAddFloat3ToFloat4(ezProcessingStream* pTarget, const ezProcessingStream* pSource, ezUInt64 uiStartIndex, ezUInt64 uiNumElements, float fScale)
+{
+  if (uiNumElements == 0)
+    return;
+
+  float* pTargetData = GetElements(pTarget, uiStartIndex, 4);
+  const float* pSourceData = GetElements(pSource, uiStartIndex, 3);
+
+  // the w component of the scale is zero, so whatever ends up in the w component of the source vectors is never added to the target
+  const ezSimdVec4f scale(fScale, fScale, fScale, 0.0f);
+
+  const ezUInt64 uiNumBlocks = uiNumElements / 4;
+  for (ezUInt64 i = 0; i < uiNumBlocks; ++i, pSourceData += 12, pTargetData += 16)
+  {
+    ezSimdVec4f a, b, c;
+    a.Load<4>(pSourceData + 0);
+    b.Load<4>(pSourceData + 4);
+    c.Load<4>(pSourceData + 8);
+
+    // a = (x0 y0 z0 x1), b = (y1 z1 x2 y2), c = (z2 x3 y3 z3)
+    const ezSimdVec4f s0 = a;
+    const ezSimdVec4f s1 = a.GetCombined<ezSwizzle::WWXX>(b).GetCombined<ezSwizzle::XZYY>(b);
+    const ezSimdVec4f s2 = b.GetCombined<ezSwizzle::ZWXX>(c);
+    const ezSimdVec4f s3 = c.Get<ezSwizzle::YZWW>();
+
+    ezSimdVec4f t0, t1, t2, t3;
+    t0.Load<4>(pTargetData + 0);
+    t1.Load<4>(pTargetData + 4);
+    t2.Load<4>(pTargetData + 8);
+    t3.Load<4>(pTargetData + 12);
+
+    ezSimdVec4f::MulAdd(s0, scale, t0).Store<4>(pTargetData + 0);
+    ezSimdVec4f::MulAdd(s1, scale, t1).Store<4>(pTargetData + 4);
+    ezSimdVec4f::MulAdd(s2, scale, t2).Store<4>(pTargetData + 8);
+    ezSimdVec4f::MulAdd(s3, scale, t3).Store<4>(pTargetData + 12);
+  }
+
+  for (ezUInt64 i = uiNumBlocks * 4; i < uiNumElements; ++i, pSourceData += 3, pTargetData += 4)
+  {
+    ezSimdVec4f s, t;
+    s.Load<3>(pSourceData);
+    t.Load<4>(pTargetData);
+    ezSimdVec4f::MulAdd(s, scale, t).Store<4>(pTargetData);
+  }
+}
+
+
+EZ_STATICLINK_FILE(Foundation, Foundation_DataProcessing_Stream_Implementation_ProcessingStreamKernels);
@@ -18,6 +18,16 @@ ezProcessingStreamProcessor::~ezProcessingStreamProcessor()
   m_pStreamGroup = nullptr;
 }
 
+void ezProcessingStreamProcessor::Process(ezUInt64 uiNumElements)
+{
+  EZ_ASSERT_DEBUG(SupportsParallelProcessing(), "Stream processors must either override Process() or support parallel processing.");
+
+  if (PrepareParallelProcessing(uiNumElements))
+  {
+    ProcessRange(0, uiNumElements);
+  }
+}
+
 
 
 EZ_STATICLINK_FILE(Foundation, Foundation_DataProcessing_Stream_Implementation_ProcessingStreamProcessor);
@@ -5,6 +5,7 @@
 #include <Foundation/Communication/Event.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStream.h>
+#include <Foundation/Threading/Mutex.h>
 
 class ezProcessingStreamProcessor;
 class ezProcessingStreamGroup;
@@ -57,7 +58,7 @@ public:
   void SetSize(ezUInt64 uiNumElements);
 
   /// \brief Removes an element (e.g. due to the death of a particle etc.), this will be enqueued (and thus is safe to be called from within data
-  /// processors).
+  /// processors, also from processors that run in parallel).
   void RemoveElement(ezUInt64 uiElementIndex);
 
   /// \brief Spawns a number of new elements, they will be added as newly initialized stream elements. Safe to call from data processors since the
@@ -65,8 +66,17 @@ public:
   void InitializeElements(ezUInt64 uiNumElements);
 
   /// \brief Runs the stream processors which have been added to the stream group.
+  ///
+  /// Processors that support parallel processing (see ezProcessingStreamProcessor::SupportsParallelProcessing()) split the active elements
+  /// into ranges that are processed on multiple threads, if there are more than GetParallelProcessingBinSize() elements.
   void Process();
 
+  /// \brief Sets the minimum number of elements that a single task processes, when processors run in parallel. 0 disables parallel processing.
+  void SetParallelProcessingBinSize(ezUInt32 uiBinSize) { m_uiParallelProcessingBinSize = uiBinSize; }
+
+  /// \brief Returns the value set via SetParallelProcessingBinSize().
+  ezUInt32 GetParallelProcessingBinSize() const { return m_uiParallelProcessingBinSize; }
+
   /// \brief Returns the number of elements the streams store.
   inline ezUInt64 GetNumElements() const { return m_uiNumElements; }
 
@@ -89,12 +99,19 @@ private:
 
   void SortProcessorsByPriority();
 
+  void ProcessInParallel(ezProcessingStreamProcessor* pProcessor);
+
   ezHybridArray<ezProcessingStreamProcessor*, 8> m_Processors;
 
   ezHybridArray<ezProcessingStream*, 8> m_DataStreams;
 
   ezHybridArray<ezUInt64, 64> m_PendingRemoveIndices;
 
+  /// Protects the pending removals and spawns, while processors run in parallel
+  ezMutex m_PendingMutex;
+
+  ezUInt32 m_uiParallelProcessingBinSize = 8192;
+
   ezUInt64 m_uiPendingNumberOfElementsToSpawn;
 
   ezUInt64 m_uiNumElements;
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <Foundation/DataProcessing/Stream/ProcessingStream.h>
+#include <Foundation/Math/Vec3.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
+
+/// \brief SIMD implementations of common operations on ranges of stream elements.
+///
+/// The streams are tightly packed arrays of elements, so these functions process multiple elements per SIMD instruction where the element
+/// layout allows it, e.g. four Float3 elements are processed as three ezSimdVec4f.
+/// All functions work on the elements in the range [uiStartIndex; uiStartIndex + uiNumElements) and can therefore also be used from
+/// ezProcessingStreamProcessor::ProcessRange().
+class EZ_FOUNDATION_DLL ezProcessingStreamKernels
+{
+public:
+  /// \brief Adds vValue to every element of a Float3 stream.
+  static void AddFloat3(ezProcessingStream* pStream, ezUInt64 uiStartIndex, ezUInt64 uiNumElements, const ezVec3& vValue);
+
+  /// \brief Multiplies every element of a Float3 stream with fFactor.
+  static void MulFloat3(ezProcessingStream* pStream, ezUInt64 uiStartIndex, ezUInt64 uiNumElements, float fFactor);
+
+  /// \brief Adds vValue to every element of a Float4 stream.
+  static void AddFloat4(ezProcessingStream* pStream, ezUInt64 uiStartIndex, ezUInt64 uiNumElements, const ezSimdVec4f& vValue);
+
+  /// \brief Adds the elements of the Float3 stream pSource, multiplied by fScale, to the x, y and z components of the elements of the
+  /// Float4 stream pTarget. The w components of pTarget are left unchanged.
+  ///
+  /// This is e.g. used to apply velocities to positions.
+  static void MulAddFloat3ToFloat4(ezProcessingStream* pTarget, const ezProcessingStream* pSource, ezUInt64 uiStartIndex, ezUInt64 uiNumElements, float fScale);
+};
@@ -33,7 +33,28 @@ protected:
   virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) = 0;
 
   /// \brief The actual method which processes the data, will be called with the number of elements to process.
-  virtual void Process(ezUInt64 uiNumElements) = 0;
+  ///
+  /// The default implementation calls PrepareParallelProcessing() and ProcessRange() for all elements, so processors that support parallel
+  /// processing don't need to override this.
+  virtual void Process(ezUInt64 uiNumElements);
+
+  /// \brief Returns whether the stream group may split the elements into several ranges and process them on multiple threads.
+  ///
+  /// Processors that return true must implement PrepareParallelProcessing() and ProcessRange() instead of Process().
+  virtual bool SupportsParallelProcessing() const { return false; }
+
+  /// \brief Called once per update, before ProcessRange() is called for all element ranges.
+  ///
+  /// This is where everything belongs that must only be done once per update, e.g. updating counters or checking whether any work is needed.
+  /// Returning false skips processing entirely for this update.
+  virtual bool PrepareParallelProcessing(ezUInt64 uiNumElements) { return true; }
+
+  /// \brief Processes the elements in the range [uiStartIndex; uiStartIndex + uiNumElements).
+  ///
+  /// This may be called from multiple threads at the same time with disjoint ranges. Implementations must only write to the elements in
+  /// their range and must not modify any other state of the processor. ezProcessingStreamGroup::RemoveElement() and
+  /// ezProcessingStreamGroup::InitializeElements() may be called.
+  virtual void ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) {}
 
   /// \brief Back pointer to the stream group - will be set to the owner stream group when adding the stream processor to the group.
   /// Can be used to get stream pointers in UpdateStreamBindings();
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/IO/Archive/Archive.h>
 #include <Foundation/IO/MemoryMappedFile.h>
+#include <Foundation/Threading/Mutex.h>
 #include <Foundation/Types/UniquePtr.h>
 
 class ezRawMemoryStreamReader;
@@ -31,8 +33,35 @@ public:
   void ConfigureRawMemoryStreamReader(ezUInt32 uiEntryIdx, ezRawMemoryStreamReader& ref_memReader) const;
 
   /// \brief Creates a reader that will decompress the given file entry.
+  ///
+  /// If the entry was prefetched (see PrefetchEntries()), the reader takes over the already decompressed data instead.
   ezUniquePtr<ezStreamReader> CreateEntryReader(ezUInt32 uiEntryIdx) const;
 
+  /// \brief Reads and decompresses the entire data of the given entry into \a out_data.
+  ezResult ReadEntry(ezUInt32 uiEntryIdx, ezDynamicArray<ezUInt8>& out_data) const;
+
+  /// \brief Reads and decompresses multiple entries. The entries are decompressed in parallel on the task system.
+  ///
+  /// \a out_data must have as many elements as \a entryIndices. Returns failure, if any of the entries could not be read entirely.
+  ezResult ReadEntries(ezArrayPtr<const ezUInt32> entryIndices, ezArrayPtr<ezDynamicArray<ezUInt8>> out_data) const;
+
+  /// \brief Decompresses the given entries in parallel on the task system, so that reading them later does not need to decompress anything.
+  ///
+  /// The decompressed data is kept until the entry is read through CreateEntryReader() or TakePrefetchedEntry(), or until
+  /// ClearPrefetchedEntries() is called. Uncompressed entries are not copied, instead the pages of the memory mapped file that they are
+  /// stored in are touched, so that the OS already loads them.
+  /// Entries that are already prefetched are skipped. This function is thread-safe.
+  void PrefetchEntries(ezArrayPtr<const ezUInt32> entryIndices);
+
+  /// \brief Moves the prefetched data of the given entry into \a out_data. Returns false, if the entry is not prefetched.
+  bool TakePrefetchedEntry(ezUInt32 uiEntryIdx, ezDynamicArray<ezUInt8>& out_data) const;
+
+  /// \brief Returns the number of prefetched entries, whose data was not taken yet.
+  ezUInt32 GetNumPrefetchedEntries() const;
+
+  /// \brief Discards the data of all prefetched entries, that was not taken yet.
+  void ClearPrefetchedEntries();
+
 protected:
   /// \brief Called by ExtractAllFiles() for progress reporting. Return false to abort.
   virtual bool ExtractNextFileCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, ezStringView sSourceFile) const;
@@ -45,4 +74,7 @@ protected:
   ezUInt8 m_uiArchiveVersion = 0;
   const void* m_pDataStart = nullptr;
   ezUInt64 m_uiMemFileSize = 0;
+
+  mutable ezMutex m_PrefetchMutex;
+  mutable ezHashTable<ezUInt32, ezDynamicArray<ezUInt8>> m_PrefetchedEntries;
 };
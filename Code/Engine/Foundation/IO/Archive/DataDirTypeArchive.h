@@ -26,6 +26,11 @@ namespace ezDataDirectory
 
     virtual const ezString128& GetRedirectedDataDirectoryPath() const override { return m_sRedirectedDataDirPath; }
 
+    /// \brief Decompresses the given files in parallel ahead of time, so that opening them later doesn't need to decompress anything.
+    ///
+    /// Files that are not stored in this archive are ignored. See ezArchiveReader::PrefetchEntries() for details.
+    void PrefetchFiles(ezArrayPtr<const ezStringView> files);
+
   protected:
     virtual ezDataDirectoryReader* OpenFileToRead(ezStringView sFile, ezFileShareMode::Enum FileShareMode, bool bSpecificallyThisDataDir) override;
 
@@ -88,6 +93,11 @@ namespace ezDataDirectory
   protected:
     virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
     virtual void InternalClose() override;
+
+    friend class ArchiveType;
+
+    /// Decompressed data of a prefetched entry, that the reader reads from instead of the archive.
+    ezDynamicArray<ezUInt8> m_PrefetchedData;
   };
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
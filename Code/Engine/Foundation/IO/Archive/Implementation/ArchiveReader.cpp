@@ -7,6 +7,8 @@
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Types/Types.h>
 
 #include <Foundation/Logging/Log.h>
@@ -122,11 +124,174 @@ void ezArchiveReader::ConfigureRawMemoryStreamReader(ezUInt32 uiEntryIdx, ezRawM
   ezArchiveUtils::ConfigureRawMemoryStreamReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart, ref_memReader);
 }
 
+namespace
+{
+  /// \brief Reads from the decompressed data of a prefetched entry, which it owns.
+  class ezArchivePrefetchedEntryReader : public ezRawMemoryStreamReader
+  {
+  public:
+    ezArchivePrefetchedEntryReader(ezDynamicArray<ezUInt8>&& data)
+      : m_Data(std::move(data))
+    {
+      Reset(m_Data);
+    }
+
+  private:
+    ezDynamicArray<ezUInt8> m_Data;
+  };
+} // namespace
+
 ezUniquePtr<ezStreamReader> ezArchiveReader::CreateEntryReader(ezUInt32 uiEntryIdx) const
 {
+  ezDynamicArray<ezUInt8> prefetchedData;
+  if (TakePrefetchedEntry(uiEntryIdx, prefetchedData))
+  {
+    return EZ_DEFAULT_NEW(ezArchivePrefetchedEntryReader, std::move(prefetchedData));
+  }
+
   return ezArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart);
 }
 
+ezResult ezArchiveReader::ReadEntry(ezUInt32 uiEntryIdx, ezDynamicArray<ezUInt8>& out_data) const
+{
+  const ezArchiveEntry& entry = m_ArchiveTOC.m_Entries[uiEntryIdx];
+
+  out_data.SetCountUninitialized(static_cast<ezUInt32>(entry.m_uiUncompressedDataSize));
+
+  if (entry.m_CompressionMode == ezArchiveCompressionMode::Uncompressed)
+  {
+    ezMemoryUtils::Copy(out_data.GetData(), static_cast<const ezUInt8*>(m_pDataStart) + entry.m_uiDataStartOffset, out_data.GetCount());
+    return EZ_SUCCESS;
+  }
+
+  ezUniquePtr<ezStreamReader> pReader = ezArchiveUtils::CreateEntryReader(entry, m_pDataStart);
+
+  if (pReader == nullptr || pReader->ReadBytes(out_data.GetData(), out_data.GetCount()) != out_data.GetCount())
+  {
+    out_data.Clear();
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezArchiveReader::ReadEntries(ezArrayPtr<const ezUInt32> entryIndices, ezArrayPtr<ezDynamicArray<ezUInt8>> out_data) const
+{
+  EZ_ASSERT_DEV(entryIndices.GetCount() == out_data.GetCount(), "Number of entries and output arrays doesn't match");
+
+  ezAtomicInteger32 iNumFailed;
+
+  // entries can have vastly different sizes, allow more tasks per thread to balance the work
+  ezParallelForParams params;
+  params.m_uiBinSize = 1;
+  params.m_uiMaxTasksPerThread = 4;
+
+  ezTaskSystem::ParallelForIndexed(
+    0, entryIndices.GetCount(), [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+    {
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        if (ReadEntry(entryIndices[i], out_data[i]).Failed())
+        {
+          iNumFailed.Increment();
+        }
+      }
+    },
+    "ezArchiveReader::ReadEntries", ezTaskNesting::Never, params);
+
+  return iNumFailed == 0 ? EZ_SUCCESS : EZ_FAILURE;
+}
+
+void ezArchiveReader::PrefetchEntries(ezArrayPtr<const ezUInt32> entryIndices)
+{
+  EZ_PROFILE_SCOPE("ezArchiveReader::PrefetchEntries");
+
+  ezDynamicArray<ezUInt32> compressedEntries;
+  ezDynamicArray<ezUInt32> uncompressedEntries;
+
+  {
+    EZ_LOCK(m_PrefetchMutex);
+
+    for (ezUInt32 uiEntryIdx : entryIndices)
+    {
+      if (uiEntryIdx >= m_ArchiveTOC.m_Entries.GetCount() || m_PrefetchedEntries.Contains(uiEntryIdx))
+        continue;
+
+      if (m_ArchiveTOC.m_Entries[uiEntryIdx].m_CompressionMode == ezArchiveCompressionMode::Uncompressed)
+        uncompressedEntries.PushBack(uiEntryIdx);
+      else if (!compressedEntries.Contains(uiEntryIdx))
+        compressedEntries.PushBack(uiEntryIdx);
+    }
+  }
+
+  // reading one byte per page makes the OS load the data of the memory mapped file
+  {
+    ezUInt64 uiTouchSum = 0;
+
+    for (ezUInt32 uiEntryIdx : uncompressedEntries)
+    {
+      const ezArchiveEntry& entry = m_ArchiveTOC.m_Entries[uiEntryIdx];
+      const ezUInt8* pData = static_cast<const ezUInt8*>(m_pDataStart) + entry.m_uiDataStartOffset;
+
+      for (ezUInt64 uiOffset = 0; uiOffset < entry.m_uiStoredDataSize; uiOffset += 4096)
+      {
+        uiTouchSum += pData[uiOffset];
+      }
+    }
+
+    // prevent the compiler from removing the loop above
+    volatile ezUInt64 uiTouchSumResult = uiTouchSum;
+    EZ_IGNORE_UNUSED(uiTouchSumResult);
+  }
+
+  if (compressedEntries.IsEmpty())
+    return;
+
+  ezDynamicArray<ezDynamicArray<ezUInt8>> data;
+  data.SetCount(compressedEntries.GetCount());
+
+  const bool bAllSucceeded = ReadEntries(compressedEntries, data).Succeeded();
+
+  EZ_LOCK(m_PrefetchMutex);
+
+  for (ezUInt32 i = 0; i < compressedEntries.GetCount(); ++i)
+  {
+    // ReadEntry() clears the data of entries that failed
+    if (!bAllSucceeded && data[i].GetCount() != m_ArchiveTOC.m_Entries[compressedEntries[i]].m_uiUncompressedDataSize)
+    {
+      ezLog::Error("Failed to prefetch archive entry '{}'", m_ArchiveTOC.GetEntryPathString(compressedEntries[i]));
+      continue;
+    }
+
+    m_PrefetchedEntries.Insert(compressedEntries[i], std::move(data[i]));
+  }
+}
+
+bool ezArchiveReader::TakePrefetchedEntry(ezUInt32 uiEntryIdx, ezDynamicArray<ezUInt8>& out_data) const
+{
+  EZ_LOCK(m_PrefetchMutex);
+
+  ezDynamicArray<ezUInt8>* pData = nullptr;
+  if (!m_PrefetchedEntries.TryGetValue(uiEntryIdx, pData))
+    return false;
+
+  out_data = std::move(*pData);
+  m_PrefetchedEntries.Remove(uiEntryIdx);
+  return true;
+}
+
+ezUInt32 ezArchiveReader::GetNumPrefetchedEntries() const
+{
+  EZ_LOCK(m_PrefetchMutex);
+  return m_PrefetchedEntries.GetCount();
+}
+
+void ezArchiveReader::ClearPrefetchedEntries()
+{
+  EZ_LOCK(m_PrefetchMutex);
+  m_PrefetchedEntries.Clear();
+}
+
 ezResult ezArchiveReader::ExtractFile(ezUInt32 uiEntryIdx, ezStringView sTargetFolder) const
 {
   ezStringView sFilePath = m_ArchiveTOC.GetEntryPathString(uiEntryIdx);
@@ -40,6 +40,31 @@ ezDataDirectoryType* ezDataDirectory::ArchiveType::Factory(ezStringView sDataDir
   return nullptr;
 }
 
+void ezDataDirectory::ArchiveType::PrefetchFiles(ezArrayPtr<const ezStringView> files)
+{
+  const ezArchiveTOC& toc = m_ArchiveReader.GetArchiveTOC();
+
+  ezDynamicArray<ezUInt32> entries;
+  entries.Reserve(files.GetCount());
+
+  ezStringBuilder sArchivePath;
+  for (ezStringView sFile : files)
+  {
+    sArchivePath = m_sArchiveSubFolder;
+    sArchivePath.AppendPath(sFile);
+    sArchivePath.MakeCleanPath();
+
+    const ezUInt32 uiEntryIndex = toc.FindEntry(sArchivePath);
+
+    if (uiEntryIndex != ezInvalidIndex)
+    {
+      entries.PushBack(uiEntryIndex);
+    }
+  }
+
+  m_ArchiveReader.PrefetchEntries(entries);
+}
+
 ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(ezStringView sFile, ezFileShareMode::Enum FileShareMode, bool bSpecificallyThisDataDir)
 {
   EZ_IGNORE_UNUSED(bSpecificallyThisDataDir);
@@ -56,12 +81,16 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(ezStringView
 
   const ezArchiveEntry* pEntry = &toc.m_Entries[uiEntryIndex];
 
+  // prefetched entries are already decompressed and are read like uncompressed ones
+  ezDynamicArray<ezUInt8> prefetchedData;
+  const bool bPrefetched = m_ArchiveReader.TakePrefetchedEntry(uiEntryIndex, prefetchedData);
+
   ArchiveReaderCommon* pReader = nullptr;
 
   {
     EZ_LOCK(m_ReaderMutex);
 
-    switch (pEntry->m_CompressionMode)
+    switch (bPrefetched ? ezArchiveCompressionMode::Uncompressed : pEntry->m_CompressionMode)
     {
       case ezArchiveCompressionMode::Uncompressed:
       {
@@ -120,7 +149,17 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(ezStringView
   pReader->m_uiUncompressedSize = pEntry->m_uiUncompressedDataSize;
   pReader->m_uiCompressedSize = pEntry->m_uiStoredDataSize;
 
-  m_ArchiveReader.ConfigureRawMemoryStreamReader(uiEntryIndex, pReader->m_MemStreamReader);
+  if (bPrefetched)
+  {
+    ArchiveReaderUncompressed* pUncompressedReader = static_cast<ArchiveReaderUncompressed*>(pReader);
+    pUncompressedReader->m_PrefetchedData = std::move(prefetchedData);
+    pUncompressedReader->m_uiCompressedSize = pEntry->m_uiUncompressedDataSize;
+    pUncompressedReader->m_MemStreamReader.Reset(pUncompressedReader->m_PrefetchedData);
+  }
+  else
+  {
+    m_ArchiveReader.ConfigureRawMemoryStreamReader(uiEntryIndex, pReader->m_MemStreamReader);
+  }
 
   if (pReader->Open(sArchivePath, this, FileShareMode).Failed())
   {
@@ -308,7 +347,9 @@ ezResult ezDataDirectory::ArchiveReaderUncompressed::InternalOpen(ezFileShareMod
 
 void ezDataDirectory::ArchiveReaderUncompressed::InternalClose()
 {
-  // nothing to do
+  // readers are pooled, don't keep the data of prefetched entries alive
+  m_PrefetchedData.Clear();
+  m_PrefetchedData.Compact();
 }
 
 //////////////////////////////////////////////////////////////////////////
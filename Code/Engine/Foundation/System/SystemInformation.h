@@ -84,6 +84,7 @@ struct ezCpuFeatures
 
   bool IsAvx1Available() const { return OS_AVX && HW_AVX; }
   bool IsAvx2Available() const { return OS_AVX && HW_AVX2; }
+  bool IsFma3Available() const { return OS_AVX && HW_FMA3; }
 #endif
 
   void Detect();
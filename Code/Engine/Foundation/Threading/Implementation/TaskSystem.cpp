@@ -41,6 +41,7 @@ void ezTaskSystem::Startup()
 
   tl_TaskWorkerInfo.m_WorkerType = ezWorkerThreadType::MainThread;
   tl_TaskWorkerInfo.m_iWorkerIndex = 0;
+  tl_TaskWorkerInfo.m_pWorkQueues = s_pThreadState->m_MainThreadWorkQueues;
 
   // initialize with the default number of worker threads
   SetWorkerThreadCount();
@@ -53,6 +54,8 @@ void ezTaskSystem::Shutdown()
 
   StopWorkerThreads();
 
+  tl_TaskWorkerInfo.m_pWorkQueues = nullptr;
+
   s_pState.Clear();
   s_pThreadState.Clear();
 }
@@ -144,6 +144,17 @@ void ezTaskSystem::ScheduleGroupTasks(ezTaskGroup* pGroup, bool bHighPriority)
   }
 
   ezInt32 iRemainingTasks = 0;
+  ezUInt32 uiNumTasks = 0;
+
+  const ezTaskPriority::Enum priority = pGroup->m_Priority;
+
+  // 'this frame' tasks that are scheduled from the main thread or a short task worker go into that thread's work-stealing queue
+  // everything else goes into the shared task lists
+  ezTaskWorkQueue* pWorkQueue = nullptr;
+  if (priority < ezTaskWorkQueue::NumPriorities && tl_TaskWorkerInfo.m_pWorkQueues != nullptr)
+  {
+    pWorkQueue = &tl_TaskWorkerInfo.m_pWorkQueues[priority];
+  }
 
   // add all the tasks to the task list, so that they will be processed
   {
@@ -156,32 +167,76 @@ void ezTaskSystem::ScheduleGroupTasks(ezTaskGroup* pGroup, bool bHighPriority)
     {
       iRemainingTasks += ezMath::Max(1u, pTask->m_uiMultiplicity);
       pTask->m_iRemainingRuns = ezMath::Max(1u, pTask->m_uiMultiplicity);
+
+      // from now on CancelTask() won't remove the task from the group anymore
+      pTask->m_bTaskIsScheduled = true;
     }
 
     pGroup->m_iNumRemainingTasks = iRemainingTasks;
+    uiNumTasks = pGroup->m_Tasks.GetCount();
 
+    if (pWorkQueue == nullptr)
+    {
+      for (ezUInt32 task = 0; task < uiNumTasks; ++task)
+      {
+        auto& pTask = pGroup->m_Tasks[task];
+
+        for (ezUInt32 mult = 0; mult < ezMath::Max(1u, pTask->m_uiMultiplicity); ++mult)
+        {
+          TaskData td;
+          td.m_pBelongsToGroup = pGroup;
+          td.m_pTask = pTask;
+          td.m_uiInvocation = mult;
+
+          if (bHighPriority)
+            s_pState->m_Tasks[priority].PushFront(td);
+          else
+            s_pState->m_Tasks[priority].PushBack(td);
+        }
+      }
 
-    for (ezUInt32 task = 0; task < pGroup->m_Tasks.GetCount(); ++task)
+      s_pState->m_iNumTasks[priority].Add(iRemainingTasks);
+    }
+  }
+
+  if (pWorkQueue != nullptr)
+  {
+    // Once the last item is pushed, other threads may finish the entire group, so it must not be accessed anymore after that.
+    // The item count is therefore cached above and all task properties are read before a task's items get pushed.
+    // 'bHighPriority' needs no special handling, the items at the bottom of the queue are the first ones that this thread works on.
+    for (ezUInt32 task = 0; task < uiNumTasks; ++task)
     {
-      auto& pTask = pGroup->m_Tasks[task];
+      const ezTask* pTask = pGroup->m_Tasks[task].Borrow();
+      const ezUInt32 uiMultiplicity = ezMath::Max(1u, pTask->m_uiMultiplicity);
+
+      ezTaskWorkItem item;
+      item.m_pBelongsToGroup = pGroup;
+      item.m_uiTaskIndex = task;
+      item.m_bNeverWaits = pTask->m_NestingMode == ezTaskNesting::Never;
 
-      for (ezUInt32 mult = 0; mult < ezMath::Max(1u, pTask->m_uiMultiplicity); ++mult)
+      for (ezUInt32 mult = 0; mult < uiMultiplicity; ++mult)
       {
-        TaskData td;
-        td.m_pBelongsToGroup = pGroup;
-        td.m_pTask = pTask;
-        td.m_pTask->m_bTaskIsScheduled = true;
-        td.m_uiInvocation = mult;
-
-        if (bHighPriority)
-          s_pState->m_Tasks[pGroup->m_Priority].PushFront(td);
-        else
-          s_pState->m_Tasks[pGroup->m_Priority].PushBack(td);
+        item.m_uiInvocation = mult;
+
+        if (!pWorkQueue->Push(item))
+        {
+          // the queue is full, fall back to the shared list
+          TaskData td;
+          td.m_pBelongsToGroup = pGroup;
+          td.m_pTask = pGroup->m_Tasks[task];
+          td.m_uiInvocation = mult;
+
+          EZ_LOCK(s_TaskSystemMutex);
+          s_pState->m_Tasks[priority].PushBack(td);
+          s_pState->m_iNumTasks[priority].Increment();
+        }
       }
     }
+  }
 
+  {
     // send the proper thread signal, to make sure one of the correct worker threads is awake
-    switch (pGroup->m_Priority)
+    switch (priority)
     {
       case ezTaskPriority::EarlyThisFrame:
       case ezTaskPriority::ThisFrame:
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Foundation/Threading/Implementation/TaskWorkQueue.h>
 #include <Foundation/Threading/TaskSystem.h>
 
 class ezTaskSystemThreadState
@@ -16,6 +17,9 @@ private:
 
   // the maximum number of worker threads that should be non-idle (and not blocked) at any time
   ezUInt32 m_uiMaxWorkersToUse[ezWorkerThreadType::ENUM_COUNT] = {};
+
+  // The work-stealing queues of the main thread, the short task workers have their own.
+  ezTaskWorkQueue m_MainThreadWorkQueues[ezTaskWorkQueue::NumPriorities];
 };
 
 class ezTaskSystemState
@@ -30,5 +34,10 @@ private:
   ezDeque<ezTaskGroup> m_TaskGroups;
 
   // The lists of all scheduled tasks, for each priority.
+  // Tasks that are scheduled from the main thread or a short task worker with a 'this frame' priority go into that thread's
+  // ezTaskWorkQueue instead, all others end up here.
   ezList<ezTaskSystem::TaskData> m_Tasks[ezTaskPriority::ENUM_COUNT];
+
+  // The number of entries in m_Tasks, so that threads can skip empty lists without taking s_TaskSystemMutex.
+  ezAtomicInteger32 m_iNumTasks[ezTaskPriority::ENUM_COUNT];
 };
@@ -94,29 +94,107 @@ ezTaskSystem::TaskData ezTaskSystem::GetNextTask(ezTaskPriority::Enum FirstPrior
   EZ_ASSERT_DEV(FirstPriority >= ezTaskPriority::EarlyThisFrame && LastPriority < ezTaskPriority::ENUM_COUNT, "Priority Range is invalid: {0} to {1}",
     FirstPriority, LastPriority);
 
-  EZ_LOCK(s_TaskSystemMutex);
+  TaskData td;
+
+  if (TryGetNextTask(td, FirstPriority, LastPriority, bOnlyTasksThatNeverWait, WaitingForGroup))
+    return td;
+
+  if (pWorkerState)
+  {
+    EZ_VERIFY(pWorkerState->Set((int)ezTaskWorkerState::Idle) == (int)ezTaskWorkerState::Active, "Corrupt Worker State");
+
+    // tasks are pushed into the work queues without any lock, so one may have been added after we searched,
+    // but before we flagged ourselves as idle, in which case nobody would wake us up
+    // therefore search once more, now that anyone who adds a task will see us as idle
+    if (TryGetNextTask(td, FirstPriority, LastPriority, bOnlyTasksThatNeverWait, WaitingForGroup))
+    {
+      // if this fails, someone else has woken us up in the meantime, which only results in one spurious wake up later
+      pWorkerState->CompareAndSwap((int)ezTaskWorkerState::Idle, (int)ezTaskWorkerState::Active);
+      return td;
+    }
+  }
+
+  return TaskData();
+}
+
+bool ezTaskSystem::TryGetNextTask(ezTaskSystem::TaskData& out_task, ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority,
+  bool bOnlyTasksThatNeverWait, const ezTaskGroupID& WaitingForGroup)
+{
+  ezTaskWorkQueue* pOwnQueues = tl_TaskWorkerInfo.m_pWorkQueues;
 
   // go through all the task lists that this thread is willing to work on
   for (ezUInt32 prio = FirstPriority; prio <= (ezUInt32)LastPriority; ++prio)
   {
+    if (prio < ezTaskWorkQueue::NumPriorities)
+    {
+      ezTaskWorkItem item;
+
+      // prefer the tasks that this thread scheduled itself, they are the most likely ones to still be in the cache
+      if (pOwnQueues != nullptr && pOwnQueues[prio].Pop(item, bOnlyTasksThatNeverWait, WaitingForGroup.m_pTaskGroup))
+      {
+        out_task.m_pTask = item.m_pBelongsToGroup->m_Tasks[item.m_uiTaskIndex];
+        out_task.m_pBelongsToGroup = item.m_pBelongsToGroup;
+        out_task.m_uiInvocation = item.m_uiInvocation;
+        return true;
+      }
+
+      if (StealTask(out_task, prio, bOnlyTasksThatNeverWait, WaitingForGroup.m_pTaskGroup))
+        return true;
+    }
+
+    if (s_pState->m_iNumTasks[prio] == 0)
+      continue;
+
+    EZ_LOCK(s_TaskSystemMutex);
+
     for (auto it = s_pState->m_Tasks[prio].GetIterator(); it.IsValid(); ++it)
     {
       if (!bOnlyTasksThatNeverWait || (it->m_pTask->m_NestingMode == ezTaskNesting::Never) || it->m_pBelongsToGroup == WaitingForGroup.m_pTaskGroup)
       {
-        TaskData td = *it;
+        out_task = *it;
 
         s_pState->m_Tasks[prio].Remove(it);
-        return td;
+        s_pState->m_iNumTasks[prio].Decrement();
+        return true;
       }
     }
   }
 
-  if (pWorkerState)
+  return false;
+}
+
+bool ezTaskSystem::StealTask(ezTaskSystem::TaskData& out_task, ezUInt32 uiPriority, bool bOnlyTasksThatNeverWait, const ezTaskGroup* pWaitingForGroup)
+{
+  const ezUInt32 uiNumWorkers = s_pThreadState->m_iAllocatedWorkers[ezWorkerThreadType::ShortTasks];
+  const ezUInt32 uiNumVictims = uiNumWorkers + 1;
+
+  // index uiNumWorkers stands for the main thread
+  // start with the thread after this one, so that not all threads try to steal from the same victim
+  ezUInt32 uiFirstVictim = 0;
+  if (tl_TaskWorkerInfo.m_WorkerType == ezWorkerThreadType::ShortTasks)
   {
-    EZ_VERIFY(pWorkerState->Set((int)ezTaskWorkerState::Idle) == (int)ezTaskWorkerState::Active, "Corrupt Worker State");
+    uiFirstVictim = static_cast<ezUInt32>(tl_TaskWorkerInfo.m_iWorkerIndex + 1);
   }
 
-  return TaskData();
+  for (ezUInt32 i = 0; i < uiNumVictims; ++i)
+  {
+    const ezUInt32 uiVictim = (uiFirstVictim + i) % uiNumVictims;
+
+    ezTaskWorkQueue* pQueues = (uiVictim == uiNumWorkers) ? s_pThreadState->m_MainThreadWorkQueues : s_pThreadState->m_Workers[ezWorkerThreadType::ShortTasks][uiVictim]->m_WorkQueues;
+
+    // our own queue is included on purpose, Pop() only looks at the bottom item,
+    // which may not be executable by this thread, while the top item is
+    ezTaskWorkItem item;
+    if (pQueues[uiPriority].Steal(item, bOnlyTasksThatNeverWait, pWaitingForGroup))
+    {
+      out_task.m_pTask = item.m_pBelongsToGroup->m_Tasks[item.m_uiTaskIndex];
+      out_task.m_pBelongsToGroup = item.m_pBelongsToGroup;
+      out_task.m_uiInvocation = item.m_uiInvocation;
+      return true;
+    }
+  }
+
+  return false;
 }
 
 bool ezTaskSystem::ExecuteTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
@@ -191,6 +269,7 @@ ezResult ezTaskSystem::CancelTask(const ezSharedPtr<ezTask>& pTask, ezOnTaskRunn
             TaskHasFinished(std::move(it->m_pTask), it->m_pBelongsToGroup);
 
             s_pState->m_Tasks[i].Remove(it);
+            s_pState->m_iNumTasks[i].Decrement();
             return EZ_SUCCESS;
           }
 
@@ -200,8 +279,9 @@ ezResult ezTaskSystem::CancelTask(const ezSharedPtr<ezTask>& pTask, ezOnTaskRunn
     }
   }
 
-  // if we made it here, the task was already running
-  // thus we just wait for it to finish
+  // if we made it here, the task was either already running, or it sits in some thread's work queue
+  // in the latter case it can't be removed, but since the cancel flag is set, it will be skipped once it gets picked up
+  // either way, we can only wait for it to finish
 
   if (onTaskRunning == ezOnTaskRunning::WaitTillFinished)
   {
@@ -226,6 +306,8 @@ bool ezTaskSystem::HelpExecutingTasks(const ezTaskGroupID& WaitingForGroup)
 
 void ezTaskSystem::ReprioritizeFrameTasks()
 {
+  // Only the tasks in the shared lists get re-prioritized. The work queues only ever hold 'this frame' tasks, which keep their priority
+  // and stay available to all threads through stealing, so they are left where they are.
   // There should usually be no 'this frame tasks' left at this time
   // however, while we waited to enter the lock, such tasks might have appeared
   // In this case we move them into the highest-priority 'this frame' queue, to ensure they will be executed asap
@@ -277,6 +359,11 @@ void ezTaskSystem::ReprioritizeFrameTasks()
     // remove the tasks from their current queue
     s_pState->m_Tasks[i].Clear();
   }
+
+  for (ezUInt32 i = (ezUInt32)ezTaskPriority::EarlyThisFrame; i <= (ezUInt32)ezTaskPriority::In9Frames; ++i)
+  {
+    s_pState->m_iNumTasks[i] = static_cast<ezInt32>(s_pState->m_Tasks[i].GetCount());
+  }
 }
 
 void ezTaskSystem::ExecuteSomeFrameTasks(ezTime smoothFrameTime)
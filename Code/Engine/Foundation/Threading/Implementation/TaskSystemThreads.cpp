@@ -2,8 +2,10 @@
 
 #include <Foundation/Logging/Log.h>
 #include <Foundation/System/SystemInformation.h>
+#include <Foundation/Threading/Implementation/TaskGroup.h>
 #include <Foundation/Threading/Implementation/TaskSystemState.h>
 #include <Foundation/Threading/Implementation/TaskWorkerThread.h>
+#include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/TaskSystem.h>
 
 ezUInt32 ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::Enum type)
@@ -93,13 +95,37 @@ void ezTaskSystem::StopWorkerThreads()
   {
     const ezUInt32 uiNumWorkers = s_pThreadState->m_iAllocatedWorkers[type];
 
+    // make sure no other thread tries to steal from the workers that are about to be deleted
+    s_pThreadState->m_iAllocatedWorkers[type] = 0;
+
     for (ezUInt32 i = 0; i < uiNumWorkers; ++i)
     {
-      s_pThreadState->m_Workers[type][i]->Join();
-      EZ_DEFAULT_DELETE(s_pThreadState->m_Workers[type][i]);
+      ezTaskWorkerThread* pWorker = s_pThreadState->m_Workers[type][i];
+      pWorker->Join();
+
+      // the worker may have left tasks in its work queues, move them over to the shared lists, so that they don't get lost
+      {
+        EZ_LOCK(s_TaskSystemMutex);
+
+        for (ezUInt32 prio = 0; prio < ezTaskWorkQueue::NumPriorities; ++prio)
+        {
+          ezTaskWorkItem item;
+          while (pWorker->m_WorkQueues[prio].Pop(item, false, nullptr))
+          {
+            TaskData td;
+            td.m_pTask = item.m_pBelongsToGroup->m_Tasks[item.m_uiTaskIndex];
+            td.m_pBelongsToGroup = item.m_pBelongsToGroup;
+            td.m_uiInvocation = item.m_uiInvocation;
+
+            s_pState->m_Tasks[prio].PushBack(td);
+            s_pState->m_iNumTasks[prio].Increment();
+          }
+        }
+      }
+
+      EZ_DEFAULT_DELETE(pWorker);
     }
 
-    s_pThreadState->m_iAllocatedWorkers[type] = 0;
     s_pThreadState->m_uiMaxWorkersToUse[type] = 0;
     s_pThreadState->m_Workers[type].Clear();
   }
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Implementation/TaskSystemDeclarations.h>
+
+#include <atomic>
+
+/// \internal A single scheduled task invocation inside an ezTaskWorkQueue.
+///
+/// The task is referenced through its group and its index in the group's task list. The group keeps the task alive
+/// until all its invocations are finished, so no reference counting is needed while the item is queued.
+/// The item is plain data on purpose: a thief may read a stale item, which it then discards when it loses the race for it.
+struct ezTaskWorkItem
+{
+  EZ_DECLARE_POD_TYPE();
+
+  ezTaskGroup* m_pBelongsToGroup;
+  ezUInt32 m_uiTaskIndex;
+  ezUInt32 m_uiInvocation : 31;
+  ezUInt32 m_bNeverWaits : 1;
+
+  /// \brief Whether a thread that is only allowed to help with certain tasks (see ezTaskSystem::HelpExecutingTasks) may take this item.
+  EZ_ALWAYS_INLINE bool CanBeExecutedBy(bool bOnlyTasksThatNeverWait, const ezTaskGroup* pWaitingForGroup) const
+  {
+    return !bOnlyTasksThatNeverWait || m_bNeverWaits || m_pBelongsToGroup == pWaitingForGroup;
+  }
+};
+
+/// \internal A fixed-size work-stealing deque (Chase-Lev) that holds the tasks that one thread has scheduled.
+///
+/// Only the owning thread may call Push() and Pop(), which operate on the bottom end in LIFO order.
+/// Any other thread may call Steal() to take items from the top end in FIFO order.
+/// No locks are involved. Thieves compete through a CAS on the top index, the owner only takes part in that for the last remaining item.
+/// The explicit fences follow the C11 formulation of the algorithm (Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models"),
+/// so the queue doesn't rely on the strong memory ordering of x86.
+/// When the queue is full, Push() fails and the caller has to put the task into the shared task lists instead.
+class ezTaskWorkQueue
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezTaskWorkQueue);
+
+public:
+  /// \brief Only the 'this frame' priorities are distributed through work queues.
+  ///
+  /// All other priorities have to be re-prioritized by ezTaskSystem::FinishFrameTasks(), which requires them to be in the shared task lists.
+  static constexpr ezUInt32 NumPriorities = ezTaskPriority::LateThisFrame + 1;
+
+  static constexpr ezInt64 Capacity = 1024;
+
+  ezTaskWorkQueue() = default;
+
+  /// \brief Returns whether the queue is empty. The result is only a snapshot, unless called by the owning thread.
+  EZ_ALWAYS_INLINE bool IsEmpty() const { return static_cast<ezInt64>(m_iBottom) <= static_cast<ezInt64>(m_iTop); }
+
+  /// \brief Adds an item at the bottom end. Returns false if the queue is full. May only be called by the owning thread.
+  bool Push(const ezTaskWorkItem& item)
+  {
+    const ezInt64 b = m_iBottom;
+    const ezInt64 t = m_iTop;
+
+    if (b - t >= Capacity)
+      return false;
+
+    m_Items[b & (Capacity - 1)] = item;
+
+    // the item has to be visible to thieves before the new bottom is
+    std::atomic_thread_fence(std::memory_order_release);
+    m_iBottom = b + 1;
+    return true;
+  }
+
+  /// \brief Takes the most recently pushed item. May only be called by the owning thread.
+  ///
+  /// If the bottom item may not be executed by the calling thread (see ezTaskWorkItem::CanBeExecutedBy()), nothing is returned.
+  bool Pop(ezTaskWorkItem& out_item, bool bOnlyTasksThatNeverWait, const ezTaskGroup* pWaitingForGroup)
+  {
+    ezInt64 b = m_iBottom;
+    ezInt64 t = m_iTop;
+
+    if (b <= t)
+      return false;
+
+    // only the owner writes items, so peeking at our own bottom item is always safe
+    if (!m_Items[(b - 1) & (Capacity - 1)].CanBeExecutedBy(bOnlyTasksThatNeverWait, pWaitingForGroup))
+      return false;
+
+    b = b - 1;
+    m_iBottom = b;
+
+    // the new bottom has to be visible to thieves before we read the top, otherwise a thief and we may both take the last item
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    t = m_iTop;
+
+    if (t > b)
+    {
+      // a thief took the last item in the meantime
+      m_iBottom = b + 1;
+      return false;
+    }
+
+    out_item = m_Items[b & (Capacity - 1)];
+
+    if (t == b)
+    {
+      // this was the last item, race against the thieves for it
+      const bool bWon = m_iTop.TestAndSet(t, t + 1);
+      m_iBottom = b + 1;
+      return bWon;
+    }
+
+    return true;
+  }
+
+  /// \brief Takes the oldest item. May be called by any thread.
+  ///
+  /// Losing the race for the top item to another thread is no reason to give up, the next item is tried instead.
+  /// Returns false only when the queue is empty or the top item may not be executed by the calling thread.
+  /// Items further down can't be taken out of order, these are left for the owner and for threads that aren't restricted.
+  bool Steal(ezTaskWorkItem& out_item, bool bOnlyTasksThatNeverWait, const ezTaskGroup* pWaitingForGroup)
+  {
+    while (true)
+    {
+      const ezInt64 t = m_iTop;
+
+      // the top has to be read before the bottom, see Pop()
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const ezInt64 b = m_iBottom;
+
+      if (t >= b)
+        return false;
+
+      // the item may be overwritten concurrently, but then the CAS below fails and the copy is discarded
+      const ezTaskWorkItem item = m_Items[t & (Capacity - 1)];
+
+      if (!item.CanBeExecutedBy(bOnlyTasksThatNeverWait, pWaitingForGroup))
+        return false;
+
+      if (m_iTop.TestAndSet(t, t + 1))
+      {
+        out_item = item;
+        return true;
+      }
+    }
+  }
+
+private:
+  static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
+  // top and bottom are written by different threads, keep them on separate cache lines
+  ezAtomicInteger64 m_iTop;
+  ezUInt8 m_Padding0[64 - sizeof(ezAtomicInteger64)];
+  ezAtomicInteger64 m_iBottom;
+  ezUInt8 m_Padding1[64 - sizeof(ezAtomicInteger64)];
+
+  ezTaskWorkItem m_Items[Capacity];
+};
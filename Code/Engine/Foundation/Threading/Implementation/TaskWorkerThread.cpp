@@ -50,6 +50,11 @@ ezUInt32 ezTaskWorkerThread::Run()
   tl_TaskWorkerInfo.m_iWorkerIndex = m_uiWorkerThreadNumber;
   tl_TaskWorkerInfo.m_pWorkerState = &m_iWorkerState;
 
+  if (m_WorkerType == ezWorkerThreadType::ShortTasks)
+  {
+    tl_TaskWorkerInfo.m_pWorkQueues = m_WorkQueues;
+  }
+
   const bool bIsReserve = m_uiWorkerThreadNumber >= ezTaskSystem::s_pThreadState->m_uiMaxWorkersToUse[m_WorkerType];
 
   ezTaskPriority::Enum FirstPriority;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Threading/Implementation/TaskSystemDeclarations.h>
+#include <Foundation/Threading/Implementation/TaskWorkQueue.h>
 
 #include <Foundation/Threading/Thread.h>
 #include <Foundation/Threading/ThreadSignal.h>
@@ -75,6 +76,17 @@ private:
   ezAtomicInteger32 m_iWorkerState; // ezTaskWorkerState
 
   ///@}
+
+  /// \name Work Stealing
+  ///@{
+
+private:
+  friend class ezTaskSystem;
+
+  // Tasks that this thread scheduled itself. Only used by short task workers, other threads are stolen from.
+  ezTaskWorkQueue m_WorkQueues[ezTaskWorkQueue::NumPriorities];
+
+  ///@}
 };
 
 /// \internal Thread local state used by the task system (and for better debugging)
@@ -85,6 +97,7 @@ struct ezTaskWorkerInfo
   ezInt32 m_iWorkerIndex = -1;
   const char* m_szTaskName = nullptr;
   ezAtomicInteger32* m_pWorkerState = nullptr;
+  ezTaskWorkQueue* m_pWorkQueues = nullptr; ///< Only set on threads that own work-stealing queues (main thread and short task workers).
 };
 
 extern thread_local ezTaskWorkerInfo tl_TaskWorkerInfo;
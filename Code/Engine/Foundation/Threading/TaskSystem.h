@@ -63,6 +63,10 @@ public:
   /// Tasks that are removed without execution will still be marked as 'finished' and dependent tasks will be scheduled.
   ///
   /// EZ_FAILURE is returned, if the task had already been started and thus could not be prevented from running.
+  /// EZ_FAILURE is also returned for tasks that haven't started yet, but sit in the work-stealing queue of the thread that scheduled them.
+  /// That applies to tasks with a 'this frame' priority, that were started from the main thread or from a short task worker.
+  /// Those can't be removed from the queue, but they are flagged as canceled and won't execute once a thread picks them up.
+  /// With ezOnTaskRunning::WaitTillFinished the function returns as soon as that has happened.
   ///
   /// In case of failure, \a bWaitForIt determines whether 'WaitForTask' is called (with all its consequences),
   /// or whether the function will return immediately.
@@ -86,6 +90,13 @@ private:
   static TaskData GetNextTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
     const ezTaskGroupID& WaitingForGroup, ezAtomicInteger32* pWorkerState);
 
+  /// \brief Searches the work-stealing queues and the shared task lists once. Does not change the worker state.
+  static bool TryGetNextTask(TaskData& out_task, ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
+    const ezTaskGroupID& WaitingForGroup);
+
+  /// \brief Tries to take a task of priority \a uiPriority from the work-stealing queue of any other thread.
+  static bool StealTask(TaskData& out_task, ezUInt32 uiPriority, bool bOnlyTasksThatNeverWait, const ezTaskGroup* pWaitingForGroup);
+
   /// \brief Executes some task of priority between \a FirstPriority and \a LastPriority (inclusive). Returns true, if any such task was available.
   static bool ExecuteTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
     const ezTaskGroupID& WaitingForGroup, ezAtomicInteger32* pWorkerState);
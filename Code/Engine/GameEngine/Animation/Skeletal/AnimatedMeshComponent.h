@@ -78,6 +78,10 @@ protected:
   ezBoundingBox m_MaxBounds;
   ezSkinningState m_SkinningState;
   ezSkeletonResourceHandle m_hDefaultSkeleton;
+
+  // the skeleton joint index for every bone of the mesh, in the iteration order of the bones table, so that joints don't have to be looked up by name every frame
+  ezDynamicArray<ezUInt16> m_JointIndexPerBone;
+  const ezSkeleton* m_pMappedSkeleton = nullptr;
 };
 
 
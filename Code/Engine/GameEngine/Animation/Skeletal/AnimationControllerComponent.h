@@ -7,10 +7,18 @@
 #include <GameEngine/Animation/Skeletal/AnimatedMeshComponent.h>
 #include <RendererCore/AnimationSystem/AnimGraph/AnimController.h>
 #include <RendererCore/AnimationSystem/AnimGraph/AnimGraph.h>
+#include <RendererCore/AnimationSystem/AnimationLod.h>
 
 using ezSkeletonResourceHandle = ezTypedResourceHandle<class ezSkeletonResource>;
 using ezAnimGraphResourceHandle = ezTypedResourceHandle<class ezAnimGraphResource>;
 
+/// \brief Updates all ezAnimationControllerComponents in one batch.
+///
+/// The animation graphs are evaluated on the calling thread, since they may read and modify other objects.
+/// The poses of all graphs without IK are then generated together through ezAnimPoseGenerator::UpdatePoses(), the same way as the poses of ezSimpleAnimationComponent.
+/// Graphs with IK enabled generate their poses on the calling thread, since IK is applied through messages.
+///
+/// The skinning matrices are still uploaded to the GPU for each animated mesh separately.
 class ezAnimationControllerComponentManager : public ezComponentManager<class ezAnimationControllerComponent, ezBlockStorageType::FreeList>
 {
 public:
@@ -24,6 +32,9 @@ private:
   void ResourceEvent(const ezResourceEvent& e);
 
   ezDeque<ezComponentHandle> m_ComponentsToReset;
+  ezDynamicArray<ezAnimationControllerComponent*> m_ComponentsToBatch;
+  ezDynamicArray<ezAnimPoseGenerator*> m_PoseGeneratorsToBatch;
+  ezAnimationLodScheduler m_LodScheduler;
 };
 
 /// \brief Evaluates an ezAnimGraphResource and provides the result through the ezMsgAnimationPoseUpdated.
@@ -33,6 +44,8 @@ private:
 ///
 /// The result is sent as a recursive message, which is usually consumed by an ezAnimatedMeshComponent.
 /// The mesh component may be on the same game object or a child object.
+///
+/// Graphs far away from the cameras are evaluated less often and without IK, see ezAnimationLodScheduler.
 class EZ_GAMEENGINE_DLL ezAnimationControllerComponent : public ezComponent
 {
   EZ_DECLARE_COMPONENT_TYPE(ezAnimationControllerComponent, ezComponent, ezAnimationControllerComponentManager);
@@ -61,7 +74,15 @@ public:
   bool m_bEnableIK = false; // [ property ]
 
 protected:
-  void Update();
+  friend class ezAnimationControllerComponentManager;
+
+  /// \brief Evaluates the animation graph, if it is time for an update. Returns true, if a new pose needs to be generated.
+  bool PrepareUpdate(ezAnimationLodScheduler& ref_lodScheduler);
+
+  /// \brief Sends the generated pose to the animated meshes and applies the root motion.
+  void FinishUpdate();
+
+  bool IsIKEnabled() const { return m_bEnableIK && ezAnimationLod::IsIKEnabled(m_Lod); }
 
   ezEnum<ezRootMotionMode> m_RootMotionMode;
 
@@ -70,4 +91,5 @@ protected:
   ezAnimPoseGenerator m_PoseGenerator;
 
   ezTime m_ElapsedTimeSinceUpdate = ezTime::MakeZero();
+  ezAnimationLod::Enum m_Lod = ezAnimationLod::Lod0;
 };
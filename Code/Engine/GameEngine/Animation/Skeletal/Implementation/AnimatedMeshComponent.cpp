@@ -84,6 +84,7 @@ void ezAnimatedMeshComponent::OnDeactivated()
 void ezAnimatedMeshComponent::InitializeAnimationPose()
 {
   m_MaxBounds = ezBoundingBox::MakeInvalid();
+  m_pMappedSkeleton = nullptr;
 
   if (!m_hMesh.IsValid())
     return;
@@ -130,32 +131,34 @@ void ezAnimatedMeshComponent::InitializeAnimationPose()
 
 void ezAnimatedMeshComponent::MapModelSpacePoseToSkinningSpace(const ezHashTable<ezHashedString, ezMeshResourceDescriptor::BoneData>& bones, const ezSkeleton& skeleton, ezArrayPtr<const ezMat4> modelSpaceTransforms, ezBoundingBox* bounds)
 {
-  m_SkinningState.m_Transforms.SetCountUninitialized(bones.GetCount());
-
-  if (bounds)
+  if (m_pMappedSkeleton != &skeleton || m_JointIndexPerBone.GetCount() != bones.GetCount())
   {
+    m_pMappedSkeleton = &skeleton;
+    m_JointIndexPerBone.Clear();
+    m_JointIndexPerBone.Reserve(bones.GetCount());
+
     for (auto itBone : bones)
     {
-      const ezUInt16 uiJointIdx = skeleton.FindJointByName(itBone.Key());
-
-      if (uiJointIdx == ezInvalidJointIndex)
-        continue;
-
-      bounds->ExpandToInclude(modelSpaceTransforms[uiJointIdx].GetTranslationVector());
-      m_SkinningState.m_Transforms[itBone.Value().m_uiBoneIndex] = modelSpaceTransforms[uiJointIdx] * itBone.Value().m_GlobalInverseRestPoseMatrix;
+      m_JointIndexPerBone.PushBack(skeleton.FindJointByName(itBone.Key()));
     }
   }
-  else
+
+  m_SkinningState.m_Transforms.SetCountUninitialized(bones.GetCount());
+
+  ezUInt32 uiBone = 0;
+  for (auto itBone : bones)
   {
-    for (auto itBone : bones)
-    {
-      const ezUInt16 uiJointIdx = skeleton.FindJointByName(itBone.Key());
+    const ezUInt16 uiJointIdx = m_JointIndexPerBone[uiBone++];
 
-      if (uiJointIdx == ezInvalidJointIndex)
-        continue;
+    if (uiJointIdx == ezInvalidJointIndex || uiJointIdx >= modelSpaceTransforms.GetCount())
+      continue;
 
-      m_SkinningState.m_Transforms[itBone.Value().m_uiBoneIndex] = modelSpaceTransforms[uiJointIdx] * itBone.Value().m_GlobalInverseRestPoseMatrix;
+    if (bounds)
+    {
+      bounds->ExpandToInclude(modelSpaceTransforms[uiJointIdx].GetTranslationVector());
     }
+
+    m_SkinningState.m_Transforms[itBone.Value().m_uiBoneIndex] = modelSpaceTransforms[uiJointIdx] * itBone.Value().m_GlobalInverseRestPoseMatrix;
   }
 }
 
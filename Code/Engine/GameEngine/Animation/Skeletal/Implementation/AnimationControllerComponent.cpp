@@ -84,7 +84,7 @@ void ezAnimationControllerComponent::OnSimulationStarted()
   m_AnimController.AddAnimGraph(m_hAnimGraph);
 }
 
-void ezAnimationControllerComponent::Update()
+bool ezAnimationControllerComponent::PrepareUpdate(ezAnimationLodScheduler& ref_lodScheduler)
 {
   ezTime tMinStep = ezTime::MakeFromSeconds(0);
   ezVisibilityState visType = GetOwner()->GetVisibilityState();
@@ -92,19 +92,36 @@ void ezAnimationControllerComponent::Update()
   if (visType != ezVisibilityState::Direct)
   {
     if (m_InvisibleUpdateRate == ezAnimationInvisibleUpdateRate::Pause && visType == ezVisibilityState::Invisible)
-      return;
+      return false;
 
     tMinStep = ezAnimationInvisibleUpdateRate::GetTimeStep(m_InvisibleUpdateRate);
   }
 
+  m_Lod = ref_lodScheduler.DetermineLod(GetOwner());
+  tMinStep = ezMath::Max(tMinStep, ezAnimationLod::GetTimeStep(m_Lod));
+
   m_ElapsedTimeSinceUpdate += GetWorld()->GetClock().GetTimeDiff();
 
   if (m_ElapsedTimeSinceUpdate < tMinStep)
-    return;
+  {
+    ref_lodScheduler.CountSkippedUpdate(m_Lod);
+    return false;
+  }
 
-  m_AnimController.Update(m_ElapsedTimeSinceUpdate, GetOwner(), m_bEnableIK);
+  const bool bGeneratePose = m_AnimController.PrepareUpdate(m_ElapsedTimeSinceUpdate, GetOwner());
   m_ElapsedTimeSinceUpdate = ezTime::MakeZero();
 
+  if (!bGeneratePose)
+    return false;
+
+  ref_lodScheduler.CountEvaluation(m_Lod, m_PoseGenerator.GetNumSampleTrackCommands());
+  return true;
+}
+
+void ezAnimationControllerComponent::FinishUpdate()
+{
+  m_AnimController.FinishUpdate(GetOwner());
+
   ezVec3 translation;
   ezAngle rotationX;
   ezAngle rotationY;
@@ -153,13 +170,36 @@ void ezAnimationControllerComponentManager::Update(const ezWorldModule::UpdateCo
     m_ComponentsToReset.Clear();
   }
 
+  m_ComponentsToBatch.Clear();
+  m_PoseGeneratorsToBatch.Clear();
+  m_LodScheduler.BeginUpdate(GetWorld());
+
   for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
   {
     ComponentType* pComponent = it;
-    if (pComponent->IsActiveAndInitialized())
+    if (!pComponent->IsActiveAndInitialized() || !pComponent->PrepareUpdate(m_LodScheduler))
+      continue;
+
+    if (pComponent->IsIKEnabled())
     {
-      pComponent->Update();
+      // the IK components are queried through messages, which can't be done in parallel
+      pComponent->m_PoseGenerator.UpdatePose(true);
+      pComponent->FinishUpdate();
     }
+    else
+    {
+      m_ComponentsToBatch.PushBack(pComponent);
+      m_PoseGeneratorsToBatch.PushBack(&pComponent->m_PoseGenerator);
+    }
+  }
+
+  m_LodScheduler.EndUpdate("Anim Graphs");
+
+  ezAnimPoseGenerator::UpdatePoses(m_PoseGeneratorsToBatch);
+
+  for (ezAnimationControllerComponent* pComponent : m_ComponentsToBatch)
+  {
+    pComponent->FinishUpdate();
   }
 }
 
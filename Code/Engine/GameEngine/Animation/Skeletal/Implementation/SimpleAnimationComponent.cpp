@@ -95,13 +95,13 @@ void ezSimpleAnimationComponent::SetNormalizedPlaybackPosition(float fPosition)
   SetUserFlag(1, true);
 }
 
-void ezSimpleAnimationComponent::Update()
+bool ezSimpleAnimationComponent::PrepareUpdate(ezAnimationLodScheduler& ref_lodScheduler)
 {
   if (!m_hSkeleton.IsValid() || !m_hAnimationClip.IsValid())
-    return;
+    return false;
 
   if (m_fSpeed == 0.0f && !GetUserFlag(1))
-    return;
+    return false;
 
   ezTime tMinStep = ezTime::MakeFromSeconds(0);
   ezVisibilityState visType = GetOwner()->GetVisibilityState();
@@ -109,21 +109,27 @@ void ezSimpleAnimationComponent::Update()
   if (visType != ezVisibilityState::Direct)
   {
     if (m_InvisibleUpdateRate == ezAnimationInvisibleUpdateRate::Pause && visType == ezVisibilityState::Invisible)
-      return;
+      return false;
 
     tMinStep = ezAnimationInvisibleUpdateRate::GetTimeStep(m_InvisibleUpdateRate);
   }
 
+  m_Lod = ref_lodScheduler.DetermineLod(GetOwner());
+  tMinStep = ezMath::Max(tMinStep, ezAnimationLod::GetTimeStep(m_Lod));
+
   m_ElapsedTimeSinceUpdate += GetWorld()->GetClock().GetTimeDiff();
 
   if (m_ElapsedTimeSinceUpdate < tMinStep)
-    return;
+  {
+    ref_lodScheduler.CountSkippedUpdate(m_Lod);
+    return false;
+  }
 
   const bool bVisible = visType != ezVisibilityState::Invisible;
 
   ezResourceLock<ezAnimationClipResource> pAnimation(m_hAnimationClip, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
   if (pAnimation.GetAcquireResult() != ezResourceAcquireResult::Final)
-    return;
+    return false;
 
   const ezTime tDiff = m_ElapsedTimeSinceUpdate;
   m_ElapsedTimeSinceUpdate = ezTime::MakeZero();
@@ -137,7 +143,7 @@ void ezSimpleAnimationComponent::Update()
   ezAnimPoseEventTrackSampleMode mode = ezAnimPoseEventTrackSampleMode::None;
 
   if (!UpdatePlaybackTime(tDiff, animDesc.m_EventTrack, mode))
-    return;
+    return false;
 
   if (animDesc.m_EventTrack.IsEmpty())
   {
@@ -146,45 +152,28 @@ void ezSimpleAnimationComponent::Update()
 
   // no need to do anything, if we can't get events and are currently invisible
   if (!bVisible && mode == ezAnimPoseEventTrackSampleMode::None && m_RootMotionMode == ezRootMotionMode::Ignore)
-    return;
+    return false;
 
   ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
   if (pSkeleton.GetAcquireResult() != ezResourceAcquireResult::Final)
-    return;
-
-  ezAnimPoseGenerator poseGen;
-  poseGen.Reset(pSkeleton.GetPointer(), GetOwner());
-
-  auto& cmdSample = poseGen.AllocCommandSampleTrack(0);
-  cmdSample.m_hAnimationClip = m_hAnimationClip;
-  cmdSample.m_fNormalizedSamplePos = m_fNormalizedPlaybackPosition;
-  cmdSample.m_fPreviousNormalizedSamplePos = fPrevPlaybackPos;
-  cmdSample.m_EventSampling = mode;
+    return false;
 
-  if (bVisible)
+  // events are only sent for visible objects, same as the pose
+  if (bVisible && mode != ezAnimPoseEventTrackSampleMode::None)
   {
-    auto& cmdL2M = poseGen.AllocCommandLocalToModelPose();
-    cmdL2M.m_pSendLocalPoseMsgTo = GetOwner();
+    // the event messages may do anything, so the event track is sampled here and not in GeneratePose()
+    m_PoseGenerator.Reset(pSkeleton.GetPointer(), GetOwner());
 
-    if (animDesc.m_bAdditive)
-    {
-      auto& cmdComb = poseGen.AllocCommandCombinePoses();
-      cmdComb.m_Inputs.PushBack(cmdSample.GetCommandID());
-      cmdComb.m_InputWeights.PushBack(1.0f);
-
-      cmdL2M.m_Inputs.PushBack(cmdComb.GetCommandID());
-    }
-    else
-    {
-      cmdL2M.m_Inputs.PushBack(cmdSample.GetCommandID());
-    }
+    auto& cmdEvents = m_PoseGenerator.AllocCommandSampleEventTrack();
+    cmdEvents.m_hAnimationClip = m_hAnimationClip;
+    cmdEvents.m_fNormalizedSamplePos = m_fNormalizedPlaybackPosition;
+    cmdEvents.m_fPreviousNormalizedSamplePos = fPrevPlaybackPos;
+    cmdEvents.m_EventSampling = mode;
 
-    ezAnimPoseGeneratorCommandID prevCmdID = cmdL2M.GetCommandID();
-    poseGen.SetFinalCommand(prevCmdID);
+    m_PoseGenerator.SetFinalCommand(cmdEvents.GetCommandID());
+    m_PoseGenerator.UpdatePose(false);
   }
 
-  poseGen.UpdatePose(m_bEnableIK);
-
   if (m_RootMotionMode != ezRootMotionMode::Ignore)
   {
     ezVec3 vRootMotion = tDiff.AsFloatInSeconds() * m_fSpeed * animDesc.m_vConstantRootMotion;
@@ -199,15 +188,53 @@ void ezSimpleAnimationComponent::Update()
     ezRootMotionMode::Apply(m_RootMotionMode, GetOwner(), vRootMotion, ezAngle(), ezAngle(), ezAngle());
   }
 
-  if (poseGen.GetCurrentPose().IsEmpty())
+  return bVisible;
+}
+
+void ezSimpleAnimationComponent::SetupPoseCommands()
+{
+  ezResourceLock<ezAnimationClipResource> pAnimation(m_hAnimationClip, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+  ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+
+  m_PoseGenerator.Reset(pSkeleton.GetPointer(), GetOwner());
+
+  auto& cmdSample = m_PoseGenerator.AllocCommandSampleTrack(0);
+  cmdSample.m_hAnimationClip = m_hAnimationClip;
+  cmdSample.m_fNormalizedSamplePos = m_fNormalizedPlaybackPosition;
+  cmdSample.m_fPreviousNormalizedSamplePos = m_fNormalizedPlaybackPosition;
+
+  auto& cmdL2M = m_PoseGenerator.AllocCommandLocalToModelPose();
+  cmdL2M.m_pSendLocalPoseMsgTo = GetOwner();
+
+  if (pAnimation->GetDescriptor().m_bAdditive)
+  {
+    auto& cmdComb = m_PoseGenerator.AllocCommandCombinePoses();
+    cmdComb.m_Inputs.PushBack(cmdSample.GetCommandID());
+    cmdComb.m_InputWeights.PushBack(1.0f);
+
+    cmdL2M.m_Inputs.PushBack(cmdComb.GetCommandID());
+  }
+  else
+  {
+    cmdL2M.m_Inputs.PushBack(cmdSample.GetCommandID());
+  }
+
+  m_PoseGenerator.SetFinalCommand(cmdL2M.GetCommandID());
+}
+
+void ezSimpleAnimationComponent::FinishUpdate()
+{
+  if (m_PoseGenerator.GetCurrentPose().IsEmpty())
     return;
 
+  ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+
   // inform child nodes/components that a new pose is available
   {
     ezMsgAnimationPoseUpdated msg2;
     msg2.m_pRootTransform = &pSkeleton->GetDescriptor().m_RootTransform;
     msg2.m_pSkeleton = &pSkeleton->GetDescriptor().m_Skeleton;
-    msg2.m_ModelTransforms = poseGen.GetCurrentPose();
+    msg2.m_ModelTransforms = m_PoseGenerator.GetCurrentPose();
 
     // recursive, so that objects below the mesh can also listen in on these changes
     // for example bone attachments
@@ -300,5 +327,58 @@ bool ezSimpleAnimationComponent::UpdatePlaybackTime(ezTime tDiff, const ezEventT
   return tPrefNorm != m_fNormalizedPlaybackPosition;
 }
 
+//////////////////////////////////////////////////////////////////////////
+
+ezSimpleAnimationComponentManager::ezSimpleAnimationComponentManager(ezWorld* pWorld)
+  : ezComponentManager<ComponentType, ezBlockStorageType::FreeList>(pWorld)
+{
+}
+
+void ezSimpleAnimationComponentManager::Initialize()
+{
+  auto desc = ezWorldModule::UpdateFunctionDesc(ezWorldModule::UpdateFunction(&ezSimpleAnimationComponentManager::Update, this), "ezSimpleAnimationComponentManager::Update");
+  desc.m_bOnlyUpdateWhenSimulating = true;
+
+  this->RegisterUpdateFunction(desc);
+}
+
+void ezSimpleAnimationComponentManager::Update(const ezWorldModule::UpdateContext& context)
+{
+  m_ComponentsToBatch.Clear();
+  m_PoseGeneratorsToBatch.Clear();
+  m_LodScheduler.BeginUpdate(GetWorld());
+
+  for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+  {
+    ComponentType* pComponent = it;
+    if (!pComponent->IsActiveAndInitialized() || !pComponent->PrepareUpdate(m_LodScheduler))
+      continue;
+
+    m_LodScheduler.CountEvaluation(pComponent->m_Lod, 1);
+
+    pComponent->SetupPoseCommands();
+
+    if (pComponent->IsIKEnabled())
+    {
+      // the IK components are queried through messages, which can't be done in parallel
+      pComponent->m_PoseGenerator.UpdatePose(true);
+      pComponent->FinishUpdate();
+    }
+    else
+    {
+      m_ComponentsToBatch.PushBack(pComponent);
+      m_PoseGeneratorsToBatch.PushBack(&pComponent->m_PoseGenerator);
+    }
+  }
+
+  m_LodScheduler.EndUpdate("Simple Animations");
+
+  ezAnimPoseGenerator::UpdatePoses(m_PoseGeneratorsToBatch);
+
+  for (ezSimpleAnimationComponent* pComponent : m_ComponentsToBatch)
+  {
+    pComponent->FinishUpdate();
+  }
+}
 
 EZ_STATICLINK_FILE(GameEngine, GameEngine_Animation_Skeletal_Implementation_SimpleAnimationComponent);
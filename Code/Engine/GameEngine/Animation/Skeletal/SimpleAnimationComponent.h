@@ -6,6 +6,7 @@
 #include <GameEngine/Animation/PropertyAnimResource.h>
 #include <GameEngine/Animation/Skeletal/AnimationControllerComponent.h>
 #include <RendererCore/AnimationSystem/AnimPoseGenerator.h>
+#include <RendererCore/AnimationSystem/AnimationLod.h>
 #include <RendererCore/AnimationSystem/AnimationPose.h>
 #include <ozz/base/containers/vector.h>
 #include <ozz/base/maths/simd_math.h>
@@ -17,7 +18,31 @@ struct ezMsgGenericEvent;
 using ezAnimationClipResourceHandle = ezTypedResourceHandle<class ezAnimationClipResource>;
 using ezSkeletonResourceHandle = ezTypedResourceHandle<class ezSkeletonResource>;
 
-using ezSimpleAnimationComponentManager = ezComponentManagerSimple<class ezSimpleAnimationComponent, ezComponentUpdateType::WhenSimulating, ezBlockStorageType::FreeList>;
+/// \brief Updates all ezSimpleAnimationComponents in one batch.
+///
+/// Playback, event tracks and root motion are updated on the calling thread, since they may affect other objects.
+/// The expensive part, sampling the animation clips and computing the model space poses, is done for all visible components together
+/// through ezAnimPoseGenerator::UpdatePoses(), which sends ezMsgAnimationPosePreparing on the calling thread in between.
+/// Afterwards the new poses are sent to the animated meshes.
+/// Components with IK enabled generate their poses on the calling thread, since IK is applied through messages.
+///
+/// The skinning matrices are still uploaded to the GPU for each animated mesh separately.
+///
+/// Components far away from the cameras are updated less often, see ezAnimationLodScheduler.
+class ezSimpleAnimationComponentManager : public ezComponentManager<class ezSimpleAnimationComponent, ezBlockStorageType::FreeList>
+{
+public:
+  ezSimpleAnimationComponentManager(ezWorld* pWorld);
+
+  virtual void Initialize() override;
+
+private:
+  void Update(const ezWorldModule::UpdateContext& context);
+
+  ezDynamicArray<ezSimpleAnimationComponent*> m_ComponentsToBatch;
+  ezDynamicArray<ezAnimPoseGenerator*> m_PoseGeneratorsToBatch;
+  ezAnimationLodScheduler m_LodScheduler;
+};
 
 /// \brief Plays a single animation clip on an animated mesh.
 ///
@@ -64,7 +89,19 @@ public:
   ezEnum<ezAnimationInvisibleUpdateRate> m_InvisibleUpdateRate; // [ property ]
 
 protected:
-  void Update();
+  friend class ezSimpleAnimationComponentManager;
+
+  /// \brief Advances the playback and applies events and root motion. Returns true, if a new pose needs to be generated.
+  bool PrepareUpdate(ezAnimationLodScheduler& ref_lodScheduler);
+
+  bool IsIKEnabled() const { return m_bEnableIK && ezAnimationLod::IsIKEnabled(m_Lod); }
+
+  /// \brief Sets up the commands of the pose generator, which then samples the animation clip and computes the new model space pose.
+  void SetupPoseCommands();
+
+  /// \brief Sends the generated pose to the animated meshes.
+  void FinishUpdate();
+
   bool UpdatePlaybackTime(ezTime tDiff, const ezEventTrack& eventTrack, ezAnimPoseEventTrackSampleMode& out_trackSampling);
 
   ezEnum<ezRootMotionMode> m_RootMotionMode;
@@ -73,6 +110,7 @@ protected:
   ezSkeletonResourceHandle m_hSkeleton;
   ezTime m_ElapsedTimeSinceUpdate = ezTime::MakeZero();
   bool m_bEnableIK = false;
+  ezAnimationLod::Enum m_Lod = ezAnimationLod::Lod0;
 
-  ozz::vector<ozz::math::SoaTransform> m_OzzLocalTransforms; // TODO: could be frame allocated
+  ezAnimPoseGenerator m_PoseGenerator; // kept alive, so that the sampling caches are reused across frames
 };
@@ -58,8 +58,18 @@ public:
 
   void Initialize(const ezSkeletonResourceHandle& hSkeleton, ezAnimPoseGenerator& ref_poseGenerator, const ezSharedPtr<ezBlackboard>& pBlackboard = nullptr);
 
+  /// \brief Evaluates the animation graphs and generates the new pose. Same as calling PrepareUpdate(), UpdatePose() on the pose generator and FinishUpdate().
   void Update(ezTime diff, ezGameObject* pTarget, bool bEnableIK);
 
+  /// \brief Evaluates the animation graphs, which set up the commands of the pose generator. Returns false, if no pose can be generated.
+  ///
+  /// Afterwards the pose generator has to execute its commands, either through ezAnimPoseGenerator::UpdatePose()
+  /// or batched with other controllers through ezAnimPoseGenerator::UpdatePoses(). Then FinishUpdate() must be called.
+  bool PrepareUpdate(ezTime diff, ezGameObject* pTarget);
+
+  /// \brief Sends the generated pose to pTarget and its children through ezMsgAnimationPoseUpdated.
+  void FinishUpdate(ezGameObject* pTarget);
+
   void GetRootMotion(ezVec3& ref_vTranslation, ezAngle& ref_rotationX, ezAngle& ref_rotationY, ezAngle& ref_rotationZ) const;
 
   const ezSharedPtr<ezBlackboard>& GetBlackboard() { return m_pBlackboard; }
@@ -49,12 +49,22 @@ void ezAnimController::GetRootMotion(ezVec3& ref_vTranslation, ezAngle& ref_rota
 
 void ezAnimController::Update(ezTime diff, ezGameObject* pTarget, bool bEnableIK)
 {
-  if (!m_hSkeleton.IsValid())
+  if (!PrepareUpdate(diff, pTarget))
     return;
 
+  GetPoseGenerator().UpdatePose(bEnableIK);
+
+  FinishUpdate(pTarget);
+}
+
+bool ezAnimController::PrepareUpdate(ezTime diff, ezGameObject* pTarget)
+{
+  if (!m_hSkeleton.IsValid())
+    return false;
+
   ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
   if (pSkeleton.GetAcquireResult() != ezResourceAcquireResult::Final)
-    return;
+    return false;
 
   m_pCurrentModelTransforms = nullptr;
 
@@ -86,7 +96,12 @@ void ezAnimController::Update(ezTime diff, ezGameObject* pTarget, bool bEnableIK
     pTarget->SendMessageRecursive(poseGenMsg);
   }
 
-  GetPoseGenerator().UpdatePose(bEnableIK);
+  return true;
+}
+
+void ezAnimController::FinishUpdate(ezGameObject* pTarget)
+{
+  ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
 
   if (auto newPose = GetPoseGenerator().GetCurrentPose(); !newPose.IsEmpty())
   {
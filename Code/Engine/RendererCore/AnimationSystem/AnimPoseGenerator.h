@@ -233,15 +233,42 @@ public:
 
   void UpdatePose(bool bRequestExternalPoseGeneration);
 
+  /// \brief Executes all commands that generate local space poses, but doesn't convert them to model space yet.
+  ///
+  /// Sends no messages, so it may be called for different pose generators in parallel. The event messages and ezMsgAnimationPosePreparing
+  /// are held back until SendPendingMessages() is called. UpdateModelPoses() then finishes the pose.
+  void UpdateLocalPoses();
+
+  /// \brief Sends the messages that UpdateLocalPoses() held back. Must be called on the thread that is allowed to modify the world.
+  void SendPendingMessages();
+
+  /// \brief Executes the remaining commands to compute the final model space pose. May be called for different pose generators in parallel.
+  void UpdateModelPoses();
+
+  /// \brief Generates the poses of all given pose generators with the same result as calling UpdatePose(false) on each of them.
+  ///
+  /// The local and model space poses are computed on multiple threads, the messages are sent on the calling thread in between.
+  static void UpdatePoses(ezArrayPtr<ezAnimPoseGenerator*> generators);
+
   ezArrayPtr<ezMat4> GetCurrentPose() const { return m_OutputPose; }
 
+  /// \brief Returns the local space pose that an already executed command has generated.
+  ///
+  /// The command must be of type ezAnimPoseGeneratorCommandSampleTrack, ezAnimPoseGeneratorCommandCombinePoses or ezAnimPoseGeneratorCommandRestPose.
+  /// The pose can still be modified before it gets converted to model space.
+  ezArrayPtr<ozz::math::SoaTransform> GetLocalPose(ezAnimPoseGeneratorCommandID id);
+
   void SetFinalCommand(ezAnimPoseGeneratorCommandID cmdId) { m_FinalCommand = cmdId; }
   ezAnimPoseGeneratorCommandID GetFinalCommand() const { return m_FinalCommand; }
 
+  /// \brief Returns how many animation clips are sampled by the current set of commands.
+  ezUInt32 GetNumSampleTrackCommands() const { return m_CommandsSampleTrack.GetCount(); }
+
 private:
   void Validate() const;
 
   void Execute(ezAnimPoseGeneratorCommand& cmd);
+  void ExecuteLocalPoses(ezAnimPoseGeneratorCommand& cmd);
   void ExecuteCmd(ezAnimPoseGeneratorCommandSampleTrack& cmd);
   void ExecuteCmd(ezAnimPoseGeneratorCommandRestPose& cmd);
   void ExecuteCmd(ezAnimPoseGeneratorCommandCombinePoses& cmd);
@@ -250,6 +277,7 @@ private:
   void ExecuteCmd(ezAnimPoseGeneratorCommandAimIK& cmd);
   void ExecuteCmd(ezAnimPoseGeneratorCommandTwoBoneIK& cmd);
   void SampleEventTrack(const ezAnimationClipResource* pResource, ezAnimPoseEventTrackSampleMode mode, float fPrevPos, float fCurPos);
+  void SendPosePreparingMsg(const ezAnimPoseGeneratorCommandLocalToModelPose& cmd, ezArrayPtr<ozz::math::SoaTransform> localTransforms);
 
   ezArrayPtr<ozz::math::SoaTransform> AcquireLocalPoseTransforms(ezAnimPoseGeneratorLocalPoseID id);
   ezArrayPtr<ezMat4> AcquireModelPoseTransforms(ezAnimPoseGeneratorModelPoseID id);
@@ -264,6 +292,11 @@ private:
 
   ezAnimPoseGeneratorCommandID m_FinalCommand = 0;
 
+  bool m_bDeferMessages = false;         ///< Set by UpdateLocalPoses(), events are stored in m_DeferredEvents instead of being sent.
+  bool m_bPosePreparingMsgsSent = false; ///< Set by UpdateModelPoses(), ezMsgAnimationPosePreparing was already sent by SendPendingMessages().
+  ezHybridArray<ezHashedString, 4> m_DeferredEvents;
+  ezHybridArray<ezAnimPoseGeneratorCommandID, 1> m_PendingLocalToModelPoses;
+
   ezHybridArray<ezArrayPtr<ozz::math::SoaTransform>, 8> m_UsedLocalTransforms;
   ezHybridArray<ezDynamicArray<ezMat4, ezAlignedAllocatorWrapper>, 2> m_UsedModelTransforms;
 
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <Foundation/Containers/HybridArray.h>
+#include <Foundation/Math/Vec3.h>
+#include <Foundation/Time/Time.h>
+#include <RendererCore/RendererCoreDLL.h>
+
+class ezWorld;
+class ezGameObject;
+
+/// \brief The animation level of detail of an animated object, depending on its distance to the closest camera.
+struct EZ_RENDERERCORE_DLL ezAnimationLod
+{
+  enum Enum : ezUInt8
+  {
+    Lod0, ///< Updated every frame with all features.
+    Lod1, ///< Updated with at most 30 FPS.
+    Lod2, ///< Updated with at most 15 FPS.
+    Lod3, ///< Updated with at most 10 FPS, IK is skipped.
+
+    ENUM_COUNT
+  };
+
+  /// \brief Returns the minimum time between two pose updates for the given LOD.
+  static ezTime GetTimeStep(ezAnimationLod::Enum lod);
+
+  /// \brief Whether IK may still be applied to poses of the given LOD.
+  static bool IsIKEnabled(ezAnimationLod::Enum lod) { return lod < Lod3; }
+};
+
+/// \brief Selects the animation LOD of animated objects and collects per-LOD statistics.
+///
+/// The LOD is determined by the distance of an object's bounds to the closest camera of all main views that show the same world.
+/// LOD 1 starts at the distance configured through the CVar 'Animation.Lod.Distance', and every following LOD starts at twice the previous distance.
+/// Objects in worlds without a main view always use LOD 0.
+///
+/// Animation component managers own one instance each. BeginUpdate() has to be called once per update before DetermineLod() is used,
+/// and EndUpdate() publishes the counted evaluations and sampled animation tracks per LOD to ezStats.
+class EZ_RENDERERCORE_DLL ezAnimationLodScheduler
+{
+public:
+  ezAnimationLodScheduler();
+
+  /// \brief Retrieves the camera positions of all main views that show the given world.
+  void BeginUpdate(const ezWorld* pWorld);
+
+  /// \brief Publishes the statistics of this update under 'Animation LOD/<world>/<szName>/...'.
+  void EndUpdate(const char* szName);
+
+  /// \brief Returns the LOD for the given object. May be called from multiple threads.
+  ezAnimationLod::Enum DetermineLod(const ezGameObject* pObject) const;
+
+  /// \brief Counts a full pose evaluation of the given LOD. Only to be called from the thread that updates the world.
+  void CountEvaluation(ezAnimationLod::Enum lod, ezUInt32 uiNumSampledTracks);
+
+  /// \brief Counts an update of the given LOD that was skipped because of the reduced update rate.
+  void CountSkippedUpdate(ezAnimationLod::Enum lod);
+
+private:
+  const ezWorld* m_pWorld = nullptr;
+  ezHybridArray<ezVec3, 4> m_CameraPositions;
+  float m_fLodDistances[ezAnimationLod::ENUM_COUNT - 1] = {};
+
+  ezUInt32 m_uiEvaluations[ezAnimationLod::ENUM_COUNT] = {};
+  ezUInt32 m_uiSampledTracks[ezAnimationLod::ENUM_COUNT] = {};
+  ezUInt32 m_uiSkippedUpdates[ezAnimationLod::ENUM_COUNT] = {};
+};
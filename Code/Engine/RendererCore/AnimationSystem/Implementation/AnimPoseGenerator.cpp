@@ -2,6 +2,7 @@
 
 #include <Core/Messages/CommonMessages.h>
 #include <Core/World/GameObject.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/AnimationSystem/AnimPoseGenerator.h>
 #include <RendererCore/AnimationSystem/AnimationClipResource.h>
 #include <RendererCore/AnimationSystem/Declarations.h>
@@ -35,6 +36,9 @@ void ezAnimPoseGenerator::Reset(const ezSkeletonResource* pSkeleton, ezGameObjec
 
   m_OutputPose.Clear();
 
+  m_DeferredEvents.Clear();
+  m_PendingLocalToModelPoses.Clear();
+
   // don't clear these arrays, they are reused
   // m_UsedModelTransforms.Clear();
   // m_SamplingCaches.Clear();
@@ -259,6 +263,113 @@ void ezAnimPoseGenerator::UpdatePose(bool bRequestExternalPoseGeneration)
   }
 }
 
+void ezAnimPoseGenerator::UpdateLocalPoses()
+{
+  if (m_FinalCommand == 0)
+    return;
+
+  Validate();
+
+  m_bDeferMessages = true;
+  ExecuteLocalPoses(GetCommand(m_FinalCommand));
+  m_bDeferMessages = false;
+}
+
+void ezAnimPoseGenerator::SendPendingMessages()
+{
+  if (m_pTargetGameObject)
+  {
+    ezMsgGenericEvent msg;
+
+    for (const auto& hs : m_DeferredEvents)
+    {
+      msg.m_sMessage = hs;
+
+      m_pTargetGameObject->SendEventMessage(msg, nullptr);
+    }
+  }
+
+  m_DeferredEvents.Clear();
+
+  for (auto id : m_PendingLocalToModelPoses)
+  {
+    const auto& cmd = static_cast<const ezAnimPoseGeneratorCommandLocalToModelPose&>(GetCommand(id));
+    SendPosePreparingMsg(cmd, GetLocalPose(cmd.m_Inputs[0]));
+  }
+
+  m_PendingLocalToModelPoses.Clear();
+}
+
+void ezAnimPoseGenerator::UpdateModelPoses()
+{
+  if (m_FinalCommand == 0)
+    return;
+
+  m_bPosePreparingMsgsSent = true;
+  Execute(GetCommand(m_FinalCommand));
+  m_bPosePreparingMsgsSent = false;
+}
+
+void ezAnimPoseGenerator::UpdatePoses(ezArrayPtr<ezAnimPoseGenerator*> generators)
+{
+  if (generators.IsEmpty())
+    return;
+
+  // each pose generator only reads the animation resources and writes its own poses
+  ezParallelForParams params;
+  params.m_uiBinSize = 8;
+
+  ezTaskSystem::ParallelForSingle(
+    generators, [](ezAnimPoseGenerator* pGenerator)
+    { pGenerator->UpdateLocalPoses(); },
+    "UpdateLocalAnimationPoses", params);
+
+  // message handlers may modify other objects, so the messages are sent on this thread between the two parallel steps
+  for (ezAnimPoseGenerator* pGenerator : generators)
+  {
+    pGenerator->SendPendingMessages();
+  }
+
+  ezTaskSystem::ParallelForSingle(
+    generators, [](ezAnimPoseGenerator* pGenerator)
+    { pGenerator->UpdateModelPoses(); },
+    "UpdateModelAnimationPoses", params);
+}
+
+void ezAnimPoseGenerator::ExecuteLocalPoses(ezAnimPoseGeneratorCommand& cmd)
+{
+  if (cmd.m_bExecuted)
+    return;
+
+  switch (cmd.GetType())
+  {
+    case ezAnimPoseGeneratorCommandType::LocalToModelPose:
+      // the conversion to model space is postponed until ezMsgAnimationPosePreparing was sent
+      if (!m_PendingLocalToModelPoses.Contains(cmd.GetCommandID()))
+      {
+        m_PendingLocalToModelPoses.PushBack(cmd.GetCommandID());
+      }
+
+      for (auto id : cmd.m_Inputs)
+      {
+        ExecuteLocalPoses(GetCommand(id));
+      }
+      break;
+
+    case ezAnimPoseGeneratorCommandType::AimIK:
+    case ezAnimPoseGeneratorCommandType::TwoBoneIK:
+      for (auto id : cmd.m_Inputs)
+      {
+        ExecuteLocalPoses(GetCommand(id));
+      }
+      break;
+
+    default:
+      Execute(cmd);
+      break;
+  }
+}
+
 void ezAnimPoseGenerator::Execute(ezAnimPoseGeneratorCommand& cmd)
 {
   if (cmd.m_bExecuted)
@@ -459,16 +570,9 @@ void ezAnimPoseGenerator::ExecuteCmd(ezAnimPoseGeneratorCommandLocalToModelPose&
   auto transform = AcquireLocalPoseTransforms(cmd.m_LocalPoseOutput);
   job.input = ozz::span<const ozz::math::SoaTransform>(transform.GetPtr(), transform.GetCount());
 
-  if (cmd.m_pSendLocalPoseMsgTo || m_pTargetGameObject)
+  if (!m_bPosePreparingMsgsSent)
   {
-    ezMsgAnimationPosePreparing msg;
-    msg.m_pSkeleton = &m_pSkeleton->GetDescriptor().m_Skeleton;
-    msg.m_LocalTransforms = ezMakeArrayPtr(const_cast<ozz::math::SoaTransform*>(job.input.data()), (ezUInt32)job.input.size());
-
-    if (m_pTargetGameObject)
-      m_pTargetGameObject->SendMessageRecursive(msg);
-    else
-      cmd.m_pSendLocalPoseMsgTo->SendMessageRecursive(msg);
+    SendPosePreparingMsg(cmd, ezMakeArrayPtr(const_cast<ozz::math::SoaTransform*>(job.input.data()), (ezUInt32)job.input.size()));
   }
 
   m_OutputPose = AcquireModelPoseTransforms(cmd.m_ModelPoseOutput);
@@ -480,6 +584,21 @@ void ezAnimPoseGenerator::ExecuteCmd(ezAnimPoseGeneratorCommandLocalToModelPose&
   job.Run();
 }
 
+void ezAnimPoseGenerator::SendPosePreparingMsg(const ezAnimPoseGeneratorCommandLocalToModelPose& cmd, ezArrayPtr<ozz::math::SoaTransform> localTransforms)
+{
+  if (cmd.m_pSendLocalPoseMsgTo == nullptr && m_pTargetGameObject == nullptr)
+    return;
+
+  ezMsgAnimationPosePreparing msg;
+  msg.m_pSkeleton = &m_pSkeleton->GetDescriptor().m_Skeleton;
+  msg.m_LocalTransforms = localTransforms;
+
+  if (m_pTargetGameObject)
+    m_pTargetGameObject->SendMessageRecursive(msg);
+  else
+    cmd.m_pSendLocalPoseMsgTo->SendMessageRecursive(msg);
+}
+
 void ezAnimPoseGenerator::ExecuteCmd(ezAnimPoseGeneratorCommandSampleEventTrack& cmd)
 {
   ezResourceLock<ezAnimationClipResource> pResource(cmd.m_hAnimationClip, ezResourceAcquireMode::BlockTillLoaded);
@@ -708,6 +827,12 @@ void ezAnimPoseGenerator::SampleEventTrack(const ezAnimationClipResource* pResou
       EZ_DEFAULT_CASE_NOT_IMPLEMENTED;
   }
 
+  if (m_bDeferMessages)
+  {
+    m_DeferredEvents.PushBackRange(events);
+    return;
+  }
+
   ezMsgGenericEvent msg;
 
   for (const auto& hs : events)
@@ -718,6 +843,28 @@ void ezAnimPoseGenerator::SampleEventTrack(const ezAnimationClipResource* pResou
   }
 }
 
+ezArrayPtr<ozz::math::SoaTransform> ezAnimPoseGenerator::GetLocalPose(ezAnimPoseGeneratorCommandID id)
+{
+  const ezAnimPoseGeneratorCommand& cmd = GetCommand(id);
+  EZ_ASSERT_DEV(cmd.m_bExecuted, "The command has to be executed before its pose can be queried.");
+
+  switch (cmd.GetType())
+  {
+    case ezAnimPoseGeneratorCommandType::SampleTrack:
+      return m_UsedLocalTransforms[static_cast<const ezAnimPoseGeneratorCommandSampleTrack&>(cmd).m_LocalPoseOutput];
+
+    case ezAnimPoseGeneratorCommandType::RestPose:
+      return m_UsedLocalTransforms[static_cast<const ezAnimPoseGeneratorCommandRestPose&>(cmd).m_LocalPoseOutput];
+
+    case ezAnimPoseGeneratorCommandType::CombinePoses:
+      return m_UsedLocalTransforms[static_cast<const ezAnimPoseGeneratorCommandCombinePoses&>(cmd).m_LocalPoseOutput];
+
+      EZ_DEFAULT_CASE_NOT_IMPLEMENTED;
+  }
+
+  return {};
+}
+
 ezArrayPtr<ozz::math::SoaTransform> ezAnimPoseGenerator::AcquireLocalPoseTransforms(ezAnimPoseGeneratorLocalPoseID id)
 {
   m_UsedLocalTransforms.EnsureCount(id + 1);
@@ -1,5 +1,6 @@
 #include <RendererCore/RendererCorePCH.h>
 
+#include <Foundation/Threading/Mutex.h>
 #include <Foundation/Utilities/AssetFileHeader.h>
 #include <RendererCore/AnimationSystem/AnimationClipResource.h>
 #include <RendererCore/AnimationSystem/AnimationPose.h>
@@ -101,6 +102,7 @@ struct ezAnimationClipResourceDescriptor::OzzImpl
     ozz::unique_ptr<ozz::animation::Animation> m_pAnim;
   };
 
+  ezMutex m_Mutex; ///< The poses of different objects are sampled in parallel, see ezAnimPoseGenerator::UpdatePoses()
   ezMap<const ezSkeletonResource*, CachedAnim> m_MappedOzzAnimations;
 };
 
@@ -256,6 +258,8 @@ EZ_FORCE_INLINE void ez2ozz(const ezQuat& qIn, ozz::math::Quaternion& ref_out)
 
 const ozz::animation::Animation& ezAnimationClipResourceDescriptor::GetMappedOzzAnimation(const ezSkeletonResource& skeleton) const
 {
+  EZ_LOCK(m_pOzzImpl->m_Mutex);
+
   auto it = m_pOzzImpl->m_MappedOzzAnimations.Find(&skeleton);
   if (it.IsValid())
   {
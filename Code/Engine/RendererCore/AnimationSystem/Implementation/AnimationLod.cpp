@@ -0,0 +1,126 @@
+#include <RendererCore/RendererCorePCH.h>
+
+#include <Core/World/World.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Utilities/Stats.h>
+#include <RendererCore/AnimationSystem/AnimationLod.h>
+#include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+
+ezCVarFloat cvar_AnimationLodDistance("Animation.Lod.Distance", 20.0f, ezCVarFlags::Default, "Distance at which animated objects start to be updated less often. Zero disables animation LODs.");
+
+ezTime ezAnimationLod::GetTimeStep(ezAnimationLod::Enum lod)
+{
+  switch (lod)
+  {
+    case ezAnimationLod::Lod0:
+      return ezTime::MakeZero();
+    case ezAnimationLod::Lod1:
+      return ezTime::MakeFromSeconds(1.0 / 30.0);
+    case ezAnimationLod::Lod2:
+      return ezTime::MakeFromSeconds(1.0 / 15.0);
+    case ezAnimationLod::Lod3:
+      return ezTime::MakeFromSeconds(1.0 / 10.0);
+
+      EZ_DEFAULT_CASE_NOT_IMPLEMENTED;
+  }
+
+  return ezTime::MakeZero();
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezAnimationLodScheduler::ezAnimationLodScheduler() = default;
+
+void ezAnimationLodScheduler::BeginUpdate(const ezWorld* pWorld)
+{
+  m_pWorld = pWorld;
+  m_CameraPositions.Clear();
+
+  const float fLodDistance = cvar_AnimationLodDistance;
+  if (fLodDistance <= 0.0f)
+    return;
+
+  for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(m_fLodDistances); ++i)
+  {
+    m_fLodDistances[i] = fLodDistance * static_cast<float>(1u << i);
+  }
+
+  for (const ezViewHandle& hView : ezRenderWorld::GetMainViews())
+  {
+    ezView* pView = nullptr;
+    if (ezRenderWorld::TryGetView(hView, pView) && pView->GetWorld() == pWorld && pView->GetCullingCamera() != nullptr)
+    {
+      m_CameraPositions.PushBack(pView->GetCullingCamera()->GetCenterPosition());
+    }
+  }
+}
+
+void ezAnimationLodScheduler::EndUpdate(const char* szName)
+{
+  if (m_pWorld == nullptr)
+    return;
+
+  ezStringBuilder sStatName;
+
+  for (ezUInt32 i = 0; i < ezAnimationLod::ENUM_COUNT; ++i)
+  {
+    sStatName.SetFormat("Animation LOD/{0}/{1}/LOD{2} Evaluated", m_pWorld->GetName(), szName, i);
+    ezStats::SetStat(sStatName, m_uiEvaluations[i]);
+
+    sStatName.SetFormat("Animation LOD/{0}/{1}/LOD{2} Sampled Tracks", m_pWorld->GetName(), szName, i);
+    ezStats::SetStat(sStatName, m_uiSampledTracks[i]);
+
+    sStatName.SetFormat("Animation LOD/{0}/{1}/LOD{2} Skipped", m_pWorld->GetName(), szName, i);
+    ezStats::SetStat(sStatName, m_uiSkippedUpdates[i]);
+
+    m_uiEvaluations[i] = 0;
+    m_uiSampledTracks[i] = 0;
+    m_uiSkippedUpdates[i] = 0;
+  }
+}
+
+ezAnimationLod::Enum ezAnimationLodScheduler::DetermineLod(const ezGameObject* pObject) const
+{
+  if (m_CameraPositions.IsEmpty())
+    return ezAnimationLod::Lod0;
+
+  ezVec3 vCenter = pObject->GetGlobalPosition();
+  float fRadius = 0.0f;
+
+  const ezBoundingBoxSphere bounds = pObject->GetGlobalBounds();
+  if (bounds.IsValid())
+  {
+    vCenter = bounds.m_vCenter;
+    fRadius = bounds.m_fSphereRadius;
+  }
+
+  float fMinDistanceSquared = ezMath::MaxValue<float>();
+  for (const ezVec3& vCameraPos : m_CameraPositions)
+  {
+    fMinDistanceSquared = ezMath::Min(fMinDistanceSquared, (vCameraPos - vCenter).GetLengthSquared());
+  }
+
+  const float fDistance = ezMath::Sqrt(fMinDistanceSquared) - fRadius;
+
+  ezUInt32 uiLod = 0;
+  while (uiLod < EZ_ARRAY_SIZE(m_fLodDistances) && fDistance >= m_fLodDistances[uiLod])
+  {
+    ++uiLod;
+  }
+
+  return static_cast<ezAnimationLod::Enum>(uiLod);
+}
+
+void ezAnimationLodScheduler::CountEvaluation(ezAnimationLod::Enum lod, ezUInt32 uiNumSampledTracks)
+{
+  m_uiEvaluations[lod]++;
+  m_uiSampledTracks[lod] += uiNumSampledTracks;
+}
+
+void ezAnimationLodScheduler::CountSkippedUpdate(ezAnimationLod::Enum lod)
+{
+  m_uiSkippedUpdates[lod]++;
+}
+
+EZ_STATICLINK_FILE(RendererCore, RendererCore_AnimationSystem_Implementation_AnimationLod);
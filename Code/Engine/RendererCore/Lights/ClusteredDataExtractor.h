@@ -7,6 +7,8 @@ struct ezPerLightData;
 struct ezPerDecalData;
 struct ezPerReflectionProbeData;
 struct ezPerClusterData;
+struct ezClusterBinningItem;
+struct ezClusterBoundingSpheres4;
 
 class ezClusteredDataCPU : public ezRenderData
 {
@@ -56,7 +58,8 @@ public:
   virtual ezResult Deserialize(ezStreamReader& inout_stream) override;
 
 private:
-  void FillItemListAndClusterData(ezClusteredDataCPU* pData);
+  void BinSlice(ezUInt32 uiSliceIndex);
+  void FillItemListAndClusterData(ezClusteredDataCPU* pData, ezUInt32 uiSliceIndex);
 
   template <ezUInt32 MaxData>
   struct TempCluster
@@ -72,7 +75,11 @@ private:
   ezDynamicArray<TempCluster<ezClusteredDataCPU::MAX_LIGHT_DATA>> m_TempLightsClusters;
   ezDynamicArray<TempCluster<ezClusteredDataCPU::MAX_DECAL_DATA>> m_TempDecalsClusters;
   ezDynamicArray<TempCluster<ezClusteredDataCPU::MAX_REFLECTION_PROBE_DATA>> m_TempReflectionProbeClusters;
-  ezDynamicArray<ezUInt32> m_TempClusterItemList;
+  ezDynamicArray<ezClusterBinningItem, ezAlignedAllocatorWrapper> m_TempLightItems;
+  ezDynamicArray<ezClusterBinningItem, ezAlignedAllocatorWrapper> m_TempDecalItems;
+  ezDynamicArray<ezClusterBinningItem, ezAlignedAllocatorWrapper> m_TempReflectionProbeItems;
+  ezDynamicArray<ezDynamicArray<ezUInt32>> m_TempSliceItemLists; ///< One item list per depth slice, so the slices can be filled in parallel.
 
   ezDynamicArray<ezSimdBSphere, ezAlignedAllocatorWrapper> m_ClusterBoundingSpheres;
+  ezDynamicArray<ezClusterBoundingSpheres4, ezAlignedAllocatorWrapper> m_ClusterBoundingSpheres4;
 };
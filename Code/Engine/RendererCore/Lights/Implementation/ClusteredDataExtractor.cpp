@@ -4,6 +4,7 @@
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/IO/TypeVersionContext.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Components/FogComponent.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/Lights/AmbientLightComponent.h>
@@ -169,10 +170,18 @@ ezClusteredDataExtractor::ezClusteredDataExtractor(const char* szName)
   m_TempDecalsClusters.SetCountUninitialized(NUM_CLUSTERS);
   m_TempReflectionProbeClusters.SetCountUninitialized(NUM_CLUSTERS);
   m_ClusterBoundingSpheres.SetCountUninitialized(NUM_CLUSTERS);
+  m_ClusterBoundingSpheres4.SetCountUninitialized(NUM_CLUSTERS / 4);
+  m_TempSliceItemLists.SetCount(NUM_CLUSTERS_Z);
 }
 
 ezClusteredDataExtractor::~ezClusteredDataExtractor() = default;
 
+namespace
+{
+  /// Below this number of lights, decals and probes binning all depth slices on one thread is cheaper than spawning tasks.
+  constexpr ezUInt32 s_uiMinParallelBinningItemCount = 32;
+} // namespace
+
 void ezClusteredDataExtractor::PostSortAndBatch(const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& ref_extractedRenderData)
 {
   EZ_PROFILE_SCOPE("PostSortAndBatch");
@@ -181,6 +190,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(const ezView& view, const ezDyna
   const float fAspectRatio = view.GetViewport().width / view.GetViewport().height;
 
   FillClusterBoundingSpheres(*pCamera, fAspectRatio, m_ClusterBoundingSpheres);
+  TransposeClusterBoundingSpheres(m_ClusterBoundingSpheres, m_ClusterBoundingSpheres4);
   ezClusteredDataCPU* pData = EZ_NEW(ezFrameAllocator::GetCurrentAllocator(), ezClusteredDataCPU);
   pData->m_ClusterData = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezPerClusterData, NUM_CLUSTERS);
 
@@ -196,7 +206,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(const ezView& view, const ezDyna
   {
     EZ_PROFILE_SCOPE("Lights");
     m_TempLightData.Clear();
-    ezMemoryUtils::ZeroFill(m_TempLightsClusters.GetData(), NUM_CLUSTERS);
+    m_TempLightItems.Clear();
 
     auto batchList = ref_extractedRenderData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::Light);
     const ezUInt32 uiBatchCount = batchList.GetBatchCount();
@@ -219,7 +229,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(const ezView& view, const ezDyna
           FillPointLightData(m_TempLightData.ExpandAndGetRef(), pPointLightRenderData);
 
           ezSimdBSphere pointLightSphere = ezSimdBSphere(ezSimdConversion::ToVec3(pPointLightRenderData->m_GlobalTransform.m_vPosition), pPointLightRenderData->m_fRange);
-          RasterizeSphere(pointLightSphere, uiLightIndex, viewMatrix, projectionMatrix, m_TempLightsClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+          PrepareSphere(pointLightSphere, uiLightIndex, viewMatrix, projectionMatrix, m_TempLightItems.ExpandAndGetRef());
 
           if (false)
           {
@@ -244,20 +254,20 @@ void ezClusteredDataExtractor::PostSortAndBatch(const ezView& view, const ezDyna
           cone.m_PositionAndRange.SetW(pSpotLightRenderData->m_fRange);
           cone.m_ForwardDir = ezSimdConversion::ToVec3(pSpotLightRenderData->m_GlobalTransform.m_qRotation * ezVec3(1.0f, 0.0f, 0.0f));
           cone.m_SinCosAngle = ezSimdVec4f(ezMath::Sin(halfAngle), ezMath::Cos(halfAngle), 0.0f);
-          RasterizeSpotLight(cone, uiLightIndex, viewMatrix, projectionMatrix, m_TempLightsClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+          PrepareSpotLight(cone, uiLightIndex, viewMatrix, projectionMatrix, m_TempLightItems.ExpandAndGetRef());
         }
         else if (auto pDirLightRenderData = ezDynamicCast<const ezDirectionalLightRenderData*>(it))
         {
           FillDirLightData(m_TempLightData.ExpandAndGetRef(), pDirLightRenderData);
 
-          RasterizeDirLight(pDirLightRenderData, uiLightIndex, m_TempLightsClusters.GetArrayPtr());
+          PrepareDirLight(uiLightIndex, m_TempLightItems.ExpandAndGetRef());
         }
         else if (auto pFillLightRenderData = ezDynamicCast<const ezFillLightRenderData*>(it))
         {
           FillFillLightData(m_TempLightData.ExpandAndGetRef(), pFillLightRenderData);
 
           ezSimdBSphere fillLightSphere = ezSimdBSphere(ezSimdConversion::ToVec3(pFillLightRenderData->m_GlobalTransform.m_vPosition), pFillLightRenderData->m_fRange);
-          RasterizeSphere(fillLightSphere, uiLightIndex, viewMatrix, projectionMatrix, m_TempLightsClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+          PrepareSphere(fillLightSphere, uiLightIndex, viewMatrix, projectionMatrix, m_TempLightItems.ExpandAndGetRef());
         }
         else if (auto pFogRenderData = ezDynamicCast<const ezFogRenderData*>(it))
         {
@@ -296,7 +306,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(const ezView& view, const ezDyna
   {
     EZ_PROFILE_SCOPE("Decals");
     m_TempDecalData.Clear();
-    ezMemoryUtils::ZeroFill(m_TempDecalsClusters.GetData(), NUM_CLUSTERS);
+    m_TempDecalItems.Clear();
 
     auto batchList = ref_extractedRenderData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::Decal);
     const ezUInt32 uiBatchCount = batchList.GetBatchCount();
@@ -318,7 +328,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(const ezView& view, const ezDyna
         {
           FillDecalData(m_TempDecalData.ExpandAndGetRef(), pDecalRenderData);
 
-          RasterizeBox(pDecalRenderData->m_GlobalTransform, uiDecalIndex, viewProjectionMatrix, m_TempDecalsClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+          PrepareBox(pDecalRenderData->m_GlobalTransform, uiDecalIndex, viewProjectionMatrix, m_TempDecalItems.ExpandAndGetRef());
         }
         else
         {
@@ -335,7 +345,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(const ezView& view, const ezDyna
   {
     EZ_PROFILE_SCOPE("Probes");
     m_TempReflectionProbeData.Clear();
-    ezMemoryUtils::ZeroFill(m_TempReflectionProbeClusters.GetData(), NUM_CLUSTERS);
+    m_TempReflectionProbeItems.Clear();
 
     auto batchList = ref_extractedRenderData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::ReflectionProbe);
     const ezUInt32 uiBatchCount = batchList.GetBatchCount();
@@ -378,8 +388,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(const ezView& view, const ezDyna
           {
             ezSimdBSphere pointLightSphere =
               ezSimdBSphere(ezSimdConversion::ToVec3(pReflectionProbeRenderData->m_GlobalTransform.m_vPosition), fMaxRadius);
-            RasterizeSphere(
-              pointLightSphere, uiProbeIndex, viewMatrix, projectionMatrix, m_TempReflectionProbeClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+            PrepareSphere(pointLightSphere, uiProbeIndex, viewMatrix, projectionMatrix, m_TempReflectionProbeItems.ExpandAndGetRef());
           }
           else
           {
@@ -390,7 +399,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(const ezView& view, const ezDyna
             // const ezBoundingBox aabb(ezVec3(-1.0f), ezVec3(1.0f));
             // ezDebugRenderer::DrawLineBox(view.GetHandle(), aabb, ezColor::DarkBlue, transform);
 
-            RasterizeBox(transform, uiProbeIndex, viewProjectionMatrix, m_TempReflectionProbeClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+            PrepareBox(transform, uiProbeIndex, viewProjectionMatrix, m_TempReflectionProbeItems.ExpandAndGetRef());
           }
         }
         else
@@ -404,7 +413,52 @@ void ezClusteredDataExtractor::PostSortAndBatch(const ezView& view, const ezDyna
     pData->m_ReflectionProbeData.CopyFrom(m_TempReflectionProbeData);
   }
 
-  FillItemListAndClusterData(pData);
+  // Binning
+  {
+    EZ_PROFILE_SCOPE("Binning");
+
+    // Depth slices don't share any clusters, so each slice is binned and gets its item list filled independently.
+    ezParallelForParams params;
+    const ezUInt32 uiNumItems = m_TempLightItems.GetCount() + m_TempDecalItems.GetCount() + m_TempReflectionProbeItems.GetCount();
+    if (uiNumItems < s_uiMinParallelBinningItemCount)
+    {
+      params.m_uiBinSize = NUM_CLUSTERS_Z;
+    }
+
+    ezTaskSystem::ParallelForIndexed(
+      0u, NUM_CLUSTERS_Z, [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        for (ezUInt32 uiSliceIndex = uiStartIndex; uiSliceIndex < uiEndIndex; ++uiSliceIndex)
+        {
+          BinSlice(uiSliceIndex);
+          FillItemListAndClusterData(pData, uiSliceIndex);
+        }
+      },
+      "ClusteredDataBinning", ezTaskNesting::Never, params);
+
+    ezUInt32 uiTotalItemCount = 0;
+    for (const auto& sliceItemList : m_TempSliceItemLists)
+    {
+      uiTotalItemCount += sliceItemList.GetCount();
+    }
+
+    pData->m_ClusterItemList = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezUInt32, uiTotalItemCount);
+
+    ezUInt32 uiSliceOffset = 0;
+    for (ezUInt32 uiSliceIndex = 0; uiSliceIndex < NUM_CLUSTERS_Z; ++uiSliceIndex)
+    {
+      const auto& sliceItemList = m_TempSliceItemLists[uiSliceIndex];
+      pData->m_ClusterItemList.GetSubArray(uiSliceOffset, sliceItemList.GetCount()).CopyFrom(sliceItemList);
+
+      const ezUInt32 uiFirstCluster = GetClusterIndexFromCoord(0, 0, uiSliceIndex);
+      for (ezUInt32 i = uiFirstCluster; i < uiFirstCluster + NUM_CLUSTERS_XY; ++i)
+      {
+        pData->m_ClusterData[i].offset += uiSliceOffset;
+      }
+
+      uiSliceOffset += sliceItemList.GetCount();
+    }
+  }
 
   ref_extractedRenderData.AddFrameData(pData);
 
@@ -441,10 +495,24 @@ namespace
   }
 } // namespace
 
-void ezClusteredDataExtractor::FillItemListAndClusterData(ezClusteredDataCPU* pData)
+void ezClusteredDataExtractor::BinSlice(ezUInt32 uiSliceIndex)
 {
-  EZ_PROFILE_SCOPE("FillItemListAndClusterData");
-  m_TempClusterItemList.Clear();
+  const ezUInt32 uiFirstCluster = GetClusterIndexFromCoord(0, 0, uiSliceIndex);
+
+  ezMemoryUtils::ZeroFill(m_TempLightsClusters.GetData() + uiFirstCluster, NUM_CLUSTERS_XY);
+  ezMemoryUtils::ZeroFill(m_TempDecalsClusters.GetData() + uiFirstCluster, NUM_CLUSTERS_XY);
+  ezMemoryUtils::ZeroFill(m_TempReflectionProbeClusters.GetData() + uiFirstCluster, NUM_CLUSTERS_XY);
+
+  BinItemsForSlice(m_TempLightItems.GetArrayPtr(), uiSliceIndex, m_ClusterBoundingSpheres4.GetData(), m_TempLightsClusters.GetData());
+  BinItemsForSlice(m_TempDecalItems.GetArrayPtr(), uiSliceIndex, m_ClusterBoundingSpheres4.GetData(), m_TempDecalsClusters.GetData());
+  BinItemsForSlice(m_TempReflectionProbeItems.GetArrayPtr(), uiSliceIndex, m_ClusterBoundingSpheres4.GetData(), m_TempReflectionProbeClusters.GetData());
+}
+
+void ezClusteredDataExtractor::FillItemListAndClusterData(ezClusteredDataCPU* pData, ezUInt32 uiSliceIndex)
+{
+  // The offsets are relative to the slice's own item list here, they are fixed up once all slice lists are concatenated.
+  ezDynamicArray<ezUInt32>& tempClusterItemList = m_TempSliceItemLists[uiSliceIndex];
+  tempClusterItemList.Clear();
 
   const ezUInt32 uiNumLights = m_TempLightData.GetCount();
   const ezUInt32 uiMaxLightBlockIndex = (uiNumLights + 31) / 32;
@@ -456,14 +524,15 @@ void ezClusteredDataExtractor::FillItemListAndClusterData(ezClusteredDataCPU* pD
   const ezUInt32 uiMaxReflectionProbeBlockIndex = (uiNumReflectionProbes + 31) / 32;
 
   const ezUInt32 uiWorstCase = ezMath::Max(uiNumLights, uiNumDecals, uiNumReflectionProbes);
-  for (ezUInt32 i = 0; i < NUM_CLUSTERS; ++i)
+  const ezUInt32 uiFirstCluster = GetClusterIndexFromCoord(0, 0, uiSliceIndex);
+  for (ezUInt32 i = uiFirstCluster; i < uiFirstCluster + NUM_CLUSTERS_XY; ++i)
   {
-    const ezUInt32 uiOffset = m_TempClusterItemList.GetCount();
+    const ezUInt32 uiOffset = tempClusterItemList.GetCount();
     ezUInt32 uiLightCount = 0;
 
-    // We expand m_TempClusterItemList by the worst case this loop can produce and then cut it down again to the actual size once we have filled the data. This makes sure we do not waste time on boundary checks or potential out of line calls like PushBack or PushBackUnchecked.
-    m_TempClusterItemList.SetCountUninitialized(uiOffset + uiWorstCase);
-    ezUInt32* pTempClusterItemListRange = m_TempClusterItemList.GetData() + uiOffset;
+    // We expand tempClusterItemList by the worst case this loop can produce and then cut it down again to the actual size once we have filled the data. This makes sure we do not waste time on boundary checks or potential out of line calls like PushBack or PushBackUnchecked.
+    tempClusterItemList.SetCountUninitialized(uiOffset + uiWorstCase);
+    ezUInt32* pTempClusterItemListRange = tempClusterItemList.GetData() + uiOffset;
 
     // Lights
     {
@@ -548,15 +617,12 @@ void ezClusteredDataExtractor::FillItemListAndClusterData(ezClusteredDataCPU* pD
 
     // Cut down the array to the actual number of elements we have written.
     const ezUInt32 uiActualCase = ezMath::Max(uiLightCount, uiDecalCount, uiReflectionProbeCount);
-    m_TempClusterItemList.SetCountUninitialized(uiOffset + uiActualCase);
+    tempClusterItemList.SetCountUninitialized(uiOffset + uiActualCase);
 
     auto& clusterData = pData->m_ClusterData[i];
     clusterData.offset = uiOffset;
     clusterData.counts = PackReflectionProbeIndex(PackIndex(uiLightCount, uiDecalCount), uiReflectionProbeCount);
   }
-
-  pData->m_ClusterItemList = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezUInt32, m_TempClusterItemList.GetCount());
-  pData->m_ClusterItemList.CopyFrom(m_TempClusterItemList);
 }
 
 
@@ -20,6 +20,48 @@ EZ_DEFINE_AS_POD_TYPE(ezPerClusterData);
 #include <Foundation/SimdMath/SimdVec4i.h>
 #include <Foundation/Utilities/GraphicsUtils.h>
 
+/// \brief The cluster bounding spheres of four neighboring clusters in x direction, stored as structure of arrays so they can be tested against an item at once.
+struct ezClusterBoundingSpheres4
+{
+  EZ_DECLARE_POD_TYPE();
+
+  ezSimdVec4f m_CenterX;
+  ezSimdVec4f m_CenterY;
+  ezSimdVec4f m_CenterZ;
+  ezSimdVec4f m_Radius;
+};
+
+static_assert(NUM_CLUSTERS_X % 4 == 0, "Cluster bounding spheres are grouped by four in x direction");
+
+/// \brief A light, decal or reflection probe shape together with the range of clusters that it covers on screen.
+///
+/// These are gathered in a serial pass and then binned into the clusters of each depth slice independently.
+struct ezClusterBinningItem
+{
+  enum class Shape : ezUInt8
+  {
+    All,
+    Sphere,
+    Cone,
+    Box
+  };
+
+  ezSimdVec4f m_CenterAndRadius; ///< Sphere center and radius, or cone position and range.
+  ezSimdVec4f m_ForwardDir;
+  ezSimdVec4f m_SinCosAngle;
+  ezSimdMat4f m_WorldToBox;
+  float m_fBoxRadiusScale = 1.0f;
+
+  ezUInt16 m_uiIndex = 0;
+  Shape m_Shape = Shape::All;
+  ezUInt8 m_uiMinX = 0;
+  ezUInt8 m_uiMaxX = NUM_CLUSTERS_X - 1;
+  ezUInt8 m_uiMinY = 0;
+  ezUInt8 m_uiMaxY = NUM_CLUSTERS_Y - 1;
+  ezUInt8 m_uiMinZ = 0;
+  ezUInt8 m_uiMaxZ = NUM_CLUSTERS_Z - 1;
+};
+
 namespace
 {
   ///\todo Make this configurable.
@@ -332,8 +374,30 @@ namespace
     return ezSimdBBox(mi, ma);
   }
 
-  template <typename Cluster, typename IntersectionFunc>
-  EZ_FORCE_INLINE void FillCluster(const ezSimdBBox& screenSpaceBounds, ezUInt32 uiBlockIndex, ezUInt32 uiMask, Cluster* pClusters, IntersectionFunc func)
+  void TransposeClusterBoundingSpheres(ezArrayPtr<const ezSimdBSphere> clusterBoundingSpheres, ezArrayPtr<ezClusterBoundingSpheres4> out_clusterBoundingSpheres4)
+  {
+    for (ezUInt32 i = 0; i < out_clusterBoundingSpheres4.GetCount(); ++i)
+    {
+      const ezSimdBSphere* pSpheres = clusterBoundingSpheres.GetPtr() + i * 4;
+
+      ezSimdVec4f s0 = pSpheres[0].m_CenterAndRadius;
+      ezSimdVec4f s1 = pSpheres[1].m_CenterAndRadius;
+      ezSimdVec4f s2 = pSpheres[2].m_CenterAndRadius;
+      ezSimdVec4f s3 = pSpheres[3].m_CenterAndRadius;
+      ezSimdVec4f xy01 = s0.GetCombined<ezSwizzle::XYXY>(s1);
+      ezSimdVec4f xy23 = s2.GetCombined<ezSwizzle::XYXY>(s3);
+      ezSimdVec4f zw01 = s0.GetCombined<ezSwizzle::ZWZW>(s1);
+      ezSimdVec4f zw23 = s2.GetCombined<ezSwizzle::ZWZW>(s3);
+
+      ezClusterBoundingSpheres4& spheres4 = out_clusterBoundingSpheres4[i];
+      spheres4.m_CenterX = xy01.GetCombined<ezSwizzle::XZXZ>(xy23);
+      spheres4.m_CenterY = xy01.GetCombined<ezSwizzle::YWYW>(xy23);
+      spheres4.m_CenterZ = zw01.GetCombined<ezSwizzle::XZXZ>(zw23);
+      spheres4.m_Radius = zw01.GetCombined<ezSwizzle::YWYW>(zw23);
+    }
+  }
+
+  EZ_FORCE_INLINE void SetClusterRange(const ezSimdBBox& screenSpaceBounds, ezClusterBinningItem& ref_item)
   {
     ezSimdVec4f scale = ezSimdVec4f(0.5f * NUM_CLUSTERS_X, -0.5f * NUM_CLUSTERS_Y, 1.0f, 1.0f);
     ezSimdVec4f bias = ezSimdVec4f(0.5f * NUM_CLUSTERS_X, 0.5f * NUM_CLUSTERS_Y, 0.0f, 0.0f);
@@ -347,43 +411,23 @@ namespace
     minXY_maxXY = minXY_maxXY.CompMin(maxClusterIndex - ezSimdVec4i(1));
     minXY_maxXY = minXY_maxXY.CompMax(ezSimdVec4i::MakeZero());
 
-    ezUInt32 xMin = minXY_maxXY.x();
-    ezUInt32 yMin = minXY_maxXY.w();
-
-    ezUInt32 xMax = minXY_maxXY.z();
-    ezUInt32 yMax = minXY_maxXY.y();
+    ref_item.m_uiMinX = static_cast<ezUInt8>(minXY_maxXY.x());
+    ref_item.m_uiMinY = static_cast<ezUInt8>(minXY_maxXY.w());
 
-    ezUInt32 zMin = GetSliceIndexFromDepth(screenSpaceBounds.m_Min.z());
-    ezUInt32 zMax = GetSliceIndexFromDepth(screenSpaceBounds.m_Max.z());
+    ref_item.m_uiMaxX = static_cast<ezUInt8>(minXY_maxXY.z());
+    ref_item.m_uiMaxY = static_cast<ezUInt8>(minXY_maxXY.y());
 
-    for (ezUInt32 z = zMin; z <= zMax; ++z)
-    {
-      for (ezUInt32 y = yMin; y <= yMax; ++y)
-      {
-        for (ezUInt32 x = xMin; x <= xMax; ++x)
-        {
-          ezUInt32 uiClusterIndex = GetClusterIndexFromCoord(x, y, z);
-          if (func(uiClusterIndex))
-          {
-            pClusters[uiClusterIndex].m_BitMask[uiBlockIndex] |= uiMask;
-          }
-        }
-      }
-    }
+    ref_item.m_uiMinZ = static_cast<ezUInt8>(GetSliceIndexFromDepth(screenSpaceBounds.m_Min.z()));
+    ref_item.m_uiMaxZ = static_cast<ezUInt8>(GetSliceIndexFromDepth(screenSpaceBounds.m_Max.z()));
   }
 
-  template <typename Cluster>
-  void RasterizeSphere(const ezSimdBSphere& pointLightSphere, ezUInt32 uiLightIndex, const ezSimdMat4f& mViewMatrix,
-    const ezSimdMat4f& mProjectionMatrix, Cluster* pClusters, ezSimdBSphere* pClusterBoundingSpheres)
+  void PrepareSphere(const ezSimdBSphere& sphere, ezUInt32 uiIndex, const ezSimdMat4f& mViewMatrix, const ezSimdMat4f& mProjectionMatrix, ezClusterBinningItem& out_item)
   {
-    ezSimdBBox screenSpaceBounds = GetScreenSpaceBounds(pointLightSphere, mViewMatrix, mProjectionMatrix);
-
-    const ezUInt32 uiBlockIndex = uiLightIndex / 32;
-    const ezUInt32 uiMask = 1 << (uiLightIndex - uiBlockIndex * 32);
+    out_item.m_Shape = ezClusterBinningItem::Shape::Sphere;
+    out_item.m_uiIndex = static_cast<ezUInt16>(uiIndex);
+    out_item.m_CenterAndRadius = sphere.m_CenterAndRadius;
 
-    FillCluster(screenSpaceBounds, uiBlockIndex, uiMask, pClusters,
-      [&](ezUInt32 uiClusterIndex)
-      { return pointLightSphere.Overlaps(pClusterBoundingSpheres[uiClusterIndex]); });
+    SetClusterRange(GetScreenSpaceBounds(sphere, mViewMatrix, mProjectionMatrix), out_item);
   }
 
   struct BoundingCone
@@ -394,9 +438,7 @@ namespace
     ezSimdVec4f m_SinCosAngle;
   };
 
-  template <typename Cluster>
-  void RasterizeSpotLight(const BoundingCone& spotLightCone, ezUInt32 uiLightIndex, const ezSimdMat4f& mViewMatrix,
-    const ezSimdMat4f& mProjectionMatrix, Cluster* pClusters, ezSimdBSphere* pClusterBoundingSpheres)
+  void PrepareSpotLight(const BoundingCone& spotLightCone, ezUInt32 uiLightIndex, const ezSimdMat4f& mViewMatrix, const ezSimdMat4f& mProjectionMatrix, ezClusterBinningItem& out_item)
   {
     ezSimdVec4f position = spotLightCone.m_PositionAndRange;
     ezSimdFloat range = spotLightCone.m_PositionAndRange.w();
@@ -419,57 +461,37 @@ namespace
     }
 
     ezSimdBSphere spotLightSphere(bSphereCenter, bSphereRadius);
-    ezSimdBBox screenSpaceBounds = GetScreenSpaceBounds(spotLightSphere, mViewMatrix, mProjectionMatrix);
 
-    const ezUInt32 uiBlockIndex = uiLightIndex / 32;
-    const ezUInt32 uiMask = 1 << (uiLightIndex - uiBlockIndex * 32);
+    out_item.m_Shape = ezClusterBinningItem::Shape::Cone;
+    out_item.m_uiIndex = static_cast<ezUInt16>(uiLightIndex);
+    out_item.m_CenterAndRadius = spotLightCone.m_PositionAndRange;
+    out_item.m_ForwardDir = forwardDir;
+    out_item.m_SinCosAngle = spotLightCone.m_SinCosAngle;
 
-    FillCluster(screenSpaceBounds, uiBlockIndex, uiMask, pClusters, [&](ezUInt32 uiClusterIndex)
-      {
-      ezSimdBSphere clusterSphere = pClusterBoundingSpheres[uiClusterIndex];
-      ezSimdFloat clusterRadius = clusterSphere.GetRadius();
-
-      ezSimdVec4f toConePos = clusterSphere.m_CenterAndRadius - position;
-      ezSimdFloat projected = forwardDir.Dot<3>(toConePos);
-      ezSimdFloat distToConeSq = toConePos.Dot<3>(toConePos);
-      ezSimdFloat distClosestP = cosAngle * (distToConeSq - projected * projected).GetSqrt() - projected * sinAngle;
-
-      bool angleCull = distClosestP > clusterRadius;
-      bool frontCull = projected > clusterRadius + range;
-      bool backCull = projected < -clusterRadius;
-
-      return !(angleCull || frontCull || backCull); });
+    SetClusterRange(GetScreenSpaceBounds(spotLightSphere, mViewMatrix, mProjectionMatrix), out_item);
   }
 
-  template <typename Cluster>
-  void RasterizeDirLight(const ezDirectionalLightRenderData* pDirLightRenderData, ezUInt32 uiLightIndex, ezArrayPtr<Cluster> clusters)
+  void PrepareDirLight(ezUInt32 uiLightIndex, ezClusterBinningItem& out_item)
   {
-    const ezUInt32 uiBlockIndex = uiLightIndex / 32;
-    const ezUInt32 uiMask = 1 << (uiLightIndex - uiBlockIndex * 32);
-
-    for (ezUInt32 i = 0; i < clusters.GetCount(); ++i)
-    {
-      clusters[i].m_BitMask[uiBlockIndex] |= uiMask;
-    }
+    out_item = ezClusterBinningItem();
+    out_item.m_uiIndex = static_cast<ezUInt16>(uiLightIndex);
   }
 
-  template <typename Cluster>
-  void RasterizeBox(const ezTransform& transform, ezUInt32 uiDecalIndex, const ezSimdMat4f& mViewProjectionMatrix, Cluster* pClusters,
-    ezSimdBSphere* pClusterBoundingSpheres)
+  void PrepareBox(const ezTransform& transform, ezUInt32 uiIndex, const ezSimdMat4f& mViewProjectionMatrix, ezClusterBinningItem& out_item)
   {
-    ezSimdMat4f decalToWorld = ezSimdConversion::ToTransform(transform).GetAsMat4();
-    ezSimdMat4f worldToDecal = decalToWorld.GetInverse();
+    ezSimdMat4f boxToWorld = ezSimdConversion::ToTransform(transform).GetAsMat4();
+    ezSimdMat4f worldToBox = boxToWorld.GetInverse();
 
     ezVec3 corners[8];
     ezBoundingBox::MakeFromMinMax(ezVec3(-1), ezVec3(1)).GetCorners(corners);
 
-    ezSimdMat4f decalToScreen = mViewProjectionMatrix * decalToWorld;
+    ezSimdMat4f boxToScreen = mViewProjectionMatrix * boxToWorld;
     ezSimdBBox screenSpaceBounds = ezSimdBBox::MakeInvalid();
     bool bInsideBox = false;
     for (ezUInt32 i = 0; i < 8; ++i)
     {
       ezSimdVec4f corner = ezSimdConversion::ToVec3(corners[i]);
-      ezSimdVec4f screenSpaceCorner = decalToScreen.TransformPosition(corner);
+      ezSimdVec4f screenSpaceCorner = boxToScreen.TransformPosition(corner);
       ezSimdFloat depth = screenSpaceCorner.w();
       bInsideBox |= depth < ezSimdFloat::MakeZero();
 
@@ -486,17 +508,169 @@ namespace
       screenSpaceBounds.m_Max = ezSimdVec4f(1.0f).GetCombined<ezSwizzle::XYZW>(screenSpaceBounds.m_Max);
     }
 
-    ezSimdVec4f decalHalfExtents = ezSimdVec4f(1.0f);
-    ezSimdBBox localDecalBounds = ezSimdBBox(-decalHalfExtents, decalHalfExtents);
+    // same as ezSimdBSphere::Transform, the cluster radius is scaled by the largest axis scale of the matrix
+    ezSimdFloat maxScaleSq = worldToBox.m_col0.Dot<3>(worldToBox.m_col0);
+    maxScaleSq = maxScaleSq.Max(worldToBox.m_col1.Dot<3>(worldToBox.m_col1));
+    maxScaleSq = maxScaleSq.Max(worldToBox.m_col2.Dot<3>(worldToBox.m_col2));
+
+    out_item.m_Shape = ezClusterBinningItem::Shape::Box;
+    out_item.m_uiIndex = static_cast<ezUInt16>(uiIndex);
+    out_item.m_WorldToBox = worldToBox;
+    out_item.m_fBoxRadiusScale = maxScaleSq.GetSqrt();
 
-    const ezUInt32 uiBlockIndex = uiDecalIndex / 32;
-    const ezUInt32 uiMask = 1 << (uiDecalIndex - uiBlockIndex * 32);
+    SetClusterRange(screenSpaceBounds, out_item);
+  }
 
-    FillCluster(screenSpaceBounds, uiBlockIndex, uiMask, pClusters, [&](ezUInt32 uiClusterIndex)
+  EZ_ALWAYS_INLINE ezUInt32 GetLaneMask(const ezSimdVec4b& v)
+  {
+    return (v.x() ? 1u : 0u) | (v.y() ? 2u : 0u) | (v.z() ? 4u : 0u) | (v.w() ? 8u : 0u);
+  }
+
+  /// \brief Tests the item against four clusters at a time for all clusters of the given slice that are within the item's screen space range.
+  template <typename Cluster, typename IntersectionFunc>
+  EZ_FORCE_INLINE void BinItem(const ezClusterBinningItem& item, ezUInt32 uiSliceIndex, const ezClusterBoundingSpheres4* pClusterBoundingSpheres4, Cluster* pClusters, IntersectionFunc func)
+  {
+    const ezUInt32 uiBlockIndex = item.m_uiIndex / 32;
+    const ezUInt32 uiMask = 1 << (item.m_uiIndex - uiBlockIndex * 32);
+
+    const ezUInt32 uiMinGroup = item.m_uiMinX / 4;
+    const ezUInt32 uiMaxGroup = item.m_uiMaxX / 4;
+
+    for (ezUInt32 y = item.m_uiMinY; y <= item.m_uiMaxY; ++y)
+    {
+      const ezUInt32 uiRowStart = GetClusterIndexFromCoord(0, y, uiSliceIndex);
+
+      for (ezUInt32 uiGroup = uiMinGroup; uiGroup <= uiMaxGroup; ++uiGroup)
       {
-      ezSimdBSphere clusterSphere = pClusterBoundingSpheres[uiClusterIndex];
-      clusterSphere.Transform(worldToDecal);
+        const ezUInt32 uiFirstX = uiGroup * 4;
+        const ezUInt32 uiLo = ezMath::Max<ezUInt32>(item.m_uiMinX, uiFirstX) - uiFirstX;
+        const ezUInt32 uiHi = ezMath::Min<ezUInt32>(item.m_uiMaxX, uiFirstX + 3) - uiFirstX;
+        const ezUInt32 uiRangeMask = ((2u << uiHi) - 1u) & ~((1u << uiLo) - 1u);
+
+        const ezUInt32 uiClusterIndex = uiRowStart + uiFirstX;
+        ezUInt32 uiHitMask = GetLaneMask(func(pClusterBoundingSpheres4[uiClusterIndex / 4])) & uiRangeMask;
 
-      return localDecalBounds.Overlaps(clusterSphere); });
+        while (uiHitMask != 0)
+        {
+          const ezUInt32 uiLane = ezMath::FirstBitLow(uiHitMask);
+          uiHitMask &= uiHitMask - 1;
+
+          pClusters[uiClusterIndex + uiLane].m_BitMask[uiBlockIndex] |= uiMask;
+        }
+      }
+    }
+  }
+
+  /// \brief Sets the bits of all items that overlap a cluster in the given depth slice. Only touches the clusters of that slice, so different slices can be binned in parallel.
+  template <typename Cluster>
+  void BinItemsForSlice(ezArrayPtr<const ezClusterBinningItem> items, ezUInt32 uiSliceIndex, const ezClusterBoundingSpheres4* pClusterBoundingSpheres4, Cluster* pClusters)
+  {
+    for (const ezClusterBinningItem& item : items)
+    {
+      if (uiSliceIndex < item.m_uiMinZ || uiSliceIndex > item.m_uiMaxZ)
+        continue;
+
+      switch (item.m_Shape)
+      {
+        case ezClusterBinningItem::Shape::All:
+        {
+          const ezUInt32 uiBlockIndex = item.m_uiIndex / 32;
+          const ezUInt32 uiMask = 1 << (item.m_uiIndex - uiBlockIndex * 32);
+
+          Cluster* pSliceClusters = pClusters + GetClusterIndexFromCoord(0, 0, uiSliceIndex);
+          for (ezUInt32 i = 0; i < NUM_CLUSTERS_XY; ++i)
+          {
+            pSliceClusters[i].m_BitMask[uiBlockIndex] |= uiMask;
+          }
+        }
+        break;
+
+        case ezClusterBinningItem::Shape::Sphere:
+        {
+          const ezSimdVec4f centerX = item.m_CenterAndRadius.Get<ezSwizzle::XXXX>();
+          const ezSimdVec4f centerY = item.m_CenterAndRadius.Get<ezSwizzle::YYYY>();
+          const ezSimdVec4f centerZ = item.m_CenterAndRadius.Get<ezSwizzle::ZZZZ>();
+          const ezSimdVec4f radius = item.m_CenterAndRadius.Get<ezSwizzle::WWWW>();
+
+          BinItem(item, uiSliceIndex, pClusterBoundingSpheres4, pClusters, [&](const ezClusterBoundingSpheres4& clusters)
+            {
+            const ezSimdVec4f dx = clusters.m_CenterX - centerX;
+            const ezSimdVec4f dy = clusters.m_CenterY - centerY;
+            const ezSimdVec4f dz = clusters.m_CenterZ - centerZ;
+            const ezSimdVec4f distSq = ezSimdVec4f::MulAdd(dz, dz, ezSimdVec4f::MulAdd(dy, dy, dx.CompMul(dx)));
+            const ezSimdVec4f radii = clusters.m_Radius + radius;
+
+            return distSq < radii.CompMul(radii); });
+        }
+        break;
+
+        case ezClusterBinningItem::Shape::Cone:
+        {
+          const ezSimdVec4f positionX = item.m_CenterAndRadius.Get<ezSwizzle::XXXX>();
+          const ezSimdVec4f positionY = item.m_CenterAndRadius.Get<ezSwizzle::YYYY>();
+          const ezSimdVec4f positionZ = item.m_CenterAndRadius.Get<ezSwizzle::ZZZZ>();
+          const ezSimdVec4f range = item.m_CenterAndRadius.Get<ezSwizzle::WWWW>();
+          const ezSimdVec4f forwardX = item.m_ForwardDir.Get<ezSwizzle::XXXX>();
+          const ezSimdVec4f forwardY = item.m_ForwardDir.Get<ezSwizzle::YYYY>();
+          const ezSimdVec4f forwardZ = item.m_ForwardDir.Get<ezSwizzle::ZZZZ>();
+          const ezSimdVec4f sinAngle = item.m_SinCosAngle.Get<ezSwizzle::XXXX>();
+          const ezSimdVec4f cosAngle = item.m_SinCosAngle.Get<ezSwizzle::YYYY>();
+
+          BinItem(item, uiSliceIndex, pClusterBoundingSpheres4, pClusters, [&](const ezClusterBoundingSpheres4& clusters)
+            {
+            const ezSimdVec4f dx = clusters.m_CenterX - positionX;
+            const ezSimdVec4f dy = clusters.m_CenterY - positionY;
+            const ezSimdVec4f dz = clusters.m_CenterZ - positionZ;
+
+            const ezSimdVec4f projected = ezSimdVec4f::MulAdd(dz, forwardZ, ezSimdVec4f::MulAdd(dy, forwardY, dx.CompMul(forwardX)));
+            const ezSimdVec4f distToConeSq = ezSimdVec4f::MulAdd(dz, dz, ezSimdVec4f::MulAdd(dy, dy, dx.CompMul(dx)));
+            const ezSimdVec4f distToAxisSq = (distToConeSq - projected.CompMul(projected)).CompMax(ezSimdVec4f::MakeZero());
+            const ezSimdVec4f distClosestP = cosAngle.CompMul(distToAxisSq.GetSqrt()) - projected.CompMul(sinAngle);
+
+            const ezSimdVec4b angleCull = distClosestP > clusters.m_Radius;
+            const ezSimdVec4b frontCull = projected > clusters.m_Radius + range;
+            const ezSimdVec4b backCull = projected < -clusters.m_Radius;
+
+            return !(angleCull || frontCull || backCull); });
+        }
+        break;
+
+        case ezClusterBinningItem::Shape::Box:
+        {
+          // broadcast all elements of the upper 3 rows of the matrix, so four cluster centers can be transformed at once
+          const ezSimdVec4f* cols[4] = {&item.m_WorldToBox.m_col0, &item.m_WorldToBox.m_col1, &item.m_WorldToBox.m_col2, &item.m_WorldToBox.m_col3};
+          ezSimdVec4f m[3][4];
+          for (ezUInt32 r = 0; r < 3; ++r)
+          {
+            for (ezUInt32 c = 0; c < 4; ++c)
+            {
+              m[r][c] = ezSimdVec4f(cols[c]->GetComponent(r));
+            }
+          }
+
+          const ezSimdVec4f radiusScale = ezSimdVec4f(item.m_fBoxRadiusScale);
+          const ezSimdVec4f one = ezSimdVec4f(1.0f);
+          const ezSimdVec4f negOne = ezSimdVec4f(-1.0f);
+
+          BinItem(item, uiSliceIndex, pClusterBoundingSpheres4, pClusters, [&](const ezClusterBoundingSpheres4& clusters)
+            {
+            // transform the cluster spheres into box space and check whether the closest point of the unit box is inside the sphere
+            ezSimdVec4f distSq = ezSimdVec4f::MakeZero();
+            for (ezUInt32 r = 0; r < 3; ++r)
+            {
+              ezSimdVec4f c = ezSimdVec4f::MulAdd(clusters.m_CenterX, m[r][0], m[r][3]);
+              c = ezSimdVec4f::MulAdd(clusters.m_CenterY, m[r][1], c);
+              c = ezSimdVec4f::MulAdd(clusters.m_CenterZ, m[r][2], c);
+
+              const ezSimdVec4f d = c.CompMin(one).CompMax(negOne) - c;
+              distSq = ezSimdVec4f::MulAdd(d, d, distSq);
+            }
+
+            const ezSimdVec4f radius = clusters.m_Radius.CompMul(radiusScale);
+            return distSq <= radius.CompMul(radius); });
+        }
+        break;
+      }
+    }
   }
 } // namespace
@@ -28,6 +28,7 @@ EZ_BEGIN_COMPONENT_TYPE(ezPointLightComponent, 3, ezComponentMode::Static)
   {
     new ezSphereManipulatorAttribute("Range"),
     new ezPointLightVisualizerAttribute("Range", "Intensity", "LightColor"),
+    new ezThreadSafeExtractionAttribute(),
   }
   EZ_END_ATTRIBUTES;
 }
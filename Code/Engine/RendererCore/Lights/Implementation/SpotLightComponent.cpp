@@ -34,6 +34,7 @@ EZ_BEGIN_COMPONENT_TYPE(ezSpotLightComponent, 3, ezComponentMode::Static)
     new ezConeLengthManipulatorAttribute("Range"),
     new ezConeAngleManipulatorAttribute("OuterSpotAngle", 1.5f),
     new ezConeAngleManipulatorAttribute("InnerSpotAngle", 1.5f),
+    new ezThreadSafeExtractionAttribute(),
   }
   EZ_END_ATTRIBUTES;
 }
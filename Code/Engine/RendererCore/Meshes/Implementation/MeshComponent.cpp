@@ -22,6 +22,11 @@ EZ_BEGIN_COMPONENT_TYPE(ezMeshComponent, 3, ezComponentMode::Static)
     EZ_MESSAGE_HANDLER(ezMsgExtractGeometry, OnMsgExtractGeometry)
   }
   EZ_END_MESSAGEHANDLERS;
+  EZ_BEGIN_ATTRIBUTES
+  {
+    new ezThreadSafeExtractionAttribute(),
+  }
+  EZ_END_ATTRIBUTES;
 }
 EZ_END_COMPONENT_TYPE
 // clang-format on
@@ -29,6 +34,22 @@ EZ_END_COMPONENT_TYPE
 ezMeshComponent::ezMeshComponent() = default;
 ezMeshComponent::~ezMeshComponent() = default;
 
+bool ezMeshComponent::CopyDeserializedState(const ezComponent& other)
+{
+  // derived component types deserialize additional data
+  if (GetDynamicRTTI() != ezGetStaticRTTI<ezMeshComponent>())
+    return false;
+
+  const ezMeshComponent& otherMesh = static_cast<const ezMeshComponent&>(other);
+  m_hMesh = otherMesh.m_hMesh;
+  m_Materials = otherMesh.m_Materials;
+  m_Color = otherMesh.m_Color;
+  m_fSortingDepthOffset = otherMesh.m_fSortingDepthOffset;
+  m_vCustomData = otherMesh.m_vCustomData;
+
+  return true;
+}
+
 void ezMeshComponent::OnMsgExtractGeometry(ezMsgExtractGeometry& ref_msg) const
 {
   if (ref_msg.m_Mode != ezWorldGeoExtractionUtil::ExtractionMode::RenderMesh)
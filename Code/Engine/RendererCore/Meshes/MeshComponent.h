@@ -12,6 +12,12 @@ class EZ_RENDERERCORE_DLL ezMeshComponent : public ezMeshComponentBase
 {
   EZ_DECLARE_COMPONENT_TYPE(ezMeshComponent, ezMeshComponentBase, ezMeshComponentManager);
 
+  //////////////////////////////////////////////////////////////////////////
+  // ezComponent
+
+public:
+  virtual bool CopyDeserializedState(const ezComponent& other) override;
+
   //////////////////////////////////////////////////////////////////////////
   // ezMeshComponent
 
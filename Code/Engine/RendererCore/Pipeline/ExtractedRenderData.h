@@ -32,6 +32,11 @@ public:
   void AddRenderData(const ezRenderData* pRenderData, ezRenderData::Category category);
   void AddFrameData(const ezRenderData* pFrameData);
 
+  /// \brief Moves all render data that was added to ref_other into this one, ref_other is left empty.
+  ///
+  /// The sorting keys are not recomputed, so both need to use the same camera. This is used to merge the results of parallel extraction.
+  void AppendRenderData(ezExtractedRenderData& ref_other);
+
   void SortAndBatch();
 
   void Clear();
@@ -52,6 +57,7 @@ private:
   {
     ezDynamicArray<ezRenderDataBatch> m_Batches;
     ezDynamicArray<ezRenderDataBatch::SortableRenderData> m_SortableRenderData;
+    ezDynamicArray<ezRenderDataBatch::SortableRenderData> m_TempSortableRenderData; // scratch memory for the radix sort
   };
 
   ezCamera m_Camera;
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Types/UniquePtr.h>
 #include <RendererCore/Pipeline/RenderData.h>
 
 class ezStreamWriter;
@@ -32,6 +35,8 @@ protected:
   bool FilterByViewTags(const ezView& view, const ezGameObject* pObject) const;
 
   /// \brief extracts the render data for the given object.
+  ///
+  /// Can be called concurrently for different objects, as long as the components of these objects support it, see ezThreadSafeExtractionAttribute.
   void ExtractRenderData(const ezView& view, const ezGameObject* pObject, ezMsgExtractRenderData& msg, ezExtractedRenderData& extractedRenderData) const;
 
 private:
@@ -45,8 +50,8 @@ protected:
   ezHybridArray<ezHashedString, 4> m_DependsOn;
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-  mutable ezUInt32 m_uiNumCachedRenderData;
-  mutable ezUInt32 m_uiNumUncachedRenderData;
+  mutable ezAtomicInteger32 m_uiNumCachedRenderData;
+  mutable ezAtomicInteger32 m_uiNumUncachedRenderData;
 #endif
 };
 
@@ -64,6 +69,14 @@ public:
 
   virtual ezResult Serialize(ezStreamWriter& inout_stream) const override;
   virtual ezResult Deserialize(ezStreamReader& inout_stream) override;
+
+private:
+  bool CanExtractInParallel(const ezGameObject* pObject);
+  void ExtractInParallel(const ezView& view, ezExtractedRenderData& ref_extractedRenderData);
+
+  ezHashTable<const ezRTTI*, bool> m_ThreadSafeComponentTypes;
+  ezDynamicArray<const ezGameObject*> m_ParallelObjects;
+  ezDynamicArray<ezUniquePtr<ezExtractedRenderData>> m_ChunkRenderData;
 };
 
 class EZ_RENDERERCORE_DLL ezSelectedObjectsExtractorBase : public ezExtractor
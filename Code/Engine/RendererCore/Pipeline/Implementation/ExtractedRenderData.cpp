@@ -1,6 +1,8 @@
 #include <RendererCore/RendererCorePCH.h>
 
+#include <Foundation/Algorithm/Sorting.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 
 ezExtractedRenderData::ezExtractedRenderData() = default;
@@ -19,13 +21,34 @@ void ezExtractedRenderData::AddFrameData(const ezRenderData* pFrameData)
   m_FrameData.PushBack(pFrameData);
 }
 
-void ezExtractedRenderData::SortAndBatch()
+void ezExtractedRenderData::AppendRenderData(ezExtractedRenderData& ref_other)
 {
-  EZ_PROFILE_SCOPE("SortAndBatch");
+  m_DataPerCategory.EnsureCount(ref_other.m_DataPerCategory.GetCount());
+
+  for (ezUInt32 uiCategory = 0; uiCategory < ref_other.m_DataPerCategory.GetCount(); ++uiCategory)
+  {
+    auto& otherSortableRenderData = ref_other.m_DataPerCategory[uiCategory].m_SortableRenderData;
+    m_DataPerCategory[uiCategory].m_SortableRenderData.PushBackRange(otherSortableRenderData);
+
+    // keep the memory, ref_other is typically reused for the next extraction
+    otherSortableRenderData.Clear();
+  }
+}
+
+namespace
+{
+  // ezRenderDataBatch::SortableRenderData is private, therefore the helpers below are templated on it
+
+  // below this number of render data in a category a comparison sort is faster than the radix sort
+  constexpr ezUInt32 s_uiMinRadixSortCount = 256;
+
+  // below this number of render data in total the categories are sorted on the calling thread, since the tasks would cost more than they save
+  constexpr ezUInt32 s_uiMinParallelSortCount = 1024;
 
   struct RenderDataComparer
   {
-    EZ_FORCE_INLINE bool Less(const ezRenderDataBatch::SortableRenderData& a, const ezRenderDataBatch::SortableRenderData& b) const
+    template <typename SortableRenderData>
+    EZ_FORCE_INLINE bool Less(const SortableRenderData& a, const SortableRenderData& b) const
     {
       if (a.m_uiSortingKey == b.m_uiSortingKey)
       {
@@ -36,15 +59,127 @@ void ezExtractedRenderData::SortAndBatch()
     }
   };
 
+  struct BatchIdComparer
+  {
+    template <typename SortableRenderData>
+    EZ_FORCE_INLINE bool Less(const SortableRenderData& a, const SortableRenderData& b) const
+    {
+      return a.m_pRenderData->m_uiBatchId < b.m_pRenderData->m_uiBatchId;
+    }
+  };
+
+  /// \brief Sorts the data with the same order as RenderDataComparer.
+  ///
+  /// The 64-bit sorting keys are sorted with a stable LSD radix sort using 8-bit digits. All digit histograms are built in a single pass
+  /// and digits that are the same for all elements are skipped, which is common for the upper bits of the keys that
+  /// ezRenderSortingFunctions produces. Afterwards runs of equal sorting keys are ordered by batch id.
+  template <typename SortableRenderData>
+  void RadixSort(ezDynamicArray<SortableRenderData>& ref_data, ezDynamicArray<SortableRenderData>& ref_tempData)
+  {
+    const ezUInt32 uiCount = ref_data.GetCount();
+
+    ezUInt32 histograms[8][256] = {};
+    for (const auto& data : ref_data)
+    {
+      const ezUInt64 uiKey = data.m_uiSortingKey;
+      for (ezUInt32 uiDigit = 0; uiDigit < 8; ++uiDigit)
+      {
+        ++histograms[uiDigit][(uiKey >> (uiDigit * 8)) & 0xFF];
+      }
+    }
+
+    ref_tempData.SetCountUninitialized(uiCount);
+
+    SortableRenderData* pSource = ref_data.GetData();
+    SortableRenderData* pTarget = ref_tempData.GetData();
+    bool bResultInTempData = false;
+
+    for (ezUInt32 uiDigit = 0; uiDigit < 8; ++uiDigit)
+    {
+      const ezUInt32 uiShift = uiDigit * 8;
+      ezUInt32* pHistogram = histograms[uiDigit];
+
+      // all elements have the same digit, so this pass would not change the order
+      if (pHistogram[(pSource[0].m_uiSortingKey >> uiShift) & 0xFF] == uiCount)
+        continue;
+
+      ezUInt32 uiOffset = 0;
+      for (ezUInt32 i = 0; i < 256; ++i)
+      {
+        const ezUInt32 uiBucketCount = pHistogram[i];
+        pHistogram[i] = uiOffset;
+        uiOffset += uiBucketCount;
+      }
+
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        const ezUInt32 uiBucket = (pSource[i].m_uiSortingKey >> uiShift) & 0xFF;
+        pTarget[pHistogram[uiBucket]++] = pSource[i];
+      }
+
+      ezMath::Swap(pSource, pTarget);
+      bResultInTempData = !bResultInTempData;
+    }
+
+    if (bResultInTempData)
+    {
+      ref_data.Swap(ref_tempData);
+    }
+
+    // order render data with equal sorting keys by batch id
+    SortableRenderData* pData = ref_data.GetData();
+    ezUInt32 uiRunStart = 0;
+    for (ezUInt32 i = 1; i <= uiCount; ++i)
+    {
+      if (i < uiCount && pData[i].m_uiSortingKey == pData[uiRunStart].m_uiSortingKey)
+        continue;
+
+      const ezUInt32 uiRunLength = i - uiRunStart;
+      if (uiRunLength > 1)
+      {
+        ezArrayPtr<SortableRenderData> run(pData + uiRunStart, uiRunLength);
+
+        // insertion sort is stable, for long runs it gets too slow though
+        if (uiRunLength <= 16)
+          ezSorting::InsertionSort(run, BatchIdComparer());
+        else
+          ezSorting::QuickSort(run, BatchIdComparer());
+      }
+
+      uiRunStart = i;
+    }
+  }
+} // namespace
+
+void ezExtractedRenderData::SortAndBatch()
+{
+  EZ_PROFILE_SCOPE("SortAndBatch");
+
+  ezHybridArray<DataPerCategory*, 16> categoriesToSort;
+  ezUInt32 uiTotalCount = 0;
+
   for (auto& dataPerCategory : m_DataPerCategory)
   {
     if (dataPerCategory.m_SortableRenderData.IsEmpty())
       continue;
 
-    auto& data = dataPerCategory.m_SortableRenderData;
+    categoriesToSort.PushBack(&dataPerCategory);
+    uiTotalCount += dataPerCategory.m_SortableRenderData.GetCount();
+  }
+
+  auto SortAndBatchCategory = [](DataPerCategory* pDataPerCategory)
+  {
+    auto& data = pDataPerCategory->m_SortableRenderData;
 
     // Sort
-    data.Sort(RenderDataComparer());
+    if (data.GetCount() >= s_uiMinRadixSortCount)
+    {
+      RadixSort(data, pDataPerCategory->m_TempSortableRenderData);
+    }
+    else
+    {
+      data.Sort(RenderDataComparer());
+    }
 
     // Find batches
     ezUInt32 uiCurrentBatchId = data[0].m_pRenderData->m_uiBatchId;
@@ -57,7 +192,7 @@ void ezExtractedRenderData::SortAndBatch()
 
       if (pRenderData->m_uiBatchId != uiCurrentBatchId || pRenderData->GetDynamicRTTI() != pCurrentBatchType)
       {
-        dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], i - uiCurrentBatchStartIndex);
+        pDataPerCategory->m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], i - uiCurrentBatchStartIndex);
 
         uiCurrentBatchId = pRenderData->m_uiBatchId;
         uiCurrentBatchStartIndex = i;
@@ -65,7 +200,20 @@ void ezExtractedRenderData::SortAndBatch()
       }
     }
 
-    dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], data.GetCount() - uiCurrentBatchStartIndex);
+    pDataPerCategory->m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], data.GetCount() - uiCurrentBatchStartIndex);
+  };
+
+  // categories are independent of each other, so they can be sorted concurrently
+  if (categoriesToSort.GetCount() > 1 && uiTotalCount >= s_uiMinParallelSortCount)
+  {
+    ezTaskSystem::ParallelForSingle(categoriesToSort.GetArrayPtr(), SortAndBatchCategory, "SortAndBatch");
+  }
+  else
+  {
+    for (auto pDataPerCategory : categoriesToSort)
+    {
+      SortAndBatchCategory(pDataPerCategory);
+    }
   }
 }
 
@@ -4,6 +4,8 @@
 #include <Core/World/World.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/IO/TypeVersionContext.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/Extractor.h>
@@ -19,10 +21,14 @@ ezCVarBool cvar_SpatialVisDataOnlySelected("Spatial.VisData.OnlySelected", false
 ezCVarString cvar_SpatialVisDataOnlyObject("Spatial.VisData.OnlyObject", "", ezCVarFlags::Default, "When set the debug visualization is only shown for objects with the given name");
 
 ezCVarBool cvar_SpatialExtractionShowStats("Spatial.Extraction.ShowStats", false, ezCVarFlags::Default, "Display some stats of the render data extraction");
+ezCVarBool cvar_SpatialExtractionParallel("Spatial.Extraction.Parallel", true, ezCVarFlags::Default, "Extract objects with thread-safe components in parallel tasks");
 #endif
 
 namespace
 {
+  // below this number of objects per task the task overhead costs more than the parallel extraction saves
+  constexpr ezUInt32 s_uiMinObjectsPerExtractionTask = 128;
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   void VisualizeSpatialData(const ezView& view)
   {
@@ -144,6 +150,12 @@ bool ezExtractor::FilterByViewTags(const ezView& view, const ezGameObject* pObje
 
 void ezExtractor::ExtractRenderData(const ezView& view, const ezGameObject* pObject, ezMsgExtractRenderData& msg, ezExtractedRenderData& extractedRenderData) const
 {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  // counted locally, so that concurrent extraction only touches the shared counters once per object
+  ezUInt32 uiNumCachedRenderData = 0;
+  ezUInt32 uiNumUncachedRenderData = 0;
+#endif
+
   auto AddRenderDataFromMessage = [&](const ezMsgExtractRenderData& msg) {
     if (msg.m_OverrideCategory != ezInvalidRenderDataCategory)
     {
@@ -161,7 +173,7 @@ void ezExtractor::ExtractRenderData(const ezView& view, const ezGameObject* pObj
     }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-    m_uiNumUncachedRenderData += msg.m_ExtractedRenderData.GetCount();
+    uiNumUncachedRenderData += msg.m_ExtractedRenderData.GetCount();
 #endif
   };
 
@@ -197,7 +209,7 @@ void ezExtractor::ExtractRenderData(const ezView& view, const ezGameObject* pObj
           extractedRenderData.AddRenderData(cacheEntry.m_pRenderData, msg.m_OverrideCategory != ezInvalidRenderDataCategory ? msg.m_OverrideCategory : ezRenderData::Category(cacheEntry.m_uiCategory));
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-          ++m_uiNumCachedRenderData;
+          ++uiNumCachedRenderData;
 #endif
         }
         ++uiCacheIndex;
@@ -257,6 +269,14 @@ void ezExtractor::ExtractRenderData(const ezView& view, const ezGameObject* pObj
 
     AddRenderDataFromMessage(msg);
   }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (uiNumCachedRenderData > 0)
+    m_uiNumCachedRenderData.Add(uiNumCachedRenderData);
+
+  if (uiNumUncachedRenderData > 0)
+    m_uiNumUncachedRenderData.Add(uiNumUncachedRenderData);
+#endif
 }
 
 ezResult ezExtractor::Serialize(ezStreamWriter& inout_stream) const
@@ -301,11 +321,25 @@ void ezVisibleObjectsExtractor::Extract(const ezView& view, const ezDynamicArray
 
   m_uiNumCachedRenderData = 0;
   m_uiNumUncachedRenderData = 0;
+
+  const bool bParallel = cvar_SpatialExtractionParallel && visibleObjects.GetCount() >= s_uiMinObjectsPerExtractionTask * 2;
+#else
+  const bool bParallel = visibleObjects.GetCount() >= s_uiMinObjectsPerExtractionTask * 2;
 #endif
 
+  m_ParallelObjects.Clear();
+
   for (auto pObject : visibleObjects)
   {
-    ExtractRenderData(view, pObject, msg, ref_extractedRenderData);
+    // objects with thread-safe components are collected and extracted in parallel afterwards, all others are extracted right away
+    if (bParallel && CanExtractInParallel(pObject))
+    {
+      m_ParallelObjects.PushBack(pObject);
+    }
+    else
+    {
+      ExtractRenderData(view, pObject, msg, ref_extractedRenderData);
+    }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
     if (cvar_SpatialVisBounds || cvar_SpatialVisLocalBBox || cvar_SpatialVisData)
@@ -320,6 +354,11 @@ void ezVisibleObjectsExtractor::Extract(const ezView& view, const ezDynamicArray
 #endif
   }
 
+  if (!m_ParallelObjects.IsEmpty())
+  {
+    ExtractInParallel(view, ref_extractedRenderData);
+  }
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   const bool bIsMainView = (view.GetCameraUsageHint() == ezCameraUsageHint::MainView || view.GetCameraUsageHint() == ezCameraUsageHint::EditorView);
 
@@ -331,15 +370,107 @@ void ezVisibleObjectsExtractor::Extract(const ezView& view, const ezDynamicArray
 
     ezDebugRenderer::DrawInfoText(hView, ezDebugTextPlacement::TopLeft, "ExtractionStats", "Extraction Stats:");
 
-    sb.SetFormat("Num Cached Render Data: {0}", m_uiNumCachedRenderData);
+    sb.SetFormat("Num Cached Render Data: {0}", static_cast<ezInt32>(m_uiNumCachedRenderData));
     ezDebugRenderer::DrawInfoText(hView, ezDebugTextPlacement::TopLeft, "ExtractionStats", sb);
 
-    sb.SetFormat("Num Uncached Render Data: {0}", m_uiNumUncachedRenderData);
+    sb.SetFormat("Num Uncached Render Data: {0}", static_cast<ezInt32>(m_uiNumUncachedRenderData));
     ezDebugRenderer::DrawInfoText(hView, ezDebugTextPlacement::TopLeft, "ExtractionStats", sb);
   }
 #endif
 }
 
+bool ezVisibleObjectsExtractor::CanExtractInParallel(const ezGameObject* pObject)
+{
+  for (const ezComponent* pComponent : pObject->GetComponents())
+  {
+    const ezRTTI* pRtti = pComponent->GetDynamicRTTI();
+
+    bool bThreadSafe = false;
+    if (!m_ThreadSafeComponentTypes.TryGetValue(pRtti, bThreadSafe))
+    {
+      // the attribute is deliberately not inherited, since a derived type may extract differently than its base type
+      bThreadSafe = !pRtti->CanHandleMessage<ezMsgExtractRenderData>();
+      for (const ezPropertyAttribute* pAttribute : pRtti->GetAttributes())
+      {
+        bThreadSafe |= pAttribute->IsInstanceOf<ezThreadSafeExtractionAttribute>();
+      }
+
+      m_ThreadSafeComponentTypes.Insert(pRtti, bThreadSafe);
+    }
+
+    if (!bThreadSafe)
+      return false;
+  }
+
+  return true;
+}
+
+void ezVisibleObjectsExtractor::ExtractInParallel(const ezView& view, ezExtractedRenderData& ref_extractedRenderData)
+{
+  const ezUInt32 uiNumObjects = m_ParallelObjects.GetCount();
+
+  // the calling thread helps out as well
+  const ezUInt32 uiMaxNumChunks = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks) + 1;
+  const ezUInt32 uiNumChunks = ezMath::Clamp(uiNumObjects / s_uiMinObjectsPerExtractionTask, 1u, uiMaxNumChunks);
+
+  if (uiNumChunks == 1)
+  {
+    ezMsgExtractRenderData msg;
+    msg.m_pView = &view;
+
+    for (auto pObject : m_ParallelObjects)
+    {
+      ExtractRenderData(view, pObject, msg, ref_extractedRenderData);
+    }
+
+    return;
+  }
+
+  EZ_PROFILE_SCOPE("ExtractInParallel");
+
+  // every chunk extracts into its own render data, since the sorting keys are computed while adding, the camera needs to be the same
+  while (m_ChunkRenderData.GetCount() < uiNumChunks)
+  {
+    m_ChunkRenderData.PushBack(EZ_DEFAULT_NEW(ezExtractedRenderData));
+  }
+
+  for (ezUInt32 uiChunk = 0; uiChunk < uiNumChunks; ++uiChunk)
+  {
+    m_ChunkRenderData[uiChunk]->SetCamera(ref_extractedRenderData.GetCamera());
+  }
+
+  ezParallelForParams params;
+  params.m_uiBinSize = 1;
+  params.m_uiMaxTasksPerThread = 1;
+
+  ezTaskSystem::ParallelForIndexed(
+    0, uiNumChunks, [&](ezUInt32 uiStartChunk, ezUInt32 uiEndChunk)
+    {
+      ezMsgExtractRenderData msg;
+      msg.m_pView = &view;
+
+      for (ezUInt32 uiChunk = uiStartChunk; uiChunk < uiEndChunk; ++uiChunk)
+      {
+        ezExtractedRenderData& chunkRenderData = *m_ChunkRenderData[uiChunk];
+
+        const ezUInt32 uiStartObject = uiNumObjects * uiChunk / uiNumChunks;
+        const ezUInt32 uiEndObject = uiNumObjects * (uiChunk + 1) / uiNumChunks;
+
+        for (ezUInt32 i = uiStartObject; i < uiEndObject; ++i)
+        {
+          ExtractRenderData(view, m_ParallelObjects[i], msg, chunkRenderData);
+        }
+      }
+    },
+    "ExtractRenderData", ezTaskNesting::Never, params);
+
+  // merge in chunk order, so that the result doesn't depend on the scheduling
+  for (ezUInt32 uiChunk = 0; uiChunk < uiNumChunks; ++uiChunk)
+  {
+    ref_extractedRenderData.AppendRenderData(*m_ChunkRenderData[uiChunk]);
+  }
+}
+
 ezResult ezVisibleObjectsExtractor::Serialize(ezStreamWriter& inout_stream) const
 {
   EZ_SUCCEED_OR_RETURN(SUPER::Serialize(inout_stream));
@@ -1081,6 +1081,12 @@ void ezRenderPipeline::FindVisibleObjects(const ezView& view)
     sb.SetFormat("Num Objects Passed: {0}", stats.m_uiNumObjectsPassed);
     ezDebugRenderer::DrawInfoText(hView, ezDebugTextPlacement::TopLeft, "VisCulling", sb, ezColor::LimeGreen);
 
+    sb.SetFormat("Num Objects Culled: {0}", stats.m_uiNumObjectsCulled);
+    ezDebugRenderer::DrawInfoText(hView, ezDebugTextPlacement::TopLeft, "VisCulling", sb, ezColor::LimeGreen);
+
+    sb.SetFormat("Num Objects Occluded: {0}", stats.m_uiNumObjectsOccluded);
+    ezDebugRenderer::DrawInfoText(hView, ezDebugTextPlacement::TopLeft, "VisCulling", sb, ezColor::LimeGreen);
+
     // Exponential moving average for better readability.
     m_AverageCullingTime = ezMath::Lerp(m_AverageCullingTime, stats.m_TimeTaken, 0.05f);
 
@@ -1356,7 +1362,7 @@ ezRasterizerView* ezRenderPipeline::PrepareOcclusionCulling(const ezFrustum& fru
   if (!cvar_SpatialCullingOcclusionEnable)
     return nullptr;
 
-  if (!ezSystemInformation::Get().GetCpuFeatures().IsAvx1Available())
+  if (!ezRasterizerView::IsAvailable())
     return nullptr;
 
   ezRasterizerView* pRasterizer = nullptr;
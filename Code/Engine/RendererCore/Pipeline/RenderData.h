@@ -136,6 +136,16 @@ private:
   ezUInt32 m_uiNumCacheIfStatic = 0;
 };
 
+/// \brief Add this attribute to a component type to declare that its ezMsgExtractRenderData handler can be executed concurrently for different objects.
+///
+/// The extractor then extracts objects on which all components are of such types in parallel tasks. The handler may only read
+/// the state of its own component and owner object and must only access shared data in a thread-safe way.
+/// The attribute is only considered on the exact type it is added to, derived component types need to add it again.
+class EZ_RENDERERCORE_DLL ezThreadSafeExtractionAttribute : public ezPropertyAttribute
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezThreadSafeExtractionAttribute, ezPropertyAttribute);
+};
+
 struct EZ_RENDERERCORE_DLL ezMsgExtractOccluderData : public ezMessage
 {
   EZ_DECLARE_MESSAGE_TYPE(ezMsgExtractOccluderData, ezMessage);
@@ -190,8 +190,6 @@ private:
 
   mutable ezViewData m_Data;
 
-  ezInternal::RenderDataCache* m_pRenderDataCache = nullptr;
-
   ezDynamicArray<ezPermutationVar> m_PermutationVars;
   bool m_bPermutationVarsDirty = false;
 
@@ -3,6 +3,7 @@
 #include <Core/Graphics/Geometry.h>
 #include <Foundation/SimdMath/SimdVec4f.h>
 #include <RendererCore/Rasterizer/RasterizerObject.h>
+#include <RendererCore/Rasterizer/RasterizerView.h>
 #include <RendererCore/Rasterizer/Thirdparty/Occluder.h>
 #include <RendererCore/Rasterizer/Thirdparty/VectorMath.h>
 
@@ -19,6 +20,10 @@ EZ_DEFINE_AS_POD_TYPE(__m128);
 
 void ezRasterizerObject::CreateMesh(const ezGeometry& geo)
 {
+  // baking the occluder requires the same instruction sets as rasterizing it
+  if (!ezRasterizerView::IsAvailable())
+    return;
+
   ezHybridArray<__m128, 64, ezAlignedAllocatorWrapper> vertices;
   vertices.Reserve(geo.GetPolygons().GetCount() * 4);
 
@@ -5,6 +5,7 @@
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/SimdMath/SimdBBox.h>
 #include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/System/SystemInformation.h>
 #include <RendererCore/Rasterizer/RasterizerObject.h>
 #include <RendererCore/Rasterizer/RasterizerView.h>
 #include <RendererCore/Rasterizer/Thirdparty/Occluder.h>
@@ -16,6 +17,21 @@ ezCVarInt cvar_SpatialCullingOcclusionMaxOccluders("Spatial.Occlusion.MaxOcclude
 ezRasterizerView::ezRasterizerView() = default;
 ezRasterizerView::~ezRasterizerView() = default;
 
+bool ezRasterizerView::IsAvailable()
+{
+#if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
+  static const bool s_bAvailable = []()
+  {
+    const auto& cpu = ezSystemInformation::Get().GetCpuFeatures();
+    return cpu.IsAvx2Available() && cpu.IsFma3Available();
+  }();
+
+  return s_bAvailable;
+#else
+  return false;
+#endif
+}
+
 void ezRasterizerView::SetResolution(ezUInt32 uiWidth, ezUInt32 uiHeight, float fAspectRatio)
 {
   if (m_uiResolutionX != uiWidth || m_uiResolutionY != uiHeight)
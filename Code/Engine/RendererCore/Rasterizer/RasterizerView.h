@@ -20,6 +20,11 @@ public:
   ezRasterizerView();
   ~ezRasterizerView();
 
+  /// \brief Whether the software rasterizer can be used on this platform and CPU.
+  ///
+  /// The rasterizer requires AVX2 and FMA3, which is checked at runtime. If this returns false, no view should be rasterized.
+  static bool IsAvailable();
+
   /// \brief Changes the resolution of the view. Has to be called at least once before starting to render anything.
   void SetResolution(ezUInt32 uiWidth, ezUInt32 uiHeight, float fAspectRatio);
 
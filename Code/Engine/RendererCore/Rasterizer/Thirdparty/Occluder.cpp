@@ -6,6 +6,8 @@
 
 #  include "VectorMath.h"
 
+EZ_RASTERIZER_AVX2_BEGIN
+
 Occluder::~Occluder()
 {
   EZ_DELETE_RAW_BUFFER(ezFoundation::GetAlignedAllocator(), m_vertexData);
@@ -114,7 +116,8 @@ void Occluder::bake(const __m128* vertices, ezUInt32 numVertices, __m128 refMin,
   __m128 half = _mm_set1_ps(0.5f);
 
   occluder->m_packetCount = 0;
-  occluder->m_vertexData = EZ_NEW_RAW_BUFFER(ezFoundation::GetAlignedAllocator(), __m256i, orderedVertices.GetCount() * 4);
+  // GCC drops the alignment attribute of __m256i when it is used as a template argument, so EZ_NEW_RAW_BUFFER would only align to 16 bytes
+  occluder->m_vertexData = static_cast<__m256i*>(ezFoundation::GetAlignedAllocator()->Allocate(sizeof(__m256i) * orderedVertices.GetCount() * 4, 32));
 
   for (ezUInt32 i = 0; i < orderedVertices.GetCount(); i += 32)
   {
@@ -189,4 +192,6 @@ void Occluder::bake(const __m128* vertices, ezUInt32 numVertices, __m128 refMin,
   occluder->m_center = _mm_mul_ps(_mm_add_ps(max, min), _mm_set1_ps(0.5f));
 }
 
+EZ_RASTERIZER_AVX2_END
+
 #endif
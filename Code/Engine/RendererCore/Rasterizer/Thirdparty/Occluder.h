@@ -5,14 +5,32 @@
 
 #include <Foundation/Basics.h>
 
-#if EZ_ENABLED(EZ_COMPILER_MSVC_PURE) && EZ_ENABLED(EZ_PLATFORM_64BIT)
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86) && EZ_ENABLED(EZ_PLATFORM_64BIT) && (EZ_ENABLED(EZ_COMPILER_MSVC_PURE) || EZ_ENABLED(EZ_COMPILER_GCC) || EZ_ENABLED(EZ_COMPILER_CLANG))
 #  define EZ_RASTERIZER_SUPPORTED EZ_ON
 #else
 #  define EZ_RASTERIZER_SUPPORTED EZ_OFF
 #endif
 
 #if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
-#  include <intrin.h>
+#  if EZ_ENABLED(EZ_COMPILER_MSVC)
+#    include <intrin.h>
+#  else
+#    include <immintrin.h>
+#  endif
+
+// The rasterizer code uses AVX2 and FMA3 instructions. MSVC allows that without any special compiler flags,
+// GCC and Clang need the instruction sets to be enabled explicitly for the functions that use them.
+// Since the rest of the engine is not compiled with AVX2, the CPU support has to be checked at runtime (see ezRasterizerView::IsAvailable()).
+#  if EZ_ENABLED(EZ_COMPILER_MSVC)
+#    define EZ_RASTERIZER_AVX2_BEGIN
+#    define EZ_RASTERIZER_AVX2_END
+#  elif EZ_ENABLED(EZ_COMPILER_CLANG)
+#    define EZ_RASTERIZER_AVX2_BEGIN _Pragma("clang attribute push(__attribute__((target(\"avx,avx2,fma\"))), apply_to = function)")
+#    define EZ_RASTERIZER_AVX2_END _Pragma("clang attribute pop")
+#  else
+#    define EZ_RASTERIZER_AVX2_BEGIN _Pragma("GCC push_options") _Pragma("GCC target(\"avx,avx2,fma\")")
+#    define EZ_RASTERIZER_AVX2_END _Pragma("GCC pop_options")
+#  endif
 #endif
 
 #if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
@@ -32,7 +50,7 @@ struct Occluder
   __m128 m_boundsMax;
 
   __m256i* m_vertexData = nullptr;
-  uint32_t m_packetCount;
+  uint32_t m_packetCount = 0;
 };
 #else
 
@@ -11,6 +11,8 @@ static constexpr float floatCompressionBias = 2.5237386e-29f; // 0xFFFF << 12 re
 static constexpr float minEdgeOffset = -0.45f;
 static const float maxInvW = std::sqrt(std::numeric_limits<float>::max());
 
+EZ_RASTERIZER_AVX2_BEGIN
+
 static constexpr int OFFSET_QUANTIZATION_BITS = 6;
 static constexpr int OFFSET_QUANTIZATION_FACTOR = 1 << OFFSET_QUANTIZATION_BITS;
 
@@ -635,7 +637,7 @@ void Rasterizer::readBackDepth(void* target) const
   }
 }
 
-__forceinline float Rasterizer::decompressFloat(uint16_t depth)
+EZ_FORCE_INLINE float Rasterizer::decompressFloat(uint16_t depth)
 {
   const float bias = 3.9623753e+28f; // 1.0f / floatCompressionBias
 
@@ -693,7 +695,7 @@ __forceinline float Rasterizer::decompressFloat(uint16_t depth)
     }
 
 template <bool possiblyNearClipped>
-__forceinline void Rasterizer::normalizeEdge(__m256& nx, __m256& ny, __m256 edgeFlipMask)
+EZ_FORCE_INLINE void Rasterizer::normalizeEdge(__m256& nx, __m256& ny, __m256 edgeFlipMask)
 {
   __m256 minusZero = _mm256_set1_ps(-0.0f);
   __m256 invLen = _mm256_rcp_ps(_mm256_add_ps(_mm256_andnot_ps(minusZero, nx), _mm256_andnot_ps(minusZero, ny)));
@@ -710,7 +712,7 @@ __forceinline void Rasterizer::normalizeEdge(__m256& nx, __m256& ny, __m256 edge
   ny = _mm256_mul_ps(ny, invLen);
 }
 
-__forceinline __m128i Rasterizer::quantizeSlopeLookup(__m128 nx, __m128 ny)
+EZ_FORCE_INLINE __m128i Rasterizer::quantizeSlopeLookup(__m128 nx, __m128 ny)
 {
   __m128i yNeg = _mm_castps_si128(_mm_cmplt_ps(ny, _mm_setzero_ps()));
 
@@ -722,7 +724,7 @@ __forceinline __m128i Rasterizer::quantizeSlopeLookup(__m128 nx, __m128 ny)
   return _mm_slli_epi32(_mm_sub_epi32(_mm_slli_epi32(quantizedSlope, 1), yNeg), OFFSET_QUANTIZATION_BITS);
 }
 
-__forceinline __m256i Rasterizer::quantizeSlopeLookup(__m256 nx, __m256 ny)
+EZ_FORCE_INLINE __m256i Rasterizer::quantizeSlopeLookup(__m256 nx, __m256 ny)
 {
   __m256i yNeg = _mm256_castps_si256(_mm256_cmp_ps(ny, _mm256_setzero_ps(), _CMP_LE_OQ));
 
@@ -736,7 +738,7 @@ __forceinline __m256i Rasterizer::quantizeSlopeLookup(__m256 nx, __m256 ny)
 }
 
 
-__forceinline uint32_t Rasterizer::quantizeOffsetLookup(float offset)
+EZ_FORCE_INLINE uint32_t Rasterizer::quantizeOffsetLookup(float offset)
 {
   const float maxOffset = -minEdgeOffset;
 
@@ -748,18 +750,18 @@ __forceinline uint32_t Rasterizer::quantizeOffsetLookup(float offset)
   return std::min(std::max(int32_t(lookup), 0), OFFSET_QUANTIZATION_FACTOR - 1);
 }
 
-__forceinline __m128i Rasterizer::packDepthPremultiplied(__m128 depthA, __m128 depthB)
+EZ_FORCE_INLINE __m128i Rasterizer::packDepthPremultiplied(__m128 depthA, __m128 depthB)
 {
   return _mm_packus_epi32(_mm_srai_epi32(_mm_castps_si128(depthA), 12), _mm_srai_epi32(_mm_castps_si128(depthB), 12));
 }
 
-__forceinline __m128i Rasterizer::packDepthPremultiplied(__m256 depth)
+EZ_FORCE_INLINE __m128i Rasterizer::packDepthPremultiplied(__m256 depth)
 {
   __m256i x = _mm256_srai_epi32(_mm256_castps_si256(depth), 12);
   return _mm_packus_epi32(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1));
 }
 
-__forceinline __m256i Rasterizer::packDepthPremultiplied(__m256 depthA, __m256 depthB)
+EZ_FORCE_INLINE __m256i Rasterizer::packDepthPremultiplied(__m256 depthA, __m256 depthB)
 {
   __m256i x1 = _mm256_srai_epi32(_mm256_castps_si256(depthA), 12);
   __m256i x2 = _mm256_srai_epi32(_mm256_castps_si256(depthB), 12);
@@ -842,12 +844,12 @@ void Rasterizer::precomputeRasterizationTable()
 
     if (m_precomputedRasterTables[slopeLookup] != -1)
     {
-      __debugbreak();
+      EZ_DEBUG_BREAK;
     }
 
     if (m_precomputedRasterTables[slopeLookup + OFFSET_QUANTIZATION_FACTOR - 1] != 0)
     {
-      __debugbreak();
+      EZ_DEBUG_BREAK;
     }
   }
 }
@@ -1311,20 +1313,20 @@ void Rasterizer::rasterize(const Occluder& occluder)
     uint32_t rangesY[8];
     _mm256_storeu_si256(reinterpret_cast<__m256i*>(rangesY), rangeY);
 
-    // Transpose into AoS
-    __m128 depthPlane[8];
+    // Transpose into AoS, the arrays must be 32 byte aligned for the AVX stores
+    alignas(32) __m128 depthPlane[8];
     transpose256(depthPlane0, depthPlane1, depthPlane2, _mm256_setzero_ps(), depthPlane);
 
-    __m128 edgeNormalsX[8];
+    alignas(32) __m128 edgeNormalsX[8];
     transpose256(edgeNormalsX0, edgeNormalsX1, edgeNormalsX2, edgeNormalsX3, edgeNormalsX);
 
-    __m128 edgeNormalsY[8];
+    alignas(32) __m128 edgeNormalsY[8];
     transpose256(edgeNormalsY0, edgeNormalsY1, edgeNormalsY2, edgeNormalsY3, edgeNormalsY);
 
-    __m128 edgeOffsets[8];
+    alignas(32) __m128 edgeOffsets[8];
     transpose256(edgeOffsets0, edgeOffsets1, edgeOffsets2, edgeOffsets3, edgeOffsets);
 
-    __m128i slopeLookups[8];
+    alignas(32) __m128i slopeLookups[8];
     transpose256i(slopeLookups0, slopeLookups1, slopeLookups2, slopeLookups3, slopeLookups);
 
     uint32_t validMask = _mm256_movemask_ps(_mm256_castsi256_ps(primitiveValid));
@@ -1335,9 +1337,10 @@ void Rasterizer::rasterize(const Occluder& occluder)
     __m128i* pDepthBuffer = &*m_depthBuffer.begin();
 
     // Loop over set bits
-    unsigned long primitiveIdx;
-    while (_BitScanForward(&primitiveIdx, validMask))
+    while (validMask != 0)
     {
+      const uint32_t primitiveIdx = ezMath::FirstBitLow(validMask);
+
       // Clear lowest set bit in mask
       validMask &= validMask - 1;
 
@@ -1547,4 +1550,6 @@ void Rasterizer::rasterize(const Occluder& occluder)
 template void Rasterizer::rasterize<true>(const Occluder& occluder);
 template void Rasterizer::rasterize<false>(const Occluder& occluder);
 
+EZ_RASTERIZER_AVX2_END
+
 #endif
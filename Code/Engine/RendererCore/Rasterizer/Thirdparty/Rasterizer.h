@@ -79,7 +79,34 @@ private:
   float m_modelViewProjectionRaw[16];
 
   static std::vector<int64_t> m_precomputedRasterTables;
-  std::vector<__m128i> m_depthBuffer;
+  /// The depth buffer is written with 256 bit aligned stores, std::allocator only guarantees 16 byte alignment.
+  template <typename T>
+  struct AlignedAllocator
+  {
+    using value_type = T;
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U>&)
+    {
+    }
+
+    T* allocate(size_t n) { return static_cast<T*>(ezFoundation::GetAlignedAllocator()->Allocate(n * sizeof(T), 32)); }
+    void deallocate(T* p, size_t) { ezFoundation::GetAlignedAllocator()->Deallocate(p); }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U>&) const
+    {
+      return true;
+    }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U>&) const
+    {
+      return false;
+    }
+  };
+
+  std::vector<__m128i, AlignedAllocator<__m128i>> m_depthBuffer;
   std::vector<uint16_t> m_hiZ;
 
   uint32_t m_width;
@@ -59,13 +59,69 @@ namespace
   static ezProxyAllocator* s_pCacheAllocator;
 
   static ezMutex s_CachedRenderDataMutex;
-  using CachedRenderDataPerComponent = ezHybridArray<const ezRenderData*, 4>;
-  static ezHashTable<ezComponentHandle, CachedRenderDataPerComponent> s_CachedRenderData;
+
+  struct CachedRenderDataPerComponent
+  {
+    ezHybridArray<const ezRenderData*, 4> m_RenderData;
+    ezUInt16 m_uiVersion = 0; ///< The component version of the owner object at the time the render data was cached.
+  };
+
+  /// Components may extract different render data depending on the camera usage hint of the view, e.g. nothing for shadow views,
+  /// so the cloned render data is kept separately per usage hint as well.
+  struct CachedRenderDataKey
+  {
+    ezComponentHandle m_hComponent;
+    ezUInt8 m_uiCameraUsageHint = 0;
+
+    bool operator==(const CachedRenderDataKey& other) const { return m_hComponent == other.m_hComponent && m_uiCameraUsageHint == other.m_uiCameraUsageHint; }
+  };
+
+  struct CachedRenderDataKeyHashHelper
+  {
+    static ezUInt32 Hash(const CachedRenderDataKey& key) { return ezHashingUtils::CombineHashValues32(ezHashHelper<ezComponentHandle>::Hash(key.m_hComponent), key.m_uiCameraUsageHint); }
+    static bool Equal(const CachedRenderDataKey& a, const CachedRenderDataKey& b) { return a == b; }
+  };
+
+  static ezHashTable<CachedRenderDataKey, CachedRenderDataPerComponent, CachedRenderDataKeyHashHelper> s_CachedRenderData;
   static ezDynamicArray<const ezRenderData*> s_DeletedRenderData;
 
+  /// The render data cache is shared between all views of a world with the same camera usage hint, so that e.g. all shadow views
+  /// don't have to extract static objects again that were already extracted for one of them.
+  static ezInternal::RenderDataCache* s_RenderDataCaches[EZ_MAX_WORLDS][ezCameraUsageHint::ENUM_COUNT] = {};
+
+  ezInternal::RenderDataCache* GetRenderDataCache(const ezView& view)
+  {
+    if (view.GetWorld() == nullptr)
+      return nullptr;
+
+    return s_RenderDataCaches[view.GetWorld()->GetIndex()][view.GetCameraUsageHint().GetValue()];
+  }
+
+  void DeleteCachedRenderDataForComponent(const ezComponentHandle& hComponent)
+  {
+    CachedRenderDataKey key;
+    key.m_hComponent = hComponent;
+
+    for (ezUInt32 uiCameraUsageHint = 0; uiCameraUsageHint < ezCameraUsageHint::ENUM_COUNT; ++uiCameraUsageHint)
+    {
+      key.m_uiCameraUsageHint = static_cast<ezUInt8>(uiCameraUsageHint);
+
+      CachedRenderDataPerComponent* pCachedRenderDataPerComponent = nullptr;
+      if (s_CachedRenderData.TryGetValue(key, pCachedRenderDataPerComponent))
+      {
+        for (auto pCachedRenderData : pCachedRenderDataPerComponent->m_RenderData)
+        {
+          s_DeletedRenderData.PushBack(pCachedRenderData);
+        }
+
+        s_CachedRenderData.Remove(key);
+      }
+    }
+  }
+
   enum
   {
-    MaxNumNewCacheEntries = 32
+    MaxNumNewCacheEntries = 128
   };
 
   static bool s_bWriteRenderPipelineDgml = false;
@@ -155,8 +211,6 @@ ezViewHandle ezRenderWorld::CreateView(const char* szName, ezView*& out_pView)
   pView->SetName(szName);
   pView->InitializePins();
 
-  pView->m_pRenderDataCache = EZ_NEW(s_pCacheAllocator, ezInternal::RenderDataCache, s_pCacheAllocator);
-
   s_ViewCreatedEvent.Broadcast(pView);
 
   out_pView = pView;
@@ -175,8 +229,6 @@ void ezRenderWorld::DeleteView(const ezViewHandle& hView)
 
   s_ViewDeletedEvent.Broadcast(pView);
 
-  EZ_DELETE(s_pCacheAllocator, pView->m_pRenderDataCache);
-
   {
     EZ_LOCK(s_PipelinesToRebuildMutex);
 
@@ -257,18 +309,20 @@ ezArrayPtr<ezViewHandle> ezRenderWorld::GetMainViews()
 
 void ezRenderWorld::CacheRenderData(const ezView& view, const ezGameObjectHandle& hOwnerObject, const ezComponentHandle& hOwnerComponent, ezUInt16 uiComponentVersion, ezArrayPtr<ezInternal::RenderDataCacheEntry> cacheEntries)
 {
-  if (cvar_RenderingCachingStaticObjects)
+  ezInternal::RenderDataCache* pCache = GetRenderDataCache(view);
+
+  if (cvar_RenderingCachingStaticObjects && pCache != nullptr)
   {
-    ezUInt32 uiNewEntriesCount = view.m_pRenderDataCache->m_NewEntriesCount;
+    ezUInt32 uiNewEntriesCount = pCache->m_NewEntriesCount;
     if (uiNewEntriesCount >= MaxNumNewCacheEntries)
     {
       return;
     }
 
-    uiNewEntriesCount = view.m_pRenderDataCache->m_NewEntriesCount.Increment();
+    uiNewEntriesCount = pCache->m_NewEntriesCount.Increment();
     if (uiNewEntriesCount <= MaxNumNewCacheEntries)
     {
-      auto& newEntry = view.m_pRenderDataCache->m_NewEntriesPerComponent[uiNewEntriesCount - 1];
+      auto& newEntry = pCache->m_NewEntriesPerComponent[uiNewEntriesCount - 1];
       newEntry.m_hOwnerObject = hOwnerObject;
       newEntry.m_hOwnerComponent = hOwnerComponent;
       newEntry.m_Cache.m_Entries = cacheEntries;
@@ -286,10 +340,15 @@ void ezRenderWorld::DeleteAllCachedRenderData()
   {
     EZ_LOCK(s_ViewsMutex);
 
-    for (auto it = s_Views.GetIterator(); it.IsValid(); ++it)
+    for (auto& cachesPerWorld : s_RenderDataCaches)
     {
-      ezView* pView = it.Value();
-      pView->m_pRenderDataCache->m_PerObjectCaches.Clear();
+      for (ezInternal::RenderDataCache* pCache : cachesPerWorld)
+      {
+        if (pCache != nullptr)
+        {
+          pCache->m_PerObjectCaches.Clear();
+        }
+      }
     }
   }
 
@@ -300,12 +359,12 @@ void ezRenderWorld::DeleteAllCachedRenderData()
     {
       auto& cachedRenderDataPerComponent = it.Value();
 
-      for (auto pCachedRenderData : cachedRenderDataPerComponent)
+      for (auto pCachedRenderData : cachedRenderDataPerComponent.m_RenderData)
       {
         s_DeletedRenderData.PushBack(pCachedRenderData);
       }
 
-      cachedRenderDataPerComponent.Clear();
+      cachedRenderDataPerComponent.m_RenderData.Clear();
     }
   }
 }
@@ -318,25 +377,32 @@ void ezRenderWorld::DeleteCachedRenderData(const ezGameObjectHandle& hOwnerObjec
 
   EZ_LOCK(s_CachedRenderDataMutex);
 
-  CachedRenderDataPerComponent* pCachedRenderDataPerComponent = nullptr;
-  if (s_CachedRenderData.TryGetValue(hOwnerComponent, pCachedRenderDataPerComponent))
-  {
-    for (auto pCachedRenderData : *pCachedRenderDataPerComponent)
-    {
-      s_DeletedRenderData.PushBack(pCachedRenderData);
-    }
-
-    s_CachedRenderData.Remove(hOwnerComponent);
-  }
+  DeleteCachedRenderDataForComponent(hOwnerComponent);
 }
 
 void ezRenderWorld::ResetRenderDataCache(ezView& ref_view)
 {
-  ref_view.m_pRenderDataCache->m_PerObjectCaches.Clear();
-  ref_view.m_pRenderDataCache->m_NewEntriesCount = 0;
-
   if (ref_view.GetWorld() != nullptr)
   {
+    {
+      EZ_LOCK(s_ViewsMutex);
+
+      // the usage hint of the view may still change, and caches can't be created during extraction, so all of them are created up front
+      for (ezInternal::RenderDataCache*& pCache : s_RenderDataCaches[ref_view.GetWorld()->GetIndex()])
+      {
+        if (pCache == nullptr)
+        {
+          pCache = EZ_NEW(s_pCacheAllocator, ezInternal::RenderDataCache, s_pCacheAllocator);
+        }
+        else
+        {
+          // the caches may still contain the render data of a deleted world that had the same index
+          pCache->m_PerObjectCaches.Clear();
+          pCache->m_NewEntriesCount = 0;
+        }
+      }
+    }
+
     if (ref_view.GetWorld()->GetObjectDeletionEvent().HasEventHandler(&ezRenderWorld::DeleteCachedRenderDataForObject) == false)
     {
       ref_view.GetWorld()->GetObjectDeletionEvent().AddEventHandler(&ezRenderWorld::DeleteCachedRenderDataForObject);
@@ -355,18 +421,7 @@ void ezRenderWorld::DeleteCachedRenderDataForObject(const ezGameObject* pOwnerOb
   auto components = pOwnerObject->GetComponents();
   for (auto pComponent : components)
   {
-    ezComponentHandle hComponent = pComponent->GetHandle();
-
-    CachedRenderDataPerComponent* pCachedRenderDataPerComponent = nullptr;
-    if (s_CachedRenderData.TryGetValue(hComponent, pCachedRenderDataPerComponent))
-    {
-      for (auto pCachedRenderData : *pCachedRenderDataPerComponent)
-      {
-        s_DeletedRenderData.PushBack(pCachedRenderData);
-      }
-
-      s_CachedRenderData.Remove(hComponent);
-    }
+    DeleteCachedRenderDataForComponent(pComponent->GetHandle());
   }
 }
 
@@ -382,9 +437,11 @@ void ezRenderWorld::DeleteCachedRenderDataForObjectRecursive(const ezGameObject*
 
 ezArrayPtr<const ezInternal::RenderDataCacheEntry> ezRenderWorld::GetCachedRenderData(const ezView& view, const ezGameObjectHandle& hOwner, ezUInt16 uiComponentVersion)
 {
-  if (cvar_RenderingCachingStaticObjects)
+  const ezInternal::RenderDataCache* pCache = GetRenderDataCache(view);
+
+  if (cvar_RenderingCachingStaticObjects && pCache != nullptr)
   {
-    const auto& perObjectCaches = view.m_pRenderDataCache->m_PerObjectCaches;
+    const auto& perObjectCaches = pCache->m_PerObjectCaches;
     ezUInt32 uiCacheIndex = hOwner.GetInternalID().m_InstanceIndex;
     if (uiCacheIndex < perObjectCaches.GetCount())
     {
@@ -656,23 +713,22 @@ bool ezRenderWorld::IsRenderingThread()
 
 void ezRenderWorld::DeleteCachedRenderDataInternal(const ezGameObjectHandle& hOwnerObject)
 {
-  ezUInt32 uiCacheIndex = hOwnerObject.GetInternalID().m_InstanceIndex;
-  ezWorld* pWorld = ezWorld::GetWorld(hOwnerObject);
+  const ezUInt32 uiCacheIndex = hOwnerObject.GetInternalID().m_InstanceIndex;
+  const ezUInt32 uiWorldIndex = hOwnerObject.GetInternalID().m_WorldIndex;
 
   EZ_LOCK(s_ViewsMutex);
 
-  for (auto it = s_Views.GetIterator(); it.IsValid(); ++it)
+  for (ezInternal::RenderDataCache* pCache : s_RenderDataCaches[uiWorldIndex])
   {
-    ezView* pView = it.Value();
-    if (pView->GetWorld() != nullptr && pView->GetWorld() == pWorld)
-    {
-      auto& perObjectCaches = pView->m_pRenderDataCache->m_PerObjectCaches;
+    if (pCache == nullptr)
+      continue;
 
-      if (uiCacheIndex < perObjectCaches.GetCount())
-      {
-        perObjectCaches[uiCacheIndex].m_Entries.Clear();
-        perObjectCaches[uiCacheIndex].m_uiVersion = 0;
-      }
+    auto& perObjectCaches = pCache->m_PerObjectCaches;
+
+    if (uiCacheIndex < perObjectCaches.GetCount())
+    {
+      perObjectCaches[uiCacheIndex].m_Entries.Clear();
+      perObjectCaches[uiCacheIndex].m_uiVersion = 0;
     }
   }
 }
@@ -694,71 +750,93 @@ void ezRenderWorld::UpdateRenderDataCache()
 {
   EZ_PROFILE_SCOPE("Update Render Data Cache");
 
-  for (auto it = s_Views.GetIterator(); it.IsValid(); ++it)
+  for (auto& cachesPerWorld : s_RenderDataCaches)
   {
-    ezView* pView = it.Value();
-    ezUInt32 uiNumNewEntries = ezMath::Min<ezInt32>(pView->m_pRenderDataCache->m_NewEntriesCount, MaxNumNewCacheEntries);
-    pView->m_pRenderDataCache->m_NewEntriesCount = 0;
-
-    auto& perObjectCaches = pView->m_pRenderDataCache->m_PerObjectCaches;
-
-    for (ezUInt32 uiNewEntryIndex = 0; uiNewEntryIndex < uiNumNewEntries; ++uiNewEntryIndex)
+    for (ezUInt32 uiCameraUsageHint = 0; uiCameraUsageHint < ezCameraUsageHint::ENUM_COUNT; ++uiCameraUsageHint)
     {
-      auto& newEntries = pView->m_pRenderDataCache->m_NewEntriesPerComponent[uiNewEntryIndex];
-      EZ_ASSERT_DEV(!newEntries.m_hOwnerObject.IsInvalidated(), "Implementation error");
+      ezInternal::RenderDataCache* pCache = cachesPerWorld[uiCameraUsageHint];
+      if (pCache == nullptr)
+        continue;
 
-      // find or create cached render data
-      auto& cachedRenderDataPerComponent = s_CachedRenderData[newEntries.m_hOwnerComponent];
+      ezUInt32 uiNumNewEntries = ezMath::Min<ezInt32>(pCache->m_NewEntriesCount, MaxNumNewCacheEntries);
+      pCache->m_NewEntriesCount = 0;
 
-      const ezUInt32 uiNumCachedRenderData = cachedRenderDataPerComponent.GetCount();
-      if (uiNumCachedRenderData == 0) // Nothing cached yet
-      {
-        cachedRenderDataPerComponent = CachedRenderDataPerComponent(s_pCacheAllocator);
-      }
+      auto& perObjectCaches = pCache->m_PerObjectCaches;
 
-      ezUInt32 uiCachedRenderDataIndex = 0;
-      for (auto& newEntry : newEntries.m_Cache.m_Entries)
+      for (ezUInt32 uiNewEntryIndex = 0; uiNewEntryIndex < uiNumNewEntries; ++uiNewEntryIndex)
       {
-        if (newEntry.m_pRenderData != nullptr)
+        auto& newEntries = pCache->m_NewEntriesPerComponent[uiNewEntryIndex];
+        EZ_ASSERT_DEV(!newEntries.m_hOwnerObject.IsInvalidated(), "Implementation error");
+
+        // find or create cached render data
+        CachedRenderDataKey key;
+        key.m_hComponent = newEntries.m_hOwnerComponent;
+        key.m_uiCameraUsageHint = static_cast<ezUInt8>(uiCameraUsageHint);
+
+        auto& cachedRenderDataPerComponent = s_CachedRenderData[key];
+
+        const ezUInt32 uiNumCachedRenderData = cachedRenderDataPerComponent.m_RenderData.GetCount();
+        if (uiNumCachedRenderData == 0) // Nothing cached yet
         {
-          if (uiCachedRenderDataIndex >= cachedRenderDataPerComponent.GetCount())
+          cachedRenderDataPerComponent.m_RenderData = ezHybridArray<const ezRenderData*, 4>(s_pCacheAllocator);
+        }
+        else if (cachedRenderDataPerComponent.m_uiVersion != newEntries.m_Cache.m_uiVersion)
+        {
+          // the owner was modified or moved since the render data was cached, it needs to be replaced by the newly extracted one
+          for (auto pCachedRenderData : cachedRenderDataPerComponent.m_RenderData)
           {
-            const ezRTTI* pRtti = newEntry.m_pRenderData->GetDynamicRTTI();
-            newEntry.m_pRenderData = pRtti->GetAllocator()->Clone<ezRenderData>(newEntry.m_pRenderData, s_pCacheAllocator);
-
-            cachedRenderDataPerComponent.PushBack(newEntry.m_pRenderData);
+            s_DeletedRenderData.PushBack(pCachedRenderData);
           }
-          else
+
+          cachedRenderDataPerComponent.m_RenderData.Clear();
+        }
+
+        cachedRenderDataPerComponent.m_uiVersion = newEntries.m_Cache.m_uiVersion;
+
+        ezUInt32 uiCachedRenderDataIndex = 0;
+        for (auto& newEntry : newEntries.m_Cache.m_Entries)
+        {
+          if (newEntry.m_pRenderData != nullptr)
           {
-            // replace with cached render data
-            newEntry.m_pRenderData = cachedRenderDataPerComponent[uiCachedRenderDataIndex];
+            if (uiCachedRenderDataIndex >= cachedRenderDataPerComponent.m_RenderData.GetCount())
+            {
+              const ezRTTI* pRtti = newEntry.m_pRenderData->GetDynamicRTTI();
+              newEntry.m_pRenderData = pRtti->GetAllocator()->Clone<ezRenderData>(newEntry.m_pRenderData, s_pCacheAllocator);
+
+              cachedRenderDataPerComponent.m_RenderData.PushBack(newEntry.m_pRenderData);
+            }
+            else
+            {
+              // replace with cached render data, e.g. when the same component was extracted by multiple views with the same usage hint in the same frame
+              newEntry.m_pRenderData = cachedRenderDataPerComponent.m_RenderData[uiCachedRenderDataIndex];
+            }
+
+            ++uiCachedRenderDataIndex;
           }
-
-          ++uiCachedRenderDataIndex;
         }
-      }
 
-      // add entry for this view
-      const ezUInt32 uiCacheIndex = newEntries.m_hOwnerObject.GetInternalID().m_InstanceIndex;
-      perObjectCaches.EnsureCount(uiCacheIndex + 1);
+        // add entry for all views of this world with this usage hint
+        const ezUInt32 uiCacheIndex = newEntries.m_hOwnerObject.GetInternalID().m_InstanceIndex;
+        perObjectCaches.EnsureCount(uiCacheIndex + 1);
 
-      auto& perObjectCache = perObjectCaches[uiCacheIndex];
-      if (perObjectCache.m_uiVersion != newEntries.m_Cache.m_uiVersion)
-      {
-        perObjectCache.m_Entries.Clear();
-        perObjectCache.m_uiVersion = newEntries.m_Cache.m_uiVersion;
-      }
+        auto& perObjectCache = perObjectCaches[uiCacheIndex];
+        if (perObjectCache.m_uiVersion != newEntries.m_Cache.m_uiVersion)
+        {
+          perObjectCache.m_Entries.Clear();
+          perObjectCache.m_uiVersion = newEntries.m_Cache.m_uiVersion;
+        }
 
-      for (auto& newEntry : newEntries.m_Cache.m_Entries)
-      {
-        if (!perObjectCache.m_Entries.Contains(newEntry))
+        for (auto& newEntry : newEntries.m_Cache.m_Entries)
         {
-          perObjectCache.m_Entries.PushBack(newEntry);
+          if (!perObjectCache.m_Entries.Contains(newEntry))
+          {
+            perObjectCache.m_Entries.PushBack(newEntry);
+          }
         }
-      }
 
-      // keep entries sorted, otherwise the logic ezExtractor::ExtractRenderData doesn't work
-      perObjectCache.m_Entries.Sort();
+        // keep entries sorted, otherwise the logic ezExtractor::ExtractRenderData doesn't work
+        perObjectCache.m_Entries.Sort();
+      }
     }
   }
 }
@@ -806,7 +884,7 @@ void ezRenderWorld::OnEngineStartup()
 {
   s_pCacheAllocator = EZ_DEFAULT_NEW(ezProxyAllocator, "Cached Render Data", ezFoundation::GetDefaultAllocator());
 
-  s_CachedRenderData = ezHashTable<ezComponentHandle, CachedRenderDataPerComponent>(s_pCacheAllocator);
+  s_CachedRenderData = ezHashTable<CachedRenderDataKey, CachedRenderDataPerComponent, CachedRenderDataKeyHashHelper>(s_pCacheAllocator);
 }
 
 void ezRenderWorld::OnEngineShutdown()
@@ -815,15 +893,23 @@ void ezRenderWorld::OnEngineShutdown()
   for (auto it : s_CachedRenderData)
   {
     auto& cachedRenderDataPerComponent = it.Value();
-    if (cachedRenderDataPerComponent.IsEmpty() == false)
+    if (cachedRenderDataPerComponent.m_RenderData.IsEmpty() == false)
     {
-      EZ_REPORT_FAILURE("Leaked cached render data of type '{}'", cachedRenderDataPerComponent[0]->GetDynamicRTTI()->GetTypeName());
+      EZ_REPORT_FAILURE("Leaked cached render data of type '{}'", cachedRenderDataPerComponent.m_RenderData[0]->GetDynamicRTTI()->GetTypeName());
     }
   }
 #endif
 
   ClearRenderDataCache();
 
+  for (auto& cachesPerWorld : s_RenderDataCaches)
+  {
+    for (ezInternal::RenderDataCache*& pCache : cachesPerWorld)
+    {
+      EZ_DELETE(s_pCacheAllocator, pCache);
+    }
+  }
+
   EZ_DEFAULT_DELETE(s_pCacheAllocator);
 
   s_FilteredRenderPipelines[0].Clear();
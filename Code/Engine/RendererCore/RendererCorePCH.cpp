@@ -28,6 +28,7 @@ EZ_STATICLINK_LIBRARY(RendererCore)
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_AnimGraph_Implementation_AnimGraphPins);
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_AnimGraph_Implementation_AnimGraphResource);
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_AnimationClipResource);
+  EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_AnimationLod);
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_AnimationPose);
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_EditableSkeleton);
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_Skeleton);
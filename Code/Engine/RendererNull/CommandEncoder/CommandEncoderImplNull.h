@@ -0,0 +1,216 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <RendererFoundation/CommandEncoder/CommandEncoderPlatformInterface.h>
+#include <RendererNull/RendererNullDLL.h>
+
+class ezGALDeviceNull;
+
+/// \brief The kinds of commands that the null device records.
+struct ezGALCommandTypeNull
+{
+  using StorageType = ezUInt8;
+
+  enum Enum : ezUInt8
+  {
+    // Pipeline state
+    SetShader,
+    SetIndexBuffer,
+    SetVertexBuffer,
+    SetVertexDeclaration,
+    SetPrimitiveTopology,
+    SetBlendState,
+    SetDepthStencilState,
+    SetRasterizerState,
+    SetViewport,
+    SetScissorRect,
+
+    // Resource bindings
+    SetConstantBuffer,
+    SetSamplerState,
+    SetResourceView,
+    SetUnorderedAccessView,
+    SetPushConstants,
+
+    // Scopes
+    BeginRendering,
+    EndRendering,
+    BeginCompute,
+    EndCompute,
+
+    // Work
+    Clear,
+    Draw,
+    DrawIndirect,
+    Dispatch,
+    DispatchIndirect,
+
+    // Resource updates
+    UpdateBuffer,
+    UpdateTexture,
+    ClearUnorderedAccessView,
+    Copy,
+    Resolve,
+    Readback,
+    GenerateMipMaps,
+
+    // Misc
+    Query,
+    Marker,
+    Flush,
+
+    ENUM_COUNT,
+    Default = Flush
+  };
+};
+
+/// \brief A single recorded command.
+struct ezGALRecordedCommandNull
+{
+  EZ_DECLARE_POD_TYPE();
+
+  ezGALCommandTypeNull::Enum m_Type;
+
+  /// \brief The amount of work of the command: Vertices or indices (times instances) for draws, thread groups for dispatches,
+  /// bytes for buffer and texture updates. Zero when unknown, e.g. for indirect draws.
+  ezUInt64 m_uiAmount;
+};
+
+/// \brief Statistics about the commands that were submitted to the null device.
+///
+/// The same statistics can be computed from a recorded command stream by passing every command to AddCommand().
+struct EZ_RENDERERNULL_DLL ezGALCommandStatsNull
+{
+  void AddCommand(const ezGALRecordedCommandNull& command);
+
+  ezUInt32 m_uiNumCommands[ezGALCommandTypeNull::ENUM_COUNT] = {};
+
+  ezUInt32 m_uiDrawCalls = 0;        ///< Direct and indirect draws.
+  ezUInt32 m_uiDispatchCalls = 0;    ///< Direct and indirect dispatches.
+  ezUInt32 m_uiStateChanges = 0;     ///< Changes of shaders, vertex and index buffers and fixed function state. Redundant changes are already filtered out by ezGALCommandEncoder.
+  ezUInt32 m_uiResourceBindings = 0; ///< Bound constant buffers, samplers, resource views, UAVs and push constants.
+  ezUInt64 m_uiElementsDrawn = 0;    ///< Vertices or indices of all direct draws, multiplied by their instance count.
+  ezUInt64 m_uiBytesUploaded = 0;    ///< Bytes written through buffer and texture updates.
+};
+
+/// \brief Implements the command encoder of the null device.
+///
+/// No work is executed, except for buffer updates, copies and readbacks, which operate on the system memory copies of the null buffers.
+/// Every command is counted in the statistics of the current frame and, if enabled, recorded into a command stream.
+class EZ_RENDERERNULL_DLL ezGALCommandEncoderImplNull final : public ezGALCommandEncoderCommonPlatformInterface
+{
+public:
+  ezGALCommandEncoderImplNull(ezGALDeviceNull& ref_deviceNull);
+  ~ezGALCommandEncoderImplNull();
+
+  void EndFrame();
+
+  void SetCommandRecordingEnabled(bool bEnable) { m_bRecordCommands = bEnable; }
+  bool IsCommandRecordingEnabled() const { return m_bRecordCommands; }
+  ezArrayPtr<const ezGALRecordedCommandNull> GetRecordedCommands() const { return m_RecordedCommands; }
+  void ClearRecordedCommands() { m_RecordedCommands.Clear(); }
+
+  const ezGALCommandStatsNull& GetCurrentFrameStats() const { return m_CurrentFrameStats; }
+  const ezGALCommandStatsNull& GetLastFrameStats() const { return m_LastFrameStats; }
+
+  // ezGALCommandEncoderCommonPlatformInterface
+  // State setting functions
+
+  virtual void SetShaderPlatform(const ezGALShader* pShader) override;
+
+  virtual void SetConstantBufferPlatform(const ezShaderResourceBinding& binding, const ezGALBuffer* pBuffer) override;
+  virtual void SetSamplerStatePlatform(const ezShaderResourceBinding& binding, const ezGALSamplerState* pSamplerState) override;
+  virtual void SetResourceViewPlatform(const ezShaderResourceBinding& binding, const ezGALTextureResourceView* pResourceView) override;
+  virtual void SetResourceViewPlatform(const ezShaderResourceBinding& binding, const ezGALBufferResourceView* pResourceView) override;
+  virtual void SetUnorderedAccessViewPlatform(const ezShaderResourceBinding& binding, const ezGALTextureUnorderedAccessView* pUnorderedAccessView) override;
+  virtual void SetUnorderedAccessViewPlatform(const ezShaderResourceBinding& binding, const ezGALBufferUnorderedAccessView* pUnorderedAccessView) override;
+  virtual void SetPushConstantsPlatform(ezArrayPtr<const ezUInt8> data) override;
+
+  // GPU -> CPU query functions
+
+  virtual ezGALTimestampHandle InsertTimestampPlatform() override;
+  virtual ezGALOcclusionHandle BeginOcclusionQueryPlatform(ezEnum<ezGALQueryType> type) override;
+  virtual void EndOcclusionQueryPlatform(ezGALOcclusionHandle hOcclusion) override;
+  virtual ezGALFenceHandle InsertFencePlatform() override;
+
+  // Resource update functions
+
+  virtual void ClearUnorderedAccessViewPlatform(const ezGALTextureUnorderedAccessView* pUnorderedAccessView, ezVec4 vClearValues) override;
+  virtual void ClearUnorderedAccessViewPlatform(const ezGALBufferUnorderedAccessView* pUnorderedAccessView, ezVec4 vClearValues) override;
+  virtual void ClearUnorderedAccessViewPlatform(const ezGALTextureUnorderedAccessView* pUnorderedAccessView, ezVec4U32 vClearValues) override;
+  virtual void ClearUnorderedAccessViewPlatform(const ezGALBufferUnorderedAccessView* pUnorderedAccessView, ezVec4U32 vClearValues) override;
+
+  virtual void CopyBufferPlatform(const ezGALBuffer* pDestination, const ezGALBuffer* pSource) override;
+  virtual void CopyBufferRegionPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, const ezGALBuffer* pSource, ezUInt32 uiSourceOffset, ezUInt32 uiByteCount) override;
+
+  virtual void UpdateBufferPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, ezArrayPtr<const ezUInt8> sourceData, ezGALUpdateMode::Enum updateMode) override;
+
+  virtual void CopyTexturePlatform(const ezGALTexture* pDestination, const ezGALTexture* pSource) override;
+  virtual void CopyTextureRegionPlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource, const ezVec3U32& vDestinationPoint, const ezGALTexture* pSource, const ezGALTextureSubresource& sourceSubResource, const ezBoundingBoxu32& box) override;
+
+  virtual void UpdateTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource, const ezBoundingBoxu32& destinationBox, const ezGALSystemMemoryDescription& sourceData) override;
+
+  virtual void ResolveTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource, const ezGALTexture* pSource, const ezGALTextureSubresource& sourceSubResource) override;
+
+  virtual void ReadbackTexturePlatform(const ezGALReadbackTexture* pDestination, const ezGALTexture* pSource) override;
+  virtual void ReadbackBufferPlatform(const ezGALReadbackBuffer* pDestination, const ezGALBuffer* pSource) override;
+
+  virtual void GenerateMipMapsPlatform(const ezGALTextureResourceView* pResourceView) override;
+
+  // Misc
+
+  virtual void FlushPlatform() override;
+
+  // Debug helper functions
+
+  virtual void PushMarkerPlatform(const char* szMarker) override;
+  virtual void PopMarkerPlatform() override;
+  virtual void InsertEventMarkerPlatform(const char* szMarker) override;
+
+  // Dispatch
+
+  virtual void BeginComputePlatform() override;
+  virtual void EndComputePlatform() override;
+
+  virtual ezResult DispatchPlatform(ezUInt32 uiThreadGroupCountX, ezUInt32 uiThreadGroupCountY, ezUInt32 uiThreadGroupCountZ) override;
+  virtual ezResult DispatchIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes) override;
+
+  // Draw functions
+
+  virtual void BeginRenderingPlatform(const ezGALRenderingSetup& renderingSetup) override;
+  virtual void EndRenderingPlatform() override;
+
+  virtual void ClearPlatform(const ezColor& clearColor, ezUInt32 uiRenderTargetClearMask, bool bClearDepth, bool bClearStencil, float fDepthClear, ezUInt8 uiStencilClear) override;
+
+  virtual ezResult DrawPlatform(ezUInt32 uiVertexCount, ezUInt32 uiStartVertex) override;
+  virtual ezResult DrawIndexedPlatform(ezUInt32 uiIndexCount, ezUInt32 uiStartIndex) override;
+  virtual ezResult DrawIndexedInstancedPlatform(ezUInt32 uiIndexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartIndex) override;
+  virtual ezResult DrawIndexedInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes) override;
+  virtual ezResult DrawInstancedPlatform(ezUInt32 uiVertexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartVertex) override;
+  virtual ezResult DrawInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes) override;
+
+  // State functions
+
+  virtual void SetIndexBufferPlatform(const ezGALBuffer* pIndexBuffer) override;
+  virtual void SetVertexBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pVertexBuffer) override;
+  virtual void SetVertexDeclarationPlatform(const ezGALVertexDeclaration* pVertexDeclaration) override;
+  virtual void SetPrimitiveTopologyPlatform(ezGALPrimitiveTopology::Enum topology) override;
+
+  virtual void SetBlendStatePlatform(const ezGALBlendState* pBlendState, const ezColor& blendFactor, ezUInt32 uiSampleMask) override;
+  virtual void SetDepthStencilStatePlatform(const ezGALDepthStencilState* pDepthStencilState, ezUInt8 uiStencilRefValue) override;
+  virtual void SetRasterizerStatePlatform(const ezGALRasterizerState* pRasterizerState) override;
+
+  virtual void SetViewportPlatform(const ezRectFloat& rect, float fMinDepth, float fMaxDepth) override;
+  virtual void SetScissorRectPlatform(const ezRectU32& rect) override;
+
+private:
+  void Record(ezGALCommandTypeNull::Enum type, ezUInt64 uiAmount = 0);
+
+  ezGALDeviceNull& m_GALDeviceNull;
+
+  bool m_bRecordCommands = false;
+  ezDynamicArray<ezGALRecordedCommandNull> m_RecordedCommands;
+
+  ezGALCommandStatsNull m_CurrentFrameStats;
+  ezGALCommandStatsNull m_LastFrameStats;
+};
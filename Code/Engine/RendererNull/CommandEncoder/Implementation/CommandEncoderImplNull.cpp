@@ -0,0 +1,467 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererNull/CommandEncoder/CommandEncoderImplNull.h>
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererNull/Resources/BufferNull.h>
+#include <RendererNull/Resources/ReadbackBufferNull.h>
+#include <RendererNull/Resources/ReadbackTextureNull.h>
+
+void ezGALCommandStatsNull::AddCommand(const ezGALRecordedCommandNull& command)
+{
+  ++m_uiNumCommands[command.m_Type];
+
+  switch (command.m_Type)
+  {
+    case ezGALCommandTypeNull::SetShader:
+    case ezGALCommandTypeNull::SetIndexBuffer:
+    case ezGALCommandTypeNull::SetVertexBuffer:
+    case ezGALCommandTypeNull::SetVertexDeclaration:
+    case ezGALCommandTypeNull::SetPrimitiveTopology:
+    case ezGALCommandTypeNull::SetBlendState:
+    case ezGALCommandTypeNull::SetDepthStencilState:
+    case ezGALCommandTypeNull::SetRasterizerState:
+    case ezGALCommandTypeNull::SetViewport:
+    case ezGALCommandTypeNull::SetScissorRect:
+      ++m_uiStateChanges;
+      break;
+
+    case ezGALCommandTypeNull::SetConstantBuffer:
+    case ezGALCommandTypeNull::SetSamplerState:
+    case ezGALCommandTypeNull::SetResourceView:
+    case ezGALCommandTypeNull::SetUnorderedAccessView:
+    case ezGALCommandTypeNull::SetPushConstants:
+      ++m_uiResourceBindings;
+      break;
+
+    case ezGALCommandTypeNull::Draw:
+    case ezGALCommandTypeNull::DrawIndirect:
+      ++m_uiDrawCalls;
+      m_uiElementsDrawn += command.m_uiAmount;
+      break;
+
+    case ezGALCommandTypeNull::Dispatch:
+    case ezGALCommandTypeNull::DispatchIndirect:
+      ++m_uiDispatchCalls;
+      break;
+
+    case ezGALCommandTypeNull::UpdateBuffer:
+    case ezGALCommandTypeNull::UpdateTexture:
+      m_uiBytesUploaded += command.m_uiAmount;
+      break;
+
+    default:
+      break;
+  }
+}
+
+ezGALCommandEncoderImplNull::ezGALCommandEncoderImplNull(ezGALDeviceNull& ref_deviceNull)
+  : m_GALDeviceNull(ref_deviceNull)
+{
+}
+
+ezGALCommandEncoderImplNull::~ezGALCommandEncoderImplNull() = default;
+
+void ezGALCommandEncoderImplNull::EndFrame()
+{
+  m_LastFrameStats = m_CurrentFrameStats;
+  m_CurrentFrameStats = {};
+}
+
+void ezGALCommandEncoderImplNull::Record(ezGALCommandTypeNull::Enum type, ezUInt64 uiAmount)
+{
+  ezGALRecordedCommandNull command;
+  command.m_Type = type;
+  command.m_uiAmount = uiAmount;
+
+  m_CurrentFrameStats.AddCommand(command);
+
+  if (m_bRecordCommands)
+  {
+    m_RecordedCommands.PushBack(command);
+  }
+}
+
+// State setting functions
+
+void ezGALCommandEncoderImplNull::SetShaderPlatform(const ezGALShader* pShader)
+{
+  EZ_IGNORE_UNUSED(pShader);
+  Record(ezGALCommandTypeNull::SetShader);
+}
+
+void ezGALCommandEncoderImplNull::SetConstantBufferPlatform(const ezShaderResourceBinding& binding, const ezGALBuffer* pBuffer)
+{
+  EZ_IGNORE_UNUSED(binding);
+  EZ_IGNORE_UNUSED(pBuffer);
+  Record(ezGALCommandTypeNull::SetConstantBuffer);
+}
+
+void ezGALCommandEncoderImplNull::SetSamplerStatePlatform(const ezShaderResourceBinding& binding, const ezGALSamplerState* pSamplerState)
+{
+  EZ_IGNORE_UNUSED(binding);
+  EZ_IGNORE_UNUSED(pSamplerState);
+  Record(ezGALCommandTypeNull::SetSamplerState);
+}
+
+void ezGALCommandEncoderImplNull::SetResourceViewPlatform(const ezShaderResourceBinding& binding, const ezGALTextureResourceView* pResourceView)
+{
+  EZ_IGNORE_UNUSED(binding);
+  EZ_IGNORE_UNUSED(pResourceView);
+  Record(ezGALCommandTypeNull::SetResourceView);
+}
+
+void ezGALCommandEncoderImplNull::SetResourceViewPlatform(const ezShaderResourceBinding& binding, const ezGALBufferResourceView* pResourceView)
+{
+  EZ_IGNORE_UNUSED(binding);
+  EZ_IGNORE_UNUSED(pResourceView);
+  Record(ezGALCommandTypeNull::SetResourceView);
+}
+
+void ezGALCommandEncoderImplNull::SetUnorderedAccessViewPlatform(const ezShaderResourceBinding& binding, const ezGALTextureUnorderedAccessView* pUnorderedAccessView)
+{
+  EZ_IGNORE_UNUSED(binding);
+  EZ_IGNORE_UNUSED(pUnorderedAccessView);
+  Record(ezGALCommandTypeNull::SetUnorderedAccessView);
+}
+
+void ezGALCommandEncoderImplNull::SetUnorderedAccessViewPlatform(const ezShaderResourceBinding& binding, const ezGALBufferUnorderedAccessView* pUnorderedAccessView)
+{
+  EZ_IGNORE_UNUSED(binding);
+  EZ_IGNORE_UNUSED(pUnorderedAccessView);
+  Record(ezGALCommandTypeNull::SetUnorderedAccessView);
+}
+
+void ezGALCommandEncoderImplNull::SetPushConstantsPlatform(ezArrayPtr<const ezUInt8> data)
+{
+  Record(ezGALCommandTypeNull::SetPushConstants, data.GetCount());
+}
+
+// GPU -> CPU query functions
+
+ezGALTimestampHandle ezGALCommandEncoderImplNull::InsertTimestampPlatform()
+{
+  Record(ezGALCommandTypeNull::Query);
+  return m_GALDeviceNull.InsertTimestamp();
+}
+
+ezGALOcclusionHandle ezGALCommandEncoderImplNull::BeginOcclusionQueryPlatform(ezEnum<ezGALQueryType> type)
+{
+  EZ_IGNORE_UNUSED(type);
+  Record(ezGALCommandTypeNull::Query);
+  return m_GALDeviceNull.CreateOcclusionQuery();
+}
+
+void ezGALCommandEncoderImplNull::EndOcclusionQueryPlatform(ezGALOcclusionHandle hOcclusion)
+{
+  EZ_IGNORE_UNUSED(hOcclusion);
+}
+
+ezGALFenceHandle ezGALCommandEncoderImplNull::InsertFencePlatform()
+{
+  Record(ezGALCommandTypeNull::Query);
+  return m_GALDeviceNull.InsertFence();
+}
+
+// Resource update functions
+
+void ezGALCommandEncoderImplNull::ClearUnorderedAccessViewPlatform(const ezGALTextureUnorderedAccessView* pUnorderedAccessView, ezVec4 vClearValues)
+{
+  EZ_IGNORE_UNUSED(pUnorderedAccessView);
+  EZ_IGNORE_UNUSED(vClearValues);
+  Record(ezGALCommandTypeNull::ClearUnorderedAccessView);
+}
+
+void ezGALCommandEncoderImplNull::ClearUnorderedAccessViewPlatform(const ezGALBufferUnorderedAccessView* pUnorderedAccessView, ezVec4 vClearValues)
+{
+  EZ_IGNORE_UNUSED(pUnorderedAccessView);
+  EZ_IGNORE_UNUSED(vClearValues);
+  Record(ezGALCommandTypeNull::ClearUnorderedAccessView);
+}
+
+void ezGALCommandEncoderImplNull::ClearUnorderedAccessViewPlatform(const ezGALTextureUnorderedAccessView* pUnorderedAccessView, ezVec4U32 vClearValues)
+{
+  EZ_IGNORE_UNUSED(pUnorderedAccessView);
+  EZ_IGNORE_UNUSED(vClearValues);
+  Record(ezGALCommandTypeNull::ClearUnorderedAccessView);
+}
+
+void ezGALCommandEncoderImplNull::ClearUnorderedAccessViewPlatform(const ezGALBufferUnorderedAccessView* pUnorderedAccessView, ezVec4U32 vClearValues)
+{
+  EZ_IGNORE_UNUSED(pUnorderedAccessView);
+  EZ_IGNORE_UNUSED(vClearValues);
+  Record(ezGALCommandTypeNull::ClearUnorderedAccessView);
+}
+
+void ezGALCommandEncoderImplNull::CopyBufferPlatform(const ezGALBuffer* pDestination, const ezGALBuffer* pSource)
+{
+  const ezGALBufferNull* pDestinationNull = static_cast<const ezGALBufferNull*>(pDestination);
+  const ezGALBufferNull* pSourceNull = static_cast<const ezGALBufferNull*>(pSource);
+
+  const ezUInt32 uiByteCount = ezMath::Min(pDestinationNull->GetData().GetCount(), pSourceNull->GetData().GetCount());
+  pDestinationNull->WriteData(0, pSourceNull->GetData().GetSubArray(0, uiByteCount));
+
+  Record(ezGALCommandTypeNull::Copy, uiByteCount);
+}
+
+void ezGALCommandEncoderImplNull::CopyBufferRegionPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, const ezGALBuffer* pSource, ezUInt32 uiSourceOffset, ezUInt32 uiByteCount)
+{
+  const ezGALBufferNull* pDestinationNull = static_cast<const ezGALBufferNull*>(pDestination);
+  const ezGALBufferNull* pSourceNull = static_cast<const ezGALBufferNull*>(pSource);
+
+  pDestinationNull->WriteData(uiDestOffset, pSourceNull->GetData().GetSubArray(uiSourceOffset, uiByteCount));
+
+  Record(ezGALCommandTypeNull::Copy, uiByteCount);
+}
+
+void ezGALCommandEncoderImplNull::UpdateBufferPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, ezArrayPtr<const ezUInt8> sourceData, ezGALUpdateMode::Enum updateMode)
+{
+  EZ_IGNORE_UNUSED(updateMode);
+
+  static_cast<const ezGALBufferNull*>(pDestination)->WriteData(uiDestOffset, sourceData);
+
+  Record(ezGALCommandTypeNull::UpdateBuffer, sourceData.GetCount());
+}
+
+void ezGALCommandEncoderImplNull::CopyTexturePlatform(const ezGALTexture* pDestination, const ezGALTexture* pSource)
+{
+  EZ_IGNORE_UNUSED(pDestination);
+  EZ_IGNORE_UNUSED(pSource);
+  Record(ezGALCommandTypeNull::Copy);
+}
+
+void ezGALCommandEncoderImplNull::CopyTextureRegionPlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource, const ezVec3U32& vDestinationPoint, const ezGALTexture* pSource, const ezGALTextureSubresource& sourceSubResource, const ezBoundingBoxu32& box)
+{
+  EZ_IGNORE_UNUSED(pDestination);
+  EZ_IGNORE_UNUSED(destinationSubResource);
+  EZ_IGNORE_UNUSED(vDestinationPoint);
+  EZ_IGNORE_UNUSED(pSource);
+  EZ_IGNORE_UNUSED(sourceSubResource);
+  EZ_IGNORE_UNUSED(box);
+  Record(ezGALCommandTypeNull::Copy);
+}
+
+void ezGALCommandEncoderImplNull::UpdateTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource, const ezBoundingBoxu32& destinationBox, const ezGALSystemMemoryDescription& sourceData)
+{
+  EZ_IGNORE_UNUSED(pDestination);
+  EZ_IGNORE_UNUSED(destinationSubResource);
+
+  const ezUInt32 uiDepth = ezMath::Max(destinationBox.m_vMax.z - destinationBox.m_vMin.z, 1u);
+  const ezUInt64 uiByteCount = sourceData.m_uiSlicePitch > 0 ? (ezUInt64)sourceData.m_uiSlicePitch * uiDepth : sourceData.m_pData.GetCount();
+
+  Record(ezGALCommandTypeNull::UpdateTexture, uiByteCount);
+}
+
+void ezGALCommandEncoderImplNull::ResolveTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource, const ezGALTexture* pSource, const ezGALTextureSubresource& sourceSubResource)
+{
+  EZ_IGNORE_UNUSED(pDestination);
+  EZ_IGNORE_UNUSED(destinationSubResource);
+  EZ_IGNORE_UNUSED(pSource);
+  EZ_IGNORE_UNUSED(sourceSubResource);
+  Record(ezGALCommandTypeNull::Resolve);
+}
+
+void ezGALCommandEncoderImplNull::ReadbackTexturePlatform(const ezGALReadbackTexture* pDestination, const ezGALTexture* pSource)
+{
+  EZ_IGNORE_UNUSED(pSource);
+
+  // texture content is not stored, so there is nothing to read back
+  static_cast<const ezGALReadbackTextureNull*>(pDestination)->ClearData();
+
+  Record(ezGALCommandTypeNull::Readback);
+}
+
+void ezGALCommandEncoderImplNull::ReadbackBufferPlatform(const ezGALReadbackBuffer* pDestination, const ezGALBuffer* pSource)
+{
+  const ezGALBufferNull* pSourceNull = static_cast<const ezGALBufferNull*>(pSource);
+  static_cast<const ezGALReadbackBufferNull*>(pDestination)->WriteData(pSourceNull->GetData());
+
+  Record(ezGALCommandTypeNull::Readback, pSourceNull->GetData().GetCount());
+}
+
+void ezGALCommandEncoderImplNull::GenerateMipMapsPlatform(const ezGALTextureResourceView* pResourceView)
+{
+  EZ_IGNORE_UNUSED(pResourceView);
+  Record(ezGALCommandTypeNull::GenerateMipMaps);
+}
+
+// Misc
+
+void ezGALCommandEncoderImplNull::FlushPlatform()
+{
+  Record(ezGALCommandTypeNull::Flush);
+}
+
+// Debug helper functions
+
+void ezGALCommandEncoderImplNull::PushMarkerPlatform(const char* szMarker)
+{
+  EZ_IGNORE_UNUSED(szMarker);
+  Record(ezGALCommandTypeNull::Marker);
+}
+
+void ezGALCommandEncoderImplNull::PopMarkerPlatform()
+{
+  Record(ezGALCommandTypeNull::Marker);
+}
+
+void ezGALCommandEncoderImplNull::InsertEventMarkerPlatform(const char* szMarker)
+{
+  EZ_IGNORE_UNUSED(szMarker);
+  Record(ezGALCommandTypeNull::Marker);
+}
+
+// Dispatch
+
+void ezGALCommandEncoderImplNull::BeginComputePlatform()
+{
+  Record(ezGALCommandTypeNull::BeginCompute);
+}
+
+void ezGALCommandEncoderImplNull::EndComputePlatform()
+{
+  Record(ezGALCommandTypeNull::EndCompute);
+}
+
+ezResult ezGALCommandEncoderImplNull::DispatchPlatform(ezUInt32 uiThreadGroupCountX, ezUInt32 uiThreadGroupCountY, ezUInt32 uiThreadGroupCountZ)
+{
+  Record(ezGALCommandTypeNull::Dispatch, (ezUInt64)uiThreadGroupCountX * uiThreadGroupCountY * uiThreadGroupCountZ);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALCommandEncoderImplNull::DispatchIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  EZ_IGNORE_UNUSED(pIndirectArgumentBuffer);
+  EZ_IGNORE_UNUSED(uiArgumentOffsetInBytes);
+  Record(ezGALCommandTypeNull::DispatchIndirect);
+  return EZ_SUCCESS;
+}
+
+// Draw functions
+
+void ezGALCommandEncoderImplNull::BeginRenderingPlatform(const ezGALRenderingSetup& renderingSetup)
+{
+  EZ_IGNORE_UNUSED(renderingSetup);
+  Record(ezGALCommandTypeNull::BeginRendering);
+}
+
+void ezGALCommandEncoderImplNull::EndRenderingPlatform()
+{
+  Record(ezGALCommandTypeNull::EndRendering);
+}
+
+void ezGALCommandEncoderImplNull::ClearPlatform(const ezColor& clearColor, ezUInt32 uiRenderTargetClearMask, bool bClearDepth, bool bClearStencil, float fDepthClear, ezUInt8 uiStencilClear)
+{
+  EZ_IGNORE_UNUSED(clearColor);
+  EZ_IGNORE_UNUSED(uiRenderTargetClearMask);
+  EZ_IGNORE_UNUSED(bClearDepth);
+  EZ_IGNORE_UNUSED(bClearStencil);
+  EZ_IGNORE_UNUSED(fDepthClear);
+  EZ_IGNORE_UNUSED(uiStencilClear);
+  Record(ezGALCommandTypeNull::Clear);
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawPlatform(ezUInt32 uiVertexCount, ezUInt32 uiStartVertex)
+{
+  EZ_IGNORE_UNUSED(uiStartVertex);
+  Record(ezGALCommandTypeNull::Draw, uiVertexCount);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawIndexedPlatform(ezUInt32 uiIndexCount, ezUInt32 uiStartIndex)
+{
+  EZ_IGNORE_UNUSED(uiStartIndex);
+  Record(ezGALCommandTypeNull::Draw, uiIndexCount);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawIndexedInstancedPlatform(ezUInt32 uiIndexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartIndex)
+{
+  EZ_IGNORE_UNUSED(uiStartIndex);
+  Record(ezGALCommandTypeNull::Draw, (ezUInt64)uiIndexCountPerInstance * uiInstanceCount);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawIndexedInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  EZ_IGNORE_UNUSED(pIndirectArgumentBuffer);
+  EZ_IGNORE_UNUSED(uiArgumentOffsetInBytes);
+  Record(ezGALCommandTypeNull::DrawIndirect);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawInstancedPlatform(ezUInt32 uiVertexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartVertex)
+{
+  EZ_IGNORE_UNUSED(uiStartVertex);
+  Record(ezGALCommandTypeNull::Draw, (ezUInt64)uiVertexCountPerInstance * uiInstanceCount);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  EZ_IGNORE_UNUSED(pIndirectArgumentBuffer);
+  EZ_IGNORE_UNUSED(uiArgumentOffsetInBytes);
+  Record(ezGALCommandTypeNull::DrawIndirect);
+  return EZ_SUCCESS;
+}
+
+// State functions
+
+void ezGALCommandEncoderImplNull::SetIndexBufferPlatform(const ezGALBuffer* pIndexBuffer)
+{
+  EZ_IGNORE_UNUSED(pIndexBuffer);
+  Record(ezGALCommandTypeNull::SetIndexBuffer);
+}
+
+void ezGALCommandEncoderImplNull::SetVertexBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pVertexBuffer)
+{
+  EZ_IGNORE_UNUSED(uiSlot);
+  EZ_IGNORE_UNUSED(pVertexBuffer);
+  Record(ezGALCommandTypeNull::SetVertexBuffer);
+}
+
+void ezGALCommandEncoderImplNull::SetVertexDeclarationPlatform(const ezGALVertexDeclaration* pVertexDeclaration)
+{
+  EZ_IGNORE_UNUSED(pVertexDeclaration);
+  Record(ezGALCommandTypeNull::SetVertexDeclaration);
+}
+
+void ezGALCommandEncoderImplNull::SetPrimitiveTopologyPlatform(ezGALPrimitiveTopology::Enum topology)
+{
+  EZ_IGNORE_UNUSED(topology);
+  Record(ezGALCommandTypeNull::SetPrimitiveTopology);
+}
+
+void ezGALCommandEncoderImplNull::SetBlendStatePlatform(const ezGALBlendState* pBlendState, const ezColor& blendFactor, ezUInt32 uiSampleMask)
+{
+  EZ_IGNORE_UNUSED(pBlendState);
+  EZ_IGNORE_UNUSED(blendFactor);
+  EZ_IGNORE_UNUSED(uiSampleMask);
+  Record(ezGALCommandTypeNull::SetBlendState);
+}
+
+void ezGALCommandEncoderImplNull::SetDepthStencilStatePlatform(const ezGALDepthStencilState* pDepthStencilState, ezUInt8 uiStencilRefValue)
+{
+  EZ_IGNORE_UNUSED(pDepthStencilState);
+  EZ_IGNORE_UNUSED(uiStencilRefValue);
+  Record(ezGALCommandTypeNull::SetDepthStencilState);
+}
+
+void ezGALCommandEncoderImplNull::SetRasterizerStatePlatform(const ezGALRasterizerState* pRasterizerState)
+{
+  EZ_IGNORE_UNUSED(pRasterizerState);
+  Record(ezGALCommandTypeNull::SetRasterizerState);
+}
+
+void ezGALCommandEncoderImplNull::SetViewportPlatform(const ezRectFloat& rect, float fMinDepth, float fMaxDepth)
+{
+  EZ_IGNORE_UNUSED(rect);
+  EZ_IGNORE_UNUSED(fMinDepth);
+  EZ_IGNORE_UNUSED(fMaxDepth);
+  Record(ezGALCommandTypeNull::SetViewport);
+}
+
+void ezGALCommandEncoderImplNull::SetScissorRectPlatform(const ezRectU32& rect)
+{
+  EZ_IGNORE_UNUSED(rect);
+  Record(ezGALCommandTypeNull::SetScissorRect);
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <Foundation/Types/UniquePtr.h>
+#include <RendererFoundation/Device/Device.h>
+#include <RendererNull/CommandEncoder/CommandEncoderImplNull.h>
+#include <RendererNull/RendererNullDLL.h>
+
+/// \brief A graphics device that doesn't use a GPU at all.
+///
+/// All resources, states and views are created and tracked like on every other device, and everything that goes through the
+/// ezGALCommandEncoder is validated and state-filtered as usual, but no GPU work is ever executed.
+/// This allows running the whole extraction and render pipeline on machines without a GPU, e.g. to profile its CPU cost.
+///
+/// Every command that reaches the device is counted in per-frame statistics, see GetLastFrameStats().
+/// Additionally, the full command stream can be recorded with SetCommandRecordingEnabled(), to analyze or replay the statistics later.
+///
+/// Buffer content is kept in system memory, so buffer updates, copies and readbacks work. Texture content isn't stored, texture readbacks return zeros.
+/// All queries and fences are finished immediately and every frame is safe as soon as it has ended.
+///
+/// The device is registered under the name "Null" and uses the shaders of the default device of the platform,
+/// since the shader byte code is still needed for the resource binding information.
+class EZ_RENDERERNULL_DLL ezGALDeviceNull : public ezGALDevice
+{
+private:
+  friend ezInternal::NewInstance<ezGALDevice> CreateNullDevice(ezAllocator* pAllocator, const ezGALDeviceCreationDescription& description);
+  ezGALDeviceNull(const ezGALDeviceCreationDescription& Description);
+
+public:
+  virtual ~ezGALDeviceNull();
+
+public:
+  ezGALCommandEncoder* GetCommandEncoder() const;
+
+  /// \brief Enables or disables recording of all commands into a stream that can be retrieved with GetRecordedCommands().
+  ///
+  /// Recording is disabled by default. The recorded commands are kept until ClearRecordedCommands() is called.
+  void SetCommandRecordingEnabled(bool bEnable);
+  bool IsCommandRecordingEnabled() const;
+  ezArrayPtr<const ezGALRecordedCommandNull> GetRecordedCommands() const;
+  void ClearRecordedCommands();
+
+  /// \brief Returns the statistics of the frame that is currently being recorded.
+  const ezGALCommandStatsNull& GetCurrentFrameStats() const;
+
+  /// \brief Returns the statistics of the last finished frame.
+  const ezGALCommandStatsNull& GetLastFrameStats() const;
+
+  // These functions need to be implemented by a render API abstraction
+protected:
+  // Init & shutdown functions
+
+  virtual ezStringView GetRendererPlatform() override;
+  virtual ezResult InitPlatform() override;
+  virtual ezResult ShutdownPlatform() override;
+
+  // Command encoder functions
+
+  virtual ezGALCommandEncoder* BeginCommandsPlatform(const char* szName) override;
+  virtual void EndCommandsPlatform(ezGALCommandEncoder* pPass) override;
+
+  virtual void FlushPlatform() override;
+
+  // State creation functions
+
+  virtual ezGALBlendState* CreateBlendStatePlatform(const ezGALBlendStateCreationDescription& Description) override;
+  virtual void DestroyBlendStatePlatform(ezGALBlendState* pBlendState) override;
+
+  virtual ezGALDepthStencilState* CreateDepthStencilStatePlatform(const ezGALDepthStencilStateCreationDescription& Description) override;
+  virtual void DestroyDepthStencilStatePlatform(ezGALDepthStencilState* pDepthStencilState) override;
+
+  virtual ezGALRasterizerState* CreateRasterizerStatePlatform(const ezGALRasterizerStateCreationDescription& Description) override;
+  virtual void DestroyRasterizerStatePlatform(ezGALRasterizerState* pRasterizerState) override;
+
+  virtual ezGALSamplerState* CreateSamplerStatePlatform(const ezGALSamplerStateCreationDescription& Description) override;
+  virtual void DestroySamplerStatePlatform(ezGALSamplerState* pSamplerState) override;
+
+  // Resource creation functions
+
+  virtual ezGALShader* CreateShaderPlatform(const ezGALShaderCreationDescription& Description) override;
+  virtual void DestroyShaderPlatform(ezGALShader* pShader) override;
+
+  virtual ezGALBuffer* CreateBufferPlatform(const ezGALBufferCreationDescription& Description, ezArrayPtr<const ezUInt8> pInitialData) override;
+  virtual void DestroyBufferPlatform(ezGALBuffer* pBuffer) override;
+
+  virtual ezGALTexture* CreateTexturePlatform(const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData) override;
+  virtual void DestroyTexturePlatform(ezGALTexture* pTexture) override;
+
+  virtual ezGALTexture* CreateSharedTexturePlatform(const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData, ezEnum<ezGALSharedTextureType> sharedType, ezGALPlatformSharedHandle handle) override;
+  virtual void DestroySharedTexturePlatform(ezGALTexture* pTexture) override;
+
+  virtual ezGALReadbackBuffer* CreateReadbackBufferPlatform(const ezGALBufferCreationDescription& Description) override;
+  virtual void DestroyReadbackBufferPlatform(ezGALReadbackBuffer* pReadbackBuffer) override;
+
+  virtual ezGALReadbackTexture* CreateReadbackTexturePlatform(const ezGALTextureCreationDescription& Description) override;
+  virtual void DestroyReadbackTexturePlatform(ezGALReadbackTexture* pReadbackTexture) override;
+
+  virtual ezGALTextureResourceView* CreateResourceViewPlatform(ezGALTexture* pResource, const ezGALTextureResourceViewCreationDescription& Description) override;
+  virtual void DestroyResourceViewPlatform(ezGALTextureResourceView* pResourceView) override;
+
+  virtual ezGALBufferResourceView* CreateResourceViewPlatform(ezGALBuffer* pResource, const ezGALBufferResourceViewCreationDescription& Description) override;
+  virtual void DestroyResourceViewPlatform(ezGALBufferResourceView* pResourceView) override;
+
+  virtual ezGALRenderTargetView* CreateRenderTargetViewPlatform(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description) override;
+  virtual void DestroyRenderTargetViewPlatform(ezGALRenderTargetView* pRenderTargetView) override;
+
+  virtual ezGALTextureUnorderedAccessView* CreateUnorderedAccessViewPlatform(ezGALTexture* pResource, const ezGALTextureUnorderedAccessViewCreationDescription& Description) override;
+  virtual void DestroyUnorderedAccessViewPlatform(ezGALTextureUnorderedAccessView* pUnorderedAccessView) override;
+
+  virtual ezGALBufferUnorderedAccessView* CreateUnorderedAccessViewPlatform(ezGALBuffer* pResource, const ezGALBufferUnorderedAccessViewCreationDescription& Description) override;
+  virtual void DestroyUnorderedAccessViewPlatform(ezGALBufferUnorderedAccessView* pUnorderedAccessView) override;
+
+  // Other rendering creation functions
+
+  virtual ezGALVertexDeclaration* CreateVertexDeclarationPlatform(const ezGALVertexDeclarationCreationDescription& Description) override;
+  virtual void DestroyVertexDeclarationPlatform(ezGALVertexDeclaration* pVertexDeclaration) override;
+
+  // GPU -> CPU query functions
+
+  virtual ezEnum<ezGALAsyncResult> GetTimestampResultPlatform(ezGALTimestampHandle hTimestamp, ezTime& out_result) override;
+  virtual ezEnum<ezGALAsyncResult> GetOcclusionResultPlatform(ezGALOcclusionHandle hOcclusion, ezUInt64& out_uiResult) override;
+  virtual ezEnum<ezGALAsyncResult> GetFenceResultPlatform(ezGALFenceHandle hFence, ezTime timeout) override;
+  virtual ezResult LockBufferPlatform(const ezGALReadbackBuffer* pBuffer, ezArrayPtr<const ezUInt8>& out_Memory) const override;
+  virtual void UnlockBufferPlatform(const ezGALReadbackBuffer* pBuffer) const override;
+  virtual ezResult LockTexturePlatform(const ezGALReadbackTexture* pTexture, const ezArrayPtr<const ezGALTextureSubresource>& subResources, ezDynamicArray<ezGALSystemMemoryDescription>& out_Memory) const override;
+  virtual void UnlockTexturePlatform(const ezGALReadbackTexture* pTexture, const ezArrayPtr<const ezGALTextureSubresource>& subResources) const override;
+
+  // Misc functions
+
+  virtual void BeginFramePlatform(ezArrayPtr<ezGALSwapChain*> swapchains, const ezUInt64 uiAppFrame) override;
+  virtual void EndFramePlatform(ezArrayPtr<ezGALSwapChain*> swapchains) override;
+  virtual ezUInt64 GetCurrentFramePlatform() const override;
+  virtual ezUInt64 GetSafeFramePlatform() const override;
+
+  virtual void FillCapabilitiesPlatform() override;
+
+  virtual void WaitIdlePlatform() override;
+
+  virtual const ezGALSharedTexture* GetSharedTexture(ezGALTextureHandle hTexture) const override;
+
+private:
+  friend class ezGALCommandEncoderImplNull;
+
+  ezGALTimestampHandle InsertTimestamp();
+  ezGALOcclusionHandle CreateOcclusionQuery();
+  ezGALFenceHandle InsertFence();
+
+  ezUniquePtr<ezGALCommandEncoderImplNull> m_pCommandEncoderImpl;
+  ezUniquePtr<ezGALCommandEncoder> m_pCommandEncoder;
+
+  ezUInt64 m_uiFrameCounter = 1;
+  ezUInt64 m_uiSafeFrame = 0;
+
+  // Timestamps are taken on the CPU when they are inserted. Only the most recent ones are kept, older ones are reported as expired.
+  static constexpr ezUInt32 MaxTimestamps = 1024;
+  ezTime m_Timestamps[MaxTimestamps];
+  ezUInt64 m_uiNextTimestamp = 0;
+
+  ezUInt64 m_uiNextOcclusionQuery = 0;
+  ezGALFenceHandle m_uiLastFence = 0;
+};
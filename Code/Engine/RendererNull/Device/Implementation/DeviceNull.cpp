@@ -0,0 +1,623 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <Foundation/Configuration/Startup.h>
+#include <RendererFoundation/CommandEncoder/CommandEncoder.h>
+#include <RendererFoundation/Device/DeviceFactory.h>
+#include <RendererNull/CommandEncoder/CommandEncoderImplNull.h>
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererNull/Device/SwapChainNull.h>
+#include <RendererNull/Resources/BufferNull.h>
+#include <RendererNull/Resources/ReadbackBufferNull.h>
+#include <RendererNull/Resources/ReadbackTextureNull.h>
+#include <RendererNull/Resources/RenderTargetViewNull.h>
+#include <RendererNull/Resources/ResourceViewNull.h>
+#include <RendererNull/Resources/TextureNull.h>
+#include <RendererNull/Resources/UnorderedAccessViewNull.h>
+#include <RendererNull/Shader/ShaderNull.h>
+#include <RendererNull/Shader/VertexDeclarationNull.h>
+#include <RendererNull/State/StateNull.h>
+
+ezInternal::NewInstance<ezGALDevice> CreateNullDevice(ezAllocator* pAllocator, const ezGALDeviceCreationDescription& Description)
+{
+  return EZ_NEW(pAllocator, ezGALDeviceNull, Description);
+}
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(RendererNull, DeviceFactoryNull)
+
+ON_CORESYSTEMS_STARTUP
+{
+  // The null device doesn't need shaders itself, but the resource binding information is extracted from the shader byte code,
+  // so it uses the shaders of the default device of the platform.
+#if EZ_ENABLED(EZ_PLATFORM_WINDOWS)
+  ezGALDeviceFactory::RegisterCreatorFunc("Null", &CreateNullDevice, "DX11_SM50", "ezShaderCompilerHLSL");
+#else
+  ezGALDeviceFactory::RegisterCreatorFunc("Null", &CreateNullDevice, "VULKAN", "ezShaderCompilerVulkan");
+#endif
+}
+
+ON_CORESYSTEMS_SHUTDOWN
+{
+  ezGALDeviceFactory::UnregisterCreatorFunc("Null");
+}
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+ezGALDeviceNull::ezGALDeviceNull(const ezGALDeviceCreationDescription& Description)
+  : ezGALDevice(Description)
+{
+}
+
+ezGALDeviceNull::~ezGALDeviceNull() = default;
+
+ezGALCommandEncoder* ezGALDeviceNull::GetCommandEncoder() const
+{
+  return m_pCommandEncoder.Borrow();
+}
+
+void ezGALDeviceNull::SetCommandRecordingEnabled(bool bEnable)
+{
+  m_pCommandEncoderImpl->SetCommandRecordingEnabled(bEnable);
+}
+
+bool ezGALDeviceNull::IsCommandRecordingEnabled() const
+{
+  return m_pCommandEncoderImpl->IsCommandRecordingEnabled();
+}
+
+ezArrayPtr<const ezGALRecordedCommandNull> ezGALDeviceNull::GetRecordedCommands() const
+{
+  return m_pCommandEncoderImpl->GetRecordedCommands();
+}
+
+void ezGALDeviceNull::ClearRecordedCommands()
+{
+  m_pCommandEncoderImpl->ClearRecordedCommands();
+}
+
+const ezGALCommandStatsNull& ezGALDeviceNull::GetCurrentFrameStats() const
+{
+  return m_pCommandEncoderImpl->GetCurrentFrameStats();
+}
+
+const ezGALCommandStatsNull& ezGALDeviceNull::GetLastFrameStats() const
+{
+  return m_pCommandEncoderImpl->GetLastFrameStats();
+}
+
+// Init & shutdown functions
+
+ezStringView ezGALDeviceNull::GetRendererPlatform()
+{
+  return "Null";
+}
+
+ezResult ezGALDeviceNull::InitPlatform()
+{
+  EZ_LOG_BLOCK("ezGALDeviceNull::InitPlatform");
+
+  m_pCommandEncoderImpl = EZ_NEW(&m_Allocator, ezGALCommandEncoderImplNull, *this);
+  m_pCommandEncoder = EZ_NEW(&m_Allocator, ezGALCommandEncoder, *this, *m_pCommandEncoderImpl);
+
+  ezGALWindowSwapChain::SetFactoryMethod([this](const ezGALWindowSwapChainCreationDescription& desc) -> ezGALSwapChainHandle
+    { return CreateSwapChain([&desc](ezAllocator* pAllocator) -> ezGALSwapChain*
+        { return EZ_NEW(pAllocator, ezGALSwapChainNull, desc); }); });
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALDeviceNull::ShutdownPlatform()
+{
+  ezGALWindowSwapChain::SetFactoryMethod({});
+
+  m_pCommandEncoder = nullptr;
+  m_pCommandEncoderImpl = nullptr;
+
+  return EZ_SUCCESS;
+}
+
+// Command encoder functions
+
+ezGALCommandEncoder* ezGALDeviceNull::BeginCommandsPlatform(const char* szName)
+{
+  EZ_IGNORE_UNUSED(szName);
+  return m_pCommandEncoder.Borrow();
+}
+
+void ezGALDeviceNull::EndCommandsPlatform(ezGALCommandEncoder* pPass)
+{
+  EZ_ASSERT_DEV(m_pCommandEncoder.Borrow() == pPass, "Invalid pass");
+  EZ_IGNORE_UNUSED(pPass);
+}
+
+void ezGALDeviceNull::FlushPlatform()
+{
+  m_pCommandEncoderImpl->FlushPlatform();
+}
+
+// State creation functions
+
+ezGALBlendState* ezGALDeviceNull::CreateBlendStatePlatform(const ezGALBlendStateCreationDescription& Description)
+{
+  ezGALBlendStateNull* pBlendState = EZ_NEW(&m_Allocator, ezGALBlendStateNull, Description);
+
+  if (!pBlendState->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pBlendState);
+    return nullptr;
+  }
+
+  return pBlendState;
+}
+
+void ezGALDeviceNull::DestroyBlendStatePlatform(ezGALBlendState* pBlendState)
+{
+  ezGALBlendStateNull* pBlendStateNull = static_cast<ezGALBlendStateNull*>(pBlendState);
+  pBlendStateNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pBlendStateNull);
+}
+
+ezGALDepthStencilState* ezGALDeviceNull::CreateDepthStencilStatePlatform(const ezGALDepthStencilStateCreationDescription& Description)
+{
+  ezGALDepthStencilStateNull* pDepthStencilState = EZ_NEW(&m_Allocator, ezGALDepthStencilStateNull, Description);
+
+  if (!pDepthStencilState->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pDepthStencilState);
+    return nullptr;
+  }
+
+  return pDepthStencilState;
+}
+
+void ezGALDeviceNull::DestroyDepthStencilStatePlatform(ezGALDepthStencilState* pDepthStencilState)
+{
+  ezGALDepthStencilStateNull* pDepthStencilStateNull = static_cast<ezGALDepthStencilStateNull*>(pDepthStencilState);
+  pDepthStencilStateNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pDepthStencilStateNull);
+}
+
+ezGALRasterizerState* ezGALDeviceNull::CreateRasterizerStatePlatform(const ezGALRasterizerStateCreationDescription& Description)
+{
+  ezGALRasterizerStateNull* pRasterizerState = EZ_NEW(&m_Allocator, ezGALRasterizerStateNull, Description);
+
+  if (!pRasterizerState->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pRasterizerState);
+    return nullptr;
+  }
+
+  return pRasterizerState;
+}
+
+void ezGALDeviceNull::DestroyRasterizerStatePlatform(ezGALRasterizerState* pRasterizerState)
+{
+  ezGALRasterizerStateNull* pRasterizerStateNull = static_cast<ezGALRasterizerStateNull*>(pRasterizerState);
+  pRasterizerStateNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pRasterizerStateNull);
+}
+
+ezGALSamplerState* ezGALDeviceNull::CreateSamplerStatePlatform(const ezGALSamplerStateCreationDescription& Description)
+{
+  ezGALSamplerStateNull* pSamplerState = EZ_NEW(&m_Allocator, ezGALSamplerStateNull, Description);
+
+  if (!pSamplerState->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pSamplerState);
+    return nullptr;
+  }
+
+  return pSamplerState;
+}
+
+void ezGALDeviceNull::DestroySamplerStatePlatform(ezGALSamplerState* pSamplerState)
+{
+  ezGALSamplerStateNull* pSamplerStateNull = static_cast<ezGALSamplerStateNull*>(pSamplerState);
+  pSamplerStateNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pSamplerStateNull);
+}
+
+
+// Resource creation functions
+
+ezGALShader* ezGALDeviceNull::CreateShaderPlatform(const ezGALShaderCreationDescription& Description)
+{
+  ezGALShaderNull* pShader = EZ_NEW(&m_Allocator, ezGALShaderNull, Description);
+
+  if (!pShader->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pShader);
+    return nullptr;
+  }
+
+  return pShader;
+}
+
+void ezGALDeviceNull::DestroyShaderPlatform(ezGALShader* pShader)
+{
+  ezGALShaderNull* pShaderNull = static_cast<ezGALShaderNull*>(pShader);
+  pShaderNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pShaderNull);
+}
+
+ezGALBuffer* ezGALDeviceNull::CreateBufferPlatform(const ezGALBufferCreationDescription& Description, ezArrayPtr<const ezUInt8> pInitialData)
+{
+  ezGALBufferNull* pBuffer = EZ_NEW(&m_Allocator, ezGALBufferNull, Description);
+
+  if (!pBuffer->InitPlatform(this, pInitialData).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pBuffer);
+    return nullptr;
+  }
+
+  return pBuffer;
+}
+
+void ezGALDeviceNull::DestroyBufferPlatform(ezGALBuffer* pBuffer)
+{
+  ezGALBufferNull* pBufferNull = static_cast<ezGALBufferNull*>(pBuffer);
+  pBufferNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pBufferNull);
+}
+
+ezGALTexture* ezGALDeviceNull::CreateTexturePlatform(const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData)
+{
+  ezGALTextureNull* pTexture = EZ_NEW(&m_Allocator, ezGALTextureNull, Description);
+
+  if (!pTexture->InitPlatform(this, pInitialData).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pTexture);
+    return nullptr;
+  }
+
+  return pTexture;
+}
+
+void ezGALDeviceNull::DestroyTexturePlatform(ezGALTexture* pTexture)
+{
+  ezGALTextureNull* pTextureNull = static_cast<ezGALTextureNull*>(pTexture);
+  pTextureNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pTextureNull);
+}
+
+ezGALTexture* ezGALDeviceNull::CreateSharedTexturePlatform(const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData, ezEnum<ezGALSharedTextureType> sharedType, ezGALPlatformSharedHandle handle)
+{
+  EZ_IGNORE_UNUSED(Description);
+  EZ_IGNORE_UNUSED(pInitialData);
+  EZ_IGNORE_UNUSED(sharedType);
+  EZ_IGNORE_UNUSED(handle);
+
+  ezLog::Error("Shared textures are not supported by the null device.");
+  return nullptr;
+}
+
+void ezGALDeviceNull::DestroySharedTexturePlatform(ezGALTexture* pTexture)
+{
+  EZ_IGNORE_UNUSED(pTexture);
+}
+
+ezGALReadbackBuffer* ezGALDeviceNull::CreateReadbackBufferPlatform(const ezGALBufferCreationDescription& Description)
+{
+  ezGALReadbackBufferNull* pReadbackBuffer = EZ_NEW(&m_Allocator, ezGALReadbackBufferNull, Description);
+
+  if (!pReadbackBuffer->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pReadbackBuffer);
+    return nullptr;
+  }
+
+  return pReadbackBuffer;
+}
+
+void ezGALDeviceNull::DestroyReadbackBufferPlatform(ezGALReadbackBuffer* pReadbackBuffer)
+{
+  ezGALReadbackBufferNull* pReadbackBufferNull = static_cast<ezGALReadbackBufferNull*>(pReadbackBuffer);
+  pReadbackBufferNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pReadbackBufferNull);
+}
+
+ezGALReadbackTexture* ezGALDeviceNull::CreateReadbackTexturePlatform(const ezGALTextureCreationDescription& Description)
+{
+  ezGALReadbackTextureNull* pReadbackTexture = EZ_NEW(&m_Allocator, ezGALReadbackTextureNull, Description);
+
+  if (!pReadbackTexture->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pReadbackTexture);
+    return nullptr;
+  }
+
+  return pReadbackTexture;
+}
+
+void ezGALDeviceNull::DestroyReadbackTexturePlatform(ezGALReadbackTexture* pReadbackTexture)
+{
+  ezGALReadbackTextureNull* pReadbackTextureNull = static_cast<ezGALReadbackTextureNull*>(pReadbackTexture);
+  pReadbackTextureNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pReadbackTextureNull);
+}
+
+ezGALTextureResourceView* ezGALDeviceNull::CreateResourceViewPlatform(ezGALTexture* pResource, const ezGALTextureResourceViewCreationDescription& Description)
+{
+  ezGALTextureResourceViewNull* pResourceView = EZ_NEW(&m_Allocator, ezGALTextureResourceViewNull, pResource, Description);
+
+  if (!pResourceView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pResourceView);
+    return nullptr;
+  }
+
+  return pResourceView;
+}
+
+void ezGALDeviceNull::DestroyResourceViewPlatform(ezGALTextureResourceView* pResourceView)
+{
+  ezGALTextureResourceViewNull* pResourceViewNull = static_cast<ezGALTextureResourceViewNull*>(pResourceView);
+  pResourceViewNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pResourceViewNull);
+}
+
+ezGALBufferResourceView* ezGALDeviceNull::CreateResourceViewPlatform(ezGALBuffer* pResource, const ezGALBufferResourceViewCreationDescription& Description)
+{
+  ezGALBufferResourceViewNull* pResourceView = EZ_NEW(&m_Allocator, ezGALBufferResourceViewNull, pResource, Description);
+
+  if (!pResourceView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pResourceView);
+    return nullptr;
+  }
+
+  return pResourceView;
+}
+
+void ezGALDeviceNull::DestroyResourceViewPlatform(ezGALBufferResourceView* pResourceView)
+{
+  ezGALBufferResourceViewNull* pResourceViewNull = static_cast<ezGALBufferResourceViewNull*>(pResourceView);
+  pResourceViewNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pResourceViewNull);
+}
+
+ezGALRenderTargetView* ezGALDeviceNull::CreateRenderTargetViewPlatform(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description)
+{
+  ezGALRenderTargetViewNull* pRenderTargetView = EZ_NEW(&m_Allocator, ezGALRenderTargetViewNull, pTexture, Description);
+
+  if (!pRenderTargetView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pRenderTargetView);
+    return nullptr;
+  }
+
+  return pRenderTargetView;
+}
+
+void ezGALDeviceNull::DestroyRenderTargetViewPlatform(ezGALRenderTargetView* pRenderTargetView)
+{
+  ezGALRenderTargetViewNull* pRenderTargetViewNull = static_cast<ezGALRenderTargetViewNull*>(pRenderTargetView);
+  pRenderTargetViewNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pRenderTargetViewNull);
+}
+
+ezGALTextureUnorderedAccessView* ezGALDeviceNull::CreateUnorderedAccessViewPlatform(ezGALTexture* pResource, const ezGALTextureUnorderedAccessViewCreationDescription& Description)
+{
+  ezGALTextureUnorderedAccessViewNull* pUnorderedAccessView = EZ_NEW(&m_Allocator, ezGALTextureUnorderedAccessViewNull, pResource, Description);
+
+  if (!pUnorderedAccessView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pUnorderedAccessView);
+    return nullptr;
+  }
+
+  return pUnorderedAccessView;
+}
+
+void ezGALDeviceNull::DestroyUnorderedAccessViewPlatform(ezGALTextureUnorderedAccessView* pUnorderedAccessView)
+{
+  ezGALTextureUnorderedAccessViewNull* pUnorderedAccessViewNull = static_cast<ezGALTextureUnorderedAccessViewNull*>(pUnorderedAccessView);
+  pUnorderedAccessViewNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pUnorderedAccessViewNull);
+}
+
+ezGALBufferUnorderedAccessView* ezGALDeviceNull::CreateUnorderedAccessViewPlatform(ezGALBuffer* pResource, const ezGALBufferUnorderedAccessViewCreationDescription& Description)
+{
+  ezGALBufferUnorderedAccessViewNull* pUnorderedAccessView = EZ_NEW(&m_Allocator, ezGALBufferUnorderedAccessViewNull, pResource, Description);
+
+  if (!pUnorderedAccessView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pUnorderedAccessView);
+    return nullptr;
+  }
+
+  return pUnorderedAccessView;
+}
+
+void ezGALDeviceNull::DestroyUnorderedAccessViewPlatform(ezGALBufferUnorderedAccessView* pUnorderedAccessView)
+{
+  ezGALBufferUnorderedAccessViewNull* pUnorderedAccessViewNull = static_cast<ezGALBufferUnorderedAccessViewNull*>(pUnorderedAccessView);
+  pUnorderedAccessViewNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pUnorderedAccessViewNull);
+}
+
+
+// Other rendering creation functions
+
+ezGALVertexDeclaration* ezGALDeviceNull::CreateVertexDeclarationPlatform(const ezGALVertexDeclarationCreationDescription& Description)
+{
+  ezGALVertexDeclarationNull* pVertexDeclaration = EZ_NEW(&m_Allocator, ezGALVertexDeclarationNull, Description);
+
+  if (!pVertexDeclaration->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pVertexDeclaration);
+    return nullptr;
+  }
+
+  return pVertexDeclaration;
+}
+
+void ezGALDeviceNull::DestroyVertexDeclarationPlatform(ezGALVertexDeclaration* pVertexDeclaration)
+{
+  ezGALVertexDeclarationNull* pVertexDeclarationNull = static_cast<ezGALVertexDeclarationNull*>(pVertexDeclaration);
+  pVertexDeclarationNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pVertexDeclarationNull);
+}
+
+// GPU -> CPU query functions
+
+ezGALTimestampHandle ezGALDeviceNull::InsertTimestamp()
+{
+  const ezUInt64 uiTimestamp = m_uiNextTimestamp++;
+  const ezUInt32 uiSlot = static_cast<ezUInt32>(uiTimestamp % MaxTimestamps);
+
+  m_Timestamps[uiSlot] = ezTime::Now();
+  return ezGALTimestampHandle(uiSlot, uiTimestamp);
+}
+
+ezGALOcclusionHandle ezGALDeviceNull::CreateOcclusionQuery()
+{
+  return ezGALOcclusionHandle(0, m_uiNextOcclusionQuery++);
+}
+
+ezGALFenceHandle ezGALDeviceNull::InsertFence()
+{
+  return ++m_uiLastFence;
+}
+
+ezEnum<ezGALAsyncResult> ezGALDeviceNull::GetTimestampResultPlatform(ezGALTimestampHandle hTimestamp, ezTime& out_result)
+{
+  // the slot has already been reused by a newer timestamp
+  if (hTimestamp.m_Generation + MaxTimestamps < m_uiNextTimestamp)
+    return ezGALAsyncResult::Expired;
+
+  out_result = m_Timestamps[hTimestamp.m_InstanceIndex];
+  return ezGALAsyncResult::Ready;
+}
+
+ezEnum<ezGALAsyncResult> ezGALDeviceNull::GetOcclusionResultPlatform(ezGALOcclusionHandle hOcclusion, ezUInt64& out_uiResult)
+{
+  EZ_IGNORE_UNUSED(hOcclusion);
+
+  // nothing is ever rendered, so treat everything as visible to not cull anything that depends on the query
+  out_uiResult = 1;
+  return ezGALAsyncResult::Ready;
+}
+
+ezEnum<ezGALAsyncResult> ezGALDeviceNull::GetFenceResultPlatform(ezGALFenceHandle hFence, ezTime timeout)
+{
+  EZ_IGNORE_UNUSED(timeout);
+
+  return hFence <= m_uiLastFence ? ezGALAsyncResult::Ready : ezGALAsyncResult::Expired;
+}
+
+ezResult ezGALDeviceNull::LockBufferPlatform(const ezGALReadbackBuffer* pBuffer, ezArrayPtr<const ezUInt8>& out_Memory) const
+{
+  out_Memory = static_cast<const ezGALReadbackBufferNull*>(pBuffer)->GetData();
+  return EZ_SUCCESS;
+}
+
+void ezGALDeviceNull::UnlockBufferPlatform(const ezGALReadbackBuffer* pBuffer) const
+{
+  EZ_IGNORE_UNUSED(pBuffer);
+}
+
+ezResult ezGALDeviceNull::LockTexturePlatform(const ezGALReadbackTexture* pTexture, const ezArrayPtr<const ezGALTextureSubresource>& subResources, ezDynamicArray<ezGALSystemMemoryDescription>& out_Memory) const
+{
+  const ezGALReadbackTextureNull* pNullTexture = static_cast<const ezGALReadbackTextureNull*>(pTexture);
+  const ezArrayPtr<const ezUInt8> data = pNullTexture->GetData();
+
+  out_Memory.Clear();
+  out_Memory.Reserve(subResources.GetCount());
+
+  for (const ezGALTextureSubresource& subRes : subResources)
+  {
+    const ezGALReadbackTextureNull::SubResource& layout = pNullTexture->GetSubResource(pNullTexture->GetSubResourceIndex(subRes));
+
+    ezGALSystemMemoryDescription& memDesc = out_Memory.ExpandAndGetRef();
+    memDesc.m_pData = ezMakeByteBlobPtr(data.GetPtr() + layout.m_uiOffset, layout.m_uiSize);
+    memDesc.m_uiRowPitch = layout.m_uiRowPitch;
+    memDesc.m_uiSlicePitch = layout.m_uiSlicePitch;
+  }
+
+  return EZ_SUCCESS;
+}
+
+void ezGALDeviceNull::UnlockTexturePlatform(const ezGALReadbackTexture* pTexture, const ezArrayPtr<const ezGALTextureSubresource>& subResources) const
+{
+  EZ_IGNORE_UNUSED(pTexture);
+  EZ_IGNORE_UNUSED(subResources);
+}
+
+// Misc functions
+
+void ezGALDeviceNull::BeginFramePlatform(ezArrayPtr<ezGALSwapChain*> swapchains, const ezUInt64 uiAppFrame)
+{
+  EZ_IGNORE_UNUSED(uiAppFrame);
+
+  for (ezGALSwapChain* pSwapChain : swapchains)
+  {
+    pSwapChain->AcquireNextRenderTarget(this);
+  }
+}
+
+void ezGALDeviceNull::EndFramePlatform(ezArrayPtr<ezGALSwapChain*> swapchains)
+{
+  for (ezGALSwapChain* pSwapChain : swapchains)
+  {
+    pSwapChain->PresentRenderTarget(this);
+  }
+
+  m_pCommandEncoderImpl->EndFrame();
+
+  // there is no GPU that could still be working on the frame
+  m_uiSafeFrame = m_uiFrameCounter;
+  ++m_uiFrameCounter;
+}
+
+ezUInt64 ezGALDeviceNull::GetCurrentFramePlatform() const
+{
+  return m_uiFrameCounter;
+}
+
+ezUInt64 ezGALDeviceNull::GetSafeFramePlatform() const
+{
+  return m_uiSafeFrame;
+}
+
+void ezGALDeviceNull::FillCapabilitiesPlatform()
+{
+  m_Capabilities.m_sAdapterName = "Null Device";
+  m_Capabilities.m_bHardwareAccelerated = false;
+
+  m_Capabilities.m_bSupportsMultithreadedResourceCreation = true;
+  m_Capabilities.m_bSupportsNoOverwriteBufferUpdate = true;
+
+  for (ezUInt32 i = 0; i < ezGALShaderStage::ENUM_COUNT; ++i)
+  {
+    m_Capabilities.m_bShaderStageSupported[i] = true;
+  }
+
+  m_Capabilities.m_bSupportsIndirectDraw = true;
+  m_Capabilities.m_bSupportsConservativeRasterization = true;
+  m_Capabilities.m_bSupportsVSRenderTargetArrayIndex = true;
+  m_Capabilities.m_bSupportsTexelBuffer = true;
+  m_Capabilities.m_bSupportsMultiSampledArrays = true;
+  m_Capabilities.m_uiMaxPushConstantsSize = 128;
+  m_Capabilities.m_bSupportsSharedTextures = false;
+
+  // nothing is ever sampled or rendered, so every format can be used for everything
+  m_Capabilities.m_FormatSupport.SetCount(ezGALResourceFormat::ENUM_COUNT);
+  for (ezUInt32 i = 0; i < ezGALResourceFormat::ENUM_COUNT; i++)
+  {
+    m_Capabilities.m_FormatSupport[i] = ezGALResourceFormatSupport::Texture | ezGALResourceFormatSupport::RenderTarget | ezGALResourceFormatSupport::TextureRW | ezGALResourceFormatSupport::MSAA2x | ezGALResourceFormatSupport::MSAA4x | ezGALResourceFormatSupport::MSAA8x | ezGALResourceFormatSupport::VertexAttribute;
+  }
+}
+
+void ezGALDeviceNull::WaitIdlePlatform()
+{
+}
+
+const ezGALSharedTexture* ezGALDeviceNull::GetSharedTexture(ezGALTextureHandle hTexture) const
+{
+  EZ_IGNORE_UNUSED(hTexture);
+  return nullptr;
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Device_Implementation_DeviceNull);
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <RendererFoundation/Descriptors/Descriptors.h>
+#include <RendererFoundation/Device/SwapChain.h>
+#include <RendererNull/RendererNullDLL.h>
+
+/// \brief A window swap chain of the null device. Nothing is ever presented, the back buffer is a regular null texture with the size of the window.
+class EZ_RENDERERNULL_DLL ezGALSwapChainNull : public ezGALWindowSwapChain
+{
+public:
+  virtual void AcquireNextRenderTarget(ezGALDevice* pDevice) override;
+  virtual void PresentRenderTarget(ezGALDevice* pDevice) override;
+  virtual ezResult UpdateSwapChain(ezGALDevice* pDevice, ezEnum<ezGALPresentMode> newPresentMode) override;
+
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALSwapChainNull(const ezGALWindowSwapChainCreationDescription& Description);
+  virtual ~ezGALSwapChainNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+
+  ezResult CreateBackBufferInternal(ezGALDevice* pDevice);
+  void DestroyBackBufferInternal(ezGALDevice* pDevice);
+
+  ezGALTextureHandle m_hBackBufferTexture;
+  ezEnum<ezGALPresentMode> m_CurrentPresentMode;
+};
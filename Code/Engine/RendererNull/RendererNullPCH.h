@@ -0,0 +1,5 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Logging/Log.h>
+#include <RendererNull/RendererNullDLL.h>
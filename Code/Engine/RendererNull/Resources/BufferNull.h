@@ -0,0 +1,28 @@
+#pragma once
+
+#include <RendererFoundation/Resources/Buffer.h>
+#include <RendererNull/RendererNullDLL.h>
+
+/// \brief A buffer of the null device. The buffer content is kept in system memory, so that updates, copies and readbacks behave as on a real device.
+class EZ_RENDERERNULL_DLL ezGALBufferNull : public ezGALBuffer
+{
+public:
+  ezArrayPtr<const ezUInt8> GetData() const { return m_Data; }
+
+  /// \brief Writes into the buffer content. The content is GPU state, which is modified through const objects, just like on the other devices.
+  void WriteData(ezUInt32 uiOffset, ezArrayPtr<const ezUInt8> data) const;
+
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALBufferNull(const ezGALBufferCreationDescription& Description);
+  virtual ~ezGALBufferNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice, ezArrayPtr<const ezUInt8> pInitialData) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+  virtual void SetDebugNamePlatform(const char* szName) const override;
+
+protected:
+  mutable ezDynamicArray<ezUInt8> m_Data;
+};
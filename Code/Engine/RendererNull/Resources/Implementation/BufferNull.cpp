@@ -0,0 +1,44 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererNull/Resources/BufferNull.h>
+
+ezGALBufferNull::ezGALBufferNull(const ezGALBufferCreationDescription& Description)
+  : ezGALBuffer(Description)
+{
+}
+
+ezGALBufferNull::~ezGALBufferNull() = default;
+
+void ezGALBufferNull::WriteData(ezUInt32 uiOffset, ezArrayPtr<const ezUInt8> data) const
+{
+  EZ_ASSERT_DEBUG(uiOffset + data.GetCount() <= m_Data.GetCount(), "Buffer write out of bounds");
+  ezMemoryUtils::Copy(m_Data.GetData() + uiOffset, data.GetPtr(), data.GetCount());
+}
+
+ezResult ezGALBufferNull::InitPlatform(ezGALDevice* pDevice, ezArrayPtr<const ezUInt8> pInitialData)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+
+  m_Data.SetCount(m_Description.m_uiTotalSize);
+
+  if (!pInitialData.IsEmpty())
+  {
+    WriteData(0, pInitialData.GetSubArray(0, ezMath::Min(pInitialData.GetCount(), m_Data.GetCount())));
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALBufferNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+
+  m_Data.Clear();
+  m_Data.Compact();
+  return EZ_SUCCESS;
+}
+
+void ezGALBufferNull::SetDebugNamePlatform(const char* szName) const
+{
+  EZ_IGNORE_UNUSED(szName);
+}
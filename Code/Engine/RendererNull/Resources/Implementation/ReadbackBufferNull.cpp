@@ -0,0 +1,38 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererNull/Resources/ReadbackBufferNull.h>
+
+ezGALReadbackBufferNull::ezGALReadbackBufferNull(const ezGALBufferCreationDescription& Description)
+  : ezGALReadbackBuffer(Description)
+{
+}
+
+ezGALReadbackBufferNull::~ezGALReadbackBufferNull() = default;
+
+void ezGALReadbackBufferNull::WriteData(ezArrayPtr<const ezUInt8> data) const
+{
+  EZ_ASSERT_DEBUG(data.GetCount() == m_Data.GetCount(), "Readback size mismatch");
+  ezMemoryUtils::Copy(m_Data.GetData(), data.GetPtr(), data.GetCount());
+}
+
+ezResult ezGALReadbackBufferNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+
+  m_Data.SetCount(m_Description.m_uiTotalSize);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALReadbackBufferNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+
+  m_Data.Clear();
+  m_Data.Compact();
+  return EZ_SUCCESS;
+}
+
+void ezGALReadbackBufferNull::SetDebugNamePlatform(const char* szName) const
+{
+  EZ_IGNORE_UNUSED(szName);
+}
@@ -0,0 +1,75 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererNull/Resources/ReadbackTextureNull.h>
+
+ezGALReadbackTextureNull::ezGALReadbackTextureNull(const ezGALTextureCreationDescription& Description)
+  : ezGALReadbackTexture(Description)
+{
+}
+
+ezGALReadbackTextureNull::~ezGALReadbackTextureNull() = default;
+
+void ezGALReadbackTextureNull::ClearData() const
+{
+  ezMemoryUtils::ZeroFill(m_Data.GetData(), m_Data.GetCount());
+}
+
+ezResult ezGALReadbackTextureNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+
+  const ezGALResourceFormat::Enum format = m_Description.m_Format;
+  const ezUInt32 uiBitsPerElement = ezGALResourceFormat::GetBitsPerElement(format);
+  const bool bBlockCompressed = ezGALResourceFormat::IsBlockCompressed(format);
+  const bool bCube = m_Description.m_Type == ezGALTextureType::TextureCube || m_Description.m_Type == ezGALTextureType::TextureCubeArray;
+  const ezUInt32 uiArrayLayers = bCube ? (m_Description.m_uiArraySize * 6) : m_Description.m_uiArraySize;
+  const ezUInt32 uiMipLevels = m_Description.m_uiMipLevelCount;
+
+  m_SubResources.Reserve(uiArrayLayers * uiMipLevels);
+
+  ezUInt32 uiOffset = 0;
+  for (ezUInt32 uiLayer = 0; uiLayer < uiArrayLayers; ++uiLayer)
+  {
+    for (ezUInt32 uiMipLevel = 0; uiMipLevel < uiMipLevels; ++uiMipLevel)
+    {
+      ezUInt32 uiWidth = ezMath::Max(m_Description.m_uiWidth >> uiMipLevel, 1u);
+      ezUInt32 uiHeight = ezMath::Max(m_Description.m_uiHeight >> uiMipLevel, 1u);
+      const ezUInt32 uiDepth = ezMath::Max(m_Description.m_uiDepth >> uiMipLevel, 1u);
+
+      ezUInt32 uiBitsPerRowElement = uiBitsPerElement;
+      if (bBlockCompressed)
+      {
+        // block compressed formats store 4x4 pixels per block
+        uiWidth = (uiWidth + 3) / 4;
+        uiHeight = (uiHeight + 3) / 4;
+        uiBitsPerRowElement = uiBitsPerElement * 16;
+      }
+
+      SubResource& subResource = m_SubResources.ExpandAndGetRef();
+      subResource.m_uiOffset = uiOffset;
+      subResource.m_uiRowPitch = (uiWidth * uiBitsPerRowElement + 7) / 8;
+      subResource.m_uiSlicePitch = subResource.m_uiRowPitch * uiHeight;
+      subResource.m_uiSize = subResource.m_uiSlicePitch * uiDepth;
+
+      uiOffset += subResource.m_uiSize;
+    }
+  }
+
+  m_Data.SetCount(uiOffset);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALReadbackTextureNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+
+  m_SubResources.Clear();
+  m_Data.Clear();
+  m_Data.Compact();
+  return EZ_SUCCESS;
+}
+
+void ezGALReadbackTextureNull::SetDebugNamePlatform(const char* szName) const
+{
+  EZ_IGNORE_UNUSED(szName);
+}
@@ -0,0 +1,22 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererNull/Resources/RenderTargetViewNull.h>
+
+ezGALRenderTargetViewNull::ezGALRenderTargetViewNull(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description)
+  : ezGALRenderTargetView(pTexture, Description)
+{
+}
+
+ezGALRenderTargetViewNull::~ezGALRenderTargetViewNull() = default;
+
+ezResult ezGALRenderTargetViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALRenderTargetViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
@@ -0,0 +1,28 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererNull/Resources/TextureNull.h>
+
+ezGALTextureNull::ezGALTextureNull(const ezGALTextureCreationDescription& Description)
+  : ezGALTexture(Description)
+{
+}
+
+ezGALTextureNull::~ezGALTextureNull() = default;
+
+ezResult ezGALTextureNull::InitPlatform(ezGALDevice* pDevice, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  EZ_IGNORE_UNUSED(pInitialData);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALTextureNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+void ezGALTextureNull::SetDebugNamePlatform(const char* szName) const
+{
+  EZ_IGNORE_UNUSED(szName);
+}
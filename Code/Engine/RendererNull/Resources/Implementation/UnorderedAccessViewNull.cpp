@@ -0,0 +1,41 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererNull/Resources/UnorderedAccessViewNull.h>
+
+ezGALTextureUnorderedAccessViewNull::ezGALTextureUnorderedAccessViewNull(ezGALTexture* pResource, const ezGALTextureUnorderedAccessViewCreationDescription& Description)
+  : ezGALTextureUnorderedAccessView(pResource, Description)
+{
+}
+
+ezGALTextureUnorderedAccessViewNull::~ezGALTextureUnorderedAccessViewNull() = default;
+
+ezResult ezGALTextureUnorderedAccessViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALTextureUnorderedAccessViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezGALBufferUnorderedAccessViewNull::ezGALBufferUnorderedAccessViewNull(ezGALBuffer* pResource, const ezGALBufferUnorderedAccessViewCreationDescription& Description)
+  : ezGALBufferUnorderedAccessView(pResource, Description)
+{
+}
+
+ezGALBufferUnorderedAccessViewNull::~ezGALBufferUnorderedAccessViewNull() = default;
+
+ezResult ezGALBufferUnorderedAccessViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALBufferUnorderedAccessViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
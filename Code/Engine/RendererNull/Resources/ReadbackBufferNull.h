@@ -0,0 +1,27 @@
+#pragma once
+
+#include <RendererFoundation/Resources/ReadbackBuffer.h>
+#include <RendererNull/RendererNullDLL.h>
+
+class EZ_RENDERERNULL_DLL ezGALReadbackBufferNull : public ezGALReadbackBuffer
+{
+public:
+  ezArrayPtr<const ezUInt8> GetData() const { return m_Data; }
+
+  /// \brief Replaces the content with the given data, which must have the size of the readback buffer.
+  void WriteData(ezArrayPtr<const ezUInt8> data) const;
+
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALReadbackBufferNull(const ezGALBufferCreationDescription& Description);
+  ~ezGALReadbackBufferNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+  virtual void SetDebugNamePlatform(const char* szName) const override;
+
+protected:
+  mutable ezDynamicArray<ezUInt8> m_Data;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <RendererFoundation/Resources/ReadbackTexture.h>
+#include <RendererNull/RendererNullDLL.h>
+
+/// \brief A readback texture of the null device.
+///
+/// The system memory for all subresources is allocated up front. Since the null device doesn't store texture content, readbacks fill it with zeros.
+class EZ_RENDERERNULL_DLL ezGALReadbackTextureNull : public ezGALReadbackTexture
+{
+public:
+  struct SubResource
+  {
+    ezUInt32 m_uiOffset = 0;
+    ezUInt32 m_uiRowPitch = 0;
+    ezUInt32 m_uiSlicePitch = 0;
+    ezUInt32 m_uiSize = 0;
+  };
+
+  ezUInt32 GetSubResourceIndex(const ezGALTextureSubresource& subResource) const { return subResource.m_uiMipLevel + subResource.m_uiArraySlice * m_Description.m_uiMipLevelCount; }
+  const SubResource& GetSubResource(ezUInt32 uiIndex) const { return m_SubResources[uiIndex]; }
+  ezArrayPtr<const ezUInt8> GetData() const { return m_Data; }
+
+  void ClearData() const;
+
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALReadbackTextureNull(const ezGALTextureCreationDescription& Description);
+  ~ezGALReadbackTextureNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+  virtual void SetDebugNamePlatform(const char* szName) const override;
+
+protected:
+  ezDynamicArray<SubResource> m_SubResources;
+  mutable ezDynamicArray<ezUInt8> m_Data;
+};
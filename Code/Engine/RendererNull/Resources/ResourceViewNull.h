@@ -0,0 +1,30 @@
+#pragma once
+
+#include <RendererFoundation/Resources/ResourceView.h>
+#include <RendererNull/RendererNullDLL.h>
+
+class EZ_RENDERERNULL_DLL ezGALTextureResourceViewNull : public ezGALTextureResourceView
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALTextureResourceViewNull(ezGALTexture* pResource, const ezGALTextureResourceViewCreationDescription& Description);
+  ~ezGALTextureResourceViewNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALBufferResourceViewNull : public ezGALBufferResourceView
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALBufferResourceViewNull(ezGALBuffer* pResource, const ezGALBufferResourceViewCreationDescription& Description);
+  ~ezGALBufferResourceViewNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
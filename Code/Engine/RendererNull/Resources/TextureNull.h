@@ -0,0 +1,19 @@
+#pragma once
+
+#include <RendererFoundation/Resources/Texture.h>
+#include <RendererNull/RendererNullDLL.h>
+
+/// \brief A texture of the null device. Only the description is kept, the texture content is not stored.
+class EZ_RENDERERNULL_DLL ezGALTextureNull : public ezGALTexture
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALTextureNull(const ezGALTextureCreationDescription& Description);
+  ~ezGALTextureNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+  virtual void SetDebugNamePlatform(const char* szName) const override;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <RendererFoundation/Resources/UnorderedAccesView.h>
+#include <RendererNull/RendererNullDLL.h>
+
+class EZ_RENDERERNULL_DLL ezGALTextureUnorderedAccessViewNull : public ezGALTextureUnorderedAccessView
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALTextureUnorderedAccessViewNull(ezGALTexture* pResource, const ezGALTextureUnorderedAccessViewCreationDescription& Description);
+  ~ezGALTextureUnorderedAccessViewNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALBufferUnorderedAccessViewNull : public ezGALBufferUnorderedAccessView
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALBufferUnorderedAccessViewNull(ezGALBuffer* pResource, const ezGALBufferUnorderedAccessViewCreationDescription& Description);
+  ~ezGALBufferUnorderedAccessViewNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
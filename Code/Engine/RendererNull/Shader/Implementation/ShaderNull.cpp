@@ -0,0 +1,31 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererNull/Shader/ShaderNull.h>
+
+ezGALShaderNull::ezGALShaderNull(const ezGALShaderCreationDescription& Description)
+  : ezGALShader(Description)
+{
+}
+
+ezGALShaderNull::~ezGALShaderNull() = default;
+
+void ezGALShaderNull::SetDebugName(ezStringView sName) const
+{
+  EZ_IGNORE_UNUSED(sName);
+}
+
+ezResult ezGALShaderNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+
+  // the byte code may come from any shader compiler, so be as lenient as the most lenient device
+  return CreateBindingMapping(true);
+}
+
+ezResult ezGALShaderNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+
+  DestroyBindingMapping();
+  return EZ_SUCCESS;
+}
@@ -0,0 +1,22 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererNull/Shader/VertexDeclarationNull.h>
+
+ezGALVertexDeclarationNull::ezGALVertexDeclarationNull(const ezGALVertexDeclarationCreationDescription& Description)
+  : ezGALVertexDeclaration(Description)
+{
+}
+
+ezGALVertexDeclarationNull::~ezGALVertexDeclarationNull() = default;
+
+ezResult ezGALVertexDeclarationNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALVertexDeclarationNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <RendererFoundation/Shader/Shader.h>
+#include <RendererNull/RendererNullDLL.h>
+
+/// \brief A shader of the null device. The byte code is never executed, only the resource binding information is extracted from it.
+class EZ_RENDERERNULL_DLL ezGALShaderNull : public ezGALShader
+{
+public:
+  virtual void SetDebugName(ezStringView sName) const override;
+
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALShaderNull(const ezGALShaderCreationDescription& Description);
+  virtual ~ezGALShaderNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <RendererFoundation/Shader/VertexDeclaration.h>
+#include <RendererNull/RendererNullDLL.h>
+
+class EZ_RENDERERNULL_DLL ezGALVertexDeclarationNull : public ezGALVertexDeclaration
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALVertexDeclarationNull(const ezGALVertexDeclarationCreationDescription& Description);
+  ~ezGALVertexDeclarationNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
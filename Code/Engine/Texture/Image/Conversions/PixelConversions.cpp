@@ -616,6 +616,69 @@ public:
     const void* sourcePointer = source.GetPtr();
     void* targetPointer = target.GetPtr();
 
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE && EZ_SSE_LEVEL >= EZ_SSE_20
+    {
+      // Produces exactly the same results as ezFloat16, which truncates the mantissa.
+      const ezUInt32 elementsPerBatch = 8;
+
+      const __m128i absMask = _mm_set1_epi32(0x7FFFFFFF);
+      const __m128i infinity32 = _mm_set1_epi32(0x7F800000);
+      const __m128i infinity16 = _mm_set1_epi32(0x7C00);
+      const __m128i minNormal32 = _mm_set1_epi32((127 - 14) << 23);    // smallest float that is a normalized half
+      const __m128i minDenormal32 = _mm_set1_epi32((127 - 25) << 23);  // everything below becomes an unsigned zero
+      const __m128i overflow32 = _mm_set1_epi32((127 + 16) << 23);     // everything above becomes infinity
+      const __m128i exponentRebias = _mm_set1_epi32((127 - 15) << 23);
+      const __m128 denormalScale = _mm_set1_ps(16777216.0f);           // 2^24, the inverse of the smallest half denormal
+      const __m128i signMask16 = _mm_set1_epi32(0x8000);
+      const __m128i one = _mm_set1_epi32(1);
+      const __m128i packBias32 = _mm_set1_epi32(0x8000);
+      const __m128i packBias16 = _mm_set1_epi16(static_cast<short>(0x8000));
+
+      auto convert4 = [&](__m128i bits) -> __m128i
+      {
+        const __m128i absBits = _mm_and_si128(bits, absMask);
+
+        // normalized: rebias the exponent and truncate the mantissa
+        const __m128i normal = _mm_srli_epi32(_mm_sub_epi32(absBits, exponentRebias), 13);
+
+        // denormalized: the truncated value in units of the smallest half denormal
+        const __m128i denormal = _mm_cvttps_epi32(_mm_mul_ps(_mm_castsi128_ps(absBits), denormalScale));
+
+        const __m128i isDenormal = _mm_cmplt_epi32(absBits, minNormal32);
+        __m128i result = _mm_or_si128(_mm_and_si128(isDenormal, denormal), _mm_andnot_si128(isDenormal, normal));
+
+        const __m128i isOverflow = _mm_cmpgt_epi32(absBits, _mm_sub_epi32(overflow32, one));
+        result = _mm_or_si128(_mm_and_si128(isOverflow, infinity16), _mm_andnot_si128(isOverflow, result));
+
+        // NaN keeps the upper mantissa bits, but at least one of them must be set
+        const __m128i nanMantissa = _mm_srli_epi32(_mm_and_si128(absBits, _mm_set1_epi32(0x007FFFFF)), 13);
+        const __m128i nan = _mm_or_si128(_mm_or_si128(infinity16, nanMantissa), _mm_and_si128(_mm_cmpeq_epi32(nanMantissa, _mm_setzero_si128()), one));
+        const __m128i isNan = _mm_cmpgt_epi32(absBits, infinity32);
+        result = _mm_or_si128(_mm_and_si128(isNan, nan), _mm_andnot_si128(isNan, result));
+
+        // tiny values lose their sign
+        const __m128i hasSign = _mm_cmpgt_epi32(absBits, _mm_sub_epi32(minDenormal32, one));
+        const __m128i sign = _mm_and_si128(_mm_and_si128(_mm_srli_epi32(bits, 16), signMask16), hasSign);
+
+        return _mm_or_si128(result, sign);
+      };
+
+      while (uiNumElements >= elementsPerBatch)
+      {
+        const __m128i half0 = convert4(_mm_loadu_si128(static_cast<const __m128i*>(sourcePointer) + 0));
+        const __m128i half1 = convert4(_mm_loadu_si128(static_cast<const __m128i*>(sourcePointer) + 1));
+
+        // _mm_packs_epi32 saturates signed values, so shift the unsigned 16 bit values into the signed range and back
+        const __m128i packed = _mm_packs_epi32(_mm_sub_epi32(half0, packBias32), _mm_sub_epi32(half1, packBias32));
+        _mm_storeu_si128(static_cast<__m128i*>(targetPointer), _mm_xor_si128(packed, packBias16));
+
+        sourcePointer = ezMemoryUtils::AddByteOffset(sourcePointer, sourceStride * elementsPerBatch);
+        targetPointer = ezMemoryUtils::AddByteOffset(targetPointer, targetStride * elementsPerBatch);
+        uiNumElements -= elementsPerBatch;
+      }
+    }
+#endif
+
     while (uiNumElements)
     {
 
@@ -698,6 +761,33 @@ public:
     const void* sourcePointer = source.GetPtr();
     void* targetPointer = target.GetPtr();
 
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE && EZ_SSE_LEVEL >= EZ_SSE_20
+    {
+      const ezUInt32 elementsPerBatch = 16;
+
+      const __m128i zero = _mm_setzero_si128();
+      const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+
+      while (uiNumElements >= elementsPerBatch)
+      {
+        const __m128i bytes = _mm_loadu_si128(static_cast<const __m128i*>(sourcePointer));
+
+        const __m128i short0 = _mm_unpacklo_epi8(bytes, zero);
+        const __m128i short1 = _mm_unpackhi_epi8(bytes, zero);
+
+        float* targetFloats = static_cast<float*>(targetPointer);
+        _mm_storeu_ps(targetFloats + 0, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(short0, zero)), scale));
+        _mm_storeu_ps(targetFloats + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(short0, zero)), scale));
+        _mm_storeu_ps(targetFloats + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(short1, zero)), scale));
+        _mm_storeu_ps(targetFloats + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(short1, zero)), scale));
+
+        sourcePointer = ezMemoryUtils::AddByteOffset(sourcePointer, sourceStride * elementsPerBatch);
+        targetPointer = ezMemoryUtils::AddByteOffset(targetPointer, targetStride * elementsPerBatch);
+        uiNumElements -= elementsPerBatch;
+      }
+    }
+#endif
+
     while (uiNumElements)
     {
       *reinterpret_cast<float*>(targetPointer) = ezMath::ColorByteToFloat(*reinterpret_cast<const ezUInt8*>(sourcePointer));
@@ -852,6 +942,43 @@ public:
     const void* sourcePointer = source.GetPtr();
     void* targetPointer = target.GetPtr();
 
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE && EZ_SSE_LEVEL >= EZ_SSE_20
+    {
+      // Every half is exactly representable as a float, so this produces the same results as ezFloat16.
+      const ezUInt32 elementsPerBatch = 8;
+
+      const __m128i zero = _mm_setzero_si128();
+      const __m128i absMask = _mm_set1_epi32(0x7FFF);
+      const __m128i maxFinite16 = _mm_set1_epi32(0x7BFF);
+      const __m128i infinity32 = _mm_set1_epi32(0x7F800000);
+      const __m128 exponentRebias = _mm_castsi128_ps(_mm_set1_epi32((127 + 127 - 15) << 23)); // 2^112, also renormalizes denormals
+
+      auto convert4 = [&](__m128i halfs) -> __m128i
+      {
+        const __m128i absBits = _mm_and_si128(halfs, absMask);
+        const __m128i sign = _mm_slli_epi32(_mm_xor_si128(halfs, absBits), 16);
+
+        const __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(absBits, 13)), exponentRebias);
+        const __m128i infNan = _mm_and_si128(_mm_cmpgt_epi32(absBits, maxFinite16), infinity32);
+
+        return _mm_or_si128(_mm_or_si128(_mm_castps_si128(scaled), infNan), sign);
+      };
+
+      while (uiNumElements >= elementsPerBatch)
+      {
+        const __m128i halfs = _mm_loadu_si128(static_cast<const __m128i*>(sourcePointer));
+
+        __m128i* targetInts = static_cast<__m128i*>(targetPointer);
+        _mm_storeu_si128(targetInts + 0, convert4(_mm_unpacklo_epi16(halfs, zero)));
+        _mm_storeu_si128(targetInts + 1, convert4(_mm_unpackhi_epi16(halfs, zero)));
+
+        sourcePointer = ezMemoryUtils::AddByteOffset(sourcePointer, sourceStride * elementsPerBatch);
+        targetPointer = ezMemoryUtils::AddByteOffset(targetPointer, targetStride * elementsPerBatch);
+        uiNumElements -= elementsPerBatch;
+      }
+    }
+#endif
+
     while (uiNumElements)
     {
       *reinterpret_cast<float*>(targetPointer) = *reinterpret_cast<const ezFloat16*>(sourcePointer);
@@ -54,6 +54,9 @@ class EZ_TEXTURE_DLL ezImageConversionStepLinear : public ezImageConversionStep
 {
 public:
   /// \brief Converts a batch of pixels.
+  ///
+  /// Large images are split into several batches, which are converted in parallel. Implementations therefore must not rely on
+  /// receiving whole images or rows, and must not modify any shared state.
   virtual ezResult ConvertPixels(ezConstByteBlobPtr source, ezByteBlobPtr target, ezUInt64 uiNumElements, ezImageFormat::Enum sourceFormat,
     ezImageFormat::Enum targetFormat) const = 0;
 };
@@ -156,6 +159,9 @@ private:
 
   static ezResult ConvertSingleStep(const ezImageConversionStep* pStep, const ezImageView& source, ezImage& target, ezImageFormat::Enum targetFormat);
 
+  static ezResult ConvertSingleStepLinear(const ezImageConversionStepLinear* pStep, ezConstByteBlobPtr source, ezByteBlobPtr target, ezUInt64 uiNumElements,
+    ezImageFormat::Enum sourceFormat, ezImageFormat::Enum targetFormat);
+
   static ezResult ConvertSingleStepDecompress(const ezImageView& source, ezImage& target, ezImageFormat::Enum sourceFormat,
     ezImageFormat::Enum targetFormat, const ezImageConversionStep* pStep);
 
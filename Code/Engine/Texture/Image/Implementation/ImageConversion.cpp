@@ -3,6 +3,7 @@
 #include <Foundation/Containers/HashTable.h>
 #include <Foundation/Math/Math.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Texture/Image/ImageConversion.h>
 
 EZ_ENUMERABLE_CLASS_IMPLEMENTATION(ezImageConversionStep);
@@ -538,8 +539,7 @@ ezResult ezImageConversion::ConvertSingleStep(
     {
       // we have to do the computation in 64-bit otherwise it might overflow for very large textures (8k x 4k or bigger).
       ezUInt64 numElements = ezUInt64(8) * target.GetByteBlobPtr().GetCount() / (ezUInt64)ezImageFormat::GetBitsPerPixel(targetFormat);
-      return static_cast<const ezImageConversionStepLinear*>(pStep)->ConvertPixels(
-        source.GetByteBlobPtr(), target.GetByteBlobPtr(), (ezUInt32)numElements, sourceFormat, targetFormat);
+      return ConvertSingleStepLinear(static_cast<const ezImageConversionStepLinear*>(pStep), source.GetByteBlobPtr(), target.GetByteBlobPtr(), numElements, sourceFormat, targetFormat);
     }
 
     case MakeTypeKey(ezImageFormatType::LINEAR, ezImageFormatType::BLOCK_COMPRESSED):
@@ -560,6 +560,45 @@ ezResult ezImageConversion::ConvertSingleStep(
   }
 }
 
+ezResult ezImageConversion::ConvertSingleStepLinear(const ezImageConversionStepLinear* pStep, ezConstByteBlobPtr source, ezByteBlobPtr target, ezUInt64 uiNumElements, ezImageFormat::Enum sourceFormat, ezImageFormat::Enum targetFormat)
+{
+  const ezUInt32 sourceBpp = ezImageFormat::GetBitsPerPixel(sourceFormat);
+  const ezUInt32 targetBpp = ezImageFormat::GetBitsPerPixel(targetFormat);
+
+  // Linear conversions process every element independently, so large images are split into ranges of whole elements.
+  constexpr ezUInt64 uiMinElementsPerTask = 64 * 1024;
+
+  if (uiNumElements < 2 * uiMinElementsPerTask || sourceBpp % 8 != 0 || targetBpp % 8 != 0)
+  {
+    return pStep->ConvertPixels(source, target, uiNumElements, sourceFormat, targetFormat);
+  }
+
+  const ezUInt64 sourceBytesPerElement = sourceBpp / 8;
+  const ezUInt64 targetBytesPerElement = targetBpp / 8;
+
+  ezAtomicBool bFailed = false;
+
+  ezParallelForParams params;
+  params.m_uiBinSize = static_cast<ezUInt32>(uiMinElementsPerTask);
+  params.m_uiMaxTasksPerThread = 1;
+
+  ezTaskSystem::ParallelForIndexed(
+    ezUInt64(0), uiNumElements, [&](ezUInt64 uiStartElement, ezUInt64 uiEndElement)
+    {
+      const ezUInt64 uiCount = uiEndElement - uiStartElement;
+      ezConstByteBlobPtr sourceRange = source.GetSubArray(uiStartElement * sourceBytesPerElement, uiCount * sourceBytesPerElement);
+      ezByteBlobPtr targetRange = target.GetSubArray(uiStartElement * targetBytesPerElement, uiCount * targetBytesPerElement);
+
+      if (pStep->ConvertPixels(sourceRange, targetRange, uiCount, sourceFormat, targetFormat).Failed())
+      {
+        bFailed = true;
+      }
+    },
+    "ConvertImagePixels", ezTaskNesting::Never, params);
+
+  return bFailed ? EZ_FAILURE : EZ_SUCCESS;
+}
+
 ezResult ezImageConversion::ConvertSingleStepDecompress(
   const ezImageView& source, ezImage& target, ezImageFormat::Enum sourceFormat, ezImageFormat::Enum targetFormat, const ezImageConversionStep* pStep)
 {
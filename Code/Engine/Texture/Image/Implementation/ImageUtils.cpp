@@ -5,6 +5,7 @@
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/SimdMath/SimdVec4f.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Timestamp.h>
 #include <Texture/Image/ImageConversion.h>
 #include <Texture/Image/ImageEnums.h>
@@ -740,6 +741,27 @@ inline static void FilterLine(
   }
 }
 
+/// Calls func(uiLine) for all lines in [0; uiNumLines). The lines are distributed across tasks, but each task filters at least a few
+/// thousand samples, so that small images and mip levels don't pay for the task overhead.
+template <typename Func>
+static void FilterLinesParallel(ezUInt32 uiNumLines, ezUInt32 uiSamplesPerLine, const Func& func)
+{
+  constexpr ezUInt32 uiMinSamplesPerTask = 16 * 1024;
+
+  ezParallelForParams params;
+  params.m_uiBinSize = ezMath::Max(1u, uiMinSamplesPerTask / ezMath::Max(1u, uiSamplesPerLine));
+
+  ezTaskSystem::ParallelForIndexed(
+    0, uiNumLines, [&func](ezUInt32 uiStartLine, ezUInt32 uiEndLine)
+    {
+      for (ezUInt32 uiLine = uiStartLine; uiLine < uiEndLine; ++uiLine)
+      {
+        func(uiLine);
+      }
+    },
+    "FilterImageLines", ezTaskNesting::Never, params);
+}
+
 static void DownScaleFastLine(ezUInt32 uiPixelStride, const ezUInt8* pSrc, ezUInt8* pDest, ezUInt32 uiLengthIn, ezUInt32 uiStrideIn, ezUInt32 uiLengthOut, ezUInt32 uiStrideOut)
 {
   const ezUInt32 downScaleFactor = uiLengthIn / uiLengthOut;
@@ -1007,6 +1029,8 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& ref_target, e
   ezHybridArray<ezInt32, 256> firstSampleIndices;
   firstSampleIndices.Reserve(ezMath::Max(uiWidth, uiHeight, uiDepth));
 
+  const ezSimdVec4f vBorderColor(borderColor.r, borderColor.g, borderColor.b, borderColor.a);
+
   if (uiWidth != originalWidth)
   {
     ezImageFilterWeights weights(*pFilter, originalWidth, uiWidth);
@@ -1030,21 +1054,18 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& ref_target, e
     stepHeader.SetWidth(uiWidth);
     stepTarget->ResetAndAlloc(stepHeader);
 
-    for (ezUInt32 arrayIndex = 0; arrayIndex < numArrayElements; ++arrayIndex)
-    {
-      for (ezUInt32 face = 0; face < numFaces; ++face)
+    // every row is filtered independently
+    FilterLinesParallel(numArrayElements * numFaces * originalDepth * originalHeight, uiWidth, [&](ezUInt32 uiLine)
       {
-        for (ezUInt32 z = 0; z < originalDepth; ++z)
-        {
-          for (ezUInt32 y = 0; y < originalHeight; ++y)
-          {
-            const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, y, z);
-            ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, y, z);
-            FilterLine(originalWidth, filterSource, filterTarget, 1, weights, firstSampleIndices, addressModeU, ezSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a));
-          }
-        }
-      }
-    }
+        const ezUInt32 y = uiLine % originalHeight;
+        const ezUInt32 z = (uiLine / originalHeight) % originalDepth;
+        const ezUInt32 face = (uiLine / (originalHeight * originalDepth)) % numFaces;
+        const ezUInt32 arrayIndex = uiLine / (originalHeight * originalDepth * numFaces);
+
+        const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, y, z);
+        ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, y, z);
+        FilterLine(originalWidth, filterSource, filterTarget, 1, weights, firstSampleIndices, addressModeU, vBorderColor);
+      });
 
     releaseScratch(*stepSource);
     stepSource = stepTarget;
@@ -1073,21 +1094,18 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& ref_target, e
     stepHeader.SetHeight(uiHeight);
     stepTarget->ResetAndAlloc(stepHeader);
 
-    for (ezUInt32 arrayIndex = 0; arrayIndex < numArrayElements; ++arrayIndex)
-    {
-      for (ezUInt32 face = 0; face < numFaces; ++face)
+    // every column is filtered independently
+    FilterLinesParallel(numArrayElements * numFaces * originalDepth * uiWidth, uiHeight, [&](ezUInt32 uiLine)
       {
-        for (ezUInt32 z = 0; z < originalDepth; ++z)
-        {
-          for (ezUInt32 x = 0; x < uiWidth; ++x)
-          {
-            const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, 0, z);
-            ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, 0, z);
-            FilterLine(originalHeight, filterSource, filterTarget, uiWidth, weights, firstSampleIndices, addressModeV, ezSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a));
-          }
-        }
-      }
-    }
+        const ezUInt32 x = uiLine % uiWidth;
+        const ezUInt32 z = (uiLine / uiWidth) % originalDepth;
+        const ezUInt32 face = (uiLine / (uiWidth * originalDepth)) % numFaces;
+        const ezUInt32 arrayIndex = uiLine / (uiWidth * originalDepth * numFaces);
+
+        const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, 0, z);
+        ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, 0, z);
+        FilterLine(originalHeight, filterSource, filterTarget, uiWidth, weights, firstSampleIndices, addressModeV, vBorderColor);
+      });
 
     releaseScratch(*stepSource);
     stepSource = stepTarget;
@@ -1116,21 +1134,18 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& ref_target, e
     stepHeader.SetDepth(uiDepth);
     stepTarget->ResetAndAlloc(stepHeader);
 
-    for (ezUInt32 arrayIndex = 0; arrayIndex < numArrayElements; ++arrayIndex)
-    {
-      for (ezUInt32 face = 0; face < numFaces; ++face)
+    // every pixel column along the depth is filtered independently
+    FilterLinesParallel(numArrayElements * numFaces * uiHeight * uiWidth, uiDepth, [&](ezUInt32 uiLine)
       {
-        for (ezUInt32 y = 0; y < uiHeight; ++y)
-        {
-          for (ezUInt32 x = 0; x < uiWidth; ++x)
-          {
-            const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, y, 0);
-            ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, y, 0);
-            FilterLine(originalHeight, filterSource, filterTarget, uiWidth * uiHeight, weights, firstSampleIndices, addressModeW, ezSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a));
-          }
-        }
-      }
-    }
+        const ezUInt32 x = uiLine % uiWidth;
+        const ezUInt32 y = (uiLine / uiWidth) % uiHeight;
+        const ezUInt32 face = (uiLine / (uiWidth * uiHeight)) % numFaces;
+        const ezUInt32 arrayIndex = uiLine / (uiWidth * uiHeight * numFaces);
+
+        const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, y, 0);
+        ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, y, 0);
+        FilterLine(originalHeight, filterSource, filterTarget, uiWidth * uiHeight, weights, firstSampleIndices, addressModeW, vBorderColor);
+      });
 
     releaseScratch(*stepSource);
     stepSource = stepTarget;
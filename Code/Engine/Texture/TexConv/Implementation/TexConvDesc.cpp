@@ -0,0 +1,115 @@
+#include <Texture/TexturePCH.h>
+
+#include <Foundation/Algorithm/HashStream.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Texture/TexConv/TexConvDesc.h>
+
+namespace
+{
+  // bump this whenever the conversion itself changes in a way that produces different results for the same settings
+  constexpr ezUInt32 s_uiTexConvHashVersion = 1;
+
+  ezResult HashFileContent(ezStringView sFile, ezStreamWriter& inout_stream)
+  {
+    ezFileReader file;
+    if (file.Open(sFile).Failed())
+    {
+      ezLog::Error("Could not read input file '{0}'.", ezArgSensitive(sFile, "File"));
+      return EZ_FAILURE;
+    }
+
+    inout_stream << file.GetFileSize();
+
+    ezUInt8 buffer[1024 * 16];
+    while (true)
+    {
+      const ezUInt64 uiRead = file.ReadBytes(buffer, EZ_ARRAY_SIZE(buffer));
+
+      if (uiRead == 0)
+        break;
+
+      EZ_SUCCEED_OR_RETURN(inout_stream.WriteBytes(buffer, uiRead));
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  void HashImage(const ezImage& image, ezStreamWriter& inout_stream)
+  {
+    inout_stream << static_cast<ezUInt32>(image.GetImageFormat());
+    inout_stream << image.GetWidth();
+    inout_stream << image.GetHeight();
+    inout_stream << image.GetDepth();
+    inout_stream << image.GetNumMipLevels();
+    inout_stream << image.GetNumFaces();
+    inout_stream << image.GetNumArrayIndices();
+
+    const ezConstByteBlobPtr data = image.GetByteBlobPtr();
+    inout_stream.WriteBytes(data.GetPtr(), data.GetCount()).AssertSuccess();
+  }
+} // namespace
+
+ezResult ezTexConvDesc::ComputeHash(ezUInt64& out_uiHash) const
+{
+  ezHashStreamWriter64 stream;
+
+  stream << s_uiTexConvHashVersion;
+
+  stream << m_InputFiles.GetCount();
+  for (const ezString& sFile : m_InputFiles)
+  {
+    EZ_SUCCEED_OR_RETURN(HashFileContent(sFile, stream));
+  }
+
+  stream << m_InputImages.GetCount();
+  for (const ezImage& image : m_InputImages)
+  {
+    HashImage(image, stream);
+  }
+
+  stream << m_ChannelMappings.GetCount();
+  for (const ezTexConvSliceChannelMapping& mapping : m_ChannelMappings)
+  {
+    for (const ezTexConvChannelMapping& channel : mapping.m_Channel)
+    {
+      stream << channel.m_iInputImageIndex;
+      stream << static_cast<ezUInt8>(channel.m_ChannelValue);
+    }
+  }
+
+  stream << m_OutputType;
+  stream << m_TargetPlatform;
+  stream << m_uiLowResMipmaps;
+  stream << m_uiThumbnailOutputResolution;
+  stream << m_Usage;
+  stream << m_CompressionMode;
+  stream << m_uiMinResolution;
+  stream << m_uiMaxResolution;
+  stream << m_uiDownscaleSteps;
+  stream << m_MipmapMode;
+  stream << m_FilterMode;
+  stream << m_AddressModeU;
+  stream << m_AddressModeV;
+  stream << m_AddressModeW;
+  stream << m_bPreserveMipmapCoverage;
+  stream << m_fMipmapAlphaThreshold;
+  stream << m_uiDilateColor;
+  stream << m_bFlipHorizontal;
+  stream << m_bPremultiplyAlpha;
+  stream << m_fHdrExposureBias;
+  stream << m_fMaxValue;
+  stream << m_uiAssetHash;
+  stream << m_uiAssetVersion;
+  stream << m_BumpMapFilter;
+
+  stream << m_sTextureAtlasDescFile;
+  if (!m_sTextureAtlasDescFile.IsEmpty())
+  {
+    EZ_SUCCEED_OR_RETURN(HashFileContent(m_sTextureAtlasDescFile, stream));
+  }
+
+  out_uiHash = stream.GetHashValue();
+  return EZ_SUCCESS;
+}
+
+EZ_STATICLINK_FILE(Texture, Texture_TexConv_Implementation_TexConvDesc);
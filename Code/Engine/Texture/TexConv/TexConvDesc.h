@@ -34,6 +34,13 @@ class EZ_TEXTURE_DLL ezTexConvDesc
 public:
   ezTexConvDesc() = default;
 
+  /// \brief Computes a hash over all conversion settings and the content of all input files and input images.
+  ///
+  /// Descriptors with the same hash produce the same output, so this can be used as the key for caching conversion results.
+  /// Files that are only referenced from within a texture atlas description are not taken into account.
+  /// Fails if one of the input files cannot be read.
+  ezResult ComputeHash(ezUInt64& out_uiHash) const;
+
   ezHybridArray<ezString, 4> m_InputFiles;
   ezDynamicArray<ezImage> m_InputImages;
 
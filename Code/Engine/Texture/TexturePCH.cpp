@@ -20,4 +20,5 @@ EZ_STATICLINK_LIBRARY(Texture)
   EZ_STATICLINK_REFERENCE(Texture_Image_Implementation_ImageEnums);
   EZ_STATICLINK_REFERENCE(Texture_Image_Implementation_ImageFormat);
   EZ_STATICLINK_REFERENCE(Texture_TexConv_Implementation_Processor);
+  EZ_STATICLINK_REFERENCE(Texture_TexConv_Implementation_TexConvDesc);
 }
@@ -11,7 +11,7 @@ ezAiNavMeshSector::ezAiNavMeshSector()
 {
   m_FlagRequested = 0;
   m_FlagInvalidate = 0;
-  m_FlagUpdateAvailable = 0;
+  m_FlagGenerating = 0;
   m_FlagUsable = 0;
 }
 
@@ -37,6 +37,8 @@ ezAiNavMesh::ezAiNavMesh(const ezAiNavmeshConfig& navmeshConfig)
   np.maxPolys = 1 << 16;
 
   m_pNavMesh->init(&np);
+
+  m_PathSearchQueue.SetNavMesh(m_pNavMesh);
 }
 
 ezAiNavMesh::~ezAiNavMesh()
@@ -142,7 +144,7 @@ void ezAiNavMesh::InvalidateSector(SectorID sectorID, bool bRebuildAsSoonAsPossi
 
   auto& sector = it.Value();
 
-  if (sector.m_FlagInvalidate == 0 && (sector.m_FlagUsable == 1 || sector.m_FlagUpdateAvailable == 1))
+  if (sector.m_FlagInvalidate == 0 && (sector.m_FlagUsable == 1 || sector.m_FlagGenerating == 1))
   {
     if (bRebuildAsSoonAsPossible)
     {
@@ -161,13 +163,19 @@ void ezAiNavMesh::FinalizeSectorUpdates()
 {
   EZ_LOCK(m_Mutex);
 
-  for (auto sectorID : m_UpdatingSectors)
+  if (!m_UpdatingSectors.IsEmpty() || !m_UnloadingSectors.IsEmpty())
   {
-    const auto coord = CalculateSectorCoord(sectorID);
+    // cached path corridors and searches in progress may go through sectors that change now
+    m_PathSearchQueue.OnNavMeshModified();
+  }
 
-    auto& sector = m_Sectors[sectorID];
+  for (auto& update : m_UpdatingSectors)
+  {
+    const auto coord = CalculateSectorCoord(update.m_SectorID);
+
+    auto& sector = m_Sectors[update.m_SectorID];
 
-    EZ_ASSERT_DEV(sector.m_FlagUpdateAvailable == 1, "Invalid sector update state");
+    EZ_ASSERT_DEV(sector.m_FlagGenerating == 1, "Invalid sector update state");
 
     if (!sector.m_NavmeshDataCur.IsEmpty())
     {
@@ -181,9 +189,7 @@ void ezAiNavMesh::FinalizeSectorUpdates()
       }
     }
 
-    sector.m_NavmeshDataCur.Swap(sector.m_NavmeshDataNew);
-    sector.m_NavmeshDataNew.Clear();
-    sector.m_NavmeshDataNew.Compact();
+    sector.m_NavmeshDataCur.Swap(update.m_NavmeshData);
 
     if (!sector.m_NavmeshDataCur.IsEmpty())
     {
@@ -206,12 +212,14 @@ void ezAiNavMesh::FinalizeSectorUpdates()
     }
 
     sector.m_FlagInvalidate = 0;
-    sector.m_FlagUpdateAvailable = 0;
+    sector.m_FlagGenerating = 0;
     // sector.m_FlagRequested = 0; // do not reset the requested flag
   }
 
   m_UpdatingSectors.Clear();
 
+  ezHybridArray<SectorID, 8> stillUnloading;
+
   for (auto sectorID : m_UnloadingSectors)
   {
     auto& sector = m_Sectors[sectorID];
@@ -220,6 +228,13 @@ void ezAiNavMesh::FinalizeSectorUpdates()
     if (sector.m_FlagRequested == 1)
       continue;
 
+    // Sector is still being generated, unload it once that is finished.
+    if (sector.m_FlagGenerating == 1)
+    {
+      stillUnloading.PushBack(sectorID);
+      continue;
+    }
+
     if (!sector.m_NavmeshDataCur.IsEmpty())
     {
       const auto res = m_pNavMesh->removeTile(sector.m_TileRef, nullptr, nullptr);
@@ -235,20 +250,73 @@ void ezAiNavMesh::FinalizeSectorUpdates()
 
     sector.m_FlagRequested = 0;
     sector.m_FlagInvalidate = 0;
-    sector.m_FlagUpdateAvailable = 0;
     sector.m_FlagUsable = 0;
   }
 
-  m_UnloadingSectors.Clear();
+  m_UnloadingSectors.Swap(stillUnloading);
+}
+
+void ezAiNavMesh::AddPriorityPosition(const ezVec2& vPosition)
+{
+  const ezVec2I32 coord = CalculateSectorCoord(vPosition.x, vPosition.y);
+
+  // agents tend to be close to each other, so the number of distinct sectors stays small
+  if (!m_PrioritySectorCoords.Contains(coord))
+  {
+    m_PrioritySectorCoords.PushBack(coord);
+  }
+}
+
+void ezAiNavMesh::ClearPriorityPositions()
+{
+  m_PrioritySectorCoords.Clear();
 }
 
 ezAiNavMesh::SectorID ezAiNavMesh::RetrieveRequestedSector()
 {
-  if (m_RequestedSectors.IsEmpty())
+  ezUInt32 uiBestIdx = ezInvalidIndex;
+  ezInt32 iBestDistance = ezMath::MaxValue<ezInt32>();
+
+  for (ezUInt32 i = 0; i < m_RequestedSectors.GetCount(); ++i)
+  {
+    const SectorID sectorID = m_RequestedSectors[i];
+
+    // a sector that is invalidated while it is being generated stays in the queue, until the previous generation is finished
+    if (m_Sectors[sectorID].m_FlagGenerating == 1)
+      continue;
+
+    // without any priority positions, the sectors are generated in the order in which they were requested
+    if (m_PrioritySectorCoords.IsEmpty())
+    {
+      uiBestIdx = i;
+      break;
+    }
+
+    const ezVec2I32 coord = CalculateSectorCoord(sectorID);
+
+    for (const ezVec2I32& prio : m_PrioritySectorCoords)
+    {
+      const ezInt32 iDistance = ezMath::Max(ezMath::Abs(coord.x - prio.x), ezMath::Abs(coord.y - prio.y));
+
+      if (iDistance < iBestDistance)
+      {
+        iBestDistance = iDistance;
+        uiBestIdx = i;
+      }
+    }
+
+    // can't get any closer than the sector that an agent is in
+    if (iBestDistance == 0)
+      break;
+  }
+
+  if (uiBestIdx == ezInvalidIndex)
     return ezInvalidIndex;
 
-  ezAiNavMesh::SectorID id = m_RequestedSectors.PeekFront();
-  m_RequestedSectors.PopFront();
+  const SectorID id = m_RequestedSectors[uiBestIdx];
+  m_RequestedSectors.RemoveAtAndCopy(uiBestIdx);
+
+  m_Sectors[id].m_FlagGenerating = 1;
 
   return id;
 }
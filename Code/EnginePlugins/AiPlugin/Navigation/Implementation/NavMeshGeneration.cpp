@@ -308,13 +308,11 @@ static void QueryInputGeo(const ezNavmeshGeoWorldModuleInterface* pGeo, ezUInt32
 
 void ezAiNavMesh::BuildSector(SectorID sectorID, const ezNavmeshGeoWorldModuleInterface* pGeo)
 {
+  // this runs on multiple threads in parallel, so m_Sectors must not be accessed here, it may be modified on the main thread at any time
   const ezVec2I32 sectorCoord = CalculateSectorCoord(sectorID);
-  auto& sector = m_Sectors[sectorID];
-
-  EZ_ASSERT_DEV(sector.m_FlagUpdateAvailable == 0, "Shouldn't update a sector that is already being updated");
-
   const ezBoundingBox bounds = GetSectorBounds(sectorCoord, -1000, +1000);
 
+  ezDataBuffer navmeshData;
   ezAiNavMeshInputGeo inputGeo;
   {
     ezBoundingBox boundsWithBorder = bounds;
@@ -335,15 +333,15 @@ void ezAiNavMesh::BuildSector(SectorID sectorID, const ezNavmeshGeoWorldModuleIn
 
     if (polyMesh.nverts > 0 && polyMesh.npolys > 0)
     {
-      BuildDetourNavMeshData(m_NavmeshConfig, polyMesh, sector.m_NavmeshDataNew, sectorCoord).AssertSuccess();
+      BuildDetourNavMeshData(m_NavmeshConfig, polyMesh, navmeshData, sectorCoord).AssertSuccess();
     }
   }
 
   {
-    EZ_ASSERT_DEV(sector.m_FlagUpdateAvailable == 0, "Race condition in navmesh sector update");
-    sector.m_FlagUpdateAvailable = 1;
-
     EZ_LOCK(m_Mutex);
-    m_UpdatingSectors.PushBack(sectorID);
+
+    auto& update = m_UpdatingSectors.ExpandAndGetRef();
+    update.m_SectorID = sectorID;
+    update.m_NavmeshData.Swap(navmeshData);
   }
 }
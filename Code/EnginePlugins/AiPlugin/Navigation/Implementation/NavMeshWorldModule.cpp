@@ -6,6 +6,8 @@
 #include <Foundation/Configuration/CVar.h>
 
 ezCVarInt cvar_NavMeshVisualize("AI.Navmesh.Visualize", -1, ezCVarFlags::None, "Visualize the n-th navmesh.");
+ezCVarFloat cvar_PathSearchTimeBudget("AI.PathSearch.TimeBudget", 2.0f, ezCVarFlags::Save, "How many milliseconds per frame may be spent on path searches (per navmesh).");
+ezCVarInt cvar_NavMeshMaxConcurrentSectors("AI.Navmesh.MaxConcurrentSectors", 4, ezCVarFlags::Save, "How many navmesh sectors may be generated in parallel.");
 
 // clang-format off
 EZ_IMPLEMENT_WORLD_MODULE(ezAiNavMeshWorldModule);
@@ -73,16 +75,21 @@ void ezAiNavMeshWorldModule::Initialize()
     // TODO: make tile size etc configurable
     m_WorldNavMeshes[cfg.m_sName] = EZ_DEFAULT_NEW(ezAiNavMesh, cfg);
   }
-
-  m_pGenerateSectorTask = EZ_DEFAULT_NEW(ezNavMeshSectorGenerationTask);
-  m_pGenerateSectorTask->ConfigureTask("Generate Navmesh Sector", ezTaskNesting::Maybe);
 }
 
 void ezAiNavMeshWorldModule::Deinitialize()
 {
-  m_pGenerateSectorTask = nullptr;
-  ezTaskSystem::CancelGroup(m_GenerateSectorTaskID).IgnoreResult();
-  ezTaskSystem::WaitForGroup(m_GenerateSectorTaskID);
+  for (auto& task : m_GenerateSectorTasks)
+  {
+    ezTaskSystem::CancelGroup(task.m_TaskGroupID).IgnoreResult();
+  }
+
+  for (auto& task : m_GenerateSectorTasks)
+  {
+    ezTaskSystem::WaitForGroup(task.m_TaskGroupID);
+  }
+
+  m_GenerateSectorTasks.Clear();
 }
 
 ezAiNavMesh* ezAiNavMeshWorldModule::GetNavMesh(ezStringView sName)
@@ -105,12 +112,21 @@ const ezAiNavMesh* ezAiNavMeshWorldModule::GetNavMesh(ezStringView sName) const
 
 void ezAiNavMeshWorldModule::Update(const UpdateContext& ctxt)
 {
+  // the agents report their positions anew every frame
+  EZ_SCOPE_EXIT(for (auto& nm : m_WorldNavMeshes) { nm.Value()->ClearPriorityPositions(); });
+
   if (m_uiUpdateDelay > 0)
   {
     --m_uiUpdateDelay;
     return;
   }
 
+  // the path searches were queued with polygons of the current navmesh state, so process them before any sectors change
+  for (auto& nm : m_WorldNavMeshes)
+  {
+    nm.Value()->GetPathSearchQueue().ProcessRequests(ezTime::MakeFromMilliseconds(cvar_PathSearchTimeBudget.GetValue()));
+  }
+
   for (auto& nm : m_WorldNavMeshes)
   {
     nm.Value()->FinalizeSectorUpdates();
@@ -129,26 +145,48 @@ void ezAiNavMeshWorldModule::Update(const UpdateContext& ctxt)
     }
   }
 
-  if (!ezTaskSystem::IsTaskGroupFinished(m_GenerateSectorTaskID))
-    return;
+  const ezUInt32 uiMaxConcurrentSectors = ezMath::Max(cvar_NavMeshMaxConcurrentSectors.GetValue(), 1);
+
+  // tasks beyond the current limit are only kept around until they are finished
+  while (m_GenerateSectorTasks.GetCount() > uiMaxConcurrentSectors && ezTaskSystem::IsTaskGroupFinished(m_GenerateSectorTasks.PeekBack().m_TaskGroupID))
+  {
+    m_GenerateSectorTasks.PopBack();
+  }
+
+  while (m_GenerateSectorTasks.GetCount() < uiMaxConcurrentSectors)
+  {
+    auto& task = m_GenerateSectorTasks.ExpandAndGetRef();
+    task.m_pTask = EZ_DEFAULT_NEW(ezNavMeshSectorGenerationTask);
+    task.m_pTask->ConfigureTask("Generate Navmesh Sector", ezTaskNesting::Maybe);
+  }
 
   auto pNavGeo = GetWorld()->GetOrCreateModule<ezNavmeshGeoWorldModuleInterface>();
   if (pNavGeo == nullptr)
     return;
 
-  for (auto& nm : m_WorldNavMeshes)
+  auto itNavMesh = m_WorldNavMeshes.GetIterator();
+
+  for (ezUInt32 i = 0; i < uiMaxConcurrentSectors && itNavMesh.IsValid(); ++i)
   {
-    auto sectorID = nm.Value()->RetrieveRequestedSector();
-    if (sectorID == ezInvalidIndex)
+    auto& task = m_GenerateSectorTasks[i];
+
+    if (!ezTaskSystem::IsTaskGroupFinished(task.m_TaskGroupID))
       continue;
 
-    m_pGenerateSectorTask->m_pWorldNavMesh = nm.Value();
-    m_pGenerateSectorTask->m_SectorID = sectorID;
-    m_pGenerateSectorTask->m_pNavGeo = pNavGeo;
+    // fill up the free tasks with the requested sectors of one navmesh after the other
+    for (; itNavMesh.IsValid(); ++itNavMesh)
+    {
+      auto sectorID = itNavMesh.Value()->RetrieveRequestedSector();
+      if (sectorID == ezInvalidIndex)
+        continue;
 
-    m_GenerateSectorTaskID = ezTaskSystem::StartSingleTask(m_pGenerateSectorTask, ezTaskPriority::LongRunning);
+      task.m_pTask->m_pWorldNavMesh = itNavMesh.Value();
+      task.m_pTask->m_SectorID = sectorID;
+      task.m_pTask->m_pNavGeo = pNavGeo;
 
-    break;
+      task.m_TaskGroupID = ezTaskSystem::StartSingleTask(task.m_pTask, ezTaskPriority::LongRunning);
+      break;
+    }
   }
 }
 
@@ -48,6 +48,9 @@ void ezAiNavigation::Update()
   if (m_pNavmesh == nullptr || m_pFilter == nullptr)
     return;
 
+  // active agents get their surrounding sectors generated first
+  m_pNavmesh->AddPriorityPosition(m_vCurrentPosition.GetAsVec2());
+
   if (m_uiReinitQueryBit)
   {
     m_uiReinitQueryBit = 0;
@@ -204,6 +207,7 @@ void ezAiNavigation::Update()
 
 void ezAiNavigation::CancelNavigation()
 {
+  m_pPathSearch = nullptr; // a queued path search is skipped, once nobody references it anymore
   m_PathCorridor.clear();
   m_uiTargetPositionChangedBit = 0; // don't start another path search
   m_State = State::Idle;
@@ -236,6 +240,13 @@ void ezAiNavigation::SetNavmesh(ezAiNavMesh* pNavmesh)
 
   m_pNavmesh = pNavmesh;
   m_uiReinitQueryBit = 1;
+
+  if (m_State == State::Searching)
+  {
+    // the path search was queued on the previous navmesh
+    m_pPathSearch = nullptr;
+    m_State = State::StartNewSearch;
+  }
 }
 
 void ezAiNavigation::SetQueryFilter(const dtQueryFilter& filter)
@@ -303,63 +314,60 @@ bool ezAiNavigation::UpdatePathSearch()
     }
 
     m_vPathSearchTargetPos = m_vTargetPosition;
-    if (dtStatusFailed(m_Query.initSlicedFindPath(startRef, m_PathSearchTargetPoly, ezRcPos(m_vCurrentPosition), ezRcPos(m_vTargetPosition), m_pFilter)))
+
+    // a request that is still referenced by the queue can't be reused, it would get processed twice
+    if (m_pPathSearch == nullptr || m_pPathSearch->GetRefCount() > 1)
     {
-      m_State = State::NoPathFound;
-      EZ_REPORT_FAILURE("Detour: initSlicedFindPath failed.");
-      return false;
+      m_pPathSearch = EZ_DEFAULT_NEW(ezAiPathSearchRequest);
     }
 
+    m_pPathSearch->m_pFilter = m_pFilter;
+    m_pPathSearch->m_StartPoly = startRef;
+    m_pPathSearch->m_EndPoly = m_PathSearchTargetPoly;
+    m_pPathSearch->m_vStartPosition = m_vCurrentPosition;
+    m_pPathSearch->m_vEndPosition = m_vTargetPosition;
+    m_pNavmesh->GetPathSearchQueue().AddRequest(m_pPathSearch);
+
     m_State = State::Searching;
     return false;
   }
 
   if (m_State == State::Searching)
   {
-    const int iMaxIterations = 32;
-    int iIterationsDone = 0;
-    dtStatus res = m_Query.updateSlicedFindPath(iMaxIterations, &iIterationsDone);
-
-    if (dtStatusInProgress(res))
-    {
-      // still searching
-      return false;
-    }
-
-    if (dtStatusFailed(res))
+    switch (m_pPathSearch->GetState())
     {
-      m_State = State::NoPathFound;
-      return false;
-    }
+      case ezAiPathSearchState::Pending:
+        // still searching
+        return false;
+
+      case ezAiPathSearchState::NoPathFound:
+        m_pPathSearch = nullptr;
+        m_State = State::NoPathFound;
+        return false;
+
+      case ezAiPathSearchState::Invalidated:
+        // the navmesh changed in between, the start and end polygons need to be looked up again
+        m_pPathSearch = nullptr;
+        m_State = State::StartNewSearch;
+        return false;
 
-    ezInt32 iPathCorridorLength = 0;
-    dtPolyRef resultPolys[MaxPathNodes];
+      case ezAiPathSearchState::PartialPathFound:
+        // the target position cannot be reached, but we can walk close to it
+        m_State = State::PartialPathFound;
+        break;
 
-    if (dtStatusFailed(m_Query.finalizeSlicedFindPath(resultPolys, &iPathCorridorLength, (int)MaxPathNodes)))
-    {
-      m_State = State::NoPathFound;
-      EZ_REPORT_FAILURE("Detour: finalizeSlicedFindPath failed.");
-      return false;
+      case ezAiPathSearchState::FullPathFound:
+        m_State = State::FullPathFound;
+        break;
     }
 
-    // reduce to actual length
-    EZ_ASSERT_DEV(iPathCorridorLength >= 1, "Expected path corridor to have at least length 1");
-
-    if (resultPolys[iPathCorridorLength - 1] != m_PathSearchTargetPoly)
-    {
-      // if this is the case, the target position cannot be reached, but we can walk close to it
-      m_State = State::PartialPathFound;
-    }
-    else
-    {
-      m_State = State::FullPathFound;
-    }
+    const ezArrayPtr<const dtPolyRef> resultPolys = m_pPathSearch->GetPathCorridor();
 
     // the target position here may already differ from the target position when the search was started
     // so we need to use m_vPathSearchTargetPos
     // the final target position will be updated in the next Update()
     m_PathCorridor.reset(resultPolys[0], ezRcPos(m_vCurrentPosition));
-    m_PathCorridor.setCorridor(ezRcPos(m_vPathSearchTargetPos), resultPolys, (ezUInt32)iPathCorridorLength);
+    m_PathCorridor.setCorridor(ezRcPos(m_vPathSearchTargetPos), resultPolys.GetPtr(), (int)resultPolys.GetCount());
 
     m_uiOptimizeTopologyCounter = 0;
     m_uiOptimizeVisibilityCounter = 0;
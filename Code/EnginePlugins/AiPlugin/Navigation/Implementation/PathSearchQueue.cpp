@@ -0,0 +1,306 @@
+#include <AiPlugin/Navigation/Navigation.h>
+#include <AiPlugin/Navigation/PathSearchQueue.h>
+#include <DetourNavMesh.h>
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+// static
+ezUInt32 ezAiPathSearchQueue::CacheKeyHashHelper::Hash(const CacheKey& key)
+{
+  const ezUInt32 uiPolysHash = ezHashingUtils::CombineHashValues32(ezHashHelper<ezUInt64>::Hash(key.m_StartPoly), ezHashHelper<ezUInt64>::Hash(key.m_EndPoly));
+  return ezHashingUtils::CombineHashValues32(ezHashHelper<ezUInt64>::Hash(key.m_uiFilterHash), uiPolysHash);
+}
+
+// static
+ezUInt64 ezAiPathSearchQueue::ComputeFilterHash(const dtQueryFilter& filter)
+{
+  struct FilterSettings
+  {
+    float m_AreaCosts[DT_MAX_AREAS];
+    ezUInt16 m_uiIncludeFlags;
+    ezUInt16 m_uiExcludeFlags;
+  };
+
+  FilterSettings settings;
+  ezMemoryUtils::ZeroFill(&settings, 1);
+
+  for (int i = 0; i < DT_MAX_AREAS; ++i)
+  {
+    settings.m_AreaCosts[i] = filter.getAreaCost(i);
+  }
+
+  settings.m_uiIncludeFlags = filter.getIncludeFlags();
+  settings.m_uiExcludeFlags = filter.getExcludeFlags();
+
+  return ezHashingUtils::xxHash64(&settings, sizeof(settings));
+}
+
+// static
+ezAiPathSearchQueue::CacheKey ezAiPathSearchQueue::MakeCacheKey(const ezAiPathSearchRequest& request)
+{
+  CacheKey key;
+  key.m_uiFilterHash = request.m_uiFilterHash;
+  key.m_StartPoly = request.m_StartPoly;
+  key.m_EndPoly = request.m_EndPoly;
+  return key;
+}
+
+ezAiPathSearchQueue::ezAiPathSearchQueue() = default;
+ezAiPathSearchQueue::~ezAiPathSearchQueue() = default;
+
+void ezAiPathSearchQueue::SetNavMesh(const dtNavMesh* pNavMesh)
+{
+  if (m_pNavMesh == pNavMesh)
+    return;
+
+  InvalidateAllRequests();
+
+  // the queries of the slots are bound to the previous navmesh, new ones are created on demand
+  m_pNavMesh = pNavMesh;
+  m_QuerySlots.Clear();
+  m_Cache.Clear();
+}
+
+void ezAiPathSearchQueue::InvalidateAllRequests()
+{
+  for (QuerySlot& slot : m_QuerySlots)
+  {
+    if (slot.m_pActiveRequest != nullptr)
+    {
+      m_PendingRequests.PushBack(slot.m_pActiveRequest);
+      slot.m_pActiveRequest = nullptr;
+    }
+  }
+
+  for (auto& pRequest : m_PendingRequests)
+  {
+    pRequest->m_State = ezAiPathSearchState::Invalidated;
+    pRequest->m_uiPathCorridorLength = 0;
+  }
+
+  m_PendingRequests.Clear();
+}
+
+void ezAiPathSearchQueue::AddRequest(const ezSharedPtr<ezAiPathSearchRequest>& pRequest)
+{
+  EZ_ASSERT_DEBUG(pRequest->m_pFilter != nullptr, "Path search request needs a query filter");
+
+  pRequest->m_State = ezAiPathSearchState::Pending;
+  pRequest->m_uiPathCorridorLength = 0;
+  pRequest->m_uiFilterHash = ComputeFilterHash(*pRequest->m_pFilter);
+
+  m_PendingRequests.PushBack(pRequest);
+}
+
+void ezAiPathSearchQueue::OnNavMeshModified()
+{
+  m_Cache.Clear();
+
+  // the node pools of the queries may reference polygons that are removed now, so the searches in progress start over,
+  // ahead of the requests that were not started yet
+  for (ezUInt32 i = m_QuerySlots.GetCount(); i > 0; --i)
+  {
+    QuerySlot& slot = m_QuerySlots[i - 1];
+
+    if (slot.m_pActiveRequest != nullptr)
+    {
+      m_PendingRequests.PushFront(slot.m_pActiveRequest);
+      slot.m_pActiveRequest = nullptr;
+    }
+  }
+}
+
+void ezAiPathSearchQueue::ProcessRequests(ezTime maxDuration)
+{
+  if (m_pNavMesh == nullptr)
+    return;
+
+  ezUInt32 uiNumActive = 0;
+  for (QuerySlot& slot : m_QuerySlots)
+  {
+    if (slot.m_pActiveRequest == nullptr)
+      continue;
+
+    // nobody is interested in the result anymore
+    if (slot.m_pActiveRequest->GetRefCount() == 1)
+    {
+      slot.m_pActiveRequest = nullptr;
+      continue;
+    }
+
+    ++uiNumActive;
+  }
+
+  if (m_PendingRequests.IsEmpty() && uiNumActive == 0)
+    return;
+
+  EZ_PROFILE_SCOPE("ProcessPathSearches");
+
+  const ezTime tDeadline = ezTime::Now() + maxDuration;
+
+  // requests nobody is interested in anymore are dropped, and the cached ones are answered right away
+  ezUInt32 uiNumPending = 0;
+  for (ezUInt32 i = 0; i < m_PendingRequests.GetCount(); ++i)
+  {
+    auto& pRequest = m_PendingRequests[i];
+
+    if (pRequest->GetRefCount() == 1)
+      continue;
+
+    if (const CachedPath* pCached = m_Cache.GetValue(MakeCacheKey(*pRequest)))
+    {
+      pRequest->m_State = pCached->m_State;
+      pRequest->m_uiPathCorridorLength = pCached->m_PathCorridor.GetCount();
+      ezMemoryUtils::Copy(pRequest->m_PathCorridor, pCached->m_PathCorridor.GetData(), pCached->m_PathCorridor.GetCount());
+      continue;
+    }
+
+    m_PendingRequests[uiNumPending++] = pRequest;
+  }
+
+  while (m_PendingRequests.GetCount() > uiNumPending)
+  {
+    m_PendingRequests.PopBack();
+  }
+
+  if (uiNumPending + uiNumActive == 0)
+    return;
+
+  // the main thread helps out as well
+  const ezUInt32 uiNumSlots = ezMath::Min(ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks) + 1, uiNumPending + uiNumActive);
+
+  while (m_QuerySlots.GetCount() < uiNumSlots)
+  {
+    auto& pQuery = m_QuerySlots.ExpandAndGetRef().m_pQuery;
+    pQuery = EZ_DEFAULT_NEW(dtNavMeshQuery);
+    pQuery->init(m_pNavMesh, ezAiNavigation::MaxSearchNodes);
+  }
+
+  ezParallelForParams params;
+  params.m_uiBinSize = 1;
+  params.m_uiMaxTasksPerThread = 1;
+
+  // every slot continues its active search and then starts the oldest pending requests, until the time is up
+  ezAtomicInteger32 iNextRequest = 0;
+  ezTaskSystem::ParallelForIndexed(
+    0, m_QuerySlots.GetCount(), [&](ezUInt32 uiStartSlot, ezUInt32 uiEndSlot)
+    {
+      for (ezUInt32 uiSlot = uiStartSlot; uiSlot < uiEndSlot; ++uiSlot)
+      {
+        ProcessSlot(m_QuerySlots[uiSlot], iNextRequest, tDeadline);
+      }
+    },
+    "ProcessPathSearches", ezTaskNesting::Never, params);
+
+  // the started requests are either finished or active in one of the slots now
+  const ezUInt32 uiNumStarted = ezMath::Min<ezUInt32>(iNextRequest, uiNumPending);
+  for (ezUInt32 i = 0; i < uiNumStarted; ++i)
+  {
+    m_PendingRequests.PopFront();
+  }
+
+  // cache the results of the finished requests
+  for (QuerySlot& slot : m_QuerySlots)
+  {
+    for (auto& pRequest : slot.m_FinishedRequests)
+    {
+      if (pRequest->GetRefCount() == 1 || pRequest->m_State == ezAiPathSearchState::Invalidated)
+        continue;
+
+      CachedPath& cached = m_Cache[MakeCacheKey(*pRequest)];
+      cached.m_State = pRequest->m_State;
+      cached.m_PathCorridor = pRequest->GetPathCorridor();
+    }
+
+    slot.m_FinishedRequests.Clear();
+  }
+
+  // the cache is only meant to catch repeated searches, it doesn't need to remember everything
+  constexpr ezUInt32 uiMaxCachedPaths = 4096;
+  if (m_Cache.GetCount() > uiMaxCachedPaths)
+  {
+    m_Cache.Clear();
+  }
+}
+
+void ezAiPathSearchQueue::ProcessSlot(QuerySlot& ref_slot, ezAtomicInteger32& ref_iNextRequest, ezTime deadline) const
+{
+  dtNavMeshQuery& query = *ref_slot.m_pQuery;
+
+  while (true)
+  {
+    if (ref_slot.m_pActiveRequest == nullptr)
+    {
+      if (ezTime::Now() > deadline)
+        return;
+
+      const ezUInt32 uiRequest = static_cast<ezUInt32>(ref_iNextRequest.Increment() - 1);
+      if (uiRequest >= m_PendingRequests.GetCount())
+        return;
+
+      const ezSharedPtr<ezAiPathSearchRequest>& pRequest = m_PendingRequests[uiRequest];
+
+      if (!StartSearch(query, *pRequest))
+      {
+        ref_slot.m_FinishedRequests.PushBack(pRequest);
+        continue;
+      }
+
+      ref_slot.m_pActiveRequest = pRequest;
+    }
+
+    // a single search may be too long for the time budget, so it is done in slices and continued next time, if necessary
+    dtStatus res;
+    do
+    {
+      res = query.updateSlicedFindPath(MaxIterationsPerSlice, nullptr);
+    } while (dtStatusInProgress(res) && ezTime::Now() <= deadline);
+
+    if (dtStatusInProgress(res))
+      return;
+
+    FinishSearch(query, *ref_slot.m_pActiveRequest, res);
+
+    ref_slot.m_FinishedRequests.PushBack(ref_slot.m_pActiveRequest);
+    ref_slot.m_pActiveRequest = nullptr;
+  }
+}
+
+bool ezAiPathSearchQueue::StartSearch(dtNavMeshQuery& ref_query, ezAiPathSearchRequest& ref_request) const
+{
+  // the polygons were looked up before the navmesh got modified
+  if (!m_pNavMesh->isValidPolyRef(ref_request.m_StartPoly) || !m_pNavMesh->isValidPolyRef(ref_request.m_EndPoly))
+  {
+    ref_request.m_State = ezAiPathSearchState::Invalidated;
+    return false;
+  }
+
+  if (dtStatusFailed(ref_query.initSlicedFindPath(ref_request.m_StartPoly, ref_request.m_EndPoly, ezRcPos(ref_request.m_vStartPosition), ezRcPos(ref_request.m_vEndPosition), ref_request.m_pFilter)))
+  {
+    ref_request.m_State = ezAiPathSearchState::NoPathFound;
+    return false;
+  }
+
+  return true;
+}
+
+void ezAiPathSearchQueue::FinishSearch(dtNavMeshQuery& ref_query, ezAiPathSearchRequest& ref_request, dtStatus status) const
+{
+  int iPathCorridorLength = 0;
+
+  if (dtStatusFailed(status) || dtStatusFailed(ref_query.finalizeSlicedFindPath(ref_request.m_PathCorridor, &iPathCorridorLength, (int)ezAiPathSearchRequest::MaxPathNodes)) || iPathCorridorLength <= 0)
+  {
+    ref_request.m_uiPathCorridorLength = 0;
+    ref_request.m_State = ezAiPathSearchState::NoPathFound;
+    return;
+  }
+
+  ref_request.m_uiPathCorridorLength = (ezUInt32)iPathCorridorLength;
+
+  // if the corridor doesn't end at the target polygon, the target position cannot be reached, but we can walk close to it
+  if (ref_request.m_PathCorridor[iPathCorridorLength - 1] != ref_request.m_EndPoly)
+    ref_request.m_State = ezAiPathSearchState::PartialPathFound;
+  else
+    ref_request.m_State = ezAiPathSearchState::FullPathFound;
+}
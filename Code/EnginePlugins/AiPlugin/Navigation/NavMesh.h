@@ -1,6 +1,7 @@
 #pragma once
 
 #include <AiPlugin/Navigation/NavigationConfig.h>
+#include <AiPlugin/Navigation/PathSearchQueue.h>
 #include <DetourNavMesh.h>
 #include <DetourNavMeshQuery.h>
 #include <Foundation/Containers/Deque.h>
@@ -49,11 +50,10 @@ struct ezAiNavMeshSector final
 
   ezUInt8 m_FlagRequested : 1;
   ezUInt8 m_FlagInvalidate : 1;
-  ezUInt8 m_FlagUpdateAvailable : 1;
+  ezUInt8 m_FlagGenerating : 1;
   ezUInt8 m_FlagUsable : 1;
 
   ezDataBuffer m_NavmeshDataCur;
-  ezDataBuffer m_NavmeshDataNew;
   dtTileRef m_TileRef = 0;
 };
 
@@ -111,11 +111,30 @@ public:
 
   void FinalizeSectorUpdates();
 
+  /// \brief Informs the navmesh that an agent is currently at the given position.
+  ///
+  /// RetrieveRequestedSector() prefers the requested sectors that are closest to any of these positions,
+  /// so that the navmesh becomes available where agents need it first.
+  /// The positions have to be reported anew every frame, ClearPriorityPositions() is called by the ezAiNavMeshWorldModule.
+  void AddPriorityPosition(const ezVec2& vPosition);
+  void ClearPriorityPositions();
+
+  /// \brief Returns the requested sector that should be generated next and marks it as being generated.
+  ///
+  /// Sectors that are currently being generated are skipped, they will be returned again once their generation has finished.
+  /// Returns ezInvalidIndex if there is nothing to generate.
   SectorID RetrieveRequestedSector();
+
+  /// \brief Generates the navmesh data for the given sector.
+  ///
+  /// This is thread-safe and may be called for different sectors in parallel. The result is applied in FinalizeSectorUpdates().
   void BuildSector(SectorID sectorID, const ezNavmeshGeoWorldModuleInterface* pGeo);
 
   const dtNavMesh* GetDetourNavMesh() const { return m_pNavMesh; }
 
+  /// \brief The queue through which all path searches on this navmesh are done.
+  ezAiPathSearchQueue& GetPathSearchQueue() { return m_PathSearchQueue; }
+
   void DebugDraw(ezDebugRendererContext context, const ezAiNavigationConfig& config);
 
   const ezAiNavmeshConfig& GetConfig() const { return m_NavmeshConfig; }
@@ -133,9 +152,18 @@ private:
   dtNavMesh* m_pNavMesh = nullptr;
   ezMap<SectorID, ezAiNavMeshSector> m_Sectors;
   ezDeque<SectorID> m_RequestedSectors;
+  ezDynamicArray<ezVec2I32> m_PrioritySectorCoords;
+
+  struct SectorUpdate
+  {
+    SectorID m_SectorID = ezInvalidIndex;
+    ezDataBuffer m_NavmeshData;
+  };
 
   ezMutex m_Mutex;
-  ezDynamicArray<SectorID> m_UpdatingSectors;
+  ezDynamicArray<SectorUpdate> m_UpdatingSectors;
 
   ezDynamicArray<SectorID> m_UnloadingSectors;
+
+  ezAiPathSearchQueue m_PathSearchQueue;
 };
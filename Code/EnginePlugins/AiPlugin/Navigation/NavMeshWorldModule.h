@@ -9,6 +9,8 @@ class dtNavMesh;
 
 /// This world module keeps track of all the configured navmeshes (for different character types)
 /// and makes sure to build their sectors in the background.
+/// Multiple sectors are generated in parallel, the maximum number of concurrent generation tasks is set through the CVar
+/// 'AI.Navmesh.MaxConcurrentSectors'.
 ///
 /// Through this you can get access to one of the available navmeshes.
 /// Additionally, it also provides access to the different path search filters.
@@ -38,8 +40,14 @@ private:
 
   // TODO: this is a hacky solution to delay the navmesh generation until after Physics has been set up.
   ezUInt32 m_uiUpdateDelay = 10;
-  ezTaskGroupID m_GenerateSectorTaskID;
-  ezSharedPtr<ezNavMeshSectorGenerationTask> m_pGenerateSectorTask;
+
+  struct SectorGenerationTask
+  {
+    ezTaskGroupID m_TaskGroupID;
+    ezSharedPtr<ezNavMeshSectorGenerationTask> m_pTask;
+  };
+
+  ezDynamicArray<SectorGenerationTask> m_GenerateSectorTasks;
 
   ezAiNavigationConfig m_Config;
 
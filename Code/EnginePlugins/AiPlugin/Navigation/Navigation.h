@@ -27,6 +27,8 @@ struct ezAiSteeringInfo
 /// When you need a path, call SetCurrentPosition() and SetTargetPosition() to inform the
 /// system of the current position and desired target location.
 /// Then call Update() once per frame to have it compute the path.
+/// The path search itself is queued in the ezAiPathSearchQueue of the navmesh and processed asynchronously,
+/// so the result is available a frame later at the earliest.
 /// Call GetState() to figure out whether a path exists.
 /// Use ComputeAllWaypoints() to get an entire path, e.g. for visualization.
 /// For steering this is not necessary. Instead use ComputeSteeringInfo() to plan the next step.
@@ -111,6 +113,7 @@ private:
 
   dtPolyRef m_PathSearchTargetPoly;
   ezVec3 m_vPathSearchTargetPos;
+  ezSharedPtr<ezAiPathSearchRequest> m_pPathSearch;
 
   ezUInt8 m_uiOptimizeTopologyCounter = 0;
   ezUInt8 m_uiOptimizeVisibilityCounter = 0;
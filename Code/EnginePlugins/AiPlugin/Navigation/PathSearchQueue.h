@@ -0,0 +1,142 @@
+#pragma once
+
+#include <AiPlugin/AiPluginDLL.h>
+#include <DetourNavMeshQuery.h>
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Math/Vec3.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Types/RefCounted.h>
+#include <Foundation/Types/SharedPtr.h>
+#include <Foundation/Types/UniquePtr.h>
+
+class dtNavMesh;
+
+enum class ezAiPathSearchState : ezUInt8
+{
+  Pending,          ///< The request has not been processed yet.
+  FullPathFound,    ///< The path corridor leads to the end polygon.
+  PartialPathFound, ///< The end polygon can't be reached, the path corridor leads as close to it as possible.
+  NoPathFound,      ///< The path search failed.
+  Invalidated,      ///< The navmesh changed or was replaced before the search was done and the start or end polygon doesn't exist anymore. Search again.
+};
+
+/// \brief A single path search that is processed asynchronously by an ezAiPathSearchQueue.
+///
+/// Fill out the input members, pass the request to ezAiPathSearchQueue::AddRequest() and check GetState() in the following frames.
+/// To cancel a request, just release all references to it. Requests that nobody references anymore are skipped.
+/// The input must not be modified while the request is pending.
+/// A long search may take several frames. If the navmesh changes in between, the search is restarted, or it ends with
+/// ezAiPathSearchState::Invalidated, in case its polygons were removed.
+class EZ_AIPLUGIN_DLL ezAiPathSearchRequest : public ezRefCounted
+{
+public:
+  static constexpr ezUInt32 MaxPathNodes = 64;
+
+  const dtQueryFilter* m_pFilter = nullptr;
+  dtPolyRef m_StartPoly = 0;
+  dtPolyRef m_EndPoly = 0;
+  ezVec3 m_vStartPosition = ezVec3::MakeZero();
+  ezVec3 m_vEndPosition = ezVec3::MakeZero();
+
+  ezAiPathSearchState GetState() const { return m_State; }
+
+  /// \brief Returns the polygons from the start polygon to the end polygon (or as close to it as possible).
+  ///
+  /// Only valid when a path was found.
+  ezArrayPtr<const dtPolyRef> GetPathCorridor() const { return ezArrayPtr<const dtPolyRef>(m_PathCorridor, m_uiPathCorridorLength); }
+
+private:
+  friend class ezAiPathSearchQueue;
+
+  ezAiPathSearchState m_State = ezAiPathSearchState::Pending;
+  ezUInt32 m_uiPathCorridorLength = 0;
+  ezUInt64 m_uiFilterHash = 0;
+  dtPolyRef m_PathCorridor[MaxPathNodes];
+};
+
+/// \brief Batches the path searches of many agents on one navmesh and processes them on multiple threads.
+///
+/// Every ezAiNavMesh owns one queue. ezAiNavigation adds its requests here instead of searching on its own,
+/// and the ezAiNavMeshWorldModule calls ProcessRequests() once per frame, with a time budget.
+/// Each thread uses its own dtNavMeshQuery and searches in slices of MaxIterationsPerSlice iterations,
+/// so that a single long search can't exceed the time budget. It is continued in the next frame instead.
+///
+/// Path corridors are cached per query filter and start and end polygon, so repeated searches between the same places are free,
+/// until the navmesh changes and OnNavMeshModified() is called. Filters are identified by their settings, not by their address,
+/// so a filter that gets modified, or a new one that is allocated at the address of a deleted one, never hits stale entries.
+class EZ_AIPLUGIN_DLL ezAiPathSearchQueue final
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezAiPathSearchQueue);
+
+public:
+  ezAiPathSearchQueue();
+  ~ezAiPathSearchQueue();
+
+  /// \brief Sets the navmesh that all searches are done on.
+  ///
+  /// The polygons of all queued requests belong to the previous navmesh, so they are ended with ezAiPathSearchState::Invalidated.
+  void SetNavMesh(const dtNavMesh* pNavMesh);
+
+  void AddRequest(const ezSharedPtr<ezAiPathSearchRequest>& pRequest);
+
+  /// \brief Returns the number of requests that were not started yet.
+  ezUInt32 GetNumPendingRequests() const { return m_PendingRequests.GetCount(); }
+
+  /// \brief Processes pending requests in parallel, until all are done or the time budget is used up.
+  ///
+  /// Requests are started in the order in which they were added, searches that are not finished are continued next time.
+  /// Must be called on the main thread while the navmesh is not modified.
+  void ProcessRequests(ezTime maxDuration);
+
+  /// \brief Must be called whenever the navmesh was modified.
+  ///
+  /// Clears all cached path corridors and restarts the searches that are in progress, since they may reference removed polygons.
+  void OnNavMeshModified();
+
+  /// \brief How many search iterations are done at once, before the time budget is checked again.
+  static constexpr int MaxIterationsPerSlice = 32;
+
+private:
+  struct CacheKey
+  {
+    ezUInt64 m_uiFilterHash = 0;
+    dtPolyRef m_StartPoly = 0;
+    dtPolyRef m_EndPoly = 0;
+
+    bool operator==(const CacheKey& other) const { return m_uiFilterHash == other.m_uiFilterHash && m_StartPoly == other.m_StartPoly && m_EndPoly == other.m_EndPoly; }
+  };
+
+  struct CacheKeyHashHelper
+  {
+    static ezUInt32 Hash(const CacheKey& key);
+    static bool Equal(const CacheKey& a, const CacheKey& b) { return a == b; }
+  };
+
+  struct CachedPath
+  {
+    ezAiPathSearchState m_State = ezAiPathSearchState::NoPathFound;
+    ezHybridArray<dtPolyRef, 16> m_PathCorridor;
+  };
+
+  struct QuerySlot
+  {
+    ezUniquePtr<dtNavMeshQuery> m_pQuery;
+    ezSharedPtr<ezAiPathSearchRequest> m_pActiveRequest;
+    ezHybridArray<ezSharedPtr<ezAiPathSearchRequest>, 8> m_FinishedRequests;
+  };
+
+  static ezUInt64 ComputeFilterHash(const dtQueryFilter& filter);
+  static CacheKey MakeCacheKey(const ezAiPathSearchRequest& request);
+  void InvalidateAllRequests();
+  void ProcessSlot(QuerySlot& ref_slot, ezAtomicInteger32& ref_iNextRequest, ezTime deadline) const;
+  bool StartSearch(dtNavMeshQuery& ref_query, ezAiPathSearchRequest& ref_request) const;
+  void FinishSearch(dtNavMeshQuery& ref_query, ezAiPathSearchRequest& ref_request, dtStatus status) const;
+
+  const dtNavMesh* m_pNavMesh = nullptr;
+  ezDeque<ezSharedPtr<ezAiPathSearchRequest>> m_PendingRequests;
+  ezDynamicArray<QuerySlot> m_QuerySlots;
+  ezHashTable<CacheKey, CachedPath, CacheKeyHashHelper> m_Cache;
+};
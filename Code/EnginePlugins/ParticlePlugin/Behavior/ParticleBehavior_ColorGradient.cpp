@@ -131,7 +131,7 @@ void ezParticleBehavior_ColorGradient::InitializeElements(ezUInt64 uiStartIndex,
   }
 }
 
-void ezParticleBehavior_ColorGradient::Process(ezUInt64 uiNumElements)
+bool ezParticleBehavior_ColorGradient::PrepareParallelProcessing(ezUInt64 uiNumElements)
 {
   if (!GetOwnerEffect()->IsVisible())
   {
@@ -139,12 +139,41 @@ void ezParticleBehavior_ColorGradient::Process(ezUInt64 uiNumElements)
     // all particles get fully updated
     m_uiCurrentUpdateInterval = 1;
     m_uiFirstToUpdate = 0;
-    return;
+    return false;
   }
 
   if (!m_hGradient.IsValid())
-    return;
+    return false;
+
+  {
+    ezResourceLock<ezColorGradientResource> pGradient(m_hGradient, ezResourceAcquireMode::BlockTillLoaded);
+
+    if (pGradient.GetAcquireResult() == ezResourceAcquireResult::MissingFallback)
+      return false;
+  }
+
+  // all ranges of this frame update the same subset of particles
+  m_uiFrameFirstToUpdate = m_uiFirstToUpdate;
+  m_uiFrameUpdateInterval = m_uiCurrentUpdateInterval;
+
+  // adjust which index is the first to update
+  {
+    ++m_uiFirstToUpdate;
+    if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
+      m_uiFirstToUpdate = 0;
+  }
 
+  /// \todo Use level of detail to reduce the update interval further
+  /// up close, with a high interval, animations appear choppy, especially when fading stuff out at the end
+
+  // reset the update interval to the default
+  m_uiCurrentUpdateInterval = 2;
+
+  return true;
+}
+
+void ezParticleBehavior_ColorGradient::ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
+{
   EZ_PROFILE_SCOPE("PFX: Color Gradient");
 
   ezResourceLock<ezColorGradientResource> pGradient(m_hGradient, ezResourceAcquireMode::BlockTillLoaded);
@@ -154,17 +183,21 @@ void ezParticleBehavior_ColorGradient::Process(ezUInt64 uiNumElements)
 
   const ezColorGradient& gradient = pGradient->GetDescriptor().m_Gradient;
 
-  ezProcessingStreamIterator<ezColorLinear16f> itColor(m_pStreamColor, uiNumElements, 0);
+  // the first particle in this range that is updated this frame
+  const ezUInt32 uiInterval = m_uiFrameUpdateInterval;
+  const ezUInt32 uiFirstToUpdate = (m_uiFrameFirstToUpdate + uiInterval - static_cast<ezUInt32>(uiStartIndex % uiInterval)) % uiInterval;
+
+  ezProcessingStreamIterator<ezColorLinear16f> itColor(m_pStreamColor, uiNumElements, uiStartIndex);
 
   // skip the first n particles
-  itColor.Advance(m_uiFirstToUpdate);
+  itColor.Advance(uiFirstToUpdate);
 
   if (m_GradientMode == ezParticleColorGradientMode::Age)
   {
-    ezProcessingStreamIterator<ezFloat16Vec2> itLifeTime(m_pStreamLifeTime, uiNumElements, 0);
+    ezProcessingStreamIterator<ezFloat16Vec2> itLifeTime(m_pStreamLifeTime, uiNumElements, uiStartIndex);
 
     // skip the first n particles
-    itLifeTime.Advance(m_uiFirstToUpdate);
+    itLifeTime.Advance(uiFirstToUpdate);
 
     while (!itLifeTime.HasReachedEnd())
     {
@@ -185,16 +218,16 @@ void ezParticleBehavior_ColorGradient::Process(ezUInt64 uiNumElements)
       // skip the next n items
       // this is to reduce the number of particles that need to be fully evaluated,
       // since sampling the color gradient is pretty expensive
-      itLifeTime.Advance(m_uiCurrentUpdateInterval);
-      itColor.Advance(m_uiCurrentUpdateInterval);
+      itLifeTime.Advance(uiInterval);
+      itColor.Advance(uiInterval);
     }
   }
   else if (m_GradientMode == ezParticleColorGradientMode::Speed)
   {
-    ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+    ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, uiStartIndex);
 
     // skip the first n particles
-    itVelocity.Advance(m_uiFirstToUpdate);
+    itVelocity.Advance(uiFirstToUpdate);
 
     while (!itVelocity.HasReachedEnd())
     {
@@ -215,23 +248,10 @@ void ezParticleBehavior_ColorGradient::Process(ezUInt64 uiNumElements)
       // skip the next n items
       // this is to reduce the number of particles that need to be fully evaluated,
       // since sampling the color gradient is pretty expensive
-      itVelocity.Advance(m_uiCurrentUpdateInterval);
-      itColor.Advance(m_uiCurrentUpdateInterval);
+      itVelocity.Advance(uiInterval);
+      itColor.Advance(uiInterval);
     }
   }
-
-  // adjust which index is the first to update
-  {
-    ++m_uiFirstToUpdate;
-    if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
-      m_uiFirstToUpdate = 0;
-  }
-
-  /// \todo Use level of detail to reduce the update interval further
-  /// up close, with a high interval, animations appear choppy, especially when fading stuff out at the end
-
-  // reset the update interval to the default
-  m_uiCurrentUpdateInterval = 2;
 }
 
 
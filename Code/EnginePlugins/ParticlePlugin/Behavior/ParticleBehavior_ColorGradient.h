@@ -39,7 +39,9 @@ protected:
   friend class ezParticleBehaviorFactory_ColorGradient;
 
   virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
-  virtual void Process(ezUInt64 uiNumElements) override;
+  virtual bool SupportsParallelProcessing() const override { return true; }
+  virtual bool PrepareParallelProcessing(ezUInt64 uiNumElements) override;
+  virtual void ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
 
   ezProcessingStream* m_pStreamLifeTime = nullptr;
   ezProcessingStream* m_pStreamColor = nullptr;
@@ -47,4 +49,8 @@ protected:
   ezColor m_InitColor;
   ezUInt8 m_uiFirstToUpdate = 0;
   ezUInt8 m_uiCurrentUpdateInterval = 8;
+
+  // the update pattern of the current frame, used by all ranges that are processed
+  ezUInt8 m_uiFrameFirstToUpdate = 0;
+  ezUInt8 m_uiFrameUpdateInterval = 1;
 };
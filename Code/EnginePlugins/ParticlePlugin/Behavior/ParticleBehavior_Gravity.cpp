@@ -3,7 +3,7 @@
 #include <Core/Interfaces/PhysicsWorldModule.h>
 #include <Core/World/World.h>
 #include <Core/World/WorldModule.h>
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamKernels.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Time/Clock.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_Gravity.h>
@@ -73,23 +73,21 @@ void ezParticleBehavior_Gravity::CreateRequiredStreams()
   CreateStream("Velocity", ezProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
 }
 
-void ezParticleBehavior_Gravity::Process(ezUInt64 uiNumElements)
+bool ezParticleBehavior_Gravity::PrepareParallelProcessing(ezUInt64 uiNumElements)
 {
-  EZ_PROFILE_SCOPE("PFX: Gravity");
-
   const ezVec3 vGravity = m_pPhysicsModule != nullptr ? m_pPhysicsModule->GetGravity() : ezVec3(0.0f, 0.0f, -10.0f);
 
   const float tDiff = (float)m_TimeDiff.GetSeconds();
-  const ezVec3 addGravity = vGravity * m_fGravityFactor * tDiff;
+  m_vAddGravity = vGravity * m_fGravityFactor * tDiff;
 
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  return true;
+}
 
-  while (!itVelocity.HasReachedEnd())
-  {
-    itVelocity.Current() += addGravity;
+void ezParticleBehavior_Gravity::ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
+{
+  EZ_PROFILE_SCOPE("PFX: Gravity");
 
-    itVelocity.Advance();
-  }
+  ezProcessingStreamKernels::AddFloat3(m_pStreamVelocity, uiStartIndex, uiNumElements, m_vAddGravity);
 }
 
 void ezParticleBehavior_Gravity::RequestRequiredWorldModulesForCache(ezParticleWorldModule* pParticleModule)
@@ -74,7 +74,7 @@ void ezParticleBehavior_SizeCurve::InitializeElements(ezUInt64 uiStartIndex, ezU
   }
 }
 
-void ezParticleBehavior_SizeCurve::Process(ezUInt64 uiNumElements)
+bool ezParticleBehavior_SizeCurve::PrepareParallelProcessing(ezUInt64 uiNumElements)
 {
   if (!GetOwnerEffect()->IsVisible())
   {
@@ -87,12 +87,31 @@ void ezParticleBehavior_SizeCurve::Process(ezUInt64 uiNumElements)
   }
 
   if (!m_hCurve.IsValid())
-    return;
+    return false;
 
-  EZ_PROFILE_SCOPE("PFX: Size Curve");
+  {
+    ezResourceLock<ezCurve1DResource> pCurve(m_hCurve, ezResourceAcquireMode::BlockTillLoaded);
+
+    if (pCurve.GetAcquireResult() == ezResourceAcquireResult::MissingFallback)
+      return false;
+
+    if (pCurve->GetDescriptor().m_Curves.IsEmpty())
+      return false;
+  }
 
-  ezProcessingStreamIterator<ezFloat16Vec2> itLifeTime(m_pStreamLifeTime, uiNumElements, 0);
-  ezProcessingStreamIterator<ezFloat16> itSize(m_pStreamSize, uiNumElements, 0);
+  // all ranges of this frame update the same subset of particles
+  m_uiFrameFirstToUpdate = m_uiFirstToUpdate;
+
+  ++m_uiFirstToUpdate;
+  if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
+    m_uiFirstToUpdate = 0;
+
+  return true;
+}
+
+void ezParticleBehavior_SizeCurve::ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
+{
+  EZ_PROFILE_SCOPE("PFX: Size Curve");
 
   ezResourceLock<ezCurve1DResource> pCurve(m_hCurve, ezResourceAcquireMode::BlockTillLoaded);
 
@@ -104,21 +123,16 @@ void ezParticleBehavior_SizeCurve::Process(ezUInt64 uiNumElements)
 
   auto& curve = pCurve->GetDescriptor().m_Curves[0];
 
-  double fMinX, fMaxX;
-  curve.QueryExtents(fMinX, fMaxX);
+  // the first particle in this range that is updated this frame
+  const ezUInt32 uiInterval = m_uiCurrentUpdateInterval;
+  const ezUInt32 uiFirstToUpdate = (m_uiFrameFirstToUpdate + uiInterval - static_cast<ezUInt32>(uiStartIndex % uiInterval)) % uiInterval;
 
-  // skip the first n particles
-  {
-    for (ezUInt32 i = 0; i < m_uiFirstToUpdate; ++i)
-    {
-      itLifeTime.Advance();
-      itSize.Advance();
-    }
+  ezProcessingStreamIterator<ezFloat16Vec2> itLifeTime(m_pStreamLifeTime, uiNumElements, uiStartIndex);
+  ezProcessingStreamIterator<ezFloat16> itSize(m_pStreamSize, uiNumElements, uiStartIndex);
 
-    ++m_uiFirstToUpdate;
-    if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
-      m_uiFirstToUpdate = 0;
-  }
+  // skip the first n particles
+  itLifeTime.Advance(uiFirstToUpdate);
+  itSize.Advance(uiFirstToUpdate);
 
   while (!itLifeTime.HasReachedEnd())
   {
@@ -136,11 +150,8 @@ void ezParticleBehavior_SizeCurve::Process(ezUInt64 uiNumElements)
     // skip the next n items
     // this is to reduce the number of particles that need to be fully evaluated,
     // since sampling the curve is expensive
-    for (ezUInt32 i = 0; i < m_uiCurrentUpdateInterval; ++i)
-    {
-      itLifeTime.Advance();
-      itSize.Advance();
-    }
+    itLifeTime.Advance(uiInterval);
+    itSize.Advance(uiInterval);
   }
 }
 
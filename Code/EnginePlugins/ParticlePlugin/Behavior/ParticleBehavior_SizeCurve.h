@@ -32,10 +32,15 @@ public:
 
 protected:
   virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
-  virtual void Process(ezUInt64 uiNumElements) override;
+  virtual bool SupportsParallelProcessing() const override { return true; }
+  virtual bool PrepareParallelProcessing(ezUInt64 uiNumElements) override;
+  virtual void ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
 
   ezProcessingStream* m_pStreamLifeTime = nullptr;
   ezProcessingStream* m_pStreamSize = nullptr;
   ezUInt8 m_uiFirstToUpdate = 0;
   ezUInt8 m_uiCurrentUpdateInterval = 8;
+
+  // the update pattern of the current frame, used by all ranges that are processed
+  ezUInt8 m_uiFrameFirstToUpdate = 0;
 };
@@ -4,6 +4,7 @@
 #include <Core/Interfaces/WindWorldModule.h>
 #include <Core/World/World.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamKernels.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Time/Clock.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_Velocity.h>
@@ -104,48 +105,49 @@ void ezParticleBehavior_Velocity::CreateRequiredStreams()
   }
 }
 
-void ezParticleBehavior_Velocity::Process(ezUInt64 uiNumElements)
+bool ezParticleBehavior_Velocity::PrepareParallelProcessing(ezUInt64 uiNumElements)
 {
-  EZ_PROFILE_SCOPE("PFX: Velocity");
-
-  auto pOwner = GetOwnerEffect();
-
   const float tDiff = (float)m_TimeDiff.GetSeconds();
   const ezVec3 vDown = m_pPhysicsModule != nullptr ? m_pPhysicsModule->GetGravity().GetNormalized() : ezVec3(0.0f, 0.0f, -1.0f);
-  const ezSimdVec4f vRise = ezSimdConversion::ToVec3(vDown * tDiff * -m_fRiseSpeed);
+  m_vRise = vDown * tDiff * -m_fRiseSpeed;
 
   const float fFriction = ezMath::Clamp(m_fFriction, 0.0f, 100.0f);
-  const float fFrictionFactor = ezMath::Pow(0.5f, tDiff * fFriction);
+  m_fFrictionFactor = ezMath::Pow(0.5f, tDiff * fFriction);
+
+  m_fWindFactor = m_fWindInfluence * tDiff;
 
-  ezProcessingStreamIterator<ezSimdVec4f> itPosition(m_pStreamPosition, uiNumElements, 0);
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  return true;
+}
+
+void ezParticleBehavior_Velocity::ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
+{
+  EZ_PROFILE_SCOPE("PFX: Velocity");
+
+  auto pOwner = GetOwnerEffect();
+
+  const ezSimdVec4f vRise = ezSimdConversion::ToVec3(m_vRise);
 
   if (m_fWindInfluence > 0)
   {
-    const ezSimdFloat fWindFactor = m_fWindInfluence * tDiff;
+    const ezSimdFloat fWindFactor = m_fWindFactor;
+
+    ezProcessingStreamIterator<ezSimdVec4f> itPosition(m_pStreamPosition, uiNumElements, uiStartIndex);
 
     while (!itPosition.HasReachedEnd())
     {
       ezSimdVec4f addPos = vRise + pOwner->GetWindAt(itPosition.Current()) * fWindFactor;
 
       itPosition.Current() += addPos;
-      itVelocity.Current() *= fFrictionFactor;
 
       itPosition.Advance();
-      itVelocity.Advance();
     }
   }
   else
   {
-    while (!itPosition.HasReachedEnd())
-    {
-      itPosition.Current() += vRise;
-      itVelocity.Current() *= fFrictionFactor;
-
-      itPosition.Advance();
-      itVelocity.Advance();
-    }
+    ezProcessingStreamKernels::AddFloat4(m_pStreamPosition, uiStartIndex, uiNumElements, vRise);
   }
+
+  ezProcessingStreamKernels::MulFloat3(m_pStreamVelocity, uiStartIndex, uiNumElements, m_fFrictionFactor);
 }
 
 void ezParticleBehavior_Velocity::RequestRequiredWorldModulesForCache(ezParticleWorldModule* pParticleModule)
@@ -41,7 +41,9 @@ public:
 protected:
   friend class ezParticleBehaviorFactory_Velocity;
 
-  virtual void Process(ezUInt64 uiNumElements) override;
+  virtual bool SupportsParallelProcessing() const override { return true; }
+  virtual bool PrepareParallelProcessing(ezUInt64 uiNumElements) override;
+  virtual void ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
 
   void RequestRequiredWorldModulesForCache(ezParticleWorldModule* pParticleModule) override;
 
@@ -50,4 +52,8 @@ protected:
 
   ezProcessingStream* m_pStreamPosition;
   ezProcessingStream* m_pStreamVelocity;
+
+  ezVec3 m_vRise;
+  float m_fFrictionFactor = 1.0f;
+  float m_fWindFactor = 0.0f;
 };
@@ -103,7 +103,7 @@ void ezParticleFinalizer_Age::InitializeElements(ezUInt64 uiStartIndex, ezUInt64
   }
 }
 
-void ezParticleFinalizer_Age::Process(ezUInt64 uiNumElements)
+void ezParticleFinalizer_Age::ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
 {
   EZ_PROFILE_SCOPE("PFX: Age");
 
@@ -111,17 +111,21 @@ void ezParticleFinalizer_Age::Process(ezUInt64 uiNumElements)
 
   const float tDiff = (float)m_TimeDiff.GetSeconds();
 
-  for (ezUInt32 i = 0; i < uiNumElements; ++i)
+  for (ezUInt64 i = uiStartIndex; i < uiStartIndex + uiNumElements; ++i)
   {
-    pLifeTime[i].x = pLifeTime[i].x - tDiff;
+    // converting from and to half precision is the expensive part, so only do each once
+    const ezFloat16 fRemaining = pLifeTime[i].x - tDiff;
 
-    if (pLifeTime[i].x <= 0)
+    if (fRemaining.GetRawData() == 0 || (fRemaining.GetRawData() & 0x8000) != 0)
     {
       pLifeTime[i].x = 0;
 
-      /// \todo Get current element index from iterator ?
       m_pStreamGroup->RemoveElement(i);
     }
+    else
+    {
+      pLifeTime[i].x = fRemaining;
+    }
   }
 }
 
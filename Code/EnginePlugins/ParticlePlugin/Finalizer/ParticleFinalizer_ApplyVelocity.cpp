@@ -1,7 +1,7 @@
 #include <ParticlePlugin/ParticlePluginPCH.h>
 
 #include <Core/World/World.h>
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamKernels.h>
 #include <Foundation/Math/Declarations.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <ParticlePlugin/Finalizer/ParticleFinalizer_ApplyVelocity.h>
@@ -40,24 +40,13 @@ void ezParticleFinalizer_ApplyVelocity::CreateRequiredStreams()
   CreateStream("Velocity", ezProcessingStream::DataType::Float3, &m_pStreamVelocity, false);
 }
 
-void ezParticleFinalizer_ApplyVelocity::Process(ezUInt64 uiNumElements)
+void ezParticleFinalizer_ApplyVelocity::ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
 {
   EZ_PROFILE_SCOPE("PFX: ApplyVelocity");
 
   const float tDiff = (float)m_TimeDiff.GetSeconds();
 
-  ezProcessingStreamIterator<ezVec4> itPosition(m_pStreamPosition, uiNumElements, 0);
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
-
-  while (!itPosition.HasReachedEnd())
-  {
-    ezVec3& pos = reinterpret_cast<ezVec3&>(itPosition.Current());
-
-    pos += itVelocity.Current() * tDiff;
-
-    itPosition.Advance();
-    itVelocity.Advance();
-  }
+  ezProcessingStreamKernels::MulAddFloat3ToFloat4(m_pStreamPosition, m_pStreamVelocity, uiStartIndex, uiNumElements, tDiff);
 }
 
 
@@ -116,42 +116,55 @@ ezUInt32 PlacementTile::PlaceObjects(ezWorld& ref_world, ezArrayPtr<const Placem
 {
   EZ_PROFILE_SCOPE("PlacementTile::PlaceObjects");
 
-  ezGameObjectDesc desc;
   auto& objectsToPlace = m_pOutput->m_ObjectsToPlace;
 
-  ezHybridArray<ezPrefabResource*, 4> prefabs;
-  prefabs.SetCount(objectsToPlace.GetCount());
+  ezDynamicArray<const PlacementTransform*> placements;
+  ezDynamicArray<ezTransform> transforms;
+  ezDynamicArray<ezGameObject*> rootObjects;
 
-
-
-  for (auto& objectTransform : objectTransforms)
+  // instantiate all copies of the same prefab at once, which is a lot faster than instantiating them one by one
+  for (ezUInt32 uiObjectIndex = 0; uiObjectIndex < objectsToPlace.GetCount(); ++uiObjectIndex)
   {
-    const ezUInt32 uiObjectIndex = objectTransform.m_uiObjectIndex;
-    ezPrefabResource* pPrefab = prefabs[uiObjectIndex];
+    placements.Clear();
+    transforms.Clear();
 
-    if (pPrefab == nullptr)
+    for (auto& objectTransform : objectTransforms)
     {
-      pPrefab = ezResourceManager::BeginAcquireResource(objectsToPlace[uiObjectIndex], ezResourceAcquireMode::BlockTillLoaded);
-      prefabs[uiObjectIndex] = pPrefab;
+      if (objectTransform.m_uiObjectIndex == uiObjectIndex)
+      {
+        placements.PushBack(&objectTransform);
+        transforms.PushBack(ezSimdConversion::ToTransform(objectTransform.m_Transform));
+      }
     }
 
-    ezTransform transform = ezSimdConversion::ToTransform(objectTransform.m_Transform);
-    ezHybridArray<ezGameObject*, 8> rootObjects;
+    if (transforms.IsEmpty())
+      continue;
+
+    rootObjects.Clear();
 
     ezPrefabInstantiationOptions options;
     options.m_pCreatedRootObjectsOut = &rootObjects;
 
-    pPrefab->InstantiatePrefab(ref_world, transform, options);
+    {
+      ezResourceLock<ezPrefabResource> pPrefab(objectsToPlace[uiObjectIndex], ezResourceAcquireMode::BlockTillLoaded);
+      pPrefab->InstantiatePrefabs(ref_world, transforms, options);
+    }
+
+    // every instance creates the same number of root objects
+    const ezUInt32 uiRootObjectsPerInstance = rootObjects.GetCount() / transforms.GetCount();
 
-    // only send the color message, if we actually have a custom color
-    if (objectTransform.m_bHasValidColor)
+    for (ezUInt32 i = 0; i < placements.GetCount(); ++i)
     {
-      for (auto pRootObject : rootObjects)
+      // only send the color message, if we actually have a custom color
+      if (!placements[i]->m_bHasValidColor)
+        continue;
+
+      for (ezUInt32 j = 0; j < uiRootObjectsPerInstance; ++j)
       {
         // Set the color
         ezMsgSetColor msg;
-        msg.m_Color = objectTransform.m_ObjectColor.ToLinearFloat();
-        pRootObject->PostMessageRecursive(msg, ezTime::MakeZero(), ezObjectMsgQueueType::AfterInitialized);
+        msg.m_Color = placements[i]->m_ObjectColor.ToLinearFloat();
+        rootObjects[i * uiRootObjectsPerInstance + j]->PostMessageRecursive(msg, ezTime::MakeZero(), ezObjectMsgQueueType::AfterInitialized);
       }
     }
 
@@ -161,14 +174,6 @@ ezUInt32 PlacementTile::PlaceObjects(ezWorld& ref_world, ezArrayPtr<const Placem
     }
   }
 
-  for (auto pPrefab : prefabs)
-  {
-    if (pPrefab != nullptr)
-    {
-      ezResourceManager::EndAcquireResource(pPrefab);
-    }
-  }
-
   m_State = State::Finished;
 
   return m_PlacedObjects.GetCount();
@@ -155,7 +155,7 @@ ezResourceLoadDesc ezVisualScriptClassResource::UpdateContent(ezStreamReader* pS
           chunk >> coroutineCreationMode;
 
           ezUniquePtr<ezVisualScriptGraphDescription> pDesc = EZ_SCRIPT_NEW(ezVisualScriptGraphDescription);
-          if (pDesc->Deserialize(chunk, *m_pInstanceDataDesc, m_pConstantDataStorage->GetDesc()).Failed())
+          if (pDesc->Deserialize(chunk, *m_pInstanceDataDesc, *m_pConstantDataStorage).Failed())
           {
             ezLog::Error("Invalid visual script desc");
             return ld;
@@ -7,6 +7,7 @@
 #include <VisualScriptPlugin/Runtime/VisualScriptNodeUserData.h>
 
 ezVisualScriptGraphDescription::ExecuteFunction GetExecuteFunction(ezVisualScriptNodeDescription::Type::Enum nodeType, ezVisualScriptDataType::Enum dataType);
+ezVisualScriptGraphDescription::ExecuteFunction GetBranchFusedExecuteFunction(ezVisualScriptNodeDescription::Type::Enum nodeType, ezVisualScriptDataType::Enum dataType);
 
 namespace
 {
@@ -201,7 +202,9 @@ ezResult ezVisualScriptGraphDescription::Serialize(ezArrayPtr<const ezVisualScri
   return EZ_SUCCESS;
 }
 
-ezResult ezVisualScriptGraphDescription::Deserialize(ezStreamReader& inout_stream, const ezVisualScriptDataDescription& instanceDataDesc, const ezVisualScriptDataDescription& constantDataDesc)
+ezCVarBool cvar_OptimizeGraphs("VisualScript.OptimizeGraphs", true, ezCVarFlags::Default, "Whether constant branches are folded and conditions are merged with their branches when a script is loaded");
+
+ezResult ezVisualScriptGraphDescription::Deserialize(ezStreamReader& inout_stream, const ezVisualScriptDataDescription& instanceDataDesc, const ezVisualScriptDataStorage& constantDataStorage)
 {
   ezTypeVersion uiVersion = inout_stream.ReadVersion(s_uiVisualScriptGraphDescriptionVersion);
   if (uiVersion < s_uiVisualScriptGraphDescriptionVersion)
@@ -241,7 +244,7 @@ ezResult ezVisualScriptGraphDescription::Deserialize(ezStreamReader& inout_strea
       case DataOffset::Source::Instance:
         return &instanceDataDesc;
       case DataOffset::Source::Constant:
-        return &constantDataDesc;
+        return &constantDataStorage.GetDesc();
         EZ_DEFAULT_CASE_NOT_IMPLEMENTED;
     }
 
@@ -279,11 +282,142 @@ ezResult ezVisualScriptGraphDescription::Deserialize(ezStreamReader& inout_strea
     }
   }
 
+  if (cvar_OptimizeGraphs)
+  {
+    OptimizeNodes(nodes, constantDataStorage);
+  }
+
   m_Nodes = nodes;
 
   return EZ_SUCCESS;
 }
 
+// static
+void ezVisualScriptGraphDescription::OptimizeNodes(ezArrayPtr<Node> nodes, const ezVisualScriptDataStorage& constantDataStorage)
+{
+  constexpr ezUInt16 uiNotFolded = 0xFFFE;
+  constexpr ezUInt16 uiNoTarget = static_cast<ezUInt16>(ezInvalidIndex);
+  if (nodes.GetCount() >= uiNotFolded)
+    return;
+
+  // Pass 1: Branches and switches with a constant input always take the same path, so every node that points to them can jump to that path directly.
+  ezHybridArray<ezUInt16, 64> foldedTargets;
+  foldedTargets.SetCount(nodes.GetCount(), uiNotFolded);
+
+  bool bAnyFolded = false;
+  for (ezUInt32 i = 0; i < nodes.GetCount(); ++i)
+  {
+    const Node& node = nodes[i];
+    if (node.m_NumInputDataOffsets == 0 || node.GetInputDataOffset(0).IsConstant() == false)
+      continue;
+
+    const DataOffset inputOffset = node.GetInputDataOffset(0);
+
+    if (node.m_Type == ezVisualScriptNodeDescription::Type::Builtin_Branch)
+    {
+      const bool bCondition = constantDataStorage.GetData<bool>(inputOffset);
+      foldedTargets[i] = static_cast<ezUInt16>(node.GetExecutionIndex(bCondition ? 0 : 1));
+      bAnyFolded = true;
+    }
+    else if (node.m_Type == ezVisualScriptNodeDescription::Type::Builtin_Switch)
+    {
+      ezInt64 iValue = 0;
+      if (node.m_DeductedDataType == ezVisualScriptDataType::Int64)
+      {
+        iValue = constantDataStorage.GetData<ezInt64>(inputOffset);
+      }
+      else if (node.m_DeductedDataType == ezVisualScriptDataType::HashedString)
+      {
+        iValue = constantDataStorage.GetData<ezHashedString>(inputOffset).GetHash();
+      }
+      else
+      {
+        continue;
+      }
+
+      auto& userData = node.GetUserData<NodeUserData_Switch>();
+      ezUInt32 uiSlot = userData.m_uiNumCases;
+      for (ezUInt32 uiCase = 0; uiCase < userData.m_uiNumCases; ++uiCase)
+      {
+        if (iValue == userData.m_Cases[uiCase])
+        {
+          uiSlot = uiCase;
+          break;
+        }
+      }
+
+      foldedTargets[i] = static_cast<ezUInt16>(node.GetExecutionIndex(uiSlot));
+      bAnyFolded = true;
+    }
+  }
+
+  if (bAnyFolded)
+  {
+    auto ResolveTarget = [&](ezUInt16 uiTarget) -> ezUInt16
+    {
+      ezUInt16 uiResolved = uiTarget;
+      for (ezUInt32 uiSteps = 0; uiResolved < foldedTargets.GetCount() && foldedTargets[uiResolved] != uiNotFolded; ++uiSteps)
+      {
+        // a cycle of constant branches never terminates, keep it as it is so the max node executions check still triggers
+        if (uiSteps >= foldedTargets.GetCount())
+          return uiTarget;
+
+        uiResolved = foldedTargets[uiResolved];
+      }
+
+      return uiResolved;
+    };
+
+    for (auto& node : nodes)
+    {
+      ezUInt16* pExecutionIndices = node.GetExecutionIndices();
+      for (ezUInt32 uiSlot = 0; uiSlot < node.m_NumExecutionIndices; ++uiSlot)
+      {
+        if (pExecutionIndices[uiSlot] != uiNoTarget)
+        {
+          pExecutionIndices[uiSlot] = ResolveTarget(pExecutionIndices[uiSlot]);
+        }
+      }
+    }
+  }
+
+  // Pass 2: A condition that is directly followed by a branch on its result decides the next node itself,
+  // which saves a dispatch per evaluation in loops. The branch node stays in place for all other nodes that point to it.
+  for (auto& node : nodes)
+  {
+    if (node.m_NumExecutionIndices != 1 || node.m_NumOutputDataOffsets != 1)
+      continue;
+
+    auto fusedFunction = GetBranchFusedExecuteFunction(node.m_Type, node.m_DeductedDataType);
+    if (fusedFunction == nullptr)
+      continue;
+
+    const ezUInt32 uiNextNode = node.GetExecutionIndex(0);
+    if (uiNextNode >= nodes.GetCount())
+      continue;
+
+    const Node& branchNode = nodes[uiNextNode];
+    if (branchNode.m_Type != ezVisualScriptNodeDescription::Type::Builtin_Branch ||
+        branchNode.m_NumExecutionIndices > EZ_ARRAY_SIZE(node.m_ExecutionIndices.m_Embedded))
+      continue;
+
+    const DataOffset conditionOffset = node.GetOutputDataOffset(0);
+    const DataOffset branchOffset = branchNode.GetInputDataOffset(0);
+    if (conditionOffset.m_uiByteOffset != branchOffset.m_uiByteOffset ||
+        conditionOffset.GetType() != branchOffset.GetType() ||
+        conditionOffset.GetSource() != branchOffset.GetSource())
+      continue;
+
+    for (ezUInt32 uiSlot = 0; uiSlot < branchNode.m_NumExecutionIndices; ++uiSlot)
+    {
+      node.m_ExecutionIndices.m_Embedded[uiSlot] = static_cast<ezUInt16>(branchNode.GetExecutionIndex(uiSlot));
+    }
+
+    node.m_NumExecutionIndices = branchNode.m_NumExecutionIndices;
+    node.m_Function = fusedFunction;
+  }
+}
+
 ezScriptMessageDesc ezVisualScriptGraphDescription::GetMessageDesc() const
 {
   auto pEntryNode = GetNode(0);
@@ -136,7 +136,7 @@ public:
   ~ezVisualScriptGraphDescription();
 
   static ezResult Serialize(ezArrayPtr<const ezVisualScriptNodeDescription> nodes, const ezVisualScriptDataDescription& localDataDesc, ezStreamWriter& inout_stream);
-  ezResult Deserialize(ezStreamReader& inout_stream, const ezVisualScriptDataDescription& instanceDataDesc, const ezVisualScriptDataDescription& constantDataDesc);
+  ezResult Deserialize(ezStreamReader& inout_stream, const ezVisualScriptDataDescription& instanceDataDesc, const ezVisualScriptDataStorage& constantDataStorage);
 
   template <typename T, ezUInt32 Size>
   struct EmbeddedArrayOrPointer
@@ -209,6 +209,7 @@ public:
     DataOffset GetInputDataOffset(ezUInt32 uiSlot) const;
     DataOffset GetOutputDataOffset(ezUInt32 uiSlot) const;
 
+    ezUInt16* GetExecutionIndices();
     DataOffset* GetInputDataOffsets();
     DataOffset* GetOutputDataOffsets();
 
@@ -230,6 +231,8 @@ public:
   const ezSharedPtr<const ezVisualScriptDataDescription>& GetLocalDataDesc() const;
 
 private:
+  static void OptimizeNodes(ezArrayPtr<Node> nodes, const ezVisualScriptDataStorage& constantDataStorage);
+
   ezArrayPtr<const Node> m_Nodes;
   ezBlob m_Storage;
 
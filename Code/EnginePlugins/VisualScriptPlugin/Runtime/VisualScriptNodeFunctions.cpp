@@ -670,6 +670,53 @@ namespace
 
   MAKE_EXEC_FUNC_GETTER(NodeFunction_Builtin_IsValid);
 
+  //////////////////////////////////////////////////////////////////////////
+
+  // Variants of the condition nodes that are used when the condition is directly followed by a branch on its result.
+  // The result is still written to the output, since other nodes might read it as well.
+
+  static EZ_ALWAYS_INLINE ExecResult BranchOnOutput(ezVisualScriptExecutionContext& inout_context, const ezVisualScriptGraphDescription::Node& node)
+  {
+    bool bCondition = inout_context.GetData<bool>(node.GetOutputDataOffset(0));
+    return ExecResult::RunNext(bCondition ? 0 : 1);
+  }
+
+  static ExecResult NodeFunction_Builtin_AndAndBranch(ezVisualScriptExecutionContext& inout_context, const ezVisualScriptGraphDescription::Node& node)
+  {
+    NodeFunction_Builtin_And(inout_context, node);
+    return BranchOnOutput(inout_context, node);
+  }
+
+  static ExecResult NodeFunction_Builtin_OrAndBranch(ezVisualScriptExecutionContext& inout_context, const ezVisualScriptGraphDescription::Node& node)
+  {
+    NodeFunction_Builtin_Or(inout_context, node);
+    return BranchOnOutput(inout_context, node);
+  }
+
+  static ExecResult NodeFunction_Builtin_NotAndBranch(ezVisualScriptExecutionContext& inout_context, const ezVisualScriptGraphDescription::Node& node)
+  {
+    NodeFunction_Builtin_Not(inout_context, node);
+    return BranchOnOutput(inout_context, node);
+  }
+
+  template <typename T>
+  static ExecResult NodeFunction_Builtin_CompareAndBranch(ezVisualScriptExecutionContext& inout_context, const ezVisualScriptGraphDescription::Node& node)
+  {
+    NodeFunction_Builtin_Compare<T>(inout_context, node);
+    return BranchOnOutput(inout_context, node);
+  }
+
+  MAKE_EXEC_FUNC_GETTER(NodeFunction_Builtin_CompareAndBranch);
+
+  template <typename T>
+  static ExecResult NodeFunction_Builtin_IsValidAndBranch(ezVisualScriptExecutionContext& inout_context, const ezVisualScriptGraphDescription::Node& node)
+  {
+    NodeFunction_Builtin_IsValid<T>(inout_context, node);
+    return BranchOnOutput(inout_context, node);
+  }
+
+  MAKE_EXEC_FUNC_GETTER(NodeFunction_Builtin_IsValidAndBranch);
+
   template <typename T>
   static ExecResult NodeFunction_Builtin_Select(ezVisualScriptExecutionContext& inout_context, const ezVisualScriptGraphDescription::Node& node)
   {
@@ -1540,5 +1587,24 @@ ezVisualScriptGraphDescription::ExecuteFunction GetExecuteFunction(ezVisualScrip
   return nullptr;
 }
 
+ezVisualScriptGraphDescription::ExecuteFunction GetBranchFusedExecuteFunction(ezVisualScriptNodeDescription::Type::Enum nodeType, ezVisualScriptDataType::Enum dataType)
+{
+  switch (nodeType)
+  {
+    case ezVisualScriptNodeDescription::Type::Builtin_And:
+      return &NodeFunction_Builtin_AndAndBranch;
+    case ezVisualScriptNodeDescription::Type::Builtin_Or:
+      return &NodeFunction_Builtin_OrAndBranch;
+    case ezVisualScriptNodeDescription::Type::Builtin_Not:
+      return &NodeFunction_Builtin_NotAndBranch;
+    case ezVisualScriptNodeDescription::Type::Builtin_Compare:
+      return NodeFunction_Builtin_CompareAndBranch_Getter(dataType);
+    case ezVisualScriptNodeDescription::Type::Builtin_IsValid:
+      return NodeFunction_Builtin_IsValidAndBranch_Getter(dataType);
+    default:
+      return nullptr;
+  }
+}
+
 #undef MAKE_EXEC_FUNC_GETTER
 #undef MAKE_TONUMBER_EXEC_FUNC
@@ -87,6 +87,11 @@ EZ_ALWAYS_INLINE ezVisualScriptGraphDescription::DataOffset ezVisualScriptGraphD
   return {};
 }
 
+EZ_ALWAYS_INLINE ezUInt16* ezVisualScriptGraphDescription::Node::GetExecutionIndices()
+{
+  return m_NumExecutionIndices <= EZ_ARRAY_SIZE(m_ExecutionIndices.m_Embedded) ? m_ExecutionIndices.m_Embedded : m_ExecutionIndices.m_Ptr;
+}
+
 EZ_ALWAYS_INLINE ezVisualScriptGraphDescription::DataOffset* ezVisualScriptGraphDescription::Node::GetInputDataOffsets()
 {
   return m_NumInputDataOffsets <= EZ_ARRAY_SIZE(m_InputDataOffsets.m_Embedded) ? m_InputDataOffsets.m_Embedded : m_InputDataOffsets.m_Ptr;
@@ -10,6 +10,7 @@
 #include <Foundation/Strings/String.h>
 #include <Foundation/Strings/StringBuilder.h>
 #include <Foundation/System/SystemInformation.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Stopwatch.h>
 #include <Foundation/Utilities/CommandLineOptions.h>
 
@@ -36,6 +37,15 @@
     Example:
       -pack "path/to/folder" "path/to/another/folder"
 
+-benchmark <paths>
+    One or multiple paths to ezArchive files that shall be read entirely, to measure the read throughput.
+
+    Reports the throughput of decompressing all entries one after another, in parallel, and through prefetching.
+    Nothing is written to disk.
+
+    Example:
+      -benchmark "path/to/file.ezArchive"
+
 Description:
     -pack and -unpack can take multiple inputs to either aggregate multiple folders into one archive (pack)
     or to unpack multiple archives at the same time.
@@ -85,6 +95,17 @@ Example:\n\
 ",
   "");
 
+ezCommandLineOptionDoc opt_Benchmark("_ArchiveTool", "-benchmark", "<paths>", "\
+One or multiple paths to ezArchive files that shall be read entirely, to measure the read throughput.\n\
+\n\
+Reports the throughput of decompressing all entries one after another, in parallel, and through prefetching.\n\
+Nothing is written to disk.\n\
+\n\
+Example:\n\
+  -benchmark \"path/to/file.ezArchive\"\n\
+",
+  "");
+
 ezCommandLineOptionDoc opt_Desc("_ArchiveTool", "Description:", "", "\
 -pack and -unpack can take multiple inputs to either aggregate multiple folders into one archive (pack)\n\
 or to unpack multiple archives at the same time.\n\
@@ -148,6 +169,7 @@ public:
     Auto,
     Pack,
     Unpack,
+    Benchmark,
   };
 
   ArchiveMode m_Mode = ArchiveMode::Auto;
@@ -218,6 +240,22 @@ public:
         }
       }
     }
+    else if (cmd.GetStringOptionArguments("-benchmark") > 0)
+    {
+      m_Mode = ArchiveMode::Benchmark;
+      const ezUInt32 args = cmd.GetStringOptionArguments("-benchmark");
+
+      for (ezUInt32 a = 0; a < args; ++a)
+      {
+        m_sInputs.PushBack(cmd.GetAbsolutePathOption("-benchmark", a));
+
+        if (!ezOSFile::ExistsFile(m_sInputs.PeekBack()))
+        {
+          ezLog::Error("-benchmark input file does not exist: '{}'", m_sInputs.PeekBack());
+          return EZ_FAILURE;
+        }
+      }
+    }
     else
     {
       bool bInputsFolders = true;
@@ -254,7 +292,7 @@ public:
       }
     }
 
-    ezLog::Info("Mode is: {}", m_Mode == ArchiveMode::Pack ? "pack" : "unpack");
+    ezLog::Info("Mode is: {}", m_Mode == ArchiveMode::Pack ? "pack" : (m_Mode == ArchiveMode::Unpack ? "unpack" : "benchmark"));
     ezLog::Info("Inputs:");
 
     for (const auto& input : m_sInputs)
@@ -368,6 +406,96 @@ public:
     return EZ_SUCCESS;
   }
 
+  static void LogThroughput(ezStringView sName, ezUInt64 uiNumBytes, ezTime duration)
+  {
+    const double fMegaBytes = uiNumBytes / (1024.0 * 1024.0);
+    ezLog::Info("  {}: {} MB in {} -> {} MB/s", sName, ezArgF(fMegaBytes, 1), duration, ezArgF(fMegaBytes / ezMath::Max(duration.GetSeconds(), 0.000001), 1));
+  }
+
+  ezResult Benchmark()
+  {
+    for (const auto& file : m_sInputs)
+    {
+      ezLog::Info("Benchmarking archive '{}'", file);
+
+      if (!ezArchiveUtils::IsAcceptedArchiveFileExtensions(ezPathUtils::GetFileExtension(file)))
+      {
+        ezArchiveUtils::GetAcceptedArchiveFileExtensions().PushBack(ezPathUtils::GetFileExtension(file));
+      }
+
+      ezArchiveReader reader;
+      EZ_SUCCEED_OR_RETURN(reader.OpenArchive(file));
+
+      const ezArchiveTOC& toc = reader.GetArchiveTOC();
+
+      ezDynamicArray<ezUInt32> entries;
+      ezUInt64 uiTotalBytes = 0;
+
+      for (ezUInt32 e = 0; e < toc.m_Entries.GetCount(); ++e)
+      {
+        entries.PushBack(e);
+        uiTotalBytes += toc.m_Entries[e].m_uiUncompressedDataSize;
+      }
+
+      ezLog::Info("  {} entries, {} worker threads", entries.GetCount(), ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks));
+
+      // the first read pulls the archive into the OS file cache, all measurements below only measure the decompression
+      reader.PrefetchEntries(entries);
+      reader.ClearPrefetchedEntries();
+
+      {
+        ezStopwatch sw;
+
+        ezDynamicArray<ezUInt8> data;
+        for (ezUInt32 e : entries)
+        {
+          EZ_SUCCEED_OR_RETURN(reader.ReadEntry(e, data));
+        }
+
+        LogThroughput("Serial", uiTotalBytes, sw.GetRunningTotal());
+      }
+
+      {
+        ezStopwatch sw;
+
+        ezDynamicArray<ezDynamicArray<ezUInt8>> data;
+        data.SetCount(entries.GetCount());
+        EZ_SUCCEED_OR_RETURN(reader.ReadEntries(entries, data));
+
+        LogThroughput("Parallel", uiTotalBytes, sw.GetRunningTotal());
+      }
+
+      {
+        ezStopwatch sw;
+
+        reader.PrefetchEntries(entries);
+
+        ezUInt8 uiTemp[1024 * 8];
+        ezUInt64 uiBytesRead = 0;
+
+        for (ezUInt32 e : entries)
+        {
+          ezUniquePtr<ezStreamReader> pEntryReader = reader.CreateEntryReader(e);
+
+          while (const ezUInt64 uiRead = pEntryReader->ReadBytes(uiTemp, EZ_ARRAY_SIZE(uiTemp)))
+          {
+            uiBytesRead += uiRead;
+          }
+        }
+
+        if (uiBytesRead != uiTotalBytes)
+        {
+          ezLog::Error("Read {} bytes, but the archive stores {} bytes", uiBytesRead, uiTotalBytes);
+          return EZ_FAILURE;
+        }
+
+        LogThroughput("Prefetched", uiTotalBytes, sw.GetRunningTotal());
+      }
+    }
+
+    return EZ_SUCCESS;
+  }
+
   virtual void Run() override
   {
     {
@@ -415,6 +543,18 @@ public:
       return;
     }
 
+    if (m_Mode == ArchiveMode::Benchmark)
+    {
+      if (Benchmark().Failed())
+      {
+        ezLog::Error("Benchmarking the archive failed");
+        SetReturnCode(4);
+      }
+
+      RequestApplicationQuit();
+      return;
+    }
+
     ezLog::Error("Unknown mode");
     RequestApplicationQuit();
   }
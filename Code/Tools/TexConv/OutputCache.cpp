@@ -0,0 +1,182 @@
+#include <TexConv/TexConvPCH.h>
+
+#include <Foundation/Algorithm/HashStream.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/OSFile.h>
+#include <TexConv/TexConv.h>
+
+static void GetCachedFilePath(ezStringBuilder& out_sPath, ezStringView sCacheDir, ezUInt64 uiCacheKey, ezStringView sOutput)
+{
+  out_sPath = sCacheDir;
+  out_sPath.AppendFormat("/{}-{}", ezArgU(uiCacheKey, 16, true, 16, true), sOutput);
+}
+
+ezResult ezTexConv::ComputeCacheKey()
+{
+  ezUInt64 uiDescHash = 0;
+  EZ_SUCCEED_OR_RETURN(m_Processor.m_Descriptor.ComputeHash(uiDescHash));
+
+  // the output file types decide in which format the results are written
+  ezHashStreamWriter64 stream(uiDescHash);
+  stream << ezPathUtils::GetFileExtension(m_sOutputFile);
+  stream << ezPathUtils::GetFileExtension(m_sOutputThumbnailFile);
+  stream << ezPathUtils::GetFileExtension(m_sOutputLowResFile);
+
+  m_uiCacheKey = stream.GetHashValue();
+  return EZ_SUCCESS;
+}
+
+bool ezTexConv::RestoreFromCache()
+{
+  ezStringBuilder sCachedFile;
+  GetCachedFilePath(sCachedFile, m_sCacheDir, m_uiCacheKey, "main");
+
+  // the main result is stored last, so if it exists, all other outputs have been stored as well
+  if (!ezOSFile::ExistsFile(sCachedFile))
+  {
+    ezLog::Info("Conversion result is not cached yet.");
+    UpdateCacheStats(false, 0);
+    return false;
+  }
+
+  const ezStringView outputs[][2] = {
+    {m_sOutputThumbnailFile, "thumbnail"},
+    {m_sOutputLowResFile, "lowres"},
+    {m_sOutputFile, "main"},
+  };
+
+  ezUInt64 uiBytesRestored = 0;
+
+  for (const auto& output : outputs)
+  {
+    if (output[0].IsEmpty())
+      continue;
+
+    GetCachedFilePath(sCachedFile, m_sCacheDir, m_uiCacheKey, output[1]);
+
+    if (!ezOSFile::ExistsFile(sCachedFile))
+    {
+      // the conversion did not produce this output (e.g. not enough mips for a low-res result), make sure no outdated file is left behind
+      ezOSFile::DeleteFile(output[0]).IgnoreResult();
+      continue;
+    }
+
+    ezFileStats stats;
+    if (ezOSFile::CopyFile(sCachedFile, output[0]).Failed() || ezOSFile::GetFileStats(sCachedFile, stats).Failed())
+    {
+      ezLog::Warning("Failed to copy cached result '{}' to '{}'. Converting the input instead.", sCachedFile, output[0]);
+      UpdateCacheStats(false, 0);
+      return false;
+    }
+
+    uiBytesRestored += stats.m_uiFileSize;
+    ezLog::Success("Restored '{}' from the cache.", output[0]);
+  }
+
+  UpdateCacheStats(true, uiBytesRestored);
+  return true;
+}
+
+void ezTexConv::StoreInCache() const
+{
+  if (ezOSFile::CreateDirectoryStructure(m_sCacheDir).Failed())
+  {
+    ezLog::Warning("Failed to create cache folder '{}'.", m_sCacheDir);
+    return;
+  }
+
+  ezStringBuilder sCachedFile;
+
+  struct OptionalOutput
+  {
+    ezStringView m_sFile;
+    ezStringView m_sName;
+    bool m_bWritten;
+  };
+
+  const OptionalOutput optionalOutputs[] = {
+    {m_sOutputThumbnailFile, "thumbnail", m_Processor.m_ThumbnailOutputImage.IsValid()},
+    {m_sOutputLowResFile, "lowres", m_Processor.m_LowResOutputImage.IsValid()},
+  };
+
+  for (const auto& output : optionalOutputs)
+  {
+    GetCachedFilePath(sCachedFile, m_sCacheDir, m_uiCacheKey, output.m_sName);
+
+    if (output.m_sFile.IsEmpty() || !output.m_bWritten)
+    {
+      ezOSFile::DeleteFile(sCachedFile).IgnoreResult();
+      continue;
+    }
+
+    if (ezOSFile::CopyFile(output.m_sFile, sCachedFile).Failed())
+    {
+      ezLog::Warning("Failed to store '{}' in the cache.", output.m_sFile);
+      return;
+    }
+  }
+
+  // write the main result under a temporary name first, so that other processes never see a partially written cache entry
+  GetCachedFilePath(sCachedFile, m_sCacheDir, m_uiCacheKey, "main");
+
+  ezStringBuilder sTempFile = sCachedFile;
+  sTempFile.Append(".tmp");
+  ezOSFile::FindFreeFilename(sTempFile);
+
+  if (ezOSFile::CopyFile(m_sOutputFile, sTempFile).Failed() || ezOSFile::MoveFileOrDirectory(sTempFile, sCachedFile).Failed())
+  {
+    ezOSFile::DeleteFile(sTempFile).IgnoreResult();
+    ezLog::Warning("Failed to store '{}' in the cache.", m_sOutputFile);
+  }
+}
+
+void ezTexConv::UpdateCacheStats(bool bHit, ezUInt64 uiBytesSaved) const
+{
+  constexpr ezUInt8 uiStatsVersion = 1;
+
+  ezStringBuilder sStatsFile = m_sCacheDir;
+  sStatsFile.AppendPath("TexConvCache.stats");
+
+  ezUInt64 uiHits = 0;
+  ezUInt64 uiMisses = 0;
+  ezUInt64 uiTotalBytesSaved = 0;
+
+  // the statistics are only informative, if multiple processes update them at the same time, some counts may get lost
+  {
+    ezFileReader file;
+    if (file.Open(sStatsFile).Succeeded())
+    {
+      ezUInt8 uiVersion = 0;
+      file >> uiVersion;
+
+      if (uiVersion == uiStatsVersion)
+      {
+        file >> uiHits;
+        file >> uiMisses;
+        file >> uiTotalBytesSaved;
+      }
+    }
+  }
+
+  if (bHit)
+    ++uiHits;
+  else
+    ++uiMisses;
+
+  uiTotalBytesSaved += uiBytesSaved;
+
+  {
+    ezFileWriter file;
+    if (file.Open(sStatsFile).Succeeded())
+    {
+      file << uiStatsVersion;
+      file << uiHits;
+      file << uiMisses;
+      file << uiTotalBytesSaved;
+    }
+  }
+
+  const ezUInt64 uiTotal = uiHits + uiMisses;
+  ezLog::Info("Cache hit rate: {} of {} conversions ({} percent), {} saved by this run, {} saved in total.", uiHits, uiTotal, ezArgF(100.0 * uiHits / uiTotal, 1), ezArgFileSize(uiBytesSaved), ezArgFileSize(uiTotalBytesSaved));
+}
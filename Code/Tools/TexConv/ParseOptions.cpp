@@ -44,6 +44,8 @@ ezCommandLineOptionInt opt_DilateStrength("_TexConv", "-dilateStrength", "How ma
 
 ezCommandLineOptionBool opt_Premulalpha("_TexConv", "-premulalpha", "Whether to multiply the alpha channel into the RGB channels.", false);
 
+ezCommandLineOptionBool opt_Benchmark("_TexConv", "-benchmark", "Measures how long the conversion takes and reports the throughput in megapixels per second.", false);
+
 ezCommandLineOptionInt opt_ThumbnailRes("_TexConv", "-thumbnailRes", "Thumbnail resolution. Should be a power-of-two.", 0, 32, 1024);
 
 ezCommandLineOptionPath opt_ThumbnailOut("_TexConv", "-thumbnailOut",
@@ -60,6 +62,13 @@ ezCommandLineOptionPath opt_LowOut("_TexConv", "-lowOut",
 ",
   "");
 
+ezCommandLineOptionPath opt_CacheDir("_TexConv", "-cacheDir",
+  "\
+  Path to a folder in which conversion results are cached.\n\
+  If the input files and all settings are unchanged, the outputs are copied from the cache instead of converting the input again.\n\
+",
+  "");
+
 ezCommandLineOptionInt opt_LowMips("_TexConv", "-lowMips", "Number of mipmaps to use from main result as low-res data.", 0, 0, 8);
 
 ezCommandLineOptionInt opt_MinRes("_TexConv", "-minRes", "The minimum resolution allowed for the output.", 16, 4, 8 * 1024);
@@ -360,6 +369,8 @@ ezResult ezTexConv::ParseOutputFiles()
     m_Processor.m_Descriptor.m_uiLowResMipmaps = opt_LowMips.GetOptionValue(ezCommandLineOption::LogMode::Always);
   }
 
+  m_sCacheDir = opt_CacheDir.GetOptionValue(ezCommandLineOption::LogMode::Always);
+
   return EZ_SUCCESS;
 }
 
@@ -493,6 +504,8 @@ ezResult ezTexConv::ParseMiscOptions()
 
   m_Processor.m_Descriptor.m_fMaxValue = opt_Clamp.GetOptionValue(ezCommandLineOption::LogMode::Always);
 
+  m_bBenchmark = opt_Benchmark.GetOptionValue(ezCommandLineOption::LogMode::Always);
+
   return EZ_SUCCESS;
 }
 
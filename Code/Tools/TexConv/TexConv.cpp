@@ -1,6 +1,7 @@
 #include <TexConv/TexConvPCH.h>
 
 #include <Foundation/IO/FileSystem/DeferredFileWriter.h>
+#include <Foundation/Time/Stopwatch.h>
 #include <Foundation/Utilities/AssetFileHeader.h>
 #include <TexConv/TexConv.h>
 #include <Texture/Image/Formats/DdsFileFormat.h>
@@ -209,6 +210,31 @@ ezResult ezTexConv::WriteOutputFile(ezStringView sFile, const ezImage& image)
   }
 }
 
+void ezTexConv::ReportBenchmark(ezTime duration) const
+{
+  const ezImage& img = m_Processor.m_OutputImage;
+
+  if (!img.IsValid())
+  {
+    ezLog::Info("Processing took {} ms", ezArgF(duration.GetMilliseconds(), 1));
+    return;
+  }
+
+  // count all pixels that had to be produced, including mipmaps, faces and array slices
+  ezUInt64 uiNumPixels = 0;
+  for (ezUInt32 uiMip = 0; uiMip < img.GetNumMipLevels(); ++uiMip)
+  {
+    uiNumPixels += static_cast<ezUInt64>(img.GetWidth(uiMip)) * img.GetHeight(uiMip) * img.GetDepth(uiMip);
+  }
+
+  uiNumPixels *= img.GetNumFaces() * img.GetNumArrayIndices();
+
+  const double fMegaPixels = static_cast<double>(uiNumPixels) / (1000.0 * 1000.0);
+  const double fSeconds = ezMath::Max(duration.GetSeconds(), 0.000001);
+
+  ezLog::Info("Processed {} megapixels in {} ms: {} megapixels per second", ezArgF(fMegaPixels, 2), ezArgF(duration.GetMilliseconds(), 1), ezArgF(fMegaPixels / fSeconds, 2));
+}
+
 void ezTexConv::Run()
 {
   SetReturnCode(-1);
@@ -262,12 +288,29 @@ void ezTexConv::Run()
   }
   else
   {
+    // texture atlases reference further input files, which are not known before processing, so they can't be cached
+    const bool bUseCache = !m_sCacheDir.IsEmpty() && !m_sOutputFile.IsEmpty() && m_Processor.m_Descriptor.m_OutputType != ezTexConvOutputType::Atlas && ComputeCacheKey().Succeeded();
+
+    if (bUseCache && RestoreFromCache())
+    {
+      SetReturnCode(0);
+      RequestApplicationQuit();
+      return;
+    }
+
+    ezStopwatch sw;
+
     if (m_Processor.Process().Failed())
     {
       RequestApplicationQuit();
       return;
     }
 
+    if (m_bBenchmark)
+    {
+      ReportBenchmark(sw.GetRunningTotal());
+    }
+
     if (m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Atlas)
     {
       ezDeferredFileWriter file;
@@ -335,6 +378,11 @@ void ezTexConv::Run()
       }
     }
 
+    if (bUseCache && m_Processor.m_OutputImage.IsValid())
+    {
+      StoreInCache();
+    }
+
     SetReturnCode(0);
   }
 
@@ -73,11 +73,19 @@ public:
   bool IsTexFormat() const;
   ezResult WriteTexFile(ezStreamWriter& inout_stream, const ezImage& image);
   ezResult WriteOutputFile(ezStringView sFile, const ezImage& image);
+  void ReportBenchmark(ezTime duration) const;
+
+  ezResult ComputeCacheKey();
+  bool RestoreFromCache();
+  void StoreInCache() const;
+  void UpdateCacheStats(bool bHit, ezUInt64 uiBytesSaved) const;
 
 private:
   ezString m_sOutputFile;
   ezString m_sOutputThumbnailFile;
   ezString m_sOutputLowResFile;
+  ezString m_sCacheDir;
+  ezUInt64 m_uiCacheKey = 0;
 
   bool m_bOutputSupports2D = false;
   bool m_bOutputSupports3D = false;
@@ -86,6 +94,7 @@ private:
   bool m_bOutputSupportsMipmaps = false;
   bool m_bOutputSupportsFiltering = false;
   bool m_bOutputSupportsCompression = false;
+  bool m_bBenchmark = false;
 
   ezEnum<ezTexConvMode> m_Mode;
   ezTexConvProcessor m_Processor;
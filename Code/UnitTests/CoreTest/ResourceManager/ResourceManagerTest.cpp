@@ -1,5 +1,6 @@
 #include <CoreTest/CoreTestPCH.h>
 
+#include <Core/ResourceManager/Implementation/ResourceLoadingQueue.h>
 #include <Core/ResourceManager/ResourceManager.h>
 #include <Foundation/Types/ScopeExit.h>
 
@@ -286,3 +287,198 @@ EZ_CREATE_SIMPLE_TEST(ResourceManager, NestedLoading)
     EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(ResourceManager, LoadingQueue)
+{
+  // the resources are never registered with the resource manager, the queue only uses their heap index
+  constexpr ezUInt32 uiNumResources = 16;
+  TestResource resources[uiNumResources];
+
+  ezResourceLoadingQueue queue;
+  EZ_SCOPE_EXIT(queue.Clear());
+
+  auto PopAll = [&](ezDynamicArray<ezResource*>& out_order)
+  {
+    out_order.Clear();
+
+    float fLastPriority = -1.0f;
+    while (!queue.IsEmpty())
+    {
+      const ezResourceLoadingQueue::Entry entry = queue.PopFront();
+      EZ_TEST_BOOL(entry.m_fPriority >= fLastPriority);
+      EZ_TEST_BOOL(!queue.Contains(entry.m_pResource));
+
+      fLastPriority = entry.m_fPriority;
+      out_order.PushBack(entry.m_pResource);
+    }
+  };
+
+  ezDynamicArray<ezResource*> order;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Pop Order")
+  {
+    // inserts the priorities in a scrambled order
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      const ezUInt32 uiPriority = (i * 7) % uiNumResources;
+      queue.Insert(&resources[uiPriority], static_cast<float>(uiPriority), false, ezTime::MakeFromSeconds(i));
+    }
+
+    EZ_TEST_INT(queue.GetCount(), uiNumResources);
+
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      EZ_TEST_BOOL(queue.Contains(&resources[i]));
+    }
+
+    PopAll(order);
+
+    if (EZ_TEST_INT(order.GetCount(), uiNumResources))
+    {
+      for (ezUInt32 i = 0; i < uiNumResources; ++i)
+      {
+        EZ_TEST_BOOL(order[i] == &resources[i]);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Equal Priority")
+  {
+    queue.Insert(&resources[0], 1.0f, false, ezTime::MakeZero());
+    queue.Insert(&resources[1], 1.0f, false, ezTime::MakeZero());
+    queue.Insert(&resources[2], 1.0f, true, ezTime::MakeZero());
+    queue.Insert(&resources[3], 1.0f, false, ezTime::MakeZero());
+    queue.Insert(&resources[4], 1.0f, true, ezTime::MakeZero());
+    queue.Insert(&resources[5], 0.5f, false, ezTime::MakeZero());
+
+    PopAll(order);
+
+    // resources added to the front come first in reverse order, the others in the order in which they were added
+    if (EZ_TEST_INT(order.GetCount(), 6))
+    {
+      EZ_TEST_BOOL(order[0] == &resources[5]);
+      EZ_TEST_BOOL(order[1] == &resources[4]);
+      EZ_TEST_BOOL(order[2] == &resources[2]);
+      EZ_TEST_BOOL(order[3] == &resources[0]);
+      EZ_TEST_BOOL(order[4] == &resources[1]);
+      EZ_TEST_BOOL(order[5] == &resources[3]);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Loading Priority")
+  {
+    // none of the resources was ever acquired, so 'now' is the time since the last acquire
+    resources[0].SetPriority(ezResourcePriority::Medium);
+    resources[1].SetPriority(ezResourcePriority::Medium);
+    resources[2].SetPriority(ezResourcePriority::High);
+    resources[3].SetPriority(ezResourcePriority::Critical);
+    EZ_SCOPE_EXIT(for (ezUInt32 i = 0; i < 4; ++i) resources[i].SetPriority(ezResourcePriority::Medium););
+
+    queue.Insert(&resources[0], resources[0].GetLoadingPriority(ezTime::MakeFromSeconds(8)), false, ezTime::MakeZero());
+    queue.Insert(&resources[1], resources[1].GetLoadingPriority(ezTime::MakeFromSeconds(2)), false, ezTime::MakeZero());
+    queue.Insert(&resources[2], resources[2].GetLoadingPriority(ezTime::MakeFromSeconds(9)), false, ezTime::MakeZero());
+    queue.Insert(&resources[3], resources[3].GetLoadingPriority(ezTime::MakeFromSeconds(100)), false, ezTime::MakeZero());
+
+    PopAll(order);
+
+    // critical resources always come first, a higher priority wins over a more recent acquire, within the same priority the more recently acquired one is loaded first
+    if (EZ_TEST_INT(order.GetCount(), 4))
+    {
+      EZ_TEST_BOOL(order[0] == &resources[3]);
+      EZ_TEST_BOOL(order[1] == &resources[2]);
+      EZ_TEST_BOOL(order[2] == &resources[1]);
+      EZ_TEST_BOOL(order[3] == &resources[0]);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "UpdatePriority")
+  {
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      queue.Insert(&resources[i], static_cast<float>(i), false, ezTime::MakeZero());
+    }
+
+    // moves the last one to the front, the first one to the back and one from the middle further down
+    queue.UpdatePriority(&resources[uiNumResources - 1], -1.0f);
+    queue.UpdatePriority(&resources[0], 100.0f);
+    queue.UpdatePriority(&resources[5], 10.5f);
+
+    // resources that are not queued are ignored
+    TestResource notQueued;
+    queue.UpdatePriority(&notQueued, 0.0f);
+    EZ_TEST_BOOL(!queue.Contains(&notQueued));
+
+    EZ_TEST_INT(queue.GetCount(), uiNumResources);
+
+    PopAll(order);
+
+    if (EZ_TEST_INT(order.GetCount(), uiNumResources))
+    {
+      EZ_TEST_BOOL(order[0] == &resources[uiNumResources - 1]);
+      EZ_TEST_BOOL(order[1] == &resources[1]);
+      EZ_TEST_BOOL(order[4] == &resources[4]);
+      EZ_TEST_BOOL(order[5] == &resources[6]);
+      EZ_TEST_BOOL(order[9] == &resources[10]);
+      EZ_TEST_BOOL(order[10] == &resources[5]);
+      EZ_TEST_BOOL(order[11] == &resources[11]);
+      EZ_TEST_BOOL(order[uiNumResources - 1] == &resources[0]);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Remove")
+  {
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      queue.Insert(&resources[i], static_cast<float>(i), false, ezTime::MakeZero());
+    }
+
+    // removes entries from the middle of the heap, which have children that need to be moved up
+    ezResource* pRemoved0 = queue.GetResource(1);
+    ezResource* pRemoved1 = queue.GetResource(5);
+    ezResource* pRemoved2 = queue.GetResource(uiNumResources - 1);
+
+    EZ_TEST_BOOL(queue.Remove(pRemoved0));
+    EZ_TEST_BOOL(queue.Remove(pRemoved1));
+    EZ_TEST_BOOL(queue.Remove(pRemoved2));
+    EZ_TEST_BOOL(!queue.Remove(pRemoved1));
+
+    EZ_TEST_BOOL(!queue.Contains(pRemoved0));
+    EZ_TEST_BOOL(!queue.Contains(pRemoved1));
+    EZ_TEST_BOOL(!queue.Contains(pRemoved2));
+    EZ_TEST_INT(queue.GetCount(), uiNumResources - 3);
+
+    PopAll(order);
+
+    if (EZ_TEST_INT(order.GetCount(), uiNumResources - 3))
+    {
+      ezUInt32 uiExpected = 0;
+      for (ezResource* pResource : order)
+      {
+        while (&resources[uiExpected] == pRemoved0 || &resources[uiExpected] == pRemoved1 || &resources[uiExpected] == pRemoved2)
+        {
+          ++uiExpected;
+        }
+
+        EZ_TEST_BOOL(pResource == &resources[uiExpected]);
+        ++uiExpected;
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Clear")
+  {
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      queue.Insert(&resources[i], 0.0f, false, ezTime::MakeZero());
+    }
+
+    queue.Clear();
+
+    EZ_TEST_BOOL(queue.IsEmpty());
+
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      EZ_TEST_BOOL(!queue.Contains(&resources[i]));
+    }
+  }
+}
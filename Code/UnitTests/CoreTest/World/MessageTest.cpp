@@ -1,6 +1,7 @@
 #include <CoreTest/CoreTestPCH.h>
 
 #include <Core/World/World.h>
+#include <CoreTest/World/TestPostingThread.h>
 #include <Foundation/Memory/FrameAllocator.h>
 #include <Foundation/Time/Clock.h>
 
@@ -233,4 +234,113 @@ EZ_CREATE_SIMPLE_TEST(World, Messaging)
 
     ezFrameAllocator::Reset();
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Queuing from multiple threads")
+  {
+    ResetComponents(*pRoot);
+
+    TestMessage1 msg;
+    msg.m_iValue = 1;
+
+    constexpr ezUInt32 uiNumMessages = 1000;
+
+    ezHybridArray<ezUniquePtr<ezTestPostingThread>, 4> threads;
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      threads.PushBack(EZ_DEFAULT_NEW(ezTestPostingThread, world, pRoot->GetHandle(), msg, uiNumMessages));
+      threads.PeekBack()->Start();
+    }
+
+    for (auto& pThread : threads)
+    {
+      pThread->Join();
+    }
+
+    world.Update();
+
+    TestComponentMsg* pComponent2 = nullptr;
+    EZ_TEST_BOOL(pRoot->TryGetComponentOfBaseType(pComponent2));
+    EZ_TEST_INT(pComponent2->m_iSomeData, 1 + 4 * uiNumMessages);
+
+    ezFrameAllocator::Reset();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Queuing from multiple threads while processing messages")
+  {
+    ResetComponents(*pRoot);
+
+    TestMessage1 msg;
+    msg.m_iValue = 1;
+
+    constexpr ezUInt32 uiNumMessages = 20000;
+
+    ezHybridArray<ezUniquePtr<ezTestPostingThread>, 4> threads;
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      threads.PushBack(EZ_DEFAULT_NEW(ezTestPostingThread, world, pRoot->GetHandle(), msg, uiNumMessages));
+      threads.PeekBack()->Start();
+    }
+
+    // the staged messages are merged several times per update, no message must get lost while the threads keep posting
+    for (auto& pThread : threads)
+    {
+      while (pThread->GetThreadStatus() != ezThread::Finished)
+      {
+        world.Update();
+      }
+    }
+
+    for (auto& pThread : threads)
+    {
+      pThread->Join();
+    }
+
+    world.Update();
+
+    TestComponentMsg* pComponent2 = nullptr;
+    EZ_TEST_BOOL(pRoot->TryGetComponentOfBaseType(pComponent2));
+    EZ_TEST_INT(pComponent2->m_iSomeData, 1 + 4 * uiNumMessages);
+
+    ezFrameAllocator::Reset();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Queuing with long delays")
+  {
+    ResetComponents(*pRoot);
+
+    // the delays end up in different levels of the timing wheel and beyond its range
+    const double delays[] = {0.0005, 0.07, 3.5, 250.0, 20000.0, 100000.0};
+
+    const ezTime startTime = world.GetClock().GetAccumulatedTime();
+
+    for (ezUInt32 i = EZ_ARRAY_SIZE(delays); i-- > 0;)
+    {
+      TestMessage1 msg;
+      msg.m_iValue = 1 << i;
+      pRoot->PostMessage(msg, ezTime::MakeFromSeconds(delays[i]));
+    }
+
+    int iDesiredValue = 1;
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(delays); ++i)
+    {
+      TestComponentMsg* pComponent2 = nullptr;
+      EZ_TEST_BOOL(pRoot->TryGetComponentOfBaseType(pComponent2));
+
+      // advance to shortly before the message is due
+      const ezTime dueTime = startTime + ezTime::MakeFromSeconds(delays[i]);
+      world.GetClock().SetFixedTimeStep(dueTime - ezTime::MakeFromMilliseconds(0.2) - world.GetClock().GetAccumulatedTime());
+      world.Update();
+
+      EZ_TEST_INT(pComponent2->m_iSomeData, iDesiredValue);
+
+      world.GetClock().SetFixedTimeStep(ezTime::MakeFromMilliseconds(0.4));
+      world.Update();
+
+      iDesiredValue += 1 << i;
+      EZ_TEST_INT(pComponent2->m_iSomeData, iDesiredValue);
+    }
+
+    ezFrameAllocator::Reset();
+  }
 }
@@ -1,13 +1,18 @@
 #include <CoreTest/CoreTestPCH.h>
 
 #include <Core/Messages/UpdateLocalBoundsMessage.h>
+#include <Core/World/SpatialSystem_Bvh.h>
+#include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Core/World/World.h>
+#include <Foundation/Configuration/CVar.h>
 #include <Foundation/Containers/HashSet.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/Math/Random.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Profiling/ProfilingUtils.h>
+#include <Foundation/SimdMath/SimdConversion.h>
 #include <Foundation/Utilities/GraphicsUtils.h>
 
 namespace
@@ -58,10 +63,11 @@ namespace
   // clang-format on
 } // namespace
 
-EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
+static void TestSpatialSystem(ezUniquePtr<ezSpatialSystem> pSpatialSystem)
 {
   ezWorldDesc worldDesc("Test");
   worldDesc.m_uiRandomNumberGeneratorSeed = 5;
+  worldDesc.m_pSpatialSystem = std::move(pSpatialSystem);
 
   ezWorld world(worldDesc);
   EZ_LOCK(world.GetWriteMarker());
@@ -281,6 +287,118 @@ EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
     }
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "BatchedQueries")
+  {
+    queryParams.m_uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask() | ezDefaultSpatialDataCategories::RenderDynamic.GetBitmask();
+
+    const ezBoundingSphere testSpheres[] = {
+      ezBoundingSphere::MakeFromCenterAndRadius(ezVec3(100.0f, 60.0f, 400.0f), 3000.0f),
+      ezBoundingSphere::MakeFromCenterAndRadius(ezVec3(-5000.0f, 2000.0f, 0.0f), 2500.0f),
+      ezBoundingSphere::MakeFromCenterAndRadius(ezVec3(0.0f, 0.0f, 0.0f), 10.0f),
+    };
+
+    ezDynamicArray<ezGameObject*> batchedObjects[EZ_ARRAY_SIZE(testSpheres)];
+    auto CollectSphereObjects = [&](ezUInt32 uiQueryIndex, ezGameObject* pObject)
+    {
+      batchedObjects[uiQueryIndex].PushBack(pObject);
+      return ezVisitorExecution::Continue;
+    };
+
+    world.GetSpatialSystem()->FindObjectsInSpheres(testSpheres, queryParams, CollectSphereObjects);
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(testSpheres); ++i)
+    {
+      ezDynamicArray<ezGameObject*> objectsInSphere;
+      world.GetSpatialSystem()->FindObjectsInSphere(testSpheres[i], queryParams, objectsInSphere);
+
+      EZ_TEST_INT(batchedObjects[i].GetCount(), objectsInSphere.GetCount());
+      for (auto pObject : objectsInSphere)
+      {
+        EZ_TEST_BOOL(batchedObjects[i].Contains(pObject));
+      }
+    }
+
+    // stopping one query must not affect the others
+    ezSpatialSystem::QueryParams staticQueryParams;
+    staticQueryParams.m_uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
+
+    ezDynamicArray<ezGameObject*> objectsInSecondSphere;
+    world.GetSpatialSystem()->FindObjectsInSphere(testSpheres[1], staticQueryParams, objectsInSecondSphere);
+
+    ezUInt32 uiNumFoundInFirstQuery = 0;
+    ezUInt32 uiNumFoundInSecondQuery = 0;
+    auto StopFirstQuery = [&](ezUInt32 uiQueryIndex, ezGameObject* pObject)
+    {
+      EZ_IGNORE_UNUSED(pObject);
+
+      if (uiQueryIndex == 0)
+      {
+        ++uiNumFoundInFirstQuery;
+        return ezVisitorExecution::Stop;
+      }
+
+      ++uiNumFoundInSecondQuery;
+      return ezVisitorExecution::Continue;
+    };
+
+    world.GetSpatialSystem()->FindObjectsInSpheres(ezMakeArrayPtr(testSpheres, 2), staticQueryParams, StopFirstQuery);
+
+    EZ_TEST_INT(uiNumFoundInFirstQuery, 1);
+    EZ_TEST_INT(uiNumFoundInSecondQuery, objectsInSecondSphere.GetCount());
+
+    const ezBoundingBox testBoxes[] = {
+      ezBoundingBox::MakeFromCenterAndHalfExtents(ezVec3(100.0f, 60.0f, 400.0f), ezVec3(3000.0f)),
+      ezBoundingBox::MakeFromMinMax(ezVec3(-10000.0f), ezVec3(0.0f)),
+    };
+
+    ezDynamicArray<ezGameObject*> batchedBoxObjects[EZ_ARRAY_SIZE(testBoxes)];
+    auto CollectBoxObjects = [&](ezUInt32 uiQueryIndex, ezGameObject* pObject)
+    {
+      batchedBoxObjects[uiQueryIndex].PushBack(pObject);
+      return ezVisitorExecution::Continue;
+    };
+
+    world.GetSpatialSystem()->FindObjectsInBoxes(testBoxes, queryParams, CollectBoxObjects);
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(testBoxes); ++i)
+    {
+      ezDynamicArray<ezGameObject*> objectsInBox;
+      world.GetSpatialSystem()->FindObjectsInBox(testBoxes[i], queryParams, objectsInBox);
+
+      EZ_TEST_INT(batchedBoxObjects[i].GetCount(), objectsInBox.GetCount());
+      for (auto pObject : objectsInBox)
+      {
+        EZ_TEST_BOOL(batchedBoxObjects[i].Contains(pObject));
+      }
+    }
+
+    const ezVec3 viewDirs[] = {ezVec3::MakeAxisX(), -ezVec3::MakeAxisX(), ezVec3::MakeAxisY(), ezVec3(1, 1, 1).GetNormalized()};
+    ezMat4 projection = ezGraphicsUtils::CreatePerspectiveProjectionMatrixFromFovX(ezAngle::MakeFromDegree(80.0f), 1.0f, 1.0f, 10000.0f);
+
+    ezFrustum testFrustums[EZ_ARRAY_SIZE(viewDirs)];
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(viewDirs); ++i)
+    {
+      ezMat4 lookAt = ezGraphicsUtils::CreateLookAtViewMatrix(ezVec3::MakeZero(), viewDirs[i], ezVec3::MakeAxisZ());
+      testFrustums[i] = ezFrustum::MakeFromMVP(projection * lookAt);
+    }
+
+    ezDynamicArray<const ezGameObject*> batchedVisibleObjects[EZ_ARRAY_SIZE(testFrustums)];
+    world.GetSpatialSystem()->FindVisibleObjects(testFrustums, queryParams, batchedVisibleObjects, ezVisibilityState::Direct);
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(testFrustums); ++i)
+    {
+      ezDynamicArray<const ezGameObject*> visibleObjects;
+      world.GetSpatialSystem()->FindVisibleObjects(testFrustums[i], queryParams, visibleObjects, {}, ezVisibilityState::Direct);
+
+      EZ_TEST_BOOL(!visibleObjects.IsEmpty());
+      EZ_TEST_INT(batchedVisibleObjects[i].GetCount(), visibleObjects.GetCount());
+      for (auto pObject : visibleObjects)
+      {
+        EZ_TEST_BOOL(batchedVisibleObjects[i].Contains(pObject));
+      }
+    }
+  }
+
   if (false)
   {
     ezStringBuilder outputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
@@ -319,3 +437,192 @@ EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
     world.Update();
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
+{
+  TestSpatialSystem(nullptr);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parallel Culling")
+  {
+    ezUniquePtr<ezSpatialSystem_RegularGrid> pGrid = EZ_NEW(ezFoundation::GetAlignedAllocator(), ezSpatialSystem_RegularGrid);
+    ezSpatialSystem& system = *pGrid;
+
+    ezRandom rng;
+    rng.Initialize(7);
+
+    // enough objects for the culling to be split into multiple tasks
+    constexpr ezUInt32 uiNumObjects = 50000;
+    const ezUInt32 uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
+
+    ezDynamicArray<ezSimdBBoxSphere, ezAlignedAllocatorWrapper> allBounds;
+    allBounds.Reserve(uiNumObjects);
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      const ezVec3 vCenter((float)rng.DoubleMinMax(-1000.0, 1000.0), (float)rng.DoubleMinMax(-1000.0, 1000.0), (float)rng.DoubleMinMax(-100.0, 100.0));
+      allBounds.PushBack(ezSimdBBoxSphere(ezSimdBSphere(ezSimdConversion::ToVec3(vCenter), (float)rng.DoubleMinMax(0.5, 5.0))));
+
+      system.CreateSpatialData(allBounds.PeekBack(), reinterpret_cast<ezGameObject*>(static_cast<size_t>(i + 1)), uiCategoryBitmask, ezTagSet());
+    }
+
+    ezMat4 lookAt = ezGraphicsUtils::CreateLookAtViewMatrix(ezVec3::MakeZero(), ezVec3::MakeAxisX(), ezVec3::MakeAxisZ());
+    ezMat4 projection = ezGraphicsUtils::CreatePerspectiveProjectionMatrixFromFovX(ezAngle::MakeFromDegree(80.0f), 1.0f, 1.0f, 2000.0f);
+
+    const ezFrustum testFrustum = ezFrustum::MakeFromMVP(projection * lookAt);
+
+    // rejects everything beyond x = 500, must be safe to be called from multiple tasks
+    auto IsOccluded = [](const ezSimdBBox& box)
+    { return box.m_Min.x() > 500.0f; };
+
+    ezCVarBool* pParallelCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("Spatial.Queries.ParallelCulling"));
+    EZ_TEST_BOOL(pParallelCVar != nullptr);
+
+    const bool bPrevParallel = *pParallelCVar;
+
+    ezDynamicArray<const ezGameObject*> visibleObjects[2];
+    for (ezUInt32 uiParallel = 0; uiParallel < 2; ++uiParallel)
+    {
+      *pParallelCVar = uiParallel != 0;
+
+      ezSpatialSystem::QueryParams queryParams;
+      queryParams.m_uiCategoryBitmask = uiCategoryBitmask;
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+      ezSpatialSystem::QueryStats stats;
+      queryParams.m_pStats = &stats;
+#endif
+
+      system.FindVisibleObjects(testFrustum, queryParams, visibleObjects[uiParallel], IsOccluded, ezVisibilityState::Direct);
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+      EZ_TEST_INT(stats.m_uiTotalNumObjects, uiNumObjects);
+      EZ_TEST_INT(stats.m_uiNumObjectsPassed, visibleObjects[uiParallel].GetCount());
+      EZ_TEST_INT(stats.m_uiNumObjectsTested, stats.m_uiNumObjectsCulled + stats.m_uiNumObjectsOccluded + stats.m_uiNumObjectsPassed);
+      EZ_TEST_BOOL(stats.m_uiNumObjectsCulled > 0);
+      EZ_TEST_BOOL(stats.m_uiNumObjectsOccluded > 0);
+#endif
+    }
+
+    *pParallelCVar = bPrevParallel;
+
+    EZ_TEST_BOOL(!visibleObjects[0].IsEmpty());
+
+    // the per task results are merged in order, so the result must not depend on the number of tasks
+    EZ_TEST_BOOL(visibleObjects[0] == visibleObjects[1]);
+
+    for (const ezGameObject* pObject : visibleObjects[1])
+    {
+      const ezSimdBBoxSphere& bounds = allBounds[reinterpret_cast<size_t>(pObject) - 1];
+
+      EZ_TEST_BOOL(testFrustum.Overlaps(bounds.GetSphere()));
+      EZ_TEST_BOOL(!IsOccluded(bounds.GetBox()));
+    }
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(World, SpatialSystemBvh)
+{
+  TestSpatialSystem(EZ_NEW(ezFoundation::GetAlignedAllocator(), ezSpatialSystem_Bvh));
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Incremental Updates")
+  {
+    ezUniquePtr<ezSpatialSystem_Bvh> pBvh = EZ_NEW(ezFoundation::GetAlignedAllocator(), ezSpatialSystem_Bvh);
+    ezSpatialSystem& system = *pBvh;
+
+    ezRandom rng;
+    rng.Initialize(42);
+
+    constexpr ezUInt32 uiNumObjects = 4000;
+    const ezUInt32 uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
+
+    ezDynamicArray<ezSpatialDataHandle> handles;
+    ezDynamicArray<ezBoundingSphere> spheres;
+
+    auto MakeRandomSphere = [&]()
+    {
+      // mix of many small and a few huge objects
+      const float fRadius = (rng.UInt() % 100 == 0) ? (float)rng.DoubleMinMax(100.0, 1000.0) : (float)rng.DoubleMinMax(0.1, 5.0);
+      const ezVec3 vCenter((float)rng.DoubleMinMax(-2000.0, 2000.0), (float)rng.DoubleMinMax(-2000.0, 2000.0), (float)rng.DoubleMinMax(-200.0, 200.0));
+      return ezBoundingSphere::MakeFromCenterAndRadius(vCenter, fRadius);
+    };
+
+    auto ToSimdBounds = [](const ezBoundingSphere& sphere)
+    {
+      return ezSimdBBoxSphere(ezSimdBSphere(ezSimdConversion::ToVec3(sphere.m_vCenter), sphere.m_fRadius));
+    };
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      spheres.PushBack(MakeRandomSphere());
+      handles.PushBack(system.CreateSpatialData(ToSimdBounds(spheres[i]), reinterpret_cast<ezGameObject*>(static_cast<size_t>(i + 1)), uiCategoryBitmask, ezTagSet()));
+    }
+
+    auto CheckQueries = [&]()
+    {
+      ezSpatialSystem::QueryParams queryParams;
+      queryParams.m_uiCategoryBitmask = uiCategoryBitmask;
+
+      for (ezUInt32 uiQuery = 0; uiQuery < 10; ++uiQuery)
+      {
+        const ezBoundingSphere testSphere = ezBoundingSphere::MakeFromCenterAndRadius(MakeRandomSphere().m_vCenter, 300.0f);
+
+        ezDynamicArray<ezGameObject*> objects;
+        system.FindObjectsInSphere(testSphere, queryParams, objects);
+
+        ezUInt32 uiExpectedCount = 0;
+        for (ezUInt32 i = 0; i < handles.GetCount(); ++i)
+        {
+          if (!handles[i].IsInvalidated() && testSphere.Overlaps(spheres[i]))
+          {
+            ++uiExpectedCount;
+            EZ_TEST_BOOL(objects.Contains(reinterpret_cast<ezGameObject*>(static_cast<size_t>(i + 1))));
+          }
+        }
+
+        EZ_TEST_INT(objects.GetCount(), uiExpectedCount);
+      }
+
+      // the tree rotations don't guarantee a balanced tree but it must not degenerate
+      EZ_TEST_BOOL(pBvh->GetTreeHeight() <= 4 * 12);
+    };
+
+    CheckQueries();
+
+    // small movements that stay within the leaf margin and large ones that require re-insertion
+    for (ezUInt32 uiFrame = 0; uiFrame < 10; ++uiFrame)
+    {
+      // also compacts the tree nodes once enough leaves have been re-inserted
+      system.StartNewFrame();
+
+      for (ezUInt32 i = 0; i < uiNumObjects; i += 3)
+      {
+        if (uiFrame % 2 == 0)
+          spheres[i].m_vCenter += ezVec3(0.1f, 0.0f, 0.0f);
+        else
+          spheres[i] = MakeRandomSphere();
+
+        system.UpdateSpatialDataBounds(handles[i], ToSimdBounds(spheres[i]));
+      }
+    }
+
+    CheckQueries();
+
+    for (ezUInt32 i = 0; i < uiNumObjects; i += 2)
+    {
+      system.DeleteSpatialData(handles[i]);
+      handles[i].Invalidate();
+    }
+
+    system.StartNewFrame();
+    CheckQueries();
+
+    for (ezUInt32 i = 0; i < uiNumObjects; i += 2)
+    {
+      spheres[i] = MakeRandomSphere();
+      handles[i] = system.CreateSpatialData(ToSimdBounds(spheres[i]), reinterpret_cast<ezGameObject*>(static_cast<size_t>(i + 1)), uiCategoryBitmask, ezTagSet());
+    }
+
+    system.StartNewFrame();
+    CheckQueries();
+  }
+}
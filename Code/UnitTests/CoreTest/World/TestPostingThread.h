@@ -0,0 +1,34 @@
+#pragma once
+
+#include <Core/World/World.h>
+#include <Foundation/Threading/Thread.h>
+
+/// \brief Posts copies of the given message to a game object, to test posting messages from multiple threads.
+class ezTestPostingThread : public ezThread
+{
+public:
+  ezTestPostingThread(const ezWorld& world, ezGameObjectHandle hReceiver, const ezMessage& msg, ezUInt32 uiNumMessages)
+    : ezThread("Posting Thread")
+    , m_World(world)
+    , m_hReceiver(hReceiver)
+    , m_Msg(msg)
+    , m_uiNumMessages(uiNumMessages)
+  {
+  }
+
+  virtual ezUInt32 Run() override
+  {
+    for (ezUInt32 i = 0; i < m_uiNumMessages; ++i)
+    {
+      m_World.PostMessage(m_hReceiver, m_Msg, ezTime::MakeZero());
+    }
+
+    return 0;
+  }
+
+private:
+  const ezWorld& m_World;
+  ezGameObjectHandle m_hReceiver;
+  const ezMessage& m_Msg;
+  ezUInt32 m_uiNumMessages;
+};
@@ -1,8 +1,15 @@
 #include <CoreTest/CoreTestPCH.h>
 
+#include <Core/Messages/SetColorMessage.h>
+#include <Core/World/SpatialSystem_Bvh.h>
+#include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Core/World/World.h>
+#include <CoreTest/World/TestPostingThread.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/SimdMath/SimdConversion.h>
 #include <Foundation/Time/Clock.h>
 #include <Foundation/Time/Stopwatch.h>
+#include <Foundation/Utilities/GraphicsUtils.h>
 
 namespace
 {
@@ -114,6 +121,119 @@ namespace
     }
   }
 
+  void MeasureSpatialSystem(ezSpatialSystem& ref_system, const char* szName)
+  {
+    // Mixed scale distribution: many small props in dense clusters, some medium sized objects and a few huge ones like terrain chunks
+    ezRandom rng;
+    rng.Initialize(11);
+
+    constexpr ezUInt32 uiNumObjects = 100000;
+    constexpr ezUInt32 uiNumMovingObjects = 10000;
+    const ezUInt32 uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderDynamic.GetBitmask();
+
+    ezVec3 clusterCenters[32];
+    for (auto& vCenter : clusterCenters)
+    {
+      vCenter.Set((float)rng.DoubleMinMax(-4000.0, 4000.0), (float)rng.DoubleMinMax(-4000.0, 4000.0), (float)rng.DoubleMinMax(-50.0, 50.0));
+    }
+
+    ezDynamicArray<ezSimdBBoxSphere, ezAlignedAllocatorWrapper> bounds;
+    bounds.SetCountUninitialized(uiNumObjects);
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      const ezUInt32 uiType = rng.UIntInRange(100);
+      const float fHalfExtent = uiType < 90 ? (float)rng.DoubleMinMax(0.05, 0.5) : (uiType < 99 ? (float)rng.DoubleMinMax(5.0, 50.0) : (float)rng.DoubleMinMax(200.0, 2000.0));
+      const float fSpread = uiType < 90 ? 50.0f : 4000.0f;
+
+      const ezVec3 vCenter = clusterCenters[i % EZ_ARRAY_SIZE(clusterCenters)] + ezVec3((float)rng.DoubleMinMax(-fSpread, fSpread), (float)rng.DoubleMinMax(-fSpread, fSpread), (float)rng.DoubleMinMax(-20.0, 20.0));
+      bounds[i] = ezSimdBBox::MakeFromCenterAndHalfExtents(ezSimdConversion::ToVec3(vCenter), ezSimdVec4f(fHalfExtent));
+    }
+
+    ezDynamicArray<ezSpatialDataHandle> handles;
+    handles.Reserve(uiNumObjects);
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      handles.PushBack(ref_system.CreateSpatialData(bounds[i], nullptr, uiCategoryBitmask, ezTagSet()));
+    }
+
+    // the BVH builds its tree for the new objects at the start of the next frame, so that is part of the creation time
+    ref_system.StartNewFrame();
+
+    const ezTime tCreate = sw.Checkpoint();
+
+    // a main view and three shadow cascades looking at one of the clusters
+    ezFrustum frustums[4];
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(frustums); ++i)
+    {
+      const float fFar = 250.0f * (1 << (2 * i));
+      const ezMat4 lookAt = ezGraphicsUtils::CreateLookAtViewMatrix(clusterCenters[0], clusterCenters[0] + ezVec3(1, (float)i * 0.1f, -0.1f), ezVec3::MakeAxisZ());
+      const ezMat4 projection = ezGraphicsUtils::CreatePerspectiveProjectionMatrixFromFovX(ezAngle::MakeFromDegree(90.0f), 16.0f / 9.0f, 0.1f, fFar);
+      frustums[i] = ezFrustum::MakeFromMVP(projection * lookAt);
+    }
+
+    ezSpatialSystem::QueryParams queryParams;
+    queryParams.m_uiCategoryBitmask = uiCategoryBitmask;
+
+    ezDynamicArray<const ezGameObject*> visibleObjects[EZ_ARRAY_SIZE(frustums)];
+    ezUInt32 uiNumVisible = 0;
+
+    ezTime tUpdate;
+    ezTime tQueries;
+    ezTime tBatchedQueries;
+
+    constexpr ezUInt32 uiNumFrames = 60;
+    for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+    {
+      sw.Checkpoint();
+
+      // the start of a frame is where the BVH does its deferred maintenance, so it is part of the update time
+      ref_system.StartNewFrame();
+
+      // a subset of the objects moves a little bit every frame
+      for (ezUInt32 i = 0; i < uiNumMovingObjects; ++i)
+      {
+        const ezUInt32 uiIndex = (i * 7) % uiNumObjects;
+        bounds[uiIndex].m_CenterAndRadius += ezSimdVec4f(0.2f, 0.1f, 0.0f, 0.0f);
+        ref_system.UpdateSpatialDataBounds(handles[uiIndex], bounds[uiIndex]);
+      }
+
+      tUpdate += sw.Checkpoint();
+
+      for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(frustums); ++i)
+      {
+        visibleObjects[i].Clear();
+        ref_system.FindVisibleObjects(frustums[i], queryParams, visibleObjects[i], {}, ezVisibilityState::Direct);
+        uiNumVisible += visibleObjects[i].GetCount();
+      }
+
+      for (ezUInt32 i = 0; i < 1000; ++i)
+      {
+        const ezBoundingSphere sphere = ezBoundingSphere::MakeFromCenterAndRadius(clusterCenters[i % EZ_ARRAY_SIZE(clusterCenters)] + ezVec3((float)(i % 100) * 0.5f, 0, 0), 5.0f);
+        ref_system.FindObjectsInSphere(sphere, queryParams, [&](ezGameObject*)
+          { return ezVisitorExecution::Continue; });
+      }
+
+      tQueries += sw.Checkpoint();
+
+      for (auto& objects : visibleObjects)
+      {
+        objects.Clear();
+      }
+
+      ref_system.FindVisibleObjects(frustums, queryParams, visibleObjects, ezVisibilityState::Direct);
+
+      tBatchedQueries += sw.Checkpoint();
+    }
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%s: Creating %u objects: %.2fms", szName, uiNumObjects, tCreate.GetMilliseconds());
+    ezTestFramework::Output(ezTestOutput::Duration, "%s: Moving %u objects for %u frames: %.2fms", szName, uiNumMovingObjects, uiNumFrames, tUpdate.GetMilliseconds());
+    ezTestFramework::Output(ezTestOutput::Duration, "%s: %u frames with 4 views and 1000 sphere queries (%u objects visible): %.2fms", szName, uiNumFrames, uiNumVisible, tQueries.GetMilliseconds());
+    ezTestFramework::Output(ezTestOutput::Duration, "%s: %u frames with one batched query for 4 views: %.2fms", szName, uiNumFrames, tBatchedQueries.GetMilliseconds());
+  }
 } // namespace
 
 
@@ -288,3 +408,97 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
     }
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(World, Profile_TimedMessages)
+{
+  EZ_TEST_BLOCK(EnableInRelease, "Update with 100,000 timed messages")
+  {
+    ezWorldDesc worldDesc("Test");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezGameObjectDesc desc;
+    const ezGameObjectHandle hObject = world.CreateObject(desc);
+
+    // most messages are due far in the future, like timers and cooldowns
+    constexpr ezUInt32 uiNumMessages = 100000;
+    for (ezUInt32 i = 0; i < uiNumMessages; ++i)
+    {
+      ezMsgSetColor msg;
+      world.PostMessage(hObject, msg, ezTime::MakeFromMilliseconds(1 + (i * 7919) % 600000));
+    }
+
+    world.GetClock().SetFixedTimeStep(ezTime::MakeFromSeconds(1.0 / 60.0));
+
+    ezStopwatch sw;
+
+    constexpr ezUInt32 uiNumFrames = 600;
+    for (ezUInt32 i = 0; i < uiNumFrames; ++i)
+    {
+      world.Update();
+    }
+
+    const ezTime tDiff = sw.Checkpoint();
+    ezTestFramework::Output(ezTestOutput::Duration, "Updating %u frames with %u timed messages: %.2fms", uiNumFrames, uiNumMessages, tDiff.GetMilliseconds());
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(World, Profile_PostMessages)
+{
+  EZ_TEST_BLOCK(EnableInRelease, "Post 100,000 messages from each of 16 threads")
+  {
+    ezWorldDesc worldDesc("Test");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezGameObjectDesc desc;
+    const ezGameObjectHandle hObject = world.CreateObject(desc);
+
+    constexpr ezUInt32 uiNumThreads = 16;
+    constexpr ezUInt32 uiNumMessagesPerThread = 100000;
+
+    ezMsgSetColor msg;
+
+    ezHybridArray<ezUniquePtr<ezTestPostingThread>, uiNumThreads> threads;
+    for (ezUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      threads.PushBack(EZ_DEFAULT_NEW(ezTestPostingThread, world, hObject, msg, uiNumMessagesPerThread));
+    }
+
+    ezStopwatch sw;
+
+    for (auto& pThread : threads)
+    {
+      pThread->Start();
+    }
+
+    for (auto& pThread : threads)
+    {
+      pThread->Join();
+    }
+
+    const ezTime tPost = sw.Checkpoint();
+
+    world.Update();
+
+    const ezTime tUpdate = sw.Checkpoint();
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Posting %u messages from %u threads: %.2fms", uiNumThreads * uiNumMessagesPerThread, uiNumThreads, tPost.GetMilliseconds());
+    ezTestFramework::Output(ezTestOutput::Duration, "Processing %u messages: %.2fms", uiNumThreads * uiNumMessagesPerThread, tUpdate.GetMilliseconds());
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(World, Profile_SpatialSystem)
+{
+  EZ_TEST_BLOCK(EnableInRelease, "Regular Grid")
+  {
+    ezUniquePtr<ezSpatialSystem> pSystem = EZ_NEW(ezFoundation::GetAlignedAllocator(), ezSpatialSystem_RegularGrid);
+    MeasureSpatialSystem(*pSystem, "Regular Grid");
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "Bounding Volume Hierarchy")
+  {
+    ezUniquePtr<ezSpatialSystem> pSystem = EZ_NEW(ezFoundation::GetAlignedAllocator(), ezSpatialSystem_Bvh);
+    MeasureSpatialSystem(*pSystem, "BVH");
+  }
+}
@@ -0,0 +1,164 @@
+#include <CoreTest/CoreTestPCH.h>
+
+#include <Core/World/World.h>
+#include <Core/WorldSerializer/WorldReader.h>
+#include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/IO/MemoryStream.h>
+
+namespace
+{
+  ezUInt32 s_uiNumDeserialized = 0;
+  ezUInt32 s_uiNumCopied = 0;
+
+  class CopyableTestComponent;
+  using CopyableTestComponentManager = ezComponentManager<CopyableTestComponent, ezBlockStorageType::Compact>;
+
+  class CopyableTestComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(CopyableTestComponent, ezComponent, CopyableTestComponentManager);
+
+  public:
+    virtual void SerializeComponent(ezWorldWriter& inout_stream) const override { inout_stream.GetStream() << m_iValue; }
+
+    virtual void DeserializeComponent(ezWorldReader& inout_stream) override
+    {
+      inout_stream.GetStream() >> m_iValue;
+      ++s_uiNumDeserialized;
+    }
+
+    virtual bool CopyDeserializedState(const ezComponent& other) override
+    {
+      m_iValue = static_cast<const CopyableTestComponent&>(other).m_iValue;
+      ++s_uiNumCopied;
+      return true;
+    }
+
+    ezInt32 m_iValue = 0;
+  };
+
+  // clang-format off
+  EZ_BEGIN_COMPONENT_TYPE(CopyableTestComponent, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE;
+  // clang-format on
+
+  class ReferencingTestComponent;
+  using ReferencingTestComponentManager = ezComponentManager<ReferencingTestComponent, ezBlockStorageType::Compact>;
+
+  class ReferencingTestComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(ReferencingTestComponent, ezComponent, ReferencingTestComponentManager);
+
+  public:
+    virtual void SerializeComponent(ezWorldWriter& inout_stream) const override { inout_stream.WriteGameObjectHandle(m_hTarget); }
+
+    virtual void DeserializeComponent(ezWorldReader& inout_stream) override
+    {
+      m_hTarget = inout_stream.ReadGameObjectHandle();
+      ++s_uiNumDeserialized;
+    }
+
+    ezGameObjectHandle m_hTarget;
+  };
+
+  // clang-format off
+  EZ_BEGIN_COMPONENT_TYPE(ReferencingTestComponent, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE;
+  // clang-format on
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(World, InstantiatePrefabs)
+{
+  ezWorldDesc worldDesc("Test");
+  ezWorld world(worldDesc);
+  EZ_LOCK(world.GetWriteMarker());
+
+  ezDefaultMemoryStreamStorage storage;
+
+  // build a prefab with a root object that references its child
+  {
+    ezGameObjectDesc desc;
+    desc.m_LocalPosition.Set(1, 0, 0);
+
+    ezGameObject* pRoot = nullptr;
+    const ezGameObjectHandle hRoot = world.CreateObject(desc, pRoot);
+
+    desc.m_hParent = hRoot;
+    desc.m_LocalPosition.Set(0, 2, 0);
+
+    ezGameObject* pChild = nullptr;
+    const ezGameObjectHandle hChild = world.CreateObject(desc, pChild);
+
+    CopyableTestComponent* pCopyable = nullptr;
+    CopyableTestComponent::CreateComponent(pChild, pCopyable);
+    pCopyable->m_iValue = 42;
+
+    ReferencingTestComponent* pReferencing = nullptr;
+    ReferencingTestComponent::CreateComponent(pRoot, pReferencing);
+    pReferencing->m_hTarget = hChild;
+
+    const ezGameObject* rootObjects[] = {pRoot};
+
+    ezMemoryStreamWriter writer(&storage);
+    ezWorldWriter worldWriter;
+    worldWriter.WriteObjects(writer, rootObjects);
+
+    world.DeleteObjectNow(hRoot);
+  }
+
+  ezMemoryStreamReader reader(&storage);
+  ezWorldReader worldReader;
+  EZ_TEST_BOOL(worldReader.ReadWorldDescription(reader).Succeeded());
+
+  const ezTransform transforms[] = {
+    ezTransform(ezVec3(10, 0, 0)),
+    ezTransform(ezVec3(20, 0, 0)),
+    ezTransform(ezVec3(30, 0, 0)),
+  };
+
+  s_uiNumDeserialized = 0;
+  s_uiNumCopied = 0;
+
+  ezDynamicArray<ezGameObject*> createdRootObjects;
+  ezDynamicArray<ezGameObject*> createdChildObjects;
+
+  ezPrefabInstantiationOptions options;
+  options.m_pCreatedRootObjectsOut = &createdRootObjects;
+  options.m_pCreatedChildObjectsOut = &createdChildObjects;
+
+  worldReader.InstantiatePrefabs(world, transforms, options);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Objects")
+  {
+    EZ_TEST_INT(createdRootObjects.GetCount(), 3);
+    EZ_TEST_INT(createdChildObjects.GetCount(), 3);
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(transforms); ++i)
+    {
+      ezGameObject* pRoot = createdRootObjects[i];
+      ezGameObject* pChild = createdChildObjects[i];
+
+      EZ_TEST_VEC3(pRoot->GetGlobalPosition(), transforms[i].m_vPosition + ezVec3(1, 0, 0), 0.001f);
+      EZ_TEST_VEC3(pChild->GetGlobalPosition(), transforms[i].m_vPosition + ezVec3(1, 2, 0), 0.001f);
+      EZ_TEST_BOOL(pChild->GetParent() == pRoot);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Components")
+  {
+    // only the first copyable component is deserialized, the referencing components are always deserialized
+    EZ_TEST_INT(s_uiNumDeserialized, 1 + 3);
+    EZ_TEST_INT(s_uiNumCopied, 2);
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(transforms); ++i)
+    {
+      CopyableTestComponent* pCopyable = nullptr;
+      EZ_TEST_BOOL(createdChildObjects[i]->TryGetComponentOfBaseType(pCopyable));
+      EZ_TEST_INT(pCopyable->m_iValue, 42);
+
+      // references must point into the same instance
+      ReferencingTestComponent* pReferencing = nullptr;
+      EZ_TEST_BOOL(createdRootObjects[i]->TryGetComponentOfBaseType(pReferencing));
+      EZ_TEST_BOOL(pReferencing->m_hTarget == createdChildObjects[i]->GetHandle());
+    }
+  }
+}
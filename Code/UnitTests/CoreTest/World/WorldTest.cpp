@@ -247,6 +247,9 @@ EZ_CREATE_SIMPLE_TEST(World, World)
 
     TestWorldObjects o = CreateTestWorld(world, false);
 
+    const ezUInt16 uiParentVersion = o.pParent1->GetComponentVersion();
+    const ezUInt16 uiChildVersion = o.pChild11->GetComponentVersion();
+
     ezVec3 offset = ezVec3(200.0f, 0.0f, 0.0f);
     o.pParent1->SetLocalPosition(offset);
     o.pParent2->SetLocalPosition(offset);
@@ -255,6 +258,55 @@ EZ_CREATE_SIMPLE_TEST(World, World)
     // world.Update();
 
     TestTransforms(o, offset);
+
+    // moving static objects invalidates everything that was cached for them and their children
+    EZ_TEST_BOOL(o.pParent1->GetComponentVersion() != uiParentVersion);
+    EZ_TEST_BOOL(o.pChild11->GetComponentVersion() != uiChildVersion);
+
+    const ezUInt16 uiUnchangedVersion = o.pParent1->GetComponentVersion();
+    o.pParent1->SetLocalPosition(offset);
+    EZ_TEST_INT(o.pParent1->GetComponentVersion(), uiUnchangedVersion);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Transforms static deferred")
+  {
+    ezWorldDesc worldDesc("Test");
+    worldDesc.m_bReportErrorWhenStaticObjectMoves = false;
+
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    TestWorldObjects o = CreateTestWorld(world, false);
+
+    ezVec3 offset = ezVec3(200.0f, 0.0f, 0.0f);
+    o.pParent1->SetLocalPosition(ezSimdConversion::ToVec3(offset), ezGameObject::UpdateBehaviorIfStatic::UpdateDeferred);
+    o.pParent2->SetLocalPosition(ezSimdConversion::ToVec3(offset), ezGameObject::UpdateBehaviorIfStatic::UpdateDeferred);
+
+    EZ_TEST_INT(world.GetDeferredStaticTransformCount(), 2);
+
+    // changing an object again in the same frame does not queue it again, the child is covered by the update of its parent
+    o.pChild11->SetLocalPosition(ezSimdConversion::ToVec3(ezVec3(100.0f, 0.0f, 0.0f)), ezGameObject::UpdateBehaviorIfStatic::UpdateDeferred);
+    o.pParent1->SetLocalPosition(ezSimdConversion::ToVec3(offset), ezGameObject::UpdateBehaviorIfStatic::UpdateDeferred);
+    o.pChild11->SetLocalPosition(ezSimdConversion::ToVec3(ezVec3(100.0f, 0.0f, 0.0f)), ezGameObject::UpdateBehaviorIfStatic::UpdateDeferred);
+
+    EZ_TEST_INT(world.GetDeferredStaticTransformCount(), 3);
+
+    // the global transforms are not updated before the next world update
+    EZ_TEST_VEC3(o.pParent1->GetGlobalPosition(), ezVec3(100.0f, 0.0f, 0.0f), 0);
+
+    world.Update();
+
+    EZ_TEST_INT(world.GetDeferredStaticTransformCount(), 0);
+    TestTransforms(o, offset);
+
+    // the update of the parent has cleared the flag of the child, so it is queued again when it is moved after the update
+    o.pChild11->SetLocalPosition(ezSimdConversion::ToVec3(ezVec3(100.0f, 0.0f, 0.0f)), ezGameObject::UpdateBehaviorIfStatic::UpdateDeferred);
+    EZ_TEST_INT(world.GetDeferredStaticTransformCount(), 1);
+
+    world.Update();
+
+    EZ_TEST_INT(world.GetDeferredStaticTransformCount(), 0);
+    TestTransforms(o, offset);
   }
 
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "GameObject parenting")
@@ -0,0 +1,218 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Containers/ConcurrentHashTable.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Strings/String.h>
+#include <Foundation/Threading/Thread.h>
+
+namespace ConcurrentHashTableTestDetail
+{
+  struct Collision
+  {
+    ezUInt32 hash;
+    int key;
+
+    inline bool operator==(const Collision& other) const { return key == other.key; }
+
+    EZ_DECLARE_POD_TYPE();
+  };
+
+  constexpr ezUInt32 s_uiNumThreads = 4;
+  constexpr ezUInt32 s_uiNumKeysPerThread = 2000;
+
+  class InsertThread : public ezThread
+  {
+  public:
+    InsertThread()
+      : ezThread("Concurrent Hash Table Test Thread")
+    {
+    }
+
+    ezConcurrentHashTable<ezUInt32, ezUInt32>* m_pTable = nullptr;
+    ezUInt32 m_uiThreadIndex = 0;
+    ezUInt32 m_uiNumErrors = 0;
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      const ezUInt32 uiFirstKey = m_uiThreadIndex * s_uiNumKeysPerThread;
+
+      for (ezUInt32 i = 0; i < s_uiNumKeysPerThread; ++i)
+      {
+        const ezUInt32 uiKey = uiFirstKey + i;
+        m_pTable->Insert(uiKey, uiKey * 2);
+
+        // every thread also reads the keys of all other threads, while they are being inserted
+        ezUInt32 uiValue = 0;
+        const ezUInt32 uiOtherKey = (uiKey + s_uiNumKeysPerThread) % (s_uiNumThreads * s_uiNumKeysPerThread);
+        if (m_pTable->TryGetValue(uiOtherKey, uiValue) && uiValue != uiOtherKey * 2)
+          ++m_uiNumErrors;
+
+        // the shared key is added by all threads, but only one of them may succeed
+        bool bExisted = false;
+        if (m_pTable->FindOrAdd(0xFFFFFFFFu, m_uiThreadIndex, &bExisted) >= s_uiNumThreads)
+          ++m_uiNumErrors;
+
+        // remove every other key again
+        if ((i & 1) == 1 && !m_pTable->Remove(uiKey))
+          ++m_uiNumErrors;
+      }
+
+      return 0;
+    }
+  };
+} // namespace ConcurrentHashTableTestDetail
+
+template <>
+struct ezHashHelper<ConcurrentHashTableTestDetail::Collision>
+{
+  static ezUInt32 Hash(const ConcurrentHashTableTestDetail::Collision& value) { return value.hash; }
+
+  static bool Equal(const ConcurrentHashTableTestDetail::Collision& a, const ConcurrentHashTableTestDetail::Collision& b) { return a == b; }
+};
+
+EZ_CREATE_SIMPLE_TEST(Containers, ConcurrentHashTable)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Constructor")
+  {
+    ezConcurrentHashTable<ezInt32, ezInt32> table;
+
+    EZ_TEST_BOOL(table.GetCount() == 0);
+    EZ_TEST_BOOL(table.IsEmpty());
+    EZ_TEST_BOOL(!table.Contains(1));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Insert/TryGetValue/Contains")
+  {
+    ezConcurrentHashTable<ezInt32, ezString> table;
+
+    ezString sOldValue;
+    EZ_TEST_BOOL(!table.Insert(1, "one", &sOldValue));
+    EZ_TEST_BOOL(!table.Insert(2, "two"));
+    EZ_TEST_INT(table.GetCount(), 2);
+
+    EZ_TEST_BOOL(table.Insert(1, "eins", &sOldValue));
+    EZ_TEST_STRING(sOldValue, "one");
+    EZ_TEST_INT(table.GetCount(), 2);
+
+    ezString sValue;
+    EZ_TEST_BOOL(table.TryGetValue(1, sValue));
+    EZ_TEST_STRING(sValue, "eins");
+    EZ_TEST_BOOL(table.TryGetValue(2, sValue));
+    EZ_TEST_STRING(sValue, "two");
+    EZ_TEST_BOOL(!table.TryGetValue(3, sValue));
+
+    EZ_TEST_BOOL(table.Contains(2));
+    EZ_TEST_BOOL(!table.Contains(3));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindOrAdd")
+  {
+    ezConcurrentHashTable<ezString, ezInt32> table;
+
+    bool bExisted = true;
+    EZ_TEST_INT(table.FindOrAdd("a", 1, &bExisted), 1);
+    EZ_TEST_BOOL(!bExisted);
+
+    EZ_TEST_INT(table.FindOrAdd("a", 2, &bExisted), 1);
+    EZ_TEST_BOOL(bExisted);
+
+    // compatible key type
+    EZ_TEST_BOOL(table.Contains("a"));
+    EZ_TEST_INT(table.GetCount(), 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Remove/Clear")
+  {
+    ezConcurrentHashTable<ezInt32, ezInt32> table;
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+    {
+      table.Insert(i, i * 3);
+    }
+
+    EZ_TEST_INT(table.GetCount(), 1000);
+
+    for (ezInt32 i = 0; i < 1000; i += 2)
+    {
+      ezInt32 iOldValue = 0;
+      EZ_TEST_BOOL(table.Remove(i, &iOldValue));
+      EZ_TEST_INT(iOldValue, i * 3);
+    }
+
+    EZ_TEST_BOOL(!table.Remove(0));
+    EZ_TEST_INT(table.GetCount(), 500);
+
+    for (ezInt32 i = 0; i < 1000; ++i)
+    {
+      ezInt32 iValue = 0;
+      EZ_TEST_BOOL(table.TryGetValue(i, iValue) == ((i & 1) == 1));
+    }
+
+    table.Clear();
+    EZ_TEST_BOOL(table.IsEmpty());
+    EZ_TEST_BOOL(!table.Contains(1));
+
+    // the table is still usable after clearing it
+    table.Insert(1, 1);
+    EZ_TEST_BOOL(table.Contains(1));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Collision Tests")
+  {
+    using namespace ConcurrentHashTableTestDetail;
+
+    ezConcurrentHashTable<Collision, ezInt32> table;
+
+    for (ezInt32 i = 0; i < 100; ++i)
+    {
+      table.Insert({static_cast<ezUInt32>(i % 3), i}, i);
+    }
+
+    EZ_TEST_INT(table.GetCount(), 100);
+
+    for (ezInt32 i = 0; i < 100; i += 3)
+    {
+      EZ_TEST_BOOL(table.Remove(Collision{static_cast<ezUInt32>(i % 3), i}));
+    }
+
+    for (ezInt32 i = 0; i < 100; ++i)
+    {
+      ezInt32 iValue = -1;
+      const bool bFound = table.TryGetValue(Collision{static_cast<ezUInt32>(i % 3), i}, iValue);
+      EZ_TEST_BOOL(bFound == ((i % 3) != 0));
+      EZ_TEST_BOOL(!bFound || iValue == i);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Multi-threaded Access")
+  {
+    using namespace ConcurrentHashTableTestDetail;
+
+    ezConcurrentHashTable<ezUInt32, ezUInt32> table;
+
+    InsertThread threads[s_uiNumThreads];
+    for (ezUInt32 i = 0; i < s_uiNumThreads; ++i)
+    {
+      threads[i].m_pTable = &table;
+      threads[i].m_uiThreadIndex = i;
+      threads[i].Start();
+    }
+
+    for (ezUInt32 i = 0; i < s_uiNumThreads; ++i)
+    {
+      threads[i].Join();
+      EZ_TEST_INT(threads[i].m_uiNumErrors, 0);
+    }
+
+    EZ_TEST_INT(table.GetCount(), s_uiNumThreads * s_uiNumKeysPerThread / 2 + 1);
+
+    for (ezUInt32 uiKey = 0; uiKey < s_uiNumThreads * s_uiNumKeysPerThread; ++uiKey)
+    {
+      ezUInt32 uiValue = 0;
+      const bool bFound = table.TryGetValue(uiKey, uiValue);
+      EZ_TEST_BOOL(bFound == ((uiKey & 1) == 0));
+      EZ_TEST_BOOL(!bFound || uiValue == uiKey * 2);
+    }
+  }
+}
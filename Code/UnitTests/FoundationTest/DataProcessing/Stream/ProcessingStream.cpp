@@ -4,8 +4,10 @@
 #include <Foundation/DataProcessing/Stream/DefaultImplementations/ZeroInitializer.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamGroup.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamKernels.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamProcessor.h>
 #include <Foundation/Reflection/Reflection.h>
+#include <Foundation/Time/Time.h>
 
 EZ_CREATE_SIMPLE_TEST_GROUP(DataProcessing);
 
@@ -51,6 +53,67 @@ protected:
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(AddOneStreamProcessor, 1, ezRTTIDefaultAllocator<AddOneStreamProcessor>)
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 
+// Parallel add processor
+
+class ParallelAddOneStreamProcessor : public ezProcessingStreamProcessor
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ParallelAddOneStreamProcessor, ezProcessingStreamProcessor);
+
+public:
+  ParallelAddOneStreamProcessor() = default;
+
+  void SetStreamName(ezHashedString sStreamName) { m_sStreamName = sStreamName; }
+
+  ezAtomicInteger32 m_iNumPrepareCalls;
+  ezAtomicInteger32 m_iNumRangeCalls;
+
+protected:
+  virtual ezResult UpdateStreamBindings() override
+  {
+    m_pStream = m_pStreamGroup->GetStreamByName(m_sStreamName);
+
+    return m_pStream ? EZ_SUCCESS : EZ_FAILURE;
+  }
+
+  virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override {}
+
+  virtual bool SupportsParallelProcessing() const override { return true; }
+
+  virtual bool PrepareParallelProcessing(ezUInt64 uiNumElements) override
+  {
+    m_iNumPrepareCalls.Increment();
+    return true;
+  }
+
+  virtual void ProcessRange(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override
+  {
+    m_iNumRangeCalls.Increment();
+
+    ezProcessingStreamIterator<float> streamIterator(m_pStream, uiNumElements, uiStartIndex);
+
+    ezUInt64 uiElementIndex = uiStartIndex;
+    while (!streamIterator.HasReachedEnd())
+    {
+      streamIterator.Current() += 1.0f;
+
+      // remove every 100th element, this is enqueued and done after all ranges are processed
+      if (uiElementIndex % 100 == 0)
+      {
+        m_pStreamGroup->RemoveElement(uiElementIndex);
+      }
+
+      streamIterator.Advance();
+      ++uiElementIndex;
+    }
+  }
+
+  ezHashedString m_sStreamName;
+  ezProcessingStream* m_pStream = nullptr;
+};
+
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ParallelAddOneStreamProcessor, 1, ezRTTIDefaultAllocator<ParallelAddOneStreamProcessor>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
 EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStream)
 {
   ezProcessingStreamGroup Group;
@@ -156,3 +219,211 @@ EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStream)
     }
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStreamParallel)
+{
+  ezProcessingStreamGroup Group;
+  ezProcessingStream* pStream = Group.AddStream("Stream", ezProcessingStream::DataType::Float);
+
+  ezProcessingStreamSpawnerZeroInitialized* pSpawner = EZ_DEFAULT_NEW(ezProcessingStreamSpawnerZeroInitialized);
+  pSpawner->SetStreamName(pStream->GetName());
+  Group.AddProcessor(pSpawner);
+
+  ParallelAddOneStreamProcessor* pProcessor = EZ_DEFAULT_NEW(ParallelAddOneStreamProcessor);
+  pProcessor->SetStreamName(pStream->GetName());
+  Group.AddProcessor(pProcessor);
+
+  Group.SetSize(10000);
+  Group.SetParallelProcessingBinSize(256);
+  EZ_TEST_INT(Group.GetParallelProcessingBinSize(), 256);
+
+  Group.InitializeElements(10000);
+  Group.Process();
+
+  // the elements are only spawned after the processors ran
+  EZ_TEST_INT(Group.GetNumActiveElements(), 10000);
+  pProcessor->m_iNumPrepareCalls = 0;
+  pProcessor->m_iNumRangeCalls = 0;
+
+  Group.Process();
+
+  EZ_TEST_INT(pProcessor->m_iNumPrepareCalls, 1);
+  EZ_TEST_BOOL(pProcessor->m_iNumRangeCalls > 1);
+  EZ_TEST_INT(Group.GetNumActiveElements(), 9900);
+
+  {
+    ezProcessingStreamIterator<float> streamIterator(pStream, Group.GetNumActiveElements(), 0);
+
+    ezUInt32 uiNumWrong = 0;
+    while (!streamIterator.HasReachedEnd())
+    {
+      uiNumWrong += (streamIterator.Current() == 1.0f) ? 0 : 1;
+      streamIterator.Advance();
+    }
+
+    EZ_TEST_INT(uiNumWrong, 0);
+  }
+
+  // a bin size of 0 disables parallel processing
+  Group.SetParallelProcessingBinSize(0);
+  pProcessor->m_iNumRangeCalls = 0;
+
+  Group.Process();
+
+  EZ_TEST_INT(pProcessor->m_iNumPrepareCalls, 2);
+  EZ_TEST_INT(pProcessor->m_iNumRangeCalls, 1);
+  EZ_TEST_INT(Group.GetNumActiveElements(), 9801);
+}
+
+namespace
+{
+  void FillStreams(ezProcessingStream* pFloat3, ezProcessingStream* pFloat4, ezUInt64 uiNumElements)
+  {
+    ezVec3* pData3 = pFloat3->GetWritableData<ezVec3>();
+    ezVec4* pData4 = pFloat4->GetWritableData<ezVec4>();
+
+    for (ezUInt32 i = 0; i < uiNumElements; ++i)
+    {
+      pData3[i].Set((float)i, i * 2.0f, i * -3.0f);
+      pData4[i].Set((float)i, i * 0.5f, i * -1.0f, (float)i);
+    }
+  }
+} // namespace
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStreamKernels)
+{
+  // not a multiple of four, to also run the code paths for the remaining elements
+  constexpr ezUInt32 uiNumElements = 103;
+
+  ezProcessingStreamGroup Group;
+  ezProcessingStream* pFloat3 = Group.AddStream("Float3", ezProcessingStream::DataType::Float3);
+  ezProcessingStream* pFloat4 = Group.AddStream("Float4", ezProcessingStream::DataType::Float4);
+  Group.SetSize(uiNumElements);
+  Group.Process(); // allocates the stream data
+
+  const ezVec3* pData3 = pFloat3->GetData<ezVec3>();
+  const ezVec4* pData4 = pFloat4->GetData<ezVec4>();
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "AddFloat3")
+  {
+    FillStreams(pFloat3, pFloat4, uiNumElements);
+
+    ezProcessingStreamKernels::AddFloat3(pFloat3, 2, uiNumElements - 3, ezVec3(1, 2, 3));
+
+    for (ezUInt32 i = 0; i < uiNumElements; ++i)
+    {
+      const ezVec3 vExpected = ezVec3((float)i, i * 2.0f, i * -3.0f) + ((i >= 2 && i < uiNumElements - 1) ? ezVec3(1, 2, 3) : ezVec3::MakeZero());
+      EZ_TEST_VEC3(pData3[i], vExpected, 0.0f);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "MulFloat3")
+  {
+    FillStreams(pFloat3, pFloat4, uiNumElements);
+
+    ezProcessingStreamKernels::MulFloat3(pFloat3, 1, uiNumElements - 1, 0.5f);
+
+    EZ_TEST_VEC3(pData3[0], ezVec3::MakeZero(), 0.0f);
+    for (ezUInt32 i = 1; i < uiNumElements; ++i)
+    {
+      EZ_TEST_VEC3(pData3[i], ezVec3(i * 0.5f, (float)i, i * -1.5f), 0.0f);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "AddFloat4")
+  {
+    FillStreams(pFloat3, pFloat4, uiNumElements);
+
+    ezProcessingStreamKernels::AddFloat4(pFloat4, 0, uiNumElements, ezSimdVec4f(1, 2, 3, 4));
+
+    for (ezUInt32 i = 0; i < uiNumElements; ++i)
+    {
+      EZ_TEST_VEC4(pData4[i], ezVec4(i + 1.0f, i * 0.5f + 2.0f, i * -1.0f + 3.0f, i + 4.0f), 0.0f);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "MulAddFloat3ToFloat4")
+  {
+    FillStreams(pFloat3, pFloat4, uiNumElements);
+
+    ezProcessingStreamKernels::MulAddFloat3ToFloat4(pFloat4, pFloat3, 3, uiNumElements - 3, 2.0f);
+
+    for (ezUInt32 i = 0; i < uiNumElements; ++i)
+    {
+      const ezVec4 vOriginal((float)i, i * 0.5f, i * -1.0f, (float)i);
+      const ezVec4 vExpected = (i >= 3) ? vOriginal + ezVec4(i * 2.0f, i * 4.0f, i * -6.0f, 0.0f) : vOriginal;
+      EZ_TEST_VEC4(pData4[i], vExpected, 0.0f);
+    }
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Scalar vs. SIMD")
+  {
+    constexpr ezUInt32 uiNumParticles = 100000;
+    constexpr ezUInt32 uiNumIterations = 100;
+
+    ezProcessingStreamGroup PerfGroup;
+    ezProcessingStream* pVelocity = PerfGroup.AddStream("Velocity", ezProcessingStream::DataType::Float3);
+    ezProcessingStream* pPosition = PerfGroup.AddStream("Position", ezProcessingStream::DataType::Float4);
+    PerfGroup.SetSize(uiNumParticles);
+    PerfGroup.Process();
+    FillStreams(pVelocity, pPosition, uiNumParticles);
+
+    const ezVec3 vGravity(0, 0, -0.16f);
+    const float fFriction = 0.99f;
+    const float fTimeDiff = 1.0f / 60.0f;
+
+    ezTime tScalar;
+    ezTime tSimd;
+
+    for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+    {
+      const ezTime t0 = ezTime::Now();
+
+      {
+        ezProcessingStreamIterator<ezVec3> itVelocity(pVelocity, uiNumParticles, 0);
+        while (!itVelocity.HasReachedEnd())
+        {
+          itVelocity.Current() += vGravity;
+          itVelocity.Advance();
+        }
+      }
+
+      {
+        ezProcessingStreamIterator<ezVec3> itVelocity(pVelocity, uiNumParticles, 0);
+        while (!itVelocity.HasReachedEnd())
+        {
+          itVelocity.Current() *= fFriction;
+          itVelocity.Advance();
+        }
+      }
+
+      {
+        ezProcessingStreamIterator<ezVec4> itPosition(pPosition, uiNumParticles, 0);
+        ezProcessingStreamIterator<ezVec3> itVelocity(pVelocity, uiNumParticles, 0);
+        while (!itPosition.HasReachedEnd())
+        {
+          reinterpret_cast<ezVec3&>(itPosition.Current()) += itVelocity.Current() * fTimeDiff;
+          itPosition.Advance();
+          itVelocity.Advance();
+        }
+      }
+
+      const ezTime t1 = ezTime::Now();
+
+      ezProcessingStreamKernels::AddFloat3(pVelocity, 0, uiNumParticles, vGravity);
+      ezProcessingStreamKernels::MulFloat3(pVelocity, 0, uiNumParticles, fFriction);
+      ezProcessingStreamKernels::MulAddFloat3ToFloat4(pPosition, pVelocity, 0, uiNumParticles, fTimeDiff);
+
+      const ezTime t2 = ezTime::Now();
+
+      tScalar += t1 - t0;
+      tSimd += t2 - t1;
+    }
+
+    ezLog::Info("[test]Particle update (gravity, friction, velocity), scalar: {0} particles/ms", ezArgF(uiNumParticles * uiNumIterations / tScalar.GetMilliseconds(), 1));
+    ezLog::Info("[test]Particle update (gravity, friction, velocity), SIMD: {0} particles/ms", ezArgF(uiNumParticles * uiNumIterations / tSimd.GetMilliseconds(), 1));
+  }
+}
@@ -150,11 +150,127 @@ EZ_CREATE_SIMPLE_TEST(IO, Archive)
       EZ_TEST_FILES(sFileSrc, sFileDst, "Unpacked file should be identical");
     }
 
+    // decompress all files ahead of time, opening them afterwards takes over the prefetched data
+    const ezDataDirectoryInfo* pDataDirInfo = ezFileSystem::FindDataDirectoryWithRoot("archive");
+    if (EZ_TEST_BOOL(pDataDirInfo != nullptr))
+    {
+      ezDataDirectory::ArchiveType* pArchiveDataDir = static_cast<ezDataDirectory::ArchiveType*>(pDataDirInfo->m_pDataDirType);
+
+      // files that are not in the archive are ignored
+      ezHybridArray<ezStringView, 8> filesToPrefetch;
+      filesToPrefetch.PushBack("DoesNotExist.txt");
+      for (const char* szFile : szFileList)
+      {
+        filesToPrefetch.PushBack(szFile);
+      }
+
+      pArchiveDataDir->PrefetchFiles(filesToPrefetch);
+
+      for (ezUInt32 uiFileIdx = 0; uiFileIdx < EZ_ARRAY_SIZE(szFileList); ++uiFileIdx)
+      {
+        sFileSrc.Set(":output/", szTestData, "/", szFileList[uiFileIdx]);
+        sFileDst.Set(":archive/", szFileList[uiFileIdx]);
+
+        EZ_TEST_FILES(sFileSrc, sFileDst, "Prefetched file should be identical");
+      }
+    }
+
     // mount a second time
     if (!EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sArchiveFile, "Clear", "archive2", ezDataDirUsage::ReadOnly) == EZ_SUCCESS))
       return;
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Read and Prefetch Entries")
+  {
+    ezArchiveReader reader;
+    if (!EZ_TEST_BOOL(reader.OpenArchive(sArchiveFile).Succeeded()))
+      return;
+
+    const ezArchiveTOC& toc = reader.GetArchiveTOC();
+
+    constexpr ezUInt32 uiNumFiles = EZ_ARRAY_SIZE(szFileList);
+    ezUInt32 entryIndices[uiNumFiles];
+    ezDynamicArray<ezUInt8> expectedData[uiNumFiles];
+    ezUInt32 uiNumCompressedEntries = 0;
+
+    ezStringBuilder sFileSrc;
+
+    for (ezUInt32 uiFileIdx = 0; uiFileIdx < uiNumFiles; ++uiFileIdx)
+    {
+      entryIndices[uiFileIdx] = toc.FindEntry(szFileList[uiFileIdx]);
+      if (!EZ_TEST_BOOL(entryIndices[uiFileIdx] != ezInvalidIndex))
+        return;
+
+      if (toc.m_Entries[entryIndices[uiFileIdx]].m_CompressionMode != ezArchiveCompressionMode::Uncompressed)
+        ++uiNumCompressedEntries;
+
+      sFileSrc.Set(":output/", szTestData, "/", szFileList[uiFileIdx]);
+
+      ezFileReader file;
+      if (!EZ_TEST_BOOL(file.Open(sFileSrc).Succeeded()))
+        return;
+
+      expectedData[uiFileIdx].SetCountUninitialized(static_cast<ezUInt32>(file.GetFileSize()));
+      EZ_TEST_INT(file.ReadBytes(expectedData[uiFileIdx].GetData(), expectedData[uiFileIdx].GetCount()), expectedData[uiFileIdx].GetCount());
+    }
+
+    // the jpg and zip files (and the empty file) are stored uncompressed, but the others need to be decompressed
+    EZ_TEST_BOOL(uiNumCompressedEntries > 0 && uiNumCompressedEntries < uiNumFiles);
+
+    ezDynamicArray<ezUInt8> data[uiNumFiles];
+    EZ_TEST_BOOL(reader.ReadEntries(ezMakeArrayPtr(entryIndices), ezMakeArrayPtr(data)).Succeeded());
+
+    for (ezUInt32 uiFileIdx = 0; uiFileIdx < uiNumFiles; ++uiFileIdx)
+    {
+      EZ_TEST_BOOL(data[uiFileIdx] == expectedData[uiFileIdx]);
+    }
+
+    // only compressed entries keep prefetched data
+    reader.PrefetchEntries(ezMakeArrayPtr(entryIndices));
+    EZ_TEST_INT(reader.GetNumPrefetchedEntries(), uiNumCompressedEntries);
+
+    // prefetching again doesn't decompress anything twice
+    reader.PrefetchEntries(ezMakeArrayPtr(entryIndices));
+    EZ_TEST_INT(reader.GetNumPrefetchedEntries(), uiNumCompressedEntries);
+
+    for (ezUInt32 uiFileIdx = 0; uiFileIdx < uiNumFiles; ++uiFileIdx)
+    {
+      const bool bCompressed = toc.m_Entries[entryIndices[uiFileIdx]].m_CompressionMode != ezArchiveCompressionMode::Uncompressed;
+
+      ezDynamicArray<ezUInt8> prefetchedData;
+      EZ_TEST_BOOL(reader.TakePrefetchedEntry(entryIndices[uiFileIdx], prefetchedData) == bCompressed);
+
+      if (bCompressed)
+      {
+        EZ_TEST_BOOL(prefetchedData == expectedData[uiFileIdx]);
+
+        // the data can only be taken once
+        EZ_TEST_BOOL(!reader.TakePrefetchedEntry(entryIndices[uiFileIdx], prefetchedData));
+      }
+    }
+
+    EZ_TEST_INT(reader.GetNumPrefetchedEntries(), 0);
+
+    reader.PrefetchEntries(ezMakeArrayPtr(entryIndices));
+    reader.ClearPrefetchedEntries();
+    EZ_TEST_INT(reader.GetNumPrefetchedEntries(), 0);
+
+    // reading an entry through a reader works the same, whether it was prefetched or not
+    reader.PrefetchEntries(ezMakeArrayPtr(entryIndices));
+
+    for (ezUInt32 uiFileIdx = 0; uiFileIdx < uiNumFiles; ++uiFileIdx)
+    {
+      ezUniquePtr<ezStreamReader> pEntryReader = reader.CreateEntryReader(entryIndices[uiFileIdx]);
+
+      ezDynamicArray<ezUInt8> entryData;
+      entryData.SetCountUninitialized(expectedData[uiFileIdx].GetCount());
+      EZ_TEST_INT(pEntryReader->ReadBytes(entryData.GetData(), entryData.GetCount()), entryData.GetCount());
+      EZ_TEST_BOOL(entryData == expectedData[uiFileIdx]);
+    }
+
+    EZ_TEST_INT(reader.GetNumPrefetchedEntries(), 0);
+  }
+
   ezFileSystem::RemoveDataDirectoryGroup("Clear");
 }
 
@@ -5,6 +5,7 @@
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/Math/Float16.h>
 #include <Foundation/Memory/MemoryTracker.h>
 #include <Texture/Image/Formats/BmpFileFormat.h>
 #include <Texture/Image/Formats/DdsFileFormat.h>
@@ -230,3 +231,87 @@ private:
 };
 
 static ezImageConversionTest s_ImageConversionTest;
+
+EZ_CREATE_SIMPLE_TEST(Image, ImageConversionFloat16)
+{
+  // The vectorized conversions must give exactly the same results as ezFloat16
+  auto bitsEqual = [](float a, float b)
+  { return *reinterpret_cast<const ezUInt32*>(&a) == *reinterpret_cast<const ezUInt32*>(&b); };
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Half to Float")
+  {
+    ezImageHeader header;
+    header.SetImageFormat(ezImageFormat::R16_FLOAT);
+    header.SetWidth(256);
+    header.SetHeight(256);
+
+    ezImage image;
+    image.ResetAndAlloc(header);
+
+    ezUInt16* pHalfs = image.GetBlobPtr<ezUInt16>().GetPtr();
+    for (ezUInt32 i = 0; i < 0x10000; ++i)
+    {
+      pHalfs[i] = static_cast<ezUInt16>(i);
+    }
+
+    EZ_TEST_BOOL(image.Convert(ezImageFormat::R32_FLOAT).Succeeded());
+
+    const float* pFloats = image.GetBlobPtr<float>().GetPtr();
+
+    ezUInt32 uiNumMismatches = 0;
+    for (ezUInt32 i = 0; i < 0x10000; ++i)
+    {
+      ezFloat16 half;
+      half.SetRawData(static_cast<ezUInt16>(i));
+
+      if (!bitsEqual(pFloats[i], half))
+        ++uiNumMismatches;
+    }
+
+    EZ_TEST_INT(uiNumMismatches, 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Float to Half")
+  {
+    // large enough to be converted in parallel
+    ezImageHeader header;
+    header.SetImageFormat(ezImageFormat::R32_FLOAT);
+    header.SetWidth(1024);
+    header.SetHeight(512);
+
+    ezImage image;
+    image.ResetAndAlloc(header);
+
+    ezBlobPtr<ezUInt32> floatBits = image.GetBlobPtr<ezUInt32>();
+
+    // special values first, then random bit patterns covering all exponents
+    const ezUInt32 specialValues[] = {0x00000000, 0x80000000, 0x7F800000, 0xFF800000, 0x7FC00000, 0x7F800001, 0xFF801000, 0x477FE000, 0x477FF000,
+      0x47800000, 0x38800000, 0x387FFFFF, 0x33800000, 0x337FFFFF, 0x33000000, 0x32FFFFFF, 0xB3000000, 0x00000001, 0x3F800000, 0xBF800000};
+
+    ezUInt32 uiState = 0x12345678;
+    for (ezUInt64 i = 0; i < floatBits.GetCount(); ++i)
+    {
+      uiState = uiState * 1664525u + 1013904223u;
+      floatBits[i] = i < EZ_ARRAY_SIZE(specialValues) ? specialValues[i] : uiState;
+    }
+
+    ezDynamicArray<ezUInt32> sourceBits;
+    sourceBits.SetCountUninitialized(static_cast<ezUInt32>(floatBits.GetCount()));
+    ezMemoryUtils::Copy(sourceBits.GetData(), floatBits.GetPtr(), sourceBits.GetCount());
+
+    EZ_TEST_BOOL(image.Convert(ezImageFormat::R16_FLOAT).Succeeded());
+
+    const ezUInt16* pHalfs = image.GetBlobPtr<ezUInt16>().GetPtr();
+
+    ezUInt32 uiNumMismatches = 0;
+    for (ezUInt32 i = 0; i < sourceBits.GetCount(); ++i)
+    {
+      ezFloat16 half = *reinterpret_cast<const float*>(&sourceBits[i]);
+
+      if (pHalfs[i] != half.GetRawData())
+        ++uiNumMismatches;
+    }
+
+    EZ_TEST_INT(uiNumMismatches, 0);
+  }
+}
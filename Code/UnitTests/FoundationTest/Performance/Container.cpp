@@ -1,9 +1,15 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
+#include <Foundation/Containers/ConcurrentHashTable.h>
 #include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Memory/AllocatorWithPolicy.h>
+#include <Foundation/Memory/Policies/AllocPolicyHeap.h>
 #include <Foundation/Reflection/Reflection.h>
 #include <Foundation/Strings/String.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/Thread.h>
 #include <Foundation/Time/Time.h>
 
 #include <vector>
@@ -75,6 +81,114 @@ namespace
 
   ezUInt32 SomeBigObject::constructionCount = 0;
   ezUInt32 SomeBigObject::destructionCount = 0;
+
+  enum HashTableContentionConstants
+  {
+    NUM_CACHE_KEYS = 4096,
+    NUM_CACHE_ACCESSES = 1024 * 64,
+  };
+
+  /// Simulates a shared cache: mostly lookups, every 64th access replaces an entry.
+  template <typename Table>
+  class HashTableContentionThread : public ezThread
+  {
+  public:
+    HashTableContentionThread()
+      : ezThread("Hash Table Contention")
+    {
+    }
+
+    Table* m_pTable = nullptr;
+    ezUInt32 m_uiSeed = 0;
+    ezUInt32 m_uiSum = 0;
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      ezUInt32 uiKey = m_uiSeed;
+      for (ezUInt32 i = 0; i < NUM_CACHE_ACCESSES; ++i)
+      {
+        uiKey = (uiKey * 1664525u + 1013904223u);
+        const ezUInt32 uiCacheKey = (uiKey >> 8) % NUM_CACHE_KEYS;
+
+        if ((i & 63) == 0)
+        {
+          m_pTable->Insert(uiCacheKey, i);
+        }
+        else
+        {
+          ezUInt32 uiValue = 0;
+          m_pTable->TryGetValue(uiCacheKey, uiValue);
+          m_uiSum += uiValue;
+        }
+      }
+
+      return 0;
+    }
+  };
+
+  class MutexHashTable
+  {
+  public:
+    void Insert(ezUInt32 uiKey, ezUInt32 uiValue)
+    {
+      EZ_LOCK(m_Mutex);
+      m_Table.Insert(uiKey, uiValue);
+    }
+
+    bool TryGetValue(ezUInt32 uiKey, ezUInt32& out_uiValue)
+    {
+      EZ_LOCK(m_Mutex);
+      return m_Table.TryGetValue(uiKey, out_uiValue);
+    }
+
+  private:
+    ezMutex m_Mutex;
+    ezHashTable<ezUInt32, ezUInt32> m_Table;
+  };
+
+  /// The default allocator records a callstack for every allocation in development builds, which would dominate the cost of replacing entries.
+  struct UntrackedAllocatorWrapper
+  {
+    static ezAllocator* GetAllocator()
+    {
+      static ezAllocatorWithPolicy<ezAllocPolicyHeap, ezAllocatorTrackingMode::Nothing> s_Allocator("UntrackedHashTableAllocator");
+      return &s_Allocator;
+    }
+  };
+
+  template <typename Table>
+  ezTime MeasureHashTableContention(ezUInt32 uiNumThreads)
+  {
+    Table table;
+    for (ezUInt32 i = 0; i < NUM_CACHE_KEYS; ++i)
+    {
+      table.Insert(i, i);
+    }
+
+    ezDynamicArray<ezUniquePtr<HashTableContentionThread<Table>>> threads;
+    for (ezUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      auto& pThread = threads.ExpandAndGetRef();
+      pThread = EZ_DEFAULT_NEW(HashTableContentionThread<Table>);
+      pThread->m_pTable = &table;
+      pThread->m_uiSeed = i;
+    }
+
+    ezTime t0 = ezTime::Now();
+
+    for (auto& pThread : threads)
+    {
+      pThread->Start();
+    }
+
+    for (auto& pThread : threads)
+    {
+      pThread->Join();
+    }
+
+    return ezTime::Now() - t0;
+  }
 } // namespace
 
 // Enable when needed
@@ -419,4 +533,17 @@ EZ_CREATE_SIMPLE_TEST(Performance, Container)
         ezArgF((t1 - t0).GetMilliseconds() / static_cast<double>(NUM_SAMPLES), 4), sum);
     }
   }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "ezConcurrentHashTable vs. ezHashTable with ezMutex")
+  {
+    for (ezUInt32 uiNumThreads = 1; uiNumThreads <= 64; uiNumThreads *= 2)
+    {
+      const ezTime tMutex = MeasureHashTableContention<MutexHashTable>(uiNumThreads);
+      const ezTime tConcurrent = MeasureHashTableContention<ezConcurrentHashTable<ezUInt32, ezUInt32>>(uiNumThreads);
+      const ezTime tConcurrentUntracked = MeasureHashTableContention<ezConcurrentHashTable<ezUInt32, ezUInt32, ezHashHelper<ezUInt32>, UntrackedAllocatorWrapper>>(uiNumThreads);
+
+      ezLog::Info("[test]Hash table contention with {0} threads: ezHashTable + ezMutex = {1}ms, ezConcurrentHashTable = {2}ms ({3}ms without allocation tracking)",
+        uiNumThreads, ezArgF(tMutex.GetMilliseconds(), 2), ezArgF(tConcurrent.GetMilliseconds(), 2), ezArgF(tConcurrentUntracked.GetMilliseconds(), 2));
+    }
+  }
 }
@@ -0,0 +1,127 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  enum TaskSystemConstants
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    NUM_ROOT_TASKS = 16,
+    NUM_CHILD_TASKS = 256,
+    NUM_FRAMES = 10,
+#else
+    NUM_ROOT_TASKS = 32,
+    NUM_CHILD_TASKS = 512,
+    NUM_FRAMES = 50,
+#endif
+  };
+
+  class ezPerfChildTask final : public ezTask
+  {
+  public:
+    ezPerfChildTask() { ConfigureTask("ezPerfChildTask", ezTaskNesting::Never); }
+
+    ezAtomicInteger32* m_pCounter = nullptr;
+
+  private:
+    virtual void Execute() override
+    {
+      // a tiny bit of work, so that the scheduling overhead dominates
+      ezUInt32 uiResult = 0;
+      for (ezUInt32 i = 0; i < 64; ++i)
+      {
+        uiResult += i * i;
+      }
+
+      m_pCounter->Add(uiResult != 0 ? 1 : 0);
+    }
+  };
+
+  /// Spawns its child tasks from within a worker thread and waits for them, which is the typical pattern of nested parallel work.
+  class ezPerfRootTask final : public ezTask
+  {
+  public:
+    ezPerfRootTask() { ConfigureTask("ezPerfRootTask", ezTaskNesting::Maybe); }
+
+    ezDynamicArray<ezSharedPtr<ezPerfChildTask>> m_Children;
+
+  private:
+    virtual void Execute() override
+    {
+      ezTaskGroupID group = ezTaskSystem::CreateTaskGroup(ezTaskPriority::EarlyThisFrame);
+
+      for (auto& pChild : m_Children)
+      {
+        ezTaskSystem::AddTaskToGroup(group, pChild);
+      }
+
+      ezTaskSystem::StartTaskGroup(group);
+      ezTaskSystem::WaitForGroup(group);
+    }
+  };
+} // namespace
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST(Performance, TaskSystem)
+{
+  ezAtomicInteger32 iCounter;
+
+  ezDynamicArray<ezSharedPtr<ezPerfRootTask>> roots;
+  roots.SetCount(NUM_ROOT_TASKS);
+
+  for (auto& pRoot : roots)
+  {
+    pRoot = EZ_DEFAULT_NEW(ezPerfRootTask);
+    pRoot->m_Children.SetCount(NUM_CHILD_TASKS);
+
+    for (auto& pChild : pRoot->m_Children)
+    {
+      pChild = EZ_DEFAULT_NEW(ezPerfChildTask);
+      pChild->m_pCounter = &iCounter;
+    }
+  }
+
+  const ezUInt32 uiNumTasksPerFrame = NUM_ROOT_TASKS * (NUM_CHILD_TASKS + 1);
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Nested Tasks Throughput")
+  {
+    const ezUInt32 workerCounts[] = {1, 2, 4, 8, 16};
+
+    for (ezUInt32 uiWorkers : workerCounts)
+    {
+      ezTaskSystem::SetWorkerThreadCount(uiWorkers, 2);
+      iCounter = 0;
+
+      ezTime t0 = ezTime::Now();
+
+      for (ezUInt32 frame = 0; frame < NUM_FRAMES; ++frame)
+      {
+        ezTaskGroupID group = ezTaskSystem::CreateTaskGroup(ezTaskPriority::ThisFrame);
+
+        for (auto& pRoot : roots)
+        {
+          ezTaskSystem::AddTaskToGroup(group, pRoot);
+        }
+
+        ezTaskSystem::StartTaskGroup(group);
+        ezTaskSystem::WaitForGroup(group);
+      }
+
+      ezTime t1 = ezTime::Now();
+
+      EZ_TEST_INT(iCounter, NUM_FRAMES * NUM_ROOT_TASKS * NUM_CHILD_TASKS);
+
+      const double fTasksPerSecond = (NUM_FRAMES * uiNumTasksPerFrame) / (t1 - t0).GetSeconds();
+      ezLog::Info("[test]Nested Tasks with {0} workers: {1} tasks/sec ({2}ms)", uiWorkers, ezArgF(fTasksPerSecond, 0),
+        ezArgF((t1 - t0).GetMilliseconds(), 2));
+    }
+  }
+
+  // restore the default configuration
+  ezTaskSystem::SetWorkerThreadCount();
+}
@@ -0,0 +1,249 @@
+#include <GameEngineTest/GameEngineTestPCH.h>
+
+#ifdef BUILDSYSTEM_ENABLE_RECAST_SUPPORT
+
+#  include <AiPlugin/Navigation/PathSearchQueue.h>
+#  include <DetourNavMesh.h>
+#  include <DetourNavMeshBuilder.h>
+#  include <Foundation/Configuration/Startup.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Ai);
+
+namespace
+{
+  /// Creates a navmesh with two quads next to each other. If they are not connected, there is a gap between them.
+  dtNavMesh* CreateNavMesh(bool bConnected)
+  {
+    constexpr ezUInt16 N = 0xFFFF;
+
+    // clang-format off
+    const ezUInt16 connectedVerts[] = {
+      0, 0, 0,   10, 0, 0,   20, 0, 0,
+      20, 0, 10, 10, 0, 10,  0, 0, 10,
+    };
+
+    const ezUInt16 connectedPolys[] = {
+      0, 1, 4, 5,   N, 1, N, N,
+      1, 2, 3, 4,   N, N, N, 0,
+    };
+
+    const ezUInt16 disconnectedVerts[] = {
+      0, 0, 0,   10, 0, 0,  10, 0, 10,  0, 0, 10,
+      12, 0, 0,  22, 0, 0,  22, 0, 10,  12, 0, 10,
+    };
+
+    const ezUInt16 disconnectedPolys[] = {
+      0, 1, 2, 3,   N, N, N, N,
+      4, 5, 6, 7,   N, N, N, N,
+    };
+    // clang-format on
+
+    const ezUInt8 polyAreas[] = {0, 0};
+    const ezUInt16 polyFlags[] = {1, 1};
+
+    dtNavMeshCreateParams params;
+    ezMemoryUtils::ZeroFill(&params, 1);
+    params.verts = bConnected ? connectedVerts : disconnectedVerts;
+    params.vertCount = bConnected ? 6 : 8;
+    params.polys = bConnected ? connectedPolys : disconnectedPolys;
+    params.polyAreas = polyAreas;
+    params.polyFlags = polyFlags;
+    params.polyCount = 2;
+    params.nvp = 4;
+    params.walkableHeight = 2.0f;
+    params.walkableRadius = 0.5f;
+    params.walkableClimb = 0.5f;
+    params.bmin[0] = 0.0f;
+    params.bmin[1] = 0.0f;
+    params.bmin[2] = 0.0f;
+    params.bmax[0] = 22.0f;
+    params.bmax[1] = 1.0f;
+    params.bmax[2] = 10.0f;
+    params.cs = 1.0f;
+    params.ch = 1.0f;
+    params.buildBvTree = true;
+
+    unsigned char* pData = nullptr;
+    int iDataSize = 0;
+    if (!dtCreateNavMeshData(&params, &pData, &iDataSize))
+      return nullptr;
+
+    dtNavMesh* pNavMesh = dtAllocNavMesh();
+    if (dtStatusFailed(pNavMesh->init(pData, iDataSize, DT_TILE_FREE_DATA)))
+    {
+      dtFree(pData);
+      dtFreeNavMesh(pNavMesh);
+      return nullptr;
+    }
+
+    return pNavMesh;
+  }
+
+  ezSharedPtr<ezAiPathSearchRequest> CreateRequest(const dtNavMesh* pNavMesh, const dtQueryFilter& filter, ezUInt32 uiStartPoly, ezUInt32 uiEndPoly)
+  {
+    const dtPolyRef polyBase = pNavMesh->getPolyRefBase(pNavMesh->getTile(0));
+
+    // the centers of the polygons, Recast uses Y as the up axis
+    const ezVec3 polyCenters[] = {ezVec3(5, 5, 0), ezVec3(16, 5, 0)};
+
+    ezSharedPtr<ezAiPathSearchRequest> pRequest = EZ_DEFAULT_NEW(ezAiPathSearchRequest);
+    pRequest->m_pFilter = &filter;
+    pRequest->m_StartPoly = polyBase | uiStartPoly;
+    pRequest->m_EndPoly = polyBase | uiEndPoly;
+    pRequest->m_vStartPosition = polyCenters[uiStartPoly];
+    pRequest->m_vEndPosition = polyCenters[uiEndPoly];
+    return pRequest;
+  }
+
+  bool IsCorridor(const dtNavMesh* pNavMesh, const ezAiPathSearchRequest& request, std::initializer_list<ezUInt32> polys)
+  {
+    const dtPolyRef polyBase = pNavMesh->getPolyRefBase(pNavMesh->getTile(0));
+    const ezArrayPtr<const dtPolyRef> corridor = request.GetPathCorridor();
+
+    if (corridor.GetCount() != polys.size())
+      return false;
+
+    ezUInt32 i = 0;
+    for (ezUInt32 uiPoly : polys)
+    {
+      if (corridor[i++] != (polyBase | uiPoly))
+        return false;
+    }
+
+    return true;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Ai, PathSearchQueue)
+{
+  ezStartup::StartupCoreSystems();
+  EZ_SCOPE_EXIT(ezStartup::ShutdownCoreSystems());
+
+  dtNavMesh* pConnectedNavMesh = CreateNavMesh(true);
+  dtNavMesh* pDisconnectedNavMesh = CreateNavMesh(false);
+  EZ_SCOPE_EXIT(dtFreeNavMesh(pConnectedNavMesh); dtFreeNavMesh(pDisconnectedNavMesh););
+
+  if (!EZ_TEST_BOOL(pConnectedNavMesh != nullptr && pDisconnectedNavMesh != nullptr))
+    return;
+
+  const ezTime tBudget = ezTime::MakeFromSeconds(10);
+
+  dtQueryFilter filter;
+
+  ezAiPathSearchQueue queue;
+  queue.SetNavMesh(pConnectedNavMesh);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Find Path")
+  {
+    auto pRequest = CreateRequest(pConnectedNavMesh, filter, 0, 1);
+    queue.AddRequest(pRequest);
+    EZ_TEST_INT(queue.GetNumPendingRequests(), 1);
+
+    queue.ProcessRequests(tBudget);
+
+    EZ_TEST_INT(queue.GetNumPendingRequests(), 0);
+    EZ_TEST_BOOL(pRequest->GetState() == ezAiPathSearchState::FullPathFound);
+    EZ_TEST_BOOL(IsCorridor(pConnectedNavMesh, *pRequest, {0, 1}));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Slot Reuse")
+  {
+    // the query slots are created once and then reused for the searches of the following frames
+    for (ezUInt32 uiFrame = 0; uiFrame < 4; ++uiFrame)
+    {
+      // makes sure the searches run in the slots and aren't answered from the cache
+      queue.OnNavMeshModified();
+
+      ezHybridArray<ezSharedPtr<ezAiPathSearchRequest>, 32> requests;
+      for (ezUInt32 i = 0; i < 32; ++i)
+      {
+        requests.PushBack(CreateRequest(pConnectedNavMesh, filter, (i + uiFrame) % 2, i % 2));
+        queue.AddRequest(requests.PeekBack());
+      }
+
+      // nobody waits for this one anymore, it is dropped
+      queue.AddRequest(CreateRequest(pConnectedNavMesh, filter, 0, 1));
+
+      queue.ProcessRequests(tBudget);
+
+      EZ_TEST_INT(queue.GetNumPendingRequests(), 0);
+
+      for (ezUInt32 i = 0; i < requests.GetCount(); ++i)
+      {
+        const ezUInt32 uiStart = (i + uiFrame) % 2;
+        const ezUInt32 uiEnd = i % 2;
+
+        EZ_TEST_BOOL(requests[i]->GetState() == ezAiPathSearchState::FullPathFound);
+
+        if (uiStart == uiEnd)
+          EZ_TEST_BOOL(IsCorridor(pConnectedNavMesh, *requests[i], {uiStart}));
+        else
+          EZ_TEST_BOOL(IsCorridor(pConnectedNavMesh, *requests[i], {uiStart, uiEnd}));
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Modified Filter")
+  {
+    auto pRequest = CreateRequest(pConnectedNavMesh, filter, 0, 1);
+    queue.AddRequest(pRequest);
+    queue.ProcessRequests(tBudget);
+    EZ_TEST_BOOL(pRequest->GetState() == ezAiPathSearchState::FullPathFound);
+
+    // the same filter object excludes all polygons now, so the cached result of the unmodified filter must not be used
+    filter.setExcludeFlags(1);
+    EZ_SCOPE_EXIT(filter.setExcludeFlags(0));
+
+    queue.AddRequest(pRequest);
+    queue.ProcessRequests(tBudget);
+    EZ_TEST_BOOL(pRequest->GetState() == ezAiPathSearchState::PartialPathFound);
+    EZ_TEST_BOOL(IsCorridor(pConnectedNavMesh, *pRequest, {0}));
+
+    // a different filter object with the same settings gets the same result
+    dtQueryFilter filter2;
+    filter2.setExcludeFlags(1);
+
+    auto pRequest2 = CreateRequest(pConnectedNavMesh, filter2, 0, 1);
+    queue.AddRequest(pRequest2);
+    queue.ProcessRequests(tBudget);
+    EZ_TEST_BOOL(pRequest2->GetState() == ezAiPathSearchState::PartialPathFound);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Switch NavMesh")
+  {
+    // the result for the connected navmesh is in the cache now
+    auto pRequest = CreateRequest(pConnectedNavMesh, filter, 0, 1);
+    queue.AddRequest(pRequest);
+    queue.ProcessRequests(tBudget);
+    EZ_TEST_BOOL(pRequest->GetState() == ezAiPathSearchState::FullPathFound);
+
+    // a request that is still queued when the navmesh is replaced gets a result right away
+    auto pQueued = CreateRequest(pConnectedNavMesh, filter, 0, 1);
+    queue.AddRequest(pQueued);
+
+    queue.SetNavMesh(pDisconnectedNavMesh);
+
+    EZ_TEST_INT(queue.GetNumPendingRequests(), 0);
+    EZ_TEST_BOOL(pQueued->GetState() == ezAiPathSearchState::Invalidated);
+    EZ_TEST_INT(pQueued->GetPathCorridor().GetCount(), 0);
+
+    // both navmeshes use the same polygon references, the search is done on the new navmesh and not answered from the cache
+    pRequest = CreateRequest(pDisconnectedNavMesh, filter, 0, 1);
+    queue.AddRequest(pRequest);
+    queue.ProcessRequests(tBudget);
+    EZ_TEST_BOOL(pRequest->GetState() == ezAiPathSearchState::PartialPathFound);
+    EZ_TEST_BOOL(IsCorridor(pDisconnectedNavMesh, *pRequest, {0}));
+
+    queue.SetNavMesh(pConnectedNavMesh);
+
+    queue.AddRequest(pRequest);
+    queue.ProcessRequests(tBudget);
+    EZ_TEST_BOOL(pRequest->GetState() == ezAiPathSearchState::FullPathFound);
+    EZ_TEST_BOOL(IsCorridor(pConnectedNavMesh, *pRequest, {0, 1}));
+  }
+
+  // the queue must not reference the navmeshes anymore, when they are deleted
+  queue.SetNavMesh(nullptr);
+}
+
+#endif
@@ -0,0 +1,196 @@
+#include <GameEngineTest/GameEngineTestPCH.h>
+
+#include <Core/Scripting/ScriptRTTI.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <VisualScriptPlugin/Runtime/VisualScriptInstance.h>
+
+namespace
+{
+  using DataOffset = ezVisualScriptDataDescription::DataOffset;
+
+  constexpr ezInt32 s_iNumIterations = 10000;
+
+  // Nodes that a script invocation executes without optimizations: constant branch, set variable, (compare, branch, increment) per iteration and the final compare and branch.
+  constexpr ezUInt32 s_uiNodesPerInvocation = 2 + 3 * s_iNumIterations + 2;
+
+  ezUInt16 NoTarget()
+  {
+    return static_cast<ezUInt16>(ezInvalidIndex);
+  }
+
+  ezVisualScriptNodeDescription& AddNode(ezDynamicArray<ezVisualScriptNodeDescription>& ref_nodes, ezVisualScriptNodeDescription::Type::Enum type, ezVisualScriptDataType::Enum dataType, std::initializer_list<ezUInt16> executionIndices)
+  {
+    auto& nodeDesc = ref_nodes.ExpandAndGetRef();
+    nodeDesc.m_Type = type;
+    nodeDesc.m_DeductedDataType = dataType;
+
+    for (ezUInt16 uiIndex : executionIndices)
+    {
+      nodeDesc.m_ExecutionIndices.PushBack(uiIndex);
+    }
+
+    return nodeDesc;
+  }
+
+  // Builds a counting loop with a constant branch in front of it:
+  //
+  //   Entry -> Branch(true) -> Counter = 0 -> Compare(Counter < Limit) -> Branch -> Counter++
+  //                                               ^-----------------------------------'
+  ezResult SerializeCountingLoop(ezStreamWriter& inout_stream)
+  {
+    ezDynamicArray<ezVisualScriptNodeDescription> nodes;
+
+    AddNode(nodes, ezVisualScriptNodeDescription::Type::EntryCall, ezVisualScriptDataType::Invalid, {1});
+
+    auto& constantBranch = AddNode(nodes, ezVisualScriptNodeDescription::Type::Builtin_Branch, ezVisualScriptDataType::Invalid, {2, NoTarget()});
+    constantBranch.m_InputDataOffsets.PushBack(DataOffset(0, ezVisualScriptDataType::Bool, DataOffset::Source::Constant));
+
+    auto& setCounter = AddNode(nodes, ezVisualScriptNodeDescription::Type::Builtin_SetVariable, ezVisualScriptDataType::Int, {3});
+    setCounter.m_InputDataOffsets.PushBack(DataOffset(0, ezVisualScriptDataType::Int, DataOffset::Source::Constant));
+    setCounter.m_OutputDataOffsets.PushBack(DataOffset(0, ezVisualScriptDataType::Int, DataOffset::Source::Instance));
+
+    auto& compare = AddNode(nodes, ezVisualScriptNodeDescription::Type::Builtin_Compare, ezVisualScriptDataType::Int, {4});
+    compare.m_InputDataOffsets.PushBack(DataOffset(0, ezVisualScriptDataType::Int, DataOffset::Source::Instance));
+    compare.m_InputDataOffsets.PushBack(DataOffset(1, ezVisualScriptDataType::Int, DataOffset::Source::Constant));
+    compare.m_OutputDataOffsets.PushBack(DataOffset(0, ezVisualScriptDataType::Bool, DataOffset::Source::Local));
+    compare.m_Value = ezInt64(ezComparisonOperator::Less);
+
+    auto& loopBranch = AddNode(nodes, ezVisualScriptNodeDescription::Type::Builtin_Branch, ezVisualScriptDataType::Invalid, {5, NoTarget()});
+    loopBranch.m_InputDataOffsets.PushBack(DataOffset(0, ezVisualScriptDataType::Bool, DataOffset::Source::Local));
+
+    auto& incCounter = AddNode(nodes, ezVisualScriptNodeDescription::Type::Builtin_IncVariable, ezVisualScriptDataType::Int, {3});
+    incCounter.m_InputDataOffsets.PushBack(DataOffset(0, ezVisualScriptDataType::Int, DataOffset::Source::Instance));
+    incCounter.m_OutputDataOffsets.PushBack(DataOffset(0, ezVisualScriptDataType::Int, DataOffset::Source::Instance));
+
+    ezVisualScriptDataDescription localDataDesc;
+    localDataDesc.m_PerTypeInfo[ezVisualScriptDataType::Bool].m_uiCount = 1;
+    localDataDesc.CalculatePerTypeStartOffsets();
+
+    return ezVisualScriptGraphDescription::Serialize(nodes, localDataDesc, inout_stream);
+  }
+
+  struct ScriptSetup
+  {
+    ScriptSetup()
+    {
+      ezSharedPtr<ezVisualScriptDataDescription> pInstanceDataDesc = EZ_DEFAULT_NEW(ezVisualScriptDataDescription);
+      pInstanceDataDesc->m_PerTypeInfo[ezVisualScriptDataType::Int].m_uiCount = 1;
+      pInstanceDataDesc->CalculatePerTypeStartOffsets();
+      m_pInstanceDataDesc = pInstanceDataDesc;
+
+      ezSharedPtr<ezVisualScriptDataDescription> pConstantDataDesc = EZ_DEFAULT_NEW(ezVisualScriptDataDescription);
+      pConstantDataDesc->m_PerTypeInfo[ezVisualScriptDataType::Bool].m_uiCount = 1;
+      pConstantDataDesc->m_PerTypeInfo[ezVisualScriptDataType::Int].m_uiCount = 2;
+      pConstantDataDesc->CalculatePerTypeStartOffsets();
+
+      m_pConstantDataStorage = EZ_DEFAULT_NEW(ezVisualScriptDataStorage, pConstantDataDesc);
+      m_pConstantDataStorage->AllocateStorage(ezScriptAllocator::GetAllocator());
+      m_pConstantDataStorage->SetData(pConstantDataDesc->GetOffset(ezVisualScriptDataType::Bool, 0, DataOffset::Source::Constant), true);
+      m_pConstantDataStorage->SetData(pConstantDataDesc->GetOffset(ezVisualScriptDataType::Int, 0, DataOffset::Source::Constant), ezInt32(0));
+      m_pConstantDataStorage->SetData(pConstantDataDesc->GetOffset(ezVisualScriptDataType::Int, 1, DataOffset::Source::Constant), s_iNumIterations);
+
+      m_pInstanceDataMapping = EZ_DEFAULT_NEW(ezVisualScriptInstanceDataMapping);
+      m_pInstance = EZ_DEFAULT_NEW(ezVisualScriptInstance, m_Owner, nullptr, m_pConstantDataStorage, m_pInstanceDataDesc, m_pInstanceDataMapping);
+
+      ezMemoryStreamWriter writer(&m_GraphStorage);
+      EZ_TEST_BOOL(SerializeCountingLoop(writer).Succeeded());
+    }
+
+    ezSharedPtr<const ezVisualScriptGraphDescription> LoadGraph(bool bOptimize)
+    {
+      ezCVarBool* pOptimizeCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("VisualScript.OptimizeGraphs"));
+      EZ_TEST_BOOL(pOptimizeCVar != nullptr);
+
+      const bool bPrevOptimize = *pOptimizeCVar;
+      *pOptimizeCVar = bOptimize;
+
+      ezSharedPtr<ezVisualScriptGraphDescription> pDesc = EZ_DEFAULT_NEW(ezVisualScriptGraphDescription);
+
+      ezMemoryStreamReader reader(&m_GraphStorage);
+      EZ_TEST_BOOL(pDesc->Deserialize(reader, *m_pInstanceDataDesc, *m_pConstantDataStorage).Succeeded());
+
+      *pOptimizeCVar = bPrevOptimize;
+
+      return pDesc;
+    }
+
+    ezInt32 GetCounter()
+    {
+      return m_pInstance->GetInstanceDataStorage()->GetData<ezInt32>(m_pInstanceDataDesc->GetOffset(ezVisualScriptDataType::Int, 0, DataOffset::Source::Instance));
+    }
+
+    ezReflectedClass m_Owner;
+    ezDefaultMemoryStreamStorage m_GraphStorage;
+    ezSharedPtr<const ezVisualScriptDataDescription> m_pInstanceDataDesc;
+    ezSharedPtr<ezVisualScriptDataStorage> m_pConstantDataStorage;
+    ezSharedPtr<ezVisualScriptInstanceDataMapping> m_pInstanceDataMapping;
+    ezUniquePtr<ezVisualScriptInstance> m_pInstance;
+  };
+
+  ezTime RunScript(ScriptSetup& ref_setup, const ezSharedPtr<const ezVisualScriptGraphDescription>& pDesc, ezUInt32 uiNumInvocations)
+  {
+    ezVisualScriptExecutionContext context(pDesc, ezScriptAllocator::GetAllocator());
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < uiNumInvocations; ++i)
+    {
+      context.Initialize(*ref_setup.m_pInstance, ezArrayPtr<ezVariant>());
+
+      auto result = context.Execute(ezTime::MakeZero());
+      EZ_TEST_INT(result.m_NextExecAndState, ezVisualScriptGraphDescription::ExecResult::State::Completed);
+      EZ_TEST_INT(ref_setup.GetCounter(), s_iNumIterations);
+    }
+
+    return sw.Checkpoint();
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST_GROUP(VisualScriptGraph);
+
+EZ_CREATE_SIMPLE_TEST(VisualScriptGraph, Optimization)
+{
+  ScriptSetup setup;
+
+  auto pUnoptimizedDesc = setup.LoadGraph(false);
+  auto pOptimizedDesc = setup.LoadGraph(true);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Constant Branch")
+  {
+    EZ_TEST_INT(pUnoptimizedDesc->GetNode(0)->GetExecutionIndex(0), 1);
+    EZ_TEST_INT(pOptimizedDesc->GetNode(0)->GetExecutionIndex(0), 2);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Condition And Branch")
+  {
+    auto pUnoptimizedCompare = pUnoptimizedDesc->GetNode(3);
+    auto pOptimizedCompare = pOptimizedDesc->GetNode(3);
+
+    EZ_TEST_INT(pUnoptimizedCompare->m_NumExecutionIndices, 1);
+    EZ_TEST_INT(pOptimizedCompare->m_NumExecutionIndices, 2);
+    EZ_TEST_BOOL(pOptimizedCompare->m_Function != pUnoptimizedCompare->m_Function);
+    EZ_TEST_INT(pOptimizedCompare->GetExecutionIndex(0), 5);
+    EZ_TEST_INT(pOptimizedCompare->GetExecutionIndex(1), NoTarget());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Execution")
+  {
+    RunScript(setup, pUnoptimizedDesc, 1);
+    RunScript(setup, pOptimizedDesc, 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Performance")
+  {
+    constexpr ezUInt32 uiNumInvocations = 100;
+
+    const ezTime tUnoptimized = RunScript(setup, pUnoptimizedDesc, uiNumInvocations);
+    const ezTime tOptimized = RunScript(setup, pOptimizedDesc, uiNumInvocations);
+
+    const double fNumNodes = static_cast<double>(s_uiNodesPerInvocation) * uiNumInvocations;
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Unoptimized graph: %.2fms, %.1f million nodes per second", tUnoptimized.GetMilliseconds(), fNumNodes / tUnoptimized.GetSeconds() / 1000000.0);
+    ezTestFramework::Output(ezTestOutput::Duration, "Optimized graph: %.2fms, %.1f million nodes per second", tOptimized.GetMilliseconds(), fNumNodes / tOptimized.GetSeconds() / 1000000.0);
+  }
+}
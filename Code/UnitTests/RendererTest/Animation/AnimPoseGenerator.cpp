@@ -0,0 +1,194 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Core/ResourceManager/ResourceManager.h>
+#include <Core/World/World.h>
+#include <Foundation/Configuration/Startup.h>
+#include <RendererCore/AnimationSystem/AnimPoseGenerator.h>
+#include <RendererCore/AnimationSystem/AnimationClipResource.h>
+#include <RendererCore/AnimationSystem/SkeletonBuilder.h>
+#include <RendererCore/AnimationSystem/SkeletonResource.h>
+
+namespace
+{
+  class TestPosePreparingComponent;
+  using TestPosePreparingComponentManager = ezComponentManager<TestPosePreparingComponent, ezBlockStorageType::FreeList>;
+
+  class TestPosePreparingComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(TestPosePreparingComponent, ezComponent, TestPosePreparingComponentManager);
+
+  public:
+    virtual void SerializeComponent(ezWorldWriter& inout_stream) const override {}
+    virtual void DeserializeComponent(ezWorldReader& inout_stream) override {}
+
+    void OnMsgAnimationPosePreparing(ezMsgAnimationPosePreparing& ref_msg)
+    {
+      ++m_uiNumMessages;
+
+      // moves the first four joints up, which is only visible in the final pose, if the message is sent before the conversion to model space
+      ref_msg.m_LocalTransforms[0].translation.y = ozz::math::simd_float4::Load1(1.0f);
+    }
+
+    ezUInt32 m_uiNumMessages = 0;
+  };
+
+  // clang-format off
+  EZ_BEGIN_COMPONENT_TYPE(TestPosePreparingComponent, 1, ezComponentMode::Static)
+  {
+    EZ_BEGIN_MESSAGEHANDLERS
+    {
+      EZ_MESSAGE_HANDLER(ezMsgAnimationPosePreparing, OnMsgAnimationPosePreparing),
+    }
+    EZ_END_MESSAGEHANDLERS;
+  }
+  EZ_END_COMPONENT_TYPE;
+  // clang-format on
+
+  ezSkeletonResourceHandle CreateSkeleton()
+  {
+    ezSkeletonBuilder sb;
+    const ezUInt16 uiRoot = sb.AddJoint("Root", ezTransform::MakeIdentity());
+    const ezUInt16 uiArm = sb.AddJoint("Arm", ezTransform(ezVec3(1, 0, 0)), uiRoot);
+    sb.AddJoint("Hand", ezTransform(ezVec3(1, 0, 0)), uiArm);
+
+    ezSkeletonResourceDescriptor desc;
+    sb.BuildSkeleton(desc.m_Skeleton);
+
+    return ezResourceManager::CreateResource<ezSkeletonResource>("AnimPoseGeneratorTest.Skeleton", std::move(desc));
+  }
+
+  ezAnimationClipResourceHandle CreateAnimationClip()
+  {
+    ezAnimationClipResourceDescriptor desc;
+    desc.SetDuration(ezTime::MakeFromSeconds(1.0));
+
+    const auto joint = desc.CreateJoint(ezMakeHashedString("Arm"), 1, 2, 1);
+    desc.AllocateJointTransforms();
+
+    desc.GetPositionKeyframes(joint)[0] = {0.0f, ezVec3(1, 0, 0)};
+    desc.GetRotationKeyframes(joint)[0] = {0.0f, ezQuat::MakeIdentity()};
+    desc.GetRotationKeyframes(joint)[1] = {1.0f, ezQuat::MakeFromAxisAndAngle(ezVec3(0, 0, 1), ezAngle::MakeFromDegree(90))};
+    desc.GetScaleKeyframes(joint)[0] = {0.0f, ezVec3(1)};
+
+    return ezResourceManager::CreateResource<ezAnimationClipResource>("AnimPoseGeneratorTest.Clip", std::move(desc));
+  }
+
+  void SetupPoseCommands(ezAnimPoseGenerator& ref_generator, const ezSkeletonResource* pSkeleton, const ezAnimationClipResourceHandle& hClip, float fSamplePos, ezGameObject* pTarget)
+  {
+    ref_generator.Reset(pSkeleton, pTarget);
+
+    auto& cmdSample = ref_generator.AllocCommandSampleTrack(0);
+    cmdSample.m_hAnimationClip = hClip;
+    cmdSample.m_fNormalizedSamplePos = fSamplePos;
+    cmdSample.m_fPreviousNormalizedSamplePos = fSamplePos;
+
+    auto& cmdL2M = ref_generator.AllocCommandLocalToModelPose();
+    cmdL2M.m_Inputs.PushBack(cmdSample.GetCommandID());
+    cmdL2M.m_pSendLocalPoseMsgTo = pTarget;
+
+    ref_generator.SetFinalCommand(cmdL2M.GetCommandID());
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Animation, AnimPoseGenerator)
+{
+  ezStartup::StartupCoreSystems();
+  EZ_SCOPE_EXIT(ezStartup::ShutdownCoreSystems());
+
+  constexpr ezUInt32 uiNumObjects = 64;
+
+  ezSkeletonResourceHandle hSkeleton = CreateSkeleton();
+  ezAnimationClipResourceHandle hClip = CreateAnimationClip();
+
+  ezWorldDesc worldDesc("AnimPoseGeneratorTest");
+  ezWorld world(worldDesc);
+  EZ_LOCK(world.GetWriteMarker());
+
+  TestPosePreparingComponentManager* pManager = world.GetOrCreateComponentManager<TestPosePreparingComponentManager>();
+
+  ezHybridArray<ezGameObject*, uiNumObjects> objects;
+  ezHybridArray<TestPosePreparingComponent*, uiNumObjects> components;
+
+  for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+  {
+    ezGameObjectDesc desc;
+    ezGameObject* pObject = nullptr;
+    world.CreateObject(desc, pObject);
+    objects.PushBack(pObject);
+
+    TestPosePreparingComponent* pComponent = nullptr;
+    pManager->CreateComponent(pObject, pComponent);
+    components.PushBack(pComponent);
+  }
+
+  // initializes the components, which only handle messages afterwards
+  world.Update();
+
+  ezResourceLock<ezSkeletonResource> pSkeleton(hSkeleton, ezResourceAcquireMode::BlockTillLoaded);
+
+  ezDynamicArray<ezAnimPoseGenerator> serialGenerators;
+  ezDynamicArray<ezAnimPoseGenerator> batchedGenerators;
+  serialGenerators.SetCount(uiNumObjects);
+  batchedGenerators.SetCount(uiNumObjects);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "UpdatePoses")
+  {
+    ezDynamicArray<ezAnimPoseGenerator*> generators;
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      const float fSamplePos = static_cast<float>(i) / (uiNumObjects - 1);
+
+      SetupPoseCommands(serialGenerators[i], pSkeleton.GetPointer(), hClip, fSamplePos, objects[i]);
+      serialGenerators[i].UpdatePose(false);
+
+      SetupPoseCommands(batchedGenerators[i], pSkeleton.GetPointer(), hClip, fSamplePos, objects[i]);
+      generators.PushBack(&batchedGenerators[i]);
+    }
+
+    ezAnimPoseGenerator::UpdatePoses(generators);
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      // once for the serial and once for the batched pose generation
+      EZ_TEST_INT(components[i]->m_uiNumMessages, 2);
+
+      const ezArrayPtr<ezMat4> serialPose = serialGenerators[i].GetCurrentPose();
+      const ezArrayPtr<ezMat4> batchedPose = batchedGenerators[i].GetCurrentPose();
+
+      if (!EZ_TEST_INT(batchedPose.GetCount(), serialPose.GetCount()))
+        continue;
+
+      for (ezUInt32 j = 0; j < serialPose.GetCount(); ++j)
+      {
+        EZ_TEST_BOOL(batchedPose[j].IsIdentical(serialPose[j]));
+      }
+
+      // the modification of the message handler is part of the model space pose
+      EZ_TEST_VEC3(batchedPose[0].GetTranslationVector(), ezVec3(0, 1, 0), 0.001f);
+    }
+
+    // the sampled rotation reaches the hand
+    EZ_TEST_VEC3(batchedGenerators[0].GetCurrentPose()[2].GetTranslationVector(), ezVec3(2, 3, 0), 0.001f);
+    EZ_TEST_VEC3(batchedGenerators.PeekBack().GetCurrentPose()[2].GetTranslationVector(), ezVec3(0, 3, 0), 0.001f);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "UpdatePoses Without Target")
+  {
+    ezDynamicArray<ezAnimPoseGenerator*> generators;
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      SetupPoseCommands(batchedGenerators[i], pSkeleton.GetPointer(), hClip, 0.0f, nullptr);
+      generators.PushBack(&batchedGenerators[i]);
+    }
+
+    ezAnimPoseGenerator::UpdatePoses(generators);
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      EZ_TEST_INT(components[i]->m_uiNumMessages, 2);
+      EZ_TEST_VEC3(batchedGenerators[i].GetCurrentPose()[2].GetTranslationVector(), ezVec3(2, 0, 0), 0.001f);
+    }
+  }
+}
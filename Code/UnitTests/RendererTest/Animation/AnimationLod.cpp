@@ -0,0 +1,179 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Core/Graphics/Camera.h>
+#include <Core/World/World.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Configuration/Startup.h>
+#include <RendererCore/AnimationSystem/AnimationLod.h>
+#include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+#include <RendererFoundation/Device/Device.h>
+#include <RendererFoundation/Device/DeviceFactory.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Animation);
+
+EZ_CREATE_SIMPLE_TEST(Animation, AnimationLod)
+{
+  ezStartup::StartupCoreSystems();
+  EZ_SCOPE_EXIT(ezStartup::ShutdownCoreSystems());
+
+  ezGALDeviceCreationDescription deviceDesc;
+  ezGALDevice* pDevice = ezGALDeviceFactory::CreateDevice("Null", ezFoundation::GetDefaultAllocator(), deviceDesc);
+  if (!EZ_TEST_BOOL(pDevice != nullptr))
+    return;
+
+  EZ_SCOPE_EXIT(pDevice->Shutdown().IgnoreResult(); EZ_DEFAULT_DELETE(pDevice););
+
+  if (!EZ_TEST_BOOL(pDevice->Init().Succeeded()))
+    return;
+
+  ezGALDevice::SetDefaultDevice(pDevice);
+
+  ezStartup::StartupHighLevelSystems();
+  EZ_SCOPE_EXIT(ezStartup::ShutdownHighLevelSystems());
+
+  ezCVarFloat* pLodDistance = static_cast<ezCVarFloat*>(ezCVar::FindCVarByName("Animation.Lod.Distance"));
+  if (!EZ_TEST_BOOL(pLodDistance != nullptr))
+    return;
+
+  const float fPrevLodDistance = *pLodDistance;
+  EZ_SCOPE_EXIT(*pLodDistance = fPrevLodDistance);
+
+  // LOD 1 starts at 10, LOD 2 at 20 and LOD 3 at 40
+  *pLodDistance = 10.0f;
+
+  ezWorldDesc worldDesc("AnimationLodTest");
+  ezWorld world(worldDesc);
+
+  ezWorldDesc otherWorldDesc("AnimationLodTest.Other");
+  ezWorld otherWorld(otherWorldDesc);
+
+  const float fDistances[] = {0.0f, 9.9f, 10.0f, 19.9f, 20.0f, 39.9f, 40.0f, 1000.0f};
+  const ezAnimationLod::Enum expectedLods[] = {ezAnimationLod::Lod0, ezAnimationLod::Lod0, ezAnimationLod::Lod1, ezAnimationLod::Lod1, ezAnimationLod::Lod2, ezAnimationLod::Lod2, ezAnimationLod::Lod3, ezAnimationLod::Lod3};
+
+  ezHybridArray<const ezGameObject*, 8> objects;
+
+  {
+    EZ_LOCK(world.GetWriteMarker());
+
+    for (float fDistance : fDistances)
+    {
+      ezGameObjectDesc desc;
+      desc.m_LocalPosition = ezVec3(fDistance, 0, 0);
+
+      ezGameObject* pObject = nullptr;
+      world.CreateObject(desc, pObject);
+      objects.PushBack(pObject);
+    }
+  }
+
+  ezCamera camera;
+  camera.LookAt(ezVec3::MakeZero(), ezVec3(1, 0, 0), ezVec3(0, 0, 1));
+
+  ezView* pView = nullptr;
+  const ezViewHandle hView = ezRenderWorld::CreateView("AnimationLodTest", pView);
+  EZ_SCOPE_EXIT(ezRenderWorld::RemoveMainView(hView); ezRenderWorld::DeleteView(hView););
+
+  pView->SetCamera(&camera);
+
+  ezAnimationLodScheduler scheduler;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "No Main View")
+  {
+    pView->SetWorld(&world);
+
+    EZ_LOCK(world.GetReadMarker());
+    scheduler.BeginUpdate(&world);
+
+    for (const ezGameObject* pObject : objects)
+    {
+      EZ_TEST_INT(scheduler.DetermineLod(pObject), ezAnimationLod::Lod0);
+    }
+
+    scheduler.EndUpdate("Test");
+  }
+
+  ezRenderWorld::AddMainView(hView);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Main View Of Other World")
+  {
+    pView->SetWorld(&otherWorld);
+
+    EZ_LOCK(world.GetReadMarker());
+    scheduler.BeginUpdate(&world);
+
+    EZ_TEST_INT(scheduler.DetermineLod(objects.PeekBack()), ezAnimationLod::Lod0);
+
+    scheduler.EndUpdate("Test");
+  }
+
+  pView->SetWorld(&world);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Distance")
+  {
+    EZ_LOCK(world.GetReadMarker());
+    scheduler.BeginUpdate(&world);
+
+    for (ezUInt32 i = 0; i < objects.GetCount(); ++i)
+    {
+      EZ_TEST_INT(scheduler.DetermineLod(objects[i]), expectedLods[i]);
+    }
+
+    scheduler.EndUpdate("Test");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Closest Camera")
+  {
+    // a second main view next to the farthest objects
+    ezCamera camera2;
+    camera2.LookAt(ezVec3(45, 0, 0), ezVec3(46, 0, 0), ezVec3(0, 0, 1));
+
+    ezView* pView2 = nullptr;
+    const ezViewHandle hView2 = ezRenderWorld::CreateView("AnimationLodTest2", pView2);
+    pView2->SetWorld(&world);
+    pView2->SetCamera(&camera2);
+    ezRenderWorld::AddMainView(hView2);
+
+    {
+      EZ_LOCK(world.GetReadMarker());
+      scheduler.BeginUpdate(&world);
+
+      EZ_TEST_INT(scheduler.DetermineLod(objects[0]), ezAnimationLod::Lod0);
+      EZ_TEST_INT(scheduler.DetermineLod(objects[4]), ezAnimationLod::Lod2);
+      EZ_TEST_INT(scheduler.DetermineLod(objects[5]), ezAnimationLod::Lod0);
+      EZ_TEST_INT(scheduler.DetermineLod(objects[6]), ezAnimationLod::Lod0);
+      EZ_TEST_INT(scheduler.DetermineLod(objects[7]), ezAnimationLod::Lod3);
+
+      scheduler.EndUpdate("Test");
+    }
+
+    ezRenderWorld::RemoveMainView(hView2);
+    ezRenderWorld::DeleteView(hView2);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "LODs Disabled")
+  {
+    *pLodDistance = 0.0f;
+
+    EZ_LOCK(world.GetReadMarker());
+    scheduler.BeginUpdate(&world);
+
+    for (const ezGameObject* pObject : objects)
+    {
+      EZ_TEST_INT(scheduler.DetermineLod(pObject), ezAnimationLod::Lod0);
+    }
+
+    scheduler.EndUpdate("Test");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Update Rate")
+  {
+    for (ezUInt32 i = 1; i < ezAnimationLod::ENUM_COUNT; ++i)
+    {
+      EZ_TEST_BOOL(ezAnimationLod::GetTimeStep(static_cast<ezAnimationLod::Enum>(i - 1)) < ezAnimationLod::GetTimeStep(static_cast<ezAnimationLod::Enum>(i)));
+    }
+
+    EZ_TEST_BOOL(ezAnimationLod::IsIKEnabled(ezAnimationLod::Lod2));
+    EZ_TEST_BOOL(!ezAnimationLod::IsIKEnabled(ezAnimationLod::Lod3));
+  }
+}
@@ -0,0 +1,142 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Foundation/Configuration/Startup.h>
+#include <RendererFoundation/CommandEncoder/CommandEncoder.h>
+#include <RendererFoundation/Device/DeviceFactory.h>
+#include <RendererFoundation/Device/ReadbackLock.h>
+#include <RendererFoundation/Resources/Buffer.h>
+#include <RendererNull/Device/DeviceNull.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(NullDevice);
+
+EZ_CREATE_SIMPLE_TEST(NullDevice, CommandStatistics)
+{
+  ezStartup::StartupCoreSystems();
+  EZ_SCOPE_EXIT(ezStartup::ShutdownCoreSystems());
+
+  ezGALDeviceCreationDescription desc;
+  ezGALDevice* pDevice = ezGALDeviceFactory::CreateDevice("Null", ezFoundation::GetDefaultAllocator(), desc);
+  if (!EZ_TEST_BOOL(pDevice != nullptr))
+    return;
+
+  ezGALDeviceNull* pNullDevice = static_cast<ezGALDeviceNull*>(pDevice);
+
+  EZ_TEST_BOOL(pDevice->Init().Succeeded());
+  EZ_TEST_STRING(pDevice->GetRenderer(), "Null");
+
+  ezUInt32 vertices[] = {0, 1, 2, 3, 4, 5, 6, 7};
+  ezGALBufferHandle hVertexBuffer = pDevice->CreateVertexBuffer(sizeof(ezUInt32), EZ_ARRAY_SIZE(vertices), ezMakeArrayPtr(vertices).ToByteArray(), true);
+  EZ_TEST_BOOL(!hVertexBuffer.IsInvalidated());
+
+  ezGALBufferCreationDescription readbackDesc = pDevice->GetBuffer(hVertexBuffer)->GetDescription();
+  ezGALReadbackBufferHandle hReadbackBuffer = pDevice->CreateReadbackBuffer(readbackDesc);
+  EZ_TEST_BOOL(!hReadbackBuffer.IsInvalidated());
+
+  ezGALFenceHandle hFence = 0;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Command Statistics")
+  {
+    pDevice->BeginFrame();
+
+    ezGALCommandEncoder* pEncoder = pDevice->BeginCommands("NullDevice");
+    pEncoder->BeginRendering(ezGALRenderingSetup());
+
+    pEncoder->SetVertexBuffer(0, hVertexBuffer);
+    pEncoder->SetPrimitiveTopology(ezGALPrimitiveTopology::Triangles);
+    EZ_TEST_BOOL(pEncoder->Draw(6, 0).Succeeded());
+    EZ_TEST_BOOL(pEncoder->DrawInstanced(3, 4, 0).Succeeded());
+
+    // redundant state changes are filtered out before they reach the device
+    pEncoder->SetVertexBuffer(0, hVertexBuffer);
+
+    pEncoder->EndRendering();
+
+    const ezGALCommandStatsNull& stats = pNullDevice->GetCurrentFrameStats();
+    EZ_TEST_INT(stats.m_uiDrawCalls, 2);
+    EZ_TEST_INT(stats.m_uiElementsDrawn, 18);
+    EZ_TEST_INT(stats.m_uiNumCommands[ezGALCommandTypeNull::SetVertexBuffer], 1);
+    EZ_TEST_INT(stats.m_uiNumCommands[ezGALCommandTypeNull::BeginRendering], 1);
+    EZ_TEST_INT(stats.m_uiNumCommands[ezGALCommandTypeNull::EndRendering], 1);
+
+    pDevice->EndCommands(pEncoder);
+    pDevice->EndFrame();
+
+    EZ_TEST_INT(pNullDevice->GetLastFrameStats().m_uiDrawCalls, 2);
+    EZ_TEST_INT(pNullDevice->GetCurrentFrameStats().m_uiDrawCalls, 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Buffer Readback")
+  {
+    ezUInt32 newVertices[] = {10, 11};
+
+    pDevice->BeginFrame();
+
+    ezGALCommandEncoder* pEncoder = pDevice->BeginCommands("NullDevice");
+    pEncoder->UpdateBuffer(hVertexBuffer, sizeof(ezUInt32) * 2, ezMakeArrayPtr(newVertices).ToByteArray(), ezGALUpdateMode::CopyToTempStorage);
+    pEncoder->ReadbackBuffer(hReadbackBuffer, hVertexBuffer);
+    hFence = pEncoder->InsertFence();
+    pDevice->EndCommands(pEncoder);
+
+    EZ_TEST_INT(pNullDevice->GetCurrentFrameStats().m_uiBytesUploaded, sizeof(newVertices));
+
+    pDevice->EndFrame();
+
+    EZ_TEST_BOOL(pDevice->GetFenceResult(hFence) == ezGALAsyncResult::Ready);
+
+    ezArrayPtr<const ezUInt8> memory;
+    ezReadbackBufferLock lock = pDevice->LockBuffer(hReadbackBuffer, memory);
+    if (EZ_TEST_BOOL(lock.IsValid()) && EZ_TEST_INT(memory.GetCount(), sizeof(vertices)))
+    {
+      const ezUInt32* pData = reinterpret_cast<const ezUInt32*>(memory.GetPtr());
+      EZ_TEST_INT(pData[0], 0);
+      EZ_TEST_INT(pData[1], 1);
+      EZ_TEST_INT(pData[2], 10);
+      EZ_TEST_INT(pData[3], 11);
+      EZ_TEST_INT(pData[4], 4);
+      EZ_TEST_INT(pData[7], 7);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Command Recording")
+  {
+    EZ_TEST_BOOL(!pNullDevice->IsCommandRecordingEnabled());
+    pNullDevice->SetCommandRecordingEnabled(true);
+
+    pDevice->BeginFrame();
+
+    ezGALCommandEncoder* pEncoder = pDevice->BeginCommands("NullDevice");
+    pEncoder->BeginRendering(ezGALRenderingSetup());
+    pEncoder->SetVertexBuffer(0, hVertexBuffer);
+    EZ_TEST_BOOL(pEncoder->Draw(3, 0).Succeeded());
+    EZ_TEST_BOOL(pEncoder->Draw(6, 0).Succeeded());
+    pEncoder->EndRendering();
+    pDevice->EndCommands(pEncoder);
+
+    pDevice->EndFrame();
+
+    pNullDevice->SetCommandRecordingEnabled(false);
+
+    // replaying the recorded stream yields the same statistics as the live counting
+    ezGALCommandStatsNull replayedStats;
+    for (const ezGALRecordedCommandNull& command : pNullDevice->GetRecordedCommands())
+    {
+      replayedStats.AddCommand(command);
+    }
+
+    const ezGALCommandStatsNull& stats = pNullDevice->GetLastFrameStats();
+    EZ_TEST_INT(replayedStats.m_uiDrawCalls, 2);
+    EZ_TEST_INT(replayedStats.m_uiElementsDrawn, 9);
+    EZ_TEST_INT(replayedStats.m_uiDrawCalls, stats.m_uiDrawCalls);
+    EZ_TEST_INT(replayedStats.m_uiStateChanges, stats.m_uiStateChanges);
+    EZ_TEST_INT(replayedStats.m_uiElementsDrawn, stats.m_uiElementsDrawn);
+
+    pNullDevice->ClearRecordedCommands();
+    EZ_TEST_BOOL(pNullDevice->GetRecordedCommands().IsEmpty());
+  }
+
+  pDevice->DestroyReadbackBuffer(hReadbackBuffer);
+  pDevice->DestroyBuffer(hVertexBuffer);
+
+  EZ_TEST_BOOL(pDevice->Shutdown().Succeeded());
+  EZ_DEFAULT_DELETE(pDevice);
+}
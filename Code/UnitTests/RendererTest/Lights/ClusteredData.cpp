@@ -0,0 +1,272 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <RendererCore/Lights/ClusteredDataExtractor.h>
+#include <RendererCore/Lights/Implementation/ClusteredDataUtils.h>
+
+namespace
+{
+  struct TestCluster
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_BitMask[1024 / 32];
+  };
+
+  struct ClusteredDataTestSetup
+  {
+    ClusteredDataTestSetup()
+    {
+      m_Camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovY, 60.0f, 0.1f, 1000.0f);
+      m_Camera.LookAt(ezVec3(0.0f, 0.0f, 2.0f), ezVec3(10.0f, 1.0f, 2.0f), ezVec3(0.0f, 0.0f, 1.0f));
+
+      m_ViewMatrix = ezSimdConversion::ToMat4(m_Camera.GetViewMatrix());
+
+      ezMat4 tmp;
+      m_Camera.GetProjectionMatrix(m_fAspectRatio, tmp);
+      m_ProjectionMatrix = ezSimdConversion::ToMat4(tmp);
+
+      m_ClusterBoundingSpheres.SetCountUninitialized(NUM_CLUSTERS);
+      m_ClusterBoundingSpheres4.SetCountUninitialized(NUM_CLUSTERS / 4);
+      m_Clusters.SetCountUninitialized(NUM_CLUSTERS);
+
+      FillClusterBoundingSpheres(m_Camera, m_fAspectRatio, m_ClusterBoundingSpheres);
+      TransposeClusterBoundingSpheres(m_ClusterBoundingSpheres, m_ClusterBoundingSpheres4);
+    }
+
+    ezSimdVec4f GetRandomPosition(ezRandom& ref_rng) const
+    {
+      return ezSimdVec4f(ref_rng.FloatMinMax(-5.0f, 300.0f), ref_rng.FloatMinMax(-150.0f, 150.0f), ref_rng.FloatMinMax(-50.0f, 50.0f), 0.0f);
+    }
+
+    void PrepareItems(ezUInt32 uiNumItems, bool bWithBoxes, ezUInt64 uiSeed)
+    {
+      ezRandom rng;
+      rng.Initialize(uiSeed);
+
+      const ezSimdMat4f viewProjectionMatrix = m_ProjectionMatrix * m_ViewMatrix;
+      const ezUInt32 uiNumShapes = bWithBoxes ? 3 : 2;
+
+      m_Items.Clear();
+      for (ezUInt32 i = 0; i < uiNumItems; ++i)
+      {
+        const ezSimdVec4f position = GetRandomPosition(rng);
+        const float fRange = rng.FloatMinMax(0.5f, 20.0f);
+
+        switch (i % uiNumShapes)
+        {
+          case 0:
+            PrepareSphere(ezSimdBSphere(position, fRange), i, m_ViewMatrix, m_ProjectionMatrix, m_Items.ExpandAndGetRef());
+            break;
+
+          case 1:
+          {
+            const ezAngle halfAngle = ezAngle::MakeFromDegree(rng.FloatMinMax(5.0f, 80.0f));
+            const ezVec3 vForward = ezVec3(rng.FloatMinMax(-1.0f, 1.0f), rng.FloatMinMax(-1.0f, 1.0f), rng.FloatMinMax(-1.0f, 1.0f)).GetNormalized();
+
+            BoundingCone cone;
+            cone.m_PositionAndRange = position;
+            cone.m_PositionAndRange.SetW(fRange);
+            cone.m_ForwardDir = ezSimdConversion::ToVec3(vForward);
+            cone.m_SinCosAngle = ezSimdVec4f(ezMath::Sin(halfAngle), ezMath::Cos(halfAngle), 0.0f);
+            PrepareSpotLight(cone, i, m_ViewMatrix, m_ProjectionMatrix, m_Items.ExpandAndGetRef());
+          }
+          break;
+
+          case 2:
+          {
+            ezTransform transform = ezTransform::MakeIdentity();
+            transform.m_vPosition = ezSimdConversion::ToVec3(position);
+            transform.m_qRotation = ezQuat::MakeFromAxisAndAngle(ezVec3(0, 0, 1), ezAngle::MakeFromDegree(rng.FloatMinMax(0.0f, 360.0f)));
+            transform.m_vScale = ezVec3(rng.FloatMinMax(0.5f, 10.0f), rng.FloatMinMax(0.5f, 10.0f), rng.FloatMinMax(0.5f, 10.0f));
+            PrepareBox(transform, i, viewProjectionMatrix, m_Items.ExpandAndGetRef());
+          }
+          break;
+        }
+      }
+    }
+
+    void BinSlices(ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+    {
+      for (ezUInt32 uiSliceIndex = uiStartIndex; uiSliceIndex < uiEndIndex; ++uiSliceIndex)
+      {
+        ezMemoryUtils::ZeroFill(m_Clusters.GetData() + GetClusterIndexFromCoord(0, 0, uiSliceIndex), NUM_CLUSTERS_XY);
+        BinItemsForSlice(m_Items.GetArrayPtr(), uiSliceIndex, m_ClusterBoundingSpheres4.GetData(), m_Clusters.GetData());
+      }
+    }
+
+    /// Straight forward scalar version of the cluster tests. Returns a positive value for overlap and a negative value otherwise.
+    float ComputeReferenceOverlap(const ezClusterBinningItem& item, const ezSimdBSphere& clusterSphere) const
+    {
+      switch (item.m_Shape)
+      {
+        case ezClusterBinningItem::Shape::Sphere:
+        {
+          const float fRadii = clusterSphere.GetRadius() + item.m_CenterAndRadius.w();
+          const float fDistSq = (clusterSphere.GetCenter() - item.m_CenterAndRadius).GetLengthSquared<3>();
+          return fRadii * fRadii - fDistSq;
+        }
+
+        case ezClusterBinningItem::Shape::Cone:
+        {
+          const float fClusterRadius = clusterSphere.GetRadius();
+          const float fRange = item.m_CenterAndRadius.w();
+          const ezSimdVec4f toConePos = clusterSphere.GetCenter() - item.m_CenterAndRadius;
+          const float fProjected = item.m_ForwardDir.Dot<3>(toConePos);
+          const float fDistToConeSq = toConePos.Dot<3>(toConePos);
+          const float fDistClosestP = (float)item.m_SinCosAngle.y() * ezMath::Sqrt(ezMath::Max(fDistToConeSq - fProjected * fProjected, 0.0f)) - fProjected * (float)item.m_SinCosAngle.x();
+
+          return ezMath::Min(fClusterRadius - fDistClosestP, fClusterRadius + fRange - fProjected, fProjected + fClusterRadius);
+        }
+
+        case ezClusterBinningItem::Shape::Box:
+        {
+          ezSimdBSphere sphere = clusterSphere;
+          sphere.Transform(item.m_WorldToBox);
+
+          const ezSimdBBox box = ezSimdBBox(ezSimdVec4f(-1.0f), ezSimdVec4f(1.0f));
+          const float fRadius = sphere.GetRadius();
+          return fRadius * fRadius - (box.GetClampedPoint(sphere.GetCenter()) - sphere.GetCenter()).GetLengthSquared<3>();
+        }
+
+        default:
+          return 1.0f;
+      }
+    }
+
+    ezCamera m_Camera;
+    float m_fAspectRatio = 16.0f / 9.0f;
+    ezSimdMat4f m_ViewMatrix;
+    ezSimdMat4f m_ProjectionMatrix;
+
+    ezDynamicArray<ezSimdBSphere, ezAlignedAllocatorWrapper> m_ClusterBoundingSpheres;
+    ezDynamicArray<ezClusterBoundingSpheres4, ezAlignedAllocatorWrapper> m_ClusterBoundingSpheres4;
+    ezDynamicArray<ezClusterBinningItem, ezAlignedAllocatorWrapper> m_Items;
+    ezDynamicArray<TestCluster> m_Clusters;
+  };
+} // namespace
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Lights);
+
+EZ_CREATE_SIMPLE_TEST(Lights, ClusteredDataBinning)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Transpose Cluster Bounding Spheres")
+  {
+    ClusteredDataTestSetup setup;
+
+    for (ezUInt32 i = 0; i < NUM_CLUSTERS; ++i)
+    {
+      const ezClusterBoundingSpheres4& spheres4 = setup.m_ClusterBoundingSpheres4[i / 4];
+      const ezSimdBSphere& sphere = setup.m_ClusterBoundingSpheres[i];
+
+      EZ_TEST_BOOL(spheres4.m_CenterX.GetComponent(i % 4) == sphere.m_CenterAndRadius.x());
+      EZ_TEST_BOOL(spheres4.m_CenterY.GetComponent(i % 4) == sphere.m_CenterAndRadius.y());
+      EZ_TEST_BOOL(spheres4.m_CenterZ.GetComponent(i % 4) == sphere.m_CenterAndRadius.z());
+      EZ_TEST_BOOL(spheres4.m_Radius.GetComponent(i % 4) == sphere.m_CenterAndRadius.w());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Bin Spheres, Cones and Boxes")
+  {
+    ClusteredDataTestSetup setup;
+    setup.PrepareItems(ezClusteredDataCPU::MAX_LIGHT_DATA, true, 42);
+
+    ezDynamicArray<ezClusterBinningItem, ezAlignedAllocatorWrapper>& items = setup.m_Items;
+
+    // one light that covers everything
+    PrepareDirLight(items.GetCount() - 1, items.PeekBack());
+
+    setup.BinSlices(0, NUM_CLUSTERS_Z);
+
+    ezUInt32 uiNumErrors = 0;
+    ezUInt32 uiNumHits = 0;
+
+    for (ezUInt32 z = 0; z < NUM_CLUSTERS_Z; ++z)
+    {
+      for (ezUInt32 y = 0; y < NUM_CLUSTERS_Y; ++y)
+      {
+        for (ezUInt32 x = 0; x < NUM_CLUSTERS_X; ++x)
+        {
+          const ezUInt32 uiClusterIndex = GetClusterIndexFromCoord(x, y, z);
+          const TestCluster& cluster = setup.m_Clusters[uiClusterIndex];
+
+          for (const ezClusterBinningItem& item : items)
+          {
+            const bool bIsSet = (cluster.m_BitMask[item.m_uiIndex / 32] & (1u << (item.m_uiIndex % 32))) != 0;
+            uiNumHits += bIsSet ? 1 : 0;
+
+            const bool bInRange = x >= item.m_uiMinX && x <= item.m_uiMaxX && y >= item.m_uiMinY && y <= item.m_uiMaxY && z >= item.m_uiMinZ && z <= item.m_uiMaxZ;
+            if (!bInRange)
+            {
+              uiNumErrors += bIsSet ? 1 : 0;
+              continue;
+            }
+
+            const float fOverlap = setup.ComputeReferenceOverlap(item, setup.m_ClusterBoundingSpheres[uiClusterIndex]);
+
+            // the SIMD version computes the same values in a different order, ignore the cases that are too close to call
+            if (ezMath::Abs(fOverlap) < 0.01f)
+              continue;
+
+            uiNumErrors += (bIsSet != (fOverlap > 0.0f)) ? 1 : 0;
+          }
+        }
+      }
+    }
+
+    EZ_TEST_INT(uiNumErrors, 0);
+    EZ_TEST_BOOL(uiNumHits >= NUM_CLUSTERS);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Serial and parallel binning")
+  {
+    ClusteredDataTestSetup setup;
+    setup.PrepareItems(ezClusteredDataCPU::MAX_LIGHT_DATA, true, 7);
+
+    setup.BinSlices(0, NUM_CLUSTERS_Z);
+    ezDynamicArray<TestCluster> serialClusters = setup.m_Clusters;
+
+    ezMemoryUtils::PatternFill(setup.m_Clusters.GetData(), 0xCD, NUM_CLUSTERS);
+    ezTaskSystem::ParallelForIndexed(0u, NUM_CLUSTERS_Z, [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      { setup.BinSlices(uiStartIndex, uiEndIndex); });
+
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(serialClusters.GetData(), setup.m_Clusters.GetData(), NUM_CLUSTERS));
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Binning 1000 lights")
+  {
+    constexpr ezUInt32 uiNumLights = 1000;
+    constexpr ezUInt32 uiNumIterations = 100;
+
+    ClusteredDataTestSetup setup;
+
+    ezTime tPrepare;
+    ezTime tSerial;
+    ezTime tParallel;
+
+    for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+    {
+      ezTime t0 = ezTime::Now();
+      setup.PrepareItems(uiNumLights, false, i);
+      ezTime t1 = ezTime::Now();
+      setup.BinSlices(0, NUM_CLUSTERS_Z);
+      ezTime t2 = ezTime::Now();
+      ezTaskSystem::ParallelForIndexed(0u, NUM_CLUSTERS_Z, [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+        { setup.BinSlices(uiStartIndex, uiEndIndex); });
+      ezTime t3 = ezTime::Now();
+
+      tPrepare += t1 - t0;
+      tSerial += t2 - t1;
+      tParallel += t3 - t2;
+    }
+
+    const double fScale = 1000.0 / uiNumLights / uiNumIterations;
+    ezLog::Info("[test]Clustered light binning, prepare: {0} us per 1000 lights", ezArgF(tPrepare.GetMicroseconds() * fScale, 2));
+    ezLog::Info("[test]Clustered light binning, serial: {0} us per 1000 lights", ezArgF(tSerial.GetMicroseconds() * fScale, 2));
+    ezLog::Info("[test]Clustered light binning, parallel: {0} us per 1000 lights", ezArgF(tParallel.GetMicroseconds() * fScale, 2));
+  }
+}
@@ -0,0 +1,174 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <RendererCore/Pipeline/ExtractedRenderData.h>
+
+namespace
+{
+  ezUInt64 SortByTestKey(const ezRenderData* pRenderData, const ezCamera& camera)
+  {
+    // spread the keys over several bytes, so that the radix sort can't skip all but one digit
+    return (ezUInt64(pRenderData->m_uiSortingKey) * 0x0101010101ull) << 8;
+  }
+
+  static ezRenderData::Category s_LargeTestCategory = ezRenderData::RegisterCategory("SortingTestLarge", &SortByTestKey);
+  static ezRenderData::Category s_SmallTestCategory = ezRenderData::RegisterCategory("SortingTestSmall", &SortByTestKey);
+
+  ezUInt64 GetKey(const ezRenderData* pRenderData)
+  {
+    return SortByTestKey(pRenderData, ezCamera());
+  }
+
+  struct ReferenceComparer
+  {
+    // the comparison that was used before the radix sort
+    EZ_ALWAYS_INLINE bool Less(const ezRenderData* a, const ezRenderData* b) const
+    {
+      const ezUInt64 uiKeyA = GetKey(a);
+      const ezUInt64 uiKeyB = GetKey(b);
+
+      if (uiKeyA == uiKeyB)
+        return a->m_uiBatchId < b->m_uiBatchId;
+
+      return uiKeyA < uiKeyB;
+    }
+  };
+
+  void SortAndGetOrder(const ezDynamicArray<ezRenderData>& renderData, ezRenderData::Category category, ezDynamicArray<const ezRenderData*>& out_order, ezUInt32& out_uiNumBatches)
+  {
+    ezExtractedRenderData extractedData;
+    for (const ezRenderData& data : renderData)
+    {
+      extractedData.AddRenderData(&data, category);
+    }
+
+    extractedData.SortAndBatch();
+
+    out_order.Clear();
+
+    ezRenderDataBatchList batchList = extractedData.GetRenderDataBatchesWithCategory(category);
+    out_uiNumBatches = batchList.GetBatchCount();
+
+    for (ezUInt32 i = 0; i < batchList.GetBatchCount(); ++i)
+    {
+      const ezRenderDataBatch batch = batchList.GetBatch(i);
+      for (auto it = batch.GetIterator<ezRenderData>(); it.IsValid(); ++it)
+      {
+        out_order.PushBack(it);
+      }
+    }
+  }
+
+  void TestSortOrder(ezUInt32 uiCount, ezRenderData::Category category)
+  {
+    ezRandom rng;
+    rng.Initialize(uiCount);
+
+    // few distinct keys and batch ids, so there are long runs of equal keys and render data that is equal in both
+    ezDynamicArray<ezRenderData> renderData;
+    renderData.SetCount(uiCount);
+    for (ezRenderData& data : renderData)
+    {
+      data.m_uiSortingKey = rng.UIntInRange(64);
+      data.m_uiBatchId = rng.UIntInRange(8);
+    }
+
+    ezDynamicArray<const ezRenderData*> expectedOrder;
+    for (const ezRenderData& data : renderData)
+    {
+      expectedOrder.PushBack(&data);
+    }
+    expectedOrder.Sort(ReferenceComparer());
+
+    ezUInt32 uiExpectedNumBatches = 1;
+    for (ezUInt32 i = 1; i < uiCount; ++i)
+    {
+      if (expectedOrder[i]->m_uiBatchId != expectedOrder[i - 1]->m_uiBatchId)
+        ++uiExpectedNumBatches;
+    }
+
+    ezDynamicArray<const ezRenderData*> order;
+    ezUInt32 uiNumBatches = 0;
+    SortAndGetOrder(renderData, category, order, uiNumBatches);
+
+    EZ_TEST_INT(order.GetCount(), uiCount);
+    EZ_TEST_INT(uiNumBatches, uiExpectedNumBatches);
+
+    // render data that is equal in key and batch id may be in any order, but everything else has to match the comparison sort
+    for (ezUInt32 i = 0; i < ezMath::Min(order.GetCount(), uiCount); ++i)
+    {
+      if (GetKey(order[i]) != GetKey(expectedOrder[i]) || order[i]->m_uiBatchId != expectedOrder[i]->m_uiBatchId)
+      {
+        EZ_TEST_FAILURE("Wrong sort order", "Render data at index {} differs from the comparison sort", i);
+        break;
+      }
+    }
+
+    // the same input has to result in the exact same order
+    ezDynamicArray<const ezRenderData*> order2;
+    SortAndGetOrder(renderData, category, order2, uiNumBatches);
+
+    EZ_TEST_BOOL(order == order2);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Pipeline);
+
+EZ_CREATE_SIMPLE_TEST(Pipeline, SortAndBatch)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Comparison Sort")
+  {
+    TestSortOrder(100, s_SmallTestCategory);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Radix Sort")
+  {
+    TestSortOrder(3000, s_LargeTestCategory);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parallel Categories")
+  {
+    ezRandom rng;
+    rng.Initialize(42);
+
+    ezDynamicArray<ezRenderData> renderData;
+    renderData.SetCount(2000);
+    for (ezRenderData& data : renderData)
+    {
+      data.m_uiSortingKey = rng.UIntInRange(1000);
+      data.m_uiBatchId = rng.UIntInRange(4);
+    }
+
+    ezExtractedRenderData extractedData;
+    for (ezUInt32 i = 0; i < renderData.GetCount(); ++i)
+    {
+      extractedData.AddRenderData(&renderData[i], (i % 2 == 0) ? s_LargeTestCategory : s_SmallTestCategory);
+    }
+
+    extractedData.SortAndBatch();
+
+    for (ezRenderData::Category category : {s_LargeTestCategory, s_SmallTestCategory})
+    {
+      ezRenderDataBatchList batchList = extractedData.GetRenderDataBatchesWithCategory(category);
+
+      ezUInt32 uiCount = 0;
+      const ezRenderData* pPrevious = nullptr;
+      for (ezUInt32 i = 0; i < batchList.GetBatchCount(); ++i)
+      {
+        const ezRenderDataBatch batch = batchList.GetBatch(i);
+        for (auto it = batch.GetIterator<ezRenderData>(); it.IsValid(); ++it)
+        {
+          if (pPrevious != nullptr)
+          {
+            EZ_TEST_BOOL(!ReferenceComparer().Less(it, pPrevious));
+          }
+
+          pPrevious = it;
+          ++uiCount;
+        }
+      }
+
+      EZ_TEST_INT(uiCount, 1000);
+    }
+  }
+}
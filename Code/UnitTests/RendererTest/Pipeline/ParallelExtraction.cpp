@@ -0,0 +1,179 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Core/Graphics/Camera.h>
+#include <Core/ResourceManager/ResourceManager.h>
+#include <Core/World/World.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Memory/FrameAllocator.h>
+#include <RendererCore/Components/SpriteComponent.h>
+#include <RendererCore/Lights/PointLightComponent.h>
+#include <RendererCore/Pipeline/ExtractedRenderData.h>
+#include <RendererCore/Pipeline/Extractor.h>
+#include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+#include <RendererCore/Textures/Texture2DResource.h>
+#include <RendererFoundation/Device/Device.h>
+#include <RendererFoundation/Device/DeviceFactory.h>
+
+namespace
+{
+  struct ExtractedEntry
+  {
+    ezRenderData::Category m_Category;
+    const ezRTTI* m_pType = nullptr;
+    ezGameObjectHandle m_hOwner;
+    ezTransform m_GlobalTransform;
+    ezUInt32 m_uiSortingKey = 0;
+  };
+
+  void ExtractScene(const ezView& view, const ezDynamicArray<const ezGameObject*>& objects, ezDynamicArray<ExtractedEntry>& out_entries)
+  {
+    ezVisibleObjectsExtractor extractor;
+    ezExtractedRenderData extractedData;
+    extractedData.SetCamera(*view.GetCamera());
+    extractor.Extract(view, objects, extractedData);
+    extractedData.SortAndBatch();
+
+    out_entries.Clear();
+
+    for (ezRenderData::Category category : {ezDefaultRenderDataCategories::Light, ezDefaultRenderDataCategories::LitOpaque, ezDefaultRenderDataCategories::LitMasked, ezDefaultRenderDataCategories::LitTransparent})
+    {
+      ezRenderDataBatchList batchList = extractedData.GetRenderDataBatchesWithCategory(category);
+      for (ezUInt32 i = 0; i < batchList.GetBatchCount(); ++i)
+      {
+        const ezRenderDataBatch batch = batchList.GetBatch(i);
+        for (auto it = batch.GetIterator<ezRenderData>(); it.IsValid(); ++it)
+        {
+          const ezRenderData* pRenderData = it;
+
+          auto& entry = out_entries.ExpandAndGetRef();
+          entry.m_Category = category;
+          entry.m_pType = pRenderData->GetDynamicRTTI();
+          entry.m_hOwner = pRenderData->m_hOwner;
+          entry.m_GlobalTransform = pRenderData->m_GlobalTransform;
+          entry.m_uiSortingKey = pRenderData->m_uiSortingKey;
+        }
+      }
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Pipeline, ParallelExtraction)
+{
+  ezStartup::StartupCoreSystems();
+  EZ_SCOPE_EXIT(ezStartup::ShutdownCoreSystems());
+
+  ezGALDeviceCreationDescription deviceDesc;
+  ezGALDevice* pDevice = ezGALDeviceFactory::CreateDevice("Null", ezFoundation::GetDefaultAllocator(), deviceDesc);
+  if (!EZ_TEST_BOOL(pDevice != nullptr))
+    return;
+
+  EZ_SCOPE_EXIT(pDevice->Shutdown().IgnoreResult(); EZ_DEFAULT_DELETE(pDevice););
+
+  if (!EZ_TEST_BOOL(pDevice->Init().Succeeded()))
+    return;
+
+  ezGALDevice::SetDefaultDevice(pDevice);
+
+  ezStartup::StartupHighLevelSystems();
+  EZ_SCOPE_EXIT(ezStartup::ShutdownHighLevelSystems());
+
+  // the extracted render data is allocated with the frame allocator and the render data to cache is only freed at the end of the frame
+  EZ_SCOPE_EXIT(ezRenderWorld::BeginFrame(); ezRenderWorld::EndFrame(); ezFrameAllocator::Reset(););
+
+  // the parallel extraction can only be switched off in development builds
+  ezCVarBool* pParallel = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("Spatial.Extraction.Parallel"));
+  if (pParallel == nullptr)
+    return;
+
+  const bool bPrevParallel = *pParallel;
+  EZ_SCOPE_EXIT(*pParallel = bPrevParallel);
+
+  // enough objects for several extraction tasks
+  constexpr ezUInt32 uiNumObjects = 1000;
+
+  ezWorldDesc worldDesc("ParallelExtractionTest");
+  ezWorld world(worldDesc);
+
+  ezDynamicArray<const ezGameObject*> objects;
+
+  {
+    EZ_LOCK(world.GetWriteMarker());
+
+    // the texture is never loaded, sprites only need a valid handle to extract render data
+    ezTexture2DResourceHandle hTexture = ezResourceManager::LoadResource<ezTexture2DResource>("ParallelExtractionTest.ezTexture2D");
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      ezGameObjectDesc desc;
+      desc.m_bDynamic = (i % 2) == 0;
+      desc.m_LocalPosition = ezVec3((i % 40) * 2.0f, 10.0f + (i / 40) * 2.0f, 0);
+
+      ezGameObject* pObject = nullptr;
+      world.CreateObject(desc, pObject);
+
+      // sprites are not thread-safe and are extracted serially in between the point lights
+      if (i % 5 == 0)
+      {
+        ezSpriteComponent* pSprite = nullptr;
+        ezSpriteComponent::CreateComponent(pObject, pSprite);
+        pSprite->SetTexture(hTexture);
+      }
+      else
+      {
+        ezPointLightComponent* pLight = nullptr;
+        ezPointLightComponent::CreateComponent(pObject, pLight);
+      }
+
+      objects.PushBack(pObject);
+    }
+
+    world.Update();
+  }
+
+  ezCamera camera;
+  camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovY, 90.0f, 0.1f, 1000.0f);
+  camera.LookAt(ezVec3(40, -20, 0), ezVec3(40, 0, 0), ezVec3(0, 0, 1));
+
+  ezView* pView = nullptr;
+  const ezViewHandle hView = ezRenderWorld::CreateView("ParallelExtractionTest", pView);
+  EZ_SCOPE_EXIT(ezRenderWorld::DeleteView(hView));
+
+  pView->SetWorld(&world);
+  pView->SetCamera(&camera);
+  pView->SetCameraUsageHint(ezCameraUsageHint::MainView);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Same result as serial extraction")
+  {
+    ezDynamicArray<ExtractedEntry> serialEntries;
+    ezDynamicArray<ExtractedEntry> parallelEntries;
+
+    *pParallel = false;
+    ExtractScene(*pView, objects, serialEntries);
+
+    *pParallel = true;
+    ExtractScene(*pView, objects, parallelEntries);
+
+    EZ_TEST_INT(serialEntries.GetCount(), uiNumObjects);
+
+    if (EZ_TEST_INT(parallelEntries.GetCount(), serialEntries.GetCount()))
+    {
+      for (ezUInt32 i = 0; i < serialEntries.GetCount(); ++i)
+      {
+        const ExtractedEntry& s = serialEntries[i];
+        const ExtractedEntry& p = parallelEntries[i];
+
+        EZ_TEST_BOOL(p.m_Category == s.m_Category);
+        EZ_TEST_BOOL(p.m_pType == s.m_pType);
+        EZ_TEST_BOOL(p.m_hOwner == s.m_hOwner);
+        EZ_TEST_BOOL(p.m_GlobalTransform.IsIdentical(s.m_GlobalTransform));
+        EZ_TEST_INT(p.m_uiSortingKey, s.m_uiSortingKey);
+      }
+    }
+
+    // adds the render data of the static objects to the caches, while the world still exists to delete them again
+    ezRenderWorld::BeginFrame();
+    ezRenderWorld::EndFrame();
+  }
+}
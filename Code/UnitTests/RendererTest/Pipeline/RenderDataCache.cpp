@@ -0,0 +1,219 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Core/ResourceManager/ResourceManager.h>
+#include <Core/World/World.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Memory/FrameAllocator.h>
+#include <RendererCore/Components/SpriteComponent.h>
+#include <RendererCore/Pipeline/ExtractedRenderData.h>
+#include <RendererCore/Pipeline/Extractor.h>
+#include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+#include <RendererCore/Textures/Texture2DResource.h>
+#include <RendererFoundation/Device/Device.h>
+#include <RendererFoundation/Device/DeviceFactory.h>
+
+namespace
+{
+  ezUInt32 ExtractSprites(const ezView& view, const ezDynamicArray<const ezGameObject*>& objects, ezDynamicArray<const ezRenderData*>& out_renderData)
+  {
+    ezVisibleObjectsExtractor extractor;
+    ezExtractedRenderData extractedData;
+    extractor.Extract(view, objects, extractedData);
+    extractedData.SortAndBatch();
+
+    out_renderData.Clear();
+
+    for (ezRenderData::Category category : {ezDefaultRenderDataCategories::LitMasked, ezDefaultRenderDataCategories::LitTransparent})
+    {
+      ezRenderDataBatchList batchList = extractedData.GetRenderDataBatchesWithCategory(category);
+      for (ezUInt32 i = 0; i < batchList.GetBatchCount(); ++i)
+      {
+        const ezRenderDataBatch batch = batchList.GetBatch(i);
+        for (auto it = batch.GetIterator<ezRenderData>(); it.IsValid(); ++it)
+        {
+          out_renderData.PushBack(it);
+        }
+      }
+    }
+
+    return out_renderData.GetCount();
+  }
+
+  void CreateSprites(ezWorld& ref_world, ezUInt32 uiNumObjects, ezDynamicArray<const ezGameObject*>& out_objects)
+  {
+    EZ_LOCK(ref_world.GetWriteMarker());
+
+    // the texture is never loaded, sprites only need a valid handle to extract render data
+    ezTexture2DResourceHandle hTexture = ezResourceManager::LoadResource<ezTexture2DResource>("RenderDataCacheTest.ezTexture2D");
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      ezGameObjectDesc desc;
+      desc.m_bDynamic = false;
+      desc.m_LocalPosition = ezVec3(i * 2.0f, 0, 0);
+
+      ezGameObject* pObject = nullptr;
+      ref_world.CreateObject(desc, pObject);
+
+      ezSpriteComponent* pSprite = nullptr;
+      ezSpriteComponent::CreateComponent(pObject, pSprite);
+      pSprite->SetTexture(hTexture);
+
+      out_objects.PushBack(pObject);
+    }
+
+    ref_world.Update();
+  }
+
+  void AdvanceFrame()
+  {
+    // the render data that was extracted for caching is only added to the caches at the end of the frame
+    ezRenderWorld::BeginFrame();
+    ezRenderWorld::EndFrame();
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Pipeline, RenderDataCache)
+{
+  ezStartup::StartupCoreSystems();
+  EZ_SCOPE_EXIT(ezStartup::ShutdownCoreSystems());
+
+  ezGALDeviceCreationDescription deviceDesc;
+  ezGALDevice* pDevice = ezGALDeviceFactory::CreateDevice("Null", ezFoundation::GetDefaultAllocator(), deviceDesc);
+  if (!EZ_TEST_BOOL(pDevice != nullptr))
+    return;
+
+  EZ_SCOPE_EXIT(pDevice->Shutdown().IgnoreResult(); EZ_DEFAULT_DELETE(pDevice););
+
+  if (!EZ_TEST_BOOL(pDevice->Init().Succeeded()))
+    return;
+
+  ezGALDevice::SetDefaultDevice(pDevice);
+
+  ezStartup::StartupHighLevelSystems();
+  EZ_SCOPE_EXIT(ezStartup::ShutdownHighLevelSystems());
+
+  // the cached render data of the deleted objects is only freed at the end of the frame and the extracted render data with the frame allocator
+  EZ_SCOPE_EXIT(AdvanceFrame(); ezFrameAllocator::Reset(););
+
+  constexpr ezUInt32 uiNumObjects = 4;
+
+  ezWorldDesc worldDesc("RenderDataCacheTest");
+  ezWorld world(worldDesc);
+
+  ezDynamicArray<const ezGameObject*> objects;
+  CreateSprites(world, uiNumObjects, objects);
+
+  // editors have several views with the same usage hint, they share their cache, while shadow views need their own
+  ezView* pEditorView1 = nullptr;
+  ezView* pEditorView2 = nullptr;
+  ezView* pShadowView = nullptr;
+  const ezViewHandle hEditorView1 = ezRenderWorld::CreateView("RenderDataCacheTest.Editor1", pEditorView1);
+  const ezViewHandle hEditorView2 = ezRenderWorld::CreateView("RenderDataCacheTest.Editor2", pEditorView2);
+  const ezViewHandle hShadowView = ezRenderWorld::CreateView("RenderDataCacheTest.Shadow", pShadowView);
+
+  EZ_SCOPE_EXIT(ezRenderWorld::DeleteView(hEditorView1); ezRenderWorld::DeleteView(hEditorView2); ezRenderWorld::DeleteView(hShadowView););
+
+  for (ezView* pView : {pEditorView1, pEditorView2, pShadowView})
+  {
+    pView->SetWorld(&world);
+    pView->SetCameraUsageHint(pView == pShadowView ? ezCameraUsageHint::Shadow : ezCameraUsageHint::EditorView);
+  }
+
+  ezDynamicArray<const ezRenderData*> editorRenderData;
+  ezDynamicArray<const ezRenderData*> shadowRenderData;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Extract before caching")
+  {
+    // sprites don't extract anything for shadow views
+    EZ_TEST_INT(ExtractSprites(*pEditorView1, objects, editorRenderData), uiNumObjects);
+    EZ_TEST_INT(ExtractSprites(*pShadowView, objects, shadowRenderData), 0);
+
+    AdvanceFrame();
+
+    for (const ezGameObject* pObject : objects)
+    {
+      EZ_TEST_INT(ezRenderWorld::GetCachedRenderData(*pEditorView1, pObject->GetHandle(), pObject->GetComponentVersion()).GetCount(), 1);
+      EZ_TEST_INT(ezRenderWorld::GetCachedRenderData(*pEditorView2, pObject->GetHandle(), pObject->GetComponentVersion()).GetCount(), 1);
+      EZ_TEST_BOOL(ezRenderWorld::GetCachedRenderData(*pShadowView, pObject->GetHandle(), pObject->GetComponentVersion()).IsEmpty());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Extract from cache")
+  {
+    // the render data that was cached for the editor view must not show up in the shadow view
+    EZ_TEST_INT(ExtractSprites(*pShadowView, objects, shadowRenderData), 0);
+
+    // the second editor view uses the render data that was cached for the first one
+    EZ_TEST_INT(ExtractSprites(*pEditorView2, objects, editorRenderData), uiNumObjects);
+
+    for (const ezGameObject* pObject : objects)
+    {
+      auto cachedRenderData = ezRenderWorld::GetCachedRenderData(*pEditorView2, pObject->GetHandle(), pObject->GetComponentVersion());
+      if (EZ_TEST_INT(cachedRenderData.GetCount(), 1))
+      {
+        EZ_TEST_BOOL(editorRenderData.Contains(cachedRenderData[0].m_pRenderData));
+      }
+    }
+
+    AdvanceFrame();
+
+    EZ_TEST_INT(ExtractSprites(*pShadowView, objects, shadowRenderData), 0);
+    EZ_TEST_INT(ExtractSprites(*pEditorView1, objects, editorRenderData), uiNumObjects);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Delete cached render data")
+  {
+    for (const ezGameObject* pObject : objects)
+    {
+      ezRenderWorld::DeleteCachedRenderDataForObject(pObject);
+
+      EZ_TEST_BOOL(ezRenderWorld::GetCachedRenderData(*pEditorView1, pObject->GetHandle(), pObject->GetComponentVersion()).IsEmpty());
+    }
+
+    AdvanceFrame();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Recreate world")
+  {
+    ezDynamicArray<const ezGameObject*> oldObjects;
+    ezUniquePtr<ezWorld> pOldWorld = EZ_DEFAULT_NEW(ezWorld, worldDesc);
+    CreateSprites(*pOldWorld, uiNumObjects, oldObjects);
+
+    const ezUInt32 uiOldWorldIndex = pOldWorld->GetIndex();
+
+    ezHybridArray<ezGameObjectHandle, uiNumObjects> oldHandles;
+    for (const ezGameObject* pObject : oldObjects)
+    {
+      oldHandles.PushBack(pObject->GetHandle());
+    }
+
+    // the extracted render data is only added to the cache at the end of the frame, after the world has already been deleted
+    pEditorView1->SetWorld(pOldWorld.Borrow());
+    EZ_TEST_INT(ExtractSprites(*pEditorView1, oldObjects, editorRenderData), uiNumObjects);
+
+    pEditorView1->SetWorld(nullptr);
+    pOldWorld.Clear();
+
+    // the new world gets the index of the deleted one and its objects get the same handles, but they must not see its render data
+    ezWorld newWorld(worldDesc);
+    EZ_TEST_INT(newWorld.GetIndex(), uiOldWorldIndex);
+
+    ezDynamicArray<const ezGameObject*> newObjects;
+    CreateSprites(newWorld, uiNumObjects, newObjects);
+
+    pEditorView1->SetWorld(&newWorld);
+
+    AdvanceFrame();
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      const ezGameObject* pObject = newObjects[i];
+      EZ_TEST_BOOL(pObject->GetHandle() == oldHandles[i]);
+      EZ_TEST_BOOL(ezRenderWorld::GetCachedRenderData(*pEditorView1, pObject->GetHandle(), pObject->GetComponentVersion()).IsEmpty());
+    }
+
+    pEditorView1->SetWorld(&world);
+  }
+}
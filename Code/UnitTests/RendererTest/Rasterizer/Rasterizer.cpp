@@ -0,0 +1,161 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Core/Graphics/Camera.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/SimdMath/SimdBBox.h>
+#include <RendererCore/Rasterizer/RasterizerObject.h>
+#include <RendererCore/Rasterizer/RasterizerView.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiResolutionX = 256;
+  constexpr ezUInt32 s_uiResolutionY = 128;
+
+  ezSimdBBox GetBox(const ezVec3& vCenter, float fHalfExtent)
+  {
+    return ezSimdBBox(ezSimdVec4f(vCenter.x - fHalfExtent, vCenter.y - fHalfExtent, vCenter.z - fHalfExtent), ezSimdVec4f(vCenter.x + fHalfExtent, vCenter.y + fHalfExtent, vCenter.z + fHalfExtent));
+  }
+
+  /// A fixed scene of walls of different sizes, scattered in front of the camera.
+  struct RasterizerTestScene
+  {
+    void Create(ezUInt32 uiNumOccluders, ezUInt64 uiSeed)
+    {
+      ezRandom rng;
+      rng.Initialize(uiSeed);
+
+      m_Occluders.Clear();
+      for (ezUInt32 i = 0; i < uiNumOccluders; ++i)
+      {
+        const ezVec3 vExtents(rng.FloatMinMax(0.5f, 2.0f), rng.FloatMinMax(2.0f, 20.0f), rng.FloatMinMax(2.0f, 10.0f));
+
+        auto& occluder = m_Occluders.ExpandAndGetRef();
+        occluder.m_pObject = ezRasterizerObject::CreateBox(vExtents);
+        occluder.m_Transform = ezTransform(ezVec3(rng.FloatMinMax(10.0f, 100.0f), rng.FloatMinMax(-50.0f, 50.0f), rng.FloatMinMax(-10.0f, 10.0f)));
+      }
+    }
+
+    void AddToView(ezRasterizerView& ref_view) const
+    {
+      for (const auto& occluder : m_Occluders)
+      {
+        ref_view.AddObject(occluder.m_pObject.Borrow(), occluder.m_Transform);
+      }
+    }
+
+    struct OccluderInstance
+    {
+      ezSharedPtr<const ezRasterizerObject> m_pObject;
+      ezTransform m_Transform;
+    };
+
+    ezDynamicArray<OccluderInstance> m_Occluders;
+  };
+
+  void SetupCamera(ezCamera& ref_camera, float fAngle)
+  {
+    const ezVec3 vTarget(ezMath::Cos(ezAngle::MakeFromDegree(fAngle)), ezMath::Sin(ezAngle::MakeFromDegree(fAngle)), 0.0f);
+
+    ref_camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovY, 60.0f, 0.1f, 1000.0f);
+    ref_camera.LookAt(ezVec3::MakeZero(), vTarget, ezVec3(0.0f, 0.0f, 1.0f));
+  }
+} // namespace
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Rasterizer);
+
+EZ_CREATE_SIMPLE_TEST(Rasterizer, RasterizerView)
+{
+  // the rasterizer requires AVX2, there is nothing to test on platforms and CPUs without it
+  if (!ezRasterizerView::IsAvailable())
+    return;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Occlusion")
+  {
+    ezCamera camera;
+    SetupCamera(camera, 0.0f);
+
+    ezSharedPtr<const ezRasterizerObject> pWall = ezRasterizerObject::CreateBox(ezVec3(1.0f, 8.0f, 8.0f));
+
+    ezRasterizerView view;
+    view.SetResolution(s_uiResolutionX, s_uiResolutionY, 0.0f);
+    view.SetCamera(&camera);
+
+    view.BeginScene();
+    view.AddObject(pWall.Borrow(), ezTransform(ezVec3(10.0f, 0.0f, 0.0f)));
+    view.EndScene();
+
+    EZ_TEST_BOOL(view.HasRasterizedAnyOccluders());
+
+    // behind the wall
+    EZ_TEST_BOOL(!view.IsVisible(GetBox(ezVec3(30.0f, 0.0f, 0.0f), 2.0f)));
+    EZ_TEST_BOOL(!view.IsVisible(GetBox(ezVec3(50.0f, 10.0f, -5.0f), 2.0f)));
+
+    // in front of the wall
+    EZ_TEST_BOOL(view.IsVisible(GetBox(ezVec3(5.0f, 0.0f, 0.0f), 1.0f)));
+
+    // behind the wall, but next to it
+    EZ_TEST_BOOL(view.IsVisible(GetBox(ezVec3(30.0f, 20.0f, 0.0f), 2.0f)));
+
+    // partially behind the wall
+    EZ_TEST_BOOL(view.IsVisible(GetBox(ezVec3(30.0f, 12.0f, 0.0f), 5.0f)));
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Rasterize 64 occluders")
+  {
+    constexpr ezUInt32 uiNumOccluders = 64;
+    constexpr ezUInt32 uiNumQueries = 10000;
+    constexpr ezUInt32 uiNumIterations = 100;
+
+    RasterizerTestScene scene;
+    scene.Create(uiNumOccluders, 23);
+
+    ezRandom rng;
+    rng.Initialize(42);
+
+    // the rasterizer does no frustum culling, so only query boxes that are inside the view frustum
+    ezDynamicArray<ezSimdBBox, ezAlignedAllocatorWrapper> queries;
+    for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+    {
+      const float fDistance = rng.FloatMinMax(20.0f, 200.0f);
+      queries.PushBack(GetBox(ezVec3(fDistance, fDistance * rng.FloatMinMax(-0.9f, 0.9f), fDistance * rng.FloatMinMax(-0.4f, 0.4f)), rng.FloatMinMax(0.5f, 2.0f)));
+    }
+
+    ezCamera camera;
+    SetupCamera(camera, 0.0f);
+
+    ezRasterizerView view;
+    view.SetResolution(s_uiResolutionX, s_uiResolutionY, 0.0f);
+    view.SetCamera(&camera);
+
+    ezTime tRasterize;
+    ezTime tQuery;
+    ezUInt32 uiNumCulled = 0;
+
+    for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+    {
+      ezTime t0 = ezTime::Now();
+
+      view.BeginScene();
+      scene.AddToView(view);
+      view.EndScene();
+
+      ezTime t1 = ezTime::Now();
+
+      for (const ezSimdBBox& box : queries)
+      {
+        uiNumCulled += view.IsVisible(box) ? 0 : 1;
+      }
+
+      ezTime t2 = ezTime::Now();
+
+      tRasterize += t1 - t0;
+      tQuery += t2 - t1;
+    }
+
+    ezLog::Info("[test]Occlusion rasterizer: {0} occluders/ms", ezArgF(uiNumOccluders * uiNumIterations / tRasterize.GetMilliseconds(), 1));
+    ezLog::Info("[test]Occlusion rasterizer: {0} queries/ms, {1} culled-objects/ms ({2} of {3} culled)", ezArgF(uiNumQueries * uiNumIterations / tQuery.GetMilliseconds(), 1), ezArgF(uiNumCulled / tQuery.GetMilliseconds(), 1), uiNumCulled / uiNumIterations, uiNumQueries);
+  }
+}